@@ -0,0 +1,588 @@
+# Copyright 2025 The IREE Authors
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""Offline autotuner for LLVMCPU dispatch lowering configurations.
+
+Compiles the input program for the local CPU and dumps a standalone benchmark
+module for every dispatch. Candidate `lowering_config`s are enumerated for the
+root op of each dispatch by scaling the distribution tile sizes chosen by the
+default heuristics, substituted into the benchmark modules, compiled, and timed
+locally with iree-benchmark-module. The fastest configuration for each dispatch
+is written to a tuning spec that can be passed back to the compiler with
+`--iree-codegen-tuning-spec-path=`.
+
+Example:
+  iree-tune-cpu model.mlir -o spec.mlir
+  iree-compile model.mlir --iree-hal-target-backends=llvm-cpu \\
+      --iree-llvmcpu-target-cpu=host \\
+      --iree-codegen-tuning-spec-path=spec.mlir -o model.vmfb
+"""
+
+import argparse
+import ast
+import itertools
+import json
+import logging
+import math
+import os
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+from dataclasses import dataclass, field
+from typing import Dict, Iterator, List, Optional, Sequence, Tuple
+
+from ... import ir
+from ..binaries import find_tool, get_tool_path
+
+logger = logging.getLogger(__name__)
+
+# Factors applied to each distribution tile size when enumerating candidates.
+_TILE_SCALE_FACTORS = [1, 2, 4, 1 / 2, 1 / 4]
+
+_TILE_SIZES_PATTERN = re.compile(
+    r"^(#iree_codegen\.lowering_config<tile_sizes = )(\[.*?\])"
+    r"((?:, native_vector_size = \[.*\])?>)$"
+)
+
+
+@dataclass
+class Dispatch:
+    """A dispatch function with a tunable root op in a benchmark module."""
+
+    # Path of the benchmark module containing the dispatch.
+    benchmark_path: str
+    # Name of the dispatch function (and its export).
+    name: str
+    # Name of the root op (e.g. `linalg.matmul`).
+    op_name: str
+    # Types of the root op operands as printed in IR.
+    operand_types: List[str]
+    # Lowering config chosen by the default heuristics as printed in IR.
+    lowering_config: str
+    # Translation info of the dispatch function as printed in IR.
+    translation_info: str
+
+
+@dataclass
+class TuningResult:
+    dispatch: Dispatch
+    # Lowering config with the lowest measured time.
+    lowering_config: str
+    # Time in microseconds of the default and the best configurations.
+    default_time_us: float
+    best_time_us: float
+    # All measured configurations and their times in microseconds.
+    measurements: List[Tuple[str, float]] = field(default_factory=list)
+
+
+###############################################################################
+# Lowering config manipulation
+###############################################################################
+
+
+def parse_tile_sizes(lowering_config: str) -> Optional[List[List[int]]]:
+    """Returns the tile sizes of each level of |lowering_config|.
+
+    Returns None if the config cannot be tuned: scalable tile sizes and tile
+    interchanges are not supported.
+    """
+    match = _TILE_SIZES_PATTERN.match(lowering_config)
+    if not match or "{" in match.group(2):
+        return None
+    try:
+        levels = ast.literal_eval(match.group(2))
+    except (SyntaxError, ValueError):
+        return None
+    for level in levels:
+        if not all(isinstance(size, int) for size in level):
+            return None
+    return levels
+
+
+def format_lowering_config(lowering_config: str, levels: List[List[int]]) -> str:
+    """Returns |lowering_config| with its tile sizes replaced by |levels|."""
+    match = _TILE_SIZES_PATTERN.match(lowering_config)
+    assert match, f"unsupported lowering config {lowering_config}"
+    level_strs = [
+        "[" + ", ".join(str(size) for size in level) + "]" for level in levels
+    ]
+    return match.group(1) + "[" + ", ".join(level_strs) + "]" + match.group(3)
+
+
+def enumerate_candidates(
+    levels: List[List[int]], max_candidates: int
+) -> List[List[List[int]]]:
+    """Returns up to |max_candidates| tile size variants of |levels|.
+
+    The first level holds the distribution tile sizes that decide how much
+    work each workgroup performs; they are scaled by powers of two. Levels
+    equal to the first (cache tiling duplicates the distribution tiling for
+    most ops) are scaled with it. Deeper levels are kept as-is and candidates
+    are only produced when they remain divisible by them. Candidates closest to
+    the default configuration are returned first and the default itself is not
+    included.
+    """
+    if not levels or max_candidates <= 0:
+        return []
+    distribution = levels[0]
+    tied_levels = [i for i, level in enumerate(levels) if level == distribution]
+
+    # Inner tile sizes each dimension must remain divisible by.
+    inner_sizes = [1] * len(distribution)
+    for i, level in enumerate(levels):
+        if i in tied_levels:
+            continue
+        for dim, size in enumerate(level[: len(distribution)]):
+            if size:
+                inner_sizes[dim] = math.lcm(inner_sizes[dim], size)
+
+    per_dim_options = []
+    for dim, size in enumerate(distribution):
+        if not size:
+            per_dim_options.append([(0, 0.0)])
+            continue
+        options = []
+        for factor in _TILE_SCALE_FACTORS:
+            scaled = size * factor
+            if scaled != int(scaled) or scaled < 1:
+                continue
+            scaled = int(scaled)
+            if scaled % inner_sizes[dim]:
+                continue
+            options.append((scaled, abs(math.log2(factor))))
+        per_dim_options.append(options)
+
+    candidates = []
+    for choice in itertools.product(*per_dim_options):
+        sizes = [size for size, _ in choice]
+        if sizes == distribution:
+            continue
+        distance = sum(cost for _, cost in choice)
+        candidate = [
+            list(sizes) if i in tied_levels else list(level)
+            for i, level in enumerate(levels)
+        ]
+        candidates.append((distance, candidate))
+    candidates.sort(key=lambda entry: entry[0])
+    return [candidate for _, candidate in candidates[:max_candidates]]
+
+
+###############################################################################
+# Benchmark module handling
+###############################################################################
+
+
+def _walk_ops(op) -> Iterator:
+    yield op
+    for region in op.regions:
+        for block in region.blocks:
+            for child in block.operations:
+                yield from _walk_ops(child.operation)
+
+
+def _find_dispatch_funcs(module: ir.Module) -> Dict[str, object]:
+    """Returns the dispatch functions in a benchmark module by name."""
+    funcs = {}
+    for op in _walk_ops(module.operation):
+        if op.name != "hal.executable.variant":
+            continue
+        for nested_op in _walk_ops(op):
+            if nested_op.name == "func.func" and "translation_info" in (
+                nested_op.attributes
+            ):
+                name = ir.StringAttr(nested_op.attributes["sym_name"]).value
+                funcs[name] = nested_op
+    return funcs
+
+
+def _find_root_op(func_op):
+    for op in _walk_ops(func_op):
+        if op.name != "linalg.fill" and "lowering_config" in op.attributes:
+            return op
+    return None
+
+
+def find_dispatches(benchmark_path: str) -> List[Dispatch]:
+    """Returns the tunable dispatches in the benchmark module at the path."""
+    with open(benchmark_path, "rt") as f:
+        asm = f.read()
+    dispatches = []
+    with ir.Context():
+        module = ir.Module.parse(asm)
+        for name, func_op in _find_dispatch_funcs(module).items():
+            root_op = _find_root_op(func_op)
+            if root_op is None:
+                continue
+            lowering_config = str(root_op.attributes["lowering_config"])
+            if parse_tile_sizes(lowering_config) is None:
+                logger.info("Skipping %s: unsupported %s", name, lowering_config)
+                continue
+            dispatches.append(
+                Dispatch(
+                    benchmark_path=benchmark_path,
+                    name=name,
+                    op_name=root_op.name,
+                    operand_types=[str(operand.type) for operand in root_op.operands],
+                    lowering_config=lowering_config,
+                    translation_info=str(func_op.attributes["translation_info"]),
+                )
+            )
+    return dispatches
+
+
+def write_candidate(dispatch: Dispatch, lowering_config: str, output_path: str):
+    """Writes the benchmark module of |dispatch| using |lowering_config|."""
+    with open(dispatch.benchmark_path, "rt") as f:
+        asm = f.read()
+    with ir.Context():
+        module = ir.Module.parse(asm)
+        func_op = _find_dispatch_funcs(module)[dispatch.name]
+        root_op = _find_root_op(func_op)
+        root_op.attributes["lowering_config"] = ir.Attribute.parse(lowering_config)
+        with open(output_path, "wt") as f:
+            f.write(str(module))
+
+
+def parse_benchmark_time_us(benchmark_json: str, dispatch_name: str) -> float:
+    """Returns the time of |dispatch_name| from iree-benchmark-module JSON.
+
+    The median real time over all repetitions is taken for each benchmark
+    function and summed across functions benchmarking the dispatch (one per
+    unique workload).
+    """
+    results = json.loads(benchmark_json)
+    times: Dict[str, List[float]] = {}
+    for benchmark in results.get("benchmarks", []):
+        if benchmark.get("run_type", "iteration") != "iteration":
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        if dispatch_name not in name:
+            continue
+        scale = {"ns": 1e-3, "us": 1.0, "ms": 1e3, "s": 1e6}[
+            benchmark.get("time_unit", "ns")
+        ]
+        times.setdefault(name, []).append(benchmark["real_time"] * scale)
+    if not times:
+        raise ValueError(f"no benchmark results found for {dispatch_name}")
+    return sum(statistics.median(values) for values in times.values())
+
+
+###############################################################################
+# Tuning spec emission
+###############################################################################
+
+
+def _sanitize_symbol(name: str) -> str:
+    return re.sub(r"[^A-Za-z0-9_]", "_", name)
+
+
+def emit_tuning_spec(results: Sequence[TuningResult]) -> str:
+    """Returns a tuning spec applying the best configuration of each result.
+
+    Dispatches are matched by their root op name and operand types. When
+    multiple dispatches share both only the first is emitted.
+    """
+    lines = [
+        "// Tuning spec generated by iree-tune-cpu.",
+        "",
+        "module @iree_cpu_tuning_spec attributes { transform.with_named_sequence } {",
+        "transform.named_sequence @apply_op_config("
+        "%op: !transform.any_op {transform.readonly},",
+        "                                          "
+        "%config: !transform.any_param {transform.readonly}) {",
+        '  transform.annotate %op "compilation_info" = %config '
+        ": !transform.any_op, !transform.any_param",
+        "  transform.yield",
+        "}",
+        "",
+    ]
+    matchers = []
+    seen_signatures = set()
+    for result in results:
+        dispatch = result.dispatch
+        signature = (dispatch.op_name, tuple(dispatch.operand_types))
+        if signature in seen_signatures:
+            logger.warning(
+                "Skipping %s: root op matches an earlier dispatch", dispatch.name
+            )
+            continue
+        seen_signatures.add(signature)
+        matcher = f"match_{_sanitize_symbol(dispatch.name)}"
+        matchers.append(matcher)
+        lines.append(
+            f"// {dispatch.name}: {result.default_time_us:.3f}us -> "
+            f"{result.best_time_us:.3f}us"
+        )
+        lines.append(
+            f"transform.named_sequence @{matcher}("
+            "%op: !transform.any_op {transform.readonly})"
+        )
+        lines.append("  -> (!transform.any_op, !transform.any_param) {")
+        lines.append(
+            f'  transform.match.operation_name %op ["{dispatch.op_name}"] '
+            ": !transform.any_op"
+        )
+        for i, operand_type in enumerate(dispatch.operand_types):
+            lines.append(
+                f"  %operand{i} = transform.get_operand %op[{i}] "
+                ": (!transform.any_op) -> !transform.any_value"
+            )
+            lines.append(
+                f"  transform.iree.match.cast_compatible_type %operand{i} = "
+                f"{operand_type} : !transform.any_value"
+            )
+        lines.append(
+            "  %config = transform.param.constant #iree_codegen.compilation_info<"
+        )
+        lines.append(f"    lowering_config = {result.lowering_config},")
+        lines.append(f"    translation_info = {dispatch.translation_info}")
+        lines.append("  > -> !transform.any_param")
+        lines.append(
+            "  transform.yield %op, %config : !transform.any_op, !transform.any_param"
+        )
+        lines.append("}")
+        lines.append("")
+
+    lines.append(
+        "transform.named_sequence @__kernel_config("
+        "%variant_op: !transform.any_op {transform.consumed}) "
+        "-> (!transform.any_op)"
+    )
+    lines.append("  attributes { iree_codegen.tuning_spec_entrypoint } {")
+    if matchers:
+        lines.append("  %res = transform.foreach_match in %variant_op")
+        for i, matcher in enumerate(matchers):
+            separator = "," if i + 1 < len(matchers) else ""
+            lines.append(f"    @{matcher} -> @apply_op_config{separator}")
+        lines.append("    : (!transform.any_op) -> !transform.any_op")
+        lines.append("  transform.yield %res : !transform.any_op")
+    else:
+        lines.append("  transform.yield %variant_op : !transform.any_op")
+    lines.append("}")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+###############################################################################
+# Tuning
+###############################################################################
+
+
+def _find_runtime_tool(exe_name: str, explicit_path: Optional[str]) -> str:
+    if explicit_path:
+        return explicit_path
+    for path_entry in get_tool_path():
+        candidate_exe = os.path.join(path_entry, exe_name)
+        if os.path.isfile(candidate_exe) and os.access(candidate_exe, os.X_OK):
+            return candidate_exe
+    candidate_exe = shutil.which(exe_name)
+    if not candidate_exe:
+        raise ValueError(
+            f"IREE runtime tool '{exe_name}' was not found; install the "
+            f"iree-base-runtime package or pass its path explicitly"
+        )
+    return candidate_exe
+
+
+def _run(command_line: List[str]) -> Optional[str]:
+    logger.debug("Running: %s", " ".join(command_line))
+    process = subprocess.run(command_line, capture_output=True, text=True)
+    if process.returncode != 0:
+        logger.debug("Command failed:\n%s", process.stderr)
+        return None
+    return process.stdout
+
+
+class Tuner:
+    def __init__(self, args):
+        self.args = args
+        self.iree_compile = find_tool("iree-compile")
+        self.iree_benchmark_module = _find_runtime_tool(
+            "iree-benchmark-module", args.iree_benchmark_module
+        )
+
+    def dump_benchmarks(self, work_dir: str) -> str:
+        benchmarks_dir = os.path.join(work_dir, "benchmarks")
+        command_line = [
+            self.iree_compile,
+            self.args.input_file,
+            "--iree-hal-target-backends=llvm-cpu",
+            f"--iree-llvmcpu-target-cpu={self.args.target_cpu}",
+            f"--iree-hal-dump-executable-benchmarks-to={benchmarks_dir}",
+            "-o",
+            os.path.join(work_dir, "baseline.vmfb"),
+        ] + self.args.compile_args
+        if _run(command_line) is None:
+            raise RuntimeError(f"Failed to compile {self.args.input_file}")
+        return benchmarks_dir
+
+    def measure(self, dispatch: Dispatch, lowering_config: str, path: str):
+        """Returns the time in microseconds of |dispatch| using the config."""
+        write_candidate(dispatch, lowering_config, path + ".mlir")
+        if _run([self.iree_compile, path + ".mlir", "-o", path + ".vmfb"]) is None:
+            return None
+        output = _run(
+            [
+                self.iree_benchmark_module,
+                f"--module={path}.vmfb",
+                f"--device={self.args.device}",
+                "--benchmark_format=json",
+                f"--benchmark_repetitions={self.args.repetitions}",
+            ]
+        )
+        if output is None:
+            return None
+        return parse_benchmark_time_us(output, dispatch.name)
+
+    def tune(self, dispatch: Dispatch, work_dir: str) -> Optional[TuningResult]:
+        default_levels = parse_tile_sizes(dispatch.lowering_config)
+        candidates_dir = os.path.join(work_dir, "candidates", dispatch.name)
+        os.makedirs(candidates_dir, exist_ok=True)
+        default_time_us = self.measure(
+            dispatch,
+            dispatch.lowering_config,
+            os.path.join(candidates_dir, "default"),
+        )
+        if default_time_us is None:
+            logger.warning("Skipping %s: default config failed to run", dispatch.name)
+            return None
+        result = TuningResult(
+            dispatch=dispatch,
+            lowering_config=dispatch.lowering_config,
+            default_time_us=default_time_us,
+            best_time_us=default_time_us,
+            measurements=[(dispatch.lowering_config, default_time_us)],
+        )
+        candidates = enumerate_candidates(default_levels, self.args.max_candidates)
+        for i, levels in enumerate(candidates):
+            lowering_config = format_lowering_config(dispatch.lowering_config, levels)
+            time_us = self.measure(
+                dispatch,
+                lowering_config,
+                os.path.join(candidates_dir, f"candidate_{i}"),
+            )
+            if time_us is None:
+                logger.info("  %s: failed", lowering_config)
+                continue
+            logger.info("  %s: %.3fus", lowering_config, time_us)
+            result.measurements.append((lowering_config, time_us))
+            if time_us < result.best_time_us:
+                result.best_time_us = time_us
+                result.lowering_config = lowering_config
+        return result
+
+    def run(self, work_dir: str) -> List[TuningResult]:
+        benchmarks_dir = self.dump_benchmarks(work_dir)
+        results = []
+        for file_name in sorted(os.listdir(benchmarks_dir)):
+            if not file_name.endswith(".mlir"):
+                continue
+            for dispatch in find_dispatches(os.path.join(benchmarks_dir, file_name)):
+                logger.info("Tuning %s", dispatch.name)
+                result = self.tune(dispatch, work_dir)
+                if result is None:
+                    continue
+                logger.info(
+                    "%s: %.3fus -> %.3fus",
+                    dispatch.name,
+                    result.default_time_us,
+                    result.best_time_us,
+                )
+                # Dispatches where the default is best are left to the
+                # heuristics so that compiler improvements still apply.
+                if result.best_time_us < result.default_time_us * (
+                    1.0 - self.args.min_improvement
+                ):
+                    results.append(result)
+        return results
+
+
+###############################################################################
+# CLI handling
+###############################################################################
+
+
+def parse_arguments(argv=None):
+    parser = argparse.ArgumentParser(
+        description="IREE CPU dispatch autotuner",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__,
+    )
+    parser.add_argument("input_file", help="Program to tune")
+    parser.add_argument(
+        "-o", required=True, dest="output_file", help="Output tuning spec file"
+    )
+    parser.add_argument(
+        "--work-dir",
+        help="Directory to keep benchmark modules and candidates in "
+        "(defaults to a temporary directory that is removed on exit)",
+    )
+    parser.add_argument(
+        "--compile-arg",
+        action="append",
+        default=[],
+        dest="compile_args",
+        help="Additional iree-compile flag used when compiling the program",
+    )
+    parser.add_argument(
+        "--target-cpu",
+        default="host",
+        help="CPU to compile for; must be able to run on this machine",
+    )
+    parser.add_argument(
+        "--device", default="local-task", help="Device to benchmark on"
+    )
+    parser.add_argument(
+        "--max-candidates",
+        default=16,
+        type=int,
+        help="Maximum number of candidate configurations per dispatch",
+    )
+    parser.add_argument(
+        "--repetitions",
+        default=3,
+        type=int,
+        help="Number of benchmark repetitions per candidate",
+    )
+    parser.add_argument(
+        "--min-improvement",
+        default=0.02,
+        type=float,
+        help="Minimum fractional improvement over the default configuration "
+        "required for a dispatch to be included in the spec",
+    )
+    parser.add_argument(
+        "--iree-benchmark-module",
+        help="Path to iree-benchmark-module (defaults to searching "
+        "IREE_TOOL_PATH and PATH)",
+    )
+    parser.add_argument("--verbose", "-v", action="store_true", help="Log progress")
+    return parser.parse_args(argv)
+
+
+def main(args) -> int:
+    logging.basicConfig(level=logging.INFO if args.verbose else logging.WARNING)
+    tuner = Tuner(args)
+    if args.work_dir:
+        os.makedirs(args.work_dir, exist_ok=True)
+        results = tuner.run(args.work_dir)
+    else:
+        with tempfile.TemporaryDirectory() as work_dir:
+            results = tuner.run(work_dir)
+    with open(args.output_file, "wt") as f:
+        f.write(emit_tuning_spec(results))
+    return 0
+
+
+def _cli_main():
+    sys.exit(main(parse_arguments()))
+
+
+if __name__ == "__main__":
+    _cli_main()
@@ -0,0 +1,177 @@
+# Copyright 2025 The IREE Authors
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+from iree.compiler.tools.tune_cpu import __main__
+
+import json
+import unittest
+
+MATMUL_CONFIG = (
+    "#iree_codegen.lowering_config<tile_sizes = [[64, 64, 0], [64, 64, 0], "
+    "[0, 0, 0], [8, 32, 0], [0, 0, 16], [0, 0, 0]]>"
+)
+
+
+class TuneCpuTest(unittest.TestCase):
+    def testParseTileSizes(self):
+        self.assertEqual(
+            __main__.parse_tile_sizes(MATMUL_CONFIG),
+            [[64, 64, 0], [64, 64, 0], [0, 0, 0], [8, 32, 0], [0, 0, 16], [0, 0, 0]],
+        )
+        self.assertEqual(
+            __main__.parse_tile_sizes(
+                "#iree_codegen.lowering_config<tile_sizes = [[8, 16]], "
+                "native_vector_size = [16]>"
+            ),
+            [[8, 16]],
+        )
+
+    def testParseTileSizesUnsupported(self):
+        # Scalable tile sizes.
+        self.assertIsNone(
+            __main__.parse_tile_sizes(
+                "#iree_codegen.lowering_config<tile_sizes = [[0, 0], [1, [4]]]>"
+            )
+        )
+        # Tile interchange.
+        self.assertIsNone(
+            __main__.parse_tile_sizes(
+                "#iree_codegen.lowering_config<tile_sizes = "
+                "[{sizes = [4, 8], interchange = [1, 0]}]>"
+            )
+        )
+        self.assertIsNone(
+            __main__.parse_tile_sizes("#iree_gpu.lowering_config<{workgroup = [1]}>")
+        )
+
+    def testFormatLoweringConfig(self):
+        self.assertEqual(
+            __main__.format_lowering_config(
+                "#iree_codegen.lowering_config<tile_sizes = [[8, 16]], "
+                "native_vector_size = [16]>",
+                [[4, 32]],
+            ),
+            "#iree_codegen.lowering_config<tile_sizes = [[4, 32]], "
+            "native_vector_size = [16]>",
+        )
+
+    def testEnumerateCandidates(self):
+        levels = __main__.parse_tile_sizes(MATMUL_CONFIG)
+        candidates = __main__.enumerate_candidates(levels, max_candidates=100)
+        self.assertNotIn(levels, candidates)
+        self.assertIn(
+            [[64, 128, 0], [64, 128, 0], [0, 0, 0], [8, 32, 0], [0, 0, 16], [0, 0, 0]],
+            candidates,
+        )
+        for candidate in candidates:
+            # Cache tiling is scaled together with distribution tiling.
+            self.assertEqual(candidate[0], candidate[1])
+            # Inner levels are unchanged and still divide the outer tiles.
+            self.assertEqual(candidate[2:], levels[2:])
+            self.assertEqual(candidate[0][0] % 8, 0)
+            self.assertEqual(candidate[0][1] % 32, 0)
+            # Reduction dimensions are not distributed.
+            self.assertEqual(candidate[0][2], 0)
+        # The closest candidates change a single dimension by a factor of 2.
+        first = __main__.enumerate_candidates(levels, max_candidates=1)
+        self.assertEqual(len(first), 1)
+        self.assertIn(first[0][0], [[128, 64, 0], [32, 64, 0], [64, 128, 0]])
+
+    def testParseBenchmarkTime(self):
+        name = "BM_main_dispatch_0_main_dispatch_0_matmul_128x512x256_f32"
+        benchmark_json = json.dumps(
+            {
+                "benchmarks": [
+                    {
+                        "name": name,
+                        "run_name": name,
+                        "run_type": "iteration",
+                        "real_time": 1000.0,
+                        "time_unit": "ns",
+                    },
+                    {
+                        "name": name,
+                        "run_name": name,
+                        "run_type": "iteration",
+                        "real_time": 3000.0,
+                        "time_unit": "ns",
+                    },
+                    {
+                        "name": name,
+                        "run_name": name,
+                        "run_type": "iteration",
+                        "real_time": 2000.0,
+                        "time_unit": "ns",
+                    },
+                    {
+                        "name": name + "_mean",
+                        "run_name": name,
+                        "run_type": "aggregate",
+                        "real_time": 2000.0,
+                        "time_unit": "ns",
+                    },
+                ]
+            }
+        )
+        self.assertAlmostEqual(
+            __main__.parse_benchmark_time_us(
+                benchmark_json, "main_dispatch_0_matmul_128x512x256_f32"
+            ),
+            2.0,
+        )
+        with self.assertRaises(ValueError):
+            __main__.parse_benchmark_time_us(benchmark_json, "main_dispatch_1")
+
+    def testEmitTuningSpec(self):
+        dispatch = __main__.Dispatch(
+            benchmark_path="unused.mlir",
+            name="main_dispatch_0_matmul_128x512x256_f32",
+            op_name="linalg.matmul",
+            operand_types=[
+                "tensor<128x256xf32>",
+                "tensor<256x512xf32>",
+                "tensor<128x512xf32>",
+            ],
+            lowering_config=MATMUL_CONFIG,
+            translation_info=(
+                "#iree_codegen.translation_info<pipeline = CPUDoubleTilingExpert>"
+            ),
+        )
+        best_config = __main__.format_lowering_config(
+            MATMUL_CONFIG,
+            [[64, 128, 0], [64, 128, 0], [0, 0, 0], [8, 32, 0], [0, 0, 16], [0, 0, 0]],
+        )
+        result = __main__.TuningResult(
+            dispatch=dispatch,
+            lowering_config=best_config,
+            default_time_us=10.0,
+            best_time_us=8.0,
+        )
+        # Dispatches with the same root op signature are only emitted once.
+        spec = __main__.emit_tuning_spec([result, result])
+        print("Spec:", spec)
+        self.assertEqual(spec.count("transform.named_sequence @match_"), 1)
+        self.assertIn("iree_codegen.tuning_spec_entrypoint", spec)
+        self.assertIn(
+            "@match_main_dispatch_0_matmul_128x512x256_f32 -> @apply_op_config",
+            spec,
+        )
+        self.assertIn('transform.match.operation_name %op ["linalg.matmul"]', spec)
+        self.assertIn(
+            "transform.iree.match.cast_compatible_type %operand2 = "
+            "tensor<128x512xf32>",
+            spec,
+        )
+        self.assertIn(f"lowering_config = {best_config},", spec)
+
+    def testEmitEmptyTuningSpec(self):
+        spec = __main__.emit_tuning_spec([])
+        self.assertNotIn("foreach_match", spec)
+        self.assertIn("transform.yield %variant_op", spec)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -26,6 +26,7 @@
 #include "iree/compiler/Dialect/LinalgExt/IR/LinalgExtDialect.h"
 #include "iree/compiler/PluginAPI/Client.h"
 #include "iree/compiler/Utils/ModuleUtils.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/GlobalValue.h"
@@ -56,6 +57,11 @@ namespace mlir::iree_compiler::IREE::HAL {
 static constexpr char kQueryFunctionName[] =
     "iree_hal_executable_library_query";
 
+// Minimum number of exported functions per partition when splitting
+// executables for parallel code generation. Smaller partitions spend more time
+// in bitcode round-tripping and linking than they save in code generation.
+static constexpr int64_t kMinExportsPerCodegenPartition = 8;
+
 static void dumpLLVMModuleToPath(StringRef path, StringRef baseName,
                                  StringRef suffix, StringRef extPrefix,
                                  llvm::Module &module) {
@@ -405,6 +411,28 @@ public:
         dispatchAttrs.bindingCount = layoutAttr.getBindings().size();
       }
 
+      // Exports may hint at the order in which the runtime should distribute
+      // workgroups to improve cache reuse between concurrently running ones.
+      if (auto orderAttr = exportOp->getAttrOfType<StringAttr>(
+              "hal.executable.workgroup_order")) {
+        auto workgroupOrder =
+            llvm::StringSwitch<std::optional<LibraryBuilder::WorkgroupOrder>>(
+                orderAttr.getValue())
+                .Case("row_major", LibraryBuilder::WorkgroupOrder::ROW_MAJOR)
+                .Case("column_major",
+                      LibraryBuilder::WorkgroupOrder::COLUMN_MAJOR)
+                .Case("morton", LibraryBuilder::WorkgroupOrder::MORTON)
+                .Case("grouped", LibraryBuilder::WorkgroupOrder::GROUPED)
+                .Default(std::nullopt);
+        if (!workgroupOrder) {
+          return exportOp.emitError()
+                 << "unsupported workgroup order '" << orderAttr.getValue()
+                 << "'; expected one of row_major, column_major, morton, "
+                    "grouped";
+        }
+        dispatchAttrs.workgroupOrder = *workgroupOrder;
+      }
+
       LibraryBuilder::SourceLocation sourceLocation;
       if (options.debugLevel >= 1) {
         if (auto loc = findFirstFileLoc(exportOp.getLoc())) {
@@ -612,14 +640,44 @@ public:
 
     SmallVector<Artifact> objectFiles;
 
-    // Emit the base object file containing the bulk of our code.
-    // This must come first such that we have the proper library linking order.
-    {
-      // NOTE: today we just use a single object file, however if we wanted to
-      // scale code generation and linking we'd want to generate one per
-      // function (or something like that). A single object file is also
-      // instrumental to static library generation (which only supports one
-      // object file per library).
+    // Emit the base object files containing the bulk of our code.
+    // These must come first such that we have the proper library linking
+    // order.
+    //
+    // Executables with many dispatch functions (such as those produced by
+    // linking) are split into partitions that are compiled in parallel and
+    // linked back together. Static libraries only support a single object
+    // file.
+    int64_t exportCount =
+        llvm::range_size(variantOp.getBlock().getOps<ExecutableExportOp>());
+    unsigned partitionCount = std::min<int64_t>(
+        defaultOptions_.codegenPartitions,
+        exportCount / kMinExportsPerCodegenPartition);
+    if (!target.linkStatic && partitionCount > 1) {
+      SmallVector<std::string> partitionObjectData;
+      if (failed(runSplitEmitObjFilePasses(target, llvmModule.get(),
+                                           partitionCount,
+                                           variantOp.getContext(),
+                                           partitionObjectData))) {
+        return variantOp.emitError()
+               << "failed to compile LLVM-IR module partitions to object files";
+      }
+      for (auto [index, objectData] : llvm::enumerate(partitionObjectData)) {
+        std::string partitionSuffix = "_partition" + std::to_string(index);
+        if (!options.dumpIntermediatesPath.empty()) {
+          dumpDataToPath(options.dumpIntermediatesPath, options.dumpBaseName,
+                         variantOp.getName(), partitionSuffix + ".o",
+                         objectData);
+        }
+        auto objectFile =
+            Artifact::createTemporary(libraryName + partitionSuffix, "o");
+        auto &os = objectFile.outputFile->os();
+        os << objectData;
+        os.flush();
+        os.close();
+        objectFiles.push_back(std::move(objectFile));
+      }
+    } else {
       std::string objectData;
       if (failed(runEmitObjFilePasses(targetMachine.get(), llvmModule.get(),
                                       llvm::CodeGenFileType::ObjectFile,
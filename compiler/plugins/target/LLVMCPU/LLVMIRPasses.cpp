@@ -7,7 +7,10 @@
 #include "compiler/plugins/target/LLVMCPU/LLVMIRPasses.h"
 
 #include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassManager.h"
@@ -17,10 +20,13 @@
 #include "llvm/Passes/StandardInstrumentations.h"
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
 #include "llvm/Transforms/Instrumentation/AddressSanitizer.h"
 #include "llvm/Transforms/Instrumentation/ThreadSanitizer.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
+#include "mlir/IR/Threading.h"
 
 namespace mlir::iree_compiler::IREE::HAL {
 
@@ -118,4 +124,43 @@ LogicalResult runEmitObjFilePasses(llvm::TargetMachine *machine,
   return success();
 }
 
+LogicalResult runSplitEmitObjFilePasses(const LLVMTarget &target,
+                                        llvm::Module *module,
+                                        unsigned partitionCount,
+                                        MLIRContext *context,
+                                        SmallVectorImpl<std::string> &objData) {
+  // LLVMContexts cannot be shared across threads so each partition is
+  // round-tripped through bitcode and compiled in a context of its own.
+  SmallVector<SmallVector<char, 0>> partitionBitcode;
+  llvm::SplitModule(*module, partitionCount,
+                    [&](std::unique_ptr<llvm::Module> partition) {
+                      llvm::raw_svector_ostream ostream(
+                          partitionBitcode.emplace_back());
+                      llvm::WriteBitcodeToFile(*partition, ostream);
+                    });
+
+  objData.resize(partitionBitcode.size());
+  return failableParallelForEach(
+      context, 0, partitionBitcode.size(), [&](size_t i) -> LogicalResult {
+        llvm::LLVMContext llvmContext;
+        auto partition = llvm::parseBitcodeFile(
+            llvm::MemoryBufferRef(
+                StringRef(partitionBitcode[i].data(),
+                          partitionBitcode[i].size()),
+                module->getModuleIdentifier()),
+            llvmContext);
+        if (!partition) {
+          llvm::consumeError(partition.takeError());
+          return failure();
+        }
+        // Target machines hold per-module codegen state and cannot be shared.
+        auto machine = createTargetMachine(target);
+        if (!machine)
+          return failure();
+        return runEmitObjFilePasses(machine.get(), partition->get(),
+                                    llvm::CodeGenFileType::ObjectFile,
+                                    &objData[i]);
+      });
+}
+
 } // namespace mlir::iree_compiler::IREE::HAL
@@ -12,6 +12,7 @@
 #include "compiler/plugins/target/LLVMCPU/LLVMTargetOptions.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Target/TargetMachine.h"
+#include "mlir/IR/MLIRContext.h"
 #include "mlir/Support/LogicalResult.h"
 
 namespace mlir::iree_compiler::IREE::HAL {
@@ -27,6 +28,19 @@ LogicalResult runEmitObjFilePasses(llvm::TargetMachine *machine,
                                    llvm::CodeGenFileType fileType,
                                    std::string *objData);
 
+// Splits |module| into at most |partitionCount| partitions and emits an object
+// file for each into |objData|. Partitions are compiled in parallel when
+// multithreading is enabled in |context| and each uses its own LLVMContext and
+// target machine. The partitioning only depends on |module| and
+// |partitionCount| so the produced objects are deterministic. Symbols local to
+// |module| are externalized with hidden visibility so that the objects can be
+// linked together.
+LogicalResult runSplitEmitObjFilePasses(const LLVMTarget &target,
+                                        llvm::Module *module,
+                                        unsigned partitionCount,
+                                        MLIRContext *context,
+                                        SmallVectorImpl<std::string> &objData);
+
 } // namespace mlir::iree_compiler::IREE::HAL
 
 #endif // IREE_COMPILER_PLUGINS_TARGET_LLVMCPU_LLVMIRPASSES_H_
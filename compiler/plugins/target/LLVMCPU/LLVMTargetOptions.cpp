@@ -508,6 +508,14 @@ void LLVMCPUTargetCLOptions::bindOptions(OptionsBinder &binder) {
       "iree-llvmcpu-keep-linker-artifacts", keepLinkerArtifacts,
       llvm::cl::cat(category),
       llvm::cl::desc("Keep LLVM linker target artifacts (.so/.dll/etc)"));
+  binder.opt<unsigned>(
+      "iree-llvmcpu-codegen-partitions", codegenPartitions,
+      llvm::cl::cat(category),
+      llvm::cl::desc(
+          "Maximum number of partitions that executables with many dispatch "
+          "functions are split into for parallel LLVM code generation. The "
+          "output does not depend on the number of compiler threads. 1 "
+          "(the default) disables splitting."));
 
   // Default device options.
   binder.opt<std::string>("iree-llvmcpu-target-triple", targetTriple,
@@ -599,6 +607,7 @@ LLVMTargetOptions LLVMCPUTargetCLOptions::getTargetOptions() {
   targetOptions.embeddedLinkerPath = embeddedLinkerPath;
   targetOptions.wasmLinkerPath = wasmLinkerPath;
   targetOptions.keepLinkerArtifacts = keepLinkerArtifacts;
+  targetOptions.codegenPartitions = codegenPartitions;
 
   if (targetTriple.empty()) {
     targetTriple = llvm::sys::getProcessTriple();
@@ -161,6 +161,11 @@ struct LLVMTargetOptions {
 
   // True to keep linker artifacts for debugging.
   bool keepLinkerArtifacts = false;
+
+  // Maximum number of partitions that executables with many functions are
+  // split into for parallel code generation. 1 disables splitting and is the
+  // default until splitting has been validated on more targets.
+  unsigned codegenPartitions = 1;
 };
 
 // Creates target machine form target options.
@@ -175,6 +180,7 @@ struct LLVMCPUTargetCLOptions {
   std::string embeddedLinkerPath;
   std::string wasmLinkerPath;
   bool keepLinkerArtifacts = false;
+  unsigned codegenPartitions = 1;
 
   // Default device options.
   std::string targetTriple;
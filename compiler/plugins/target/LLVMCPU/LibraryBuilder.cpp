@@ -116,7 +116,8 @@ makeDispatchFunctionType(llvm::LLVMContext &context) {
 //   i16,
 //   i8,
 //   i8,
-//   i32,
+//   i8,
+//   i8[3],
 //   i64[8]
 // }
 static llvm::StructType *makeDispatchAttrsType(llvm::LLVMContext &context) {
@@ -126,12 +127,14 @@ static llvm::StructType *makeDispatchAttrsType(llvm::LLVMContext &context) {
   }
   auto *i8Type = llvm::IntegerType::getInt8Ty(context);
   auto *i16Type = llvm::IntegerType::getInt16Ty(context);
-  auto *i32Type = llvm::IntegerType::getInt32Ty(context);
   auto *i64Type = llvm::IntegerType::getInt64Ty(context);
   auto *type =
       llvm::StructType::create(context,
                                {
-                                   i16Type, i8Type, i8Type, i32Type,
+                                   i16Type, i8Type, i8Type, i8Type,
+                                   i8Type,  // [0]
+                                   i8Type,  // [1]
+                                   i8Type,  // [2]
                                    i64Type, // [0]
                                    i64Type, // [1]
                                    i64Type, // [2]
@@ -540,8 +543,15 @@ LibraryBuilder::buildLibraryV0ExportTable(std::string libraryName) {
               llvm::ConstantInt::get(i8Type, dispatch.attrs.constantCount),
               // binding_count=
               llvm::ConstantInt::get(i8Type, dispatch.attrs.bindingCount),
-              // reserved_0=
-              llvm::ConstantInt::get(i32Type, 0),
+              // workgroup_order=
+              llvm::ConstantInt::get(
+                  i8Type, static_cast<uint8_t>(dispatch.attrs.workgroupOrder)),
+              // reserved_0[0]=
+              llvm::ConstantInt::get(i8Type, 0),
+              // reserved_0[1]=
+              llvm::ConstantInt::get(i8Type, 0),
+              // reserved_0[2]=
+              llvm::ConstantInt::get(i8Type, 0),
               // reserved_1[0]=
               llvm::ConstantInt::get(i64Type, 0),
               // reserved_1[1]=
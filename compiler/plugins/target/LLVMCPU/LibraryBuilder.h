@@ -75,6 +75,18 @@ public:
     UNDEFINED = 4u,
   };
 
+  // iree_hal_executable_workgroup_order_t
+  enum class WorkgroupOrder : uint8_t {
+    // IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_ROW_MAJOR
+    ROW_MAJOR = 0u,
+    // IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_COLUMN_MAJOR
+    COLUMN_MAJOR = 1u,
+    // IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_MORTON
+    MORTON = 2u,
+    // IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_GROUPED
+    GROUPED = 3u,
+  };
+
   // IREE_HAL_EXECUTABLE_WORKGROUP_LOCAL_MEMORY_PAGE_SIZE
   static const int64_t kWorkgroupLocalMemoryPageSize = 4096;
 
@@ -86,10 +98,13 @@ public:
     uint8_t constantCount = 0;
     // Total number of bindings used by the dispatch.
     uint8_t bindingCount = 0;
+    // Preferred workgroup traversal order hint for the runtime.
+    WorkgroupOrder workgroupOrder = WorkgroupOrder::ROW_MAJOR;
 
     // True if all values are default and the attributes may be omitted.
     constexpr bool isDefault() const {
-      return localMemorySize == 0 && constantCount == 0 && bindingCount == 0;
+      return localMemorySize == 0 && constantCount == 0 && bindingCount == 0 &&
+             workgroupOrder == WorkgroupOrder::ROW_MAJOR;
     }
   };
 
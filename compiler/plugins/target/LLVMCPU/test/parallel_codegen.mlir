@@ -0,0 +1,225 @@
+// Tests that executables with many functions are split into partitions for
+// parallel code generation and that the result does not depend on threading.
+// RUN: rm -rf %t.dump
+// RUN: iree-opt --iree-stream-transformation-pipeline --iree-hal-transformation-pipeline --iree-llvmcpu-link-embedded=true --iree-llvmcpu-codegen-partitions=2 --iree-hal-dump-executable-intermediates-to=%t.dump %s -o %t.parallel.mlir
+// RUN: iree-opt --iree-stream-transformation-pipeline --iree-hal-transformation-pipeline --iree-llvmcpu-link-embedded=true --iree-llvmcpu-codegen-partitions=2 --mlir-disable-threading %s -o %t.serial.mlir
+// RUN: diff %t.parallel.mlir %t.serial.mlir
+// RUN: FileCheck %s --input-file=%t.parallel.mlir
+// RUN: ls %t.dump | FileCheck %s --check-prefix=DUMP
+
+module attributes {
+  hal.device.targets = [
+    #hal.device.target<"local", [
+      #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {
+        native_vector_size = 16 : index
+      }>
+    ]> : !hal.device
+  ]
+} {
+
+// Partitioning requires at least 8 exported functions per partition.
+stream.executable public @copy_dispatches {
+  stream.executable.export @copy_0 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_1 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_2 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_3 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_4 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_5 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_6 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_7 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_8 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_9 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_10 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_11 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_12 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_13 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_14 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  stream.executable.export @copy_15 workgroups() -> (index, index, index) {
+    %x, %y, %z = flow.dispatch.workgroup_count_from_dag_root
+    stream.return %x, %y, %z : index, index, index
+  }
+  builtin.module {
+    func.func @copy_0(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<1xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<1xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[1], strides=[1] : !flow.dispatch.tensor<readonly:tensor<1xf32>> -> tensor<1xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[1], strides=[1] : tensor<1xf32> -> !flow.dispatch.tensor<writeonly:tensor<1xf32>>
+      return
+    }
+    func.func @copy_1(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<2xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<2xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[2], strides=[1] : !flow.dispatch.tensor<readonly:tensor<2xf32>> -> tensor<2xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[2], strides=[1] : tensor<2xf32> -> !flow.dispatch.tensor<writeonly:tensor<2xf32>>
+      return
+    }
+    func.func @copy_2(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<3xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<3xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[3], strides=[1] : !flow.dispatch.tensor<readonly:tensor<3xf32>> -> tensor<3xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[3], strides=[1] : tensor<3xf32> -> !flow.dispatch.tensor<writeonly:tensor<3xf32>>
+      return
+    }
+    func.func @copy_3(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<4xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<4xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[4], strides=[1] : !flow.dispatch.tensor<readonly:tensor<4xf32>> -> tensor<4xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[4], strides=[1] : tensor<4xf32> -> !flow.dispatch.tensor<writeonly:tensor<4xf32>>
+      return
+    }
+    func.func @copy_4(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<5xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<5xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[5], strides=[1] : !flow.dispatch.tensor<readonly:tensor<5xf32>> -> tensor<5xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[5], strides=[1] : tensor<5xf32> -> !flow.dispatch.tensor<writeonly:tensor<5xf32>>
+      return
+    }
+    func.func @copy_5(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<6xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<6xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[6], strides=[1] : !flow.dispatch.tensor<readonly:tensor<6xf32>> -> tensor<6xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[6], strides=[1] : tensor<6xf32> -> !flow.dispatch.tensor<writeonly:tensor<6xf32>>
+      return
+    }
+    func.func @copy_6(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<7xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<7xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[7], strides=[1] : !flow.dispatch.tensor<readonly:tensor<7xf32>> -> tensor<7xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[7], strides=[1] : tensor<7xf32> -> !flow.dispatch.tensor<writeonly:tensor<7xf32>>
+      return
+    }
+    func.func @copy_7(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<8xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<8xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[8], strides=[1] : !flow.dispatch.tensor<readonly:tensor<8xf32>> -> tensor<8xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[8], strides=[1] : tensor<8xf32> -> !flow.dispatch.tensor<writeonly:tensor<8xf32>>
+      return
+    }
+    func.func @copy_8(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<9xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<9xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[9], strides=[1] : !flow.dispatch.tensor<readonly:tensor<9xf32>> -> tensor<9xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[9], strides=[1] : tensor<9xf32> -> !flow.dispatch.tensor<writeonly:tensor<9xf32>>
+      return
+    }
+    func.func @copy_9(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<10xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<10xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[10], strides=[1] : !flow.dispatch.tensor<readonly:tensor<10xf32>> -> tensor<10xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[10], strides=[1] : tensor<10xf32> -> !flow.dispatch.tensor<writeonly:tensor<10xf32>>
+      return
+    }
+    func.func @copy_10(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<11xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<11xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[11], strides=[1] : !flow.dispatch.tensor<readonly:tensor<11xf32>> -> tensor<11xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[11], strides=[1] : tensor<11xf32> -> !flow.dispatch.tensor<writeonly:tensor<11xf32>>
+      return
+    }
+    func.func @copy_11(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<12xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<12xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[12], strides=[1] : !flow.dispatch.tensor<readonly:tensor<12xf32>> -> tensor<12xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[12], strides=[1] : tensor<12xf32> -> !flow.dispatch.tensor<writeonly:tensor<12xf32>>
+      return
+    }
+    func.func @copy_12(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<13xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<13xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[13], strides=[1] : !flow.dispatch.tensor<readonly:tensor<13xf32>> -> tensor<13xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[13], strides=[1] : tensor<13xf32> -> !flow.dispatch.tensor<writeonly:tensor<13xf32>>
+      return
+    }
+    func.func @copy_13(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<14xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<14xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[14], strides=[1] : !flow.dispatch.tensor<readonly:tensor<14xf32>> -> tensor<14xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[14], strides=[1] : tensor<14xf32> -> !flow.dispatch.tensor<writeonly:tensor<14xf32>>
+      return
+    }
+    func.func @copy_14(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<15xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<15xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[15], strides=[1] : !flow.dispatch.tensor<readonly:tensor<15xf32>> -> tensor<15xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[15], strides=[1] : tensor<15xf32> -> !flow.dispatch.tensor<writeonly:tensor<15xf32>>
+      return
+    }
+    func.func @copy_15(%arg0_binding: !stream.binding, %arg1_binding: !stream.binding) {
+      %c0 = arith.constant 0 : index
+      %arg0 = stream.binding.subspan %arg0_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<readonly:tensor<16xf32>>
+      %arg1 = stream.binding.subspan %arg1_binding[%c0] : !stream.binding -> !flow.dispatch.tensor<writeonly:tensor<16xf32>>
+      %0 = flow.dispatch.tensor.load %arg0, offsets=[0], sizes=[16], strides=[1] : !flow.dispatch.tensor<readonly:tensor<16xf32>> -> tensor<16xf32>
+      flow.dispatch.tensor.store %0, %arg1, offsets=[0], sizes=[16], strides=[1] : tensor<16xf32> -> !flow.dispatch.tensor<writeonly:tensor<16xf32>>
+      return
+    }
+  }
+}
+
+}
+
+// CHECK:       hal.executable.binary public @embedded_elf_x86_64
+// CHECK-SAME:     data = dense
+// CHECK-SAME:     format = "embedded-elf-x86_64"
+
+// DUMP-DAG: _partition0.o
+// DUMP-DAG: _partition1.o
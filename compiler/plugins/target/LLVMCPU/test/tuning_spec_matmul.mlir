@@ -0,0 +1,39 @@
+// RUN: iree-opt %s
+
+// Tuning spec in the form produced by `iree-tune-cpu`: each matcher checks the
+// root op name and the operand types of a tuned dispatch and annotates it with
+// the compilation info that benchmarked fastest. The marker attribute is only
+// added for testing.
+
+module @iree_cpu_tuning_spec attributes { transform.with_named_sequence } {
+transform.named_sequence @apply_op_config(%op: !transform.any_op {transform.readonly},
+                                          %config: !transform.any_param {transform.readonly}) {
+  transform.annotate %op "compilation_info" = %config : !transform.any_op, !transform.any_param
+  transform.annotate %op "__custom_tuning_spec_applied__" : !transform.any_op
+  transform.yield
+}
+
+transform.named_sequence @match_matmul_128x256x512_f32(%op: !transform.any_op {transform.readonly})
+  -> (!transform.any_op, !transform.any_param) {
+  transform.match.operation_name %op ["linalg.matmul"] : !transform.any_op
+  %operand0 = transform.get_operand %op[0] : (!transform.any_op) -> !transform.any_value
+  transform.iree.match.cast_compatible_type %operand0 = tensor<128x256xf32> : !transform.any_value
+  %operand1 = transform.get_operand %op[1] : (!transform.any_op) -> !transform.any_value
+  transform.iree.match.cast_compatible_type %operand1 = tensor<256x512xf32> : !transform.any_value
+  %operand2 = transform.get_operand %op[2] : (!transform.any_op) -> !transform.any_value
+  transform.iree.match.cast_compatible_type %operand2 = tensor<128x512xf32> : !transform.any_value
+  %config = transform.param.constant #iree_codegen.compilation_info<
+    lowering_config = #iree_codegen.lowering_config<tile_sizes = [[32, 128, 0], [32, 128, 0], [0, 0, 0], [8, 32, 0], [0, 0, 1], [0, 0, 0]]>,
+    translation_info = #iree_codegen.translation_info<pipeline = CPUDoubleTilingExpert>
+  > -> !transform.any_param
+  transform.yield %op, %config : !transform.any_op, !transform.any_param
+}
+
+transform.named_sequence @__kernel_config(%variant_op: !transform.any_op {transform.consumed}) -> (!transform.any_op)
+  attributes { iree_codegen.tuning_spec_entrypoint } {
+  %res = transform.foreach_match in %variant_op
+    @match_matmul_128x256x512_f32 -> @apply_op_config
+    : (!transform.any_op) -> !transform.any_op
+  transform.yield %res : !transform.any_op
+}
+}
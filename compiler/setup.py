@@ -510,6 +510,7 @@ setup(
             "iree-import-onnx = iree.compiler.tools.import_onnx.__main__:_cli_main",
             "iree-ir-tool = iree.compiler.tools.ir_tool.__main__:_cli_main",
             "iree-opt = iree.compiler.tools.scripts.iree_opt.__main__:main",
+            "iree-tune-cpu = iree.compiler.tools.tune_cpu.__main__:_cli_main",
         ],
     },
     install_requires=[
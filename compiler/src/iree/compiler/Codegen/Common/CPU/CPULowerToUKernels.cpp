@@ -12,6 +12,7 @@
 #include "iree/compiler/Codegen/Dialect/Codegen/IR/UKernelOps.h"
 #include "iree/compiler/Codegen/Utils/Utils.h"
 #include "iree/compiler/Dialect/Encoding/IR/EncodingOps.h"
+#include "iree/compiler/Dialect/LinalgExt/IR/LinalgExtOps.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Linalg/Utils/Utils.h"
@@ -473,6 +474,140 @@ matchDAGForUKernel(RewriterBase &rewriter, tensor::UnPackOp op,
       genericMicroKernelOp.getOperation());
 }
 
+/// Matches an iree_linalg_ext.topk along the inner dimension of a 2D input
+/// without an input indices operand, whose comparator is a plain
+/// `arith.cmpf ogt` (largest) or `arith.cmpf olt` (smallest), and converts it
+/// into a iree_codegen.ukernel.generic calling the topk microkernel.
+static FailureOr<IREE::Codegen::UKernelOpInterface>
+matchDAGForUKernel(RewriterBase &rewriter, IREE::LinalgExt::TopkOp op,
+                   bool /*skipIntermediateRoundings*/) {
+  auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(op);
+  const char ukernelName[] = "topk";
+  if (!hasUkernel(targetAttr, ukernelName)) {
+    return failure();
+  }
+  if (op.getIndices()) {
+    return rewriter.notifyMatchFailure(op, "unsupported input indices");
+  }
+  if (op.getInputRank() != 2 || op.getDimension() != 1) {
+    return rewriter.notifyMatchFailure(
+        op, "expected a reduction along the inner dimension of a 2D input");
+  }
+  Value in = op.getValues();
+  Value outValues = op.outputValues();
+  Value outIndices = op.outputIndices();
+  auto outValuesType = llvm::cast<ShapedType>(outValues.getType());
+  auto outIndicesType = llvm::cast<ShapedType>(outIndices.getType());
+  Type valueElemType = op.getInputType().getElementType();
+  uint32_t flags = 0;
+  if (!outIndicesType.getElementType().isSignlessInteger(32)) {
+    return rewriter.notifyMatchFailure(op, "expected i32 indices");
+  } else if (valueElemType.isF32()) {
+    flags = IREE_UK_FLAG_TOPK_TYPE_F32I32;
+  } else if (valueElemType.isF16()) {
+    flags = IREE_UK_FLAG_TOPK_TYPE_F16I32;
+  } else if (valueElemType.isBF16()) {
+    flags = IREE_UK_FLAG_TOPK_TYPE_BF16I32;
+  } else {
+    return rewriter.notifyMatchFailure(op, "unsupported value element type");
+  }
+
+  // The comparator must be exactly `cmpf(new_value, existing_value)`.
+  Block &block = op.getRegion().front();
+  if (block.getOperations().size() != 2) {
+    return rewriter.notifyMatchFailure(op, "expected a single-op comparator");
+  }
+  auto cmpOp = dyn_cast<arith::CmpFOp>(&block.front());
+  if (!cmpOp || cmpOp.getLhs() != block.getArgument(0) ||
+      cmpOp.getRhs() != block.getArgument(1) ||
+      block.getTerminator()->getOperand(0) != cmpOp.getResult()) {
+    return rewriter.notifyMatchFailure(op, "unsupported comparator");
+  }
+  if (cmpOp.getPredicate() == arith::CmpFPredicate::OLT) {
+    flags |= IREE_UK_FLAG_TOPK_SMALLEST;
+  } else if (cmpOp.getPredicate() != arith::CmpFPredicate::OGT) {
+    return rewriter.notifyMatchFailure(op, "unsupported comparison predicate");
+  }
+
+  Location loc = op.getLoc();
+  Value size0 = rewriter.create<tensor::DimOp>(loc, in, 0);
+  Value size1 = rewriter.create<tensor::DimOp>(loc, in, 1);
+  Value k = rewriter.create<tensor::DimOp>(loc, outValues, 1);
+  Value flagsVal = rewriter.create<arith::ConstantOp>(
+      loc, rewriter.getI32IntegerAttr(flags));
+  auto fn = getFnNameAndDefAttrs(ukernelName, rewriter, targetAttr);
+  SmallVector<Type> returnTypes =
+      getUKernelGenericReturnTypes(targetAttr, outValuesType);
+  returnTypes.insert(returnTypes.begin() + 1, outIndicesType);
+  auto genericMicroKernelOp = rewriter.create<IREE::Codegen::UKernelGenericOp>(
+      loc, returnTypes, fn.name, in, ValueRange{outValues, outIndices},
+      ValueRange{size0, size1, k, flagsVal},
+      /*fn_def_attrs=*/rewriter.getDictionaryAttr(fn.defAttrs),
+      /*strided_outer_dims=*/rewriter.getIndexAttr(1));
+  return cast<IREE::Codegen::UKernelOpInterface>(
+      genericMicroKernelOp.getOperation());
+}
+
+/// Matches a linalg.generic argmax (see `isArgmaxOp`) over the inner dimension
+/// of a 2D input and converts it into a iree_codegen.ukernel.generic calling
+/// the argmax microkernel. Only the index result is produced.
+static FailureOr<IREE::Codegen::UKernelOpInterface>
+matchArgmaxDAGForUKernel(RewriterBase &rewriter, linalg::GenericOp op) {
+  auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(op);
+  const char ukernelName[] = "argmax";
+  if (!hasUkernel(targetAttr, ukernelName)) {
+    return failure();
+  }
+  if (failed(isArgmaxOp(op))) {
+    return failure();
+  }
+  SmallVector<utils::IteratorType> iteratorTypes = op.getIteratorTypesArray();
+  if (iteratorTypes.size() != 2 ||
+      iteratorTypes[0] != utils::IteratorType::parallel ||
+      iteratorTypes[1] != utils::IteratorType::reduction) {
+    return rewriter.notifyMatchFailure(
+        op, "expected a reduction along the inner dimension of a 2D input");
+  }
+  Value in = op.getDpsInputOperand(0)->get();
+  Value outIndex = op.getDpsInitOperand(1)->get();
+  auto outIndexType = llvm::cast<ShapedType>(outIndex.getType());
+  Type inElemType = llvm::cast<ShapedType>(in.getType()).getElementType();
+  Type outElemType = outIndexType.getElementType();
+  uint32_t flags = 0;
+  if (inElemType.isF32() && outElemType.isSignlessInteger(32)) {
+    flags = IREE_UK_FLAG_ARGMAX_TYPE_F32I32;
+  } else if (inElemType.isF32() && outElemType.isSignlessInteger(64)) {
+    flags = IREE_UK_FLAG_ARGMAX_TYPE_F32I64;
+  } else if (inElemType.isF16() && outElemType.isSignlessInteger(32)) {
+    flags = IREE_UK_FLAG_ARGMAX_TYPE_F16I32;
+  } else if (inElemType.isF16() && outElemType.isSignlessInteger(64)) {
+    flags = IREE_UK_FLAG_ARGMAX_TYPE_F16I64;
+  } else if (inElemType.isBF16() && outElemType.isSignlessInteger(32)) {
+    flags = IREE_UK_FLAG_ARGMAX_TYPE_BF16I32;
+  } else if (inElemType.isBF16() && outElemType.isSignlessInteger(64)) {
+    flags = IREE_UK_FLAG_ARGMAX_TYPE_BF16I64;
+  } else {
+    return rewriter.notifyMatchFailure(
+        op, "unsupported combination of element types");
+  }
+
+  Location loc = op.getLoc();
+  Value size0 = rewriter.create<tensor::DimOp>(loc, in, 0);
+  Value size1 = rewriter.create<tensor::DimOp>(loc, in, 1);
+  Value flagsVal = rewriter.create<arith::ConstantOp>(
+      loc, rewriter.getI32IntegerAttr(flags));
+  auto fn = getFnNameAndDefAttrs(ukernelName, rewriter, targetAttr);
+  SmallVector<Type> returnTypes =
+      getUKernelGenericReturnTypes(targetAttr, outIndexType);
+  auto genericMicroKernelOp = rewriter.create<IREE::Codegen::UKernelGenericOp>(
+      loc, returnTypes, fn.name, in, outIndex,
+      ValueRange{size0, size1, flagsVal},
+      /*fn_def_attrs=*/rewriter.getDictionaryAttr(fn.defAttrs),
+      /*strided_outer_dims=*/rewriter.getIndexAttr(1));
+  return cast<IREE::Codegen::UKernelOpInterface>(
+      genericMicroKernelOp.getOperation());
+}
+
 static uint32_t
 getFlagForUserAndOperandTypes(IREE::Encoding::EncodingAttr encoding,
                               ArrayRef<Type> operandTypes) {
@@ -597,6 +732,35 @@ struct LowerToUKernelPattern : OpRewritePattern<OpType> {
   bool skipIntermediateRoundings;
 };
 
+/// The argmax generic op has two results, the max value and its index, of
+/// which only the index is produced by the microkernel. `isArgmaxOp` checks
+/// that the max value is unused.
+struct LowerArgmaxToUKernelPattern : OpRewritePattern<linalg::GenericOp> {
+  LowerArgmaxToUKernelPattern(MLIRContext *context,
+                              TargetPredicate targetPredicate)
+      : OpRewritePattern<linalg::GenericOp>(context),
+        targetPredicate(targetPredicate) {}
+
+  LogicalResult matchAndRewrite(linalg::GenericOp op,
+                                PatternRewriter &rewriter) const override {
+    if (targetPredicate &&
+        !targetPredicate(IREE::HAL::ExecutableTargetAttr::lookup(op))) {
+      return failure();
+    }
+    FailureOr<IREE::Codegen::UKernelOpInterface> ukernelOp =
+        matchArgmaxDAGForUKernel(rewriter, op);
+    if (failed(ukernelOp)) {
+      return rewriter.notifyMatchFailure(
+          op, "failed to find microkernel op to replace with");
+    }
+    rewriter.replaceAllUsesWith(op.getResults()[1],
+                                ukernelOp.value()->getResult(0));
+    return success();
+  }
+
+  TargetPredicate targetPredicate;
+};
+
 } // namespace
 
 void CPULowerToUKernelsPass::runOnOperation() {
@@ -619,6 +783,14 @@ void CPULowerToUKernelsPass::runOnOperation() {
                   LowerToUKernelPattern<tensor::PackOp>,
                   LowerToUKernelPattern<tensor::UnPackOp>>(
       context, allTargets, skipIntermediateRoundings);
+  // These patterns are opt-in through the `ukernels` target attribute, e.g.
+  // for the sampling step of LLM decode, where the ops are memory-bound scans
+  // over the vocabulary that codegen does not vectorize well. The VMVX backend
+  // has no module functions for them.
+  auto nonVMVXTargets = [](auto target) { return !isVMVXBackend(target); };
+  patterns.insert<LowerToUKernelPattern<IREE::LinalgExt::TopkOp>>(
+      context, nonVMVXTargets);
+  patterns.insert<LowerArgmaxToUKernelPattern>(context, nonVMVXTargets);
   // These patterns are inherently specific to the VMVX backend.
   patterns.insert<LowerToUKernelPattern<IREE::Codegen::QueryTileSizesOp>>(
       context, isVMVXBackend);
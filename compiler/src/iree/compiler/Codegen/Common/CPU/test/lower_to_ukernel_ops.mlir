@@ -577,3 +577,147 @@ func.func @mmt4d_i16u4i32_extend_producers(%arg0: tensor<10x10x1x8xi16>, %arg1:
 // CHECK-SAME:       ins(%[[ARG0]], %[[ARG1]] :
 // CHECK-SAME:       outs(%[[ARG2]] :
 //      CHECK:   return %[[MICRO_KERNEL]]#0
+
+// -----
+
+func.func @argmax_f32i64(%arg0 : tensor<?x?xf32>) -> tensor<?xi64> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "argmax", target_triple="x86_64-xyz-xyz", cpu_features=""}>
+} {
+  %c0 = arith.constant 0 : index
+  %c0_i64 = arith.constant 0 : i64
+  %cst = arith.constant 0xFF800000 : f32
+  %d0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+  %0 = tensor.empty(%d0) : tensor<?xi64>
+  %1 = linalg.fill ins(%c0_i64 : i64) outs(%0 : tensor<?xi64>) -> tensor<?xi64>
+  %2 = tensor.empty(%d0) : tensor<?xf32>
+  %3 = linalg.fill ins(%cst : f32) outs(%2 : tensor<?xf32>) -> tensor<?xf32>
+  %4:2 = linalg.generic {
+        indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>, affine_map<(d0, d1) -> (d0)>, affine_map<(d0, d1) -> (d0)>],
+        iterator_types = ["parallel", "reduction"]
+      }
+      ins(%arg0 : tensor<?x?xf32>) outs(%3, %1 : tensor<?xf32>, tensor<?xi64>) {
+  ^bb0(%in: f32, %out: f32, %out_0: i64):
+    %5 = linalg.index 1 : index
+    %6 = arith.index_cast %5 : index to i64
+    %7 = arith.maximumf %in, %out : f32
+    %8 = arith.cmpf ogt, %in, %out : f32
+    %9 = arith.select %8, %6, %out_0 : i64
+    linalg.yield %7, %9 : f32, i64
+  } -> (tensor<?xf32>, tensor<?xi64>)
+  return %4#1 : tensor<?xi64>
+}
+// CHECK-LABEL: func @argmax_f32i64(
+//  CHECK-SAME:     %[[ARG0:[a-zA-Z0-9]+]]: tensor<?x?xf32>
+//   CHECK-DAG:   %[[C0:.+]] = arith.constant 0 : index
+//   CHECK-DAG:   %[[C1:.+]] = arith.constant 1 : index
+//   CHECK-DAG:   %[[FLAGS:.+]] = arith.constant 2 : i32
+//   CHECK-DAG:   %[[FILL:.+]] = linalg.fill
+//   CHECK-DAG:   %[[D0:.+]] = tensor.dim %[[ARG0]], %[[C0]]
+//   CHECK-DAG:   %[[D1:.+]] = tensor.dim %[[ARG0]], %[[C1]]
+//       CHECK:   %[[MICRO_KERNEL:.+]]:2 = iree_codegen.ukernel.generic "iree_uk_argmax"
+//  CHECK-SAME:       ins(%[[ARG0]] :
+//  CHECK-SAME:       outs(%[[FILL]] :
+//  CHECK-SAME:       (%[[D0]], %[[D1]], %[[FLAGS]] :
+//   CHECK-NOT:   linalg.generic
+//       CHECK:   return %[[MICRO_KERNEL]]#0
+
+// -----
+
+// CHECK-LABEL: func @argmax_f32i64_default(
+//       CHECK:   linalg.generic
+//   CHECK-NOT:   iree_codegen.ukernel.generic
+func.func @argmax_f32i64_default(%arg0 : tensor<?x?xf32>) -> tensor<?xi64> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {target_triple="x86_64-xyz-xyz", cpu_features=""}>
+} {
+  %c0 = arith.constant 0 : index
+  %c0_i64 = arith.constant 0 : i64
+  %cst = arith.constant 0xFF800000 : f32
+  %d0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+  %0 = tensor.empty(%d0) : tensor<?xi64>
+  %1 = linalg.fill ins(%c0_i64 : i64) outs(%0 : tensor<?xi64>) -> tensor<?xi64>
+  %2 = tensor.empty(%d0) : tensor<?xf32>
+  %3 = linalg.fill ins(%cst : f32) outs(%2 : tensor<?xf32>) -> tensor<?xf32>
+  %4:2 = linalg.generic {
+        indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>, affine_map<(d0, d1) -> (d0)>, affine_map<(d0, d1) -> (d0)>],
+        iterator_types = ["parallel", "reduction"]
+      }
+      ins(%arg0 : tensor<?x?xf32>) outs(%3, %1 : tensor<?xf32>, tensor<?xi64>) {
+  ^bb0(%in: f32, %out: f32, %out_0: i64):
+    %5 = linalg.index 1 : index
+    %6 = arith.index_cast %5 : index to i64
+    %7 = arith.maximumf %in, %out : f32
+    %8 = arith.cmpf ogt, %in, %out : f32
+    %9 = arith.select %8, %6, %out_0 : i64
+    linalg.yield %7, %9 : f32, i64
+  } -> (tensor<?xf32>, tensor<?xi64>)
+  return %4#1 : tensor<?xi64>
+}
+
+// -----
+
+func.func @topk_f32i32(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x40xf32>, %arg2 : tensor<?x40xi32>) -> (tensor<?x40xf32>, tensor<?x40xi32>) attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "topk", target_triple="x86_64-xyz-xyz", cpu_features=""}>
+} {
+  %0:2 = iree_linalg_ext.topk dimension(1)
+      ins(%arg0 : tensor<?x?xf32>)
+      outs(%arg1, %arg2 : tensor<?x40xf32>, tensor<?x40xi32>) {
+  ^bb0(%lhs: f32, %rhs: f32):
+    %1 = arith.cmpf ogt, %lhs, %rhs : f32
+    iree_linalg_ext.yield %1 : i1
+  } -> tensor<?x40xf32>, tensor<?x40xi32>
+  return %0#0, %0#1 : tensor<?x40xf32>, tensor<?x40xi32>
+}
+// CHECK-LABEL: func @topk_f32i32(
+//  CHECK-SAME:     %[[ARG0:[a-zA-Z0-9]+]]: tensor<?x?xf32>
+//  CHECK-SAME:     %[[ARG1:[a-zA-Z0-9]+]]: tensor<?x40xf32>
+//  CHECK-SAME:     %[[ARG2:[a-zA-Z0-9]+]]: tensor<?x40xi32>
+//   CHECK-DAG:   %[[C0:.+]] = arith.constant 0 : index
+//   CHECK-DAG:   %[[C1:.+]] = arith.constant 1 : index
+//   CHECK-DAG:   %[[C40:.+]] = arith.constant 40 : index
+//   CHECK-DAG:   %[[FLAGS:.+]] = arith.constant 1 : i32
+//   CHECK-DAG:   %[[D0:.+]] = tensor.dim %[[ARG0]], %[[C0]]
+//   CHECK-DAG:   %[[D1:.+]] = tensor.dim %[[ARG0]], %[[C1]]
+//       CHECK:   %[[MICRO_KERNEL:.+]]:3 = iree_codegen.ukernel.generic "iree_uk_topk"
+//  CHECK-SAME:       ins(%[[ARG0]] :
+//  CHECK-SAME:       outs(%[[ARG1]], %[[ARG2]] :
+//  CHECK-SAME:       (%[[D0]], %[[D1]], %[[C40]], %[[FLAGS]] :
+//  CHECK-SAME:       strided_outer_dims(1)
+//       CHECK:   return %[[MICRO_KERNEL]]#0, %[[MICRO_KERNEL]]#1
+
+// -----
+
+func.func @topk_bf16i32_smallest(%arg0 : tensor<?x?xbf16>, %arg1 : tensor<?x?xbf16>, %arg2 : tensor<?x?xi32>) -> (tensor<?x?xbf16>, tensor<?x?xi32>) attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "all", target_triple="x86_64-xyz-xyz", cpu_features=""}>
+} {
+  %0:2 = iree_linalg_ext.topk dimension(1)
+      ins(%arg0 : tensor<?x?xbf16>)
+      outs(%arg1, %arg2 : tensor<?x?xbf16>, tensor<?x?xi32>) {
+  ^bb0(%lhs: bf16, %rhs: bf16):
+    %1 = arith.cmpf olt, %lhs, %rhs : bf16
+    iree_linalg_ext.yield %1 : i1
+  } -> tensor<?x?xbf16>, tensor<?x?xi32>
+  return %0#0, %0#1 : tensor<?x?xbf16>, tensor<?x?xi32>
+}
+// CHECK-LABEL: func @topk_bf16i32_smallest(
+//   CHECK-DAG:   %[[FLAGS:.+]] = arith.constant 259 : i32
+//       CHECK:   iree_codegen.ukernel.generic "iree_uk_topk"
+//  CHECK-SAME:       %[[FLAGS]] :
+
+// -----
+
+// The comparator operands are swapped, which the microkernel does not support.
+// CHECK-LABEL: func @topk_f32i32_unsupported_comparator(
+//       CHECK:   iree_linalg_ext.topk
+//   CHECK-NOT:   iree_codegen.ukernel.generic
+func.func @topk_f32i32_unsupported_comparator(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x40xf32>, %arg2 : tensor<?x40xi32>) -> (tensor<?x40xf32>, tensor<?x40xi32>) attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "all", target_triple="x86_64-xyz-xyz", cpu_features=""}>
+} {
+  %0:2 = iree_linalg_ext.topk dimension(1)
+      ins(%arg0 : tensor<?x?xf32>)
+      outs(%arg1, %arg2 : tensor<?x40xf32>, tensor<?x40xi32>) {
+  ^bb0(%lhs: f32, %rhs: f32):
+    %1 = arith.cmpf ogt, %rhs, %lhs : f32
+    iree_linalg_ext.yield %1 : i1
+  } -> tensor<?x40xf32>, tensor<?x40xi32>
+  return %0#0, %0#1 : tensor<?x40xf32>, tensor<?x40xi32>
+}
@@ -40,6 +40,8 @@
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 
+#include <limits>
+
 #define DEBUG_TYPE "iree-codegen-tile-and-distribute-to-workgroups"
 
 namespace mlir::iree_compiler {
@@ -206,13 +208,61 @@ static LogicalResult lowerDispatchWorkgroupCountForDagRootOp(
   return success();
 }
 
+/// Caps the total number of workgroups returned by the workgroup count region
+/// |body| to |workgroupsPerWorker| times the number of workers of the device
+/// the dispatch executes on. The worker count is queried at dispatch time so
+/// that the same executable does not oversubscribe hosts with few workers.
+/// Requires cyclic distribution so that each workgroup loops over all tiles
+/// assigned to it. The fastest varying dimensions are capped first.
+///
+/// Only oversubscription is handled: the count is never raised above one
+/// workgroup per tile, so workloads with fewer tiles than workers still leave
+/// workers idle as the tile sizes are fixed at compile time. The worker count
+/// is the device-wide `hal.dispatch :: concurrency` query, which the
+/// local-task device answers with the worker count of its first queue.
+static void capWorkgroupCountToWorkers(RewriterBase &rewriter, Block *body,
+                                       int64_t workgroupsPerWorker) {
+  auto returnOp = cast<IREE::HAL::ReturnOp>(body->getTerminator());
+  OpBuilder::InsertionGuard g(rewriter);
+  rewriter.setInsertionPoint(returnOp);
+  Location loc = returnOp.getLoc();
+  Value device = body->getArgument(0);
+  auto queryOp = rewriter.create<IREE::HAL::DeviceQueryOp>(
+      loc, rewriter.getI1Type(), rewriter.getIndexType(), device,
+      rewriter.getStringAttr("hal.dispatch"),
+      rewriter.getStringAttr("concurrency"), TypedAttr{});
+  Value one = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+  Value workerCount =
+      rewriter.create<arith::MaxUIOp>(loc, queryOp.getValue(), one);
+  Value budget = rewriter.create<arith::MulIOp>(
+      loc, workerCount,
+      rewriter.create<arith::ConstantIndexOp>(loc, workgroupsPerWorker));
+  // Devices that do not report their concurrency are not capped.
+  Value unlimited = rewriter.create<arith::ConstantIndexOp>(
+      loc, std::numeric_limits<int32_t>::max());
+  Value remaining = rewriter.create<arith::SelectOp>(loc, queryOp.getOk(),
+                                                     budget, unlimited);
+  SmallVector<Value> workgroupCount;
+  for (Value count : returnOp.getOperands()) {
+    Value capped = rewriter.create<arith::MinUIOp>(loc, count, remaining);
+    Value divisor = rewriter.create<arith::MaxUIOp>(loc, capped, one);
+    remaining = rewriter.create<arith::MaxUIOp>(
+        loc, rewriter.create<arith::DivUIOp>(loc, remaining, divisor), one);
+    workgroupCount.push_back(capped);
+  }
+  rewriter.modifyOpInPlace(returnOp,
+                           [&]() { returnOp->setOperands(workgroupCount); });
+}
+
 /// Lowers the computation within the workgroup count region for the ops
-/// that are handled by default.
+/// that are handled by default. If |workgroupsPerWorker| is non-zero the
+/// resulting workgroup count is capped based on the device worker count.
 static LogicalResult lowerWorkgroupCount(
     RewriterBase &rewriter, mlir::FunctionOpInterface entryPointFn,
     ArrayRef<OpFoldResult> workgroupCount, ArrayRef<int64_t> tileSizes,
     ArrayRef<int64_t> staticLoopRanges, ArrayRef<int64_t> interchange,
-    ArrayRef<unsigned> partitionedLoops, int maxWorkgroupParallelDims) {
+    ArrayRef<unsigned> partitionedLoops, int maxWorkgroupParallelDims,
+    int64_t workgroupsPerWorker) {
   std::optional<IREE::HAL::ExecutableExportOp> exportOp =
       getEntryPoint(entryPointFn);
   if (!exportOp) {
@@ -242,18 +292,28 @@ static LogicalResult lowerWorkgroupCount(
         "in body");
   }
 
-  return TypeSwitch<Operation *, LogicalResult>(countOps[0])
-      .Case<IREE::Flow::DispatchWorkgroupCountFromSliceOp>([&](auto countOp) {
-        return lowerWorkgroupCountFromSliceOp(rewriter, countOp, entryPointFn,
-                                              workgroupCount,
-                                              maxWorkgroupParallelDims);
-      })
-      .Case<IREE::Flow::DispatchWorkgroupCountFromDagRootOp>([&](auto countOp) {
-        return lowerDispatchWorkgroupCountForDagRootOp(
-            rewriter, countOp, tileSizes, staticLoopRanges, interchange,
-            partitionedLoops, maxWorkgroupParallelDims);
-      })
-      .Default([&](Operation *) { return success(); });
+  LogicalResult result =
+      TypeSwitch<Operation *, LogicalResult>(countOps[0])
+          .Case<IREE::Flow::DispatchWorkgroupCountFromSliceOp>(
+              [&](auto countOp) {
+                return lowerWorkgroupCountFromSliceOp(
+                    rewriter, countOp, entryPointFn, workgroupCount,
+                    maxWorkgroupParallelDims);
+              })
+          .Case<IREE::Flow::DispatchWorkgroupCountFromDagRootOp>(
+              [&](auto countOp) {
+                return lowerDispatchWorkgroupCountForDagRootOp(
+                    rewriter, countOp, tileSizes, staticLoopRanges,
+                    interchange, partitionedLoops, maxWorkgroupParallelDims);
+              })
+          .Default([&](Operation *) { return success(); });
+  if (failed(result)) {
+    return failure();
+  }
+  if (workgroupsPerWorker > 0) {
+    capWorkgroupCountToWorkers(rewriter, body, workgroupsPerWorker);
+  }
+  return success();
 }
 
 //===---------------------------------------------------------------------===//
@@ -347,7 +407,8 @@ void TileAndDistributeToWorkgroupsPass::runOnOperation() {
                         /*staticLoopRanges =*/ArrayRef<int64_t>{},
                         /*interchange =*/ArrayRef<int64_t>{},
                         /*partitionedLoops =*/ArrayRef<unsigned>{},
-                        maxWorkgroupParallelDims))) {
+                        maxWorkgroupParallelDims,
+                        /*workgroupsPerWorker=*/0))) {
       funcOp.emitOpError(
           "failed to lower workgroup count region when no compute ops in the "
           "dispatch");
@@ -369,6 +430,12 @@ void TileAndDistributeToWorkgroupsPass::runOnOperation() {
 
   linalg::DistributionMethod distributionMethodValue =
       (linalg::DistributionMethod)(distributionMethod.getValue());
+  // Only cyclic distribution loops over tiles and allows fewer workgroups
+  // than tiles.
+  int64_t workgroupsPerWorkerValue =
+      distributionMethodValue == linalg::DistributionMethod::Cyclic
+          ? workgroupsPerWorker.getValue()
+          : 0;
   auto linalgTilingOptions =
       linalg::LinalgTilingOptions()
           .setDistributionOptions(getIREELinalgLoopDistributionOptions(
@@ -392,9 +459,10 @@ void TileAndDistributeToWorkgroupsPass::runOnOperation() {
   if (exportOp) {
     auto workgroupCountOfr =
         getAsOpFoldResult(tileAndFuseResult->workgroupCount);
-    if (failed(lowerWorkgroupCount(
-            rewriter, funcOp, workgroupCountOfr, tileSizes, staticLoopRanges,
-            interchange, partitionableLoops, maxWorkgroupParallelDims))) {
+    if (failed(lowerWorkgroupCount(rewriter, funcOp, workgroupCountOfr,
+                                   tileSizes, staticLoopRanges, interchange,
+                                   partitionableLoops, maxWorkgroupParallelDims,
+                                   workgroupsPerWorkerValue))) {
       funcOp.emitOpError("workgroup count lowering failed");
       return signalPassFailure();
     }
@@ -0,0 +1,78 @@
+// RUN: iree-opt --pass-pipeline='builtin.module(hal.executable(hal.executable.variant(builtin.module(func.func(iree-codegen-tile-and-distribute-to-workgroups{workgroups-per-worker=4}, canonicalize)), cse)))' %s | FileCheck %s
+#config = #iree_codegen.lowering_config<tile_sizes = [[64, 64, 0], [16, 4, 0], [0, 0, 64]]>
+#pipeline_layout = #hal.pipeline.layout<constants = 3, bindings = [
+  #hal.pipeline.binding<storage_buffer>,
+  #hal.pipeline.binding<storage_buffer>,
+  #hal.pipeline.binding<storage_buffer>,
+  #hal.pipeline.binding<storage_buffer>
+]>
+#executable_target_embedded_elf_arm_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-arm_64", {
+  data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128",
+  native_vector_size = 16 : index,
+  target_triple = "aarch64-none-elf"
+}>
+#translation = #iree_codegen.translation_info<pipeline = CPUDoubleTilingExpert>
+hal.executable private @matmul_tensors {
+  hal.executable.variant public @llvm target(#executable_target_embedded_elf_arm_64_) {
+    hal.executable.export public @matmul_tensors layout(#pipeline_layout) {
+    ^bb0(%arg0: !hal.device, %arg1: index, %arg2 : index, %arg3 : index):
+      %x, %y, %z = flow.dispatch.workgroup_count_from_slice %arg1, %arg2, %arg3
+      hal.return %x, %y, %z : index, index, index
+    }
+    builtin.module {
+      func.func @matmul_tensors() attributes {translation_info = #translation} {
+        %cl_0 = hal.interface.constant.load layout(#pipeline_layout) ordinal(0) : index
+        %cl_1 = hal.interface.constant.load layout(#pipeline_layout) ordinal(1) : index
+        %cl_2 = hal.interface.constant.load layout(#pipeline_layout) ordinal(2) : index
+        %0 = flow.dispatch.workload.ordinal %cl_0, 0 : index
+        %1 = flow.dispatch.workload.ordinal %cl_1, 1 : index
+        %2 = flow.dispatch.workload.ordinal %cl_2, 2 : index
+        %3 = hal.interface.binding.subspan layout(#pipeline_layout) binding(0)
+            : !flow.dispatch.tensor<readonly:tensor<?x?xf32>>{%0, %2}
+        %4 = hal.interface.binding.subspan layout(#pipeline_layout) binding(1)
+            : !flow.dispatch.tensor<readonly:tensor<?x?xf32>>{%2, %1}
+        %5 = hal.interface.binding.subspan layout(#pipeline_layout) binding(2)
+            : !flow.dispatch.tensor<readonly:tensor<?x?xf32>>{%0, %1}
+        %6 = hal.interface.binding.subspan layout(#pipeline_layout) binding(3)
+            : !flow.dispatch.tensor<writeonly:tensor<?x?xf32>>{%0, %1}
+        %7 = flow.dispatch.tensor.load %3, offsets = [0, 0], sizes = [%0, %2], strides = [1, 1]
+            : !flow.dispatch.tensor<readonly:tensor<?x?xf32>>{%0, %2} -> tensor<?x?xf32>
+        %8 = flow.dispatch.tensor.load %4, offsets = [0, 0], sizes = [%2, %1], strides = [1, 1]
+            : !flow.dispatch.tensor<readonly:tensor<?x?xf32>>{%2, %1} -> tensor<?x?xf32>
+        %9 = flow.dispatch.tensor.load %5, offsets = [0, 0], sizes = [%0, %1], strides = [1, 1]
+            : !flow.dispatch.tensor<readonly:tensor<?x?xf32>>{%0, %1} -> tensor<?x?xf32>
+        %10 = linalg.matmul {lowering_config = #config}
+            ins(%7, %8 : tensor<?x?xf32>, tensor<?x?xf32>) outs(%9 : tensor<?x?xf32>) -> tensor<?x?xf32>
+        flow.dispatch.tensor.store %10, %6, offsets = [0, 0], sizes = [%0, %1], strides = [1, 1]
+            : tensor<?x?xf32> -> !flow.dispatch.tensor<writeonly:tensor<?x?xf32>>{%0, %1}
+        return
+      }
+    }
+  }
+}
+//      CHECK: #[[MAP0:.+]] = affine_map<()[s0] -> (s0 ceildiv 64)>
+//      CHECK: hal.executable.export public @matmul_tensors
+// CHECK-NEXT:   (%[[DEVICE:.+]]: !hal.device,
+// CHECK-SAME:    %[[WORKLOAD_M:[a-zA-Z0-9_]+]]: index
+// CHECK-SAME:    %[[WORKLOAD_N:[a-zA-Z0-9_]+]]: index
+// CHECK-SAME:    %[[WORKLOAD_K:[a-zA-Z0-9_]+]]: index)
+//  CHECK-DAG:    %[[D0:.+]] = affine.apply #[[MAP0]]()[%[[WORKLOAD_M]]]
+//  CHECK-DAG:    %[[D1:.+]] = affine.apply #[[MAP0]]()[%[[WORKLOAD_N]]]
+//      CHECK:    %[[OK:.+]], %[[WORKERS:.+]] = hal.device.query<%[[DEVICE]] : !hal.device> key("hal.dispatch" :: "concurrency") : i1, index
+//      CHECK:    %[[WORKERS_NZ:.+]] = arith.maxui %[[WORKERS]], %[[C1:[a-zA-Z0-9_]+]] : index
+//      CHECK:    %[[C4:.+]] = arith.constant 4 : index
+//      CHECK:    %[[BUDGET:.+]] = arith.muli %[[WORKERS_NZ]], %[[C4]]
+//      CHECK:    %[[UNLIMITED:.+]] = arith.constant 2147483647 : index
+//      CHECK:    %[[REMAINING_X:.+]] = arith.select %[[OK]], %[[BUDGET]], %[[UNLIMITED]]
+//      CHECK:    %[[X:.+]] = arith.minui %[[D1]], %[[REMAINING_X]]
+//      CHECK:    %[[X_NZ:.+]] = arith.maxui %[[X]], %[[C1]]
+//      CHECK:    %[[DIV_X:.+]] = arith.divui %[[REMAINING_X]], %[[X_NZ]]
+//      CHECK:    %[[REMAINING_Y:.+]] = arith.maxui %[[DIV_X]], %[[C1]]
+//      CHECK:    %[[Y:.+]] = arith.minui %[[D0]], %[[REMAINING_Y]]
+//      CHECK:    hal.return %[[X]], %[[Y]], %{{.+}} : index, index, index
+//      CHECK: func.func @matmul_tensors()
+//  CHECK-DAG:   %[[WG_ID_X:.+]] = hal.interface.workgroup.id[0]
+//  CHECK-DAG:   %[[WG_COUNT_X:.+]] = hal.interface.workgroup.count[0]
+//      CHECK:   scf.for %{{.+}} = %{{.+}} to %{{.+}} step %{{.+}}
+//      CHECK:     scf.for %{{.+}} = %{{.+}} to %{{.+}} step %{{.+}}
+//      CHECK:       linalg.matmul
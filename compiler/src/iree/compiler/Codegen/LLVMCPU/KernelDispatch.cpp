@@ -2340,6 +2340,41 @@ static LogicalResult setElementwiseGenericOpRootConfig(
       /*subgroupSize=*/{}, pipelineConfig);
 }
 
+/// Sets the lowering configuration for a row-wise reduction that is lowered to
+/// a microkernel (argmax, topk) by the CPUDataTiling pipeline. Rows are
+/// distributed across workgroups and each microkernel call reduces full rows,
+/// so the reduction dimension is never tiled.
+static LogicalResult
+setRowReductionUKernelRootConfig(mlir::FunctionOpInterface entryPointFn,
+                                 TilingInterface op) {
+  SmallVector<int64_t> distTileSizes =
+      getDefaultDistributedLevelTileSizes(op, DistributionHeuristicConfig{});
+  SmallVector<int64_t> vecTileSizes;
+  for (utils::IteratorType iteratorType : op.getLoopIteratorTypes()) {
+    vecTileSizes.push_back(
+        iteratorType == utils::IteratorType::parallel ? 1 : 0);
+  }
+  TileSizesListType tileSizes = {distTileSizes, vecTileSizes};
+  return setOpConfigAndEntryPointFnTranslation(
+      entryPointFn, op, tileSizes, DispatchLoweringPassPipeline::CPUDataTiling);
+}
+
+/// Sets the lowering configuration for an argmax generic op over the inner
+/// dimension of a 2D input when the argmax microkernel is enabled. Returns
+/// failure if the op is not such an argmax.
+static LogicalResult
+setArgmaxUKernelRootConfig(mlir::FunctionOpInterface entryPointFn,
+                           linalg::GenericOp genericOp) {
+  auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(entryPointFn);
+  if (!hasUkernel(targetAttr, "argmax") || genericOp.getNumLoops() != 2 ||
+      failed(isArgmaxOp(genericOp)) ||
+      !linalg::isReductionIterator(genericOp.getIteratorTypesArray()[1])) {
+    return failure();
+  }
+  return setRowReductionUKernelRootConfig(
+      entryPointFn, cast<TilingInterface>(genericOp.getOperation()));
+}
+
 /// Sets the lowering configuration for a generic op to use
 /// CPUDoubleTilingExpert pipeline.
 static LogicalResult
@@ -2349,6 +2384,9 @@ setRootConfig(mlir::FunctionOpInterface entryPointFn,
   assert(!getLoweringConfig(genericOp) &&
          "expected lowering_config is not set");
 
+  if (succeeded(setArgmaxUKernelRootConfig(entryPointFn, genericOp))) {
+    return success();
+  }
   if (succeeded(setTransposeLikeOpRootConfig(
           entryPointFn, genericOp, linalgOpInfo, targetMLTransInfo))) {
     return success();
@@ -2614,6 +2652,21 @@ static LogicalResult setRootConfig(mlir::FunctionOpInterface entryPointFn,
       entryPointFn, op, tileSizes, DispatchLoweringPassPipeline::CPUDefault);
 }
 
+/// Sets the lowering configuration for a topk op. The topk microkernel, when
+/// enabled, handles the reduction along the inner dimension of a 2D input
+/// without input indices; everything else uses the default configuration.
+static LogicalResult setRootConfig(mlir::FunctionOpInterface entryPointFn,
+                                   IREE::LinalgExt::TopkOp topkOp) {
+  assert(!getLoweringConfig(topkOp) && "expected lowering_config is not set");
+  auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(entryPointFn);
+  auto tilingInterfaceOp = cast<TilingInterface>(topkOp.getOperation());
+  if (hasUkernel(targetAttr, "topk") && !topkOp.getIndices() &&
+      topkOp.getInputRank() == 2 && topkOp.getDimension() == 1) {
+    return setRowReductionUKernelRootConfig(entryPointFn, tilingInterfaceOp);
+  }
+  return setRootConfig(entryPointFn, tilingInterfaceOp);
+}
+
 /// Redirects to methods that set the configuration based on operation type.
 static LogicalResult
 setRootConfigImpl(mlir::FunctionOpInterface entryPointFn, Operation *op,
@@ -2629,8 +2682,8 @@ setRootConfigImpl(mlir::FunctionOpInterface entryPointFn, Operation *op,
                                                   initCPULaunchConfig);
         })
         .Case<IREE::LinalgExt::AttentionOp, IREE::LinalgExt::FftOp,
-              tensor::PackOp, tensor::PadOp, tensor::UnPackOp, linalg::Mmt4DOp,
-              linalg::BatchMmt4DOp>(
+              IREE::LinalgExt::TopkOp, tensor::PackOp, tensor::PadOp,
+              tensor::UnPackOp, linalg::Mmt4DOp, linalg::BatchMmt4DOp>(
             [&](auto op) { return setRootConfig(entryPointFn, op); })
         .Case<IREE::LinalgExt::WinogradFilterTransformOp,
               IREE::LinalgExt::WinogradInputTransformOp,
@@ -111,13 +111,29 @@ static llvm::cl::opt<bool> clForceArmStreaming(
         "than SVE). Requires the +sme feature flag."),
     llvm::cl::init(false));
 
+static llvm::cl::opt<int64_t> clWorkgroupsPerWorker(
+    "iree-llvmcpu-workgroups-per-worker",
+    llvm::cl::desc(
+        "Caps the number of workgroups of each dispatch to this many per "
+        "worker of the device as queried at dispatch time. Workgroups then "
+        "process multiple tiles on devices with few workers. Only limits "
+        "oversubscription: tile sizes are fixed at compile time so dispatches "
+        "with fewer tiles than workers still leave workers idle. The worker "
+        "count is that of the device's first queue. 0 dispatches one "
+        "workgroup per tile. Not supported with "
+        "--iree-llvmcpu-tile-dispatch-using-forall."),
+    llvm::cl::init(0));
+
 // TODO: Enable `TileDispatchUsingForall` for every pipeline.
 static void addTileAndDistributePasses(OpPassManager &funcPassManager) {
   if (clTileDispatchUsingForall) {
     funcPassManager.addPass(
         createTileAndDistributeToWorkgroupsUsingForallOpPass());
   } else {
-    funcPassManager.addPass(createTileAndDistributeToWorkgroupsPass());
+    TileAndDistributeToWorkgroupsPassOptions tileAndDistributeOptions;
+    tileAndDistributeOptions.workgroupsPerWorker = clWorkgroupsPerWorker;
+    funcPassManager.addPass(
+        createTileAndDistributeToWorkgroupsPass(tileAndDistributeOptions));
     funcPassManager.addPass(createCSEPass());
     funcPassManager.addPass(createConvertToDestinationPassingStylePass());
     funcPassManager.addPass(createFoldAffineMinInDistributedLoopsPass());
@@ -800,6 +816,7 @@ void buildLLVMCPUCodegenConfigurationPassPipelineImpl(
     addCommonTargetExecutablePreprocessingPasses(funcPassManager,
                                                  clUseSoftmaxInterFusion);
   }
+  modulePassManager.addPass(createMaterializeTuningSpecsPass());
   modulePassManager.addPass(createMaterializeUserConfigsPass());
   FunctionLikeNest(modulePassManager)
       .addPass(createRematerializeParallelOpsPass)
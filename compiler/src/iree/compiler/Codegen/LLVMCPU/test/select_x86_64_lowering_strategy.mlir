@@ -2104,3 +2104,40 @@ func.func @complex_view_as_real() attributes {hal.executable.target = #executabl
 //      CHECK: func.func @complex_view_as_real()
 //      CHECK:   linalg.generic
 // CHECK-SAME:       lowering_config = #[[CONFIG]]
+
+// -----
+
+#pipeline_layout = #hal.pipeline.layout<bindings = [
+  #hal.pipeline.binding<storage_buffer>,
+  #hal.pipeline.binding<storage_buffer>,
+  #hal.pipeline.binding<storage_buffer>
+]>
+#executable_target_embedded_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {cpu_features = "+avx2", data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128", native_vector_size = 32 : index, target_triple = "x86_64-none-elf", ukernels = "topk"}>
+func.func @topk_ukernel() attributes {hal.executable.target = #executable_target_embedded_elf_x86_64_} {
+  %c0 = arith.constant 0 : index
+  %cst = arith.constant 0xFF800000 : f32
+  %c0_i32 = arith.constant 0 : i32
+  %0 = hal.interface.binding.subspan layout(#pipeline_layout) binding(0) alignment(64) offset(%c0) flags(ReadOnly) : !flow.dispatch.tensor<readonly:tensor<4x32000xf32>>
+  %1 = hal.interface.binding.subspan layout(#pipeline_layout) binding(1) alignment(64) offset(%c0) : !flow.dispatch.tensor<writeonly:tensor<4x40xf32>>
+  %2 = hal.interface.binding.subspan layout(#pipeline_layout) binding(2) alignment(64) offset(%c0) : !flow.dispatch.tensor<writeonly:tensor<4x40xi32>>
+  %3 = flow.dispatch.tensor.load %0, offsets = [0, 0], sizes = [4, 32000], strides = [1, 1] : !flow.dispatch.tensor<readonly:tensor<4x32000xf32>> -> tensor<4x32000xf32>
+  %4 = tensor.empty() : tensor<4x40xf32>
+  %5 = linalg.fill ins(%cst : f32) outs(%4 : tensor<4x40xf32>) -> tensor<4x40xf32>
+  %6 = tensor.empty() : tensor<4x40xi32>
+  %7 = linalg.fill ins(%c0_i32 : i32) outs(%6 : tensor<4x40xi32>) -> tensor<4x40xi32>
+  %8:2 = iree_linalg_ext.topk dimension(1) ins(%3 : tensor<4x32000xf32>) outs(%5, %7 : tensor<4x40xf32>, tensor<4x40xi32>) {
+  ^bb0(%lhs: f32, %rhs: f32):
+    %9 = arith.cmpf ogt, %lhs, %rhs : f32
+    iree_linalg_ext.yield %9 : i1
+  } -> tensor<4x40xf32>, tensor<4x40xi32>
+  flow.dispatch.tensor.store %8#0, %1, offsets = [0, 0], sizes = [4, 40], strides = [1, 1] : tensor<4x40xf32> -> !flow.dispatch.tensor<writeonly:tensor<4x40xf32>>
+  flow.dispatch.tensor.store %8#1, %2, offsets = [0, 0], sizes = [4, 40], strides = [1, 1] : tensor<4x40xi32> -> !flow.dispatch.tensor<writeonly:tensor<4x40xi32>>
+  return
+}
+
+//  CHECK-DAG: #[[CONFIG:.+]] = #iree_codegen.lowering_config<tile_sizes = {{\[}}[{{[0-9]+}}, 0], [1, 0]]>
+//  CHECK-DAG: #[[TRANSLATION:.+]] = #iree_codegen.translation_info<pipeline = CPUDataTiling>
+//      CHECK: func.func @topk_ukernel()
+// CHECK-SAME:     translation_info = #[[TRANSLATION]]
+//      CHECK:   iree_linalg_ext.topk
+// CHECK-SAME:       lowering_config = #[[CONFIG]]
@@ -5,14 +5,17 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include "iree/compiler/ConstEval/Passes.h"
+#include "iree/compiler/ConstEval/ResultCache.h"
 #include "iree/compiler/ConstEval/Runtime.h"
 #include "iree/compiler/Dialect/HAL/Target/TargetOptions.h"
 #include "iree/compiler/Dialect/Util/Analysis/Constant/ConstExpr.h"
 #include "iree/compiler/Dialect/Util/Analysis/Constant/OpOracle.h"
 #include "iree/compiler/Dialect/Util/IR/UtilOps.h"
 #include "iree/compiler/Pipelines/Pipelines.h"
+#include "iree/compiler/Utils/OptionUtils.h"
 #include "iree/compiler/Utils/PassUtils.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -20,8 +23,10 @@
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Diagnostics.h"
 #include "mlir/IR/IRMapping.h"
 #include "mlir/IR/SymbolTable.h"
+#include "mlir/IR/Threading.h"
 
 #include <cstdlib>
 
@@ -45,6 +50,20 @@ static llvm::cl::opt<bool> clEnableDebug(
         "don't want to run a debug compiler)."),
     llvm::cl::init(false));
 
+static llvm::cl::opt<std::string> clJitCacheDir(
+    "iree-consteval-jit-cache-dir",
+    llvm::cl::desc("Directory used to cache the results of evaluated "
+                   "initializers across compiler invocations. Initializers "
+                   "with cached results are neither compiled nor evaluated."),
+    llvm::cl::init(""));
+
+static llvm::cl::opt<llvm::cl::ByteSize> clJitCacheMaxSize(
+    "iree-consteval-jit-cache-max-size",
+    llvm::cl::desc("Maximum total size of the consteval cache directory "
+                   "(512mib, 4gib, etc). The least recently used results are "
+                   "evicted when exceeded. 0 disables the limit."),
+    llvm::cl::init(llvm::cl::ByteSize(4ll * 1024 * 1024 * 1024)));
+
 namespace {
 
 static bool isDebugEnabled() {
@@ -407,8 +426,67 @@ struct JitFunctionDesc {
   std::string name;
   llvm::SmallVector<ArgumentBinding> argumentBindings;
   llvm::SmallVector<ResultBinding> resultBindings;
+  // Digest of the function and the objects it uses when caching is enabled.
+  std::string digest;
+  // Key of the function results in the cache once the arguments are known.
+  std::string cacheKey;
+  // Results produced by evaluating the function.
+  llvm::SmallVector<TypedAttr> results;
 };
 
+// Appends the globals loaded by |jitFunction| to |loadedGlobals| and the ones
+// it stores to |storedGlobals|.
+static void getAccessedGlobals(JitFunctionDesc &jitFunction,
+                               SmallVectorImpl<Operation *> &loadedGlobals,
+                               SmallVectorImpl<Operation *> &storedGlobals) {
+  for (ArgumentBinding &arg : jitFunction.argumentBindings) {
+    if (arg.getType() == ArgumentBinding::Type::GlobalOp)
+      loadedGlobals.push_back(arg.getGlobalOp().getOperation());
+  }
+  for (ResultBinding &result : jitFunction.resultBindings) {
+    storedGlobals.push_back(result.getGlobalOp().getOperation());
+  }
+}
+
+// Partitions |jitFunctions| into waves such that functions only depend on
+// functions in prior waves. Arguments of all functions in a wave are gathered
+// before any of their results are applied, so a function may store a global
+// loaded by a function in the same wave but not one stored by it.
+static SmallVector<SmallVector<JitFunctionDesc *>>
+partitionIntoWaves(ArrayRef<JitFunctionDesc *> jitFunctions) {
+  SmallVector<SmallVector<JitFunctionDesc *>> waves;
+  DenseMap<Operation *, unsigned> lastLoadWave;
+  DenseMap<Operation *, unsigned> lastStoreWave;
+  for (JitFunctionDesc *jitFunction : jitFunctions) {
+    SmallVector<Operation *> loadedGlobals;
+    SmallVector<Operation *> storedGlobals;
+    getAccessedGlobals(*jitFunction, loadedGlobals, storedGlobals);
+    unsigned wave = 0;
+    for (Operation *globalOp : loadedGlobals) {
+      auto it = lastStoreWave.find(globalOp);
+      if (it != lastStoreWave.end())
+        wave = std::max(wave, it->second + 1);
+    }
+    for (Operation *globalOp : storedGlobals) {
+      auto it = lastStoreWave.find(globalOp);
+      if (it != lastStoreWave.end())
+        wave = std::max(wave, it->second + 1);
+      wave = std::max(wave, lastLoadWave.lookup(globalOp));
+    }
+    for (Operation *globalOp : loadedGlobals) {
+      unsigned &lastWave = lastLoadWave[globalOp];
+      lastWave = std::max(lastWave, wave);
+    }
+    for (Operation *globalOp : storedGlobals) {
+      lastStoreWave[globalOp] = wave;
+    }
+    if (wave >= waves.size())
+      waves.resize(wave + 1);
+    waves[wave].push_back(jitFunction);
+  }
+  return waves;
+}
+
 // Clones all object-like symbols used within the function.
 // Objects are only cloned once if used by multiple functions.
 // All object contents are cloned and symbol DCE is relied on to remove any
@@ -485,16 +563,19 @@ public:
                                 targetSymbolTable, moduleBuilder)))
       return failure();
 
+    // The function is transformed prior to being named uniquely so that
+    // its digest does not depend on the other initializers in the program.
     auto funcOp = moduleBuilder.create<IREE::Util::FuncOp>(
         initializerOp.getLoc(), "jit_eval",
         moduleBuilder.getFunctionType({}, {}));
-    targetSymbolTable.insert(funcOp);
     IRMapping unusedMapping;
     initializerOp.getBody().cloneInto(&funcOp.getBody(), unusedMapping);
     if (failed(transformToJitFunction(funcOp))) {
       funcOp.erase();
       return failure();
     }
+    targetSymbolTable.insert(funcOp);
+    jitFunctions.back().name = funcOp.getName().str();
     return success();
   }
 
@@ -598,10 +679,29 @@ private:
     termBuilder.create<IREE::Util::ReturnOp>(funcOp.getLoc(), returns);
     funcOp.setType(termBuilder.getFunctionType(argumentTypes, returnTypes));
 
+    if (!clJitCacheDir.empty()) {
+      desc.digest = getFunctionDigest(funcOp, getUsedObjects(funcOp));
+    }
+
     jitFunctions.push_back(std::move(desc));
     return success();
   }
 
+  // Returns the object-like ops in the target module used by |funcOp|.
+  SmallVector<Operation *> getUsedObjects(IREE::Util::FuncOp funcOp) {
+    llvm::SetVector<Operation *> objectOps;
+    auto uses = SymbolTable::getSymbolUses(funcOp);
+    if (!uses.has_value())
+      return {};
+    for (auto use : uses.value()) {
+      auto *objectOp =
+          targetSymbolTable.lookup(use.getSymbolRef().getRootReference());
+      if (objectOp && objectOp->hasTrait<OpTrait::IREE::Util::ObjectLike>())
+        objectOps.insert(objectOp);
+    }
+    return objectOps.takeVector();
+  }
+
   ModuleOp targetModuleOp;
   SymbolTable sourceSymbolTable;
   SymbolTable targetSymbolTable;
@@ -700,70 +800,199 @@ public:
     return s;
   }
 
-  LogicalResult
-  processFunctions(CompiledBinary &binary,
-                   llvm::SmallVector<JitFunctionDesc> &jitFunctions,
-                   ModuleOp module, llvm::TimerGroup &tg) {
-    // Process each function through the runtime.
+  // Returns the values bound to the arguments of |jitFunction|. Globals that
+  // have not been initialized yet have null values.
+  static SmallVector<Attribute>
+  getArgumentValues(JitFunctionDesc &jitFunction) {
+    SmallVector<Attribute> values;
+    for (ArgumentBinding &arg : jitFunction.argumentBindings) {
+      switch (arg.getType()) {
+      case ArgumentBinding::Type::ElementsAttr:
+        values.push_back(arg.getElementsAttr());
+        break;
+      case ArgumentBinding::Type::GlobalOp:
+        values.push_back(arg.getGlobalOp().getGlobalInitialValue());
+        break;
+      }
+    }
+    return values;
+  }
+
+  static void applyResults(JitFunctionDesc &jitFunction,
+                           ArrayRef<TypedAttr> results) {
+    for (auto [resultBinding, result] :
+         llvm::zip_equal(jitFunction.resultBindings, results)) {
+      switch (resultBinding.getType()) {
+      case ResultBinding::Type::GlobalOp:
+        resultBinding.getGlobalOp().setGlobalInitialValue(result);
+        break;
+      }
+    }
+  }
+
+  // Applies the cached results of |jitFunction| if available.
+  LogicalResult restoreFunctionFromCache(JitFunctionDesc &jitFunction) {
+    auto cacheKey = getResultCacheKey(jitFunction.digest, cacheConfiguration,
+                                      getArgumentValues(jitFunction));
+    if (failed(cacheKey))
+      return failure();
+    jitFunction.cacheKey = *cacheKey;
+
+    SmallVector<Type> resultTypes;
+    for (ResultBinding &resultBinding : jitFunction.resultBindings) {
+      resultTypes.push_back(resultBinding.getGlobalOp().getGlobalType());
+    }
+    auto results = lookupResultsInCache(&getContext(), clJitCacheDir,
+                                        jitFunction.cacheKey, resultTypes);
+    if (!results)
+      return failure();
+    if (debugEnabled) {
+      llvm::dbgs() << "::: Restored " << jitFunction.name << " from cache\n";
+    }
+    applyResults(jitFunction, *results);
+    return success();
+  }
+
+  // Restores the results of |jitFunctions| from the cache, erases the restored
+  // functions from |targetModuleOp|, and returns the functions that must still
+  // be evaluated. A function is only restored if no function preceding it that
+  // must be evaluated accesses the same globals so that all results are
+  // applied in program order.
+  SmallVector<JitFunctionDesc *>
+  restoreFromCache(MutableArrayRef<JitFunctionDesc> jitFunctions,
+                   ModuleOp targetModuleOp) {
+    SmallVector<JitFunctionDesc *> pendingFunctions;
+    DenseSet<Operation *> pendingGlobals;
     for (JitFunctionDesc &jitFunction : jitFunctions) {
-      std::optional<llvm::Timer> invokeTimer;
-      if (debugEnabled) {
-        std::string timerName("Invoke ");
-        timerName.append(jitFunction.name);
-        invokeTimer.emplace(timerName, timerName, tg);
-        invokeTimer->startTimer();
-        llvm::dbgs() << "::: Invoking " << jitFunction.name << "\n";
+      SmallVector<Operation *> accessedGlobals;
+      getAccessedGlobals(jitFunction, accessedGlobals, accessedGlobals);
+      bool dependsOnPending =
+          llvm::any_of(accessedGlobals, [&](Operation *op) {
+            return pendingGlobals.contains(op);
+          });
+      if (!dependsOnPending &&
+          succeeded(restoreFunctionFromCache(jitFunction))) {
+        SymbolTable::lookupSymbolIn(targetModuleOp, jitFunction.name)->erase();
+        ++cacheHits;
+        continue;
       }
+      pendingGlobals.insert(accessedGlobals.begin(), accessedGlobals.end());
+      pendingFunctions.push_back(&jitFunction);
+      ++cacheMisses;
+    }
+    return pendingFunctions;
+  }
 
-      FunctionCall call(binary, jitFunction.argumentBindings.size(),
-                        jitFunction.resultBindings.size());
-      if (failed(call.initialize(jitFunction.loc)))
-        return failure();
+  // Invokes |jitFunction| and converts its results. May be called concurrently
+  // for functions that do not depend on each other.
+  LogicalResult evaluateFunction(CompiledBinary &binary,
+                                 JitFunctionDesc &jitFunction,
+                                 llvm::TimerGroup &tg) {
+    std::optional<llvm::Timer> invokeTimer;
+    if (debugEnabled) {
+      std::string timerName("Invoke ");
+      timerName.append(jitFunction.name);
+      invokeTimer.emplace(timerName, timerName, tg);
+      invokeTimer->startTimer();
+    }
 
-      // Convert arguments.
-      for (ArgumentBinding &arg : jitFunction.argumentBindings) {
-        switch (arg.getType()) {
-        case ArgumentBinding::Type::ElementsAttr: {
-          if (failed(call.addArgument(jitFunction.loc, arg.getElementsAttr())))
-            return failure();
-          break;
-        }
-        case ArgumentBinding::Type::GlobalOp: {
-          auto globalValue = arg.getGlobalOp().getGlobalInitialValue();
-          if (!globalValue) {
-            return emitError(jitFunction.loc)
-                   << "internal error: jit global source initialization order "
-                      "invalid: global "
-                   << arg.getGlobalOp().getGlobalName() << " has no value";
-          }
-          if (failed(call.addArgument(arg.getGlobalOp().getLoc(), globalValue)))
-            return failure();
-        } break;
+    FunctionCall call(binary, jitFunction.argumentBindings.size(),
+                      jitFunction.resultBindings.size());
+    if (failed(call.initialize(jitFunction.loc)))
+      return failure();
+
+    // Convert arguments.
+    SmallVector<Attribute> argumentValues = getArgumentValues(jitFunction);
+    for (auto [arg, value] :
+         llvm::zip_equal(jitFunction.argumentBindings, argumentValues)) {
+      switch (arg.getType()) {
+      case ArgumentBinding::Type::ElementsAttr: {
+        if (failed(call.addArgument(jitFunction.loc, value)))
+          return failure();
+        break;
+      }
+      case ArgumentBinding::Type::GlobalOp: {
+        if (!value) {
+          return emitError(jitFunction.loc)
+                 << "internal error: jit global source initialization order "
+                    "invalid: global "
+                 << arg.getGlobalOp().getGlobalName() << " has no value";
         }
+        if (failed(call.addArgument(arg.getGlobalOp().getLoc(), value)))
+          return failure();
+      } break;
       }
+    }
 
-      if (failed(call.invoke(jitFunction.loc, jitFunction.name))) {
-        return failure();
+    // Functions that depended on evaluated globals have their key computed
+    // now that all of their arguments are available.
+    if (!clJitCacheDir.empty() && jitFunction.cacheKey.empty()) {
+      auto cacheKey = getResultCacheKey(jitFunction.digest, cacheConfiguration,
+                                        argumentValues);
+      if (succeeded(cacheKey))
+        jitFunction.cacheKey = *cacheKey;
+    }
+
+    if (failed(call.invoke(jitFunction.loc, jitFunction.name))) {
+      return failure();
+    }
+
+    // Process results.
+    for (auto it : llvm::enumerate(jitFunction.resultBindings)) {
+      ResultBinding &resultBinding = it.value();
+      switch (resultBinding.getType()) {
+      case ResultBinding::Type::GlobalOp: {
+        TypedAttr attr;
+        if (failed(call.getResultAsAttr(
+                resultBinding.getGlobalOp().getLoc(), it.index(),
+                resultBinding.getGlobalOp().getGlobalType(), attr)))
+          return failure();
+        jitFunction.results.push_back(attr);
+        break;
+      }
       }
+    }
+
+    if (debugEnabled) {
+      invokeTimer->stopTimer();
+    }
+    return success();
+  }
 
-      // Process results.
-      for (auto it : llvm::enumerate(jitFunction.resultBindings)) {
-        ResultBinding &resultBinding = it.value();
-        switch (resultBinding.getType()) {
-        case ResultBinding::Type::GlobalOp: {
-          TypedAttr attr;
-          if (failed(call.getResultAsAttr(
-                  resultBinding.getGlobalOp().getLoc(), it.index(),
-                  resultBinding.getGlobalOp().getGlobalType(), attr)))
-            return failure();
-          resultBinding.getGlobalOp().setGlobalInitialValue(attr);
-          break;
+  LogicalResult processFunctions(CompiledBinary &binary,
+                                 ArrayRef<JitFunctionDesc *> jitFunctions,
+                                 llvm::TimerGroup &tg) {
+    // Process each function through the runtime. Functions in the same wave
+    // are independent and evaluated concurrently when threading is enabled
+    // with their results applied in program order once all have completed.
+    for (auto &wave : partitionIntoWaves(jitFunctions)) {
+      if (debugEnabled) {
+        for (JitFunctionDesc *jitFunction : wave) {
+          llvm::dbgs() << "::: Invoking " << jitFunction->name << "\n";
         }
+      }
+      {
+        // Diagnostics are reported in program order regardless of which
+        // function completes first.
+        ParallelDiagnosticHandler diagnosticHandler(&getContext());
+        if (failed(failableParallelForEach(
+                &getContext(), 0, wave.size(), [&](size_t i) {
+                  diagnosticHandler.setOrderIDForThread(i);
+                  LogicalResult result = evaluateFunction(binary, *wave[i], tg);
+                  diagnosticHandler.eraseOrderIDForThread();
+                  return result;
+                }))) {
+          return failure();
         }
       }
-
-      if (debugEnabled) {
-        invokeTimer->stopTimer();
+      for (JitFunctionDesc *jitFunction : wave) {
+        applyResults(*jitFunction, jitFunction->results);
+        if (!jitFunction->cacheKey.empty()) {
+          storeResultsInCache(&getContext(), clJitCacheDir,
+                              jitFunction->cacheKey,
+                              clJitCacheMaxSize.getValue().value,
+                              jitFunction->results);
+        }
       }
     }
 
@@ -832,6 +1061,29 @@ public:
       return;
     }
 
+    // Restore any results available in the cache so that only the remaining
+    // functions need to be compiled.
+    SmallVector<JitFunctionDesc *> pendingFunctions;
+    if (!clJitCacheDir.empty()) {
+      cacheConfiguration.clear();
+      llvm::raw_string_ostream os(cacheConfiguration);
+      os << requestedTargetDevice << "\n" << *targetAttr;
+      os.flush();
+      pendingFunctions = restoreFromCache(programBuilder.getJitFunctions(),
+                                          programBuilder.getTargetModule());
+    } else {
+      for (JitFunctionDesc &jitFunction : programBuilder.getJitFunctions()) {
+        pendingFunctions.push_back(&jitFunction);
+      }
+    }
+    if (pendingFunctions.empty()) {
+      programBuilder.getTargetModule()->erase();
+      for (auto deadOp : deadInitOps) {
+        deadOp.erase();
+      }
+      return;
+    }
+
     std::optional<llvm::Timer> compileTimer;
     if (debugEnabled) {
       llvm::dbgs() << "::: COMPILING JIT (" << requestedTargetDevice
@@ -856,8 +1108,7 @@ public:
     programBuilder.getTargetModule()->erase();
 
     // Process the functions.
-    if (failed(processFunctions(binary, programBuilder.getJitFunctions(),
-                                outerModule, tg))) {
+    if (failed(processFunctions(binary, pendingFunctions, tg))) {
       signalPassFailure();
       return;
     }
@@ -875,6 +1126,8 @@ private:
   std::shared_ptr<CompileOptions> compileOptions;
   OpPassManager compilePipeline;
   std::string requestedTargetDevice;
+  // JIT configuration covered by cache keys in addition to the IR.
+  std::string cacheConfiguration;
   std::shared_ptr<IREE::HAL::TargetDevice> targetDevice;
   bool hasRequestedTargetDevice;
   bool debugEnabled = isDebugEnabled();
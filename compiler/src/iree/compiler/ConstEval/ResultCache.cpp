@@ -0,0 +1,167 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/ConstEval/ResultCache.h"
+
+#include <limits>
+
+#include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
+#include "iree/compiler/Utils/CacheUtils.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/DialectResourceBlobManager.h"
+#include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/Parser/Parser.h"
+
+namespace mlir::iree_compiler::ConstEval {
+
+// Extension of cache entry files. Entries are stored as MLIR bytecode and are
+// distinguished from those of other caches sharing the directory.
+static constexpr StringLiteral kCacheEntryExtension = ".consteval.mlirbc";
+
+// Attribute on the module stored in each cache entry holding the results.
+static constexpr StringLiteral kResultsAttrName = "iree.consteval.results";
+
+std::string getFunctionDigest(Operation *funcOp,
+                              ArrayRef<Operation *> objectOps) {
+  // Elided constants would make functions that differ only in their constant
+  // values hash identically so elision requested by printing flags is
+  // overridden.
+  OpPrintingFlags flags;
+  flags.enableDebugInfo(false).useLocalScope().elideLargeElementsAttrs(
+      std::numeric_limits<int64_t>::max());
+  llvm::SHA256 hasher;
+  {
+    SHA256Stream os(hasher);
+    funcOp->print(os, flags);
+    for (Operation *objectOp : objectOps) {
+      os << "\n";
+      objectOp->print(os, flags);
+    }
+  }
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+// Writes a unique representation of the argument value |attr| to |os|.
+static LogicalResult hashArgument(Attribute attr, llvm::raw_ostream &os) {
+  if (isa<IntegerAttr, FloatAttr>(attr)) {
+    os << attr;
+    return success();
+  }
+  if (auto denseAttr = dyn_cast<DenseElementsAttr>(attr);
+      denseAttr && denseAttr.isSplat()) {
+    // Avoids expanding the splat value when serializing.
+    os << denseAttr.getType() << ":" << denseAttr.getSplatValue<Attribute>();
+    return success();
+  }
+  if (auto resourceAttr = dyn_cast<DenseResourceElementsAttr>(attr)) {
+    // Resources whose contents were not loaded cannot be hashed.
+    if (!resourceAttr.getRawHandle().getBlob()) {
+      return failure();
+    }
+  }
+  auto serializableAttr = dyn_cast<IREE::Util::SerializableAttrInterface>(attr);
+  if (!serializableAttr) {
+    return failure();
+  }
+  if (auto typedAttr = dyn_cast<TypedAttr>(attr)) {
+    os << typedAttr.getType();
+  }
+  os << ":" << serializableAttr.getStorageSize() << ":";
+  return serializableAttr.serializeToStream(UnknownLoc::get(attr.getContext()),
+                                            llvm::endianness::little, os);
+}
+
+FailureOr<std::string> getResultCacheKey(StringRef functionDigest,
+                                         StringRef configuration,
+                                         ArrayRef<Attribute> arguments) {
+  // Results computed by an unidentifiable compiler build could be stale.
+  std::string buildIdentity = getCompilerBuildIdentity();
+  if (buildIdentity.empty()) {
+    return failure();
+  }
+  llvm::SHA256 hasher;
+  {
+    SHA256Stream os(hasher);
+    os << "iree-consteval-cache\n";
+    os << buildIdentity << "\n";
+    os << configuration << "\n" << functionDigest << "\n";
+    for (Attribute argument : arguments) {
+      if (!argument || failed(hashArgument(argument, os))) {
+        return failure();
+      }
+      os << "\n";
+    }
+  }
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+std::optional<SmallVector<TypedAttr>>
+lookupResultsInCache(MLIRContext *context, StringRef cachePath, StringRef key,
+                     TypeRange resultTypes) {
+  SmallString<256> entryPath;
+  getCacheEntryPath(cachePath, key, kCacheEntryExtension, entryPath);
+  if (!llvm::sys::fs::exists(entryPath)) {
+    return std::nullopt;
+  }
+
+  // Entries are written atomically so a parse failure or mismatched results
+  // indicate the entry was produced by an incompatible compiler; drop it so
+  // it gets regenerated.
+  auto dropEntry = [&]() -> std::optional<SmallVector<TypedAttr>> {
+    (void)llvm::sys::fs::remove(entryPath);
+    return std::nullopt;
+  };
+  OwningOpRef<ModuleOp> moduleOp;
+  {
+    ScopedDiagnosticHandler diagnosticHandler(
+        context, [](Diagnostic &) { return success(); });
+    ParserConfig parserConfig(context);
+    moduleOp = parseSourceFile<ModuleOp>(entryPath, parserConfig);
+  }
+  if (!moduleOp) {
+    return dropEntry();
+  }
+  auto resultsAttr = moduleOp->getOperation()->getAttrOfType<ArrayAttr>(
+      kResultsAttrName);
+  if (!resultsAttr || resultsAttr.size() != resultTypes.size()) {
+    return dropEntry();
+  }
+  SmallVector<TypedAttr> results;
+  for (auto [resultAttr, resultType] :
+       llvm::zip_equal(resultsAttr.getValue(), resultTypes)) {
+    auto typedAttr = dyn_cast<TypedAttr>(resultAttr);
+    if (!typedAttr || typedAttr.getType() != resultType) {
+      return dropEntry();
+    }
+    results.push_back(typedAttr);
+  }
+  touchCacheEntry(entryPath);
+  return results;
+}
+
+void storeResultsInCache(MLIRContext *context, StringRef cachePath,
+                         StringRef key, int64_t maxSize,
+                         ArrayRef<TypedAttr> results) {
+  // The results are stored as attributes so that restored values are
+  // identical to evaluated ones.
+  OwningOpRef<ModuleOp> moduleOp = ModuleOp::create(UnknownLoc::get(context));
+  SmallVector<Attribute> resultAttrs(results.begin(), results.end());
+  moduleOp->getOperation()->setAttr(kResultsAttrName,
+                                    ArrayAttr::get(context, resultAttrs));
+
+  (void)storeCacheEntry(cachePath, key, kCacheEntryExtension, moduleOp.get(),
+                        maxSize);
+}
+
+} // namespace mlir::iree_compiler::ConstEval
@@ -0,0 +1,55 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_COMPILER_CONSTEVAL_RESULTCACHE_H_
+#define IREE_COMPILER_CONSTEVAL_RESULTCACHE_H_
+
+#include <optional>
+#include <string>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/TypeRange.h"
+#include "mlir/Support/LogicalResult.h"
+
+namespace mlir::iree_compiler::ConstEval {
+
+// Returns a digest of the JIT function |funcOp| and the object-like ops it
+// references in |objectOps|. Locations are excluded so that the digest is
+// stable across source files producing the same program.
+std::string getFunctionDigest(Operation *funcOp,
+                              ArrayRef<Operation *> objectOps);
+
+// Returns a content-addressed key identifying the results of evaluating the
+// function with |functionDigest| on |arguments|. |configuration| must cover
+// all JIT options that may change the results but are not captured in IR.
+// The key covers the compiler build (see getCompilerBuildIdentity). Returns
+// failure if the build cannot be identified or if any argument value is null
+// or cannot be hashed (such as resources whose contents are not available).
+FailureOr<std::string> getResultCacheKey(StringRef functionDigest,
+                                         StringRef configuration,
+                                         ArrayRef<Attribute> arguments);
+
+// Returns the results stored under |key| in the cache directory at |cachePath|
+// if an entry exists and its results match |resultTypes|.
+std::optional<SmallVector<TypedAttr>>
+lookupResultsInCache(MLIRContext *context, StringRef cachePath, StringRef key,
+                     TypeRange resultTypes);
+
+// Stores |results| under |key| in the cache directory at |cachePath|. If
+// |maxSize| is non-zero the least recently used entries are evicted until the
+// total size of the cache is at most |maxSize| bytes. Failures to write the
+// cache are ignored as the cache is only an optimization.
+void storeResultsInCache(MLIRContext *context, StringRef cachePath,
+                         StringRef key, int64_t maxSize,
+                         ArrayRef<TypedAttr> results);
+
+} // namespace mlir::iree_compiler::ConstEval
+
+#endif // IREE_COMPILER_CONSTEVAL_RESULTCACHE_H_
@@ -488,8 +488,9 @@ LogicalResult CompiledBinary::initialize(Location loc, void *data,
         hal_module.get(),
         main_module.get(),
     };
+    // Independent functions are invoked concurrently by the JIT.
     status = iree_vm_context_create_with_modules(
-        runtime.instance.get(), IREE_VM_CONTEXT_FLAG_NONE, modules.size(),
+        runtime.instance.get(), IREE_VM_CONTEXT_FLAG_CONCURRENT, modules.size(),
         modules.data(), iree_allocator_system(), &context);
   }
 
@@ -0,0 +1,55 @@
+// Tests that evaluated initializers are restored from the consteval cache when
+// compiling the same program twice.
+// RUN: rm -rf %t.cache
+// RUN: iree-opt --iree-consteval-jit-globals --iree-consteval-jit-cache-dir=%t.cache --mlir-pass-statistics --mlir-pass-statistics-display=list %s -o %t.miss.mlir 2>&1 | FileCheck %s --check-prefix=MISS
+// RUN: iree-opt --iree-consteval-jit-globals --iree-consteval-jit-cache-dir=%t.cache --mlir-pass-statistics --mlir-pass-statistics-display=list %s -o %t.hit.mlir 2>&1 | FileCheck %s --check-prefix=HIT
+// RUN: diff %t.miss.mlir %t.hit.mlir
+// RUN: FileCheck %s --input-file=%t.hit.mlir
+
+#map = affine_map<(d0) -> (d0)>
+
+// CHECK-LABEL: @cached
+module @cached {
+  // CHECK: util.global private @a = dense<[2.000000e+00, 4.000000e+00, 6.000000e+00, 8.000000e+00]> : tensor<4xf32>
+  util.global private @a : tensor<4xf32>
+  // CHECK-NOT: util.initializer
+  util.initializer {
+    %cst = arith.constant dense<[1.0, 2.0, 3.0, 4.0]> : tensor<4xf32>
+    %0 = tensor.empty() : tensor<4xf32>
+    %1 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel"]} ins(%cst, %cst : tensor<4xf32>, tensor<4xf32>) outs(%0 : tensor<4xf32>) {
+    ^bb0(%arg0: f32, %arg1: f32, %arg2: f32):
+      %2 = arith.addf %arg0, %arg1 : f32
+      linalg.yield %2 : f32
+    } -> tensor<4xf32>
+    util.global.store %1, @a : tensor<4xf32>
+    util.return
+  }
+  // The key of this initializer covers the value of @a produced above.
+  // CHECK: util.global private @b = dense<[4.000000e+00, 1.600000e+01, 3.600000e+01, 6.400000e+01]> : tensor<4xf32>
+  util.global private @b : tensor<4xf32>
+  // CHECK-NOT: util.initializer
+  util.initializer {
+    %a = util.global.load @a : tensor<4xf32>
+    %0 = tensor.empty() : tensor<4xf32>
+    %1 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel"]} ins(%a, %a : tensor<4xf32>, tensor<4xf32>) outs(%0 : tensor<4xf32>) {
+    ^bb0(%arg0: f32, %arg1: f32, %arg2: f32):
+      %2 = arith.mulf %arg0, %arg1 : f32
+      linalg.yield %2 : f32
+    } -> tensor<4xf32>
+    util.global.store %1, @b : tensor<4xf32>
+    util.return
+  }
+  util.func public @main() -> (tensor<4xf32>, tensor<4xf32>) {
+    %a = util.global.load @a : tensor<4xf32>
+    %b = util.global.load @b : tensor<4xf32>
+    util.return %a, %b : tensor<4xf32>, tensor<4xf32>
+  }
+}
+
+// MISS-LABEL: JitGlobalsPass
+// MISS-DAG:     (S) 0 cache-hits
+// MISS-DAG:     (S) 2 cache-misses
+
+// HIT-LABEL: JitGlobalsPass
+// HIT-DAG:     (S) 2 cache-hits
+// HIT-DAG:     (S) 0 cache-misses
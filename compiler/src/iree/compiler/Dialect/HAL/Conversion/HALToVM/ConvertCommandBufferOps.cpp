@@ -8,12 +8,25 @@
 #include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
 #include "iree/compiler/Dialect/VM/Conversion/ImportUtils.h"
 #include "iree/compiler/Dialect/VM/IR/VMOps.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/TypeSwitch.h"
+#include "llvm/Support/CommandLine.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/Matchers.h"
 #include "mlir/Transforms/DialectConversion.h"
 
 namespace mlir::iree_compiler {
 
+static llvm::cl::opt<bool> clBatchCommandBufferRecording{
+    "iree-hal-batch-command-buffer-recording",
+    llvm::cl::desc("Records runs of dispatches and barriers into the same "
+                   "command buffer with a single "
+                   "hal.command_buffer.record_batch call using a command "
+                   "stream stored in rodata."),
+    llvm::cl::init(false),
+};
+
 namespace {
 
 // Returns a slot value and a buffer ref value.
@@ -476,6 +489,250 @@ private:
   mutable IREE::VM::ImportOp importOp;
 };
 
+// Encodes a command stream for hal.command_buffer.record_batch.
+// The format must match the decoder in runtime/src/iree/modules/hal/module.c.
+class CommandBatchEncoder {
+public:
+  enum class Opcode : uint32_t {
+    ExecutionBarrier = 1,
+    Dispatch = 2,
+  };
+
+  // Marks a value as an ordinal into the dynamic values list.
+  static constexpr uint64_t kDynamicValueBit = 1ull << 63;
+  // Ordinal of a null ref.
+  static constexpr uint32_t kNullOrdinal = 0xFFFFFFFFu;
+
+  CommandBatchEncoder(ConversionPatternRewriter &rewriter)
+      : rewriter(rewriter) {}
+
+  void appendExecutionBarrier(IREE::HAL::CommandBufferExecutionBarrierOp op) {
+    appendU32(static_cast<uint32_t>(Opcode::ExecutionBarrier));
+    appendU32(static_cast<uint32_t>(op.getSourceStageMask()));
+    appendU32(static_cast<uint32_t>(op.getTargetStageMask()));
+    appendU32(static_cast<uint32_t>(op.getFlags()));
+  }
+
+  void appendDispatch(IREE::HAL::CommandBufferDispatchOp op) {
+    appendU32(static_cast<uint32_t>(Opcode::Dispatch));
+    appendU32(getRefOrdinal(op.getExecutable(), executables,
+                            executableOrdinals));
+    appendValue(op.getEntryPoint());
+    appendValue(op.getWorkgroupX());
+    appendValue(op.getWorkgroupY());
+    appendValue(op.getWorkgroupZ());
+    appendU64(op.getFlagsAttr() ? op.getFlagsAttr().getInt() : 0);
+    appendU32(static_cast<uint32_t>(op.getConstants().size()));
+    for (auto constant : op.getConstants()) {
+      appendValue(constant);
+    }
+    appendU32(static_cast<uint32_t>(op.getBindingBuffers().size()));
+    for (auto [bufferOrSlot, offset, length] :
+         llvm::zip_equal(op.getBindingBuffers(), op.getBindingOffsets(),
+                         op.getBindingLengths())) {
+      if (isa<IREE::HAL::BufferType>(bufferOrSlot.getType())) {
+        // Direct buffer binding; slot 0.
+        appendU64(0);
+        appendU32(getRefOrdinal(bufferOrSlot, buffers, bufferOrdinals));
+      } else {
+        // Indirect binding table reference; null buffer.
+        appendValue(bufferOrSlot);
+        appendU32(kNullOrdinal);
+      }
+      appendValue(offset);
+      appendValue(length);
+    }
+  }
+
+  // Creates the call to |importOp| with the encoded commands.
+  IREE::VM::CallVariadicOp createCall(Location loc, Value commandBuffer,
+                                      IREE::VM::ImportOp importOp) {
+    auto bufferRefType =
+        IREE::VM::RefType::get(rewriter.getType<IREE::VM::BufferType>());
+    auto dataAttr = DenseElementsAttr::get(
+        VectorType::get({static_cast<int64_t>(bytes.size())},
+                        rewriter.getI8Type()),
+        ArrayRef<int8_t>(bytes));
+    Value commands = rewriter.create<IREE::VM::RodataInlineOp>(
+        loc, bufferRefType, rewriter.getStringAttr("command_batch"), dataAttr,
+        rewriter.getI64IntegerAttr(8), /*mime_type=*/StringAttr{});
+
+    SmallVector<Value> callOperands = {
+        commandBuffer,
+        commands,
+    };
+    llvm::append_range(callOperands, executables);
+    llvm::append_range(callOperands, buffers);
+    llvm::append_range(callOperands, values);
+    SmallVector<int16_t, 5> segmentSizes = {
+        /*command_buffer=*/-1,
+        /*commands=*/-1,
+        /*executables=*/static_cast<int16_t>(executables.size()),
+        /*buffers=*/static_cast<int16_t>(buffers.size()),
+        /*values=*/static_cast<int16_t>(values.size()),
+    };
+    auto importType = importOp.getFunctionType();
+    auto callOp = rewriter.create<IREE::VM::CallVariadicOp>(
+        loc, SymbolRefAttr::get(importOp), importType.getResults(),
+        segmentSizes, importType.getInputs(), callOperands);
+    copyImportAttrs(importOp, callOp);
+    return callOp;
+  }
+
+private:
+  void appendU32(uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      bytes.push_back(static_cast<int8_t>((value >> (i * 8)) & 0xFF));
+    }
+  }
+
+  void appendU64(uint64_t value) {
+    appendU32(static_cast<uint32_t>(value));
+    appendU32(static_cast<uint32_t>(value >> 32));
+  }
+
+  // Appends |value| as an immediate if it is a constant and otherwise as a
+  // reference to a dynamic operand.
+  void appendValue(Value value) {
+    APInt constantValue;
+    if (matchPattern(value, m_ConstantInt(&constantValue)) &&
+        constantValue.getBitWidth() <= 64) {
+      uint64_t immediate = constantValue.getZExtValue();
+      if (!(immediate & kDynamicValueBit)) {
+        appendU64(immediate);
+      } else {
+        // Immediates with the high bit set would decode as operand references
+        // so they are passed as operands instead. The constant op may be
+        // defined after the start of the run so we can't reference it and
+        // instead materialize a new constant at the call site.
+        // Note that these are usually all-ones sentinels (like whole buffer
+        // lengths) that DenseMap reserves as keys so we search linearly.
+        auto it = llvm::find_if(immediateOrdinals, [&](auto &entry) {
+          return entry.first == immediate;
+        });
+        if (it == immediateOrdinals.end()) {
+          immediateOrdinals.push_back({immediate, values.size()});
+          it = std::prev(immediateOrdinals.end());
+          values.push_back(rewriter.create<IREE::VM::ConstI64Op>(
+              value.getLoc(), static_cast<int64_t>(immediate)));
+        }
+        appendU64(kDynamicValueBit | it->second);
+      }
+      return;
+    }
+    Value remappedValue = rewriter.getRemappedValue(value);
+    auto it = valueOrdinals.find(remappedValue);
+    if (it == valueOrdinals.end()) {
+      it = valueOrdinals.insert({remappedValue, values.size()}).first;
+      values.push_back(castToImportType(remappedValue, rewriter.getI64Type(),
+                                        rewriter));
+    }
+    appendU64(kDynamicValueBit | it->second);
+  }
+
+  uint32_t getRefOrdinal(Value value, SmallVectorImpl<Value> &refs,
+                         llvm::DenseMap<Value, uint32_t> &ordinals) {
+    Value remappedValue = rewriter.getRemappedValue(value);
+    auto it = ordinals.find(remappedValue);
+    if (it == ordinals.end()) {
+      it = ordinals.insert({remappedValue, refs.size()}).first;
+      refs.push_back(remappedValue);
+    }
+    return it->second;
+  }
+
+  ConversionPatternRewriter &rewriter;
+  SmallVector<int8_t> bytes;
+  SmallVector<Value> executables;
+  llvm::DenseMap<Value, uint32_t> executableOrdinals;
+  SmallVector<Value> buffers;
+  llvm::DenseMap<Value, uint32_t> bufferOrdinals;
+  SmallVector<Value> values;
+  llvm::DenseMap<Value, uint64_t> valueOrdinals;
+  SmallVector<std::pair<uint64_t, uint64_t>> immediateOrdinals;
+};
+
+// Returns the command buffer |op| records into if it can be batched.
+static Value getBatchableCommandBuffer(Operation *op) {
+  return TypeSwitch<Operation *, Value>(op)
+      .Case<IREE::HAL::CommandBufferDispatchOp,
+            IREE::HAL::CommandBufferExecutionBarrierOp>(
+          [](auto op) { return op.getCommandBuffer(); })
+      .Default([](Operation *) { return Value{}; });
+}
+
+// Records a run of dispatches and barriers into the same command buffer with
+// one hal.command_buffer.record_batch call. The run starts at the matched op
+// and continues through consecutive batchable ops, skipping over constants as
+// those are encoded as immediates. Each dispatch otherwise requires a separate
+// import call with all of its operands marshaled through VM registers.
+template <typename OpT>
+class CommandBufferRecordBatchConversion : public OpConversionPattern<OpT> {
+public:
+  CommandBufferRecordBatchConversion(MLIRContext *context,
+                                     SymbolTable &importSymbols,
+                                     TypeConverter &typeConverter,
+                                     StringRef importName)
+      : OpConversionPattern<OpT>(typeConverter, context, /*benefit=*/2) {
+    importOp = importSymbols.lookup<IREE::VM::ImportOp>(importName);
+    assert(importOp);
+  }
+
+  LogicalResult
+  matchAndRewrite(OpT op, typename OpT::Adaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value commandBuffer = op.getCommandBuffer();
+
+    // Only the first op of a run starts a batch. If the prior op records into
+    // the same command buffer then it declined to batch and so do we.
+    for (Operation *prevOp = op->getPrevNode(); prevOp;
+         prevOp = prevOp->getPrevNode()) {
+      if (prevOp->hasTrait<OpTrait::ConstantLike>())
+        continue;
+      if (getBatchableCommandBuffer(prevOp) == commandBuffer)
+        return failure();
+      break;
+    }
+
+    SmallVector<Operation *> runOps;
+    int dispatchCount = 0;
+    for (Operation *nextOp = op; nextOp; nextOp = nextOp->getNextNode()) {
+      if (getBatchableCommandBuffer(nextOp) == commandBuffer) {
+        runOps.push_back(nextOp);
+        if (isa<IREE::HAL::CommandBufferDispatchOp>(nextOp))
+          ++dispatchCount;
+      } else if (!nextOp->hasTrait<OpTrait::ConstantLike>()) {
+        break;
+      }
+    }
+    // Nothing is gained by batching a single dispatch.
+    if (dispatchCount < 2)
+      return failure();
+
+    CommandBatchEncoder encoder(rewriter);
+    SmallVector<Location> runLocs;
+    for (Operation *runOp : runOps) {
+      runLocs.push_back(runOp->getLoc());
+      if (auto dispatchOp =
+              dyn_cast<IREE::HAL::CommandBufferDispatchOp>(runOp)) {
+        encoder.appendDispatch(dispatchOp);
+      } else {
+        encoder.appendExecutionBarrier(
+            cast<IREE::HAL::CommandBufferExecutionBarrierOp>(runOp));
+      }
+    }
+    encoder.createCall(rewriter.getFusedLoc(runLocs),
+                       adaptor.getCommandBuffer(), importOp);
+    for (Operation *runOp : runOps) {
+      rewriter.eraseOp(runOp);
+    }
+    return success();
+  }
+
+private:
+  mutable IREE::VM::ImportOp importOp;
+};
+
 } // namespace
 
 void populateHALCommandBufferToVMPatterns(MLIRContext *context,
@@ -512,6 +769,14 @@ void populateHALCommandBufferToVMPatterns(MLIRContext *context,
   patterns.insert<CommandBufferDispatchIndirectOpConversion>(
       context, importSymbols, typeConverter,
       "hal.command_buffer.dispatch.indirect");
+  if (clBatchCommandBufferRecording) {
+    patterns.insert<
+        CommandBufferRecordBatchConversion<IREE::HAL::CommandBufferDispatchOp>,
+        CommandBufferRecordBatchConversion<
+            IREE::HAL::CommandBufferExecutionBarrierOp>>(
+        context, importSymbols, typeConverter,
+        "hal.command_buffer.record_batch");
+  }
 }
 
 } // namespace mlir::iree_compiler
@@ -0,0 +1,88 @@
+// RUN: iree-opt --split-input-file --iree-vm-conversion --iree-hal-batch-command-buffer-recording --canonicalize --iree-vm-target-index-bits=32 %s | FileCheck %s
+
+// CHECK-LABEL: vm.func private @command_buffer_record_batch
+//  CHECK-SAME: (%[[CMD:[a-z0-9]+]]: !vm.ref<!hal.command_buffer>,
+//  CHECK-SAME:  %[[EXECUTABLE:[a-z0-9]+]]: !vm.ref<!hal.executable>,
+//  CHECK-SAME:  %[[BUFFER:[a-z0-9]+]]: !vm.ref<!hal.buffer>,
+//  CHECK-SAME:  %[[X:[a-z0-9]+]]: i32)
+util.func public @command_buffer_record_batch(
+  %cmd: !hal.command_buffer,
+  %executable: !hal.executable,
+  %buffer: !hal.buffer,
+  %x: index
+) {
+  %ordinal0 = arith.constant 0 : index
+  %ordinal1 = arith.constant 1 : index
+  %c1 = arith.constant 1 : index
+  %c4096 = arith.constant 4096 : index
+  %constant0 = arith.constant 31 : i32
+  // CHECK: %[[COMMANDS:.+]] = vm.rodata.inline "command_batch" {{.+}}: !vm.buffer
+  // CHECK: %[[X_I64:.+]] = vm.ext.i32.i64.u %[[X]]
+  // CHECK: vm.call.variadic @hal.command_buffer.record_batch
+  // CHECK-SAME: (%[[CMD]], %[[COMMANDS]], [%[[EXECUTABLE]]], [%[[BUFFER]]], [%[[X_I64]]])
+  // CHECK-NOT: @hal.command_buffer.dispatch
+  // CHECK-NOT: @hal.command_buffer.execution_barrier
+  hal.command_buffer.dispatch<%cmd : !hal.command_buffer>
+      target(%executable : !hal.executable)[%ordinal0]
+      workgroups([%x, %c1, %c1])
+      constants([%constant0])
+      bindings([
+        (%buffer : !hal.buffer)[%ordinal0, %c4096]
+      ])
+      flags(None)
+  hal.command_buffer.execution_barrier<%cmd : !hal.command_buffer>
+      source("Dispatch")
+      target("Dispatch")
+      flags("None")
+  hal.command_buffer.dispatch<%cmd : !hal.command_buffer>
+      target(%executable : !hal.executable)[%ordinal1]
+      workgroups([%x, %c1, %c1])
+      constants([%constant0])
+      bindings([
+        (%buffer : !hal.buffer)[%ordinal0, %c4096]
+      ])
+      flags(None)
+  util.return
+}
+
+// -----
+
+// Immediates with the high bit set would alias operand references in the
+// command stream and are passed as operands materialized at the call site.
+// The whole buffer length here is defined after the start of the run.
+
+// CHECK-LABEL: vm.func private @command_buffer_record_batch_high_bit_immediate
+//  CHECK-SAME: (%[[CMD:[a-z0-9]+]]: !vm.ref<!hal.command_buffer>,
+//  CHECK-SAME:  %[[EXECUTABLE:[a-z0-9]+]]: !vm.ref<!hal.executable>,
+//  CHECK-SAME:  %[[BUFFER:[a-z0-9]+]]: !vm.ref<!hal.buffer>)
+util.func public @command_buffer_record_batch_high_bit_immediate(
+  %cmd: !hal.command_buffer,
+  %executable: !hal.executable,
+  %buffer: !hal.buffer
+) {
+  %ordinal0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4096 = arith.constant 4096 : index
+  // CHECK-DAG: %[[COMMANDS:.+]] = vm.rodata.inline "command_batch" {{.+}}: !vm.buffer
+  // CHECK-DAG: %[[WHOLE:.+]] = vm.const.i64 -1
+  // CHECK: vm.call.variadic @hal.command_buffer.record_batch
+  // CHECK-SAME: (%[[CMD]], %[[COMMANDS]], [%[[EXECUTABLE]]], [%[[BUFFER]]], [%[[WHOLE]]])
+  // CHECK-NOT: @hal.command_buffer.dispatch
+  hal.command_buffer.dispatch<%cmd : !hal.command_buffer>
+      target(%executable : !hal.executable)[%ordinal0]
+      workgroups([%c1, %c1, %c1])
+      bindings([
+        (%buffer : !hal.buffer)[%ordinal0, %c4096]
+      ])
+      flags(None)
+  %whole = arith.constant -1 : index
+  hal.command_buffer.dispatch<%cmd : !hal.command_buffer>
+      target(%executable : !hal.executable)[%ordinal0]
+      workgroups([%c1, %c1, %c1])
+      bindings([
+        (%buffer : !hal.buffer)[%c4096, %whole],
+        (%buffer : !hal.buffer)[%ordinal0, %whole]
+      ])
+      flags(None)
+  util.return
+}
@@ -150,6 +150,26 @@ static llvm::cl::opt<bool> clLinkExecutables{
     llvm::cl::init(true),
 };
 
+static llvm::cl::opt<std::string> clExecutableCacheDir{
+    "iree-hal-executable-cache-dir",
+    llvm::cl::desc(
+        "Path to a directory used to cache translated and serialized "
+        "executables across compiler invocations. Executables are keyed by a "
+        "hash of their IR, target configuration, and the compiler build. "
+        "Compilers not built from a pinned source revision are identified by "
+        "the binary hosting them. Flags that change code generation without "
+        "being reflected in the IR are not part of the key."),
+    llvm::cl::init(""),
+};
+
+static llvm::cl::opt<llvm::cl::ByteSize> clExecutableCacheMaxSize{
+    "iree-hal-executable-cache-max-size",
+    llvm::cl::desc("Maximum total size of the executable cache directory "
+                   "(512mib, 4gb, etc). The least recently used executables "
+                   "are evicted when exceeded. 0 disables the limit."),
+    llvm::cl::init(llvm::cl::ByteSize(1024ll * 1024 * 1024)),
+};
+
 } // namespace
 
 using FunctionLikeNest =
@@ -421,7 +441,9 @@ void buildHALTransformPassPipeline(OpPassManager &passManager,
 
   if (compileFrom < PipelinePhase::ExecutableTargets) {
     passManager.addNestedPass<IREE::HAL::ExecutableOp>(
-        IREE::HAL::createTranslateAllExecutablesPass({targetRegistry}));
+        IREE::HAL::createTranslateAllExecutablesPass(
+            {targetRegistry, clExecutableCacheDir,
+             clExecutableCacheMaxSize.getValue().value}));
   }
 
   // If debug information is requested capture the translated MLIR source text
@@ -556,7 +578,8 @@ void buildHALTransformPassPipeline(OpPassManager &passManager,
         IREE::HAL::createSerializeAllExecutablesPass(
             {&targetRegistry, targetOptions.debugLevel,
              targetOptions.executableIntermediatesPath,
-             targetOptions.executableBinariesPath}));
+             targetOptions.executableBinariesPath, clExecutableCacheDir,
+             clExecutableCacheMaxSize.getValue().value}));
 
     // NOTE: symbol DCE will destroy executable target contents, so only run
     // it if we serialized things.
@@ -12,6 +12,7 @@
 #include "iree/compiler/Dialect/HAL/Target/TargetBackend.h"
 #include "iree/compiler/Dialect/HAL/Target/TargetRegistry.h"
 #include "iree/compiler/Dialect/HAL/Transforms/Passes.h"
+#include "iree/compiler/Dialect/HAL/Utils/ExecutableCacheUtils.h"
 #include "iree/compiler/Utils/TracingUtils.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/FileSystem.h"
@@ -106,6 +107,25 @@ struct SerializeAllExecutablesPass
       SerializeAllExecutablesPass>::SerializeAllExecutablesPassBase;
   void runOnOperation() override {
     auto executableOp = getOperation();
+
+    // Dumped intermediates and binaries are only produced by the target
+    // backends so the cache is bypassed when they are requested.
+    const bool useCache = !cachePath.empty() && isExecutableCacheSupported() &&
+                          dumpIntermediatesPath.empty() &&
+                          dumpBinariesPath.empty();
+    std::string cacheKey;
+    if (useCache) {
+      cacheKey =
+          getExecutableCacheKey(executableOp, "serialize",
+                                "debug-level=" + std::to_string(debugLevel));
+      if (succeeded(
+              restoreExecutableFromCache(cachePath, cacheKey, executableOp))) {
+        ++cacheHits;
+        return;
+      }
+      ++cacheMisses;
+    }
+
     OpPassManager passManager(executableOp.getOperationName());
     for (const auto &targetName : gatherExecutableTargetNames(executableOp)) {
       passManager.addPass(IREE::HAL::createSerializeTargetExecutablesPass(
@@ -119,6 +139,10 @@ struct SerializeAllExecutablesPass
       executableOp.emitError() << "failed to serialize executables";
       return signalPassFailure();
     }
+
+    if (useCache) {
+      storeExecutableInCache(cachePath, cacheKey, cacheMaxSize, executableOp);
+    }
   }
 };
 
@@ -12,6 +12,7 @@
 #include "iree/compiler/Dialect/HAL/Target/TargetBackend.h"
 #include "iree/compiler/Dialect/HAL/Target/TargetRegistry.h"
 #include "iree/compiler/Dialect/HAL/Transforms/Passes.h"
+#include "iree/compiler/Dialect/HAL/Utils/ExecutableCacheUtils.h"
 #include "iree/compiler/Utils/TracingUtils.h"
 #include "llvm/ADT/StringSet.h"
 #include "mlir/Dialect/Bufferization/IR/Bufferization.h"
@@ -96,6 +97,21 @@ struct TranslateAllExecutablesPass
 
   void runOnOperation() override {
     auto executableOp = getOperation();
+
+    // Translation is skipped entirely if a previous compilation translated an
+    // identical executable.
+    const bool useCache = !cachePath.empty() && isExecutableCacheSupported();
+    std::string cacheKey;
+    if (useCache) {
+      cacheKey = getExecutableCacheKey(executableOp, "translate", "");
+      if (succeeded(
+              restoreExecutableFromCache(cachePath, cacheKey, executableOp))) {
+        ++cacheHits;
+        return;
+      }
+      ++cacheMisses;
+    }
+
     OpPassManager passManager(executableOp.getOperationName());
     for (const auto &targetName : gatherExecutableTargetNames(executableOp)) {
       passManager.addNestedPass<IREE::HAL::ExecutableVariantOp>(
@@ -109,6 +125,10 @@ struct TranslateAllExecutablesPass
       llvm::errs() << "failed to translate executables\n";
       return signalPassFailure();
     }
+
+    if (useCache) {
+      storeExecutableInCache(cachePath, cacheKey, cacheMaxSize, executableOp);
+    }
   }
 };
 
@@ -0,0 +1,81 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/HAL/Utils/ExecutableCacheUtils.h"
+
+#include <limits>
+
+#include "iree/compiler/Utils/CacheUtils.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/SHA256.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/Parser/Parser.h"
+
+namespace mlir::iree_compiler::IREE::HAL {
+
+// Extension of cache entry files. Entries are stored as MLIR bytecode and are
+// distinguished from those of other caches sharing the directory.
+static constexpr StringLiteral kCacheEntryExtension = ".executable.mlirbc";
+
+bool isExecutableCacheSupported() {
+  return !getCompilerBuildIdentity().empty();
+}
+
+std::string getExecutableCacheKey(IREE::HAL::ExecutableOp executableOp,
+                                  StringRef stage, StringRef stageOptions) {
+  llvm::SHA256 hasher;
+  {
+    SHA256Stream os(hasher);
+    os << "iree-hal-executable-cache\n";
+    os << getCompilerBuildIdentity() << "\n";
+    os << stage << "\n" << stageOptions << "\n";
+    // Locations are included as they may be embedded in debug information.
+    // Printing in the local scope avoids walking the parent module that other
+    // threads may be mutating. Elision requested by printing flags would make
+    // executables differing only in their constants hash identically.
+    executableOp->print(os, OpPrintingFlags()
+                                .enableDebugInfo()
+                                .useLocalScope()
+                                .elideLargeElementsAttrs(
+                                    std::numeric_limits<int64_t>::max()));
+  }
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+LogicalResult restoreExecutableFromCache(StringRef cachePath, StringRef key,
+                                         IREE::HAL::ExecutableOp executableOp) {
+  SmallString<256> entryPath;
+  getCacheEntryPath(cachePath, key, kCacheEntryExtension, entryPath);
+  if (!llvm::sys::fs::exists(entryPath)) {
+    return failure();
+  }
+
+  // Entries are written atomically so a parse failure indicates the entry was
+  // produced by an incompatible compiler; drop it so it gets regenerated.
+  mlir::ParserConfig parserConfig(executableOp.getContext());
+  auto rootOpRef = mlir::parseSourceFile(entryPath, parserConfig);
+  auto cachedOp =
+      dyn_cast_if_present<IREE::HAL::ExecutableOp>(rootOpRef.get());
+  if (!cachedOp) {
+    (void)llvm::sys::fs::remove(entryPath);
+    return failure();
+  }
+  touchCacheEntry(entryPath);
+
+  executableOp.getBody().takeBody(cachedOp.getBody());
+  return success();
+}
+
+void storeExecutableInCache(StringRef cachePath, StringRef key,
+                            int64_t maxSize,
+                            IREE::HAL::ExecutableOp executableOp) {
+  (void)storeCacheEntry(cachePath, key, kCacheEntryExtension, executableOp,
+                        maxSize);
+}
+
+} // namespace mlir::iree_compiler::IREE::HAL
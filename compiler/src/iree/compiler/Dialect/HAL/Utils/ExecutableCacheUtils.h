@@ -0,0 +1,46 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_COMPILER_DIALECT_HAL_UTILS_EXECUTABLECACHEUTILS_H_
+#define IREE_COMPILER_DIALECT_HAL_UTILS_EXECUTABLECACHEUTILS_H_
+
+#include <string>
+
+#include "iree/compiler/Dialect/HAL/IR/HALOps.h"
+#include "llvm/ADT/StringRef.h"
+#include "mlir/Support/LogicalResult.h"
+
+namespace mlir::iree_compiler::IREE::HAL {
+
+// Returns true if executables may be cached by this compiler. Caching is
+// unsupported if the compiler build cannot be identified (see
+// getCompilerBuildIdentity) as stale code could otherwise be reused.
+bool isExecutableCacheSupported();
+
+// Returns a content-addressed key identifying the result of running the
+// pipeline |stage| on |executableOp|. The key covers the full executable IR
+// (including locations and target attributes), the compiler build, and any
+// |stageOptions| that influence the stage output but are not captured in IR.
+// Must only be used if isExecutableCacheSupported().
+std::string getExecutableCacheKey(IREE::HAL::ExecutableOp executableOp,
+                                  StringRef stage, StringRef stageOptions);
+
+// Replaces the contents of |executableOp| with those stored under |key| in the
+// cache directory at |cachePath|. Returns failure if no entry was found.
+LogicalResult restoreExecutableFromCache(StringRef cachePath, StringRef key,
+                                         IREE::HAL::ExecutableOp executableOp);
+
+// Stores the contents of |executableOp| under |key| in the cache directory at
+// |cachePath|. If |maxSize| is non-zero the least recently used entries are
+// evicted until the total size of the cache is at most |maxSize| bytes.
+// Failures to write the cache are ignored as the cache is only an optimization.
+void storeExecutableInCache(StringRef cachePath, StringRef key,
+                            int64_t maxSize,
+                            IREE::HAL::ExecutableOp executableOp);
+
+} // namespace mlir::iree_compiler::IREE::HAL
+
+#endif // IREE_COMPILER_DIALECT_HAL_UTILS_EXECUTABLECACHEUTILS_H_
@@ -322,6 +322,21 @@ vm.import private @command_buffer.dispatch.indirect(
   %bindings : tuple<i32, i32, !vm.ref<!hal.buffer>, i64, i64>...
 )
 
+// Records a sequence of dispatches and barriers encoded in |commands|.
+// Executables, buffers, and dynamic values are referenced by ordinal into the
+// variadic lists. See iree_hal_module_command_buffer_record_batch for the
+// encoding.
+vm.import private @command_buffer.record_batch(
+  %command_buffer : !vm.ref<!hal.command_buffer>,
+  %commands : !vm.buffer,
+  %executables : !vm.ref<!hal.executable> ...,
+  %buffers : !vm.ref<!hal.buffer> ...,
+  %values : i64 ...
+)
+attributes {
+  minimum_version = 6 : i32  // command buffer batch recording
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_device_t
 //===----------------------------------------------------------------------===//
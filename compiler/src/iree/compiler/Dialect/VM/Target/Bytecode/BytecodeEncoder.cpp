@@ -11,6 +11,7 @@
 #include "iree/compiler/Dialect/VM/IR/VMDialect.h"
 #include "iree/compiler/Dialect/VM/IR/VMTypes.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/TypeSwitch.h"
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/Diagnostics.h"
 
@@ -47,9 +48,25 @@ public:
     return success();
   }
 
+  // Begins a superinstruction with the given fused |opcode|. The ops encoded
+  // until endSuperinstruction is called have their own opcodes elided such that
+  // only their operands follow the fused opcode.
+  LogicalResult beginSuperinstruction(Opcode opcode) {
+    inSuperinstruction_ = true;
+    return writeUint8(static_cast<uint8_t>(opcode));
+  }
+
+  LogicalResult endSuperinstruction() {
+    inSuperinstruction_ = false;
+    return success();
+  }
+
   LogicalResult encodeI8(int value) override { return writeUint8(value); }
 
   LogicalResult encodeOpcode(StringRef name, int opcode) override {
+    if (inSuperinstruction_) {
+      return success();
+    }
     return writeUint8(opcode);
   }
 
@@ -346,6 +363,7 @@ private:
   RegisterAllocation *registerAllocation_;
 
   Operation *currentOp_ = nullptr;
+  bool inSuperinstruction_ = false;
 
   std::vector<uint8_t> bytecode_;
   llvm::DenseMap<Block *, size_t> blockOffsets_;
@@ -354,10 +372,72 @@ private:
 
 } // namespace
 
+// Returns true if |user| immediately follows |def| and uses its result as the
+// operand at |operandIndex|.
+static bool isFedByPreviousOp(Operation *def, Operation *user,
+                              unsigned operandIndex) {
+  return user && def->getNextNode() == user && def->getNumResults() == 1 &&
+         user->getNumOperands() > operandIndex &&
+         user->getOperand(operandIndex) == def->getResult(0);
+}
+
+// Matches the sequence of ops starting at |op| against the superinstructions
+// supported by the runtime and returns the fused opcode and the number of ops
+// it covers. The sequences are the most frequent adjacent op pairs and triples
+// in host code: compare-and-branch as produced by scf.if/cf.cond_br lowering
+// and the increment/compare/branch latch of scf.for/scf.while loops.
+static std::optional<std::pair<Opcode, int>>
+matchSuperinstruction(Operation *op) {
+  Operation *nextOp = op->getNextNode();
+  Operation *branchOp = nextOp ? nextOp->getNextNode() : nullptr;
+  if (isFedByPreviousOp(op, nextOp, 0) &&
+      isFedByPreviousOp(nextOp, branchOp, 0) &&
+      isa<IREE::VM::CondBranchOp>(branchOp)) {
+    if (isa<IREE::VM::AddI32Op>(op) && isa<IREE::VM::CmpLTI32SOp>(nextOp)) {
+      return std::make_pair(Opcode::AddI32CmpLTI32SCondBranch, 3);
+    } else if (isa<IREE::VM::AddI64Op>(op) &&
+               isa<IREE::VM::CmpLTI64SOp>(nextOp)) {
+      return std::make_pair(Opcode::AddI64CmpLTI64SCondBranch, 3);
+    }
+  }
+  if (isFedByPreviousOp(op, nextOp, 0) &&
+      isa<IREE::VM::CondBranchOp>(nextOp)) {
+    auto opcode =
+        llvm::TypeSwitch<Operation *, std::optional<Opcode>>(op)
+            .Case([](IREE::VM::CmpEQI32Op) {
+              return Opcode::CmpEQI32CondBranch;
+            })
+            .Case([](IREE::VM::CmpNEI32Op) {
+              return Opcode::CmpNEI32CondBranch;
+            })
+            .Case([](IREE::VM::CmpLTI32SOp) {
+              return Opcode::CmpLTI32SCondBranch;
+            })
+            .Case([](IREE::VM::CmpEQI64Op) {
+              return Opcode::CmpEQI64CondBranch;
+            })
+            .Case([](IREE::VM::CmpNEI64Op) {
+              return Opcode::CmpNEI64CondBranch;
+            })
+            .Case([](IREE::VM::CmpLTI64SOp) {
+              return Opcode::CmpLTI64SCondBranch;
+            })
+            .Case([](IREE::VM::CmpNZRefOp) {
+              return Opcode::CmpNZRefCondBranch;
+            })
+            .Default([](Operation *) { return std::nullopt; });
+    if (opcode) {
+      return std::make_pair(*opcode, 2);
+    }
+  }
+  return std::nullopt;
+}
+
 // static
 std::optional<EncodedBytecodeFunction> BytecodeEncoder::encodeFunction(
     IREE::VM::FuncOp funcOp, llvm::DenseMap<Type, int> &typeTable,
-    SymbolTable &symbolTable, DebugDatabaseBuilder &debugDatabase) {
+    SymbolTable &symbolTable, DebugDatabaseBuilder &debugDatabase,
+    bool enableSuperinstructions) {
   EncodedBytecodeFunction result;
 
   // Perform register allocation first so that we can quickly lookup values as
@@ -380,6 +460,9 @@ std::optional<EncodedBytecodeFunction> BytecodeEncoder::encodeFunction(
       return std::nullopt;
     }
 
+    // Number of ops following the current one that are encoded as part of the
+    // same superinstruction.
+    int fusedOpsRemaining = 0;
     for (auto &op : block.getOperations()) {
       auto serializableOp = dyn_cast<IREE::VM::VMSerializableOp>(op);
       if (!serializableOp) {
@@ -390,14 +473,34 @@ std::optional<EncodedBytecodeFunction> BytecodeEncoder::encodeFunction(
         op.emitOpError() << "is not serializable";
         return std::nullopt;
       }
-      sourceMap.locations.push_back(
-          {static_cast<int32_t>(encoder.getOffset()), op.getLoc()});
+      bool endsSuperinstruction = false;
+      if (fusedOpsRemaining > 0) {
+        // Continuation of a superinstruction; the op shares the source
+        // location of the first op in the sequence.
+        endsSuperinstruction = --fusedOpsRemaining == 0;
+      } else {
+        sourceMap.locations.push_back(
+            {static_cast<int32_t>(encoder.getOffset()), op.getLoc()});
+        if (enableSuperinstructions) {
+          if (auto fused = matchSuperinstruction(&op)) {
+            if (failed(encoder.beginSuperinstruction(fused->first))) {
+              op.emitOpError() << "failed to encode";
+              return std::nullopt;
+            }
+            fusedOpsRemaining = fused->second - 1;
+          }
+        }
+      }
       if (failed(encoder.beginOp(&op)) ||
           failed(serializableOp.encode(symbolTable, encoder)) ||
           failed(encoder.endOp(&op))) {
         op.emitOpError() << "failed to encode";
         return std::nullopt;
       }
+      if (endsSuperinstruction && failed(encoder.endSuperinstruction())) {
+        op.emitOpError() << "failed to encode";
+        return std::nullopt;
+      }
     }
 
     if (failed(encoder.endBlock(&block))) {
@@ -36,14 +36,17 @@ public:
   // Matches IREE_VM_BYTECODE_VERSION_MAJOR.
   static constexpr uint32_t kVersionMajor = 15;
   // Matches IREE_VM_BYTECODE_VERSION_MINOR.
-  static constexpr uint32_t kVersionMinor = 0;
+  static constexpr uint32_t kVersionMinor = 1;
   static constexpr uint32_t kVersion = (kVersionMajor << 16) | kVersionMinor;
 
   // Encodes a vm.func to bytecode and returns the result.
+  // If |enableSuperinstructions| is set then common sequences of adjacent ops
+  // are fused into single superinstructions to reduce dispatch overhead.
   // Returns None on failure.
   static std::optional<EncodedBytecodeFunction>
   encodeFunction(IREE::VM::FuncOp funcOp, llvm::DenseMap<Type, int> &typeTable,
-                 SymbolTable &symbolTable, DebugDatabaseBuilder &debugDatabase);
+                 SymbolTable &symbolTable, DebugDatabaseBuilder &debugDatabase,
+                 bool enableSuperinstructions = true);
 
   BytecodeEncoder() = default;
   ~BytecodeEncoder() = default;
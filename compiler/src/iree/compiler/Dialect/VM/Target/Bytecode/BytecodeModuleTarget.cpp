@@ -363,7 +363,8 @@ buildFlatBufferModule(IREE::VM::TargetOptions vmOptions,
   size_t totalBytecodeLength = 0;
   for (auto [i, funcOp] : llvm::enumerate(internalFuncOps)) {
     auto encodedFunction = BytecodeEncoder::encodeFunction(
-        funcOp, typeOrdinalMap, symbolTable, debugDatabase);
+        funcOp, typeOrdinalMap, symbolTable, debugDatabase,
+        bytecodeOptions.emitSuperinstructions);
     if (!encodedFunction) {
       return funcOp.emitError() << "failed to encode function bytecode";
     }
@@ -561,8 +562,12 @@ buildFlatBufferModule(IREE::VM::TargetOptions vmOptions,
   iree_vm_BytecodeModuleDef_rwdata_segments_add(fbb, rwdataSegmentsRef);
   iree_vm_BytecodeModuleDef_function_descriptors_add(fbb,
                                                      functionDescriptorsRef);
-  iree_vm_BytecodeModuleDef_bytecode_version_add(fbb,
-                                                 BytecodeEncoder::kVersion);
+  // Modules without superinstructions remain loadable by runtimes that
+  // predate them.
+  iree_vm_BytecodeModuleDef_bytecode_version_add(
+      fbb, bytecodeOptions.emitSuperinstructions
+               ? BytecodeEncoder::kVersion
+               : BytecodeEncoder::kVersionMajor << 16);
   iree_vm_BytecodeModuleDef_bytecode_data_add(fbb, bytecodeDataRef);
   iree_vm_BytecodeModuleDef_debug_database_add(fbb, debugDatabaseRef);
   iree_vm_BytecodeModuleDef_end_as_root(fbb);
@@ -747,6 +752,11 @@ void BytecodeTargetOptions::bindOptions(OptionsBinder &binder) {
   binder.opt<bool>("iree-vm-bytecode-module-strip-debug-ops", stripDebugOps,
                    llvm::cl::cat(vmBytecodeOptionsCategory),
                    llvm::cl::desc("Strips debug-only ops from the module"));
+  binder.opt<bool>(
+      "iree-vm-bytecode-module-superinstructions", emitSuperinstructions,
+      llvm::cl::cat(vmBytecodeOptionsCategory),
+      llvm::cl::desc("Fuses common sequences of ops into superinstructions to "
+                     "reduce interpreter dispatch overhead"));
   binder.opt<bool>(
       "iree-vm-emit-polyglot-zip", emitPolyglotZip,
       llvm::cl::cat(vmBytecodeOptionsCategory),
@@ -0,0 +1,75 @@
+// RUN: iree-compile --split-input-file --compile-mode=vm \
+// RUN: --iree-vm-bytecode-module-output-format=flatbuffer-text %s | \
+// RUN: FileCheck %s
+// RUN: iree-compile --split-input-file --compile-mode=vm \
+// RUN: --iree-vm-bytecode-module-output-format=flatbuffer-text \
+// RUN: --iree-vm-bytecode-module-superinstructions=false %s | \
+// RUN: FileCheck %s --check-prefix=UNFUSED
+
+// Compare-and-branch pairs are fused into a single superinstruction.
+
+// CHECK-LABEL: "name": "cmp_cond_br"
+// UNFUSED-LABEL: "name": "cmp_cond_br"
+vm.module @cmp_cond_br {
+  vm.export @fn
+  vm.func @fn(%arg0 : i32, %arg1 : i32) -> i32 {
+    %0 = vm.cmp.eq.i32 %arg0, %arg1 : i32
+    vm.cond_br %0, ^bb1, ^bb2
+  ^bb1:
+    vm.return %arg0 : i32
+  ^bb2:
+    vm.return %arg1 : i32
+  }
+  //      CHECK: "bytecode_data": [
+  // CHECK-NEXT:   121,
+  // CHECK-NEXT:   133,
+  //      UNFUSED: "bytecode_data": [
+  // UNFUSED-NEXT:   121,
+  // UNFUSED-NEXT:   73,
+}
+
+// -----
+
+// Loop latches (increment, compare, branch) are fused into a single
+// superinstruction.
+
+// CHECK-LABEL: "name": "loop_latch"
+// UNFUSED-LABEL: "name": "loop_latch"
+vm.module @loop_latch {
+  vm.export @fn
+  vm.func @fn(%arg0 : i32, %arg1 : i32, %arg2 : i32) -> i32 {
+    %0 = vm.add.i32 %arg0, %arg1 : i32
+    %1 = vm.cmp.lt.i32.s %0, %arg2 : i32
+    vm.cond_br %1, ^bb1, ^bb2
+  ^bb1:
+    vm.return %0 : i32
+  ^bb2:
+    vm.return %arg2 : i32
+  }
+  //      CHECK: "bytecode_data": [
+  // CHECK-NEXT:   121,
+  // CHECK-NEXT:   140,
+  //      UNFUSED: "bytecode_data": [
+  // UNFUSED-NEXT:   121,
+  // UNFUSED-NEXT:   34,
+}
+
+// -----
+
+// Ops are only fused when the branch consumes the result of the compare.
+
+// CHECK-LABEL: "name": "unrelated_cmp"
+vm.module @unrelated_cmp {
+  vm.export @fn
+  vm.func @fn(%arg0 : i32, %arg1 : i32, %arg2 : i32) -> i32 {
+    %0 = vm.cmp.eq.i32 %arg0, %arg1 : i32
+    vm.cond_br %arg2, ^bb1, ^bb2
+  ^bb1:
+    vm.return %0 : i32
+  ^bb2:
+    vm.return %arg2 : i32
+  }
+  //      CHECK: "bytecode_data": [
+  // CHECK-NEXT:   121,
+  // CHECK-NEXT:   73,
+}
@@ -217,6 +217,19 @@ void buildGlobalOptimizationPassPipeline(
     buildGlobalOptExprHoistingPassPipeline(mainPassManager, transformOptions);
   }
 
+  // Packing of parameters is hoisted into initializers which either get
+  // replaced with pre-packed parameters or, when producing the pre-packed
+  // parameters, get evaluated by const-eval and exported below.
+  if (transformOptions.options.parameterPrepack ||
+      !transformOptions.options.parameterPrepackSourcePaths.empty()) {
+    IREE::IO::Parameters::PrepackParametersPassOptions prepackParametersOptions;
+    prepackParametersOptions.sourcePaths.assign(
+        transformOptions.options.parameterPrepackSourcePaths.begin(),
+        transformOptions.options.parameterPrepackSourcePaths.end());
+    mainPassManager.addPass(IREE::IO::Parameters::createPrepackParametersPass(
+        prepackParametersOptions));
+  }
+
   if (transformOptions.buildConstEvalPassPipeline) {
     transformOptions.buildConstEvalPassPipeline(mainPassManager);
   }
@@ -7,7 +7,11 @@
 #ifndef IREE_COMPILER_MODULES_IO_PARAMETERS_TRANSFORMS_ARCHIVEUTILS_H_
 #define IREE_COMPILER_MODULES_IO_PARAMETERS_TRANSFORMS_ARCHIVEUTILS_H_
 
+#include "iree/compiler/Dialect/Flow/IR/FlowTypes.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/FileOutputBuffer.h"
+#include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Diagnostics.h"
 #include "mlir/IR/Operation.h"
 
@@ -19,6 +23,11 @@
 
 namespace mlir::iree_compiler::IREE::IO::Parameters {
 
+// Discardable attribute on globals holding the #flow.parameter.named the
+// global is exported as instead of one named after the global.
+static constexpr StringLiteral kExportParameterAttrName =
+    "iree.io.export_parameter";
+
 using ArchiveBuilder =
     std::unique_ptr<iree_io_parameter_archive_builder_t,
                     void (*)(iree_io_parameter_archive_builder_t *)>;
@@ -75,6 +84,42 @@ FailureOr<FileStreamIndex> createParameterIndex(Operation *op,
                                                 ArchiveBuilder builder,
                                                 StringRef archivePath);
 
+// Parameter indices keyed by scope.
+class ParameterIndices {
+public:
+  bool contains(StringRef scope) const {
+    return indicesByScope.contains(scope);
+  }
+
+  iree_io_parameter_index_t *lookup(StringRef scope) const {
+    auto it = indicesByScope.find(scope);
+    return it == indicesByScope.end() ? nullptr : it->second;
+  }
+
+  iree_io_parameter_index_t *lookupOrCreate(ModuleOp moduleOp,
+                                            StringRef scope);
+
+private:
+  SmallVector<ParameterIndex> indices;
+  DenseMap<StringRef, iree_io_parameter_index_t *> indicesByScope;
+};
+
+// Allocates one parameter index per scope (possibly an empty string) and
+// merges in parameters from the referenced `scope=path` files.
+FailureOr<ParameterIndices>
+loadParameterArchives(ModuleOp moduleOp, ArrayRef<std::string> scopePaths);
+
+// Today only shaped types of elements where we know we can directly access the
+// data as stored in the file.
+bool isImportableType(Type type);
+
+// Imports the given |parameterAttr| from |entry| as a constant of
+// |globalType|. The type must be importable per isImportableType.
+FailureOr<TypedAttr>
+importParameter(StringRef fullName, ShapedType globalType,
+                IREE::Flow::NamedParameterAttr parameterAttr,
+                const iree_io_parameter_index_entry_t *entry);
+
 } // namespace mlir::iree_compiler::IREE::IO::Parameters
 
 #endif // IREE_COMPILER_MODULES_IO_PARAMETERS_TRANSFORMS_ARCHIVEUTILS_H_
@@ -11,6 +11,7 @@
 #include "iree/compiler/Modules/IO/Parameters/Transforms/ArchiveUtils.h"
 #include "iree/compiler/Modules/IO/Parameters/Transforms/Passes.h"
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileOutputBuffer.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
@@ -27,7 +28,7 @@ namespace mlir::iree_compiler::IREE::IO::Parameters {
 namespace {
 
 static LogicalResult
-addSplatEntry(IREE::Util::GlobalOpInterface globalOp,
+addSplatEntry(IREE::Util::GlobalOpInterface globalOp, StringRef name,
               SplatElementsAttr valueAttr, int64_t storageSize,
               iree_io_parameter_archive_builder_t *builder) {
   SmallVector<char, IREE_IO_PARAMETER_MAX_SPLAT_PATTERN_LENGTH> pattern;
@@ -38,7 +39,6 @@ addSplatEntry(IREE::Util::GlobalOpInterface globalOp,
     return failure();
   }
 
-  StringRef name = globalOp.getGlobalName();
   return handleRuntimeError(
       globalOp,
       iree_io_parameter_archive_builder_add_splat_entry(
@@ -49,11 +49,10 @@ addSplatEntry(IREE::Util::GlobalOpInterface globalOp,
 }
 
 static LogicalResult
-addDataEntry(IREE::Util::GlobalOpInterface globalOp,
+addDataEntry(IREE::Util::GlobalOpInterface globalOp, StringRef name,
              IREE::Util::SerializableAttrInterface valueAttr,
              int64_t storageSize,
              iree_io_parameter_archive_builder_t *builder) {
-  StringRef name = globalOp.getGlobalName();
   return handleRuntimeError(
       globalOp,
       iree_io_parameter_archive_builder_add_data_entry(
@@ -70,15 +69,32 @@ addDataEntry(IREE::Util::GlobalOpInterface globalOp,
 // read/write in the file. If the global is immutable and a splat we can
 // add a splat entry instead to save on archive size and startup time.
 static LogicalResult addEntry(IREE::Util::GlobalOpInterface globalOp,
+                              StringRef name,
                               IREE::Util::SerializableAttrInterface valueAttr,
                               iree_io_parameter_archive_builder_t *builder) {
   if (!globalOp.isGlobalMutable()) {
     if (auto elementsAttr = dyn_cast<SplatElementsAttr>(valueAttr)) {
-      return addSplatEntry(globalOp, elementsAttr, valueAttr.getStorageSize(),
-                           builder);
+      return addSplatEntry(globalOp, name, elementsAttr,
+                           valueAttr.getStorageSize(), builder);
     }
   }
-  return addDataEntry(globalOp, valueAttr, valueAttr.getStorageSize(), builder);
+  return addDataEntry(globalOp, name, valueAttr, valueAttr.getStorageSize(),
+                      builder);
+}
+
+// Returns the scope and key of the parameter |globalOp| is exported as.
+// Globals are exported under their own name in |defaultScope| unless they
+// request a specific parameter (such as pre-packed parameters).
+static std::pair<StringRef, StringRef>
+getExportedParameter(IREE::Util::GlobalOpInterface globalOp,
+                     StringRef defaultScope) {
+  if (auto parameterAttr =
+          globalOp->getAttrOfType<IREE::Flow::NamedParameterAttr>(
+              kExportParameterAttrName)) {
+    return {parameterAttr.getScope().getValue(),
+            parameterAttr.getKey().getValue()};
+  }
+  return {defaultScope, globalOp.getGlobalName().getValue()};
 }
 
 struct ExportParametersPass
@@ -102,7 +118,10 @@ struct ExportParametersPass
       return signalPassFailure();
 
     // Accumulate globals that match the pass options and add them to the index.
+    // Multiple globals may request the same parameter (such as the same
+    // pre-packed layout of a weight) and share a single entry.
     SmallVector<IREE::Util::GlobalOpInterface> constantGlobalOps;
+    llvm::StringMap<IREE::Util::GlobalOpInterface> exportedGlobalOps;
     for (auto globalOp : moduleOp.getOps<IREE::Util::GlobalOpInterface>()) {
       // Only globals initialized with serializable initial values can be
       // parameterized.
@@ -113,14 +132,29 @@ struct ExportParametersPass
         continue;
 
       // Check that the serialized size of the attribute is at least as big as
-      // the pass configured minimum storage size.
+      // the pass configured minimum storage size. Globals that request a
+      // specific parameter are always exported.
       int64_t storageSize = serializableAttr.getStorageSize();
-      if (storageSize < minimumSize)
+      if (storageSize < minimumSize &&
+          !globalOp->hasAttr(kExportParameterAttrName)) {
         continue;
+      }
 
       // Add the entry with a type based on its contents.
-      if (failed(addEntry(globalOp, serializableAttr, builder->get())))
+      auto [globalScope, name] = getExportedParameter(globalOp, scope);
+      auto [it, inserted] = exportedGlobalOps.try_emplace(name, globalOp);
+      if (!inserted) {
+        if (it->second.getGlobalInitialValue() !=
+            globalOp.getGlobalInitialValue()) {
+          globalOp.emitError() << "parameter `" << name
+                               << "` is exported by multiple globals with "
+                                  "different values";
+          return signalPassFailure();
+        }
+      } else if (failed(addEntry(globalOp, name, serializableAttr,
+                                 builder->get()))) {
         return signalPassFailure();
+      }
 
       constantGlobalOps.push_back(globalOp);
     }
@@ -140,7 +174,7 @@ struct ExportParametersPass
     for (auto globalOp : constantGlobalOps) {
       // Lookup the entry in the index corresponding to the global.
       const iree_io_parameter_index_entry_t *entry = nullptr;
-      StringRef name = globalOp.getGlobalName();
+      auto [globalScope, name] = getExportedParameter(globalOp, scope);
       if (failed(handleRuntimeError(
               globalOp,
               iree_io_parameter_index_lookup(
@@ -150,8 +184,11 @@ struct ExportParametersPass
         return signalPassFailure();
       }
 
-      // Only file entries get stored; splats are in the metadata table.
-      if (entry->type == IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE) {
+      // Only file entries get stored; splats are in the metadata table. Entries
+      // shared by multiple globals are only stored once.
+      if (entry->type == IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE &&
+          exportedGlobalOps.lookup(name).getOperation() ==
+              globalOp.getOperation()) {
         // Seek to where the serialized global begins in the file.
         if (failed(handleRuntimeError(
                 globalOp,
@@ -175,8 +212,10 @@ struct ExportParametersPass
 
       // Change the global to reference the parameter.
       globalOp.setGlobalInitialValue(IREE::Flow::NamedParameterAttr::get(
-          context, globalOp.getGlobalType(), StringAttr::get(context, scope),
+          context, globalOp.getGlobalType(),
+          StringAttr::get(context, globalScope),
           StringAttr::get(context, name), DictionaryAttr()));
+      globalOp->removeAttr(kExportParameterAttrName);
     }
 
     // Commit the written file.
@@ -0,0 +1,255 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <limits>
+
+#include "iree/compiler/Dialect/Flow/IR/FlowTypes.h"
+#include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
+#include "iree/compiler/Dialect/Util/IR/UtilOps.h"
+#include "iree/compiler/Modules/IO/Parameters/Transforms/ArchiveUtils.h"
+#include "iree/compiler/Modules/IO/Parameters/Transforms/Passes.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+namespace mlir::iree_compiler::IREE::IO::Parameters {
+
+#define GEN_PASS_DEF_PREPACKPARAMETERSPASS
+#include "iree/compiler/Modules/IO/Parameters/Transforms/Passes.h.inc"
+
+namespace {
+
+// Number of hex digits of the layout digest appended to parameter keys.
+static constexpr size_t kLayoutDigestLength = 16;
+
+// An initializer computing the packed form of a single parameter.
+struct PackedParameter {
+  IREE::Util::InitializerOp initializerOp;
+  IREE::Util::GlobalLoadOpInterface loadOp;
+  IREE::Flow::NamedParameterAttr parameterAttr;
+  IREE::Util::GlobalOpInterface packedGlobalOp;
+  std::string packedKey;
+};
+
+// Returns true if |type| is a tensor whose layout has not been materialized.
+static bool hasEncoding(Type type) {
+  auto tensorType = dyn_cast<RankedTensorType>(type);
+  return tensorType && tensorType.getEncoding();
+}
+
+// Returns a key identifying the packed variant of the parameter loaded by
+// |initializerOp|. The key is the source key suffixed with a digest of the
+// packing ops so that each distinct tile layout gets its own variant.
+static std::string getPackedKey(IREE::Util::InitializerOp initializerOp,
+                                IREE::Flow::NamedParameterAttr parameterAttr) {
+  // Hoisted global names depend on the order globals were created in and are
+  // replaced with fixed names so that the same layout always has the same key.
+  MLIRContext *context = initializerOp.getContext();
+  OwningOpRef<Operation *> clonedOp = initializerOp->clone();
+  clonedOp->walk([&](Operation *op) {
+    if (auto loadOp = dyn_cast<IREE::Util::GlobalLoadOpInterface>(op)) {
+      loadOp.setGlobalAttr(FlatSymbolRefAttr::get(context, "source"));
+    } else if (auto storeOp =
+                   dyn_cast<IREE::Util::GlobalStoreOpInterface>(op)) {
+      storeOp.setGlobalAttr(FlatSymbolRefAttr::get(context, "packed"));
+    }
+  });
+  std::string ir;
+  {
+    llvm::raw_string_ostream os(ir);
+    clonedOp->print(os, OpPrintingFlags()
+                            .enableDebugInfo(false)
+                            .useLocalScope()
+                            .elideLargeElementsAttrs(
+                                std::numeric_limits<int64_t>::max()));
+  }
+  std::string digest =
+      llvm::toHex(llvm::SHA256::hash(llvm::arrayRefFromStringRef(ir)),
+                  /*LowerCase=*/true);
+  return (parameterAttr.getKey().getValue() + "#" +
+          StringRef(digest).take_front(kLayoutDigestLength))
+      .str();
+}
+
+// Matches initializers that only load an immutable parameter, pack it with
+// side-effect free ops, and store the result in a global. Const-expr hoisting
+// produces these for constant weights consumed by data-tiled ops.
+static std::optional<PackedParameter>
+matchPackedParameter(IREE::Util::InitializerOp initializerOp,
+                     SymbolTable &symbolTable) {
+  if (!initializerOp.getBody().hasOneBlock())
+    return std::nullopt;
+  IREE::Util::GlobalLoadOpInterface loadOp;
+  IREE::Util::GlobalStoreOpInterface storeOp;
+  bool hasPack = false;
+  for (Operation &op : initializerOp.getBody().front()) {
+    if (auto anyLoadOp = dyn_cast<IREE::Util::GlobalLoadOpInterface>(op)) {
+      if (loadOp)
+        return std::nullopt;
+      loadOp = anyLoadOp;
+      continue;
+    }
+    if (auto anyStoreOp = dyn_cast<IREE::Util::GlobalStoreOpInterface>(op)) {
+      if (storeOp)
+        return std::nullopt;
+      storeOp = anyStoreOp;
+      continue;
+    }
+    if (op.hasTrait<OpTrait::IsTerminator>())
+      continue;
+    // The tile layout is only known once encodings have been materialized.
+    if (llvm::any_of(op.getResultTypes(), hasEncoding))
+      return std::nullopt;
+    if (!isMemoryEffectFree(&op))
+      return std::nullopt;
+    hasPack |= isa<tensor::PackOp>(op);
+  }
+  if (!loadOp || !storeOp || !hasPack)
+    return std::nullopt;
+
+  auto sourceGlobalOp =
+      symbolTable.lookup<IREE::Util::GlobalOpInterface>(loadOp.getGlobalName());
+  if (!sourceGlobalOp || sourceGlobalOp.isGlobalMutable())
+    return std::nullopt;
+  auto parameterAttr = dyn_cast_if_present<IREE::Flow::NamedParameterAttr>(
+      sourceGlobalOp.getGlobalInitialValue());
+  if (!parameterAttr)
+    return std::nullopt;
+
+  auto packedGlobalOp = symbolTable.lookup<IREE::Util::GlobalOpInterface>(
+      storeOp.getGlobalName());
+  if (!packedGlobalOp || packedGlobalOp.isGlobalMutable() ||
+      packedGlobalOp.getGlobalInitialValue() ||
+      hasEncoding(packedGlobalOp.getGlobalType())) {
+    return std::nullopt;
+  }
+
+  PackedParameter packedParameter;
+  packedParameter.initializerOp = initializerOp;
+  packedParameter.loadOp = loadOp;
+  packedParameter.parameterAttr = parameterAttr;
+  packedParameter.packedGlobalOp = packedGlobalOp;
+  packedParameter.packedKey = getPackedKey(initializerOp, parameterAttr);
+  return packedParameter;
+}
+
+// Replaces the initializer of |packedParameter| with a reference to the
+// pre-packed parameter so that no packing happens at runtime.
+static void referencePackedParameter(PackedParameter &packedParameter) {
+  MLIRContext *context = packedParameter.initializerOp.getContext();
+  IREE::Util::GlobalOpInterface packedGlobalOp = packedParameter.packedGlobalOp;
+  packedGlobalOp.setGlobalInitialValue(IREE::Flow::NamedParameterAttr::get(
+      context, packedGlobalOp.getGlobalType(),
+      packedParameter.parameterAttr.getScope(),
+      StringAttr::get(context, packedParameter.packedKey), DictionaryAttr()));
+  packedParameter.initializerOp.erase();
+}
+
+// Replaces the parameter load in the initializer of |packedParameter| with the
+// parameter contents from |entry| so that the packed value can be evaluated
+// and marks the packed global for export under its packed key.
+static LogicalResult
+producePackedParameter(PackedParameter &packedParameter,
+                       const iree_io_parameter_index_entry_t *entry) {
+  IREE::Util::GlobalLoadOpInterface loadOp = packedParameter.loadOp;
+  Value sourceValue = loadOp.getLoadedGlobalValue();
+  auto sourceType = cast<ShapedType>(sourceValue.getType());
+  auto valueOr =
+      importParameter(packedParameter.parameterAttr.getKey().getValue(),
+                      sourceType, packedParameter.parameterAttr, entry);
+  if (failed(valueOr))
+    return failure();
+
+  OpBuilder builder(loadOp);
+  Value constantValue =
+      builder.create<arith::ConstantOp>(loadOp.getLoc(), *valueOr);
+  sourceValue.replaceAllUsesWith(constantValue);
+  loadOp.erase();
+
+  MLIRContext *context = builder.getContext();
+  IREE::Util::GlobalOpInterface packedGlobalOp = packedParameter.packedGlobalOp;
+  packedGlobalOp->setAttr(
+      kExportParameterAttrName,
+      IREE::Flow::NamedParameterAttr::get(
+          context, packedGlobalOp.getGlobalType(),
+          packedParameter.parameterAttr.getScope(),
+          StringAttr::get(context, packedParameter.packedKey),
+          DictionaryAttr()));
+  return success();
+}
+
+struct PrepackParametersPass
+    : public IREE::IO::Parameters::impl::PrepackParametersPassBase<
+          PrepackParametersPass> {
+  using IREE::IO::Parameters::impl::PrepackParametersPassBase<
+      PrepackParametersPass>::PrepackParametersPassBase;
+
+  void runOnOperation() override {
+    ModuleOp moduleOp = getOperation();
+    SymbolTable symbolTable(moduleOp);
+
+    // Find all initializers packing parameters.
+    SmallVector<PackedParameter> packedParameters;
+    for (auto initializerOp : moduleOp.getOps<IREE::Util::InitializerOp>()) {
+      if (auto packedParameter =
+              matchPackedParameter(initializerOp, symbolTable)) {
+        packedParameters.push_back(std::move(*packedParameter));
+      }
+    }
+    if (packedParameters.empty())
+      return;
+
+    // Without sources the packed parameters are expected to be provided at
+    // runtime.
+    if (sourcePaths.empty()) {
+      for (auto &packedParameter : packedParameters)
+        referencePackedParameter(packedParameter);
+      return;
+    }
+
+    // Import the sources of all packed parameters found in the archives.
+    auto parameterIndices = loadParameterArchives(moduleOp, sourcePaths);
+    if (failed(parameterIndices))
+      return signalPassFailure();
+    for (auto &packedParameter : packedParameters) {
+      IREE::Flow::NamedParameterAttr parameterAttr =
+          packedParameter.parameterAttr;
+      auto *parameterIndex =
+          parameterIndices->lookup(parameterAttr.getScope().getValue());
+      if (!parameterIndex)
+        continue;
+
+      // Parameters not present in the sources are left as-is.
+      StringRef key = parameterAttr.getKey().getValue();
+      const iree_io_parameter_index_entry_t *entry = nullptr;
+      iree_status_t lookupStatus = iree_io_parameter_index_lookup(
+          parameterIndex, iree_make_string_view(key.data(), key.size()),
+          &entry);
+      if (!iree_status_is_ok(lookupStatus)) {
+        iree_status_ignore(lookupStatus);
+        continue;
+      }
+
+      if (!isImportableType(
+              packedParameter.loadOp.getLoadedGlobalValue().getType())) {
+        llvm::errs() << "WARNING: not prepacking parameter `" << key
+                     << "` as sub-byte element types are not yet supported\n";
+        continue;
+      }
+      if (failed(producePackedParameter(packedParameter, entry)))
+        return signalPassFailure();
+    }
+  }
+};
+
+} // namespace
+} // namespace mlir::iree_compiler::IREE::IO::Parameters
@@ -40,3 +40,9 @@ util.global private mutable @mutable_dense_2xf32 = dense<[11.0, 12.0]> : tensor<
 // CHECK-NEXT: util.global private mutable @mutable_splat_2xf32 = #flow.parameter.named<"opt"::"mutable_splat_2xf32"> : tensor<2xf32>
 //  DUMP-NEXT: {{[0-9]+}} | {{[0-9]+}} | 8 | `mutable_splat_2xf32`
 util.global private mutable @mutable_splat_2xf32 = dense<11.0> : tensor<2xf32>
+
+// Globals requesting a specific parameter are exported under its key and scope
+// regardless of size.
+// CHECK-NEXT: util.global private @packed_constant = #flow.parameter.named<"model"::"constant#0123456789abcdef"> : tensor<2xf32>
+//  DUMP-NEXT: {{[0-9]+}} | {{[0-9]+}} | 8 | `constant#0123456789abcdef`
+util.global private @packed_constant {iree.io.export_parameter = #flow.parameter.named<"model"::"constant#0123456789abcdef"> : tensor<2xf32>} = dense<[11.0, 12.0]> : tensor<2xf32>
@@ -0,0 +1,65 @@
+// RUN: iree-opt --pass-pipeline="builtin.module(iree-io-export-parameters{path="model=%t.irpa" minimum-size=0},iree-io-prepack-parameters)" %s | FileCheck %s
+// RUN: iree-opt --pass-pipeline="builtin.module(iree-io-export-parameters{path="model=%t.irpa" minimum-size=0},iree-io-prepack-parameters{source-paths="model=%t.irpa"})" %s | FileCheck %s --check-prefix=PRODUCE
+// RUN: iree-opt --pass-pipeline="builtin.module(iree-io-export-parameters{path="model=%t.irpa" minimum-size=0},iree-io-prepack-parameters{source-paths="model=%t.irpa"},iree-consteval-jit-globals,iree-io-export-parameters{path="model=%t.packed.irpa" minimum-size=0})" %s | FileCheck %s --check-prefix=EXPORT
+// RUN: iree-dump-parameters --parameters=%t.packed.irpa | FileCheck %s --check-prefix=DUMP
+
+// CHECK: util.global private @weight = #flow.parameter.named<"model"::"weight"> : tensor<2x4xf32>
+util.global private @weight = dense<[[1.0, 2.0, 3.0, 4.0], [5.0, 6.0, 7.0, 8.0]]> : tensor<2x4xf32>
+
+// Initializers packing a parameter are replaced by the packed parameter.
+
+// CHECK-NEXT: util.global private @packed_weight = #flow.parameter.named<"model"::"weight#[[LAYOUT:[0-9a-f]+]]"> : tensor<1x4x2x1xf32>
+// CHECK-NOT: tensor.pack
+
+// When producing the packed parameter the source is imported for const-eval
+// and the result is marked for export under the packed key.
+
+// PRODUCE: util.global private @packed_weight {iree.io.export_parameter = #flow.parameter.named<"model"::"weight#[[LAYOUT:[0-9a-f]+]]">
+// PRODUCE: util.initializer {
+// PRODUCE-NEXT: %[[SOURCE:.+]] = arith.constant dense<{{.+}}> : tensor<2x4xf32>
+// PRODUCE-NEXT: %[[EMPTY:.+]] = tensor.empty() : tensor<1x4x2x1xf32>
+// PRODUCE-NEXT: %[[PACK:.+]] = tensor.pack %[[SOURCE]] {{.+}} into %[[EMPTY]]
+// PRODUCE-NEXT: util.global.store %[[PACK]], @packed_weight
+util.global private @packed_weight : tensor<1x4x2x1xf32>
+util.initializer {
+  %weight = util.global.load immutable @weight : tensor<2x4xf32>
+  %empty = tensor.empty() : tensor<1x4x2x1xf32>
+  %pack = tensor.pack %weight inner_dims_pos = [0, 1] inner_tiles = [2, 1] into %empty : tensor<2x4xf32> -> tensor<1x4x2x1xf32>
+  util.global.store %pack, @packed_weight : tensor<1x4x2x1xf32>
+  util.return
+}
+
+// The same layout produces the same key independent of the global name.
+
+// CHECK-NEXT: util.global private @packed_weight_copy = #flow.parameter.named<"model"::"weight#[[LAYOUT]]"> : tensor<1x4x2x1xf32>
+// PRODUCE: util.global private @packed_weight_copy {iree.io.export_parameter = #flow.parameter.named<"model"::"weight#[[LAYOUT]]">
+
+// Exporting the produced parameters stores the shared key once and both
+// globals reference it.
+
+// EXPORT: util.global private @packed_weight = #flow.parameter.named<"model"::"weight#[[LAYOUT:[0-9a-f]+]]"> : tensor<1x4x2x1xf32>
+// EXPORT: util.global private @packed_weight_copy = #flow.parameter.named<"model"::"weight#[[LAYOUT]]"> : tensor<1x4x2x1xf32>
+// DUMP: {{[0-9]+}} | {{[0-9]+}} | 32 | `weight#{{[0-9a-f]+}}`
+// DUMP-NOT: `weight#
+util.global private @packed_weight_copy : tensor<1x4x2x1xf32>
+util.initializer {
+  %weight = util.global.load immutable @weight : tensor<2x4xf32>
+  %empty = tensor.empty() : tensor<1x4x2x1xf32>
+  %pack = tensor.pack %weight inner_dims_pos = [0, 1] inner_tiles = [2, 1] into %empty : tensor<2x4xf32> -> tensor<1x4x2x1xf32>
+  util.global.store %pack, @packed_weight_copy : tensor<1x4x2x1xf32>
+  util.return
+}
+
+// Initializers that do not pack are left as-is.
+
+// CHECK-NEXT: util.global private @negated_weight : tensor<2x4xf32>
+// CHECK-NEXT: util.initializer {
+// CHECK-NEXT:   util.global.load immutable @weight
+// CHECK-NEXT:   arith.negf
+util.global private @negated_weight : tensor<2x4xf32>
+util.initializer {
+  %weight = util.global.load immutable @weight : tensor<2x4xf32>
+  %negated = arith.negf %weight : tensor<2x4xf32>
+  util.global.store %negated, @negated_weight : tensor<2x4xf32>
+  util.return
+}
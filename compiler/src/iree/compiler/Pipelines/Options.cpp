@@ -196,6 +196,19 @@ void GlobalOptimizationOptions::bindOptions(OptionsBinder &binder) {
           "parameter backed globals."),
       llvm::cl::cat(category));
 
+  binder.opt<bool>(
+      "iree-opt-prepack-parameters", parameterPrepack,
+      llvm::cl::desc("Replaces runtime packing of parameters with references "
+                     "to pre-packed parameters keyed as `<key>#<layout>`."),
+      llvm::cl::cat(category));
+  binder.list<std::string>(
+      "iree-opt-prepack-parameter-sources", parameterPrepackSourcePaths,
+      llvm::cl::desc(
+          "File paths to archives with an optional `scope=` prefix to read "
+          "parameters from when producing pre-packed parameters. The packed "
+          "parameters are exported to `iree-opt-export-parameters`."),
+      llvm::cl::cat(category));
+
   binder.opt<bool>(
       "iree-opt-generalize-matmul", generalizeMatmul,
       llvm::cl::desc("Convert named matmul ops to linalg generic ops during "
@@ -105,6 +105,14 @@ struct GlobalOptimizationOptions {
   // module.
   std::string parameterSplatExportFile = "";
 
+  // Replaces runtime packing of parameters with references to pre-packed
+  // parameters.
+  bool parameterPrepack = false;
+  // File paths to archives with an optional `scope=` prefix to read the
+  // parameters being pre-packed from. When set the pre-packed parameters are
+  // produced and exported to `parameterExportPath`.
+  std::vector<std::string> parameterPrepackSourcePaths;
+
   // Enables aggressive propagation of transposes to the inputs of named ops,
   // rewriting named ops as fused generics.
   bool aggressiveTransposePropagation = false;
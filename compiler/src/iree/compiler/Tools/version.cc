@@ -22,3 +22,14 @@ std::string mlir::iree_compiler::getIreeRevision() {
   return "";
 #endif
 }
+
+std::string mlir::iree_compiler::getIreeBuildRevision() {
+#ifdef IREE_RELEASE_REVISION
+  if constexpr (std::string_view(IREE_RELEASE_REVISION) == "HEAD") {
+    return "";
+  }
+  return IREE_RELEASE_REVISION;
+#else
+  return "";
+#endif
+}
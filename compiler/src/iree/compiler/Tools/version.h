@@ -15,6 +15,10 @@ namespace mlir::iree_compiler {
 // defined.
 std::string getIreeRevision();
 
+// Returns the source revision the IREE compiler was built from. Empty if built
+// without IREE_RELEASE_REVISION defined or from an unpinned ("HEAD") revision.
+std::string getIreeBuildRevision();
+
 } // namespace mlir::iree_compiler
 
 #endif // IREE_COMPILER_TOOLS_VERSION_H
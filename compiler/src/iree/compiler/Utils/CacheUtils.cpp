@@ -0,0 +1,142 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Utils/CacheUtils.h"
+
+#include <chrono>
+#include <string>
+
+#include "iree/compiler/Tools/version.h"
+#include "iree/compiler/Utils/ToolUtils.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "mlir/Bytecode/BytecodeWriter.h"
+
+namespace mlir::iree_compiler {
+
+std::string getCompilerBuildIdentity() {
+  static const std::string identity = []() -> std::string {
+    if (!getIreeBuildRevision().empty()) {
+      return getIreeRevision();
+    }
+    // Rebuilding the compiler relinks the binary hosting it and changes its
+    // size or modification time.
+    std::string binaryPath = getCurrentDylibPath();
+    llvm::sys::fs::file_status status;
+    if (binaryPath.empty() || llvm::sys::fs::status(binaryPath, status)) {
+      return "";
+    }
+    auto modificationTime =
+        status.getLastModificationTime().time_since_epoch().count();
+    return (Twine(getIreeRevision()) + "@" + binaryPath + ":" +
+            Twine(status.getSize()) + ":" +
+            Twine(static_cast<int64_t>(modificationTime)))
+        .str();
+  }();
+  return identity;
+}
+
+void getCacheEntryPath(StringRef cachePath, StringRef key, StringRef extension,
+                       SmallVectorImpl<char> &path) {
+  path.assign(cachePath.begin(), cachePath.end());
+  llvm::sys::path::append(path, key + extension);
+}
+
+void touchCacheEntry(StringRef path) {
+  int fd = -1;
+  if (llvm::sys::fs::openFileForWrite(path, fd, llvm::sys::fs::CD_OpenExisting,
+                                      llvm::sys::fs::OF_Append)) {
+    return;
+  }
+  (void)llvm::sys::fs::setLastAccessAndModificationTime(
+      fd, std::chrono::system_clock::now());
+  (void)llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+}
+
+// Removes the least recently used entries with |extension| in |cachePath|
+// until the total size of those entries is at most |maxSize| bytes.
+static void evictCacheEntries(StringRef cachePath, StringRef extension,
+                              int64_t maxSize) {
+  struct Entry {
+    std::string path;
+    uint64_t size;
+    llvm::sys::TimePoint<> lastUsed;
+  };
+  SmallVector<Entry> entries;
+  uint64_t totalSize = 0;
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(cachePath, ec), end;
+       it != end && !ec; it.increment(ec)) {
+    // Extensions may have multiple components (".foo.mlirbc") so the whole
+    // suffix is compared instead of the last extension.
+    if (!StringRef(it->path()).ends_with(extension)) {
+      continue;
+    }
+    auto status = it->status();
+    if (!status) {
+      continue;
+    }
+    entries.push_back({it->path(), status->getSize(),
+                       status->getLastModificationTime()});
+    totalSize += status->getSize();
+  }
+  if (totalSize <= static_cast<uint64_t>(maxSize)) {
+    return;
+  }
+
+  llvm::sort(entries, [](const Entry &lhs, const Entry &rhs) {
+    return lhs.lastUsed < rhs.lastUsed;
+  });
+  for (auto &entry : entries) {
+    if (totalSize <= static_cast<uint64_t>(maxSize)) {
+      break;
+    }
+    // Another compiler process sharing the cache may have already removed it.
+    if (!llvm::sys::fs::remove(entry.path, /*IgnoreNonExisting=*/false)) {
+      totalSize -= entry.size;
+    }
+  }
+}
+
+LogicalResult storeCacheEntry(StringRef cachePath, StringRef key,
+                              StringRef extension, Operation *op,
+                              int64_t maxSize) {
+  if (llvm::sys::fs::create_directories(cachePath)) {
+    return failure();
+  }
+
+  SmallString<256> tempModel;
+  getCacheEntryPath(cachePath, key, "-%%%%%%%%.tmp", tempModel);
+  SmallString<256> tempPath;
+  int fd = -1;
+  if (llvm::sys::fs::createUniqueFile(tempModel, fd, tempPath)) {
+    return failure();
+  }
+  bool didWrite = false;
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    didWrite = succeeded(writeBytecodeToFile(op, os));
+    os.close();
+    didWrite = didWrite && !os.has_error();
+    os.clear_error();
+  }
+  SmallString<256> entryPath;
+  getCacheEntryPath(cachePath, key, extension, entryPath);
+  if (!didWrite || llvm::sys::fs::rename(tempPath, entryPath)) {
+    (void)llvm::sys::fs::remove(tempPath);
+    return failure();
+  }
+
+  if (maxSize > 0) {
+    evictCacheEntries(cachePath, extension, maxSize);
+  }
+  return success();
+}
+
+} // namespace mlir::iree_compiler
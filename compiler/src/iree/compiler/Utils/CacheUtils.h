@@ -0,0 +1,69 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_COMPILER_UTILS_CACHEUTILS_H_
+#define IREE_COMPILER_UTILS_CACHEUTILS_H_
+
+#include <cstdint>
+#include <string>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/Support/LLVM.h"
+
+namespace mlir::iree_compiler {
+
+// Streams everything written into a SHA256 hasher so that large IR need not be
+// materialized as a string when computing cache keys.
+class SHA256Stream : public llvm::raw_ostream {
+public:
+  explicit SHA256Stream(llvm::SHA256 &hasher) : hasher(hasher) {}
+  ~SHA256Stream() override { flush(); }
+
+private:
+  void write_impl(const char *ptr, size_t size) override {
+    hasher.update(StringRef(ptr, size));
+    position += size;
+  }
+  uint64_t current_pos() const override { return position; }
+
+  llvm::SHA256 &hasher;
+  uint64_t position = 0;
+};
+
+// Returns a string identifying the compiler build for use in cache keys such
+// that entries written by one build are never used by another. Compilers built
+// from a pinned source revision are identified by their version and revision
+// and all others by the binary hosting the compiler as their reported version
+// does not change with their code. Returns an empty string if the build cannot
+// be identified, in which case caches must not be used.
+std::string getCompilerBuildIdentity();
+
+// Sets |path| to the path of the entry stored under |key| in the cache
+// directory at |cachePath|. |extension| identifies the cache the entry belongs
+// to so that multiple caches may share a directory.
+void getCacheEntryPath(StringRef cachePath, StringRef key, StringRef extension,
+                       SmallVectorImpl<char> &path);
+
+// Marks the entry at |path| as recently used so that it is evicted last.
+void touchCacheEntry(StringRef path);
+
+// Writes |op| as MLIR bytecode under |key| in the cache directory at
+// |cachePath|. The entry is written to a temporary file and renamed into place
+// so that other compiler processes sharing the cache never observe partial
+// entries. If |maxSize| is non-zero the least recently used entries with
+// |extension| are then evicted until their total size is at most |maxSize|
+// bytes. Returns failure if the entry could not be written.
+LogicalResult storeCacheEntry(StringRef cachePath, StringRef key,
+                              StringRef extension, Operation *op,
+                              int64_t maxSize);
+
+} // namespace mlir::iree_compiler
+
+#endif // IREE_COMPILER_UTILS_CACHEUTILS_H_
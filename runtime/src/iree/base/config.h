@@ -313,6 +313,18 @@ typedef IREE_DEVICE_SIZE_T iree_device_size_t;
 #define IREE_VM_BYTECODE_VERIFICATION_ENABLE 1
 #endif  // !IREE_VM_BYTECODE_VERIFICATION_ENABLE
 
+#if !defined(IREE_VM_BYTECODE_JIT_ENABLE)
+// Enables the baseline JIT that translates simple bytecode functions to native
+// code when modules are created with IREE_VM_BYTECODE_MODULE_FLAG_JIT.
+// Only x86_64 System V targets are supported; elsewhere modules are always
+// interpreted.
+#if defined(IREE_ARCH_X86_64) && !defined(IREE_PLATFORM_WINDOWS)
+#define IREE_VM_BYTECODE_JIT_ENABLE 1
+#else
+#define IREE_VM_BYTECODE_JIT_ENABLE 0
+#endif  // IREE_ARCH_X86_64 && !IREE_PLATFORM_WINDOWS
+#endif  // !IREE_VM_BYTECODE_JIT_ENABLE
+
 #if !defined(IREE_VM_EXT_F32_ENABLE)
 // Enables the 32-bit floating-point instruction extension.
 // Targeted from the compiler with `-iree-vm-target-extension-f32`.
@@ -0,0 +1,74 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/internal/siphash.h"
+
+// Based on reference implementation from https://github.com/veorq/SipHash
+// By Jean-Philippe Aumasson and Daniel J. Bernstein. (CC0 Licensed)
+#define ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+#define SIPROUND(v0, v1, v2, v3) \
+  v0 += v1;                      \
+  v1 = ROTL(v1, 13);             \
+  v1 ^= v0;                      \
+  v0 = ROTL(v0, 32);             \
+  v2 += v3;                      \
+  v3 = ROTL(v3, 16);             \
+  v3 ^= v2;                      \
+  v0 += v3;                      \
+  v3 = ROTL(v3, 21);             \
+  v3 ^= v0;                      \
+  v2 += v1;                      \
+  v1 = ROTL(v1, 17);             \
+  v1 ^= v2;                      \
+  v2 = ROTL(v2, 32)
+
+// Using SipHash-2-4.
+#define cROUNDS 2
+#define dROUNDS 4
+
+uint64_t iree_siphash24(iree_siphash_key_t key, iree_const_byte_span_t data) {
+  const uint8_t* source = data.data;
+  const uint8_t* end =
+      source + data.data_length - (data.data_length % sizeof(uint64_t));
+  const int left = data.data_length & 7;
+  uint64_t hash = ((uint64_t)data.data_length) << 56;
+
+  uint64_t v0 = UINT64_C(0x736f6d6570736575) ^ key.k0;
+  uint64_t v1 = UINT64_C(0x646f72616e646f6d) ^ key.k1;
+  uint64_t v2 = UINT64_C(0x6c7967656e657261) ^ key.k0;
+  uint64_t v3 = UINT64_C(0x7465646279746573) ^ key.k1;
+  uint64_t m;
+
+  for (; source != end; source += 8) {
+    m = iree_unaligned_load_le_u64((const uint64_t*)source);
+    v3 ^= m;
+    for (int i = 0; i < cROUNDS; ++i) {
+      SIPROUND(v0, v1, v2, v3);
+    }
+    v0 ^= m;
+  }
+
+  uint64_t tmp = 0;
+  for (int l = left; l > 0; --l) {
+    tmp = tmp << 8;
+    tmp |= (uint64_t)source[l - 1];
+  }
+  hash |= tmp;
+  v3 ^= hash;
+
+  for (int i = 0; i < cROUNDS; ++i) {
+    SIPROUND(v0, v1, v2, v3);
+  }
+
+  v0 ^= hash;
+  v2 ^= 0xff;
+
+  for (int i = 0; i < dROUNDS; ++i) {
+    SIPROUND(v0, v1, v2, v3);
+  }
+
+  return v0 ^ v1 ^ v2 ^ v3;
+}
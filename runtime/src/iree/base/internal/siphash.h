@@ -0,0 +1,41 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BASE_INTERNAL_SIPHASH_H_
+#define IREE_BASE_INTERNAL_SIPHASH_H_
+
+#include <stdint.h>
+
+#include "iree/base/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===----------------------------------------------------------------------===//
+// SipHash-2-4
+//===----------------------------------------------------------------------===//
+
+// 128-bit SipHash key as two little-endian 64-bit words.
+// The reference test key 0x000102030405060708090a0b0c0d0e0f is
+// {0x0706050403020100, 0x0f0e0d0c0b0a0908}.
+typedef struct iree_siphash_key_t {
+  uint64_t k0;
+  uint64_t k1;
+} iree_siphash_key_t;
+
+// Returns the 64-bit SipHash-2-4 of |data| under |key|.
+//
+// SipHash is a keyed pseudo-random function: when |key| is secret, parties
+// that can choose |data| still cannot find collisions or predict the hash of
+// any input. With a fixed public key it is only a fast, well-distributed hash.
+uint64_t iree_siphash24(iree_siphash_key_t key, iree_const_byte_span_t data);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // IREE_BASE_INTERNAL_SIPHASH_H_
@@ -0,0 +1,61 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/arm_64/argmax_arm_64_internal.h"
+#include "iree/builtins/ukernel/arch/arm_64/common_arm_64.h"
+
+bool iree_uk_argmax_tile_f32_arm_64(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t size,
+    iree_uk_index_t* IREE_UK_RESTRICT out_index) {
+  const float* IREE_UK_RESTRICT in = in_ptr;
+  // Each lane tracks the max and first index of the elements it has seen.
+  // Lanes that have not seen anything greater than -inf keep index -1. NaN
+  // elements are only detected here and the row is then rescanned.
+  uint32x4_t acc_ordered = vdupq_n_u32(0xFFFFFFFFu);
+  const iree_uk_int32_t lane_iota[4] = {0, 1, 2, 3};
+  float32x4_t acc_max = vdupq_n_f32(iree_uk_argmax_f32_neg_inf());
+  int32x4_t acc_idx = vdupq_n_s32(-1);
+  int32x4_t idx = vld1q_s32(lane_iota);
+  const int32x4_t idx_step = vdupq_n_s32(4);
+  iree_uk_index_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    float32x4_t value = vld1q_f32(in + i);
+    acc_ordered = vandq_u32(acc_ordered, vceqq_f32(value, value));
+    uint32x4_t gt = vcgtq_f32(value, acc_max);
+    acc_max = vbslq_f32(gt, value, acc_max);
+    acc_idx = vbslq_s32(gt, idx, acc_idx);
+    idx = vaddq_s32(idx, idx_step);
+  }
+  if (vminvq_u32(acc_ordered) == 0) {
+    return iree_uk_argmax_tile_f32_scalar(in, size, out_index);
+  }
+  float lane_max[4];
+  iree_uk_int32_t lane_idx[4];
+  vst1q_f32(lane_max, acc_max);
+  vst1q_s32(lane_idx, acc_idx);
+  float best = iree_uk_argmax_f32_neg_inf();
+  iree_uk_index_t best_index = -1;
+  for (int l = 0; l < 4; ++l) {
+    if (lane_idx[l] < 0) continue;
+    if (lane_max[l] > best ||
+        (lane_max[l] == best && lane_idx[l] < best_index)) {
+      best = lane_max[l];
+      best_index = lane_idx[l];
+    }
+  }
+  // Remainder elements come after all vector elements so only a strictly
+  // greater value can win.
+  for (; i < size; ++i) {
+    if (iree_uk_argmax_f32_is_nan(in[i])) break;
+    if (in[i] > best) {
+      best = in[i];
+      best_index = i;
+    }
+  }
+  if (best_index < 0) return false;
+  *out_index = best_index;
+  return true;
+}
@@ -0,0 +1,14 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_ARCH_ARM_64_ARGMAX_ARM_64_INTERNAL_H_
+#define IREE_BUILTINS_UKERNEL_ARCH_ARM_64_ARGMAX_ARM_64_INTERNAL_H_
+
+#include "iree/builtins/ukernel/argmax_internal.h"
+
+IREE_UK_ARGMAX_TILE_FUNC_DECL(iree_uk_argmax_tile_f32_arm_64)
+
+#endif  // IREE_BUILTINS_UKERNEL_ARCH_ARM_64_ARGMAX_ARM_64_INTERNAL_H_
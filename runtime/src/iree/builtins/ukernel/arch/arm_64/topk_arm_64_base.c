@@ -0,0 +1,50 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/arm_64/common_arm_64.h"
+#include "iree/builtins/ukernel/arch/arm_64/topk_arm_64_internal.h"
+
+// Skips whole vectors with no candidate and leaves the exact position within
+// the first matching vector to the scalar loop. Ordered compares: NaN inputs
+// are never candidates.
+static inline iree_uk_index_t iree_uk_topk_scan_f32_arm_64(
+    const float* IREE_UK_RESTRICT in, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold, bool smallest) {
+  const float32x4_t threshold_vec = vdupq_n_f32(threshold);
+  iree_uk_index_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    float32x4_t in0 = vld1q_f32(in + i);
+    float32x4_t in1 = vld1q_f32(in + i + 4);
+    uint32x4_t hit0, hit1;
+    if (smallest) {
+      hit0 = vcleq_f32(in0, threshold_vec);
+      hit1 = vcleq_f32(in1, threshold_vec);
+    } else {
+      hit0 = vcgeq_f32(in0, threshold_vec);
+      hit1 = vcgeq_f32(in1, threshold_vec);
+    }
+    if (vmaxvq_u32(vorrq_u32(hit0, hit1))) break;
+  }
+  // Either the remainder or a block known to contain a candidate.
+  for (; i < end; ++i) {
+    if (smallest ? in[i] <= threshold : in[i] >= threshold) return i;
+  }
+  return end;
+}
+
+iree_uk_index_t iree_uk_topk_scan_f32_largest_arm_64(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  return iree_uk_topk_scan_f32_arm_64(in_ptr, begin, end, threshold,
+                                      /*smallest=*/false);
+}
+
+iree_uk_index_t iree_uk_topk_scan_f32_smallest_arm_64(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  return iree_uk_topk_scan_f32_arm_64(in_ptr, begin, end, threshold,
+                                      /*smallest=*/true);
+}
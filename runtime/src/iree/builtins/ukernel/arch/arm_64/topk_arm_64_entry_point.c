@@ -0,0 +1,17 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/arm_64/common_arm_64.h"
+#include "iree/builtins/ukernel/arch/arm_64/topk_arm_64_internal.h"
+
+iree_uk_topk_scan_func_t iree_uk_topk_select_scan_func_arch(
+    const iree_uk_topk_params_t* params) {
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(params->flags);
+  if (iree_uk_topk_value_type(topk_type) != IREE_UK_TYPE_FLOAT_32) return 0;
+  return (params->flags & IREE_UK_FLAG_TOPK_SMALLEST)
+             ? iree_uk_topk_scan_f32_smallest_arm_64
+             : iree_uk_topk_scan_f32_largest_arm_64;
+}
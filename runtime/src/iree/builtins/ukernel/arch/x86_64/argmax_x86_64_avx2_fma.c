@@ -0,0 +1,60 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/x86_64/argmax_x86_64_internal.h"
+#include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
+
+bool iree_uk_argmax_tile_f32_x86_64_avx2_fma(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t size,
+    iree_uk_index_t* IREE_UK_RESTRICT out_index) {
+  const float* IREE_UK_RESTRICT in = in_ptr;
+  // Each lane tracks the max and first index of the elements it has seen.
+  // Lanes that have not seen anything greater than -inf keep index -1. NaN
+  // elements are only detected here and the row is then rescanned.
+  __m256 acc_nan = _mm256_setzero_ps();
+  __m256 acc_max = _mm256_set1_ps(iree_uk_argmax_f32_neg_inf());
+  __m256i acc_idx = _mm256_set1_epi32(-1);
+  __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i idx_step = _mm256_set1_epi32(8);
+  iree_uk_index_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256 value = _mm256_loadu_ps(in + i);
+    acc_nan = _mm256_or_ps(acc_nan, _mm256_cmp_ps(value, value, _CMP_UNORD_Q));
+    __m256 gt = _mm256_cmp_ps(value, acc_max, _CMP_GT_OQ);
+    acc_max = _mm256_blendv_ps(acc_max, value, gt);
+    acc_idx = _mm256_blendv_epi8(acc_idx, idx, _mm256_castps_si256(gt));
+    idx = _mm256_add_epi32(idx, idx_step);
+  }
+  if (_mm256_movemask_ps(acc_nan)) {
+    return iree_uk_argmax_tile_f32_scalar(in, size, out_index);
+  }
+  float lane_max[8];
+  iree_uk_int32_t lane_idx[8];
+  _mm256_storeu_ps(lane_max, acc_max);
+  _mm256_storeu_si256((__m256i*)lane_idx, acc_idx);
+  float best = iree_uk_argmax_f32_neg_inf();
+  iree_uk_index_t best_index = -1;
+  for (int l = 0; l < 8; ++l) {
+    if (lane_idx[l] < 0) continue;
+    if (lane_max[l] > best ||
+        (lane_max[l] == best && lane_idx[l] < best_index)) {
+      best = lane_max[l];
+      best_index = lane_idx[l];
+    }
+  }
+  // Remainder elements come after all vector elements so only a strictly
+  // greater value can win.
+  for (; i < size; ++i) {
+    if (iree_uk_argmax_f32_is_nan(in[i])) break;
+    if (in[i] > best) {
+      best = in[i];
+      best_index = i;
+    }
+  }
+  if (best_index < 0) return false;
+  *out_index = best_index;
+  return true;
+}
@@ -0,0 +1,59 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/x86_64/argmax_x86_64_internal.h"
+#include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
+
+bool iree_uk_argmax_tile_f32_x86_64_avx512_base(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t size,
+    iree_uk_index_t* IREE_UK_RESTRICT out_index) {
+  const float* IREE_UK_RESTRICT in = in_ptr;
+  // Each lane tracks the max and first index of the elements it has seen.
+  // Lanes that have not seen anything greater than -inf keep index -1. NaN
+  // elements are only detected here and the row is then rescanned.
+  __mmask16 acc_nan = 0;
+  __m512 acc_max = _mm512_set1_ps(iree_uk_argmax_f32_neg_inf());
+  __m512i acc_idx = _mm512_set1_epi32(-1);
+  __m512i idx = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+                                  14, 15);
+  const __m512i idx_step = _mm512_set1_epi32(16);
+  iree_uk_index_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m512 value = _mm512_loadu_ps(in + i);
+    acc_nan |= _mm512_cmp_ps_mask(value, value, _CMP_UNORD_Q);
+    __mmask16 gt = _mm512_cmp_ps_mask(value, acc_max, _CMP_GT_OQ);
+    acc_max = _mm512_mask_blend_ps(gt, acc_max, value);
+    acc_idx = _mm512_mask_blend_epi32(gt, acc_idx, idx);
+    idx = _mm512_add_epi32(idx, idx_step);
+  }
+  // Remainder elements are loaded under a mask with -inf in inactive lanes.
+  if (i < size) {
+    __mmask16 tail = (__mmask16)((1u << (size - i)) - 1);
+    __m512 value = _mm512_mask_loadu_ps(acc_max, tail, in + i);
+    acc_nan |= _mm512_cmp_ps_mask(value, value, _CMP_UNORD_Q);
+    __mmask16 gt = _mm512_mask_cmp_ps_mask(tail, value, acc_max, _CMP_GT_OQ);
+    acc_max = _mm512_mask_blend_ps(gt, acc_max, value);
+    acc_idx = _mm512_mask_blend_epi32(gt, acc_idx, idx);
+  }
+  if (acc_nan) return iree_uk_argmax_tile_f32_scalar(in, size, out_index);
+  float lane_max[16];
+  iree_uk_int32_t lane_idx[16];
+  _mm512_storeu_ps(lane_max, acc_max);
+  _mm512_storeu_si512(lane_idx, acc_idx);
+  float best = iree_uk_argmax_f32_neg_inf();
+  iree_uk_index_t best_index = -1;
+  for (int l = 0; l < 16; ++l) {
+    if (lane_idx[l] < 0) continue;
+    if (lane_max[l] > best ||
+        (lane_max[l] == best && lane_idx[l] < best_index)) {
+      best = lane_max[l];
+      best_index = lane_idx[l];
+    }
+  }
+  if (best_index < 0) return false;
+  *out_index = best_index;
+  return true;
+}
@@ -0,0 +1,27 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/x86_64/argmax_x86_64_internal.h"
+#include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
+
+iree_uk_argmax_tile_func_t iree_uk_argmax_select_tile_func_arch(
+    const iree_uk_argmax_params_t* params) {
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(params->flags);
+  if (iree_uk_argmax_in_type(argmax_type) != IREE_UK_TYPE_FLOAT_32) return 0;
+  // The vector code tracks lane indices as i32.
+  if (params->size1 > 0x7FFFFFFF) return 0;
+#if defined(IREE_UK_BUILD_X86_64_AVX512_BASE)
+  if (iree_uk_cpu_x86_64_avx512_base(params->cpu_data)) {
+    return iree_uk_argmax_tile_f32_x86_64_avx512_base;
+  }
+#endif
+#if defined(IREE_UK_BUILD_X86_64_AVX2_FMA)
+  if (iree_uk_cpu_x86_64_avx2_fma(params->cpu_data)) {
+    return iree_uk_argmax_tile_f32_x86_64_avx2_fma;
+  }
+#endif
+  return 0;
+}
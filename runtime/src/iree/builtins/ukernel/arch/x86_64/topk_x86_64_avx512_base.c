@@ -0,0 +1,52 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
+#include "iree/builtins/ukernel/arch/x86_64/topk_x86_64_internal.h"
+
+// Skips whole vectors with no candidate and leaves the exact position within
+// the first matching vector to the scalar loop. Ordered compares: NaN inputs
+// are never candidates.
+static inline iree_uk_index_t iree_uk_topk_scan_f32_x86_64_avx512_base(
+    const float* IREE_UK_RESTRICT in, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold, bool smallest) {
+  const __m512 threshold_vec = _mm512_set1_ps(threshold);
+  iree_uk_index_t i = begin;
+  for (; i + 32 <= end; i += 32) {
+    __m512 in0 = _mm512_loadu_ps(in + i);
+    __m512 in1 = _mm512_loadu_ps(in + i + 16);
+    __mmask16 hit0, hit1;
+    if (smallest) {
+      hit0 = _mm512_cmp_ps_mask(in0, threshold_vec, _CMP_LE_OQ);
+      hit1 = _mm512_cmp_ps_mask(in1, threshold_vec, _CMP_LE_OQ);
+    } else {
+      hit0 = _mm512_cmp_ps_mask(in0, threshold_vec, _CMP_GE_OQ);
+      hit1 = _mm512_cmp_ps_mask(in1, threshold_vec, _CMP_GE_OQ);
+    }
+    if (hit0 | hit1) break;
+  }
+  // Either the remainder or a block known to contain a candidate.
+  for (; i < end; ++i) {
+    if (smallest ? in[i] <= threshold : in[i] >= threshold) return i;
+  }
+  return end;
+}
+
+iree_uk_index_t iree_uk_topk_scan_f32_largest_x86_64_avx512_base(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  return iree_uk_topk_scan_f32_x86_64_avx512_base(in_ptr, begin, end,
+                                                  threshold,
+                                                  /*smallest=*/false);
+}
+
+iree_uk_index_t iree_uk_topk_scan_f32_smallest_x86_64_avx512_base(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  return iree_uk_topk_scan_f32_x86_64_avx512_base(in_ptr, begin, end,
+                                                  threshold,
+                                                  /*smallest=*/true);
+}
@@ -0,0 +1,29 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
+#include "iree/builtins/ukernel/arch/x86_64/topk_x86_64_internal.h"
+
+iree_uk_topk_scan_func_t iree_uk_topk_select_scan_func_arch(
+    const iree_uk_topk_params_t* params) {
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(params->flags);
+  if (iree_uk_topk_value_type(topk_type) != IREE_UK_TYPE_FLOAT_32) return 0;
+#if defined(IREE_UK_BUILD_X86_64_AVX512_BASE)
+  if (iree_uk_cpu_x86_64_avx512_base(params->cpu_data)) {
+    bool smallest = params->flags & IREE_UK_FLAG_TOPK_SMALLEST;
+    return smallest ? iree_uk_topk_scan_f32_smallest_x86_64_avx512_base
+                    : iree_uk_topk_scan_f32_largest_x86_64_avx512_base;
+  }
+#endif
+#if defined(IREE_UK_BUILD_X86_64_AVX2_FMA)
+  if (iree_uk_cpu_x86_64_avx2_fma(params->cpu_data)) {
+    bool smallest = params->flags & IREE_UK_FLAG_TOPK_SMALLEST;
+    return smallest ? iree_uk_topk_scan_f32_smallest_x86_64_avx2_fma
+                    : iree_uk_topk_scan_f32_largest_x86_64_avx2_fma;
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,17 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_ARCH_X86_64_TOPK_X86_64_INTERNAL_H_
+#define IREE_BUILTINS_UKERNEL_ARCH_X86_64_TOPK_X86_64_INTERNAL_H_
+
+#include "iree/builtins/ukernel/topk_internal.h"
+
+IREE_UK_TOPK_SCAN_FUNC_DECL(iree_uk_topk_scan_f32_largest_x86_64_avx2_fma)
+IREE_UK_TOPK_SCAN_FUNC_DECL(iree_uk_topk_scan_f32_smallest_x86_64_avx2_fma)
+IREE_UK_TOPK_SCAN_FUNC_DECL(iree_uk_topk_scan_f32_largest_x86_64_avx512_base)
+IREE_UK_TOPK_SCAN_FUNC_DECL(iree_uk_topk_scan_f32_smallest_x86_64_avx512_base)
+
+#endif  // IREE_BUILTINS_UKERNEL_ARCH_X86_64_TOPK_X86_64_INTERNAL_H_
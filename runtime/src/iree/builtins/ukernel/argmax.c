@@ -0,0 +1,87 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/argmax_internal.h"
+
+static void iree_uk_argmax_validate(const iree_uk_argmax_params_t* params) {
+#ifdef IREE_UK_ENABLE_ASSERTS
+  const iree_uk_uint32_t allflags = IREE_UK_FLAG_ARGMAX_TYPE_MASK;
+  IREE_UK_ASSERT(!(params->flags & ~allflags));
+  iree_uk_uint32_t flags_type = params->flags & IREE_UK_FLAG_ARGMAX_TYPE_MASK;
+  IREE_UK_ASSERT(flags_type >= IREE_UK_FLAG_ARGMAX_TYPE_F32I32 &&
+                 flags_type <= IREE_UK_FLAG_ARGMAX_TYPE_BF16I64);
+  IREE_UK_ASSERT(params->size0 >= 0);
+  IREE_UK_ASSERT(params->size1 >= 0);
+  IREE_UK_ASSERT(params->size0 <= 1 || params->in_stride0 >= params->size1);
+  IREE_UK_ASSERT(params->out_stride0 >= 0);
+  // Indices must be representable in the output type.
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(params->flags);
+  if (iree_uk_argmax_out_type(argmax_type) == IREE_UK_TYPE_INT_32) {
+    IREE_UK_ASSERT(params->size1 <= 0x7FFFFFFF);
+  }
+#endif  // IREE_UK_ENABLE_ASSERTS
+}
+
+// Early-return implementation for this ukernel. Returns true if already done.
+static bool iree_uk_argmax_early(const iree_uk_argmax_params_t* params) {
+  return params->size0 == 0 || params->size1 == 0;
+}
+
+static void iree_uk_argmax_using_tile_func(
+    const iree_uk_argmax_params_t* params,
+    iree_uk_argmax_tile_func_t tile_func) {
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(params->flags);
+  iree_uk_type_t in_type = iree_uk_argmax_in_type(argmax_type);
+  iree_uk_type_t out_type = iree_uk_argmax_out_type(argmax_type);
+  iree_uk_index_t in_elem_size = iree_uk_type_size(in_type);
+  iree_uk_index_t out_elem_size = iree_uk_type_size(out_type);
+  const char* in_row =
+      (const char*)params->in_buffer + params->in_offset * in_elem_size;
+  char* out_ptr =
+      (char*)params->out_buffer + params->out_offset * out_elem_size;
+  for (iree_uk_index_t i0 = 0; i0 < params->size0; ++i0) {
+    iree_uk_index_t index = 0;
+    // Rows without any element greater than -inf keep their initial index, as
+    // the select in the reference reduction never fires for them.
+    if (tile_func(in_row, params->size1, &index)) {
+      if (out_type == IREE_UK_TYPE_INT_32) {
+        *(iree_uk_int32_t*)out_ptr = (iree_uk_int32_t)index;
+      } else {
+        *(iree_uk_int64_t*)out_ptr = (iree_uk_int64_t)index;
+      }
+    }
+    in_row += params->in_stride0 * in_elem_size;
+    out_ptr += params->out_stride0 * out_elem_size;
+  }
+}
+
+void iree_uk_argmax_p(const iree_uk_argmax_params_t* params) {
+  iree_uk_argmax_validate(params);
+
+  if (iree_uk_argmax_early(params)) return;
+
+  // Select a target-specific tile_func and use that with generic outer loops.
+  iree_uk_argmax_tile_func_t func = iree_uk_argmax_select_tile_func(params);
+  iree_uk_argmax_using_tile_func(params, func);
+}
+
+IREE_UK_EXPORT void iree_uk_argmax(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, void* out_buffer, iree_uk_index_t out_offset,
+    iree_uk_index_t out_stride0, iree_uk_index_t size0, iree_uk_index_t size1,
+    iree_uk_uint32_t flags, const iree_uk_uint64_t* cpu_data) {
+  iree_uk_argmax_params_t params = {.in_buffer = in_buffer,
+                                    .in_offset = in_offset,
+                                    .in_stride0 = in_stride0,
+                                    .out_buffer = out_buffer,
+                                    .out_offset = out_offset,
+                                    .out_stride0 = out_stride0,
+                                    .size0 = size0,
+                                    .size1 = size1,
+                                    .flags = flags,
+                                    .cpu_data = cpu_data};
+  iree_uk_argmax_p(&params);
+}
@@ -0,0 +1,30 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_ARGMAX_H_
+#define IREE_BUILTINS_UKERNEL_ARGMAX_H_
+
+#include "iree/builtins/ukernel/common.h"
+
+// `argmax` microkernel. Reduces each row of a 2D input to the index of its
+// largest element, as in greedy sampling of logits during LLM decode. Rows are
+// strided along dimension 0 and contiguous along dimension 1.
+//
+// Results match the maximumf + cmpf ogt formulation produced by the frontends
+// exactly: ties resolve to the smallest index and, as maximumf propagates NaN
+// after which the ogt comparison never succeeds, the result for a row
+// containing NaN is the index of the largest element before the first NaN.
+// The output element is left as-is for rows where no element before the first
+// NaN is greater than -inf. Rows longer than INT32_MAX elements use the
+// generic code as the vector code tracks indices in 32-bit lanes.
+
+IREE_UK_EXPORT void iree_uk_argmax(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, void* out_buffer, iree_uk_index_t out_offset,
+    iree_uk_index_t out_stride0, iree_uk_index_t size0, iree_uk_index_t size1,
+    iree_uk_uint32_t flags, const iree_uk_uint64_t* cpu_data);
+
+#endif  // IREE_BUILTINS_UKERNEL_ARGMAX_H_
@@ -0,0 +1,126 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_ARGMAX_INTERNAL_H_
+#define IREE_BUILTINS_UKERNEL_ARGMAX_INTERNAL_H_
+
+#include "iree/builtins/ukernel/argmax.h"
+
+typedef struct iree_uk_argmax_params_t {
+  const void* in_buffer;
+  iree_uk_index_t in_offset;
+  iree_uk_index_t in_stride0;
+  void* out_buffer;
+  iree_uk_index_t out_offset;
+  iree_uk_index_t out_stride0;
+  iree_uk_index_t size0;
+  iree_uk_index_t size1;
+  iree_uk_uint32_t flags;
+  const iree_uk_uint64_t* cpu_data;
+} iree_uk_argmax_params_t;
+
+void iree_uk_argmax_p(const iree_uk_argmax_params_t* params);
+
+typedef enum iree_uk_argmax_type_t {
+  iree_uk_argmax_type_f32i32 = IREE_UK_TIE_2_TYPES_LITERAL(FLOAT_32, INT_32),
+  iree_uk_argmax_type_f32i64 = IREE_UK_TIE_2_TYPES_LITERAL(FLOAT_32, INT_64),
+  iree_uk_argmax_type_f16i32 = IREE_UK_TIE_2_TYPES_LITERAL(FLOAT_16, INT_32),
+  iree_uk_argmax_type_f16i64 = IREE_UK_TIE_2_TYPES_LITERAL(FLOAT_16, INT_64),
+  iree_uk_argmax_type_bf16i32 = IREE_UK_TIE_2_TYPES_LITERAL(BFLOAT_16, INT_32),
+  iree_uk_argmax_type_bf16i64 = IREE_UK_TIE_2_TYPES_LITERAL(BFLOAT_16, INT_64),
+} iree_uk_argmax_type_t;
+
+static inline iree_uk_argmax_type_t iree_uk_argmax_type(
+    iree_uk_uint32_t flags) {
+  switch (flags & IREE_UK_FLAG_ARGMAX_TYPE_MASK) {
+    case IREE_UK_FLAG_ARGMAX_TYPE_F32I32:
+      return iree_uk_argmax_type_f32i32;
+    case IREE_UK_FLAG_ARGMAX_TYPE_F32I64:
+      return iree_uk_argmax_type_f32i64;
+    case IREE_UK_FLAG_ARGMAX_TYPE_F16I32:
+      return iree_uk_argmax_type_f16i32;
+    case IREE_UK_FLAG_ARGMAX_TYPE_F16I64:
+      return iree_uk_argmax_type_f16i64;
+    case IREE_UK_FLAG_ARGMAX_TYPE_BF16I32:
+      return iree_uk_argmax_type_bf16i32;
+    case IREE_UK_FLAG_ARGMAX_TYPE_BF16I64:
+      return iree_uk_argmax_type_bf16i64;
+    default:
+      // Shouldn't happen, validated earlier.
+      return (iree_uk_argmax_type_t)0;
+  }
+}
+
+static inline iree_uk_type_t iree_uk_argmax_in_type(
+    iree_uk_argmax_type_t type) {
+  return iree_uk_untie_type(0, type);
+}
+
+static inline iree_uk_type_t iree_uk_argmax_out_type(
+    iree_uk_argmax_type_t type) {
+  return iree_uk_untie_type(1, type);
+}
+
+// Returns a float -inf, the identity of the max reduction. Elements equal to
+// it are never selected.
+static inline float iree_uk_argmax_f32_neg_inf(void) {
+  const iree_uk_uint32_t bits = 0xFF800000u;
+  float value;
+  iree_uk_memcpy(&value, &bits, sizeof value);
+  return value;
+}
+
+// Returns true if `value` is NaN.
+static inline bool iree_uk_argmax_f32_is_nan(float value) {
+  return value != value;
+}
+
+// Scalar reduction of a contiguous f32 row of `size` elements with the
+// semantics of iree_uk_argmax_tile_func_t. Used by the vector tile functions
+// for rows containing NaN, which are rare enough that finding where the
+// reference reduction stops need not be vectorized.
+static inline bool iree_uk_argmax_tile_f32_scalar(
+    const float* IREE_UK_RESTRICT in, iree_uk_index_t size,
+    iree_uk_index_t* IREE_UK_RESTRICT out_index) {
+  float best = iree_uk_argmax_f32_neg_inf();
+  iree_uk_index_t best_index = -1;
+  for (iree_uk_index_t i = 0; i < size; ++i) {
+    // The reference max reduction is NaN from here on and never compares
+    // smaller than any later element.
+    if (iree_uk_argmax_f32_is_nan(in[i])) break;
+    // Strict comparison: ties keep the first index.
+    if (in[i] > best) {
+      best = in[i];
+      best_index = i;
+    }
+  }
+  if (best_index < 0) return false;
+  *out_index = best_index;
+  return true;
+}
+
+// Reduces a contiguous row of `size` elements. Returns true and stores the
+// index of the first largest element before the first NaN (if any) in
+// `*out_index` if that element compares greater than -inf. Returns false,
+// leaving `*out_index` untouched, otherwise.
+typedef bool (*iree_uk_argmax_tile_func_t)(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t size,
+    iree_uk_index_t* IREE_UK_RESTRICT out_index);
+
+// Tile kernel declarations. Prototype matches iree_uk_argmax_tile_func_t.
+#define IREE_UK_ARGMAX_TILE_FUNC_DECL(NAME)                            \
+  bool NAME(const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t size, \
+            iree_uk_index_t* IREE_UK_RESTRICT out_index);
+
+// Returns the tile function to use for the argmax op with the given params.
+iree_uk_argmax_tile_func_t iree_uk_argmax_select_tile_func(
+    const iree_uk_argmax_params_t* params);
+
+// Architecture-specific implementation.
+iree_uk_argmax_tile_func_t iree_uk_argmax_select_tile_func_arch(
+    const iree_uk_argmax_params_t* params);
+
+#endif  // IREE_BUILTINS_UKERNEL_ARGMAX_INTERNAL_H_
@@ -0,0 +1,68 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/argmax_internal.h"
+
+static bool iree_uk_argmax_tile_f32_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t size,
+    iree_uk_index_t* IREE_UK_RESTRICT out_index) {
+  return iree_uk_argmax_tile_f32_scalar(in_ptr, size, out_index);
+}
+
+static bool iree_uk_argmax_tile_x16_generic(
+    const iree_uk_uint16_t* IREE_UK_RESTRICT in, iree_uk_index_t size,
+    int exp_bits, iree_uk_index_t* IREE_UK_RESTRICT out_index) {
+  float best = iree_uk_argmax_f32_neg_inf();
+  iree_uk_index_t best_index = -1;
+  for (iree_uk_index_t i = 0; i < size; ++i) {
+    float value = iree_uk_generic_fp16_to_f32(in[i], exp_bits);
+    if (iree_uk_argmax_f32_is_nan(value)) break;
+    if (value > best) {
+      best = value;
+      best_index = i;
+    }
+  }
+  if (best_index < 0) return false;
+  *out_index = best_index;
+  return true;
+}
+
+static bool iree_uk_argmax_tile_f16_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t size,
+    iree_uk_index_t* IREE_UK_RESTRICT out_index) {
+  return iree_uk_argmax_tile_x16_generic(in_ptr, size, 5, out_index);
+}
+
+static bool iree_uk_argmax_tile_bf16_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t size,
+    iree_uk_index_t* IREE_UK_RESTRICT out_index) {
+  return iree_uk_argmax_tile_x16_generic(in_ptr, size, 8, out_index);
+}
+
+static iree_uk_argmax_tile_func_t iree_uk_argmax_select_tile_func_generic(
+    const iree_uk_argmax_params_t* params) {
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(params->flags);
+  switch (iree_uk_argmax_in_type(argmax_type)) {
+    case IREE_UK_TYPE_FLOAT_16:
+      return iree_uk_argmax_tile_f16_generic;
+    case IREE_UK_TYPE_BFLOAT_16:
+      return iree_uk_argmax_tile_bf16_generic;
+    default:
+      return iree_uk_argmax_tile_f32_generic;
+  }
+}
+
+// Select the 'tile function' that is the typically target-optimized inner loop
+// implementation.
+iree_uk_argmax_tile_func_t iree_uk_argmax_select_tile_func(
+    const iree_uk_argmax_params_t* params) {
+  iree_uk_argmax_tile_func_t arch_tile_func =
+      iree_uk_argmax_select_tile_func_arch(params);
+  if (arch_tile_func) {
+    return arch_tile_func;
+  }
+  return iree_uk_argmax_select_tile_func_generic(params);
+}
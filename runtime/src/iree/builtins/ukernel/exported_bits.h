@@ -82,6 +82,35 @@
 #define IREE_UK_FLAG_UNPACK_TRANSPOSE_INNER 0x100
 #define IREE_UK_FLAG_UNPACK_TRANSPOSE_OUTER 0x200
 
+//===----------------------------------------------------------------------===//
+// argmax
+//===----------------------------------------------------------------------===//
+
+// type enum: input value type, output index type.
+#define IREE_UK_FLAG_ARGMAX_TYPE_MASK 0xFF
+#define IREE_UK_FLAG_ARGMAX_TYPE_NONE 0x00
+#define IREE_UK_FLAG_ARGMAX_TYPE_F32I32 0x01
+#define IREE_UK_FLAG_ARGMAX_TYPE_F32I64 0x02
+#define IREE_UK_FLAG_ARGMAX_TYPE_F16I32 0x03
+#define IREE_UK_FLAG_ARGMAX_TYPE_F16I64 0x04
+#define IREE_UK_FLAG_ARGMAX_TYPE_BF16I32 0x05
+#define IREE_UK_FLAG_ARGMAX_TYPE_BF16I64 0x06
+
+//===----------------------------------------------------------------------===//
+// topk
+//===----------------------------------------------------------------------===//
+
+// type enum: value type, index type.
+#define IREE_UK_FLAG_TOPK_TYPE_MASK 0xFF
+#define IREE_UK_FLAG_TOPK_TYPE_NONE 0x00
+#define IREE_UK_FLAG_TOPK_TYPE_F32I32 0x01
+#define IREE_UK_FLAG_TOPK_TYPE_F16I32 0x02
+#define IREE_UK_FLAG_TOPK_TYPE_BF16I32 0x03
+
+// bit flags
+// Selects the K smallest values instead of the K largest.
+#define IREE_UK_FLAG_TOPK_SMALLEST 0x100
+
 //===----------------------------------------------------------------------===//
 // query_tile_sizes
 //===----------------------------------------------------------------------===//
@@ -4,9 +4,11 @@
 // See https://llvm.org/LICENSE.txt for license information.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include "iree/builtins/ukernel/argmax_internal.h"
 #include "iree/builtins/ukernel/mmt4d_internal.h"
 #include "iree/builtins/ukernel/pack_internal.h"
 #include "iree/builtins/ukernel/query_tile_sizes_internal.h"
+#include "iree/builtins/ukernel/topk_internal.h"
 #include "iree/builtins/ukernel/unpack_internal.h"
 
 iree_uk_mmt4d_tile_func_t iree_uk_mmt4d_select_tile_func_arch(
@@ -24,6 +26,16 @@ iree_uk_unpack_tile_func_t iree_uk_unpack_select_tile_func_arch(
   return 0;
 }
 
+iree_uk_argmax_tile_func_t iree_uk_argmax_select_tile_func_arch(
+    const iree_uk_argmax_params_t* params) {
+  return 0;
+}
+
+iree_uk_topk_scan_func_t iree_uk_topk_select_scan_func_arch(
+    const iree_uk_topk_params_t* params) {
+  return 0;
+}
+
 bool iree_uk_query_matmul_tile_sizes_arch(
     const iree_uk_query_tile_sizes_2d_params_t* params,
     iree_uk_matmul_tile_sizes_t* out_matmul_tile_sizes) {
@@ -0,0 +1,99 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/flags.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/argmax_internal.h"
+#include "iree/builtins/ukernel/tools/benchmark.h"
+#include "iree/builtins/ukernel/tools/util.h"
+
+IREE_FLAG(int64_t, vocab_size, 32000,
+          "Row length, e.g. the vocabulary size when sampling LLM logits.");
+IREE_FLAG(int64_t, rows, 1,
+          "Number of rows, e.g. the batch size when sampling LLM logits.");
+
+static iree_status_t iree_uk_benchmark_argmax(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  const iree_uk_benchmark_user_data_t* user_data = benchmark_def->user_data;
+  const iree_uk_argmax_params_t* src_params =
+      iree_uk_benchmark_params(user_data);
+  iree_uk_argmax_params_t params;
+  memcpy(&params, src_params, sizeof params);
+  params.cpu_data = iree_uk_benchmark_cpu_data(user_data);
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(params.flags);
+  iree_uk_type_t in_type = iree_uk_argmax_in_type(argmax_type);
+  iree_uk_type_t out_type = iree_uk_argmax_out_type(argmax_type);
+  params.size0 = FLAG_rows;
+  params.size1 = FLAG_vocab_size;
+  params.in_stride0 = params.size1;
+  params.out_stride0 = 1;
+  iree_uk_index_t in_buffer_size =
+      iree_uk_2d_buffer_length(in_type, params.size0, params.in_stride0);
+  iree_uk_index_t out_buffer_size =
+      iree_uk_2d_buffer_length(out_type, params.size0, params.out_stride0);
+  void* in_buffer = malloc(in_buffer_size);
+  void* out_buffer = malloc(out_buffer_size);
+  iree_uk_random_engine_t* engine = iree_uk_benchmark_random_engine(user_data);
+  iree_uk_write_random_buffer(in_buffer, in_buffer_size, in_type, engine);
+  params.in_buffer = in_buffer;
+  params.out_buffer = out_buffer;
+  int64_t total_iterations = 0;
+  int64_t batch_count = 1;
+  while (iree_benchmark_keep_running(benchmark_state, batch_count)) {
+    for (int i = 0; i < batch_count; ++i) {
+      iree_uk_argmax_p(&params);
+    }
+    total_iterations += batch_count;
+    batch_count *= 2;
+  }
+  // Report bytes per second: this is a single pass over the input, so it is
+  // expected to approach memory bandwidth for large rows.
+  iree_benchmark_set_bytes_processed(benchmark_state,
+                                     total_iterations * in_buffer_size);
+  free(in_buffer);
+  free(out_buffer);
+  return iree_ok_status();
+}
+
+static void iree_uk_benchmark_register_argmax(iree_uk_uint32_t flags,
+                                              const char* cpu_features) {
+  char type_str[32];
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(flags);
+  iree_uk_type_pair_str(type_str, sizeof type_str, argmax_type);
+  iree_uk_argmax_params_t params = {.flags = flags};
+  char name[128];
+  snprintf(name, sizeof name, "argmax_%s_%" PRIi64 "x%" PRIi64, type_str,
+           FLAG_rows, FLAG_vocab_size);
+  iree_uk_benchmark_register(name, iree_uk_benchmark_argmax, &params,
+                             sizeof params, cpu_features);
+}
+
+int main(int argc, char** argv) {
+  iree_flags_set_usage("argmax_benchmark", "");
+
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
+  iree_uk_benchmark_initialize(&argc, argv);
+
+  // Generic code, for comparison with the architecture-specific tile
+  // functions below.
+  iree_uk_benchmark_register_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F16I64, "");
+  iree_uk_benchmark_register_argmax(IREE_UK_FLAG_ARGMAX_TYPE_BF16I64, "");
+
+#if defined(IREE_ARCH_X86_64)
+  iree_uk_benchmark_register_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I64,
+                                    "avx2_fma");
+  iree_uk_benchmark_register_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I64,
+                                    "avx512_base");
+#else   // defined(IREE_ARCH_X86_64)
+  iree_uk_benchmark_register_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I64, "");
+#endif  // defined(IREE_ARCH_X86_64)
+
+  iree_uk_benchmark_run_and_cleanup();
+}
@@ -0,0 +1,192 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/api.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/argmax_internal.h"
+#include "iree/builtins/ukernel/tools/test.h"
+#include "iree/builtins/ukernel/tools/util.h"
+
+static float iree_argmax_reference_load(const void* buffer,
+                                        iree_uk_type_t type,
+                                        iree_uk_index_t i) {
+  switch (type) {
+    case IREE_UK_TYPE_FLOAT_16:
+      return iree_uk_f16_to_f32(((const iree_uk_uint16_t*)buffer)[i]);
+    case IREE_UK_TYPE_BFLOAT_16:
+      return iree_uk_bf16_to_f32(((const iree_uk_uint16_t*)buffer)[i]);
+    default:
+      return ((const float*)buffer)[i];
+  }
+}
+
+// Matches the linalg.generic argmax idiom: a strict `arith.cmpf ogt` against an
+// `arith.maximumf` accumulator initialized to -inf, so that ties keep the first
+// index and nothing after the first NaN (which the accumulator propagates) is
+// selected.
+static void iree_argmax_reference(const iree_uk_argmax_params_t* params) {
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(params->flags);
+  iree_uk_type_t in_type = iree_uk_argmax_in_type(argmax_type);
+  iree_uk_type_t out_type = iree_uk_argmax_out_type(argmax_type);
+  iree_uk_index_t in_elem_size = iree_uk_type_size(in_type);
+  iree_uk_index_t out_elem_size = iree_uk_type_size(out_type);
+  for (iree_uk_index_t i0 = 0; i0 < params->size0; ++i0) {
+    const char* in_row =
+        (const char*)params->in_buffer +
+        (params->in_offset + i0 * params->in_stride0) * in_elem_size;
+    float max = iree_uk_argmax_f32_neg_inf();
+    iree_uk_index_t best_index = -1;
+    for (iree_uk_index_t i1 = 0; i1 < params->size1; ++i1) {
+      float value = iree_argmax_reference_load(in_row, in_type, i1);
+      if (value > max) best_index = i1;
+      // arith.maximumf propagates NaN and nothing compares greater after.
+      if (value != value || value > max) max = value;
+    }
+    if (best_index < 0) continue;
+    char* out_ptr =
+        (char*)params->out_buffer +
+        (params->out_offset + i0 * params->out_stride0) * out_elem_size;
+    if (out_type == IREE_UK_TYPE_INT_32) {
+      *(iree_uk_int32_t*)out_ptr = (iree_uk_int32_t)best_index;
+    } else {
+      *(iree_uk_int64_t*)out_ptr = best_index;
+    }
+  }
+}
+
+// Overwrites some input elements with -inf and, in some rows, NaN, and
+// occasionally a whole row with -inf, to exercise the cases where the ukernel
+// must stop early or not update the output.
+static void iree_uk_test_argmax_write_special_values(
+    iree_uk_test_t* test, const iree_uk_argmax_params_t* params, void* buffer) {
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(params->flags);
+  iree_uk_type_t in_type = iree_uk_argmax_in_type(argmax_type);
+  iree_uk_random_engine_t* engine = iree_uk_test_random_engine(test);
+  for (iree_uk_index_t i0 = 0; i0 < params->size0; ++i0) {
+    bool all_neg_inf = iree_uk_random_engine_get_0_255(engine) < 32;
+    bool has_nan = iree_uk_random_engine_get_0_255(engine) < 64;
+    for (iree_uk_index_t i1 = 0; i1 < params->size1; ++i1) {
+      int r = iree_uk_random_engine_get_0_255(engine);
+      bool nan = !all_neg_inf && has_nan && r < 2;
+      bool neg_inf = all_neg_inf || (r >= 8 && r < 16);
+      if (!nan && !neg_inf) continue;
+      iree_uk_index_t i = i0 * params->in_stride0 + i1;
+      if (in_type == IREE_UK_TYPE_FLOAT_32) {
+        ((iree_uk_uint32_t*)buffer)[i] = nan ? 0x7FC00000u : 0xFF800000u;
+      } else if (in_type == IREE_UK_TYPE_FLOAT_16) {
+        ((iree_uk_uint16_t*)buffer)[i] = nan ? 0x7E00u : 0xFC00u;
+      } else {
+        ((iree_uk_uint16_t*)buffer)[i] = nan ? 0x7FC0u : 0xFF80u;
+      }
+    }
+  }
+}
+
+static void iree_uk_test_argmax_for_shape_params(
+    iree_uk_test_t* test, const iree_uk_argmax_params_t* src_params) {
+  iree_uk_argmax_params_t params;
+  memcpy(&params, src_params, sizeof params);
+  // Randomly make strides either tight or not to exercise all cases.
+  iree_uk_random_engine_t* engine = iree_uk_test_random_engine(test);
+  params.in_stride0 = params.size1 + iree_uk_random_engine_get_0_1(engine);
+  params.out_stride0 = 1 + iree_uk_random_engine_get_0_1(engine);
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(params.flags);
+  iree_uk_type_t in_type = iree_uk_argmax_in_type(argmax_type);
+  iree_uk_type_t out_type = iree_uk_argmax_out_type(argmax_type);
+  iree_uk_index_t in_buffer_size =
+      iree_uk_2d_buffer_length(in_type, params.size0, params.in_stride0);
+  void* in_buffer = malloc(in_buffer_size);
+  iree_uk_write_random_buffer(in_buffer, in_buffer_size, in_type, engine);
+  iree_uk_test_argmax_write_special_values(test, &params, in_buffer);
+  params.in_offset = iree_uk_random_engine_get_0_65535(engine);
+  params.out_offset = iree_uk_random_engine_get_0_65535(engine);
+  params.in_buffer =
+      (const char*)in_buffer - (params.in_offset * iree_uk_type_size(in_type));
+
+  // Both output buffers start out with the same contents, as rows without any
+  // value greater than -inf must be left untouched.
+  iree_uk_index_t out_buffer_size =
+      iree_uk_2d_buffer_length(out_type, params.size0, params.out_stride0);
+  void* reference_out_buffer = malloc(out_buffer_size);
+  // Random i32 words are fine garbage for i64 outputs too.
+  iree_uk_write_random_buffer(reference_out_buffer, out_buffer_size,
+                              IREE_UK_TYPE_INT_32, engine);
+  void* actual_out_buffer = malloc(out_buffer_size);
+  memcpy(actual_out_buffer, reference_out_buffer, out_buffer_size);
+
+  iree_uk_argmax_params_t reference_params;
+  memcpy(&reference_params, &params, sizeof reference_params);
+  reference_params.out_buffer =
+      (char*)reference_out_buffer -
+      (params.out_offset * iree_uk_type_size(out_type));
+
+  iree_uk_argmax_params_t actual_params;
+  memcpy(&actual_params, &params, sizeof actual_params);
+  actual_params.out_buffer = (char*)actual_out_buffer -
+                             (params.out_offset * iree_uk_type_size(out_type));
+
+  iree_argmax_reference(&reference_params);
+  iree_uk_argmax_p(&actual_params);
+
+  if (!iree_uk_2d_buffers_equal(actual_out_buffer, reference_out_buffer,
+                                out_type, params.size0, 1, params.out_stride0,
+                                1)) {
+    IREE_UK_TEST_FAIL(test);
+  }
+
+  free(reference_out_buffer);
+  free(actual_out_buffer);
+  free(in_buffer);
+}
+
+static void iree_uk_test_argmax_for_type_params(iree_uk_test_t* test,
+                                                const void* src_params) {
+  // Row lengths straddle the vector widths and tail handling of the
+  // architecture-specific tile functions.
+  const int sizes0[] = {0, 1, 3, 7};
+  const int sizes1[] = {0, 1, 5, 8, 15, 16, 17, 33, 100, 1000};
+  for (int i = 0; i < IREE_ARRAYSIZE(sizes0); ++i) {
+    for (int j = 0; j < IREE_ARRAYSIZE(sizes1); ++j) {
+      iree_uk_argmax_params_t params;
+      memcpy(&params, src_params, sizeof params);
+      params.cpu_data = iree_uk_test_cpu_data(test);
+      params.size0 = sizes0[i];
+      params.size1 = sizes1[j];
+      iree_uk_test_argmax_for_shape_params(test, &params);
+    }
+  }
+}
+
+static void iree_uk_test_argmax(iree_uk_uint32_t flags,
+                                const char* cpu_features) {
+  iree_uk_argmax_params_t params = {.flags = flags};
+  char types_str[32];
+  iree_uk_argmax_type_t argmax_type = iree_uk_argmax_type(flags);
+  iree_uk_type_pair_str(types_str, sizeof types_str, argmax_type);
+  char test_label_str[256];
+  snprintf(test_label_str, sizeof test_label_str, "types:%s", types_str);
+  iree_uk_test(test_label_str, iree_uk_test_argmax_for_type_params, &params,
+               cpu_features);
+}
+
+int main(int argc, char** argv) {
+  // Generic tests, not matching any particular CPU feature.
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I32, "");
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I64, "");
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F16I32, "");
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F16I64, "");
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_BF16I32, "");
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_BF16I64, "");
+
+#if defined(IREE_ARCH_X86_64)
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I32, "avx2_fma");
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I64, "avx2_fma");
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I32, "avx512_base");
+  iree_uk_test_argmax(IREE_UK_FLAG_ARGMAX_TYPE_F32I64, "avx512_base");
+#endif  // defined(IREE_ARCH_X86_64)
+
+  return iree_uk_test_exit_status();
+}
@@ -0,0 +1,124 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/flags.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/tools/benchmark.h"
+#include "iree/builtins/ukernel/tools/util.h"
+#include "iree/builtins/ukernel/topk_internal.h"
+
+IREE_FLAG(int64_t, vocab_size, 32000,
+          "Row length, e.g. the vocabulary size when sampling LLM logits.");
+IREE_FLAG(int64_t, rows, 1,
+          "Number of rows, e.g. the batch size when sampling LLM logits.");
+IREE_FLAG(int64_t, k, 40, "Number of values to select from each row.");
+
+// Resets the outputs to -inf so that every iteration performs a full
+// selection rather than only scanning against an already-high threshold.
+static void iree_uk_benchmark_topk_reset(const iree_uk_topk_params_t* params,
+                                         iree_uk_type_t value_type) {
+  iree_uk_index_t count = params->size0 * params->out_values_stride0;
+  if (value_type == IREE_UK_TYPE_FLOAT_32) {
+    for (iree_uk_index_t i = 0; i < count; ++i) {
+      ((iree_uk_uint32_t*)params->out_values_buffer)[i] = 0xFF800000u;
+    }
+  } else {
+    iree_uk_uint16_t bits =
+        value_type == IREE_UK_TYPE_FLOAT_16 ? 0xFC00u : 0xFF80u;
+    for (iree_uk_index_t i = 0; i < count; ++i) {
+      ((iree_uk_uint16_t*)params->out_values_buffer)[i] = bits;
+    }
+  }
+  memset(params->out_indices_buffer, 0, count * sizeof(iree_uk_int32_t));
+}
+
+static iree_status_t iree_uk_benchmark_topk(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  const iree_uk_benchmark_user_data_t* user_data = benchmark_def->user_data;
+  const iree_uk_topk_params_t* src_params =
+      iree_uk_benchmark_params(user_data);
+  iree_uk_topk_params_t params;
+  memcpy(&params, src_params, sizeof params);
+  params.cpu_data = iree_uk_benchmark_cpu_data(user_data);
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(params.flags);
+  iree_uk_type_t value_type = iree_uk_topk_value_type(topk_type);
+  iree_uk_type_t index_type = iree_uk_topk_index_type(topk_type);
+  params.size0 = FLAG_rows;
+  params.size1 = FLAG_vocab_size;
+  params.k = FLAG_k;
+  params.in_stride0 = params.size1;
+  params.out_values_stride0 = params.k;
+  params.out_indices_stride0 = params.k;
+  iree_uk_index_t in_buffer_size =
+      iree_uk_2d_buffer_length(value_type, params.size0, params.in_stride0);
+  void* in_buffer = malloc(in_buffer_size);
+  void* values_buffer = malloc(iree_uk_2d_buffer_length(
+      value_type, params.size0, params.out_values_stride0));
+  void* indices_buffer = malloc(iree_uk_2d_buffer_length(
+      index_type, params.size0, params.out_indices_stride0));
+  iree_uk_random_engine_t* engine = iree_uk_benchmark_random_engine(user_data);
+  iree_uk_write_random_buffer(in_buffer, in_buffer_size, value_type, engine);
+  params.in_buffer = in_buffer;
+  params.out_values_buffer = values_buffer;
+  params.out_indices_buffer = indices_buffer;
+  int64_t total_iterations = 0;
+  int64_t batch_count = 1;
+  while (iree_benchmark_keep_running(benchmark_state, batch_count)) {
+    for (int i = 0; i < batch_count; ++i) {
+      iree_uk_benchmark_topk_reset(&params, value_type);
+      iree_uk_topk_p(&params);
+    }
+    total_iterations += batch_count;
+    batch_count *= 2;
+  }
+  // Report bytes per second: once the K-th value has settled this is mostly a
+  // single pass over the input, so it should approach memory bandwidth.
+  iree_benchmark_set_bytes_processed(benchmark_state,
+                                     total_iterations * in_buffer_size);
+  free(in_buffer);
+  free(values_buffer);
+  free(indices_buffer);
+  return iree_ok_status();
+}
+
+static void iree_uk_benchmark_register_topk(iree_uk_uint32_t flags,
+                                            const char* cpu_features) {
+  char type_str[32];
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(flags);
+  iree_uk_type_pair_str(type_str, sizeof type_str, topk_type);
+  iree_uk_topk_params_t params = {.flags = flags};
+  char name[128];
+  snprintf(name, sizeof name, "topk_%s_%" PRIi64 "x%" PRIi64 "_k_%" PRIi64,
+           type_str, FLAG_rows, FLAG_vocab_size, FLAG_k);
+  iree_uk_benchmark_register(name, iree_uk_benchmark_topk, &params,
+                             sizeof params, cpu_features);
+}
+
+int main(int argc, char** argv) {
+  iree_flags_set_usage("topk_benchmark", "");
+
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
+  iree_uk_benchmark_initialize(&argc, argv);
+
+  // Generic code, for comparison with the architecture-specific scan
+  // functions below.
+  iree_uk_benchmark_register_topk(IREE_UK_FLAG_TOPK_TYPE_F16I32, "");
+  iree_uk_benchmark_register_topk(IREE_UK_FLAG_TOPK_TYPE_BF16I32, "");
+
+#if defined(IREE_ARCH_X86_64)
+  iree_uk_benchmark_register_topk(IREE_UK_FLAG_TOPK_TYPE_F32I32, "avx2_fma");
+  iree_uk_benchmark_register_topk(IREE_UK_FLAG_TOPK_TYPE_F32I32,
+                                  "avx512_base");
+#else   // defined(IREE_ARCH_X86_64)
+  iree_uk_benchmark_register_topk(IREE_UK_FLAG_TOPK_TYPE_F32I32, "");
+#endif  // defined(IREE_ARCH_X86_64)
+
+  iree_uk_benchmark_run_and_cleanup();
+}
@@ -0,0 +1,215 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/api.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/tools/test.h"
+#include "iree/builtins/ukernel/tools/util.h"
+#include "iree/builtins/ukernel/topk_internal.h"
+
+// Literal transcription of the scalar implementation of iree_linalg_ext.topk:
+// each input element is carried through the K output slots, swapping with any
+// slot that it compares before. Values that compare equal only swap indices.
+static void iree_topk_reference(const iree_uk_topk_params_t* params) {
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(params->flags);
+  iree_uk_type_t value_type = iree_uk_topk_value_type(topk_type);
+  iree_uk_index_t value_size = iree_uk_type_size(value_type);
+  const bool smallest = params->flags & IREE_UK_FLAG_TOPK_SMALLEST;
+  for (iree_uk_index_t i0 = 0; i0 < params->size0; ++i0) {
+    const char* in_row =
+        (const char*)params->in_buffer +
+        (params->in_offset + i0 * params->in_stride0) * value_size;
+    char* values_row =
+        (char*)params->out_values_buffer +
+        (params->out_values_offset + i0 * params->out_values_stride0) *
+            value_size;
+    iree_uk_int32_t* indices_row =
+        (iree_uk_int32_t*)params->out_indices_buffer +
+        params->out_indices_offset + i0 * params->out_indices_stride0;
+    for (iree_uk_index_t i1 = 0; i1 < params->size1; ++i1) {
+      char carry_value[4];
+      memcpy(carry_value, in_row + i1 * value_size, value_size);
+      iree_uk_int32_t carry_index = (iree_uk_int32_t)i1;
+      for (iree_uk_index_t k = 0; k < params->k; ++k) {
+        float new_value = iree_uk_topk_load_value(carry_value, value_type, 0);
+        float k_value = iree_uk_topk_load_value(values_row, value_type, k);
+        bool forward = smallest ? new_value < k_value : new_value > k_value;
+        bool backward = smallest ? k_value < new_value : k_value > new_value;
+        bool equal = forward == backward;
+        bool index_cmp = forward || (equal && carry_index < indices_row[k]);
+        if (forward) {
+          char tmp[4];
+          memcpy(tmp, values_row + k * value_size, value_size);
+          memcpy(values_row + k * value_size, carry_value, value_size);
+          memcpy(carry_value, tmp, value_size);
+        }
+        if (index_cmp) {
+          iree_uk_int32_t tmp = indices_row[k];
+          indices_row[k] = carry_index;
+          carry_index = tmp;
+        }
+      }
+    }
+  }
+}
+
+// Fills the outputs with the initial value that the op would be given (-inf,
+// or +inf when selecting the smallest values) and index 0.
+static void iree_uk_test_topk_fill_init(const iree_uk_topk_params_t* params,
+                                        void* values_buffer,
+                                        iree_uk_index_t values_buffer_size,
+                                        void* indices_buffer,
+                                        iree_uk_index_t indices_buffer_size) {
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(params->flags);
+  iree_uk_type_t value_type = iree_uk_topk_value_type(topk_type);
+  const bool smallest = params->flags & IREE_UK_FLAG_TOPK_SMALLEST;
+  if (value_type == IREE_UK_TYPE_FLOAT_32) {
+    iree_uk_uint32_t bits = smallest ? 0x7F800000u : 0xFF800000u;
+    for (iree_uk_index_t i = 0; i < values_buffer_size / 4; ++i) {
+      ((iree_uk_uint32_t*)values_buffer)[i] = bits;
+    }
+  } else {
+    iree_uk_uint16_t bits;
+    if (value_type == IREE_UK_TYPE_FLOAT_16) {
+      bits = smallest ? 0x7C00u : 0xFC00u;
+    } else {
+      bits = smallest ? 0x7F80u : 0xFF80u;
+    }
+    for (iree_uk_index_t i = 0; i < values_buffer_size / 2; ++i) {
+      ((iree_uk_uint16_t*)values_buffer)[i] = bits;
+    }
+  }
+  memset(indices_buffer, 0, indices_buffer_size);
+}
+
+static void iree_uk_test_topk_for_shape_params(
+    iree_uk_test_t* test, const iree_uk_topk_params_t* src_params) {
+  iree_uk_topk_params_t params;
+  memcpy(&params, src_params, sizeof params);
+  // Randomly make strides either tight or not to exercise all cases.
+  iree_uk_random_engine_t* engine = iree_uk_test_random_engine(test);
+  params.in_stride0 = params.size1 + iree_uk_random_engine_get_0_1(engine);
+  params.out_values_stride0 = params.k + iree_uk_random_engine_get_0_1(engine);
+  params.out_indices_stride0 =
+      params.k + iree_uk_random_engine_get_0_1(engine);
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(params.flags);
+  iree_uk_type_t value_type = iree_uk_topk_value_type(topk_type);
+  iree_uk_type_t index_type = iree_uk_topk_index_type(topk_type);
+  iree_uk_index_t value_size = iree_uk_type_size(value_type);
+  iree_uk_index_t index_size = iree_uk_type_size(index_type);
+  iree_uk_index_t in_buffer_size =
+      iree_uk_2d_buffer_length(value_type, params.size0, params.in_stride0);
+  void* in_buffer = malloc(in_buffer_size);
+  params.in_offset = iree_uk_random_engine_get_0_65535(engine);
+  params.out_values_offset = iree_uk_random_engine_get_0_65535(engine);
+  params.out_indices_offset = iree_uk_random_engine_get_0_65535(engine);
+  params.in_buffer = (const char*)in_buffer - params.in_offset * value_size;
+
+  iree_uk_index_t values_buffer_size = iree_uk_2d_buffer_length(
+      value_type, params.size0, params.out_values_stride0);
+  iree_uk_index_t indices_buffer_size = iree_uk_2d_buffer_length(
+      index_type, params.size0, params.out_indices_stride0);
+  void* reference_values_buffer = malloc(values_buffer_size);
+  void* reference_indices_buffer = malloc(indices_buffer_size);
+  iree_uk_topk_params_t reference_params;
+  memcpy(&reference_params, &params, sizeof reference_params);
+  reference_params.out_values_buffer =
+      (char*)reference_values_buffer - params.out_values_offset * value_size;
+  reference_params.out_indices_buffer =
+      (char*)reference_indices_buffer - params.out_indices_offset * index_size;
+
+  // Start from either freshly initialized outputs or outputs already holding
+  // the result of an earlier input, as when the op is tiled along the
+  // reduction dimension.
+  iree_uk_test_topk_fill_init(&params, reference_values_buffer,
+                              values_buffer_size, reference_indices_buffer,
+                              indices_buffer_size);
+  if (iree_uk_random_engine_get_0_1(engine)) {
+    iree_uk_write_random_buffer(in_buffer, in_buffer_size, value_type, engine);
+    iree_topk_reference(&reference_params);
+  }
+  iree_uk_write_random_buffer(in_buffer, in_buffer_size, value_type, engine);
+
+  void* actual_values_buffer = malloc(values_buffer_size);
+  void* actual_indices_buffer = malloc(indices_buffer_size);
+  memcpy(actual_values_buffer, reference_values_buffer, values_buffer_size);
+  memcpy(actual_indices_buffer, reference_indices_buffer, indices_buffer_size);
+  iree_uk_topk_params_t actual_params;
+  memcpy(&actual_params, &params, sizeof actual_params);
+  actual_params.out_values_buffer =
+      (char*)actual_values_buffer - params.out_values_offset * value_size;
+  actual_params.out_indices_buffer =
+      (char*)actual_indices_buffer - params.out_indices_offset * index_size;
+
+  iree_topk_reference(&reference_params);
+  iree_uk_topk_p(&actual_params);
+
+  if (!iree_uk_2d_buffers_equal(actual_values_buffer, reference_values_buffer,
+                                value_type, params.size0, params.k,
+                                params.out_values_stride0, 1) ||
+      !iree_uk_2d_buffers_equal(actual_indices_buffer, reference_indices_buffer,
+                                index_type, params.size0, params.k,
+                                params.out_indices_stride0, 1)) {
+    IREE_UK_TEST_FAIL(test);
+  }
+
+  free(reference_values_buffer);
+  free(reference_indices_buffer);
+  free(actual_values_buffer);
+  free(actual_indices_buffer);
+  free(in_buffer);
+}
+
+static void iree_uk_test_topk_for_type_params(iree_uk_test_t* test,
+                                              const void* src_params) {
+  // Row lengths straddle the block sizes of the architecture-specific scan
+  // functions, and K ranges from argmax-like to larger than some rows.
+  const int sizes0[] = {0, 1, 3};
+  const int sizes1[] = {0, 1, 7, 16, 33, 100, 1000};
+  const int ks[] = {0, 1, 4, 40};
+  for (int i = 0; i < IREE_ARRAYSIZE(sizes0); ++i) {
+    for (int j = 0; j < IREE_ARRAYSIZE(sizes1); ++j) {
+      for (int l = 0; l < IREE_ARRAYSIZE(ks); ++l) {
+        for (int smallest = 0; smallest <= 1; ++smallest) {
+          iree_uk_topk_params_t params;
+          memcpy(&params, src_params, sizeof params);
+          params.cpu_data = iree_uk_test_cpu_data(test);
+          params.size0 = sizes0[i];
+          params.size1 = sizes1[j];
+          params.k = ks[l];
+          if (smallest) params.flags |= IREE_UK_FLAG_TOPK_SMALLEST;
+          iree_uk_test_topk_for_shape_params(test, &params);
+        }
+      }
+    }
+  }
+}
+
+static void iree_uk_test_topk(iree_uk_uint32_t flags,
+                              const char* cpu_features) {
+  iree_uk_topk_params_t params = {.flags = flags};
+  char types_str[32];
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(flags);
+  iree_uk_type_pair_str(types_str, sizeof types_str, topk_type);
+  char test_label_str[256];
+  snprintf(test_label_str, sizeof test_label_str, "types:%s", types_str);
+  iree_uk_test(test_label_str, iree_uk_test_topk_for_type_params, &params,
+               cpu_features);
+}
+
+int main(int argc, char** argv) {
+  // Generic tests, not matching any particular CPU feature.
+  iree_uk_test_topk(IREE_UK_FLAG_TOPK_TYPE_F32I32, "");
+  iree_uk_test_topk(IREE_UK_FLAG_TOPK_TYPE_F16I32, "");
+  iree_uk_test_topk(IREE_UK_FLAG_TOPK_TYPE_BF16I32, "");
+
+#if defined(IREE_ARCH_X86_64)
+  iree_uk_test_topk(IREE_UK_FLAG_TOPK_TYPE_F32I32, "avx2_fma");
+  iree_uk_test_topk(IREE_UK_FLAG_TOPK_TYPE_F32I32, "avx512_base");
+#endif  // defined(IREE_ARCH_X86_64)
+
+  return iree_uk_test_exit_status();
+}
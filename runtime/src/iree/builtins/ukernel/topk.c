@@ -0,0 +1,142 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/topk_internal.h"
+
+static void iree_uk_topk_validate(const iree_uk_topk_params_t* params) {
+#ifdef IREE_UK_ENABLE_ASSERTS
+  const iree_uk_uint32_t allflags =
+      IREE_UK_FLAG_TOPK_TYPE_MASK | IREE_UK_FLAG_TOPK_SMALLEST;
+  IREE_UK_ASSERT(!(params->flags & ~allflags));
+  iree_uk_uint32_t flags_type = params->flags & IREE_UK_FLAG_TOPK_TYPE_MASK;
+  IREE_UK_ASSERT(flags_type == IREE_UK_FLAG_TOPK_TYPE_F32I32 ||
+                 flags_type == IREE_UK_FLAG_TOPK_TYPE_F16I32 ||
+                 flags_type == IREE_UK_FLAG_TOPK_TYPE_BF16I32);
+  IREE_UK_ASSERT(params->size0 >= 0);
+  IREE_UK_ASSERT(params->size1 >= 0);
+  IREE_UK_ASSERT(params->k >= 0);
+  // Indices are i32.
+  IREE_UK_ASSERT(params->size1 <= 0x7FFFFFFF);
+  IREE_UK_ASSERT(params->size0 <= 1 || params->in_stride0 >= params->size1);
+  IREE_UK_ASSERT(params->size0 <= 1 ||
+                 params->out_values_stride0 >= params->k);
+  IREE_UK_ASSERT(params->size0 <= 1 ||
+                 params->out_indices_stride0 >= params->k);
+#endif  // IREE_UK_ENABLE_ASSERTS
+}
+
+// Early-return implementation for this ukernel. Returns true if already done.
+static bool iree_uk_topk_early(const iree_uk_topk_params_t* params) {
+  return params->size0 == 0 || params->size1 == 0 || params->k == 0;
+}
+
+// Returns true if the input element (`value`, `index`) is ordered before the
+// output element (`other_value`, `other_index`). Ties are broken by index as
+// in the reference implementation of the op.
+static inline bool iree_uk_topk_precedes(float value, iree_uk_int32_t index,
+                                         float other_value,
+                                         iree_uk_int32_t other_index,
+                                         bool smallest) {
+  if (value == other_value) return index < other_index;
+  return smallest ? value < other_value : value > other_value;
+}
+
+static void iree_uk_topk_row(const iree_uk_topk_params_t* params,
+                             iree_uk_topk_scan_func_t scan_func,
+                             iree_uk_type_t value_type,
+                             iree_uk_index_t value_size, const char* in_row,
+                             char* values_row, iree_uk_int32_t* indices_row) {
+  const bool smallest = params->flags & IREE_UK_FLAG_TOPK_SMALLEST;
+  const iree_uk_index_t k = params->k;
+  const iree_uk_index_t size1 = params->size1;
+  float threshold = iree_uk_topk_load_value(values_row, value_type, k - 1);
+  iree_uk_int32_t threshold_index = indices_row[k - 1];
+  iree_uk_index_t j = 0;
+  while ((j = scan_func(in_row, j, size1, threshold)) < size1) {
+    float value = iree_uk_topk_load_value(in_row, value_type, j);
+    iree_uk_int32_t index = (iree_uk_int32_t)j;
+    if (iree_uk_topk_precedes(value, index, threshold, threshold_index,
+                              smallest)) {
+      // Find the insertion position, shifting the displaced tail down. The
+      // last element drops out.
+      iree_uk_index_t pos = k - 1;
+      while (pos > 0) {
+        float prev = iree_uk_topk_load_value(values_row, value_type, pos - 1);
+        if (!iree_uk_topk_precedes(value, index, prev, indices_row[pos - 1],
+                                   smallest)) {
+          break;
+        }
+        iree_uk_memcpy(values_row + pos * value_size,
+                       values_row + (pos - 1) * value_size, value_size);
+        indices_row[pos] = indices_row[pos - 1];
+        --pos;
+      }
+      iree_uk_memcpy(values_row + pos * value_size, in_row + j * value_size,
+                     value_size);
+      indices_row[pos] = index;
+      threshold = iree_uk_topk_load_value(values_row, value_type, k - 1);
+      threshold_index = indices_row[k - 1];
+    }
+    ++j;
+  }
+}
+
+static void iree_uk_topk_using_scan_func(const iree_uk_topk_params_t* params,
+                                         iree_uk_topk_scan_func_t scan_func) {
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(params->flags);
+  iree_uk_type_t value_type = iree_uk_topk_value_type(topk_type);
+  iree_uk_index_t value_size = iree_uk_type_size(value_type);
+  const char* in_row =
+      (const char*)params->in_buffer + params->in_offset * value_size;
+  char* values_row = (char*)params->out_values_buffer +
+                     params->out_values_offset * value_size;
+  iree_uk_int32_t* indices_row =
+      (iree_uk_int32_t*)params->out_indices_buffer +
+      params->out_indices_offset;
+  for (iree_uk_index_t i0 = 0; i0 < params->size0; ++i0) {
+    iree_uk_topk_row(params, scan_func, value_type, value_size, in_row,
+                     values_row, indices_row);
+    in_row += params->in_stride0 * value_size;
+    values_row += params->out_values_stride0 * value_size;
+    indices_row += params->out_indices_stride0;
+  }
+}
+
+void iree_uk_topk_p(const iree_uk_topk_params_t* params) {
+  iree_uk_topk_validate(params);
+
+  if (iree_uk_topk_early(params)) return;
+
+  // Select a target-specific scan_func and use that with generic outer loops.
+  iree_uk_topk_scan_func_t func = iree_uk_topk_select_scan_func(params);
+  iree_uk_topk_using_scan_func(params, func);
+}
+
+IREE_UK_EXPORT void iree_uk_topk(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, void* out_values_buffer,
+    iree_uk_index_t out_values_offset, iree_uk_index_t out_values_stride0,
+    void* out_indices_buffer, iree_uk_index_t out_indices_offset,
+    iree_uk_index_t out_indices_stride0, iree_uk_index_t size0,
+    iree_uk_index_t size1, iree_uk_index_t k, iree_uk_uint32_t flags,
+    const iree_uk_uint64_t* cpu_data) {
+  iree_uk_topk_params_t params = {
+      .in_buffer = in_buffer,
+      .in_offset = in_offset,
+      .in_stride0 = in_stride0,
+      .out_values_buffer = out_values_buffer,
+      .out_values_offset = out_values_offset,
+      .out_values_stride0 = out_values_stride0,
+      .out_indices_buffer = out_indices_buffer,
+      .out_indices_offset = out_indices_offset,
+      .out_indices_stride0 = out_indices_stride0,
+      .size0 = size0,
+      .size1 = size1,
+      .k = k,
+      .flags = flags,
+      .cpu_data = cpu_data};
+  iree_uk_topk_p(&params);
+}
@@ -0,0 +1,31 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_TOPK_H_
+#define IREE_BUILTINS_UKERNEL_TOPK_H_
+
+#include "iree/builtins/ukernel/common.h"
+
+// `topk` microkernel. Merges each row of a 2D input into the K values and
+// indices already held in the corresponding output rows, as in top-k sampling
+// of logits during LLM decode. This matches `iree_linalg_ext.topk` along the
+// inner dimension without an input indices operand: the index of an input
+// element is its position in the row.
+//
+// Output rows must be ordered as the op would produce them, typically by being
+// filled with -inf (or +inf with IREE_UK_FLAG_TOPK_SMALLEST). On equal values
+// the smaller index is ordered first, and NaN inputs are never selected.
+
+IREE_UK_EXPORT void iree_uk_topk(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, void* out_values_buffer,
+    iree_uk_index_t out_values_offset, iree_uk_index_t out_values_stride0,
+    void* out_indices_buffer, iree_uk_index_t out_indices_offset,
+    iree_uk_index_t out_indices_stride0, iree_uk_index_t size0,
+    iree_uk_index_t size1, iree_uk_index_t k, iree_uk_uint32_t flags,
+    const iree_uk_uint64_t* cpu_data);
+
+#endif  // IREE_BUILTINS_UKERNEL_TOPK_H_
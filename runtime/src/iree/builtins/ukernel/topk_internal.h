@@ -0,0 +1,96 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_TOPK_INTERNAL_H_
+#define IREE_BUILTINS_UKERNEL_TOPK_INTERNAL_H_
+
+#include "iree/builtins/ukernel/topk.h"
+
+typedef struct iree_uk_topk_params_t {
+  const void* in_buffer;
+  iree_uk_index_t in_offset;
+  iree_uk_index_t in_stride0;
+  void* out_values_buffer;
+  iree_uk_index_t out_values_offset;
+  iree_uk_index_t out_values_stride0;
+  void* out_indices_buffer;
+  iree_uk_index_t out_indices_offset;
+  iree_uk_index_t out_indices_stride0;
+  iree_uk_index_t size0;
+  iree_uk_index_t size1;
+  iree_uk_index_t k;
+  iree_uk_uint32_t flags;
+  const iree_uk_uint64_t* cpu_data;
+} iree_uk_topk_params_t;
+
+void iree_uk_topk_p(const iree_uk_topk_params_t* params);
+
+typedef enum iree_uk_topk_type_t {
+  iree_uk_topk_type_f32i32 = IREE_UK_TIE_2_TYPES_LITERAL(FLOAT_32, INT_32),
+  iree_uk_topk_type_f16i32 = IREE_UK_TIE_2_TYPES_LITERAL(FLOAT_16, INT_32),
+  iree_uk_topk_type_bf16i32 = IREE_UK_TIE_2_TYPES_LITERAL(BFLOAT_16, INT_32),
+} iree_uk_topk_type_t;
+
+static inline iree_uk_topk_type_t iree_uk_topk_type(iree_uk_uint32_t flags) {
+  switch (flags & IREE_UK_FLAG_TOPK_TYPE_MASK) {
+    case IREE_UK_FLAG_TOPK_TYPE_F32I32:
+      return iree_uk_topk_type_f32i32;
+    case IREE_UK_FLAG_TOPK_TYPE_F16I32:
+      return iree_uk_topk_type_f16i32;
+    case IREE_UK_FLAG_TOPK_TYPE_BF16I32:
+      return iree_uk_topk_type_bf16i32;
+    default:
+      // Shouldn't happen, validated earlier.
+      return (iree_uk_topk_type_t)0;
+  }
+}
+
+static inline iree_uk_type_t iree_uk_topk_value_type(iree_uk_topk_type_t type) {
+  return iree_uk_untie_type(0, type);
+}
+
+static inline iree_uk_type_t iree_uk_topk_index_type(iree_uk_topk_type_t type) {
+  return iree_uk_untie_type(1, type);
+}
+
+// Loads element `i` of a buffer of `type` values as a float.
+static inline float iree_uk_topk_load_value(const void* buffer,
+                                            iree_uk_type_t type,
+                                            iree_uk_index_t i) {
+  switch (type) {
+    case IREE_UK_TYPE_FLOAT_16:
+      return iree_uk_f16_to_f32(((const iree_uk_uint16_t*)buffer)[i]);
+    case IREE_UK_TYPE_BFLOAT_16:
+      return iree_uk_bf16_to_f32(((const iree_uk_uint16_t*)buffer)[i]);
+    default:
+      return ((const float*)buffer)[i];
+  }
+}
+
+// Returns the first position in [begin, end) of a contiguous row whose value
+// may displace the current K-th output `threshold`: >= threshold when
+// selecting the largest values, <= when selecting the smallest. Returns `end`
+// if there is none. Only candidates are inspected further by the caller, so
+// most of the row is covered by this scan alone once the outputs are warm.
+typedef iree_uk_index_t (*iree_uk_topk_scan_func_t)(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold);
+
+// Scan kernel declarations. Prototype matches iree_uk_topk_scan_func_t.
+#define IREE_UK_TOPK_SCAN_FUNC_DECL(NAME)                          \
+  iree_uk_index_t NAME(const void* IREE_UK_RESTRICT in_ptr,        \
+                       iree_uk_index_t begin, iree_uk_index_t end, \
+                       float threshold);
+
+// Returns the scan function to use for the topk op with the given params.
+iree_uk_topk_scan_func_t iree_uk_topk_select_scan_func(
+    const iree_uk_topk_params_t* params);
+
+// Architecture-specific implementation.
+iree_uk_topk_scan_func_t iree_uk_topk_select_scan_func_arch(
+    const iree_uk_topk_params_t* params);
+
+#endif  // IREE_BUILTINS_UKERNEL_TOPK_INTERNAL_H_
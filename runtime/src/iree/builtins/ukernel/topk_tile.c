@@ -0,0 +1,94 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/topk_internal.h"
+
+static iree_uk_index_t iree_uk_topk_scan_f32_largest_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  const float* IREE_UK_RESTRICT in = in_ptr;
+  for (iree_uk_index_t i = begin; i < end; ++i) {
+    if (in[i] >= threshold) return i;
+  }
+  return end;
+}
+
+static iree_uk_index_t iree_uk_topk_scan_f32_smallest_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  const float* IREE_UK_RESTRICT in = in_ptr;
+  for (iree_uk_index_t i = begin; i < end; ++i) {
+    if (in[i] <= threshold) return i;
+  }
+  return end;
+}
+
+static iree_uk_index_t iree_uk_topk_scan_x16_generic(
+    const iree_uk_uint16_t* IREE_UK_RESTRICT in, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold, int exp_bits, bool smallest) {
+  for (iree_uk_index_t i = begin; i < end; ++i) {
+    float value = iree_uk_generic_fp16_to_f32(in[i], exp_bits);
+    if (smallest ? value <= threshold : value >= threshold) return i;
+  }
+  return end;
+}
+
+static iree_uk_index_t iree_uk_topk_scan_f16_largest_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  return iree_uk_topk_scan_x16_generic(in_ptr, begin, end, threshold, 5,
+                                       /*smallest=*/false);
+}
+
+static iree_uk_index_t iree_uk_topk_scan_f16_smallest_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  return iree_uk_topk_scan_x16_generic(in_ptr, begin, end, threshold, 5,
+                                       /*smallest=*/true);
+}
+
+static iree_uk_index_t iree_uk_topk_scan_bf16_largest_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  return iree_uk_topk_scan_x16_generic(in_ptr, begin, end, threshold, 8,
+                                       /*smallest=*/false);
+}
+
+static iree_uk_index_t iree_uk_topk_scan_bf16_smallest_generic(
+    const void* IREE_UK_RESTRICT in_ptr, iree_uk_index_t begin,
+    iree_uk_index_t end, float threshold) {
+  return iree_uk_topk_scan_x16_generic(in_ptr, begin, end, threshold, 8,
+                                       /*smallest=*/true);
+}
+
+static iree_uk_topk_scan_func_t iree_uk_topk_select_scan_func_generic(
+    const iree_uk_topk_params_t* params) {
+  iree_uk_topk_type_t topk_type = iree_uk_topk_type(params->flags);
+  bool smallest = params->flags & IREE_UK_FLAG_TOPK_SMALLEST;
+  switch (iree_uk_topk_value_type(topk_type)) {
+    case IREE_UK_TYPE_FLOAT_16:
+      return smallest ? iree_uk_topk_scan_f16_smallest_generic
+                      : iree_uk_topk_scan_f16_largest_generic;
+    case IREE_UK_TYPE_BFLOAT_16:
+      return smallest ? iree_uk_topk_scan_bf16_smallest_generic
+                      : iree_uk_topk_scan_bf16_largest_generic;
+    default:
+      return smallest ? iree_uk_topk_scan_f32_smallest_generic
+                      : iree_uk_topk_scan_f32_largest_generic;
+  }
+}
+
+// Select the 'scan function' that is the typically target-optimized inner loop
+// implementation.
+iree_uk_topk_scan_func_t iree_uk_topk_select_scan_func(
+    const iree_uk_topk_params_t* params) {
+  iree_uk_topk_scan_func_t arch_scan_func =
+      iree_uk_topk_select_scan_func_arch(params);
+  if (arch_scan_func) {
+    return arch_scan_func;
+  }
+  return iree_uk_topk_select_scan_func_generic(params);
+}
@@ -0,0 +1,233 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/hal/drivers/local_sync/sync_device.h"
+#include "iree/hal/local/executable_library.h"
+#include "iree/hal/local/loaders/static_library_loader.h"
+#include "iree/testing/benchmark.h"
+
+//===----------------------------------------------------------------------===//
+// Benchmark executable
+//===----------------------------------------------------------------------===//
+
+// Increments the element of binding[0] indexed by the workgroup ID.
+// Small enough that the cost measured is dominated by the dispatch overhead.
+static int iree_hal_dispatch_list_benchmark_increment(
+    const iree_hal_executable_environment_v0_t* environment,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
+    const iree_hal_executable_workgroup_state_v0_t* workgroup_state) {
+  uint32_t* data = (uint32_t*)dispatch_state->binding_ptrs[0];
+  ++data[workgroup_state->workgroup_id_x];
+  return 0;
+}
+
+static const iree_hal_executable_library_header_t
+    iree_hal_dispatch_list_benchmark_header = {
+        .version = IREE_HAL_EXECUTABLE_LIBRARY_VERSION_LATEST,
+        .name = "dispatch_list_benchmark",
+        .features = IREE_HAL_EXECUTABLE_LIBRARY_FEATURE_NONE,
+        .sanitizer = IREE_HAL_EXECUTABLE_LIBRARY_SANITIZER_NONE,
+};
+static const iree_hal_executable_dispatch_v0_t
+    iree_hal_dispatch_list_benchmark_entry_points[1] = {
+        iree_hal_dispatch_list_benchmark_increment,
+};
+static const iree_hal_executable_dispatch_attrs_v0_t
+    iree_hal_dispatch_list_benchmark_entry_attrs[1] = {
+        {
+            .local_memory_pages = 0,
+            .constant_count = 0,
+            .binding_count = 1,
+        },
+};
+static const char* iree_hal_dispatch_list_benchmark_entry_point_names[1] = {
+    "increment",
+};
+static const iree_hal_executable_library_v0_t
+    iree_hal_dispatch_list_benchmark_library = {
+        .header = &iree_hal_dispatch_list_benchmark_header,
+        .imports =
+            {
+                .count = 0,
+                .symbols = NULL,
+            },
+        .exports =
+            {
+                .count = 1,
+                .ptrs = iree_hal_dispatch_list_benchmark_entry_points,
+                .attrs = iree_hal_dispatch_list_benchmark_entry_attrs,
+                .names = iree_hal_dispatch_list_benchmark_entry_point_names,
+                .tags = NULL,
+            },
+        .constants =
+            {
+                .count = 0,
+            },
+};
+
+static const iree_hal_executable_library_header_t**
+iree_hal_dispatch_list_benchmark_library_query(
+    iree_hal_executable_library_version_t max_version,
+    const iree_hal_executable_environment_v0_t* environment) {
+  return max_version <= IREE_HAL_EXECUTABLE_LIBRARY_VERSION_LATEST
+             ? (const iree_hal_executable_library_header_t**)&
+                   iree_hal_dispatch_list_benchmark_library
+             : NULL;
+}
+
+//===----------------------------------------------------------------------===//
+// Benchmarks
+//===----------------------------------------------------------------------===//
+
+// Shape of the command buffer executed by a benchmark.
+typedef struct iree_hal_dispatch_list_benchmark_params_t {
+  // Whether the device records command buffers as dispatch lists.
+  bool dispatch_lists;
+  // Number of dispatches recorded into the command buffer.
+  uint32_t dispatch_count;
+  // Number of workgroups in each dispatch.
+  uint32_t workgroup_count;
+} iree_hal_dispatch_list_benchmark_params_t;
+
+// Records a reusable command buffer with the configured dispatches and then
+// submits it repeatedly to a local-sync device. Reports dispatches per second.
+//
+// user_data is an iree_hal_dispatch_list_benchmark_params_t.
+static iree_status_t iree_hal_dispatch_list_benchmark_execute(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_allocator_t host_allocator = benchmark_state->host_allocator;
+  const iree_hal_dispatch_list_benchmark_params_t* params =
+      (const iree_hal_dispatch_list_benchmark_params_t*)
+          benchmark_def->user_data;
+
+  const iree_hal_executable_library_query_fn_t library_query_fns[1] = {
+      iree_hal_dispatch_list_benchmark_library_query,
+  };
+  iree_hal_executable_loader_t* loader = NULL;
+  IREE_CHECK_OK(iree_hal_static_library_loader_create(
+      IREE_ARRAYSIZE(library_query_fns), library_query_fns,
+      iree_hal_executable_import_provider_null(), host_allocator, &loader));
+  iree_hal_allocator_t* device_allocator = NULL;
+  IREE_CHECK_OK(iree_hal_allocator_create_heap(IREE_SV("local"),
+                                               host_allocator, host_allocator,
+                                               &device_allocator));
+  iree_hal_sync_device_params_t device_params;
+  iree_hal_sync_device_params_initialize(&device_params);
+  device_params.dispatch_lists = params->dispatch_lists;
+  iree_hal_device_t* device = NULL;
+  IREE_CHECK_OK(iree_hal_sync_device_create(
+      IREE_SV("local-sync"), &device_params, /*loader_count=*/1, &loader,
+      device_allocator, host_allocator, &device));
+
+  iree_status_t loop_status = iree_ok_status();
+  iree_hal_executable_cache_t* executable_cache = NULL;
+  IREE_CHECK_OK(iree_hal_executable_cache_create(
+      device, iree_string_view_empty(), iree_loop_inline(&loop_status),
+      &executable_cache));
+  iree_hal_executable_params_t executable_params;
+  iree_hal_executable_params_initialize(&executable_params);
+  executable_params.executable_format = IREE_SV("static");
+  executable_params.executable_data = iree_make_const_byte_span(
+      iree_hal_dispatch_list_benchmark_header.name,
+      strlen(iree_hal_dispatch_list_benchmark_header.name));
+  iree_hal_executable_t* executable = NULL;
+  IREE_CHECK_OK(iree_hal_executable_cache_prepare_executable(
+      executable_cache, &executable_params, &executable));
+
+  const iree_hal_buffer_params_t buffer_params = {
+      .type =
+          IREE_HAL_MEMORY_TYPE_HOST_LOCAL | IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+      .usage = IREE_HAL_BUFFER_USAGE_DISPATCH_STORAGE |
+               IREE_HAL_BUFFER_USAGE_MAPPING,
+  };
+  iree_hal_buffer_t* buffer = NULL;
+  IREE_CHECK_OK(iree_hal_allocator_allocate_buffer(
+      device_allocator, buffer_params,
+      params->workgroup_count * sizeof(uint32_t), &buffer));
+
+  iree_hal_command_buffer_t* command_buffer = NULL;
+  IREE_CHECK_OK(iree_hal_command_buffer_create(
+      device, IREE_HAL_COMMAND_BUFFER_MODE_DEFAULT,
+      IREE_HAL_COMMAND_CATEGORY_DISPATCH, IREE_HAL_QUEUE_AFFINITY_ANY,
+      /*binding_capacity=*/0, &command_buffer));
+  IREE_CHECK_OK(iree_hal_command_buffer_begin(command_buffer));
+  const uint32_t workgroup_count[3] = {params->workgroup_count, 1, 1};
+  const iree_hal_buffer_ref_t binding_refs[1] = {
+      iree_hal_make_buffer_ref(buffer, 0, IREE_HAL_WHOLE_BUFFER),
+  };
+  const iree_hal_buffer_ref_list_t bindings = {
+      .count = IREE_ARRAYSIZE(binding_refs),
+      .values = binding_refs,
+  };
+  for (uint32_t i = 0; i < params->dispatch_count; ++i) {
+    IREE_CHECK_OK(iree_hal_command_buffer_dispatch(
+        command_buffer, executable, /*entry_point=*/0, workgroup_count,
+        iree_const_byte_span_empty(), bindings, IREE_HAL_DISPATCH_FLAG_NONE));
+  }
+  IREE_CHECK_OK(iree_hal_command_buffer_end(command_buffer));
+
+  int64_t dispatch_count = 0;
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    IREE_CHECK_OK(iree_hal_device_queue_execute(
+        device, IREE_HAL_QUEUE_AFFINITY_ANY, iree_hal_semaphore_list_empty(),
+        iree_hal_semaphore_list_empty(), command_buffer,
+        iree_hal_buffer_binding_table_empty()));
+    dispatch_count += params->dispatch_count;
+  }
+  iree_benchmark_set_items_processed(benchmark_state, dispatch_count);
+
+  iree_hal_command_buffer_release(command_buffer);
+  iree_hal_buffer_release(buffer);
+  iree_hal_executable_release(executable);
+  iree_hal_executable_cache_release(executable_cache);
+  iree_hal_device_release(device);
+  iree_hal_allocator_release(device_allocator);
+  iree_hal_executable_loader_release(loader);
+  return iree_ok_status();
+}
+
+// Dispatch counts crossed with workgroup counts small enough to be overhead
+// bound, each run with deferred command buffers and with dispatch lists.
+static const iree_hal_dispatch_list_benchmark_params_t
+    iree_hal_dispatch_list_benchmark_params[] = {
+        {false, 16, 1},   {true, 16, 1},   {false, 256, 1},
+        {true, 256, 1},   {false, 256, 16}, {true, 256, 16},
+        {false, 1024, 1}, {true, 1024, 1},
+};
+
+int main(int argc, char** argv) {
+  iree_benchmark_initialize(&argc, argv);
+
+  iree_benchmark_def_t benchmark_def = {
+      .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+               IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+      .time_unit = IREE_BENCHMARK_UNIT_MICROSECOND,
+      .minimum_duration_ns = 0,
+      .iteration_count = 0,
+      .run = iree_hal_dispatch_list_benchmark_execute,
+  };
+  for (iree_host_size_t i = 0;
+       i < IREE_ARRAYSIZE(iree_hal_dispatch_list_benchmark_params); ++i) {
+    const iree_hal_dispatch_list_benchmark_params_t* params =
+        &iree_hal_dispatch_list_benchmark_params[i];
+    char name[64];
+    snprintf(name, sizeof(name), "%s_%ux%u",
+             params->dispatch_lists ? "dispatch_list" : "deferred",
+             params->dispatch_count, params->workgroup_count);
+    benchmark_def.user_data = (void*)params;
+    iree_benchmark_register(iree_make_cstring_view(name), &benchmark_def);
+  }
+
+  iree_benchmark_run_specified();
+  return 0;
+}
@@ -0,0 +1,127 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/hal/drivers/local_sync/sync_semaphore.h"
+#include "iree/testing/benchmark.h"
+
+// Shape of the fences joined by a benchmark.
+typedef struct iree_hal_fence_join_benchmark_params_t {
+  // Number of fences joined.
+  uint32_t fence_count;
+  // Number of timepoints in each fence.
+  uint32_t timepoint_count;
+  // Number of timepoints in each fence on semaphores shared by all fences.
+  // The remaining timepoints are on semaphores unique to each fence.
+  uint32_t shared_count;
+} iree_hal_fence_join_benchmark_params_t;
+
+// Joins fences with the given overlap and then waits on the joined fence.
+// All semaphores are already signaled so the wait measures the per-timepoint
+// overhead that deduplication avoids rather than any actual blocking.
+//
+// user_data is an iree_hal_fence_join_benchmark_params_t.
+static iree_status_t iree_hal_fence_join_benchmark_join_wait(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_allocator_t host_allocator = benchmark_state->host_allocator;
+  const iree_hal_fence_join_benchmark_params_t* params =
+      (const iree_hal_fence_join_benchmark_params_t*)benchmark_def->user_data;
+
+  iree_hal_sync_semaphore_state_t semaphore_state;
+  iree_hal_sync_semaphore_state_initialize(&semaphore_state);
+
+  // Create the shared semaphores followed by the unique ones for each fence.
+  const uint32_t unique_count = params->timepoint_count - params->shared_count;
+  const uint32_t semaphore_count =
+      params->shared_count + params->fence_count * unique_count;
+  iree_hal_semaphore_t** semaphores = NULL;
+  IREE_CHECK_OK(iree_allocator_malloc(host_allocator,
+                                      semaphore_count * sizeof(semaphores[0]),
+                                      (void**)&semaphores));
+  for (uint32_t i = 0; i < semaphore_count; ++i) {
+    IREE_CHECK_OK(iree_hal_sync_semaphore_create(
+        &semaphore_state, /*initial_value=*/UINT32_MAX, host_allocator,
+        &semaphores[i]));
+  }
+
+  // Each fence waits on all shared semaphores at differing values as forked
+  // work that consumed the same timelines would.
+  iree_hal_fence_t** fences = NULL;
+  IREE_CHECK_OK(iree_allocator_malloc(host_allocator,
+                                      params->fence_count * sizeof(fences[0]),
+                                      (void**)&fences));
+  for (uint32_t i = 0; i < params->fence_count; ++i) {
+    IREE_CHECK_OK(iree_hal_fence_create(params->timepoint_count,
+                                        host_allocator, &fences[i]));
+    for (uint32_t j = 0; j < params->shared_count; ++j) {
+      IREE_CHECK_OK(iree_hal_fence_insert(fences[i], semaphores[j], i + 1));
+    }
+    for (uint32_t j = 0; j < unique_count; ++j) {
+      IREE_CHECK_OK(iree_hal_fence_insert(
+          fences[i], semaphores[params->shared_count + i * unique_count + j],
+          1));
+    }
+  }
+
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    iree_hal_fence_t* joined_fence = NULL;
+    IREE_CHECK_OK(iree_hal_fence_join(params->fence_count, fences,
+                                      host_allocator, &joined_fence));
+    IREE_CHECK_OK(iree_hal_fence_wait(joined_fence, iree_immediate_timeout()));
+    iree_hal_fence_release(joined_fence);
+  }
+
+  for (uint32_t i = 0; i < params->fence_count; ++i) {
+    iree_hal_fence_release(fences[i]);
+  }
+  iree_allocator_free(host_allocator, fences);
+  for (uint32_t i = 0; i < semaphore_count; ++i) {
+    iree_hal_semaphore_release(semaphores[i]);
+  }
+  iree_allocator_free(host_allocator, semaphores);
+  iree_hal_sync_semaphore_state_deinitialize(&semaphore_state);
+  return iree_ok_status();
+}
+
+// Fork/join widths crossed with the fraction of timepoints shared.
+static const iree_hal_fence_join_benchmark_params_t
+    iree_hal_fence_join_benchmark_params[] = {
+        {2, 4, 0},  {2, 4, 2},  {2, 4, 4},  {8, 4, 0},
+        {8, 4, 2},  {8, 4, 4},  {32, 8, 0}, {32, 8, 4},
+        {32, 8, 8},
+};
+
+int main(int argc, char** argv) {
+  iree_benchmark_initialize(&argc, argv);
+
+  iree_benchmark_def_t benchmark_def = {
+      .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+               IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+      .time_unit = IREE_BENCHMARK_UNIT_NANOSECOND,
+      .minimum_duration_ns = 0,
+      .iteration_count = 0,
+      .run = iree_hal_fence_join_benchmark_join_wait,
+  };
+  for (iree_host_size_t i = 0;
+       i < IREE_ARRAYSIZE(iree_hal_fence_join_benchmark_params); ++i) {
+    const iree_hal_fence_join_benchmark_params_t* params =
+        &iree_hal_fence_join_benchmark_params[i];
+    char name[64];
+    snprintf(name, sizeof(name), "join_wait_%ux%u_shared_%u",
+             params->fence_count, params->timepoint_count,
+             params->shared_count);
+    benchmark_def.user_data = (void*)params;
+    iree_benchmark_register(iree_make_cstring_view(name), &benchmark_def);
+  }
+
+  iree_benchmark_run_specified();
+  return 0;
+}
@@ -10,10 +10,23 @@
 #include <stddef.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/flags.h"
 #include "iree/hal/drivers/local_sync/sync_driver.h"
 #include "iree/hal/local/loaders/registration/init.h"
 #include "iree/hal/local/plugins/registration/init.h"
 
+IREE_FLAG(bool, sync_dispatch_lists, false,
+          "Records command buffers without binding tables into precompiled\n"
+          "dispatch lists that resolve executables and bindings once when\n"
+          "recorded instead of on each submission.");
+
+IREE_FLAG(
+    string, sync_executable_load_mode, "immediate",
+    "Controls when executables are loaded:\n"
+    "  `immediate`: loaded on the calling thread when prepared.\n"
+    "  `lazy`: loaded when first used by a dispatch.\n"
+    "  `async`: same as `lazy` as there are no workers to load on.");
+
 static iree_status_t iree_hal_local_sync_driver_factory_enumerate(
     void* self, iree_host_size_t* out_driver_info_count,
     const iree_hal_driver_info_t** out_driver_infos) {
@@ -38,6 +51,10 @@ static iree_status_t iree_hal_local_sync_driver_factory_try_create(
 
   iree_hal_sync_device_params_t default_params;
   iree_hal_sync_device_params_initialize(&default_params);
+  default_params.dispatch_lists = FLAG_sync_dispatch_lists;
+  IREE_RETURN_IF_ERROR(iree_hal_local_executable_load_mode_parse(
+      iree_make_cstring_view(FLAG_sync_executable_load_mode),
+      &default_params.executable_load_mode));
 
   iree_hal_executable_plugin_manager_t* plugin_manager = NULL;
   iree_status_t status = iree_hal_executable_plugin_manager_create_from_flags(
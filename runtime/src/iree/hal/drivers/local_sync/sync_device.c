@@ -12,6 +12,7 @@
 
 #include "iree/base/internal/arena.h"
 #include "iree/base/internal/cpu.h"
+#include "iree/hal/drivers/local_sync/sync_dispatch_list.h"
 #include "iree/hal/drivers/local_sync/sync_event.h"
 #include "iree/hal/drivers/local_sync/sync_semaphore.h"
 #include "iree/hal/local/executable_environment.h"
@@ -35,6 +36,13 @@ typedef struct iree_hal_sync_device_t {
   // buffers can contain inlined data uploads).
   iree_arena_block_pool_t large_block_pool;
 
+  // True if command buffers should be recorded as dispatch lists when
+  // possible.
+  bool dispatch_lists;
+
+  // Controls when executables prepared by executable caches are loaded.
+  iree_hal_local_executable_load_mode_t executable_load_mode;
+
   // Shared semaphore state used to emulate OS-level primitives. This backend
   // is intended to run on bare-metal systems where we need to perform all
   // synchronization ourselves.
@@ -99,6 +107,8 @@ iree_status_t iree_hal_sync_device_create(
     iree_hal_allocator_retain(device_allocator);
     iree_arena_block_pool_initialize(params->arena_block_size, host_allocator,
                                      &device->large_block_pool);
+    device->dispatch_lists = params->dispatch_lists;
+    device->executable_load_mode = params->executable_load_mode;
 
     device->loader_count = loader_count;
     for (iree_host_size_t i = 0; i < device->loader_count; ++i) {
@@ -231,14 +241,20 @@ static iree_status_t iree_hal_sync_device_create_command_buffer(
     iree_hal_command_category_t command_categories,
     iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
     iree_hal_command_buffer_t** out_command_buffer) {
+  iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
   if (iree_all_bits_set(mode,
                         IREE_HAL_COMMAND_BUFFER_MODE_ALLOW_INLINE_EXECUTION)) {
     return iree_hal_inline_command_buffer_create(
         iree_hal_device_allocator(base_device), mode, command_categories,
         queue_affinity, binding_capacity,
         iree_hal_device_host_allocator(base_device), out_command_buffer);
+  } else if (device->dispatch_lists && binding_capacity == 0) {
+    // Bindings are known while recording and can be resolved up front.
+    return iree_hal_sync_dispatch_list_create(
+        iree_hal_device_allocator(base_device), mode, command_categories,
+        queue_affinity, binding_capacity, &device->large_block_pool,
+        device->host_allocator, out_command_buffer);
   } else {
-    iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
     return iree_hal_deferred_command_buffer_create(
         iree_hal_device_allocator(base_device), mode, command_categories,
         queue_affinity, binding_capacity, &device->large_block_pool,
@@ -258,8 +274,11 @@ static iree_status_t iree_hal_sync_device_create_executable_cache(
     iree_hal_device_t* base_device, iree_string_view_t identifier,
     iree_loop_t loop, iree_hal_executable_cache_t** out_executable_cache) {
   iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
-  return iree_hal_local_executable_cache_create(
+  // No scheduler is provided as there are no workers to issue loads to.
+  iree_hal_local_executable_scheduler_t scheduler = {0};
+  return iree_hal_local_executable_cache_create_with_mode(
       identifier, /*worker_capacity=*/1, device->loader_count, device->loaders,
+      device->executable_load_mode, scheduler,
       iree_hal_device_host_allocator(base_device), out_executable_cache);
 }
 
@@ -426,10 +445,14 @@ static iree_status_t iree_hal_sync_device_queue_execute(
       &device->semaphore_state, IREE_HAL_WAIT_MODE_ALL, wait_semaphore_list,
       iree_infinite_timeout()));
 
-  // Run all deferred command buffers - any we could have run inline we already
-  // did during recording.
-  IREE_RETURN_IF_ERROR(iree_hal_sync_device_apply_deferred_command_buffer(
-      device, command_buffer, binding_table));
+  // Run dispatch lists and deferred command buffers - any we could have run
+  // inline we already did during recording.
+  if (command_buffer && iree_hal_sync_dispatch_list_isa(command_buffer)) {
+    IREE_RETURN_IF_ERROR(iree_hal_sync_dispatch_list_execute(command_buffer));
+  } else {
+    IREE_RETURN_IF_ERROR(iree_hal_sync_device_apply_deferred_command_buffer(
+        device, command_buffer, binding_table));
+  }
 
   // Signal all semaphores now that batch work has completed.
   IREE_RETURN_IF_ERROR(iree_hal_sync_semaphore_multi_signal(
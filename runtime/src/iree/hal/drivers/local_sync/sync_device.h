@@ -10,6 +10,7 @@
 #include "iree/base/api.h"
 #include "iree/hal/api.h"
 #include "iree/hal/local/executable_loader.h"
+#include "iree/hal/local/local_executable_cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +23,17 @@ typedef struct iree_hal_sync_device_params_t {
   // Larger sizes will lower overhead and ensure the heap isn't hit for
   // transient allocations while also increasing memory consumption.
   iree_host_size_t arena_block_size;
+  // Records command buffers that are not executed inline and do not use
+  // binding tables into precompiled dispatch lists. Executables and bindings
+  // are resolved once when recording instead of each time the command buffer
+  // is submitted, reducing per-dispatch overhead for programs with many small
+  // dispatches. Errors that would otherwise be reported on submission (such
+  // as unmappable bindings) are reported while recording.
+  bool dispatch_lists;
+  // Controls when executables are loaded. There are no workers to load on so
+  // async loading behaves as lazy loading: each executable is loaded by the
+  // first command buffer that records a dispatch with it.
+  iree_hal_local_executable_load_mode_t executable_load_mode;
 } iree_hal_sync_device_params_t;
 
 // Initializes |out_params| to default values.
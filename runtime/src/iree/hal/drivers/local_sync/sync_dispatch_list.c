@@ -0,0 +1,675 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/drivers/local_sync/sync_dispatch_list.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "iree/base/internal/cpu.h"
+#include "iree/base/internal/fpu_state.h"
+#include "iree/hal/local/executable_library.h"
+#include "iree/hal/local/local_executable.h"
+#include "iree/hal/utils/resource_set.h"
+
+//===----------------------------------------------------------------------===//
+// Records
+//===----------------------------------------------------------------------===//
+
+// State shared by all records during a single execution of a list.
+typedef struct iree_hal_sync_dispatch_list_state_t {
+  // ID of the processor the list is executing on, queried once per execution.
+  iree_cpu_processor_id_t processor_id;
+  // Workgroup local memory large enough for any dispatch in the list.
+  iree_byte_span_t local_memory;
+} iree_hal_sync_dispatch_list_state_t;
+
+// Executes the command pointed to by a record.
+typedef iree_status_t (*iree_hal_sync_dispatch_list_fn_t)(
+    const void* command, const iree_hal_sync_dispatch_list_state_t* state);
+
+// A single entry in the flattened list executed in order.
+// Records are stored densely and the command data they reference is allocated
+// from the list arena in recording order.
+typedef struct iree_hal_sync_dispatch_list_record_t {
+  iree_hal_sync_dispatch_list_fn_t fn;
+  const void* command;
+} iree_hal_sync_dispatch_list_record_t;
+
+// A persistent mapping made during recording that must be unmapped when the
+// list is destroyed.
+typedef struct iree_hal_sync_dispatch_list_mapping_t {
+  struct iree_hal_sync_dispatch_list_mapping_t* next;
+  iree_hal_buffer_mapping_t mapping;
+} iree_hal_sync_dispatch_list_mapping_t;
+
+//===----------------------------------------------------------------------===//
+// iree_hal_sync_dispatch_list_t
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_hal_sync_dispatch_list_t {
+  iree_hal_command_buffer_t base;
+  iree_allocator_t host_allocator;
+
+  // Maintains a reference to all resources used within the command buffer.
+  iree_hal_resource_set_t* resource_set;
+
+  // Arena holding command data, binding pointers, and constants referenced by
+  // records.
+  iree_arena_allocator_t arena;
+
+  // Linked list of all persistent buffer mappings.
+  iree_hal_sync_dispatch_list_mapping_t* mapping_head;
+
+  // Dense list of records in execution order allocated from host_allocator.
+  iree_host_size_t record_count;
+  iree_host_size_t record_capacity;
+  iree_hal_sync_dispatch_list_record_t* records;
+
+  // Largest workgroup local memory size of any dispatch in the list.
+  iree_host_size_t max_local_memory_size;
+} iree_hal_sync_dispatch_list_t;
+
+static const iree_hal_command_buffer_vtable_t
+    iree_hal_sync_dispatch_list_vtable;
+
+static iree_hal_sync_dispatch_list_t* iree_hal_sync_dispatch_list_cast(
+    iree_hal_command_buffer_t* base_value) {
+  IREE_HAL_ASSERT_TYPE(base_value, &iree_hal_sync_dispatch_list_vtable);
+  return (iree_hal_sync_dispatch_list_t*)base_value;
+}
+
+iree_status_t iree_hal_sync_dispatch_list_create(
+    iree_hal_allocator_t* device_allocator, iree_hal_command_buffer_mode_t mode,
+    iree_hal_command_category_t command_categories,
+    iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
+    iree_arena_block_pool_t* block_pool, iree_allocator_t host_allocator,
+    iree_hal_command_buffer_t** out_command_buffer) {
+  IREE_ASSERT_ARGUMENT(block_pool);
+  IREE_ASSERT_ARGUMENT(out_command_buffer);
+  *out_command_buffer = NULL;
+  if (binding_capacity > 0) {
+    // Bindings are resolved as commands are recorded.
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "dispatch list command buffers do not support binding tables");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_sync_dispatch_list_t* command_buffer = NULL;
+  iree_status_t status = iree_allocator_malloc(
+      host_allocator,
+      sizeof(*command_buffer) +
+          iree_hal_command_buffer_validation_state_size(mode, binding_capacity),
+      (void**)&command_buffer);
+  if (iree_status_is_ok(status)) {
+    memset(command_buffer, 0, sizeof(*command_buffer));
+    iree_hal_command_buffer_initialize(
+        device_allocator, mode, command_categories, queue_affinity,
+        binding_capacity, (uint8_t*)command_buffer + sizeof(*command_buffer),
+        &iree_hal_sync_dispatch_list_vtable, &command_buffer->base);
+    command_buffer->host_allocator = host_allocator;
+    iree_arena_initialize(block_pool, &command_buffer->arena);
+
+    status = iree_hal_resource_set_allocate(block_pool,
+                                            &command_buffer->resource_set);
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_command_buffer = &command_buffer->base;
+  } else if (command_buffer) {
+    iree_hal_command_buffer_destroy(&command_buffer->base);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static void iree_hal_sync_dispatch_list_destroy(
+    iree_hal_command_buffer_t* base_command_buffer) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  iree_allocator_t host_allocator = command_buffer->host_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Unmap before releasing the buffers the mappings reference.
+  for (iree_hal_sync_dispatch_list_mapping_t* mapping =
+           command_buffer->mapping_head;
+       mapping != NULL; mapping = mapping->next) {
+    iree_status_ignore(iree_hal_buffer_unmap_range(&mapping->mapping));
+  }
+  iree_hal_resource_set_free(command_buffer->resource_set);
+  iree_arena_deinitialize(&command_buffer->arena);
+  iree_allocator_free(host_allocator, command_buffer->records);
+  iree_allocator_free(host_allocator, command_buffer);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+bool iree_hal_sync_dispatch_list_isa(
+    iree_hal_command_buffer_t* command_buffer) {
+  return iree_hal_resource_is(&command_buffer->resource,
+                              &iree_hal_sync_dispatch_list_vtable);
+}
+
+// Appends a record calling |fn| with |command| to the list.
+static iree_status_t iree_hal_sync_dispatch_list_append(
+    iree_hal_sync_dispatch_list_t* command_buffer,
+    iree_hal_sync_dispatch_list_fn_t fn, const void* command) {
+  if (command_buffer->record_count == command_buffer->record_capacity) {
+    iree_host_size_t new_capacity =
+        iree_max(16, command_buffer->record_capacity * 2);
+    IREE_RETURN_IF_ERROR(iree_allocator_realloc(
+        command_buffer->host_allocator,
+        new_capacity * sizeof(command_buffer->records[0]),
+        (void**)&command_buffer->records));
+    command_buffer->record_capacity = new_capacity;
+  }
+  iree_hal_sync_dispatch_list_record_t* record =
+      &command_buffer->records[command_buffer->record_count++];
+  record->fn = fn;
+  record->command = command;
+  return iree_ok_status();
+}
+
+// Persistently maps |buffer_ref| for the lifetime of the list and returns the
+// mapped contents. The buffer is retained by the list.
+static iree_status_t iree_hal_sync_dispatch_list_map(
+    iree_hal_sync_dispatch_list_t* command_buffer,
+    iree_hal_buffer_ref_t buffer_ref, iree_hal_memory_access_t memory_access,
+    iree_byte_span_t* out_contents) {
+  IREE_RETURN_IF_ERROR(iree_hal_resource_set_insert(
+      command_buffer->resource_set, 1, &buffer_ref.buffer));
+  iree_hal_sync_dispatch_list_mapping_t* mapping = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(
+      &command_buffer->arena, sizeof(*mapping), (void**)&mapping));
+  memset(mapping, 0, sizeof(*mapping));
+  IREE_RETURN_IF_ERROR(iree_hal_buffer_map_range(
+      buffer_ref.buffer, IREE_HAL_MAPPING_MODE_PERSISTENT, memory_access,
+      buffer_ref.offset, buffer_ref.length, &mapping->mapping));
+  mapping->next = command_buffer->mapping_head;
+  command_buffer->mapping_head = mapping;
+  *out_contents = mapping->mapping.contents;
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_begin(
+    iree_hal_command_buffer_t* base_command_buffer) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  if (command_buffer->record_count > 0) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "command buffer cannot be re-recorded");
+  }
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_end(
+    iree_hal_command_buffer_t* base_command_buffer) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  iree_hal_resource_set_freeze(command_buffer->resource_set);
+  return iree_ok_status();
+}
+
+iree_status_t iree_hal_sync_dispatch_list_execute(
+    iree_hal_command_buffer_t* base_command_buffer) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, command_buffer->record_count);
+
+  // The processor is queried once for the whole list instead of per dispatch
+  // as the list is expected to execute quickly.
+  iree_hal_sync_dispatch_list_state_t state;
+  iree_cpu_processor_tag_t processor_tag = 0;
+  iree_cpu_requery_processor_id(&processor_tag, &state.processor_id);
+
+  // A single allocation is shared by all dispatches requiring local memory.
+  state.local_memory =
+      iree_make_byte_span(NULL, command_buffer->max_local_memory_size);
+  if (state.local_memory.data_length > 0) {
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, iree_allocator_malloc(command_buffer->host_allocator,
+                                  state.local_memory.data_length,
+                                  (void**)&state.local_memory.data));
+  }
+
+  // Since we are running on a borrowed thread, we know nothing about the
+  // floating point state. Reset it.
+  iree_fpu_state_t fpu_state =
+      iree_fpu_state_push(IREE_FPU_STATE_FLAG_FLUSH_DENORMALS_TO_ZERO);
+  iree_status_t status = iree_ok_status();
+  const iree_hal_sync_dispatch_list_record_t* records = command_buffer->records;
+  for (iree_host_size_t i = 0; i < command_buffer->record_count; ++i) {
+    status = records[i].fn(records[i].command, &state);
+    if (IREE_UNLIKELY(!iree_status_is_ok(status))) break;
+  }
+  iree_fpu_state_pop(fpu_state);
+
+  iree_allocator_free(command_buffer->host_allocator, state.local_memory.data);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_command_buffer_t debug utilities
+//===----------------------------------------------------------------------===//
+
+static iree_status_t iree_hal_sync_dispatch_list_begin_debug_group(
+    iree_hal_command_buffer_t* base_command_buffer, iree_string_view_t label,
+    iree_hal_label_color_t label_color,
+    const iree_hal_label_location_t* location) {
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_end_debug_group(
+    iree_hal_command_buffer_t* base_command_buffer) {
+  return iree_ok_status();
+}
+
+//===----------------------------------------------------------------------===//
+// Synchronization
+//===----------------------------------------------------------------------===//
+
+static iree_status_t iree_hal_sync_dispatch_list_execution_barrier(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_execution_stage_t source_stage_mask,
+    iree_hal_execution_stage_t target_stage_mask,
+    iree_hal_execution_barrier_flags_t flags,
+    iree_host_size_t memory_barrier_count,
+    const iree_hal_memory_barrier_t* memory_barriers,
+    iree_host_size_t buffer_barrier_count,
+    const iree_hal_buffer_barrier_t* buffer_barriers) {
+  // No-op; records execute in order.
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_signal_event(
+    iree_hal_command_buffer_t* base_command_buffer, iree_hal_event_t* event,
+    iree_hal_execution_stage_t source_stage_mask) {
+  // No-op; records execute in order.
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_reset_event(
+    iree_hal_command_buffer_t* base_command_buffer, iree_hal_event_t* event,
+    iree_hal_execution_stage_t source_stage_mask) {
+  // No-op; records execute in order.
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_wait_events(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_host_size_t event_count, const iree_hal_event_t** events,
+    iree_hal_execution_stage_t source_stage_mask,
+    iree_hal_execution_stage_t target_stage_mask,
+    iree_host_size_t memory_barrier_count,
+    const iree_hal_memory_barrier_t* memory_barriers,
+    iree_host_size_t buffer_barrier_count,
+    const iree_hal_buffer_barrier_t* buffer_barriers) {
+  // No-op; records execute in order.
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_advise_buffer(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_buffer_ref_t buffer_ref, iree_hal_memory_advise_flags_t flags,
+    uint64_t arg0, uint64_t arg1) {
+  return iree_ok_status();
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_command_buffer_fill_buffer
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_hal_sync_dispatch_list_fill_t {
+  iree_hal_buffer_t* target_buffer;
+  iree_device_size_t target_offset;
+  iree_device_size_t length;
+  uint64_t pattern;
+  iree_host_size_t pattern_length;
+} iree_hal_sync_dispatch_list_fill_t;
+
+static iree_status_t iree_hal_sync_dispatch_list_execute_fill(
+    const void* command, const iree_hal_sync_dispatch_list_state_t* state) {
+  const iree_hal_sync_dispatch_list_fill_t* cmd =
+      (const iree_hal_sync_dispatch_list_fill_t*)command;
+  return iree_hal_buffer_map_fill(cmd->target_buffer, cmd->target_offset,
+                                  cmd->length, &cmd->pattern,
+                                  cmd->pattern_length);
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_fill_buffer(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_buffer_ref_t target_ref, const void* pattern,
+    iree_host_size_t pattern_length, iree_hal_fill_flags_t flags) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  if (IREE_UNLIKELY(pattern_length > sizeof(uint64_t))) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "fill patterns must be at most 8 bytes");
+  }
+  IREE_RETURN_IF_ERROR(iree_hal_resource_set_insert(
+      command_buffer->resource_set, 1, &target_ref.buffer));
+  iree_hal_sync_dispatch_list_fill_t* cmd = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
+                                           sizeof(*cmd), (void**)&cmd));
+  cmd->target_buffer = target_ref.buffer;
+  cmd->target_offset = target_ref.offset;
+  cmd->length = target_ref.length;
+  cmd->pattern = 0;
+  memcpy(&cmd->pattern, pattern, pattern_length);
+  cmd->pattern_length = pattern_length;
+  return iree_hal_sync_dispatch_list_append(
+      command_buffer, iree_hal_sync_dispatch_list_execute_fill, cmd);
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_command_buffer_update_buffer
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_hal_sync_dispatch_list_update_t {
+  iree_hal_buffer_t* target_buffer;
+  iree_device_size_t target_offset;
+  iree_device_size_t length;
+  const void* source_data;
+} iree_hal_sync_dispatch_list_update_t;
+
+static iree_status_t iree_hal_sync_dispatch_list_execute_update(
+    const void* command, const iree_hal_sync_dispatch_list_state_t* state) {
+  const iree_hal_sync_dispatch_list_update_t* cmd =
+      (const iree_hal_sync_dispatch_list_update_t*)command;
+  return iree_hal_buffer_map_write(cmd->target_buffer, cmd->target_offset,
+                                   cmd->source_data, cmd->length);
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_update_buffer(
+    iree_hal_command_buffer_t* base_command_buffer, const void* source_buffer,
+    iree_host_size_t source_offset, iree_hal_buffer_ref_t target_ref,
+    iree_hal_update_flags_t flags) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  IREE_RETURN_IF_ERROR(iree_hal_resource_set_insert(
+      command_buffer->resource_set, 1, &target_ref.buffer));
+  iree_hal_sync_dispatch_list_update_t* cmd = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
+                                           sizeof(*cmd), (void**)&cmd));
+  void* source_data = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(
+      &command_buffer->arena, (iree_host_size_t)target_ref.length,
+      &source_data));
+  memcpy(source_data, (const uint8_t*)source_buffer + source_offset,
+         (iree_host_size_t)target_ref.length);
+  cmd->target_buffer = target_ref.buffer;
+  cmd->target_offset = target_ref.offset;
+  cmd->length = target_ref.length;
+  cmd->source_data = source_data;
+  return iree_hal_sync_dispatch_list_append(
+      command_buffer, iree_hal_sync_dispatch_list_execute_update, cmd);
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_command_buffer_copy_buffer
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_hal_sync_dispatch_list_copy_t {
+  iree_hal_buffer_t* source_buffer;
+  iree_device_size_t source_offset;
+  iree_hal_buffer_t* target_buffer;
+  iree_device_size_t target_offset;
+  iree_device_size_t length;
+} iree_hal_sync_dispatch_list_copy_t;
+
+static iree_status_t iree_hal_sync_dispatch_list_execute_copy(
+    const void* command, const iree_hal_sync_dispatch_list_state_t* state) {
+  const iree_hal_sync_dispatch_list_copy_t* cmd =
+      (const iree_hal_sync_dispatch_list_copy_t*)command;
+  return iree_hal_buffer_map_copy(cmd->source_buffer, cmd->source_offset,
+                                  cmd->target_buffer, cmd->target_offset,
+                                  cmd->length);
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_copy_buffer(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_buffer_ref_t source_ref, iree_hal_buffer_ref_t target_ref,
+    iree_hal_copy_flags_t flags) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  const iree_hal_buffer_t* buffers[2] = {source_ref.buffer, target_ref.buffer};
+  IREE_RETURN_IF_ERROR(iree_hal_resource_set_insert(
+      command_buffer->resource_set, IREE_ARRAYSIZE(buffers), buffers));
+  iree_hal_sync_dispatch_list_copy_t* cmd = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
+                                           sizeof(*cmd), (void**)&cmd));
+  cmd->source_buffer = source_ref.buffer;
+  cmd->source_offset = source_ref.offset;
+  cmd->target_buffer = target_ref.buffer;
+  cmd->target_offset = target_ref.offset;
+  cmd->length = target_ref.length;
+  return iree_hal_sync_dispatch_list_append(
+      command_buffer, iree_hal_sync_dispatch_list_execute_copy, cmd);
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_command_buffer_collective
+//===----------------------------------------------------------------------===//
+
+static iree_status_t iree_hal_sync_dispatch_list_collective(
+    iree_hal_command_buffer_t* base_command_buffer, iree_hal_channel_t* channel,
+    iree_hal_collective_op_t op, uint32_t param, iree_hal_buffer_ref_t send_ref,
+    iree_hal_buffer_ref_t recv_ref, iree_device_size_t element_count) {
+  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                          "collectives not yet implemented on CPU");
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_command_buffer_dispatch
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_hal_sync_dispatch_list_dispatch_t {
+  // Resolved executable; the original executable is retained by the list.
+  iree_hal_local_executable_t* executable;
+  iree_host_size_t ordinal;
+  // Workgroup local memory required by the dispatch.
+  iree_host_size_t local_memory_size;
+  // Persistently mapped workgroup count of an indirect dispatch or NULL if the
+  // count in |dispatch_state| is used.
+  const uint32_t* indirect_workgroup_count;
+  // Fully populated dispatch state referencing constants and bindings stored
+  // in the list arena.
+  iree_hal_executable_dispatch_state_v0_t dispatch_state;
+} iree_hal_sync_dispatch_list_dispatch_t;
+
+static iree_status_t iree_hal_sync_dispatch_list_execute_dispatch(
+    const void* command, const iree_hal_sync_dispatch_list_state_t* state) {
+  const iree_hal_sync_dispatch_list_dispatch_t* cmd =
+      (const iree_hal_sync_dispatch_list_dispatch_t*)command;
+  const iree_hal_executable_dispatch_state_v0_t* dispatch_state =
+      &cmd->dispatch_state;
+
+  // Indirect workgroup counts may change between executions and lists may be
+  // executed concurrently so the shared dispatch state cannot be updated.
+  iree_hal_executable_dispatch_state_v0_t indirect_dispatch_state;
+  if (cmd->indirect_workgroup_count) {
+    indirect_dispatch_state = cmd->dispatch_state;
+    indirect_dispatch_state.workgroup_count_x =
+        cmd->indirect_workgroup_count[0];
+    indirect_dispatch_state.workgroup_count_y =
+        cmd->indirect_workgroup_count[1];
+    indirect_dispatch_state.workgroup_count_z =
+        cmd->indirect_workgroup_count[2];
+    dispatch_state = &indirect_dispatch_state;
+  }
+
+  return iree_hal_local_executable_issue_dispatch_inline(
+      cmd->executable, cmd->ordinal, dispatch_state, state->processor_id,
+      iree_make_byte_span(state->local_memory.data, cmd->local_memory_size));
+}
+
+// Records a dispatch with either a direct |workgroup_count| or an indirect
+// |indirect_workgroup_count| read at execution time.
+static iree_status_t iree_hal_sync_dispatch_list_record_dispatch(
+    iree_hal_sync_dispatch_list_t* command_buffer,
+    iree_hal_executable_t* executable, int32_t entry_point,
+    const uint32_t workgroup_count[3],
+    const uint32_t* indirect_workgroup_count, iree_const_byte_span_t constants,
+    iree_hal_buffer_ref_list_t bindings) {
+  IREE_RETURN_IF_ERROR(iree_hal_resource_set_insert(
+      command_buffer->resource_set, 1, &executable));
+  iree_hal_local_executable_t* local_executable = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_local_executable_resolve(executable, &local_executable));
+
+  iree_hal_executable_dispatch_attrs_v0_t dispatch_attrs = {0};
+  if (local_executable->dispatch_attrs) {
+    dispatch_attrs = local_executable->dispatch_attrs[entry_point];
+  }
+
+  // Push constants are validated and copied now so that execution needs no
+  // checks. Note that we require 4 byte alignment.
+  if (IREE_UNLIKELY((constants.data_length % sizeof(uint32_t)) != 0)) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "constants must be 4-byte aligned");
+  } else if (IREE_UNLIKELY(constants.data_length !=
+                           dispatch_attrs.constant_count * sizeof(uint32_t))) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "constant count mismatch, expected %u but was provided %" PRIhsz,
+        (uint32_t)dispatch_attrs.constant_count,
+        constants.data_length / sizeof(uint32_t));
+  }
+  if (IREE_UNLIKELY(bindings.count != dispatch_attrs.binding_count)) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "binding count mismatch, expected %u but was provided %" PRIhsz,
+        (uint32_t)dispatch_attrs.binding_count, bindings.count);
+  }
+
+  iree_hal_sync_dispatch_list_dispatch_t* cmd = NULL;
+  IREE_RETURN_IF_ERROR(iree_arena_allocate(&command_buffer->arena,
+                                           sizeof(*cmd), (void**)&cmd));
+  memset(cmd, 0, sizeof(*cmd));
+  cmd->executable = local_executable;
+  cmd->ordinal = entry_point;
+  cmd->local_memory_size =
+      dispatch_attrs.local_memory_pages *
+      IREE_HAL_EXECUTABLE_WORKGROUP_LOCAL_MEMORY_PAGE_SIZE;
+  cmd->indirect_workgroup_count = indirect_workgroup_count;
+
+  iree_hal_executable_dispatch_state_v0_t* dispatch_state =
+      &cmd->dispatch_state;
+  dispatch_state->workgroup_size_x = 1;
+  dispatch_state->workgroup_size_y = 1;
+  dispatch_state->workgroup_size_z = 1;
+  if (workgroup_count) {
+    dispatch_state->workgroup_count_x = workgroup_count[0];
+    dispatch_state->workgroup_count_y = workgroup_count[1];
+    dispatch_state->workgroup_count_z = workgroup_count[2];
+  }
+  dispatch_state->max_concurrency = 1;
+
+  dispatch_state->constant_count = dispatch_attrs.constant_count;
+  if (constants.data_length > 0) {
+    void* constants_copy = NULL;
+    IREE_RETURN_IF_ERROR(iree_arena_allocate(
+        &command_buffer->arena, constants.data_length, &constants_copy));
+    memcpy(constants_copy, constants.data, constants.data_length);
+    dispatch_state->constants = (const uint32_t*)constants_copy;
+  }
+
+  // Produce the dense binding list from persistent mappings. Binding tables
+  // are not supported so all bindings must reference a buffer directly.
+  dispatch_state->binding_count = bindings.count;
+  if (bindings.count > 0) {
+    void** binding_ptrs = NULL;
+    IREE_RETURN_IF_ERROR(iree_arena_allocate(
+        &command_buffer->arena, bindings.count * sizeof(binding_ptrs[0]),
+        (void**)&binding_ptrs));
+    size_t* binding_lengths = NULL;
+    IREE_RETURN_IF_ERROR(iree_arena_allocate(
+        &command_buffer->arena, bindings.count * sizeof(binding_lengths[0]),
+        (void**)&binding_lengths));
+    for (iree_host_size_t i = 0; i < bindings.count; ++i) {
+      if (IREE_UNLIKELY(!bindings.values[i].buffer)) {
+        return iree_make_status(
+            IREE_STATUS_FAILED_PRECONDITION,
+            "required binding %" PRIhsz
+            " is NULL; all bindings must have a valid pointer",
+            i);
+      }
+      iree_byte_span_t contents = iree_byte_span_empty();
+      IREE_RETURN_IF_ERROR(iree_hal_sync_dispatch_list_map(
+          command_buffer, bindings.values[i], IREE_HAL_MEMORY_ACCESS_ANY,
+          &contents));
+      binding_ptrs[i] = contents.data;
+      binding_lengths[i] = contents.data_length;
+    }
+    dispatch_state->binding_ptrs = binding_ptrs;
+    dispatch_state->binding_lengths = binding_lengths;
+  }
+
+  command_buffer->max_local_memory_size = iree_max(
+      command_buffer->max_local_memory_size, cmd->local_memory_size);
+  return iree_hal_sync_dispatch_list_append(
+      command_buffer, iree_hal_sync_dispatch_list_execute_dispatch, cmd);
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_dispatch(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_executable_t* executable, int32_t entry_point,
+    const uint32_t workgroup_count[3], iree_const_byte_span_t constants,
+    iree_hal_buffer_ref_list_t bindings, iree_hal_dispatch_flags_t flags) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  return iree_hal_sync_dispatch_list_record_dispatch(
+      command_buffer, executable, entry_point, workgroup_count,
+      /*indirect_workgroup_count=*/NULL, constants, bindings);
+}
+
+static iree_status_t iree_hal_sync_dispatch_list_dispatch_indirect(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_executable_t* executable, int32_t entry_point,
+    iree_hal_buffer_ref_t workgroups_ref, iree_const_byte_span_t constants,
+    iree_hal_buffer_ref_list_t bindings, iree_hal_dispatch_flags_t flags) {
+  iree_hal_sync_dispatch_list_t* command_buffer =
+      iree_hal_sync_dispatch_list_cast(base_command_buffer);
+  if (IREE_UNLIKELY(!workgroups_ref.buffer)) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "indirect workgroup count buffer is NULL");
+  }
+  workgroups_ref.length = 3 * sizeof(uint32_t);
+  iree_byte_span_t contents = iree_byte_span_empty();
+  IREE_RETURN_IF_ERROR(iree_hal_sync_dispatch_list_map(
+      command_buffer, workgroups_ref, IREE_HAL_MEMORY_ACCESS_READ, &contents));
+  return iree_hal_sync_dispatch_list_record_dispatch(
+      command_buffer, executable, entry_point, /*workgroup_count=*/NULL,
+      (const uint32_t*)contents.data, constants, bindings);
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_command_buffer_vtable_t
+//===----------------------------------------------------------------------===//
+
+static const iree_hal_command_buffer_vtable_t
+    iree_hal_sync_dispatch_list_vtable = {
+        .destroy = iree_hal_sync_dispatch_list_destroy,
+        .begin = iree_hal_sync_dispatch_list_begin,
+        .end = iree_hal_sync_dispatch_list_end,
+        .begin_debug_group = iree_hal_sync_dispatch_list_begin_debug_group,
+        .end_debug_group = iree_hal_sync_dispatch_list_end_debug_group,
+        .execution_barrier = iree_hal_sync_dispatch_list_execution_barrier,
+        .signal_event = iree_hal_sync_dispatch_list_signal_event,
+        .reset_event = iree_hal_sync_dispatch_list_reset_event,
+        .wait_events = iree_hal_sync_dispatch_list_wait_events,
+        .advise_buffer = iree_hal_sync_dispatch_list_advise_buffer,
+        .fill_buffer = iree_hal_sync_dispatch_list_fill_buffer,
+        .update_buffer = iree_hal_sync_dispatch_list_update_buffer,
+        .copy_buffer = iree_hal_sync_dispatch_list_copy_buffer,
+        .collective = iree_hal_sync_dispatch_list_collective,
+        .dispatch = iree_hal_sync_dispatch_list_dispatch,
+        .dispatch_indirect = iree_hal_sync_dispatch_list_dispatch_indirect,
+};
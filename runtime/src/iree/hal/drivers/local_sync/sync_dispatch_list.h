@@ -0,0 +1,48 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_DRIVERS_LOCAL_SYNC_SYNC_DISPATCH_LIST_H_
+#define IREE_HAL_DRIVERS_LOCAL_SYNC_SYNC_DISPATCH_LIST_H_
+
+#include "iree/base/api.h"
+#include "iree/base/internal/arena.h"
+#include "iree/hal/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Creates a command buffer that is precompiled into a flat list of records
+// during recording. Executables are resolved, bindings are mapped, and the
+// dispatch state passed to each executable is fully populated when commands
+// are recorded such that execution is a tight loop calling the function of
+// each record with no per-dispatch validation or allocation.
+//
+// Bindings are resolved at record time and binding tables are not supported;
+// |binding_capacity| must be 0. Workgroup counts of indirect dispatches are
+// read from their persistently mapped buffer each time the list is executed.
+//
+// Arena storage for recorded commands is acquired from |block_pool|.
+iree_status_t iree_hal_sync_dispatch_list_create(
+    iree_hal_allocator_t* device_allocator, iree_hal_command_buffer_mode_t mode,
+    iree_hal_command_category_t command_categories,
+    iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
+    iree_arena_block_pool_t* block_pool, iree_allocator_t host_allocator,
+    iree_hal_command_buffer_t** out_command_buffer);
+
+// Returns true if |command_buffer| is a sync dispatch list.
+bool iree_hal_sync_dispatch_list_isa(iree_hal_command_buffer_t* command_buffer);
+
+// Executes all commands recorded in the |command_buffer| dispatch list on the
+// calling thread. The command buffer must have ended recording.
+iree_status_t iree_hal_sync_dispatch_list_execute(
+    iree_hal_command_buffer_t* command_buffer);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_DRIVERS_LOCAL_SYNC_SYNC_DISPATCH_LIST_H_
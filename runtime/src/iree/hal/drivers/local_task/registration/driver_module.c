@@ -20,6 +20,56 @@ IREE_FLAG(
     bool, task_abort_on_failure, false,
     "Aborts the program on the first failure within a task system queue.");
 
+IREE_FLAG(
+    string, task_executable_load_mode, "immediate",
+    "Controls when executables are loaded:\n"
+    "  `immediate`: loaded on the calling thread when prepared.\n"
+    "  `async`: loaded concurrently by task system workers when prepared.\n"
+    "  `lazy`: loaded when first used by a dispatch.");
+
+IREE_FLAG(
+    string, task_queue_priorities, "",
+    "Comma-separated scheduling priorities of each device queue:\n"
+    "  `low`, `normal`, or `high`.\n"
+    "When specified one queue is created per entry with the queues assigned\n"
+    "to executors round-robin. Programs select a queue (and its priority)\n"
+    "with the queue affinity of their work.");
+
+// Parses a comma-separated list of queue priorities into |params| and returns
+// the number of queues specified in |out_queue_count|.
+static iree_status_t iree_hal_local_task_parse_queue_priorities(
+    iree_string_view_t value, iree_hal_task_device_params_t* params,
+    iree_host_size_t* out_queue_count) {
+  iree_host_size_t queue_count = 0;
+  while (!iree_string_view_is_empty(value)) {
+    iree_string_view_t entry = iree_string_view_empty();
+    iree_string_view_split(value, ',', &entry, &value);
+    entry = iree_string_view_trim(entry);
+    if (queue_count >= IREE_ARRAYSIZE(params->queue_priorities)) {
+      return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                              "too many queue priorities; at most %d queues "
+                              "are supported",
+                              (int)IREE_ARRAYSIZE(params->queue_priorities));
+    }
+    iree_task_priority_t priority = IREE_TASK_PRIORITY_NORMAL;
+    if (iree_string_view_equal(entry, IREE_SV("low"))) {
+      priority = IREE_TASK_PRIORITY_LOW;
+    } else if (iree_string_view_equal(entry, IREE_SV("normal"))) {
+      priority = IREE_TASK_PRIORITY_NORMAL;
+    } else if (iree_string_view_equal(entry, IREE_SV("high"))) {
+      priority = IREE_TASK_PRIORITY_HIGH;
+    } else {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "unsupported queue priority '%.*s'; expected "
+                              "`low`, `normal`, or `high`",
+                              (int)entry.size, entry.data);
+    }
+    params->queue_priorities[queue_count++] = priority;
+  }
+  *out_queue_count = queue_count;
+  return iree_ok_status();
+}
+
 static iree_status_t iree_hal_local_task_driver_factory_enumerate(
     void* self, iree_host_size_t* out_driver_info_count,
     const iree_hal_driver_info_t** out_driver_infos) {
@@ -49,6 +99,13 @@ static iree_status_t iree_hal_local_task_driver_factory_try_create(
   if (FLAG_task_abort_on_failure) {
     default_params.queue_scope_flags |= IREE_TASK_SCOPE_FLAG_ABORT_ON_FAILURE;
   }
+  IREE_RETURN_IF_ERROR(iree_hal_local_executable_load_mode_parse(
+      iree_make_cstring_view(FLAG_task_executable_load_mode),
+      &default_params.executable_load_mode));
+  iree_host_size_t prioritized_queue_count = 0;
+  IREE_RETURN_IF_ERROR(iree_hal_local_task_parse_queue_priorities(
+      iree_make_cstring_view(FLAG_task_queue_priorities), &default_params,
+      &prioritized_queue_count));
 
   // Create executors for each topology specified by flags.
   // Stack allocated storage today but we can query for the total count and
@@ -60,6 +117,20 @@ static iree_status_t iree_hal_local_task_driver_factory_try_create(
       host_allocator, IREE_ARRAYSIZE(executor_storage), executors,
       &executor_count));
 
+  // Each executor gets a single queue unless queue priorities were specified
+  // in which case the queues are assigned to executors round-robin.
+  iree_task_executor_t*
+      queue_executor_storage[IREE_HAL_TASK_DEVICE_MAX_QUEUE_COUNT] = {NULL};
+  iree_task_executor_t** queue_executors = executors;
+  iree_host_size_t queue_count = executor_count;
+  if (prioritized_queue_count > 0 && executor_count > 0) {
+    for (iree_host_size_t i = 0; i < prioritized_queue_count; ++i) {
+      queue_executor_storage[i] = executors[i % executor_count];
+    }
+    queue_executors = queue_executor_storage;
+    queue_count = prioritized_queue_count;
+  }
+
   iree_hal_executable_plugin_manager_t* plugin_manager = NULL;
   iree_status_t status = iree_hal_executable_plugin_manager_create_from_flags(
       host_allocator, &plugin_manager);
@@ -85,8 +156,8 @@ static iree_status_t iree_hal_local_task_driver_factory_try_create(
   // and loaders for loading executables.
   if (iree_status_is_ok(status)) {
     status = iree_hal_task_driver_create(
-        driver_name, &default_params, executor_count, executors, loader_count,
-        loaders, device_allocator, host_allocator, out_driver);
+        driver_name, &default_params, queue_count, queue_executors,
+        loader_count, loaders, device_allocator, host_allocator, out_driver);
   }
 
   for (iree_host_size_t i = 0; i < executor_count; ++i) {
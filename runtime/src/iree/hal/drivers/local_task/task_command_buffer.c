@@ -790,8 +790,11 @@ static iree_status_t iree_hal_task_command_buffer_build_dispatch(
   iree_hal_task_command_buffer_t* command_buffer =
       iree_hal_task_command_buffer_cast(base_command_buffer);
 
-  iree_hal_local_executable_t* local_executable =
-      iree_hal_local_executable_cast(executable);
+  // Executables may be loading asynchronously or lazily; the command records
+  // the loaded executable while the resource set retains |executable|.
+  iree_hal_local_executable_t* local_executable = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_local_executable_resolve(executable, &local_executable));
   iree_hal_executable_dispatch_attrs_v0_t dispatch_attrs = {0};
   if (local_executable->dispatch_attrs) {
     dispatch_attrs = local_executable->dispatch_attrs[entry_point];
@@ -825,6 +828,21 @@ static iree_status_t iree_hal_task_command_buffer_build_dispatch(
       dispatch_attrs.local_memory_pages *
       IREE_HAL_EXECUTABLE_WORKGROUP_LOCAL_MEMORY_PAGE_SIZE;
 
+  // Distribute workgroups in the order preferred by the executable. The task
+  // system tile orders match the executable library values and unknown values
+  // fall back to the default order.
+#define IREE_HAL_TASK_ASSERT_TILE_ORDER(name)                        \
+  static_assert((int)IREE_TASK_DISPATCH_TILE_ORDER_##name ==         \
+                    (int)IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_##name, \
+                "tile order mismatch")
+  IREE_HAL_TASK_ASSERT_TILE_ORDER(ROW_MAJOR);
+  IREE_HAL_TASK_ASSERT_TILE_ORDER(COLUMN_MAJOR);
+  IREE_HAL_TASK_ASSERT_TILE_ORDER(MORTON);
+  IREE_HAL_TASK_ASSERT_TILE_ORDER(GROUPED);
+#undef IREE_HAL_TASK_ASSERT_TILE_ORDER
+  cmd->task.tile_order =
+      (iree_task_dispatch_tile_order_t)dispatch_attrs.workgroup_order;
+
   // Push constants are pulled directly from the args and copied into the
   // command buffer. Note that we require 4 byte alignment and if the input
   // buffer is not aligned we have to fail.
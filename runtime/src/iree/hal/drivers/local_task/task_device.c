@@ -21,6 +21,7 @@
 #include "iree/hal/utils/deferred_command_buffer.h"
 #include "iree/hal/utils/file_registry.h"
 #include "iree/hal/utils/file_transfer.h"
+#include "iree/task/invocation.h"
 
 typedef struct iree_hal_task_device_t {
   iree_hal_resource_t resource;
@@ -42,6 +43,13 @@ typedef struct iree_hal_task_device_t {
   // Optional provider used for creating/configuring collective channels.
   iree_hal_channel_provider_t* channel_provider;
 
+  // Controls when executables prepared by executable caches are loaded.
+  iree_hal_local_executable_load_mode_t executable_load_mode;
+  // Scope used for asynchronous executable loads issued to the executor of the
+  // first queue. Loads are not associated with any queue and must complete
+  // before the device is destroyed.
+  iree_task_scope_t executable_load_scope;
+
   iree_host_size_t queue_count;
   iree_hal_task_queue_t queues[];
 } iree_hal_task_device_t;
@@ -58,6 +66,12 @@ void iree_hal_task_device_params_initialize(
     iree_hal_task_device_params_t* out_params) {
   out_params->arena_block_size = 32 * 1024;
   out_params->queue_scope_flags = IREE_TASK_SCOPE_FLAG_NONE;
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(out_params->queue_priorities);
+       ++i) {
+    out_params->queue_priorities[i] = IREE_TASK_PRIORITY_NORMAL;
+  }
+  out_params->executable_load_mode =
+      IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_IMMEDIATE;
 }
 
 static iree_status_t iree_hal_task_device_check_params(
@@ -69,6 +83,18 @@ static iree_status_t iree_hal_task_device_check_params(
   if (queue_count == 0) {
     return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
                             "must have at least one queue");
+  } else if (queue_count > IREE_HAL_TASK_DEVICE_MAX_QUEUE_COUNT) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "queue count %" PRIhsz " exceeds the maximum of %d",
+                            queue_count,
+                            (int)IREE_HAL_TASK_DEVICE_MAX_QUEUE_COUNT);
+  }
+  for (iree_host_size_t i = 0; i < queue_count; ++i) {
+    if (params->queue_priorities[i] >= IREE_TASK_PRIORITY_COUNT) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "queue %" PRIhsz " has an invalid priority %d", i,
+                              (int)params->queue_priorities[i]);
+    }
   }
   return iree_ok_status();
 }
@@ -115,6 +141,10 @@ iree_status_t iree_hal_task_device_create(
     device->device_allocator = device_allocator;
     iree_hal_allocator_retain(device_allocator);
 
+    device->executable_load_mode = params->executable_load_mode;
+    iree_task_scope_initialize(device->identifier, IREE_TASK_SCOPE_FLAG_NONE,
+                               &device->executable_load_scope);
+
     iree_arena_block_pool_initialize(4096, host_allocator,
                                      &device->small_block_pool);
     iree_arena_block_pool_initialize(params->arena_block_size, host_allocator,
@@ -138,6 +168,8 @@ iree_status_t iree_hal_task_device_create(
           queue_executors[i], &device->small_block_pool,
           &device->large_block_pool, device->device_allocator,
           &device->queues[i]);
+      iree_task_scope_set_priority(&device->queues[i].scope,
+                                   params->queue_priorities[i]);
     }
   }
 
@@ -155,6 +187,12 @@ static void iree_hal_task_device_destroy(iree_hal_device_t* base_device) {
   iree_allocator_t host_allocator = iree_hal_device_host_allocator(base_device);
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // Wait for any asynchronous executable loads to complete before tearing down
+  // the executors they run on.
+  iree_status_ignore(iree_task_scope_wait_idle(&device->executable_load_scope,
+                                               IREE_TIME_INFINITE_FUTURE));
+  iree_task_scope_deinitialize(&device->executable_load_scope);
+
   for (iree_host_size_t i = 0; i < device->queue_count; ++i) {
     iree_hal_task_queue_deinitialize(&device->queues[i]);
   }
@@ -224,6 +262,55 @@ static iree_status_t iree_hal_task_device_trim(iree_hal_device_t* base_device) {
   return iree_ok_status();
 }
 
+#if IREE_STATISTICS_ENABLE
+// Queries the executor statistics counter named |key| summed across all of the
+// unique executors used by the device queues.
+static iree_status_t iree_hal_task_device_query_executor_statistic(
+    iree_hal_task_device_t* device, iree_string_view_t key,
+    int64_t* out_value) {
+  static const struct {
+    iree_string_view_t key;
+    iree_host_size_t offset;
+  } counters[] = {
+#define IREE_HAL_TASK_EXECUTOR_COUNTER(name) \
+  {IREE_SVL(#name), offsetof(iree_task_executor_statistics_t, name)}
+      IREE_HAL_TASK_EXECUTOR_COUNTER(task_count),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(tile_count),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(steal_count),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(failed_steal_count),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(yield_count),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(sleep_count),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(sleep_ns),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(wake_count),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(coordination_count),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(coordinator_wait_ns),
+      IREE_HAL_TASK_EXECUTOR_COUNTER(coordinator_hold_ns),
+#undef IREE_HAL_TASK_EXECUTOR_COUNTER
+  };
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(counters); ++i) {
+    if (!iree_string_view_equal(key, counters[i].key)) continue;
+    *out_value = 0;
+    for (iree_host_size_t j = 0; j < device->queue_count; ++j) {
+      // Queues may share executors and each must only be counted once.
+      iree_task_executor_t* executor = device->queues[j].executor;
+      bool is_duplicate = false;
+      for (iree_host_size_t k = 0; k < j && !is_duplicate; ++k) {
+        is_duplicate = device->queues[k].executor == executor;
+      }
+      if (is_duplicate) continue;
+      iree_task_executor_statistics_t statistics;
+      iree_task_executor_query_statistics(executor, &statistics);
+      *out_value +=
+          *(const int64_t*)((const uint8_t*)&statistics + counters[i].offset);
+    }
+    return iree_ok_status();
+  }
+  return iree_make_status(IREE_STATUS_NOT_FOUND,
+                          "unknown executor statistic '%.*s'", (int)key.size,
+                          key.data);
+}
+#endif  // IREE_STATISTICS_ENABLE
+
 static iree_status_t iree_hal_task_device_query_i64(
     iree_hal_device_t* base_device, iree_string_view_t category,
     iree_string_view_t key, int64_t* out_value) {
@@ -262,6 +349,13 @@ static iree_status_t iree_hal_task_device_query_i64(
     return iree_cpu_lookup_data_by_key(key, out_value);
   }
 
+#if IREE_STATISTICS_ENABLE
+  if (iree_string_view_equal(category, IREE_SV("task.executor"))) {
+    return iree_hal_task_device_query_executor_statistic(device, key,
+                                                         out_value);
+  }
+#endif  // IREE_STATISTICS_ENABLE
+
   return iree_make_status(
       IREE_STATUS_NOT_FOUND,
       "unknown device configuration key value '%.*s :: %.*s'",
@@ -324,6 +418,63 @@ static iree_status_t iree_hal_task_device_create_event(
                                     out_event);
 }
 
+// An asynchronous executable load issued to the task system.
+typedef struct iree_hal_task_device_executable_load_t {
+  iree_task_call_t task;
+  iree_allocator_t host_allocator;
+  iree_hal_local_executable_load_fn_t fn;
+  void* user_data;
+  // True once |fn| has been called.
+  bool has_run;
+} iree_hal_task_device_executable_load_t;
+
+static iree_status_t iree_hal_task_device_executable_load_call(
+    void* user_context, iree_task_t* task,
+    iree_task_submission_t* pending_submission) {
+  iree_hal_task_device_executable_load_t* load =
+      (iree_hal_task_device_executable_load_t*)user_context;
+  load->has_run = true;
+  load->fn(load->user_data);
+  return iree_ok_status();
+}
+
+static void iree_hal_task_device_executable_load_cleanup(
+    iree_task_t* task, iree_status_code_t status_code) {
+  iree_hal_task_device_executable_load_t* load =
+      (iree_hal_task_device_executable_load_t*)task;
+  // Loads must always run as they own a reference to the executable. If the
+  // task was discarded before issuing we load here instead.
+  if (!load->has_run) load->fn(load->user_data);
+  iree_allocator_free(load->host_allocator, load);
+}
+
+// Schedules an executable load on the executor of the first queue.
+static iree_status_t iree_hal_task_device_schedule_executable_load(
+    void* self, iree_hal_local_executable_load_fn_t fn, void* user_data) {
+  iree_hal_task_device_t* device = (iree_hal_task_device_t*)self;
+  iree_hal_task_device_executable_load_t* load = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(device->host_allocator,
+                                             sizeof(*load), (void**)&load));
+  iree_task_call_initialize(
+      &device->executable_load_scope,
+      iree_task_make_call_closure(iree_hal_task_device_executable_load_call,
+                                  load),
+      &load->task);
+  iree_task_set_cleanup_fn(&load->task.header,
+                           iree_hal_task_device_executable_load_cleanup);
+  load->host_allocator = device->host_allocator;
+  load->fn = fn;
+  load->user_data = user_data;
+  load->has_run = false;
+
+  iree_task_submission_t submission;
+  iree_task_submission_initialize(&submission);
+  iree_task_submission_enqueue(&submission, &load->task.header);
+  iree_task_executor_submit(device->queues[0].executor, &submission);
+  iree_task_executor_flush(device->queues[0].executor);
+  return iree_ok_status();
+}
+
 static iree_status_t iree_hal_task_device_create_executable_cache(
     iree_hal_device_t* base_device, iree_string_view_t identifier,
     iree_loop_t loop, iree_hal_executable_cache_t** out_executable_cache) {
@@ -337,8 +488,15 @@ static iree_status_t iree_hal_task_device_create_executable_cache(
         iree_task_executor_worker_count(device->queues[i].executor);
   }
 
-  return iree_hal_local_executable_cache_create(
+  // Loads are only scheduled while preparing executables, which requires the
+  // device to be live, and the device waits for them to complete on destroy.
+  iree_hal_local_executable_scheduler_t scheduler = {
+      .self = device,
+      .schedule = iree_hal_task_device_schedule_executable_load,
+  };
+  return iree_hal_local_executable_cache_create_with_mode(
       identifier, total_worker_count, device->loader_count, device->loaders,
+      device->executable_load_mode, scheduler,
       iree_hal_device_host_allocator(base_device), out_executable_cache);
 }
 
@@ -403,6 +561,100 @@ static iree_status_t iree_hal_task_device_queue_dealloca(
   return iree_ok_status();
 }
 
+//===----------------------------------------------------------------------===//
+// Direct file transfers
+//===----------------------------------------------------------------------===//
+
+// Bytes transferred by each executor worker call when performing a direct file
+// transfer. Large enough to amortize the per-call IO overhead while still
+// splitting multi-megabyte parameter loads across workers.
+#define IREE_HAL_TASK_FILE_TRANSFER_CHUNK_SIZE (4 * 1024 * 1024)
+
+// A transfer between a file and a host-mappable buffer split into chunks that
+// are processed in parallel by the executor workers.
+typedef struct iree_hal_task_file_transfer_t {
+  iree_hal_file_t* file;
+  uint64_t file_offset;
+  iree_hal_buffer_t* buffer;
+  iree_device_size_t buffer_offset;
+  // True if transferring from the buffer to the file.
+  bool write;
+} iree_hal_task_file_transfer_t;
+
+static iree_status_t iree_hal_task_file_transfer_chunk(void* user_data,
+                                                       iree_host_size_t begin,
+                                                       iree_host_size_t end) {
+  const iree_hal_task_file_transfer_t* transfer =
+      (const iree_hal_task_file_transfer_t*)user_data;
+  if (transfer->write) {
+    return iree_hal_file_write(transfer->file, transfer->file_offset + begin,
+                               transfer->buffer,
+                               transfer->buffer_offset + begin, end - begin);
+  }
+  return iree_hal_file_read(transfer->file, transfer->file_offset + begin,
+                            transfer->buffer, transfer->buffer_offset + begin,
+                            end - begin);
+}
+
+// Returns true if |length| bytes can be transferred between |file| and |buffer|
+// directly by the executor workers instead of streaming through staging
+// buffers one chunk at a time.
+static bool iree_hal_task_device_can_transfer_file_directly(
+    iree_hal_file_t* file, iree_hal_buffer_t* buffer,
+    iree_device_size_t length) {
+  // Files with a storage buffer are transferred with queue copies that are
+  // already split across workers by the command buffer.
+  if (iree_hal_file_storage_buffer(file)) return false;
+  if (!iree_hal_file_supports_synchronous_io(file)) return false;
+  if (!iree_all_bits_set(iree_hal_buffer_allowed_usage(buffer),
+                         IREE_HAL_BUFFER_USAGE_MAPPING_SCOPED)) {
+    return false;
+  }
+  return length <= IREE_HOST_SIZE_MAX;
+}
+
+// Transfers |length| bytes as described by |transfer| split across the
+// executor workers of the selected queue.
+//
+// NOTE: the transfer is not queue-ordered. The calling thread blocks until all
+// of |wait_semaphore_list| is reached and then until the transfer completes
+// before signaling |signal_semaphore_list|. This matches the inline streaming
+// path used for files that cannot be transferred directly. Files backed by
+// storage buffers are transferred with queue copies and do not block.
+static iree_status_t iree_hal_task_device_queue_transfer_file(
+    iree_hal_task_device_t* device, iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_task_file_transfer_t* transfer, iree_device_size_t length) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)length);
+
+  // Blocks the caller; see the note above.
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_hal_semaphore_list_wait(wait_semaphore_list,
+                                       iree_infinite_timeout()));
+
+  iree_host_size_t queue_index = iree_hal_task_device_select_queue(
+      device, IREE_HAL_COMMAND_CATEGORY_TRANSFER, queue_affinity);
+  iree_task_invocation_t invocation;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_task_executor_parallel_for(
+              device->queues[queue_index].executor, (iree_host_size_t)length,
+              IREE_HAL_TASK_FILE_TRANSFER_CHUNK_SIZE,
+              iree_hal_task_file_transfer_chunk, transfer,
+              iree_wait_primitive_immediate(), &invocation));
+  iree_status_t status =
+      iree_task_invocation_wait(&invocation, iree_infinite_timeout());
+  iree_task_invocation_deinitialize(&invocation);
+
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_semaphore_list_signal(signal_semaphore_list);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 static iree_status_t iree_hal_task_device_queue_read(
     iree_hal_device_t* base_device, iree_hal_queue_affinity_t queue_affinity,
     const iree_hal_semaphore_list_t wait_semaphore_list,
@@ -410,6 +662,21 @@ static iree_status_t iree_hal_task_device_queue_read(
     iree_hal_file_t* source_file, uint64_t source_offset,
     iree_hal_buffer_t* target_buffer, iree_device_size_t target_offset,
     iree_device_size_t length, iree_hal_read_flags_t flags) {
+  iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
+  if (iree_hal_task_device_can_transfer_file_directly(source_file,
+                                                      target_buffer, length)) {
+    iree_hal_task_file_transfer_t transfer = {
+        .file = source_file,
+        .file_offset = source_offset,
+        .buffer = target_buffer,
+        .buffer_offset = target_offset,
+        .write = false,
+    };
+    return iree_hal_task_device_queue_transfer_file(
+        device, queue_affinity, wait_semaphore_list, signal_semaphore_list,
+        &transfer, length);
+  }
+
   // TODO: expose streaming chunk count/size options.
   iree_status_t loop_status = iree_ok_status();
   iree_hal_file_transfer_options_t options = {
@@ -431,6 +698,21 @@ static iree_status_t iree_hal_task_device_queue_write(
     iree_hal_buffer_t* source_buffer, iree_device_size_t source_offset,
     iree_hal_file_t* target_file, uint64_t target_offset,
     iree_device_size_t length, iree_hal_write_flags_t flags) {
+  iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
+  if (iree_hal_task_device_can_transfer_file_directly(target_file,
+                                                      source_buffer, length)) {
+    iree_hal_task_file_transfer_t transfer = {
+        .file = target_file,
+        .file_offset = target_offset,
+        .buffer = source_buffer,
+        .buffer_offset = source_offset,
+        .write = true,
+    };
+    return iree_hal_task_device_queue_transfer_file(
+        device, queue_affinity, wait_semaphore_list, signal_semaphore_list,
+        &transfer, length);
+  }
+
   // TODO: expose streaming chunk count/size options.
   iree_status_t loop_status = iree_ok_status();
   iree_hal_file_transfer_options_t options = {
@@ -10,12 +10,18 @@
 #include "iree/base/api.h"
 #include "iree/hal/api.h"
 #include "iree/hal/local/executable_loader.h"
+#include "iree/hal/local/local_executable_cache.h"
 #include "iree/task/executor.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
+// Maximum number of queues a device may expose as each is represented by a bit
+// in iree_hal_queue_affinity_t.
+#define IREE_HAL_TASK_DEVICE_MAX_QUEUE_COUNT \
+  (sizeof(iree_hal_queue_affinity_t) * 8)
+
 // Parameters configuring an iree_hal_task_device_t.
 // Must be initialized with iree_hal_task_device_params_initialize prior to use.
 typedef struct iree_hal_task_device_params_t {
@@ -25,6 +31,15 @@ typedef struct iree_hal_task_device_params_t {
   iree_host_size_t arena_block_size;
   // Default flags for the iree_task_scope_t used for each queue.
   iree_task_scope_flags_t queue_scope_flags;
+  // Scheduling priority of the iree_task_scope_t used for each queue indexed
+  // by queue ordinal. Work submitted with a queue affinity selecting a queue
+  // is scheduled with that queue's priority relative to the work from all
+  // other queues sharing the same executor. Defaults to normal priority.
+  iree_task_priority_t queue_priorities[IREE_HAL_TASK_DEVICE_MAX_QUEUE_COUNT];
+  // Controls when executables are loaded. Async loading is performed by the
+  // executor of the first queue and allows programs preparing many executables
+  // during initialization to load them concurrently.
+  iree_hal_local_executable_load_mode_t executable_load_mode;
 } iree_hal_task_device_params_t;
 
 // Initializes |out_params| to default values.
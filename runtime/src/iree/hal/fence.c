@@ -64,10 +64,95 @@ IREE_API_EXPORT iree_status_t iree_hal_fence_create_at(
   return status;
 }
 
-// TODO(benvanik): actually join efficiently. Today we just create a fence that
-// can hold the worst-case sum of all fence timepoints and then insert but it
-// could be made much better. In most cases the joined fences have a near
-// perfect overlap of semaphores and we are wasting memory.
+// Maximum number of timepoints merged on the stack when joining more than two
+// fences. Larger joins use a temporary heap allocation.
+#define IREE_HAL_FENCE_JOIN_MAX_STACK_TIMEPOINTS 64
+
+// Returns the index of |semaphore| in the first |count| entries of |list| or
+// IREE_HOST_SIZE_MAX if not found.
+static iree_host_size_t iree_hal_fence_find_semaphore(
+    iree_hal_semaphore_list_t list, iree_host_size_t count,
+    iree_hal_semaphore_t* semaphore) {
+  for (iree_host_size_t i = 0; i < count; ++i) {
+    if (list.semaphores[i] == semaphore) return i;
+  }
+  return IREE_HOST_SIZE_MAX;
+}
+
+// Merges the timepoints of |source_list| into |target_list| keeping the
+// maximum value of any semaphore present in both. |target_list| must have
+// capacity for all unique semaphores. Semaphores are not retained.
+static void iree_hal_fence_merge_timepoints(
+    iree_hal_semaphore_list_t source_list,
+    iree_hal_semaphore_list_t* target_list) {
+  for (iree_host_size_t i = 0; i < source_list.count; ++i) {
+    iree_host_size_t index = iree_hal_fence_find_semaphore(
+        *target_list, target_list->count, source_list.semaphores[i]);
+    if (index != IREE_HOST_SIZE_MAX) {
+      target_list->payload_values[index] = iree_max(
+          target_list->payload_values[index], source_list.payload_values[i]);
+    } else {
+      target_list->semaphores[target_list->count] = source_list.semaphores[i];
+      target_list->payload_values[target_list->count] =
+          source_list.payload_values[i];
+      ++target_list->count;
+    }
+  }
+}
+
+// Creates a fence with exactly the timepoints in |list|, which must not
+// contain duplicate semaphores.
+static iree_status_t iree_hal_fence_create_from_list(
+    iree_hal_semaphore_list_t list, iree_allocator_t host_allocator,
+    iree_hal_fence_t** out_fence) {
+  iree_hal_fence_t* fence = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_fence_create(list.count, host_allocator, &fence));
+  iree_hal_semaphore_list_t fence_list = iree_hal_fence_semaphore_list(fence);
+  for (iree_host_size_t i = 0; i < list.count; ++i) {
+    fence_list.semaphores[i] = list.semaphores[i];
+    iree_hal_semaphore_retain(list.semaphores[i]);
+    fence_list.payload_values[i] = list.payload_values[i];
+  }
+  fence->count = (uint16_t)list.count;
+  *out_fence = fence;
+  return iree_ok_status();
+}
+
+// Joins two non-empty fences. This is the common case of fork/join programs
+// and avoids the temporary storage used for wider joins.
+static iree_status_t iree_hal_fence_join_2(iree_hal_fence_t* fence_a,
+                                           iree_hal_fence_t* fence_b,
+                                           iree_allocator_t host_allocator,
+                                           iree_hal_fence_t** out_fence) {
+  iree_hal_semaphore_list_t list_a = iree_hal_fence_semaphore_list(fence_a);
+  iree_hal_semaphore_list_t list_b = iree_hal_fence_semaphore_list(fence_b);
+
+  // Count the semaphores in B that are not in A so we allocate exactly.
+  iree_host_size_t unique_count = list_a.count;
+  for (iree_host_size_t i = 0; i < list_b.count; ++i) {
+    if (iree_hal_fence_find_semaphore(list_a, list_a.count,
+                                      list_b.semaphores[i]) ==
+        IREE_HOST_SIZE_MAX) {
+      ++unique_count;
+    }
+  }
+
+  iree_hal_fence_t* fence = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_fence_create(unique_count, host_allocator, &fence));
+  iree_hal_semaphore_list_t fence_list = iree_hal_fence_semaphore_list(fence);
+  fence_list.count = 0;
+  iree_hal_fence_merge_timepoints(list_a, &fence_list);
+  iree_hal_fence_merge_timepoints(list_b, &fence_list);
+  for (iree_host_size_t i = 0; i < fence_list.count; ++i) {
+    iree_hal_semaphore_retain(fence_list.semaphores[i]);
+  }
+  fence->count = (uint16_t)fence_list.count;
+  *out_fence = fence;
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT iree_status_t iree_hal_fence_join(
     iree_host_size_t fence_count, iree_hal_fence_t** fences,
     iree_allocator_t host_allocator, iree_hal_fence_t** out_fence) {
@@ -75,41 +160,71 @@ IREE_API_EXPORT iree_status_t iree_hal_fence_join(
   *out_fence = NULL;
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Find the maximum required timepoint capacity.
+  // Find the maximum number of timepoints and the first two non-empty fences
+  // for the fast paths.
   iree_host_size_t total_count = 0;
+  iree_host_size_t nonempty_count = 0;
+  iree_hal_fence_t* nonempty_fences[2] = {NULL, NULL};
   for (iree_host_size_t i = 0; i < fence_count; ++i) {
-    if (fences[i]) total_count += fences[i]->count;
+    if (!fences[i] || !fences[i]->count) continue;
+    total_count += fences[i]->count;
+    if (nonempty_count < IREE_ARRAYSIZE(nonempty_fences)) {
+      nonempty_fences[nonempty_count] = fences[i];
+    }
+    ++nonempty_count;
   }
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, total_count);
 
   // Empty list -> NULL.
   if (!total_count) {
     IREE_TRACE_ZONE_END(z0);
-    return NULL;
+    return iree_ok_status();
   }
 
-  // Create the fence with the maximum capacity.
-  iree_hal_fence_t* fence = NULL;
-  IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_hal_fence_create(total_count, host_allocator, &fence));
-
-  // Insert all timepoints from all fences.
   iree_status_t status = iree_ok_status();
-  for (iree_host_size_t i = 0; i < fence_count; ++i) {
-    iree_hal_semaphore_list_t source_list =
-        iree_hal_fence_semaphore_list(fences[i]);
-    for (iree_host_size_t j = 0; j < source_list.count; ++j) {
-      status = iree_hal_fence_insert(fence, source_list.semaphores[j],
-                                     source_list.payload_values[j]);
-      if (!iree_status_is_ok(status)) break;
+  if (nonempty_count == 1) {
+    // Copy of the only fence with timepoints.
+    status = iree_hal_fence_create_from_list(
+        iree_hal_fence_semaphore_list(nonempty_fences[0]), host_allocator,
+        out_fence);
+  } else if (nonempty_count == 2) {
+    status = iree_hal_fence_join_2(nonempty_fences[0], nonempty_fences[1],
+                                   host_allocator, out_fence);
+  } else {
+    // Merge all timepoints into temporary storage sized for the worst case and
+    // then create the fence with only the unique semaphores.
+    iree_hal_semaphore_t** semaphores = NULL;
+    uint64_t* payload_values = NULL;
+    void* heap_storage = NULL;
+    if (total_count <= IREE_HAL_FENCE_JOIN_MAX_STACK_TIMEPOINTS) {
+      semaphores = (iree_hal_semaphore_t**)iree_alloca(total_count *
+                                                       sizeof(semaphores[0]));
+      payload_values =
+          (uint64_t*)iree_alloca(total_count * sizeof(payload_values[0]));
+    } else {
+      status = iree_allocator_malloc(
+          host_allocator,
+          total_count * (sizeof(semaphores[0]) + sizeof(payload_values[0])),
+          &heap_storage);
+      payload_values = (uint64_t*)heap_storage;
+      semaphores = (iree_hal_semaphore_t**)(payload_values + total_count);
     }
-    if (!iree_status_is_ok(status)) break;
+    if (iree_status_is_ok(status)) {
+      iree_hal_semaphore_list_t merged_list = {
+          .count = 0,
+          .semaphores = semaphores,
+          .payload_values = payload_values,
+      };
+      for (iree_host_size_t i = 0; i < fence_count; ++i) {
+        iree_hal_fence_merge_timepoints(
+            iree_hal_fence_semaphore_list(fences[i]), &merged_list);
+      }
+      status = iree_hal_fence_create_from_list(merged_list, host_allocator,
+                                               out_fence);
+    }
+    iree_allocator_free(host_allocator, heap_storage);
   }
 
-  if (iree_status_is_ok(status)) {
-    *out_fence = fence;
-  } else {
-    iree_hal_fence_release(fence);
-  }
   IREE_TRACE_ZONE_END(z0);
   return status;
 }
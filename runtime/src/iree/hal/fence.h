@@ -57,6 +57,9 @@ IREE_API_EXPORT iree_status_t iree_hal_fence_create_at(
     iree_allocator_t host_allocator, iree_hal_fence_t** out_fence);
 
 // Creates a new fence joining all |fences| as a wait-all operation.
+// Timepoints on the same semaphore are merged by keeping the maximum value and
+// the new fence has capacity for exactly the unique semaphores. NULL fences
+// are ignored and if there are no timepoints |out_fence| is set to NULL.
 IREE_API_EXPORT iree_status_t iree_hal_fence_join(
     iree_host_size_t fence_count, iree_hal_fence_t** fences,
     iree_allocator_t host_allocator, iree_hal_fence_t** out_fence);
@@ -0,0 +1,257 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/fence.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+using iree::Status;
+using iree::StatusCode;
+using iree::testing::status::StatusIs;
+
+// Semaphore that only tracks its lifetime. Fence joins only compare and retain
+// semaphores so no other methods are needed.
+typedef struct iree_hal_test_semaphore_t {
+  iree_hal_resource_t resource;
+  iree_allocator_t host_allocator;
+  int* live_count;
+} iree_hal_test_semaphore_t;
+
+static void iree_hal_test_semaphore_destroy(
+    iree_hal_semaphore_t* base_semaphore) {
+  iree_hal_test_semaphore_t* semaphore =
+      (iree_hal_test_semaphore_t*)base_semaphore;
+  --*semaphore->live_count;
+  iree_allocator_free(semaphore->host_allocator, semaphore);
+}
+
+static const iree_hal_semaphore_vtable_t iree_hal_test_semaphore_vtable = {
+    /*.destroy=*/iree_hal_test_semaphore_destroy,
+};
+
+struct FenceTest : public ::testing::Test {
+  void TearDown() override {
+    for (auto* semaphore : semaphores) iree_hal_semaphore_release(semaphore);
+    for (auto* fence : fences) iree_hal_fence_release(fence);
+    // Joined fences must release all of the semaphores they retained.
+    EXPECT_EQ(live_count, 0);
+  }
+
+  // Creates |count| semaphores owned by the test.
+  void CreateSemaphores(int count) {
+    for (int i = 0; i < count; ++i) {
+      iree_hal_test_semaphore_t* semaphore = NULL;
+      IREE_ASSERT_OK(iree_allocator_malloc(
+          host_allocator, sizeof(*semaphore), (void**)&semaphore));
+      iree_hal_resource_initialize(&iree_hal_test_semaphore_vtable,
+                                   &semaphore->resource);
+      semaphore->host_allocator = host_allocator;
+      semaphore->live_count = &live_count;
+      ++live_count;
+      semaphores.push_back((iree_hal_semaphore_t*)semaphore);
+    }
+  }
+
+  // Creates a fence owned by the test with the given (semaphore, value) pairs.
+  iree_hal_fence_t* CreateFence(
+      std::vector<std::pair<int, uint64_t>> timepoints) {
+    iree_hal_fence_t* fence = NULL;
+    IREE_CHECK_OK(
+        iree_hal_fence_create(timepoints.size(), host_allocator, &fence));
+    for (auto [index, value] : timepoints) {
+      IREE_CHECK_OK(iree_hal_fence_insert(fence, semaphores[index], value));
+    }
+    fences.push_back(fence);
+    return fence;
+  }
+
+  // Returns the payload value of |semaphore_index| in |fence| or UINT64_MAX if
+  // not present.
+  uint64_t FindValue(iree_hal_fence_t* fence, int semaphore_index) {
+    iree_hal_semaphore_list_t list = iree_hal_fence_semaphore_list(fence);
+    for (iree_host_size_t i = 0; i < list.count; ++i) {
+      if (list.semaphores[i] == semaphores[semaphore_index]) {
+        return list.payload_values[i];
+      }
+    }
+    return UINT64_MAX;
+  }
+
+  iree_allocator_t host_allocator = iree_allocator_system();
+  int live_count = 0;
+  std::vector<iree_hal_semaphore_t*> semaphores;
+  std::vector<iree_hal_fence_t*> fences;
+};
+
+TEST_F(FenceTest, JoinNone) {
+  iree_hal_fence_t* joined_fence = (iree_hal_fence_t*)0x1;
+  IREE_ASSERT_OK(
+      iree_hal_fence_join(0, NULL, host_allocator, &joined_fence));
+  EXPECT_EQ(joined_fence, nullptr);
+}
+
+TEST_F(FenceTest, JoinNullAndEmpty) {
+  iree_hal_fence_t* empty_fence = CreateFence({});
+  iree_hal_fence_t* input_fences[] = {NULL, empty_fence, NULL};
+  iree_hal_fence_t* joined_fence = (iree_hal_fence_t*)0x1;
+  IREE_ASSERT_OK(iree_hal_fence_join(IREE_ARRAYSIZE(input_fences),
+                                     input_fences, host_allocator,
+                                     &joined_fence));
+  EXPECT_EQ(joined_fence, nullptr);
+}
+
+// A single non-empty fence among NULL and empty fences is copied.
+TEST_F(FenceTest, JoinOne) {
+  CreateSemaphores(2);
+  iree_hal_fence_t* fence = CreateFence({{0, 5}, {1, 7}});
+  iree_hal_fence_t* empty_fence = CreateFence({});
+  iree_hal_fence_t* input_fences[] = {NULL, empty_fence, fence};
+  iree_hal_fence_t* joined_fence = NULL;
+  IREE_ASSERT_OK(iree_hal_fence_join(IREE_ARRAYSIZE(input_fences),
+                                     input_fences, host_allocator,
+                                     &joined_fence));
+  ASSERT_NE(joined_fence, nullptr);
+  fences.push_back(joined_fence);
+  EXPECT_NE(joined_fence, fence);
+  EXPECT_EQ(iree_hal_fence_timepoint_count(joined_fence), 2);
+  EXPECT_EQ(joined_fence->capacity, 2);
+  EXPECT_EQ(FindValue(joined_fence, 0), 5);
+  EXPECT_EQ(FindValue(joined_fence, 1), 7);
+}
+
+// Two fences use the dedicated 2-way join. Shared semaphores keep the max
+// value regardless of which fence has it and the fence is exactly sized.
+TEST_F(FenceTest, JoinTwo) {
+  CreateSemaphores(4);
+  iree_hal_fence_t* fence_a = CreateFence({{0, 5}, {1, 2}, {2, 1}});
+  iree_hal_fence_t* fence_b = CreateFence({{1, 9}, {0, 3}, {3, 4}});
+  iree_hal_fence_t* input_fences[] = {fence_a, NULL, fence_b};
+  iree_hal_fence_t* joined_fence = NULL;
+  IREE_ASSERT_OK(iree_hal_fence_join(IREE_ARRAYSIZE(input_fences),
+                                     input_fences, host_allocator,
+                                     &joined_fence));
+  ASSERT_NE(joined_fence, nullptr);
+  fences.push_back(joined_fence);
+  EXPECT_EQ(iree_hal_fence_timepoint_count(joined_fence), 4);
+  EXPECT_EQ(joined_fence->capacity, 4);
+  EXPECT_EQ(FindValue(joined_fence, 0), 5);
+  EXPECT_EQ(FindValue(joined_fence, 1), 9);
+  EXPECT_EQ(FindValue(joined_fence, 2), 1);
+  EXPECT_EQ(FindValue(joined_fence, 3), 4);
+}
+
+TEST_F(FenceTest, JoinTwoIdentical) {
+  CreateSemaphores(2);
+  iree_hal_fence_t* fence = CreateFence({{0, 5}, {1, 2}});
+  iree_hal_fence_t* input_fences[] = {fence, fence};
+  iree_hal_fence_t* joined_fence = NULL;
+  IREE_ASSERT_OK(iree_hal_fence_join(IREE_ARRAYSIZE(input_fences),
+                                     input_fences, host_allocator,
+                                     &joined_fence));
+  ASSERT_NE(joined_fence, nullptr);
+  fences.push_back(joined_fence);
+  EXPECT_EQ(iree_hal_fence_timepoint_count(joined_fence), 2);
+  EXPECT_EQ(joined_fence->capacity, 2);
+  EXPECT_EQ(FindValue(joined_fence, 0), 5);
+  EXPECT_EQ(FindValue(joined_fence, 1), 2);
+}
+
+// More than two fences merge through temporary storage.
+TEST_F(FenceTest, JoinMany) {
+  CreateSemaphores(4);
+  iree_hal_fence_t* input_fences[] = {
+      CreateFence({{0, 1}, {1, 1}}),
+      NULL,
+      CreateFence({{1, 3}, {2, 2}}),
+      CreateFence({}),
+      CreateFence({{2, 1}, {0, 4}}),
+      CreateFence({{3, 6}}),
+  };
+  iree_hal_fence_t* joined_fence = NULL;
+  IREE_ASSERT_OK(iree_hal_fence_join(IREE_ARRAYSIZE(input_fences),
+                                     input_fences, host_allocator,
+                                     &joined_fence));
+  ASSERT_NE(joined_fence, nullptr);
+  fences.push_back(joined_fence);
+  EXPECT_EQ(iree_hal_fence_timepoint_count(joined_fence), 4);
+  EXPECT_EQ(joined_fence->capacity, 4);
+  EXPECT_EQ(FindValue(joined_fence, 0), 4);
+  EXPECT_EQ(FindValue(joined_fence, 1), 3);
+  EXPECT_EQ(FindValue(joined_fence, 2), 2);
+  EXPECT_EQ(FindValue(joined_fence, 3), 6);
+}
+
+// Joins with more timepoints than fit on the stack merge on the heap and the
+// result still only has capacity for the unique semaphores.
+TEST_F(FenceTest, JoinManyLarge) {
+  const int kSemaphoreCount = 100;
+  const int kFenceCount = 4;
+  CreateSemaphores(kSemaphoreCount);
+  std::vector<iree_hal_fence_t*> input_fences;
+  for (int i = 0; i < kFenceCount; ++i) {
+    // Each fence has all even semaphores at a value increasing with the fence
+    // index and a unique quarter of the odd semaphores.
+    std::vector<std::pair<int, uint64_t>> timepoints;
+    for (int j = 0; j < kSemaphoreCount; j += 2) timepoints.push_back({j, i});
+    for (int j = 1 + 2 * i; j < kSemaphoreCount; j += 2 * kFenceCount) {
+      timepoints.push_back({j, 100 + j});
+    }
+    input_fences.push_back(CreateFence(timepoints));
+  }
+  iree_hal_fence_t* joined_fence = NULL;
+  IREE_ASSERT_OK(iree_hal_fence_join(input_fences.size(), input_fences.data(),
+                                     host_allocator, &joined_fence));
+  ASSERT_NE(joined_fence, nullptr);
+  fences.push_back(joined_fence);
+  EXPECT_EQ(iree_hal_fence_timepoint_count(joined_fence), kSemaphoreCount);
+  EXPECT_EQ(joined_fence->capacity, kSemaphoreCount);
+  for (int j = 0; j < kSemaphoreCount; ++j) {
+    EXPECT_EQ(FindValue(joined_fence, j),
+              j % 2 == 0 ? kFenceCount - 1 : 100 + j);
+  }
+}
+
+// Joined fences are exactly sized and inserting new semaphores requires a
+// new fence while existing semaphores can still be updated in place.
+TEST_F(FenceTest, JoinedFenceCapacity) {
+  CreateSemaphores(3);
+  iree_hal_fence_t* fence_a = CreateFence({{0, 1}});
+  iree_hal_fence_t* fence_b = CreateFence({{1, 1}});
+  iree_hal_fence_t* input_fences[] = {fence_a, fence_b};
+  iree_hal_fence_t* joined_fence = NULL;
+  IREE_ASSERT_OK(iree_hal_fence_join(IREE_ARRAYSIZE(input_fences),
+                                     input_fences, host_allocator,
+                                     &joined_fence));
+  ASSERT_NE(joined_fence, nullptr);
+  fences.push_back(joined_fence);
+  IREE_EXPECT_OK(iree_hal_fence_insert(joined_fence, semaphores[0], 8));
+  EXPECT_EQ(FindValue(joined_fence, 0), 8);
+  EXPECT_THAT(
+      Status(iree_hal_fence_insert(joined_fence, semaphores[2], 1)),
+      StatusIs(StatusCode::kResourceExhausted));
+
+  iree_hal_fence_t* grown_fence = CreateFence({{2, 1}});
+  iree_hal_fence_t* grow_fences[] = {joined_fence, grown_fence};
+  iree_hal_fence_t* regrown_fence = NULL;
+  IREE_ASSERT_OK(iree_hal_fence_join(IREE_ARRAYSIZE(grow_fences), grow_fences,
+                                     host_allocator, &regrown_fence));
+  ASSERT_NE(regrown_fence, nullptr);
+  fences.push_back(regrown_fence);
+  EXPECT_EQ(regrown_fence->capacity, 3);
+  EXPECT_EQ(FindValue(regrown_fence, 0), 8);
+  EXPECT_EQ(FindValue(regrown_fence, 1), 1);
+  EXPECT_EQ(FindValue(regrown_fence, 2), 1);
+}
+
+}  // namespace
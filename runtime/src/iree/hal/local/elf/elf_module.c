@@ -7,6 +7,7 @@
 #include "iree/hal/local/elf/elf_module.h"
 
 #include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "iree/hal/local/elf/arch.h"
@@ -30,6 +31,15 @@ typedef struct iree_elf_module_load_state_t {
   iree_elf_addr_t init;               // DT_INIT
   const iree_elf_addr_t* init_array;  // DT_INIT_ARRAY
   iree_host_size_t init_array_count;  // DT_INIT_ARRAYSZ
+
+  // Directory containing shared images or empty if sharing is disabled.
+  iree_string_view_t shared_cache_path;
+  // Path of the shared image for this module within shared_cache_path.
+  char shared_image_path[1024];
+  // Bitmask of phdr indices of PT_LOAD segments that may be shared.
+  uint64_t shareable_segment_mask;
+  // Bitmask of phdr indices of PT_LOAD segments mapped from a shared image.
+  uint64_t shared_segment_mask;
 } iree_elf_module_load_state_t;
 
 // Verifies the ELF file header and machine class.
@@ -192,6 +202,241 @@ static iree_status_t iree_elf_module_parse_headers(
   return iree_ok_status();
 }
 
+//==============================================================================
+// Shared images
+//==============================================================================
+// Segments that are never written during loading can be shared across all
+// processes loading the same ELF by mapping them from a file-backed image
+// instead of committing private pages and copying. Without text relocations
+// the contents of read-only segments are independent of the load address and
+// identical in every process.
+
+// Returns the memory access required by the segment defined by |phdr|.
+static iree_memory_access_t iree_elf_module_segment_access(
+    const iree_elf_phdr_t* phdr) {
+  // Interpret the access bits and widen to the implicit allowable
+  // permissions. See Table 7-37:
+  // https://docs.oracle.com/cd/E19683-01/816-1386/6m7qcoblk/index.html#chapter6-34713
+  iree_memory_access_t access = 0;
+  if (phdr->p_flags & IREE_ELF_PF_R) access |= IREE_MEMORY_ACCESS_READ;
+  if (phdr->p_flags & IREE_ELF_PF_W) access |= IREE_MEMORY_ACCESS_WRITE;
+  if (phdr->p_flags & IREE_ELF_PF_X) access |= IREE_MEMORY_ACCESS_EXECUTE;
+  if (access & IREE_MEMORY_ACCESS_WRITE) access |= IREE_MEMORY_ACCESS_READ;
+  if (access & IREE_MEMORY_ACCESS_EXECUTE) access |= IREE_MEMORY_ACCESS_READ;
+  return access;
+}
+
+// Returns true if the ELF declares that it has relocations against read-only
+// segments (DT_TEXTREL or DF_TEXTREL). The dynamic table is read from the file
+// as this happens prior to loading.
+static bool iree_elf_module_has_text_relocations(
+    iree_const_byte_span_t raw_data, iree_elf_module_load_state_t* load_state) {
+  for (iree_elf_half_t i = 0; i < load_state->ehdr->e_phnum; ++i) {
+    const iree_elf_phdr_t* phdr = &load_state->phdr_table[i];
+    if (phdr->p_type != IREE_ELF_PT_DYNAMIC) continue;
+    if (phdr->p_offset + phdr->p_filesz > raw_data.data_length) return true;
+    const iree_elf_dyn_t* dyn_table =
+        (const iree_elf_dyn_t*)(raw_data.data + phdr->p_offset);
+    iree_host_size_t dyn_table_count = phdr->p_filesz / sizeof(iree_elf_dyn_t);
+    for (iree_host_size_t j = 0; j < dyn_table_count; ++j) {
+      const iree_elf_dyn_t* dyn = &dyn_table[j];
+      if (dyn->d_tag == IREE_ELF_DT_TEXTREL) return true;
+      if (dyn->d_tag == IREE_ELF_DT_FLAGS &&
+          (dyn->d_un.d_val & IREE_ELF_DF_TEXTREL)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Returns the byte range of the segment defined by |phdr| relative to the base
+// of the module virtual address space reservation.
+static iree_byte_range_t iree_elf_module_segment_base_range(
+    const iree_elf_phdr_t* phdr, iree_elf_module_t* module) {
+  iree_byte_range_t byte_range = {
+      .offset = (iree_host_size_t)(module->vaddr_bias + phdr->p_vaddr -
+                                   module->vaddr_base),
+      .length = phdr->p_memsz,
+  };
+  return byte_range;
+}
+
+// Selects the PT_LOAD segments that may be mapped from a shared image: those
+// not writable and not sharing any host pages with other segments.
+static void iree_elf_module_select_shareable_segments(
+    iree_const_byte_span_t raw_data, iree_elf_module_load_state_t* load_state,
+    iree_elf_module_t* module) {
+  load_state->shareable_segment_mask = 0;
+  if (load_state->ehdr->e_phnum > 64) return;
+  if (iree_elf_module_has_text_relocations(raw_data, load_state)) return;
+  const iree_host_size_t page_size = load_state->memory_info.normal_page_size;
+  for (iree_elf_half_t i = 0; i < load_state->ehdr->e_phnum; ++i) {
+    const iree_elf_phdr_t* phdr = &load_state->phdr_table[i];
+    if (phdr->p_type != IREE_ELF_PT_LOAD) continue;
+    if (phdr->p_flags & IREE_ELF_PF_W) continue;
+    if (phdr->p_memsz == 0) continue;
+    uintptr_t page_start = iree_page_align_start(
+        (uintptr_t)(module->vaddr_bias + phdr->p_vaddr), page_size);
+    uintptr_t page_end = iree_page_align_end(
+        (uintptr_t)(module->vaddr_bias + phdr->p_vaddr + phdr->p_memsz),
+        page_size);
+    bool overlaps = false;
+    for (iree_elf_half_t j = 0; j < load_state->ehdr->e_phnum; ++j) {
+      const iree_elf_phdr_t* other_phdr = &load_state->phdr_table[j];
+      if (j == i || other_phdr->p_type != IREE_ELF_PT_LOAD) continue;
+      uintptr_t other_start = iree_page_align_start(
+          (uintptr_t)(module->vaddr_bias + other_phdr->p_vaddr), page_size);
+      uintptr_t other_end = iree_page_align_end(
+          (uintptr_t)(module->vaddr_bias + other_phdr->p_vaddr +
+                      other_phdr->p_memsz),
+          page_size);
+      if (page_start < other_end && other_start < page_end) {
+        overlaps = true;
+        break;
+      }
+    }
+    if (!overlaps) load_state->shareable_segment_mask |= 1ull << i;
+  }
+}
+
+// Formats the path of the shared image for the ELF in |raw_data|.
+// Images are keyed by a hash of the ELF contents and the reservation size.
+// Collisions are benign as mapped contents are always verified before use.
+static iree_status_t iree_elf_module_format_shared_image_path(
+    iree_const_byte_span_t raw_data, iree_elf_module_load_state_t* load_state,
+    iree_elf_module_t* module) {
+  // 64-bit FNV-1a.
+  uint64_t hash = 0xCBF29CE484222325ull;
+  for (iree_host_size_t i = 0; i < raw_data.data_length; ++i) {
+    hash ^= raw_data.data[i];
+    hash *= 0x100000001B3ull;
+  }
+  int length = snprintf(
+      load_state->shared_image_path, sizeof(load_state->shared_image_path),
+      "%.*s/iree-elf-%016" PRIx64 "-%" PRIhsz ".img",
+      (int)load_state->shared_cache_path.size,
+      load_state->shared_cache_path.data, hash, module->vaddr_size);
+  if (length < 0 || length >= (int)sizeof(load_state->shared_image_path)) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "shared ELF cache path too long");
+  }
+  return iree_ok_status();
+}
+
+static bool iree_elf_is_zero(const uint8_t* data, iree_host_size_t length) {
+  for (iree_host_size_t i = 0; i < length; ++i) {
+    if (data[i] != 0) return false;
+  }
+  return true;
+}
+
+// Returns true if the loaded pages of the segment defined by |phdr| contain
+// exactly what a private load of |raw_data| would have produced.
+static bool iree_elf_module_verify_loaded_segment(
+    iree_const_byte_span_t raw_data, iree_elf_module_load_state_t* load_state,
+    const iree_elf_phdr_t* phdr, iree_elf_module_t* module) {
+  const iree_host_size_t page_size = load_state->memory_info.normal_page_size;
+  uint8_t* segment_start = module->vaddr_bias + phdr->p_vaddr;
+  uint8_t* file_end = segment_start + phdr->p_filesz;
+  uint8_t* page_start =
+      (uint8_t*)iree_page_align_start((uintptr_t)segment_start, page_size);
+  uint8_t* page_end = (uint8_t*)iree_page_align_end(
+      (uintptr_t)(segment_start + phdr->p_memsz), page_size);
+  return iree_elf_is_zero(page_start, segment_start - page_start) &&
+         memcmp(segment_start, raw_data.data + phdr->p_offset,
+                phdr->p_filesz) == 0 &&
+         iree_elf_is_zero(file_end, page_end - file_end);
+}
+
+// Maps all shareable segments from an existing shared image, if present.
+// Segments successfully mapped and verified are added to the
+// shared_segment_mask and must not be loaded privately. Failures are not fatal
+// and leave the segments to be loaded as usual.
+static iree_status_t iree_elf_module_map_shared_image(
+    iree_const_byte_span_t raw_data, iree_elf_module_load_state_t* load_state,
+    iree_elf_module_t* module) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  load_state->shared_segment_mask = 0;
+
+  iree_memory_shared_image_t image;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_memory_shared_image_open(load_state->shared_image_path,
+                                        module->vaddr_size, &image));
+
+  iree_status_t status = iree_ok_status();
+  uint64_t mapped_segment_mask = 0;
+  for (iree_elf_half_t i = 0; i < load_state->ehdr->e_phnum; ++i) {
+    if (!(load_state->shareable_segment_mask & (1ull << i))) continue;
+    const iree_elf_phdr_t* phdr = &load_state->phdr_table[i];
+    iree_byte_range_t byte_range =
+        iree_elf_module_segment_base_range(phdr, module);
+    status = iree_memory_view_map_shared_image_ranges(
+        module->vaddr_base, &image, 1, &byte_range,
+        iree_elf_module_segment_access(phdr));
+    if (!iree_status_is_ok(status)) break;
+    mapped_segment_mask |= 1ull << i;
+    if (!iree_elf_module_verify_loaded_segment(raw_data, load_state, phdr,
+                                               module)) {
+      status = iree_make_status(IREE_STATUS_DATA_LOSS,
+                                "shared image '%s' contents do not match ELF",
+                                load_state->shared_image_path);
+      break;
+    }
+  }
+  iree_memory_shared_image_close(&image);
+
+  // On success all shareable segments are mapped. On failure any segments
+  // already mapped will be replaced when they are committed as private pages.
+  if (iree_status_is_ok(status)) {
+    load_state->shared_segment_mask = mapped_segment_mask;
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Publishes the privately loaded shareable segments as a new shared image and
+// replaces the private pages with mappings of the image. Must be called after
+// relocation and protection.
+static iree_status_t iree_elf_module_publish_shared_image(
+    iree_elf_module_load_state_t* load_state, iree_elf_module_t* module) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_byte_range_t byte_ranges[64];
+  iree_host_size_t byte_range_count = 0;
+  for (iree_elf_half_t i = 0; i < load_state->ehdr->e_phnum; ++i) {
+    if (!(load_state->shareable_segment_mask & (1ull << i))) continue;
+    byte_ranges[byte_range_count++] = iree_elf_module_segment_base_range(
+        &load_state->phdr_table[i], module);
+  }
+
+  iree_memory_shared_image_t image;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_memory_shared_image_create(
+              load_state->shared_image_path, module->vaddr_base,
+              module->vaddr_size, byte_range_count, byte_ranges, &image));
+
+  // Swap the private pages out for the image pages so that this process
+  // shares them as well. The contents are identical so a partial failure is
+  // harmless.
+  iree_status_t status = iree_ok_status();
+  for (iree_elf_half_t i = 0; i < load_state->ehdr->e_phnum; ++i) {
+    if (!(load_state->shareable_segment_mask & (1ull << i))) continue;
+    const iree_elf_phdr_t* phdr = &load_state->phdr_table[i];
+    iree_byte_range_t byte_range =
+        iree_elf_module_segment_base_range(phdr, module);
+    status = iree_memory_view_map_shared_image_ranges(
+        module->vaddr_base, &image, 1, &byte_range,
+        iree_elf_module_segment_access(phdr));
+    if (!iree_status_is_ok(status)) break;
+    load_state->shared_segment_mask |= 1ull << i;
+  }
+  iree_memory_shared_image_close(&image);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 //==============================================================================
 // Allocation and layout
 //==============================================================================
@@ -247,10 +492,24 @@ static iree_status_t iree_elf_module_load_segments(
       module->host_allocator, (void**)&module->vaddr_base));
   module->vaddr_bias = module->vaddr_base - vaddr_range.offset;
 
+  // If sharing is enabled try to map segments from an existing shared image.
+  // If there is no image (or it cannot be used) we load privately and publish
+  // a new image after relocation.
+  if (!iree_string_view_is_empty(load_state->shared_cache_path)) {
+    iree_elf_module_select_shareable_segments(raw_data, load_state, module);
+    if (load_state->shareable_segment_mask) {
+      IREE_RETURN_IF_ERROR(iree_elf_module_format_shared_image_path(
+          raw_data, load_state, module));
+      iree_status_ignore(
+          iree_elf_module_map_shared_image(raw_data, load_state, module));
+    }
+  }
+
   // Commit and load all of the segments.
   for (iree_elf_half_t i = 0; i < load_state->ehdr->e_phnum; ++i) {
     const iree_elf_phdr_t* phdr = &load_state->phdr_table[i];
     if (phdr->p_type != IREE_ELF_PT_LOAD) continue;
+    if (load_state->shared_segment_mask & (1ull << i)) continue;
 
     // Commit the range of pages used by this segment, initially with write
     // access so that we can modify the pages.
@@ -298,15 +557,7 @@ static iree_status_t iree_elf_module_protect_segments(
     const iree_elf_phdr_t* phdr = &load_state->phdr_table[i];
     if (phdr->p_type != IREE_ELF_PT_LOAD) continue;
 
-    // Interpret the access bits and widen to the implicit allowable
-    // permissions. See Table 7-37:
-    // https://docs.oracle.com/cd/E19683-01/816-1386/6m7qcoblk/index.html#chapter6-34713
-    iree_memory_access_t access = 0;
-    if (phdr->p_flags & IREE_ELF_PF_R) access |= IREE_MEMORY_ACCESS_READ;
-    if (phdr->p_flags & IREE_ELF_PF_W) access |= IREE_MEMORY_ACCESS_WRITE;
-    if (phdr->p_flags & IREE_ELF_PF_X) access |= IREE_MEMORY_ACCESS_EXECUTE;
-    if (access & IREE_MEMORY_ACCESS_WRITE) access |= IREE_MEMORY_ACCESS_READ;
-    if (access & IREE_MEMORY_ACCESS_EXECUTE) access |= IREE_MEMORY_ACCESS_READ;
+    iree_memory_access_t access = iree_elf_module_segment_access(phdr);
 
     // We only support R+X (no W).
     if ((phdr->p_flags & IREE_ELF_PF_X) && (phdr->p_flags & IREE_ELF_PF_W)) {
@@ -574,6 +825,16 @@ iree_status_t iree_elf_module_initialize_from_memory(
     iree_const_byte_span_t raw_data,
     const iree_elf_import_table_t* import_table,
     iree_allocator_t host_allocator, iree_elf_module_t* out_module) {
+  return iree_elf_module_initialize_from_memory_shared(
+      raw_data, import_table, iree_string_view_empty(), host_allocator,
+      out_module);
+}
+
+iree_status_t iree_elf_module_initialize_from_memory_shared(
+    iree_const_byte_span_t raw_data,
+    const iree_elf_import_table_t* import_table,
+    iree_string_view_t shared_cache_path, iree_allocator_t host_allocator,
+    iree_elf_module_t* out_module) {
   IREE_ASSERT_ARGUMENT(raw_data.data);
   IREE_ASSERT_ARGUMENT(out_module);
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -592,6 +853,7 @@ iree_status_t iree_elf_module_initialize_from_memory(
   iree_status_t status =
       iree_elf_module_parse_headers(raw_data, &load_state, out_module);
   out_module->host_allocator = host_allocator;
+  load_state.shared_cache_path = shared_cache_path;
 
   // Allocate and load the ELF into memory.
   iree_memory_jit_context_begin();
@@ -621,6 +883,15 @@ iree_status_t iree_elf_module_initialize_from_memory(
   if (iree_status_is_ok(status)) {
     status = iree_elf_module_protect_segments(&load_state, out_module);
   }
+
+  // Publish a shared image if sharing is enabled and no existing image was
+  // used. This is best-effort and the module remains usable with its private
+  // pages if it fails (read-only cache directories, etc).
+  if (iree_status_is_ok(status) && load_state.shareable_segment_mask &&
+      !load_state.shared_segment_mask) {
+    iree_status_ignore(
+        iree_elf_module_publish_shared_image(&load_state, out_module));
+  }
   iree_memory_jit_context_end();
 
   // Run initializers prior to returning to the caller.
@@ -77,6 +77,29 @@ iree_status_t iree_elf_module_initialize_from_memory(
     const iree_elf_import_table_t* import_table,
     iree_allocator_t host_allocator, iree_elf_module_t* out_module);
 
+// Initializes an ELF module from the ELF |raw_data| in memory as with
+// iree_elf_module_initialize_from_memory but maps read-only executable segments
+// from a shared image in the |shared_cache_path| directory instead of keeping
+// a private copy. Multiple processes loading the same ELF will map the same
+// image and share its physical pages.
+//
+// The first process to load a particular ELF populates the image and all later
+// processes map it directly without copying or relocating the shared segments.
+// Only ELFs without text relocations are shared: as such code is position
+// independent it is identical regardless of the address it is loaded at. The
+// mapped contents are verified against |raw_data| before use and the module
+// falls back to private pages if the image does not match or the platform does
+// not support shared images. The cache directory must only be writable by
+// trusted users.
+//
+// Use a directory on a memory-backed file system (such as /dev/shm) to avoid
+// disk I/O when populating and mapping images.
+iree_status_t iree_elf_module_initialize_from_memory_shared(
+    iree_const_byte_span_t raw_data,
+    const iree_elf_import_table_t* import_table,
+    iree_string_view_t shared_cache_path, iree_allocator_t host_allocator,
+    iree_elf_module_t* out_module);
+
 // Deinitializes a |module|, releasing any allocated executable or data pages.
 // Invalidates all symbol pointers previous retrieved from the module and any
 // pointer to data that may have been in the module text or rwdata.
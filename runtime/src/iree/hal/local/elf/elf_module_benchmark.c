@@ -0,0 +1,195 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/file_io.h"
+#include "iree/base/internal/flags.h"
+#include "iree/hal/local/elf/elf_module.h"
+#include "iree/testing/benchmark.h"
+
+// ELF modules for various platforms embedded in the binary:
+#include "iree/hal/local/elf/testdata/elementwise_mul.h"
+
+IREE_FLAG(string, shared_code_cache, "",
+          "Directory used for shared code images. Shared benchmarks are "
+          "skipped if omitted. Use /dev/shm/ to avoid disk I/O.");
+
+IREE_FLAG(string, elf_file, "",
+          "Optional ELF file to load instead of the embedded test module. "
+          "Larger executables better show the effects of sharing.");
+
+static iree_file_contents_t* elf_file_contents = NULL;
+static iree_const_byte_span_t elf_data = {NULL, 0};
+
+static iree_status_t query_elf_data(iree_const_byte_span_t* out_file_data) {
+  *out_file_data = iree_make_const_byte_span(NULL, 0);
+  if (strlen(FLAG_elf_file) > 0) {
+    IREE_RETURN_IF_ERROR(iree_file_read_contents(
+        FLAG_elf_file, IREE_FILE_READ_FLAG_DEFAULT, iree_allocator_system(),
+        &elf_file_contents));
+    *out_file_data = elf_file_contents->const_buffer;
+    return iree_ok_status();
+  }
+
+  iree_string_view_t pattern = iree_string_view_empty();
+#if defined(IREE_ARCH_ARM_32)
+  pattern = iree_make_cstring_view("*_arm_32.so");
+#elif defined(IREE_ARCH_ARM_64)
+  pattern = iree_make_cstring_view("*_arm_64.so");
+#elif defined(IREE_ARCH_RISCV_32)
+  pattern = iree_make_cstring_view("*_riscv_32.so");
+#elif defined(IREE_ARCH_RISCV_64)
+  pattern = iree_make_cstring_view("*_riscv_64.so");
+#elif defined(IREE_ARCH_X86_32)
+  pattern = iree_make_cstring_view("*_x86_32.so");
+#elif defined(IREE_ARCH_X86_64)
+  pattern = iree_make_cstring_view("*_x86_64.so");
+#endif  // IREE_ARCH_*
+  for (size_t i = 0; i < elementwise_mul_size(); ++i) {
+    const struct iree_file_toc_t* file_toc = &elementwise_mul_create()[i];
+    if (iree_string_view_match_pattern(iree_make_cstring_view(file_toc->name),
+                                       pattern)) {
+      *out_file_data =
+          iree_make_const_byte_span(file_toc->data, file_toc->size);
+      return iree_ok_status();
+    }
+  }
+  return iree_make_status(IREE_STATUS_NOT_FOUND,
+                          "no architecture-specific ELF binary embedded into "
+                          "the application for the current target platform");
+}
+
+// Returns the anonymous (private, non-file-backed) resident set size of the
+// process in bytes or 0 if unavailable on the platform.
+static int64_t query_rss_anon_bytes(void) {
+#if defined(IREE_PLATFORM_LINUX) || defined(IREE_PLATFORM_ANDROID)
+  FILE* file = fopen("/proc/self/status", "r");
+  if (!file) return 0;
+  int64_t rss_anon_kb = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    if (sscanf(line, "RssAnon: %" SCNd64 " kB", &rss_anon_kb) == 1) break;
+  }
+  fclose(file);
+  return rss_anon_kb * 1024;
+#else
+  return 0;
+#endif  // IREE_PLATFORM_*
+}
+
+// Measures the time to load and unload a module as happens during startup.
+// user_data is non-NULL when loading from the shared code cache.
+static iree_status_t iree_elf_module_benchmark_load(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_string_view_t shared_cache_path = iree_string_view_empty();
+  if (benchmark_def->user_data) {
+    shared_cache_path = iree_make_cstring_view(FLAG_shared_code_cache);
+    if (iree_string_view_is_empty(shared_cache_path)) {
+      iree_benchmark_skip(benchmark_state,
+                          "--shared_code_cache= directory not specified");
+      return iree_ok_status();
+    }
+  }
+
+  // Warm the cache (if any) so that we measure the steady state of later
+  // processes mapping an existing image.
+  iree_elf_module_t module;
+  IREE_RETURN_IF_ERROR(iree_elf_module_initialize_from_memory_shared(
+      elf_data, /*import_table=*/NULL, shared_cache_path,
+      benchmark_state->host_allocator, &module));
+  iree_elf_module_deinitialize(&module);
+
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    IREE_RETURN_IF_ERROR(iree_elf_module_initialize_from_memory_shared(
+        elf_data, /*import_table=*/NULL, shared_cache_path,
+        benchmark_state->host_allocator, &module));
+    iree_elf_module_deinitialize(&module);
+  }
+  return iree_ok_status();
+}
+
+// Measures the private resident memory required per loaded module by keeping
+// many instances live at once as with many processes serving the same model.
+// user_data is non-NULL when loading from the shared code cache.
+static iree_status_t iree_elf_module_benchmark_rss(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_string_view_t shared_cache_path = iree_string_view_empty();
+  if (benchmark_def->user_data) {
+    shared_cache_path = iree_make_cstring_view(FLAG_shared_code_cache);
+    if (iree_string_view_is_empty(shared_cache_path)) {
+      iree_benchmark_skip(benchmark_state,
+                          "--shared_code_cache= directory not specified");
+      return iree_ok_status();
+    }
+  }
+
+  enum { MODULE_COUNT = 32 };
+  iree_elf_module_t modules[MODULE_COUNT];
+  int64_t rss_delta = 0;
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    int64_t rss_before = query_rss_anon_bytes();
+    for (int i = 0; i < MODULE_COUNT; ++i) {
+      IREE_RETURN_IF_ERROR(iree_elf_module_initialize_from_memory_shared(
+          elf_data, /*import_table=*/NULL, shared_cache_path,
+          benchmark_state->host_allocator, &modules[i]));
+    }
+    rss_delta = query_rss_anon_bytes() - rss_before;
+    for (int i = 0; i < MODULE_COUNT; ++i) {
+      iree_elf_module_deinitialize(&modules[i]);
+    }
+  }
+
+  char label[64];
+  snprintf(label, sizeof(label), "rss_anon_per_module=%" PRId64 "B",
+           rss_delta / MODULE_COUNT);
+  iree_benchmark_set_label(benchmark_state, label);
+  return iree_ok_status();
+}
+
+int main(int argc, char** argv) {
+  iree_flags_set_usage(
+      "elf_module_benchmark",
+      "Benchmarks embedded ELF module loading with and without sharing code\n"
+      "pages across processes.\n"
+      "\n"
+      "Example:\n"
+      "  elf_module_benchmark --shared_code_cache=/dev/shm/\n"
+      "\n");
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
+  iree_benchmark_initialize(&argc, argv);
+  IREE_CHECK_OK(query_elf_data(&elf_data));
+
+  iree_benchmark_def_t benchmark_def = {
+      .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+               IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+      .time_unit = IREE_BENCHMARK_UNIT_MICROSECOND,
+      .minimum_duration_ns = 0,
+      .iteration_count = 0,
+      .run = iree_elf_module_benchmark_load,
+  };
+  benchmark_def.user_data = NULL;
+  iree_benchmark_register(IREE_SV("load_private"), &benchmark_def);
+  benchmark_def.user_data = (void*)1u;
+  iree_benchmark_register(IREE_SV("load_shared"), &benchmark_def);
+
+  benchmark_def.run = iree_elf_module_benchmark_rss;
+  benchmark_def.iteration_count = 1;
+  benchmark_def.user_data = NULL;
+  iree_benchmark_register(IREE_SV("rss_private"), &benchmark_def);
+  benchmark_def.user_data = (void*)1u;
+  iree_benchmark_register(IREE_SV("rss_shared"), &benchmark_def);
+
+  iree_benchmark_run_specified();
+
+  iree_file_contents_free(elf_file_contents);
+  return 0;
+}
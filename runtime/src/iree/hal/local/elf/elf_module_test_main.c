@@ -13,6 +13,13 @@
 // ELF modules for various platforms embedded in the binary:
 #include "iree/hal/local/elf/testdata/elementwise_mul.h"
 
+#if defined(IREE_PLATFORM_LINUX)
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif  // IREE_PLATFORM_LINUX
+
 static iree_status_t query_arch_test_file_data(
     iree_const_byte_span_t* out_file_data) {
   *out_file_data = iree_make_const_byte_span(NULL, 0);
@@ -51,15 +58,16 @@ static iree_status_t query_arch_test_file_data(
                           "the application for the current target platform");
 }
 
-static iree_status_t run_test() {
+static iree_status_t run_test(iree_string_view_t shared_cache_path) {
   iree_const_byte_span_t file_data;
   IREE_RETURN_IF_ERROR(query_arch_test_file_data(&file_data));
 
   iree_elf_import_table_t import_table;
   memset(&import_table, 0, sizeof(import_table));
   iree_elf_module_t module;
-  IREE_RETURN_IF_ERROR(iree_elf_module_initialize_from_memory(
-      file_data, &import_table, iree_allocator_system(), &module));
+  IREE_RETURN_IF_ERROR(iree_elf_module_initialize_from_memory_shared(
+      file_data, &import_table, shared_cache_path, iree_allocator_system(),
+      &module));
 
   iree_hal_executable_environment_v0_t environment;
   iree_hal_executable_environment_initialize(iree_allocator_system(),
@@ -155,8 +163,45 @@ static iree_status_t run_test() {
   return status;
 }
 
+#if defined(IREE_PLATFORM_LINUX)
+// Runs the test twice with a temporary shared code cache: the first run
+// publishes the shared image and the second maps it.
+static iree_status_t run_shared_test() {
+  char cache_path[] = "/tmp/iree_elf_module_test_XXXXXX";
+  if (!mkdtemp(cache_path)) {
+    return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                            "unable to create temporary directory");
+  }
+  iree_status_t status = run_test(iree_make_cstring_view(cache_path));
+  if (iree_status_is_ok(status)) {
+    status = run_test(iree_make_cstring_view(cache_path));
+  }
+
+  // Remove all images produced by the test.
+  DIR* dir = opendir(cache_path);
+  if (dir) {
+    struct dirent* entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+      if (entry->d_name[0] == '.') continue;
+      char file_path[256];
+      snprintf(file_path, sizeof(file_path), "%s/%s", cache_path,
+               entry->d_name);
+      unlink(file_path);
+    }
+    closedir(dir);
+  }
+  rmdir(cache_path);
+  return status;
+}
+#else
+static iree_status_t run_shared_test() { return iree_ok_status(); }
+#endif  // IREE_PLATFORM_LINUX
+
 int main() {
-  const iree_status_t result = run_test();
+  iree_status_t result = run_test(iree_string_view_empty());
+  if (iree_status_is_ok(result)) {
+    result = run_shared_test();
+  }
   int ret = (int)iree_status_code(result);
   if (!iree_status_is_ok(result)) {
     iree_status_fprint(stderr, result);
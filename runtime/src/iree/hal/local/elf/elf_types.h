@@ -332,6 +332,14 @@ enum {
   IREE_ELF_DT_USED = 0x7ffffffe,          // d_val
 };
 
+enum {
+  IREE_ELF_DF_ORIGIN = 0x1,
+  IREE_ELF_DF_SYMBOLIC = 0x2,
+  IREE_ELF_DF_TEXTREL = 0x4,
+  IREE_ELF_DF_BIND_NOW = 0x8,
+  IREE_ELF_DF_STATIC_TLS = 0x10,
+};
+
 typedef struct {
   iree_elf32_sword_t d_tag;  // IREE_ELF_DT_*
   union {
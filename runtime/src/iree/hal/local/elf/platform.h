@@ -89,4 +89,57 @@ iree_status_t iree_memory_view_protect_ranges(void* base_address,
                                               const iree_byte_range_t* ranges,
                                               iree_memory_access_t new_access);
 
+//===----------------------------------------------------------------------===//
+// Shared images
+//===----------------------------------------------------------------------===//
+
+// A file-backed image of view pages that can be mapped into the views of
+// multiple processes such that they all share the same physical pages.
+// Offsets within the image match the offsets within the view it was created
+// from and pages not populated during creation are zero.
+typedef struct iree_memory_shared_image_t {
+  // Platform handle to the backing file (an fd on POSIX).
+  intptr_t handle;
+  // Total length of the image in bytes.
+  iree_host_size_t total_length;
+} iree_memory_shared_image_t;
+
+// Opens an existing shared image at |path| with exactly |total_length| bytes.
+// Returns IREE_STATUS_NOT_FOUND if no image exists and
+// IREE_STATUS_FAILED_PRECONDITION if one exists with a different length.
+//
+// Implemented by open/CreateFile. Platforms without support return
+// IREE_STATUS_UNIMPLEMENTED.
+iree_status_t iree_memory_shared_image_open(
+    const char* path, iree_host_size_t total_length,
+    iree_memory_shared_image_t* out_image);
+
+// Creates a shared image at |path| with |total_length| bytes populated from the
+// pages overlapping |ranges| of the view at |base_address|. The pages must be
+// committed and readable. The image is written to a temporary file and then
+// atomically moved into place so that concurrent openers either observe a
+// complete image or none at all.
+//
+// Implemented by open+pwrite+rename.
+iree_status_t iree_memory_shared_image_create(
+    const char* path, void* base_address, iree_host_size_t total_length,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_shared_image_t* out_image);
+
+// Closes the handle to |image|. Existing mappings of the image remain valid.
+void iree_memory_shared_image_close(iree_memory_shared_image_t* image);
+
+// Maps pages overlapping |ranges| of |image| into the view at |base_address|
+// with the given |access|, replacing any pages previously committed there.
+// |base_address| must be page aligned. Mappings are private such that writes
+// through the view are never propagated back to the image. Because the image
+// contents are trusted once mapped the file must only be writable by trusted
+// users.
+//
+// Implemented by mmap+MAP_FIXED.
+iree_status_t iree_memory_view_map_shared_image_ranges(
+    void* base_address, const iree_memory_shared_image_t* image,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_access_t access);
+
 #endif  // IREE_HAL_LOCAL_ELF_PLATFORM_H_
@@ -16,6 +16,7 @@
 #include <libkern/OSCacheControl.h>
 #include <mach/vm_statistics.h>
 #include <pthread.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <unistd.h>
 
@@ -136,4 +137,35 @@ iree_status_t iree_memory_view_protect_ranges(void* base_address,
   return status;
 }
 
+//==============================================================================
+// Shared images
+//==============================================================================
+
+iree_status_t iree_memory_shared_image_open(
+    const char* path, iree_host_size_t total_length,
+    iree_memory_shared_image_t* out_image) {
+  memset(out_image, 0, sizeof(*out_image));
+  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                          "shared images not implemented on Apple platforms");
+}
+
+iree_status_t iree_memory_shared_image_create(
+    const char* path, void* base_address, iree_host_size_t total_length,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_shared_image_t* out_image) {
+  memset(out_image, 0, sizeof(*out_image));
+  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                          "shared images not implemented on Apple platforms");
+}
+
+void iree_memory_shared_image_close(iree_memory_shared_image_t* image) {}
+
+iree_status_t iree_memory_view_map_shared_image_ranges(
+    void* base_address, const iree_memory_shared_image_t* image,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_access_t access) {
+  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                          "shared images not implemented on Apple platforms");
+}
+
 #endif  // IREE_PLATFORM_APPLE
@@ -10,6 +10,7 @@
 
 #include <malloc.h>
 #include <stdlib.h>
+#include <string.h>
 
 //==============================================================================
 // Virtual address space manipulation
@@ -49,4 +50,35 @@ iree_status_t iree_memory_view_protect_ranges(void* base_address,
   return iree_ok_status();
 }
 
+//==============================================================================
+// Shared images
+//==============================================================================
+
+iree_status_t iree_memory_shared_image_open(
+    const char* path, iree_host_size_t total_length,
+    iree_memory_shared_image_t* out_image) {
+  memset(out_image, 0, sizeof(*out_image));
+  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                          "shared images not implemented on generic platforms");
+}
+
+iree_status_t iree_memory_shared_image_create(
+    const char* path, void* base_address, iree_host_size_t total_length,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_shared_image_t* out_image) {
+  memset(out_image, 0, sizeof(*out_image));
+  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                          "shared images not implemented on generic platforms");
+}
+
+void iree_memory_shared_image_close(iree_memory_shared_image_t* image) {}
+
+iree_status_t iree_memory_view_map_shared_image_ranges(
+    void* base_address, const iree_memory_shared_image_t* image,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_access_t access) {
+  return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                          "shared images not implemented on generic platforms");
+}
+
 #endif  // IREE_PLATFORM_GENERIC
@@ -9,7 +9,11 @@
 #if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)
 
 #include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 //==============================================================================
@@ -109,4 +113,161 @@ iree_status_t iree_memory_view_protect_ranges(void* base_address,
   return status;
 }
 
+//==============================================================================
+// Shared images
+//==============================================================================
+
+iree_status_t iree_memory_shared_image_open(
+    const char* path, iree_host_size_t total_length,
+    iree_memory_shared_image_t* out_image) {
+  memset(out_image, 0, sizeof(*out_image));
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    iree_status_code_t status_code = iree_status_code_from_errno(errno);
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(status_code, "unable to open shared image '%s'",
+                            path);
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    iree_status_code_t status_code = iree_status_code_from_errno(errno);
+    close(fd);
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(status_code, "unable to stat shared image '%s'",
+                            path);
+  }
+  if ((uint64_t)file_stat.st_size != (uint64_t)total_length) {
+    close(fd);
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "shared image '%s' size mismatch; expected %" PRIhsz
+                            " bytes but file has %" PRIu64,
+                            path, total_length, (uint64_t)file_stat.st_size);
+  }
+
+  out_image->handle = (intptr_t)fd;
+  out_image->total_length = total_length;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+iree_status_t iree_memory_shared_image_create(
+    const char* path, void* base_address, iree_host_size_t total_length,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_shared_image_t* out_image) {
+  memset(out_image, 0, sizeof(*out_image));
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Write to a process-unique temporary file first so that other processes
+  // never observe a partially written image.
+  char temp_path[1024];
+  int temp_path_length = snprintf(temp_path, sizeof(temp_path), "%s.%d.tmp",
+                                  path, (int)getpid());
+  if (temp_path_length < 0 || temp_path_length >= (int)sizeof(temp_path)) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "shared image path too long");
+  }
+  int fd = open(temp_path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd == -1) {
+    iree_status_code_t status_code = iree_status_code_from_errno(errno);
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(status_code,
+                            "unable to create shared image '%s'", temp_path);
+  }
+
+  iree_status_t status = iree_ok_status();
+  if (ftruncate(fd, (off_t)total_length) != 0) {
+    status = iree_make_status(iree_status_code_from_errno(errno),
+                              "unable to resize shared image");
+  }
+
+  // Write the whole pages overlapping each range. Pages outside of any range
+  // are left as holes and read back as zeros.
+  const iree_host_size_t page_size = getpagesize();
+  for (iree_host_size_t i = 0; i < range_count && iree_status_is_ok(status);
+       ++i) {
+    void* range_start = NULL;
+    iree_host_size_t aligned_length = 0;
+    iree_page_align_range(base_address, ranges[i], page_size, &range_start,
+                          &aligned_length);
+    const uint8_t* src = (const uint8_t*)range_start;
+    off_t offset = (off_t)((uint8_t*)range_start - (uint8_t*)base_address);
+    while (aligned_length > 0) {
+      ssize_t written = pwrite(fd, src, aligned_length, offset);
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        status = iree_make_status(iree_status_code_from_errno(errno),
+                                  "unable to write shared image");
+        break;
+      }
+      src += written;
+      offset += written;
+      aligned_length -= (iree_host_size_t)written;
+    }
+  }
+
+  // Publish the image. If another process raced us here then its identical
+  // image is replaced and any existing mappings of it remain valid.
+  if (iree_status_is_ok(status) && rename(temp_path, path) != 0) {
+    status = iree_make_status(iree_status_code_from_errno(errno),
+                              "unable to publish shared image '%s'", path);
+  }
+
+  if (iree_status_is_ok(status)) {
+    out_image->handle = (intptr_t)fd;
+    out_image->total_length = total_length;
+  } else {
+    close(fd);
+    unlink(temp_path);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+void iree_memory_shared_image_close(iree_memory_shared_image_t* image) {
+  if (image->total_length > 0) {
+    close((int)image->handle);
+  }
+  memset(image, 0, sizeof(*image));
+}
+
+iree_status_t iree_memory_view_map_shared_image_ranges(
+    void* base_address, const iree_memory_shared_image_t* image,
+    iree_host_size_t range_count, const iree_byte_range_t* ranges,
+    iree_memory_access_t access) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  int mmap_prot = iree_memory_access_to_prot(access);
+  int mmap_flags = MAP_PRIVATE | MAP_FIXED;
+
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < range_count; ++i) {
+    void* range_start = NULL;
+    iree_host_size_t aligned_length = 0;
+    iree_page_align_range(base_address, ranges[i], getpagesize(), &range_start,
+                          &aligned_length);
+    iree_host_size_t offset =
+        (iree_host_size_t)((uint8_t*)range_start - (uint8_t*)base_address);
+    if (offset + aligned_length > image->total_length) {
+      status = iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                                "shared image range out of bounds");
+      break;
+    }
+    void* result = mmap(range_start, aligned_length, mmap_prot, mmap_flags,
+                        (int)image->handle, (off_t)offset);
+    if (result == MAP_FAILED) {
+      status = iree_make_status(iree_status_code_from_errno(errno),
+                                "mmap of shared image failed");
+      break;
+    }
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 #endif  // IREE_PLATFORM_*
@@ -379,6 +379,23 @@ typedef int (*iree_hal_executable_dispatch_v0_t)(
 // Maximum number of bindings that can be used by a single dispatch.
 #define IREE_HAL_EXECUTABLE_MAX_BINDING_COUNT 64
 
+// Preferred order in which the workgroups of a dispatch are traversed.
+// Executors that process workgroups concurrently use this to improve the reuse
+// of operand data shared between workgroups that run close together in time.
+// Only the x and y dimensions are reordered; z is always the slowest varying.
+typedef enum iree_hal_executable_workgroup_order_e {
+  // Linear xyz order with x varying fastest.
+  IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_ROW_MAJOR = 0,
+  // y varies fastest followed by x.
+  IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_COLUMN_MAJOR = 1,
+  // Morton (Z-order) curve over x and y.
+  IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_MORTON = 2,
+  // Bands of a few consecutive y rows traversed column-major such that
+  // workgroups along x reuse the same y operand rows (grouped-M swizzling
+  // when y indexes the M dimension of a matmul).
+  IREE_HAL_EXECUTABLE_WORKGROUP_ORDER_GROUPED = 3,
+} iree_hal_executable_workgroup_order_t;
+
 // Attributes for exported dispatch functions defining how they are to be
 // executed. 0 defaults are well-specified and the entire attributes table may
 // be omitted if no dispatch functions require these fields.
@@ -392,8 +409,11 @@ typedef struct iree_hal_executable_dispatch_attrs_v0_t {
   uint8_t constant_count;
   // Total number of bindings used by the dispatch.
   uint8_t binding_count;
+  // Preferred workgroup traversal order as an
+  // iree_hal_executable_workgroup_order_t. Executors may ignore the hint.
+  uint8_t workgroup_order;
   // Unused to pad the structure. Must be 0.
-  uint32_t reserved_0;
+  uint8_t reserved_0[3];
   // Unused. Must be 0.
   uint64_t reserved_1[8];
 } iree_hal_executable_dispatch_attrs_v0_t;
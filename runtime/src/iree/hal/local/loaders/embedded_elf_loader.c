@@ -85,7 +85,8 @@ static iree_status_t iree_hal_elf_executable_query_library(
 static iree_status_t iree_hal_elf_executable_create(
     const iree_hal_executable_params_t* executable_params,
     const iree_hal_executable_import_provider_t import_provider,
-    iree_allocator_t host_allocator, iree_hal_executable_t** out_executable) {
+    iree_string_view_t shared_code_cache_path, iree_allocator_t host_allocator,
+    iree_hal_executable_t** out_executable) {
   IREE_ASSERT_ARGUMENT(executable_params);
   IREE_ASSERT_ARGUMENT(executable_params->executable_data.data &&
                        executable_params->executable_data.data_length);
@@ -121,9 +122,9 @@ static iree_status_t iree_hal_elf_executable_create(
 
   // Attempt to load the ELF module.
   if (iree_status_is_ok(status)) {
-    status = iree_elf_module_initialize_from_memory(
+    status = iree_elf_module_initialize_from_memory_shared(
         executable_params->executable_data, /*import_table=*/NULL,
-        host_allocator, &executable->module);
+        shared_code_cache_path, host_allocator, &executable->module);
   }
 
   // Query metadata and get the entry point function pointers.
@@ -228,6 +229,9 @@ typedef struct iree_hal_embedded_elf_loader_t {
   iree_hal_executable_loader_t base;
   iree_allocator_t host_allocator;
   iree_hal_executable_plugin_manager_t* plugin_manager;
+  // Directory of shared code images or empty to load all executables privately.
+  // Stored inline after the loader struct.
+  iree_string_view_t shared_code_cache_path;
 } iree_hal_embedded_elf_loader_t;
 
 static const iree_hal_executable_loader_vtable_t
@@ -237,13 +241,24 @@ iree_status_t iree_hal_embedded_elf_loader_create(
     iree_hal_executable_plugin_manager_t* plugin_manager,
     iree_allocator_t host_allocator,
     iree_hal_executable_loader_t** out_executable_loader) {
+  return iree_hal_embedded_elf_loader_create_shared(
+      plugin_manager, iree_string_view_empty(), host_allocator,
+      out_executable_loader);
+}
+
+iree_status_t iree_hal_embedded_elf_loader_create_shared(
+    iree_hal_executable_plugin_manager_t* plugin_manager,
+    iree_string_view_t shared_code_cache_path, iree_allocator_t host_allocator,
+    iree_hal_executable_loader_t** out_executable_loader) {
   IREE_ASSERT_ARGUMENT(out_executable_loader);
   *out_executable_loader = NULL;
   IREE_TRACE_ZONE_BEGIN(z0);
 
   iree_hal_embedded_elf_loader_t* executable_loader = NULL;
-  iree_status_t status = iree_allocator_malloc(
-      host_allocator, sizeof(*executable_loader), (void**)&executable_loader);
+  iree_host_size_t total_size =
+      sizeof(*executable_loader) + shared_code_cache_path.size;
+  iree_status_t status = iree_allocator_malloc(host_allocator, total_size,
+                                               (void**)&executable_loader);
   if (iree_status_is_ok(status)) {
     iree_hal_executable_loader_initialize(
         &iree_hal_embedded_elf_loader_vtable,
@@ -253,6 +268,11 @@ iree_status_t iree_hal_embedded_elf_loader_create(
     executable_loader->plugin_manager = plugin_manager;
     iree_hal_executable_plugin_manager_retain(
         executable_loader->plugin_manager);
+    char* path_storage = (char*)executable_loader + sizeof(*executable_loader);
+    memcpy(path_storage, shared_code_cache_path.data,
+           shared_code_cache_path.size);
+    executable_loader->shared_code_cache_path =
+        iree_make_string_view(path_storage, shared_code_cache_path.size);
     *out_executable_loader = (iree_hal_executable_loader_t*)executable_loader;
   }
 
@@ -292,6 +312,7 @@ static iree_status_t iree_hal_embedded_elf_loader_try_load(
   // Perform the load of the ELF and wrap it in an executable handle.
   iree_status_t status = iree_hal_elf_executable_create(
       executable_params, base_executable_loader->import_provider,
+      executable_loader->shared_code_cache_path,
       executable_loader->host_allocator, out_executable);
 
   IREE_TRACE_ZONE_END(z0);
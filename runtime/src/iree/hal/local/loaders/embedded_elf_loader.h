@@ -29,6 +29,16 @@ iree_status_t iree_hal_embedded_elf_loader_create(
     iree_allocator_t host_allocator,
     iree_hal_executable_loader_t** out_executable_loader);
 
+// Creates an embedded ELF executable loader that shares the read-only code and
+// data pages of loaded executables with other processes by mapping them from
+// images in the |shared_code_cache_path| directory. Executables that cannot be
+// shared are loaded privately as with iree_hal_embedded_elf_loader_create.
+// See iree_elf_module_initialize_from_memory_shared for details.
+iree_status_t iree_hal_embedded_elf_loader_create_shared(
+    iree_hal_executable_plugin_manager_t* plugin_manager,
+    iree_string_view_t shared_code_cache_path, iree_allocator_t host_allocator,
+    iree_hal_executable_loader_t** out_executable_loader);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -6,6 +6,8 @@
 
 #include "iree/hal/local/loaders/registration/init.h"
 
+#include "iree/base/internal/flags.h"
+
 // NOTE: we register in a specific order to allow for prioritization:
 // - system-library: used when embedded is not desired (TSAN/debugging/etc).
 // - embedded-elf: default codegen portable ELF output format.
@@ -23,6 +25,17 @@
 #include "iree/hal/local/loaders/vmvx_module_loader.h"
 #endif  // IREE_HAVE_HAL_EXECUTABLE_LOADER_VMVX_MODULE
 
+#if defined(IREE_HAVE_HAL_EXECUTABLE_LOADER_EMBEDDED_ELF)
+IREE_FLAG(
+    string, embedded_elf_shared_code_cache, "",
+    "Directory used to share the read-only code pages of embedded ELF\n"
+    "executables across processes. The first process to load an executable\n"
+    "publishes an image of its code and later processes map it instead of\n"
+    "keeping a private copy. Use a memory-backed file system such as\n"
+    "/dev/shm/ to avoid disk I/O. The directory must only be writable by\n"
+    "trusted users.");
+#endif  // IREE_HAVE_HAL_EXECUTABLE_LOADER_EMBEDDED_ELF
+
 IREE_API_EXPORT iree_status_t iree_hal_create_all_available_executable_loaders(
     iree_hal_executable_plugin_manager_t* plugin_manager,
     iree_host_size_t capacity, iree_host_size_t* out_count,
@@ -59,8 +72,10 @@ IREE_API_EXPORT iree_status_t iree_hal_create_all_available_executable_loaders(
 
 #if defined(IREE_HAVE_HAL_EXECUTABLE_LOADER_EMBEDDED_ELF)
   if (iree_status_is_ok(status)) {
-    status = iree_hal_embedded_elf_loader_create(plugin_manager, host_allocator,
-                                                 &loaders[count++]);
+    status = iree_hal_embedded_elf_loader_create_shared(
+        plugin_manager,
+        iree_make_cstring_view(FLAG_embedded_elf_shared_code_cache),
+        host_allocator, &loaders[count++]);
   }
 #endif  // IREE_HAVE_HAL_EXECUTABLE_LOADER_EMBEDDED_ELF
 
@@ -89,8 +104,10 @@ IREE_API_EXPORT iree_status_t iree_hal_create_executable_loader_by_name(
     iree_hal_executable_loader_t** out_executable_loader) {
 #if defined(IREE_HAVE_HAL_EXECUTABLE_LOADER_EMBEDDED_ELF)
   if (iree_string_view_starts_with(name, IREE_SV("embedded-elf"))) {
-    return iree_hal_embedded_elf_loader_create(plugin_manager, host_allocator,
-                                               out_executable_loader);
+    return iree_hal_embedded_elf_loader_create_shared(
+        plugin_manager,
+        iree_make_cstring_view(FLAG_embedded_elf_shared_code_cache),
+        host_allocator, out_executable_loader);
   }
 #endif  // IREE_HAVE_HAL_EXECUTABLE_LOADER_EMBEDDED_ELF
 
@@ -31,6 +31,22 @@ iree_hal_local_executable_t* iree_hal_local_executable_cast(
   return (iree_hal_local_executable_t*)base_value;
 }
 
+iree_status_t iree_hal_local_executable_resolve(
+    iree_hal_executable_t* base_value,
+    iree_hal_local_executable_t** out_executable) {
+  IREE_ASSERT_ARGUMENT(base_value);
+  IREE_ASSERT_ARGUMENT(out_executable);
+  iree_hal_local_executable_t* executable =
+      iree_hal_local_executable_cast(base_value);
+  const iree_hal_local_executable_vtable_t* vtable =
+      (const iree_hal_local_executable_vtable_t*)executable->resource.vtable;
+  if (IREE_LIKELY(!vtable->resolve)) {
+    *out_executable = executable;
+    return iree_ok_status();
+  }
+  return vtable->resolve(executable, out_executable);
+}
+
 iree_status_t iree_hal_local_executable_issue_call(
     iree_hal_local_executable_t* executable, iree_host_size_t ordinal,
     const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
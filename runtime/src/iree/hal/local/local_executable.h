@@ -37,6 +37,15 @@ typedef struct iree_hal_local_executable_vtable_t {
       const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
       const iree_hal_executable_workgroup_state_v0_t* workgroup_state,
       uint32_t worker_id);
+
+  // Optional. Resolves the executable that should be used when recording
+  // dispatches. Implementations that defer loading (such as those produced by
+  // an executable cache in lazy or async mode) block until loading completes
+  // and return the underlying loaded executable. The returned executable is
+  // kept live by |executable| and is not retained.
+  iree_status_t(IREE_API_PTR* resolve)(
+      iree_hal_local_executable_t* executable,
+      iree_hal_local_executable_t** out_executable);
 } iree_hal_local_executable_vtable_t;
 
 // Initializes the local executable base type.
@@ -51,6 +60,14 @@ void iree_hal_local_executable_deinitialize(
 iree_hal_local_executable_t* iree_hal_local_executable_cast(
     iree_hal_executable_t* base_value);
 
+// Resolves |base_value| to the loaded local executable used when recording
+// dispatches. Most executables resolve to themselves but deferred executables
+// may first need to finish loading. The returned pointer is borrowed and only
+// valid for as long as |base_value| is retained.
+iree_status_t iree_hal_local_executable_resolve(
+    iree_hal_executable_t* base_value,
+    iree_hal_local_executable_t** out_executable);
+
 iree_status_t iree_hal_local_executable_issue_call(
     iree_hal_local_executable_t* executable, iree_host_size_t ordinal,
     const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
@@ -8,12 +8,43 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/hal/local/local_executable.h"
+
+iree_status_t iree_hal_local_executable_load_mode_parse(
+    iree_string_view_t value,
+    iree_hal_local_executable_load_mode_t* out_load_mode) {
+  IREE_ASSERT_ARGUMENT(out_load_mode);
+  if (iree_string_view_is_empty(value) ||
+      iree_string_view_equal(value, IREE_SV("immediate"))) {
+    *out_load_mode = IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_IMMEDIATE;
+  } else if (iree_string_view_equal(value, IREE_SV("async"))) {
+    *out_load_mode = IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC;
+  } else if (iree_string_view_equal(value, IREE_SV("lazy"))) {
+    *out_load_mode = IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_LAZY;
+  } else {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "unknown executable load mode '%.*s'; expected "
+                            "one of `immediate`, `async`, or `lazy`",
+                            (int)value.size, value.data);
+  }
+  return iree_ok_status();
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_executable_cache_t
+//===----------------------------------------------------------------------===//
 
 typedef struct iree_hal_local_executable_cache_t {
   iree_hal_resource_t resource;
   iree_allocator_t host_allocator;
   iree_string_view_t identifier;
   iree_host_size_t worker_capacity;
+  iree_hal_local_executable_load_mode_t load_mode;
+  iree_hal_local_executable_scheduler_t scheduler;
   iree_host_size_t loader_count;
   iree_hal_executable_loader_t* loaders[];
 } iree_hal_local_executable_cache_t;
@@ -32,6 +63,20 @@ iree_status_t iree_hal_local_executable_cache_create(
     iree_host_size_t loader_count, iree_hal_executable_loader_t** loaders,
     iree_allocator_t host_allocator,
     iree_hal_executable_cache_t** out_executable_cache) {
+  iree_hal_local_executable_scheduler_t scheduler = {0};
+  return iree_hal_local_executable_cache_create_with_mode(
+      identifier, worker_capacity, loader_count, loaders,
+      IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_IMMEDIATE, scheduler, host_allocator,
+      out_executable_cache);
+}
+
+iree_status_t iree_hal_local_executable_cache_create_with_mode(
+    iree_string_view_t identifier, iree_host_size_t worker_capacity,
+    iree_host_size_t loader_count, iree_hal_executable_loader_t** loaders,
+    iree_hal_local_executable_load_mode_t load_mode,
+    iree_hal_local_executable_scheduler_t scheduler,
+    iree_allocator_t host_allocator,
+    iree_hal_executable_cache_t** out_executable_cache) {
   IREE_ASSERT_ARGUMENT(!loader_count || loaders);
   IREE_ASSERT_ARGUMENT(out_executable_cache);
   *out_executable_cache = NULL;
@@ -53,6 +98,15 @@ iree_status_t iree_hal_local_executable_cache_create(
         (char*)executable_cache + total_size - identifier.size);
     executable_cache->worker_capacity = worker_capacity;
 
+    // Async loading requires a scheduler; without one we fall back to loading
+    // on first use so that the cost is still deferred off of preparation.
+    if (load_mode == IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC &&
+        !scheduler.schedule) {
+      load_mode = IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_LAZY;
+    }
+    executable_cache->load_mode = load_mode;
+    executable_cache->scheduler = scheduler;
+
     executable_cache->loader_count = loader_count;
     for (iree_host_size_t i = 0; i < executable_cache->loader_count; ++i) {
       executable_cache->loaders[i] = loaders[i];
@@ -96,12 +150,11 @@ static bool iree_hal_local_executable_cache_can_prepare_format(
   return false;
 }
 
-static iree_status_t iree_hal_local_executable_cache_prepare_executable(
-    iree_hal_executable_cache_t* base_executable_cache,
+// Loads an executable synchronously using the first loader that accepts it.
+static iree_status_t iree_hal_local_executable_cache_load(
+    iree_hal_local_executable_cache_t* executable_cache,
     const iree_hal_executable_params_t* executable_params,
     iree_hal_executable_t** out_executable) {
-  iree_hal_local_executable_cache_t* executable_cache =
-      iree_hal_local_executable_cache_cast(base_executable_cache);
   for (iree_host_size_t i = 0; i < executable_cache->loader_count; ++i) {
     if (!iree_hal_executable_loader_query_support(
             executable_cache->loaders[i], executable_params->caching_mode,
@@ -131,6 +184,245 @@ static iree_status_t iree_hal_local_executable_cache_prepare_executable(
       executable_params->executable_format.data);
 }
 
+//===----------------------------------------------------------------------===//
+// iree_hal_local_deferred_executable_t
+//===----------------------------------------------------------------------===//
+
+// An executable whose load is deferred until first use or performed
+// asynchronously by the cache scheduler. Commands recording dispatches resolve
+// the underlying loaded executable and never see this wrapper.
+typedef struct iree_hal_local_deferred_executable_t {
+  iree_hal_local_executable_t base;
+
+  // Cache used to load the executable; retained so that its loaders remain
+  // live until the load has completed.
+  iree_hal_local_executable_cache_t* executable_cache;
+
+  // Parameters used to load the executable. Any caller-owned memory has been
+  // copied into the executable unless the caller allowed aliasing.
+  iree_hal_executable_params_t params;
+  // Copy of the executable data when not aliasing the caller memory. Dropped
+  // as soon as the load completes as loaders copy what they need to retain.
+  void* data_storage;
+
+  // Guards the load so that only one thread performs it while others wait.
+  iree_slim_mutex_t mutex;
+  // Set to 1 once |status| and |target| are final.
+  iree_atomic_int32_t is_resolved;
+  // Status of the load. Cloned and returned to each resolve when failed.
+  iree_status_t status;
+  // Loaded executable or NULL if the load failed.
+  iree_hal_local_executable_t* target;
+} iree_hal_local_deferred_executable_t;
+
+static const iree_hal_local_executable_vtable_t
+    iree_hal_local_deferred_executable_vtable;
+
+static iree_hal_local_deferred_executable_t*
+iree_hal_local_deferred_executable_cast(
+    iree_hal_local_executable_t* base_value) {
+  IREE_HAL_ASSERT_TYPE(base_value, &iree_hal_local_deferred_executable_vtable);
+  return (iree_hal_local_deferred_executable_t*)base_value;
+}
+
+static void iree_hal_local_deferred_executable_load_async(void* user_data);
+
+static iree_status_t iree_hal_local_deferred_executable_create(
+    iree_hal_local_executable_cache_t* executable_cache,
+    const iree_hal_executable_params_t* executable_params,
+    iree_hal_executable_t** out_executable) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_allocator_t host_allocator = executable_cache->host_allocator;
+
+  const bool alias_data = iree_all_bits_set(
+      executable_params->caching_mode,
+      IREE_HAL_EXECUTABLE_CACHING_MODE_ALIAS_PROVIDED_DATA);
+
+  // Constants and the format string are small and stored inline.
+  iree_hal_local_deferred_executable_t* executable = NULL;
+  const iree_host_size_t constants_size =
+      executable_params->constant_count * sizeof(*executable_params->constants);
+  const iree_host_size_t total_size =
+      iree_host_align(sizeof(*executable), iree_alignof(uint32_t)) +
+      constants_size + executable_params->executable_format.size;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, total_size,
+                                (void**)&executable));
+  memset(executable, 0, total_size);
+  iree_hal_local_executable_initialize(
+      &iree_hal_local_deferred_executable_vtable, host_allocator,
+      &executable->base);
+  executable->executable_cache = executable_cache;
+  iree_hal_executable_cache_retain(
+      (iree_hal_executable_cache_t*)executable_cache);
+  iree_slim_mutex_initialize(&executable->mutex);
+  iree_atomic_store(&executable->is_resolved, 0, iree_memory_order_relaxed);
+
+  executable->params = *executable_params;
+  uint8_t* storage_ptr = (uint8_t*)executable +
+                         iree_host_align(sizeof(*executable),
+                                         iree_alignof(uint32_t));
+  if (constants_size > 0) {
+    memcpy(storage_ptr, executable_params->constants, constants_size);
+    executable->params.constants = (const uint32_t*)storage_ptr;
+    storage_ptr += constants_size;
+  }
+  iree_string_view_append_to_buffer(executable_params->executable_format,
+                                    &executable->params.executable_format,
+                                    (char*)storage_ptr);
+
+  iree_status_t status = iree_ok_status();
+  if (!alias_data && executable_params->executable_data.data_length > 0) {
+    status = iree_allocator_malloc(
+        host_allocator, executable_params->executable_data.data_length,
+        &executable->data_storage);
+    if (iree_status_is_ok(status)) {
+      memcpy(executable->data_storage,
+             executable_params->executable_data.data,
+             executable_params->executable_data.data_length);
+      executable->params.executable_data = iree_make_const_byte_span(
+          executable->data_storage,
+          executable_params->executable_data.data_length);
+    }
+  }
+
+  // Issue the load; the pending load retains the executable until it
+  // completes so that the executable can be released while loading.
+  const bool load_async =
+      executable_cache->load_mode == IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC;
+  if (iree_status_is_ok(status) && load_async) {
+    iree_hal_executable_retain((iree_hal_executable_t*)executable);
+    status = executable_cache->scheduler.schedule(
+        executable_cache->scheduler.self,
+        iree_hal_local_deferred_executable_load_async, executable);
+    if (!iree_status_is_ok(status)) {
+      iree_hal_executable_release((iree_hal_executable_t*)executable);
+    }
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_executable = (iree_hal_executable_t*)executable;
+  } else {
+    iree_hal_executable_release((iree_hal_executable_t*)executable);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static void iree_hal_local_deferred_executable_destroy(
+    iree_hal_executable_t* base_executable) {
+  iree_hal_local_deferred_executable_t* executable =
+      iree_hal_local_deferred_executable_cast(
+          (iree_hal_local_executable_t*)base_executable);
+  iree_allocator_t host_allocator = executable->base.host_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_executable_release((iree_hal_executable_t*)executable->target);
+  iree_status_ignore(executable->status);
+  iree_allocator_free(host_allocator, executable->data_storage);
+  iree_slim_mutex_deinitialize(&executable->mutex);
+  iree_hal_executable_cache_release(
+      (iree_hal_executable_cache_t*)executable->executable_cache);
+
+  iree_hal_local_executable_deinitialize(
+      (iree_hal_local_executable_t*)base_executable);
+  iree_allocator_free(host_allocator, executable);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+// Loads the executable if it has not yet been loaded. Blocks if another thread
+// is currently loading it.
+static void iree_hal_local_deferred_executable_load(
+    iree_hal_local_deferred_executable_t* executable) {
+  iree_slim_mutex_lock(&executable->mutex);
+  if (!iree_atomic_load(&executable->is_resolved, iree_memory_order_relaxed)) {
+    IREE_TRACE_ZONE_BEGIN(z0);
+    iree_hal_executable_t* target = NULL;
+    executable->status = iree_hal_local_executable_cache_load(
+        executable->executable_cache, &executable->params, &target);
+    executable->target = target ? iree_hal_local_executable_cast(target) : NULL;
+    iree_allocator_free(executable->base.host_allocator,
+                        executable->data_storage);
+    executable->data_storage = NULL;
+    executable->params.executable_data = iree_const_byte_span_empty();
+    iree_atomic_store(&executable->is_resolved, 1, iree_memory_order_release);
+    IREE_TRACE_ZONE_END(z0);
+  }
+  iree_slim_mutex_unlock(&executable->mutex);
+}
+
+static void iree_hal_local_deferred_executable_load_async(void* user_data) {
+  iree_hal_local_deferred_executable_t* executable =
+      (iree_hal_local_deferred_executable_t*)user_data;
+  iree_hal_local_deferred_executable_load(executable);
+  iree_hal_executable_release((iree_hal_executable_t*)executable);
+}
+
+static iree_status_t iree_hal_local_deferred_executable_resolve(
+    iree_hal_local_executable_t* base_executable,
+    iree_hal_local_executable_t** out_executable) {
+  iree_hal_local_deferred_executable_t* executable =
+      iree_hal_local_deferred_executable_cast(base_executable);
+  *out_executable = NULL;
+  if (IREE_UNLIKELY(!iree_atomic_load(&executable->is_resolved,
+                                      iree_memory_order_acquire))) {
+    iree_hal_local_deferred_executable_load(executable);
+  }
+  if (IREE_UNLIKELY(!iree_status_is_ok(executable->status))) {
+    return iree_status_clone(executable->status);
+  }
+  *out_executable = executable->target;
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_local_deferred_executable_issue_call(
+    iree_hal_local_executable_t* base_executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
+    const iree_hal_executable_workgroup_state_v0_t* workgroup_state,
+    uint32_t worker_id) {
+  iree_hal_local_executable_t* target = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_local_deferred_executable_resolve(base_executable, &target));
+  return iree_hal_local_executable_issue_call(
+      target, ordinal, dispatch_state, workgroup_state, worker_id);
+}
+
+static const iree_hal_local_executable_vtable_t
+    iree_hal_local_deferred_executable_vtable = {
+        .base =
+            {
+                .destroy = iree_hal_local_deferred_executable_destroy,
+            },
+        .issue_call = iree_hal_local_deferred_executable_issue_call,
+        .resolve = iree_hal_local_deferred_executable_resolve,
+};
+
+//===----------------------------------------------------------------------===//
+// iree_hal_executable_cache_t
+//===----------------------------------------------------------------------===//
+
+static iree_status_t iree_hal_local_executable_cache_prepare_executable(
+    iree_hal_executable_cache_t* base_executable_cache,
+    const iree_hal_executable_params_t* executable_params,
+    iree_hal_executable_t** out_executable) {
+  iree_hal_local_executable_cache_t* executable_cache =
+      iree_hal_local_executable_cache_cast(base_executable_cache);
+  if (executable_cache->load_mode ==
+          IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_IMMEDIATE ||
+      !iree_hal_query_any_executable_loader_support(
+          executable_cache->loader_count, executable_cache->loaders,
+          executable_params->caching_mode,
+          executable_params->executable_format)) {
+    // Unsupported formats take the immediate path so that the failure is
+    // reported from preparation instead of the first dispatch.
+    return iree_hal_local_executable_cache_load(
+        executable_cache, executable_params, out_executable);
+  }
+  return iree_hal_local_deferred_executable_create(
+      executable_cache, executable_params, out_executable);
+}
+
 static const iree_hal_executable_cache_vtable_t
     iree_hal_local_executable_cache_vtable = {
         .destroy = iree_hal_local_executable_cache_destroy,
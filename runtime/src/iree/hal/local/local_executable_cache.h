@@ -23,12 +23,59 @@ extern "C" {
 // one device is the same JIT'ed executable in another, and in multi-tenant
 // situations we're likely to want that isolation _and_ sharing.
 
+// Controls when executables prepared by the cache are loaded.
+typedef enum iree_hal_local_executable_load_mode_e {
+  // Executables are loaded on the calling thread before
+  // iree_hal_executable_cache_prepare_executable returns.
+  IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_IMMEDIATE = 0,
+  // Executables are loaded asynchronously using the cache scheduler and
+  // preparation returns immediately. Programs that prepare many executables
+  // during initialization have them loaded concurrently. The first dispatch
+  // recorded with an executable waits for its load to complete (or performs
+  // the load itself if it has not yet started).
+  IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC,
+  // Executables are loaded on first use when a dispatch is recorded. Programs
+  // that only use a subset of their executables avoid the cost of loading the
+  // others entirely.
+  IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_LAZY,
+} iree_hal_local_executable_load_mode_t;
+
+// Parses a load mode from a string such as `immediate`, `async`, or `lazy`.
+iree_status_t iree_hal_local_executable_load_mode_parse(
+    iree_string_view_t value,
+    iree_hal_local_executable_load_mode_t* out_load_mode);
+
+typedef void(IREE_API_PTR* iree_hal_local_executable_load_fn_t)(
+    void* user_data);
+
+// Schedules |fn| to be called with |user_data| at some point in the future on
+// any thread. Scheduling failures must not call |fn|.
+typedef struct iree_hal_local_executable_scheduler_t {
+  void* self;
+  iree_status_t(IREE_API_PTR* schedule)(void* self,
+                                        iree_hal_local_executable_load_fn_t fn,
+                                        void* user_data);
+} iree_hal_local_executable_scheduler_t;
+
+// Creates an executable cache that loads executables immediately.
 iree_status_t iree_hal_local_executable_cache_create(
     iree_string_view_t identifier, iree_host_size_t worker_capacity,
     iree_host_size_t loader_count, iree_hal_executable_loader_t** loaders,
     iree_allocator_t host_allocator,
     iree_hal_executable_cache_t** out_executable_cache);
 
+// Creates an executable cache that loads executables based on |load_mode|.
+// |scheduler| is used to issue loads in the async mode and must remain valid
+// for the lifetime of the cache and all executables prepared from it. If no
+// scheduler is provided async loads behave as lazy.
+iree_status_t iree_hal_local_executable_cache_create_with_mode(
+    iree_string_view_t identifier, iree_host_size_t worker_capacity,
+    iree_host_size_t loader_count, iree_hal_executable_loader_t** loaders,
+    iree_hal_local_executable_load_mode_t load_mode,
+    iree_hal_local_executable_scheduler_t scheduler,
+    iree_allocator_t host_allocator,
+    iree_hal_executable_cache_t** out_executable_cache);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
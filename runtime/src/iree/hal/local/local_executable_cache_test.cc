@@ -0,0 +1,401 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/local_executable_cache.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/hal/local/executable_loader.h"
+#include "iree/hal/local/local_executable.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+using iree::Status;
+using iree::StatusCode;
+using iree::testing::status::StatusIs;
+
+constexpr iree_string_view_t kTestFormat = IREE_SVL("test-format");
+
+//===----------------------------------------------------------------------===//
+// TestLoader
+//===----------------------------------------------------------------------===//
+
+// Loader state shared with the tests. Loads can be held at a gate to observe
+// executables while their load is in flight.
+struct TestLoaderState {
+  // Status code returned from loads; OK produces a TestExecutable.
+  iree_status_code_t load_status_code = IREE_STATUS_OK;
+  // Total number of loads performed.
+  std::atomic<int> load_count{0};
+  // Number of TestExecutables that have not yet been destroyed.
+  std::atomic<int> live_executable_count{0};
+  // Number of calls issued to TestExecutables.
+  std::atomic<int> issue_call_count{0};
+  // Copy of the executable data passed to the last load.
+  std::vector<uint8_t> last_load_data;
+
+  // Loads block until the gate is opened.
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool gate_open = true;
+
+  void CloseGate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    gate_open = false;
+  }
+  void OpenGate() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      gate_open = true;
+    }
+    cond.notify_all();
+  }
+};
+
+struct TestExecutable {
+  iree_hal_local_executable_t base;
+  TestLoaderState* state;
+};
+
+static void TestExecutableDestroy(iree_hal_executable_t* base_executable) {
+  TestExecutable* executable = (TestExecutable*)base_executable;
+  iree_allocator_t host_allocator = executable->base.host_allocator;
+  --executable->state->live_executable_count;
+  iree_hal_local_executable_deinitialize(&executable->base);
+  iree_allocator_free(host_allocator, executable);
+}
+
+static iree_status_t TestExecutableIssueCall(
+    iree_hal_local_executable_t* base_executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
+    const iree_hal_executable_workgroup_state_v0_t* workgroup_state,
+    uint32_t worker_id) {
+  TestExecutable* executable = (TestExecutable*)base_executable;
+  ++executable->state->issue_call_count;
+  return iree_ok_status();
+}
+
+static const iree_hal_local_executable_vtable_t kTestExecutableVtable = {
+    /*.base=*/{
+        /*.destroy=*/TestExecutableDestroy,
+    },
+    /*.issue_call=*/TestExecutableIssueCall,
+    /*.resolve=*/NULL,
+};
+
+struct TestLoader {
+  iree_hal_executable_loader_t base;
+  TestLoaderState* state;
+};
+
+static void TestLoaderDestroy(iree_hal_executable_loader_t* base_loader) {
+  iree_allocator_free(iree_allocator_system(), base_loader);
+}
+
+static bool TestLoaderQuerySupport(
+    iree_hal_executable_loader_t* base_loader,
+    iree_hal_executable_caching_mode_t caching_mode,
+    iree_string_view_t executable_format) {
+  return iree_string_view_equal(executable_format, kTestFormat);
+}
+
+static iree_status_t TestLoaderTryLoad(
+    iree_hal_executable_loader_t* base_loader,
+    const iree_hal_executable_params_t* executable_params,
+    iree_host_size_t worker_capacity, iree_hal_executable_t** out_executable) {
+  TestLoaderState* state = ((TestLoader*)base_loader)->state;
+  ++state->load_count;
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cond.wait(lock, [state] { return state->gate_open; });
+  }
+  state->last_load_data.assign(
+      executable_params->executable_data.data,
+      executable_params->executable_data.data +
+          executable_params->executable_data.data_length);
+  if (state->load_status_code != IREE_STATUS_OK) {
+    return iree_make_status(state->load_status_code, "test load failure");
+  }
+  TestExecutable* executable = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      iree_allocator_system(), sizeof(*executable), (void**)&executable));
+  iree_hal_local_executable_initialize(
+      &kTestExecutableVtable, iree_allocator_system(), &executable->base);
+  executable->state = state;
+  ++state->live_executable_count;
+  *out_executable = (iree_hal_executable_t*)executable;
+  return iree_ok_status();
+}
+
+static const iree_hal_executable_loader_vtable_t kTestLoaderVtable = {
+    /*.destroy=*/TestLoaderDestroy,
+    /*.query_support=*/TestLoaderQuerySupport,
+    /*.try_load=*/TestLoaderTryLoad,
+};
+
+//===----------------------------------------------------------------------===//
+// TestScheduler
+//===----------------------------------------------------------------------===//
+
+// Holds scheduled loads until the test runs them.
+struct TestScheduler {
+  iree_status_code_t schedule_status_code = IREE_STATUS_OK;
+  std::vector<std::pair<iree_hal_local_executable_load_fn_t, void*>> pending;
+
+  static iree_status_t Schedule(void* self,
+                                iree_hal_local_executable_load_fn_t fn,
+                                void* user_data) {
+    TestScheduler* scheduler = (TestScheduler*)self;
+    if (scheduler->schedule_status_code != IREE_STATUS_OK) {
+      return iree_make_status(scheduler->schedule_status_code,
+                              "test schedule failure");
+    }
+    scheduler->pending.emplace_back(fn, user_data);
+    return iree_ok_status();
+  }
+
+  iree_hal_local_executable_scheduler_t Get() {
+    iree_hal_local_executable_scheduler_t scheduler;
+    scheduler.self = this;
+    scheduler.schedule = Schedule;
+    return scheduler;
+  }
+
+  void RunAll() {
+    auto loads = std::move(pending);
+    pending.clear();
+    for (auto& load : loads) load.first(load.second);
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// LocalExecutableCacheTest
+//===----------------------------------------------------------------------===//
+
+class LocalExecutableCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TestLoader* loader = NULL;
+    IREE_ASSERT_OK(iree_allocator_malloc(iree_allocator_system(),
+                                         sizeof(*loader), (void**)&loader));
+    iree_hal_executable_loader_initialize(
+        &kTestLoaderVtable, iree_hal_executable_import_provider_null(),
+        &loader->base);
+    loader->state = &state_;
+    loader_ = &loader->base;
+  }
+
+  void TearDown() override {
+    scheduler_.RunAll();
+    iree_hal_executable_cache_release(executable_cache_);
+    iree_hal_executable_loader_release(loader_);
+    EXPECT_EQ(state_.live_executable_count, 0);
+  }
+
+  void CreateCache(iree_hal_local_executable_load_mode_t load_mode) {
+    IREE_ASSERT_OK(iree_hal_local_executable_cache_create_with_mode(
+        IREE_SV("test"), /*worker_capacity=*/1, /*loader_count=*/1, &loader_,
+        load_mode, scheduler_.Get(), iree_allocator_system(),
+        &executable_cache_));
+  }
+
+  iree_status_t Prepare(iree_string_view_t format,
+                        iree_hal_executable_t** out_executable) {
+    iree_hal_executable_params_t params;
+    iree_hal_executable_params_initialize(&params);
+    params.executable_format = format;
+    params.executable_data =
+        iree_make_const_byte_span(executable_data_, sizeof(executable_data_));
+    return iree_hal_executable_cache_prepare_executable(
+        executable_cache_, &params, out_executable);
+  }
+
+  static iree_status_t IssueCall(iree_hal_executable_t* executable) {
+    iree_hal_executable_dispatch_state_v0_t dispatch_state;
+    memset(&dispatch_state, 0, sizeof(dispatch_state));
+    iree_hal_executable_workgroup_state_v0_t workgroup_state;
+    memset(&workgroup_state, 0, sizeof(workgroup_state));
+    return iree_hal_local_executable_issue_call(
+        iree_hal_local_executable_cast(executable), /*ordinal=*/0,
+        &dispatch_state, &workgroup_state, /*worker_id=*/0);
+  }
+
+  TestLoaderState state_;
+  TestScheduler scheduler_;
+  iree_hal_executable_loader_t* loader_ = NULL;
+  iree_hal_executable_cache_t* executable_cache_ = NULL;
+  uint8_t executable_data_[4] = {1, 2, 3, 4};
+};
+
+TEST_F(LocalExecutableCacheTest, ParseLoadMode) {
+  iree_hal_local_executable_load_mode_t load_mode;
+  IREE_ASSERT_OK(
+      iree_hal_local_executable_load_mode_parse(IREE_SV(""), &load_mode));
+  EXPECT_EQ(load_mode, IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_IMMEDIATE);
+  IREE_ASSERT_OK(
+      iree_hal_local_executable_load_mode_parse(IREE_SV("async"), &load_mode));
+  EXPECT_EQ(load_mode, IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC);
+  IREE_ASSERT_OK(
+      iree_hal_local_executable_load_mode_parse(IREE_SV("lazy"), &load_mode));
+  EXPECT_EQ(load_mode, IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_LAZY);
+  EXPECT_THAT(Status(iree_hal_local_executable_load_mode_parse(
+                  IREE_SV("eager"), &load_mode)),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
+// Immediate loads happen during preparation and resolve to themselves.
+TEST_F(LocalExecutableCacheTest, ImmediateLoadsOnPrepare) {
+  CreateCache(IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_IMMEDIATE);
+  iree_hal_executable_t* executable = NULL;
+  IREE_ASSERT_OK(Prepare(kTestFormat, &executable));
+  EXPECT_EQ(state_.load_count, 1);
+  EXPECT_TRUE(scheduler_.pending.empty());
+
+  iree_hal_local_executable_t* resolved = NULL;
+  IREE_ASSERT_OK(iree_hal_local_executable_resolve(executable, &resolved));
+  EXPECT_EQ((iree_hal_executable_t*)resolved, executable);
+  iree_hal_executable_release(executable);
+}
+
+// Lazy loads happen once on first resolve and the caller-provided data is
+// copied so that it need not outlive preparation.
+TEST_F(LocalExecutableCacheTest, LazyLoadsOnFirstResolve) {
+  CreateCache(IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_LAZY);
+  iree_hal_executable_t* executable = NULL;
+  IREE_ASSERT_OK(Prepare(kTestFormat, &executable));
+  EXPECT_EQ(state_.load_count, 0);
+  EXPECT_TRUE(scheduler_.pending.empty());
+  memset(executable_data_, 0xCD, sizeof(executable_data_));
+
+  iree_hal_local_executable_t* resolved = NULL;
+  IREE_ASSERT_OK(iree_hal_local_executable_resolve(executable, &resolved));
+  EXPECT_NE((iree_hal_executable_t*)resolved, executable);
+  EXPECT_EQ(state_.load_count, 1);
+  EXPECT_EQ(state_.last_load_data, std::vector<uint8_t>({1, 2, 3, 4}));
+
+  iree_hal_local_executable_t* resolved_again = NULL;
+  IREE_ASSERT_OK(
+      iree_hal_local_executable_resolve(executable, &resolved_again));
+  EXPECT_EQ(resolved_again, resolved);
+  EXPECT_EQ(state_.load_count, 1);
+  iree_hal_executable_release(executable);
+}
+
+// Dispatching with an async executable before its scheduled load has run
+// performs the load inline and the scheduled load becomes a no-op.
+TEST_F(LocalExecutableCacheTest, AsyncDispatchBeforeReady) {
+  CreateCache(IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC);
+  iree_hal_executable_t* executable = NULL;
+  IREE_ASSERT_OK(Prepare(kTestFormat, &executable));
+  EXPECT_EQ(state_.load_count, 0);
+  EXPECT_EQ(scheduler_.pending.size(), 1);
+
+  IREE_ASSERT_OK(IssueCall(executable));
+  EXPECT_EQ(state_.load_count, 1);
+  EXPECT_EQ(state_.issue_call_count, 1);
+
+  scheduler_.RunAll();
+  EXPECT_EQ(state_.load_count, 1);
+  iree_hal_executable_release(executable);
+}
+
+// Dispatching while the scheduled load is in flight on another thread waits
+// for it to complete instead of loading again.
+TEST_F(LocalExecutableCacheTest, AsyncDispatchWaitsForInFlightLoad) {
+  CreateCache(IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC);
+  iree_hal_executable_t* executable = NULL;
+  IREE_ASSERT_OK(Prepare(kTestFormat, &executable));
+
+  state_.CloseGate();
+  std::thread load_thread([this] { scheduler_.RunAll(); });
+  while (state_.load_count == 0) std::this_thread::yield();
+
+  std::atomic<bool> dispatched{false};
+  std::thread dispatch_thread([&] {
+    IREE_EXPECT_OK(IssueCall(executable));
+    dispatched = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(dispatched);
+
+  state_.OpenGate();
+  dispatch_thread.join();
+  load_thread.join();
+  EXPECT_TRUE(dispatched);
+  EXPECT_EQ(state_.load_count, 1);
+  EXPECT_EQ(state_.issue_call_count, 1);
+  iree_hal_executable_release(executable);
+}
+
+// Load failures are reported from each resolve and dispatch without retrying.
+TEST_F(LocalExecutableCacheTest, DeferredLoadFailurePropagates) {
+  state_.load_status_code = IREE_STATUS_DATA_LOSS;
+  CreateCache(IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC);
+  iree_hal_executable_t* executable = NULL;
+  IREE_ASSERT_OK(Prepare(kTestFormat, &executable));
+  scheduler_.RunAll();
+  EXPECT_EQ(state_.load_count, 1);
+
+  iree_hal_local_executable_t* resolved = NULL;
+  EXPECT_THAT(Status(iree_hal_local_executable_resolve(executable, &resolved)),
+              StatusIs(StatusCode::kDataLoss));
+  EXPECT_EQ(resolved, nullptr);
+  EXPECT_THAT(Status(IssueCall(executable)),
+              StatusIs(StatusCode::kDataLoss));
+  EXPECT_EQ(state_.load_count, 1);
+  EXPECT_EQ(state_.issue_call_count, 0);
+  iree_hal_executable_release(executable);
+}
+
+// Formats no loader supports fail during preparation even when deferred.
+TEST_F(LocalExecutableCacheTest, DeferredUnsupportedFormatFailsOnPrepare) {
+  CreateCache(IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_LAZY);
+  iree_hal_executable_t* executable = NULL;
+  EXPECT_THAT(Status(Prepare(IREE_SV("other-format"), &executable)),
+              StatusIs(StatusCode::kNotFound));
+  EXPECT_EQ(executable, nullptr);
+  EXPECT_EQ(state_.load_count, 0);
+}
+
+// Failing to schedule an async load fails preparation without leaking.
+TEST_F(LocalExecutableCacheTest, AsyncScheduleFailure) {
+  scheduler_.schedule_status_code = IREE_STATUS_RESOURCE_EXHAUSTED;
+  CreateCache(IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC);
+  iree_hal_executable_t* executable = NULL;
+  EXPECT_THAT(Status(Prepare(kTestFormat, &executable)),
+              StatusIs(StatusCode::kResourceExhausted));
+  EXPECT_EQ(executable, nullptr);
+  EXPECT_EQ(state_.load_count, 0);
+}
+
+// Releasing an executable and its cache while the load is pending keeps both
+// live until the load completes and then destroys the loaded executable.
+TEST_F(LocalExecutableCacheTest, AsyncReleaseWhilePending) {
+  CreateCache(IREE_HAL_LOCAL_EXECUTABLE_LOAD_MODE_ASYNC);
+  iree_hal_executable_t* executable = NULL;
+  IREE_ASSERT_OK(Prepare(kTestFormat, &executable));
+  iree_hal_executable_release(executable);
+  iree_hal_executable_cache_release(executable_cache_);
+  executable_cache_ = NULL;
+  EXPECT_EQ(state_.load_count, 0);
+
+  scheduler_.RunAll();
+  EXPECT_EQ(state_.load_count, 1);
+  EXPECT_EQ(state_.live_executable_count, 0);
+}
+
+}  // namespace
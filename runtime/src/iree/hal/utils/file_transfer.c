@@ -665,16 +665,17 @@ static iree_status_t iree_hal_transfer_worker_copy_buffer_to_staging(
   IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)transfer_length);
 
   // Timeline increments by one.
+  uint64_t wait_timepoint = worker->pending_timepoint;
   iree_hal_semaphore_list_t wait_semaphore_list = {
       .count = 1,
       .semaphores = &worker->semaphore,
-      .payload_values = &worker->pending_timepoint,
+      .payload_values = &wait_timepoint,
   };
-  ++worker->pending_timepoint;
+  uint64_t signal_timepoint = ++worker->pending_timepoint;
   iree_hal_semaphore_list_t signal_semaphore_list = {
       .count = 1,
       .semaphores = &worker->semaphore,
-      .payload_values = &worker->pending_timepoint,
+      .payload_values = &signal_timepoint,
   };
 
   // Track the pending copy operation so we know where to place it in the file.
@@ -161,6 +161,101 @@ iree_io_file_handle_flush(iree_io_file_handle_t* handle) {
   return status;
 }
 
+#if IREE_FILE_IO_ENABLE &&                                           \
+    (defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_IOS) || \
+     defined(IREE_PLATFORM_LINUX) || defined(IREE_PLATFORM_MACOS))
+
+static void iree_io_platform_prefetch_host_allocation(iree_byte_span_t buffer,
+                                                      uint64_t offset,
+                                                      uint64_t length) {
+  if (offset >= buffer.data_length) return;
+  length = iree_min(length, buffer.data_length - offset);
+  // madvise requires a page-aligned base address.
+  const uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+  uintptr_t begin = (uintptr_t)buffer.data + (uintptr_t)offset;
+  uintptr_t aligned_begin = begin & ~(page_size - 1);
+  // Host allocations may not be file mappings (heap memory, etc) and the hint
+  // is informational only so failures are ignored.
+  madvise((void*)aligned_begin, (size_t)(begin - aligned_begin + length),
+          MADV_WILLNEED);
+}
+
+static iree_status_t iree_io_platform_fd_prefetch(int fd, uint64_t offset,
+                                                  uint64_t length) {
+  // Clamp to the file size so that ranges past the end are ignored and the
+  // range always fits in off_t.
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "unable to query file size");
+  }
+  const uint64_t file_size = (uint64_t)file_stat.st_size;
+  if (offset >= file_size) return iree_ok_status();
+  length = iree_min(length, file_size - offset);
+#if defined(IREE_PLATFORM_IOS) || defined(IREE_PLATFORM_MACOS)
+  // F_RDADVISE takes an int count so large ranges are split.
+  while (length > 0) {
+    struct radvisory advisory = {
+        .ra_offset = (off_t)offset,
+        .ra_count = (int)iree_min(length, (uint64_t)INT32_MAX),
+    };
+    if (fcntl(fd, F_RDADVISE, &advisory) == -1) {
+      return iree_make_status(iree_status_code_from_errno(errno),
+                              "unable to advise file reads");
+    }
+    offset += advisory.ra_count;
+    length -= advisory.ra_count;
+  }
+  return iree_ok_status();
+#else
+  int ret = posix_fadvise(fd, (off_t)offset, (off_t)length,
+                          POSIX_FADV_WILLNEED);
+  return ret == 0 ? iree_ok_status()
+                  : iree_make_status(iree_status_code_from_errno(ret),
+                                     "unable to advise file reads");
+#endif  // IREE_PLATFORM_IOS || IREE_PLATFORM_MACOS
+}
+
+#else
+
+static void iree_io_platform_prefetch_host_allocation(iree_byte_span_t buffer,
+                                                      uint64_t offset,
+                                                      uint64_t length) {}
+
+static iree_status_t iree_io_platform_fd_prefetch(int fd, uint64_t offset,
+                                                  uint64_t length) {
+  return iree_ok_status();
+}
+
+#endif  // IREE_FILE_IO_ENABLE && IREE_PLATFORM_*
+
+IREE_API_EXPORT iree_status_t iree_io_file_handle_prefetch(
+    iree_io_file_handle_t* handle, uint64_t offset, uint64_t length) {
+  IREE_ASSERT_ARGUMENT(handle);
+  if (length == 0) return iree_ok_status();
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)length);
+  iree_status_t status = iree_ok_status();
+  switch (handle->primitive.type) {
+    case IREE_IO_FILE_HANDLE_TYPE_HOST_ALLOCATION: {
+      iree_io_platform_prefetch_host_allocation(
+          handle->primitive.value.host_allocation, offset, length);
+      break;
+    }
+    case IREE_IO_FILE_HANDLE_TYPE_FD: {
+      status = iree_io_platform_fd_prefetch(handle->primitive.value.fd, offset,
+                                            length);
+      break;
+    }
+    default: {
+      // Advisory only; unknown handle types are ignored.
+      break;
+    }
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 //===----------------------------------------------------------------------===//
 // iree_io_file_handle_t utilities
 //===----------------------------------------------------------------------===//
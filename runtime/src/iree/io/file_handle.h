@@ -155,6 +155,14 @@ static inline iree_io_file_handle_primitive_value_t iree_io_file_handle_value(
 IREE_API_EXPORT iree_status_t
 iree_io_file_handle_flush(iree_io_file_handle_t* handle);
 
+// Hints that the byte range [offset, offset+length) of |handle| will be read
+// soon. Where supported the platform begins reading the range into the page
+// cache (or faulting in the pages of a mapped host allocation) asynchronously
+// and this returns immediately. Handle types and platforms without support
+// treat this as a no-op as it is purely advisory.
+IREE_API_EXPORT iree_status_t iree_io_file_handle_prefetch(
+    iree_io_file_handle_t* handle, uint64_t offset, uint64_t length);
+
 //===----------------------------------------------------------------------===//
 // iree_io_file_handle_t platform files
 //===----------------------------------------------------------------------===//
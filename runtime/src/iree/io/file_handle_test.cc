@@ -0,0 +1,152 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/io/file_handle.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/io/stream.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+// Returns |length| bytes of a deterministic non-uniform pattern.
+static std::vector<uint8_t> MakeContents(size_t length) {
+  std::vector<uint8_t> contents(length);
+  for (size_t i = 0; i < length; ++i) contents[i] = (uint8_t)(i * 31 + 7);
+  return contents;
+}
+
+// Reads all of |handle| from offset 0 through a stream.
+static std::vector<uint8_t> ReadContents(iree_io_file_handle_t* handle,
+                                         size_t length) {
+  std::vector<uint8_t> contents(length);
+  iree_io_stream_t* stream = NULL;
+  IREE_CHECK_OK(iree_io_stream_open(IREE_IO_STREAM_MODE_READABLE, handle,
+                                    /*file_offset=*/0, iree_allocator_system(),
+                                    &stream));
+  IREE_CHECK_OK(iree_io_stream_read(stream, contents.size(), contents.data(),
+                                    /*out_buffer_length=*/NULL));
+  iree_io_stream_release(stream);
+  return contents;
+}
+
+//===----------------------------------------------------------------------===//
+// Host allocation handles
+//===----------------------------------------------------------------------===//
+
+class FileHandleHostAllocationTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    contents_ = MakeContents(64 * 1024 + 123);
+    storage_ = contents_;
+    IREE_ASSERT_OK(iree_io_file_handle_wrap_host_allocation(
+        IREE_IO_FILE_ACCESS_READ,
+        iree_make_byte_span(storage_.data(), storage_.size()),
+        iree_io_file_handle_release_callback_null(), iree_allocator_system(),
+        &handle_));
+  }
+
+  void TearDown() override {
+    // Prefetching is advisory and must never change the contents.
+    EXPECT_EQ(storage_, contents_);
+    iree_io_file_handle_release(handle_);
+  }
+
+  std::vector<uint8_t> contents_;
+  std::vector<uint8_t> storage_;
+  iree_io_file_handle_t* handle_ = NULL;
+};
+
+TEST_F(FileHandleHostAllocationTest, PrefetchAll) {
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, 0, storage_.size()));
+}
+
+TEST_F(FileHandleHostAllocationTest, PrefetchUnalignedSubrange) {
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, 4097, 8191));
+}
+
+TEST_F(FileHandleHostAllocationTest, PrefetchEmpty) {
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, 0, 0));
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, storage_.size(), 0));
+}
+
+TEST_F(FileHandleHostAllocationTest, PrefetchOutOfRange) {
+  // Ranges past the end are clamped or ignored as the call is only a hint.
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, 1024, UINT64_MAX));
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, storage_.size(), 1));
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, UINT64_MAX, 1));
+}
+
+//===----------------------------------------------------------------------===//
+// Platform file handles
+//===----------------------------------------------------------------------===//
+
+#if IREE_FILE_IO_ENABLE
+
+class FileHandlePlatformFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "/iree_io_file_handle_test_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::remove(path_.c_str());
+    contents_ = MakeContents(256 * 1024 + 17);
+    IREE_ASSERT_OK(iree_io_file_handle_create(
+        IREE_IO_FILE_MODE_READ | IREE_IO_FILE_MODE_WRITE,
+        iree_make_string_view(path_.data(), path_.size()),
+        /*initial_size=*/0, iree_allocator_system(), &handle_));
+    iree_io_stream_t* stream = NULL;
+    IREE_ASSERT_OK(iree_io_stream_open(
+        IREE_IO_STREAM_MODE_WRITABLE, handle_, /*file_offset=*/0,
+        iree_allocator_system(), &stream));
+    IREE_ASSERT_OK(
+        iree_io_stream_write(stream, contents_.size(), contents_.data()));
+    iree_io_stream_release(stream);
+    IREE_ASSERT_OK(iree_io_file_handle_flush(handle_));
+  }
+
+  void TearDown() override {
+    if (handle_) {
+      // Prefetching is advisory and must never change the contents.
+      EXPECT_EQ(ReadContents(handle_, contents_.size()), contents_);
+      iree_io_file_handle_release(handle_);
+    }
+    std::remove(path_.c_str());
+  }
+
+  std::string path_;
+  std::vector<uint8_t> contents_;
+  iree_io_file_handle_t* handle_ = NULL;
+};
+
+TEST_F(FileHandlePlatformFileTest, PrefetchAll) {
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, 0, contents_.size()));
+}
+
+TEST_F(FileHandlePlatformFileTest, PrefetchUnalignedSubrange) {
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, 4097, 100 * 1024));
+}
+
+TEST_F(FileHandlePlatformFileTest, PrefetchEmpty) {
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, 0, 0));
+}
+
+TEST_F(FileHandlePlatformFileTest, PrefetchOutOfRange) {
+  // Ranges past the end of the file are clamped or ignored as the call is only
+  // a hint; the lengths must not overflow the platform offset types.
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, 1024, UINT64_MAX));
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, contents_.size(), 1));
+  IREE_EXPECT_OK(iree_io_file_handle_prefetch(handle_, UINT64_MAX, 1));
+}
+
+#endif  // IREE_FILE_IO_ENABLE
+
+}  // namespace
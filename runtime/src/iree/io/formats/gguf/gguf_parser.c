@@ -653,9 +653,15 @@ static iree_status_t iree_io_gguf_append_tensor_info(
   return iree_io_parameter_index_add(parser->index, &entry);
 }
 
+// Parses the GGUF header from |file_contents| and appends its tensors to
+// |index|. |file_contents| must start at the beginning of the file but need
+// only be a prefix of it: |file_length| is the total file size used to bound
+// the tensor data. A prefix that ends before the tensor info does produces
+// IREE_STATUS_OUT_OF_RANGE without having added any entries to |index|; no
+// other error is reported with that code.
 static iree_status_t iree_io_parse_gguf_index_from_memory(
     iree_io_file_handle_t* file_handle, iree_const_byte_span_t file_contents,
-    iree_io_parameter_index_t* index) {
+    uint64_t file_length, iree_io_parameter_index_t* index) {
   // Read the header enough to check for file validity and version.
   // Unfortunately the format has a variable-length header (vs being
   // table-based) and that means we have to actually parse the header fully
@@ -715,8 +721,14 @@ static iree_status_t iree_io_parse_gguf_index_from_memory(
   parser.tensor_data_offset = iree_align_uint64(
       (uint64_t)(tensor_info_contents.data - file_contents.data),
       parser.alignment);
-  parser.tensor_data_size =
-      file_contents.data_length - parser.tensor_data_offset;
+  if (parser.tensor_data_offset > file_length) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "tensor data offset %" PRIu64
+                            " is beyond the end of the file (%" PRIu64
+                            " bytes)",
+                            parser.tensor_data_offset, file_length);
+  }
+  parser.tensor_data_size = file_length - parser.tensor_data_offset;
 
   // Scan forward through the tensor info now that we know the tensor data
   // offset and add the tensor entries.
@@ -726,25 +738,108 @@ static iree_status_t iree_io_parse_gguf_index_from_memory(
   return iree_ok_status();
 }
 
+// Initial number of bytes read from a stream when looking for the end of the
+// header. Most files have small headers but ones with large embedded
+// vocabularies can be several MB and the read size grows geometrically.
+#define IREE_IO_GGUF_INITIAL_HEADER_READ_SIZE (64 * 1024)
+// Maximum number of bytes read from a stream when looking for the end of the
+// header. Large embedded vocabularies are tens of MB and anything bigger is
+// assumed to be a corrupt length field that would otherwise cause the entire
+// file to be read.
+#define IREE_IO_GGUF_MAX_HEADER_READ_SIZE (256 * 1024 * 1024)
+
+IREE_API_EXPORT iree_status_t iree_io_parse_gguf_index_from_stream(
+    iree_io_file_handle_t* file_handle, iree_io_stream_t* stream,
+    iree_io_parameter_index_t* index, iree_allocator_t host_allocator) {
+  IREE_ASSERT_ARGUMENT(file_handle);
+  IREE_ASSERT_ARGUMENT(stream);
+  IREE_ASSERT_ARGUMENT(index);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // GGUF does not store the header size so we read a prefix of the file and
+  // try to parse it, reading more if it turns out to be too short. Parsing
+  // only reports IREE_STATUS_OUT_OF_RANGE when it runs off the end of the
+  // prefix and only adds entries once the entire tensor info has been scanned
+  // so retrying is safe. Each retry only reads the bytes not yet read.
+  const uint64_t file_length = (uint64_t)iree_io_stream_length(stream);
+  const uint64_t max_read_size =
+      iree_min(file_length, (uint64_t)IREE_IO_GGUF_MAX_HEADER_READ_SIZE);
+  uint8_t* buffer = NULL;
+  iree_host_size_t buffer_length = 0;
+  iree_host_size_t read_size = (iree_host_size_t)iree_min(
+      max_read_size, (uint64_t)IREE_IO_GGUF_INITIAL_HEADER_READ_SIZE);
+  iree_status_t status = iree_ok_status();
+  if (file_length == 0) {
+    status = iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                              "empty file has no GGUF header");
+  }
+  while (iree_status_is_ok(status)) {
+    // The buffer is grown by copying as |host_allocator| may be an arena that
+    // does not support reallocation.
+    uint8_t* new_buffer = NULL;
+    status =
+        iree_allocator_malloc(host_allocator, read_size, (void**)&new_buffer);
+    if (!iree_status_is_ok(status)) break;
+    if (buffer_length > 0) memcpy(new_buffer, buffer, buffer_length);
+    iree_allocator_free(host_allocator, buffer);
+    buffer = new_buffer;
+    status = iree_io_stream_read(stream, read_size - buffer_length,
+                                 buffer + buffer_length, NULL);
+    if (!iree_status_is_ok(status)) break;
+    buffer_length = read_size;
+    status = iree_io_parse_gguf_index_from_memory(
+        file_handle, iree_make_const_byte_span(buffer, buffer_length),
+        file_length, index);
+    if (iree_status_is_out_of_range(status) &&
+        buffer_length < max_read_size) {
+      status = iree_status_ignore(status);
+      read_size = (iree_host_size_t)iree_min(max_read_size,
+                                             (uint64_t)buffer_length * 4);
+      continue;
+    } else if (iree_status_is_out_of_range(status) &&
+               buffer_length < file_length) {
+      status = iree_status_annotate_f(
+          status, "GGUF header exceeds the maximum of %" PRIu64 " bytes",
+          max_read_size);
+    }
+    break;
+  }
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)buffer_length);
+  iree_allocator_free(host_allocator, buffer);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 IREE_API_EXPORT iree_status_t iree_io_parse_gguf_index(
     iree_io_file_handle_t* file_handle, iree_io_parameter_index_t* index,
     iree_allocator_t host_allocator) {
   IREE_ASSERT_ARGUMENT(index);
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // The parser requires a host pointer but will only reference the file handle
-  // in the index.
-  iree_io_file_mapping_t* file_mapping = NULL;
-  IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_io_file_map_view(file_handle, IREE_IO_FILE_ACCESS_READ, 0,
-                                IREE_HOST_SIZE_MAX,
-                                IREE_IO_FILE_MAPPING_FLAG_EXCLUDE_FROM_DUMPS,
-                                host_allocator, &file_mapping));
-
-  iree_status_t status = iree_io_parse_gguf_index_from_memory(
-      file_handle, iree_io_file_mapping_contents_ro(file_mapping), index);
-
-  iree_io_file_mapping_release(file_mapping);
+  // Files already resident in host memory are parsed in place. Everything
+  // else is streamed so that only the header is read instead of mapping the
+  // entire file.
+  iree_status_t status = iree_ok_status();
+  if (iree_io_file_handle_type(file_handle) ==
+      IREE_IO_FILE_HANDLE_TYPE_HOST_ALLOCATION) {
+    iree_byte_span_t host_allocation =
+        iree_io_file_handle_value(file_handle).host_allocation;
+    status = iree_io_parse_gguf_index_from_memory(
+        file_handle,
+        iree_make_const_byte_span(host_allocation.data,
+                                  host_allocation.data_length),
+        host_allocation.data_length, index);
+  } else {
+    iree_io_stream_t* stream = NULL;
+    status = iree_io_stream_open(IREE_IO_STREAM_MODE_READABLE, file_handle,
+                                 /*file_offset=*/0, host_allocator, &stream);
+    if (iree_status_is_ok(status)) {
+      status = iree_io_parse_gguf_index_from_stream(file_handle, stream, index,
+                                                    host_allocator);
+    }
+    iree_io_stream_release(stream);
+  }
 
   IREE_TRACE_ZONE_END(z0);
   return status;
@@ -10,6 +10,7 @@
 #include "iree/base/api.h"
 #include "iree/io/file_handle.h"
 #include "iree/io/parameter_index.h"
+#include "iree/io/stream.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,12 +21,28 @@ extern "C" {
 // Specification:
 // https://github.com/ggerganov/ggml/blob/master/docs/gguf.md
 //
+// Files backed by host allocations are parsed in place and all others are
+// streamed such that only the header is read from storage.
+//
 // The provided |host_allocator| may be used for allocations during parsing and
 // is allowed to be an arena.
 IREE_API_EXPORT iree_status_t iree_io_parse_gguf_index(
     iree_io_file_handle_t* file_handle, iree_io_parameter_index_t* index,
     iree_allocator_t host_allocator);
 
+// Parses the .gguf header read from |stream| and merges its contained
+// resources into |index| as ranges of |file_handle|. |stream| must be
+// positioned at the start of the file contents of |file_handle|. GGUF does
+// not record its header size so the header is read in geometrically growing
+// chunks until it has been fully parsed; tensor data is never read. Headers
+// larger than 256MB are rejected.
+//
+// The provided |host_allocator| is used for a transient copy of the header and
+// is allowed to be an arena.
+IREE_API_EXPORT iree_status_t iree_io_parse_gguf_index_from_stream(
+    iree_io_file_handle_t* file_handle, iree_io_stream_t* stream,
+    iree_io_parameter_index_t* index, iree_allocator_t host_allocator);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
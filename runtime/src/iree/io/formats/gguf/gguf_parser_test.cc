@@ -6,6 +6,7 @@
 
 #include "iree/io/formats/gguf/gguf_parser.h"
 
+#include "iree/base/internal/arena.h"
 #include "iree/io/formats/gguf/testdata/gguf_files.h"
 #include "iree/testing/gtest.h"
 #include "iree/testing/status_matchers.h"
@@ -125,5 +126,61 @@ TEST(GgufFormatTest, MultipleTensors) {
   iree_io_parameter_index_release(index);
 }
 
+TEST(GgufFormatTest, MultipleTensorsFromStream) {
+  iree_io_parameter_index_t* index = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_create(iree_allocator_system(), &index));
+
+  iree_io_file_handle_t* file_handle = OpenTestFile("multiple.gguf");
+  iree_io_stream_t* stream = NULL;
+  IREE_ASSERT_OK(iree_io_stream_open(IREE_IO_STREAM_MODE_READABLE, file_handle,
+                                     /*file_offset=*/0, iree_allocator_system(),
+                                     &stream));
+  IREE_ASSERT_OK(iree_io_parse_gguf_index_from_stream(
+      file_handle, stream, index, iree_allocator_system()));
+  iree_io_stream_release(stream);
+  iree_io_file_handle_release(file_handle);
+
+  const iree_io_parameter_index_entry_t* entry0 = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_lookup(index, IREE_SV("tensor0"), &entry0));
+  EXPECT_EQ(entry0->storage.file.offset, 448);
+  EXPECT_EQ(entry0->length, 16);
+
+  const iree_io_parameter_index_entry_t* entry2 = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_lookup(index, IREE_SV("tensor2"), &entry2));
+  EXPECT_EQ(entry2->storage.file.offset, 576);
+  EXPECT_EQ(entry2->length, 48);
+
+  iree_io_parameter_index_release(index);
+}
+
+// Arenas do not support reallocation and the header buffer must not need it.
+TEST(GgufFormatTest, MultipleTensorsFromStreamWithArena) {
+  iree_io_parameter_index_t* index = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_create(iree_allocator_system(), &index));
+  iree_arena_block_pool_t block_pool;
+  iree_arena_block_pool_initialize(4096, iree_allocator_system(), &block_pool);
+  iree_arena_allocator_t arena;
+  iree_arena_initialize(&block_pool, &arena);
+
+  iree_io_file_handle_t* file_handle = OpenTestFile("multiple.gguf");
+  iree_io_stream_t* stream = NULL;
+  IREE_ASSERT_OK(iree_io_stream_open(IREE_IO_STREAM_MODE_READABLE, file_handle,
+                                     /*file_offset=*/0, iree_allocator_system(),
+                                     &stream));
+  IREE_ASSERT_OK(iree_io_parse_gguf_index_from_stream(
+      file_handle, stream, index, iree_arena_allocator(&arena)));
+  iree_io_stream_release(stream);
+  iree_io_file_handle_release(file_handle);
+  EXPECT_EQ(iree_io_parameter_index_count(index), 3);
+
+  iree_arena_deinitialize(&arena);
+  iree_arena_block_pool_deinitialize(&block_pool);
+  iree_io_parameter_index_release(index);
+}
+
 }  // namespace
 }  // namespace iree
@@ -6,6 +6,10 @@
 
 #include "iree/io/formats/irpa/irpa_builder.h"
 
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/siphash.h"
+#include "iree/base/internal/threading.h"
+
 IREE_API_EXPORT iree_status_t iree_io_parameter_archive_builder_initialize(
     iree_allocator_t host_allocator,
     iree_io_parameter_archive_builder_t* out_builder) {
@@ -303,26 +307,437 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_archive_builder_add_data_entry(
   return iree_ok_status();
 }
 
+IREE_API_EXPORT iree_status_t iree_io_parameter_archive_builder_add_alias_entry(
+    iree_io_parameter_archive_builder_t* builder, iree_string_view_t name,
+    iree_const_byte_span_t metadata, iree_host_size_t target_ordinal) {
+  IREE_ASSERT_ARGUMENT(builder);
+  const iree_io_parameter_index_entry_t* target_entry = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_parameter_index_get(
+      builder->index, target_ordinal, &target_entry));
+  if (target_entry->type != IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "alias target entry %" PRIhsz " is not a data entry", target_ordinal);
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_TEXT(z0, name.data, name.size);
+  iree_io_parameter_index_entry_t entry = {
+      .key = name,
+      .metadata = metadata,
+      .length = target_entry->length,
+      .type = IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE,
+      .storage =
+          {
+              .file =
+                  {
+                      .handle = NULL,  // set on commit
+                      .offset = target_entry->storage.file.offset,
+                  },
+          },
+  };
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_io_parameter_index_add(builder->index, &entry));
+  builder->entry_segment_size =
+      iree_align_uint64(builder->entry_segment_size,
+                        IREE_IO_PARAMETER_ARCHIVE_ENTRY_ALIGNMENT) +
+      sizeof(iree_io_parameter_archive_data_entry_t);
+  builder->metadata_segment_size += name.size + metadata.data_length;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+//===----------------------------------------------------------------------===//
+// iree_io_build_parameter_archive
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_io_build_parameter_archive_state_t
+    iree_io_build_parameter_archive_state_t;
+
+// Processes a single source entry on any thread.
+typedef iree_status_t (*iree_io_build_parameter_archive_entry_fn_t)(
+    iree_io_build_parameter_archive_state_t* state,
+    iree_host_size_t entry_ordinal);
+
+struct iree_io_build_parameter_archive_state_t {
+  iree_io_parameter_index_t* source_index;
+  iree_host_size_t entry_count;
+  iree_host_size_t max_concurrency;
+  iree_allocator_t host_allocator;
+  // Content hash of each data entry when deduplicating.
+  uint64_t* hashes;
+  // Ordinal of the entry whose storage each entry uses. Entries owning their
+  // storage reference themselves.
+  iree_host_size_t* storage_ordinals;
+  // Per-entry result of the current entry_fn.
+  iree_status_t* statuses;
+  // Target archive index and the ordinal of the first entry of the archive.
+  iree_io_parameter_index_t* target_index;
+  iree_host_size_t target_base_ordinal;
+  // Host memory of the target file when the contents can be copied directly.
+  // Entry storage is at |target_file_offset| + the target entry offset.
+  iree_byte_span_t target_contents;
+  iree_io_physical_offset_t target_file_offset;
+  // Function run on each entry by the workers and the next entry to claim.
+  iree_io_build_parameter_archive_entry_fn_t entry_fn;
+  iree_atomic_int64_t next_entry;
+};
+
+// Claims and processes entries until none remain. Run on each worker thread as
+// well as the calling thread.
+static int iree_io_build_parameter_archive_worker(void* entry_arg) {
+  iree_io_build_parameter_archive_state_t* state =
+      (iree_io_build_parameter_archive_state_t*)entry_arg;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  while (true) {
+    int64_t i =
+        iree_atomic_fetch_add(&state->next_entry, 1, iree_memory_order_relaxed);
+    if (i >= (int64_t)state->entry_count) break;
+    state->statuses[i] = state->entry_fn(state, (iree_host_size_t)i);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return 0;
+}
+
+// Runs |entry_fn| on all entries with up to |state->max_concurrency| threads
+// and returns the first failure in entry order.
+static iree_status_t iree_io_build_parameter_archive_for_each_entry(
+    iree_io_build_parameter_archive_state_t* state,
+    iree_io_build_parameter_archive_entry_fn_t entry_fn) {
+  if (!state->entry_count) return iree_ok_status();
+  state->entry_fn = entry_fn;
+  iree_atomic_store(&state->next_entry, 0, iree_memory_order_relaxed);
+  for (iree_host_size_t i = 0; i < state->entry_count; ++i) {
+    state->statuses[i] = iree_ok_status();
+  }
+
+  const iree_host_size_t worker_count =
+      iree_min(state->max_concurrency, state->entry_count) - 1;
+  iree_thread_t** workers = NULL;
+  if (worker_count > 0) {
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+        state->host_allocator, worker_count * sizeof(workers[0]),
+        (void**)&workers));
+  }
+
+  // Spin up the workers and have the calling thread help out. If a worker
+  // cannot be created the remaining ones pick up its share.
+  iree_thread_create_params_t params;
+  memset(&params, 0, sizeof(params));
+  params.name = IREE_SV("iree-io-archive");
+  iree_host_size_t started_worker_count = 0;
+  for (iree_host_size_t i = 0; i < worker_count; ++i) {
+    iree_status_t create_status = iree_thread_create(
+        iree_io_build_parameter_archive_worker, state, params,
+        state->host_allocator, &workers[started_worker_count]);
+    if (!iree_status_is_ok(create_status)) {
+      iree_status_ignore(create_status);
+      break;
+    }
+    ++started_worker_count;
+  }
+  iree_io_build_parameter_archive_worker(state);
+  // Releasing the last reference to a thread joins it.
+  for (iree_host_size_t i = 0; i < started_worker_count; ++i) {
+    iree_thread_release(workers[i]);
+  }
+  iree_allocator_free(state->host_allocator, workers);
+
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < state->entry_count; ++i) {
+    if (iree_status_is_ok(status)) {
+      status = state->statuses[i];
+    } else {
+      iree_status_ignore(state->statuses[i]);
+    }
+    state->statuses[i] = iree_ok_status();
+  }
+  return status;
+}
+
+// Maps the contents of the data |entry| for reading.
+static iree_status_t iree_io_build_parameter_archive_map_entry(
+    const iree_io_parameter_index_entry_t* entry,
+    iree_allocator_t host_allocator, iree_io_file_mapping_t** out_mapping) {
+  if (entry->length > IREE_HOST_SIZE_MAX) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "parameter `%.*s` too large to map",
+                            (int)entry->key.size, entry->key.data);
+  }
+  return iree_io_file_map_view(
+      entry->storage.file.handle, IREE_IO_FILE_ACCESS_READ,
+      entry->storage.file.offset, (iree_host_size_t)entry->length,
+      IREE_IO_FILE_MAPPING_FLAG_NONE, host_allocator, out_mapping);
+}
+
+// Hashes the contents of a data entry.
+static iree_status_t iree_io_build_parameter_archive_hash_entry(
+    iree_io_build_parameter_archive_state_t* state,
+    iree_host_size_t entry_ordinal) {
+  const iree_io_parameter_index_entry_t* entry = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_io_parameter_index_get(state->source_index, entry_ordinal, &entry));
+  state->hashes[entry_ordinal] = 0;
+  if (entry->type != IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE ||
+      entry->length == 0) {
+    return iree_ok_status();
+  }
+  iree_io_file_mapping_t* mapping = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_build_parameter_archive_map_entry(
+      entry, state->host_allocator, &mapping));
+  // The key is fixed as hashes are only compared within a single build.
+  const iree_siphash_key_t key = {0x49524541524348ull, 0x4956455048415348ull};
+  state->hashes[entry_ordinal] =
+      iree_siphash24(key, iree_io_file_mapping_contents_ro(mapping));
+  iree_io_file_mapping_release(mapping);
+  return iree_ok_status();
+}
+
+// Compares the contents of two data entries of the same length.
+static iree_status_t iree_io_build_parameter_archive_compare_entries(
+    const iree_io_parameter_index_entry_t* entry_a,
+    const iree_io_parameter_index_entry_t* entry_b,
+    iree_allocator_t host_allocator, bool* out_equal) {
+  *out_equal = false;
+  iree_io_file_mapping_t* mapping_a = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_build_parameter_archive_map_entry(
+      entry_a, host_allocator, &mapping_a));
+  iree_io_file_mapping_t* mapping_b = NULL;
+  iree_status_t status = iree_io_build_parameter_archive_map_entry(
+      entry_b, host_allocator, &mapping_b);
+  if (iree_status_is_ok(status)) {
+    iree_const_byte_span_t contents_a =
+        iree_io_file_mapping_contents_ro(mapping_a);
+    iree_const_byte_span_t contents_b =
+        iree_io_file_mapping_contents_ro(mapping_b);
+    *out_equal = contents_a.data == contents_b.data ||
+                 memcmp(contents_a.data, contents_b.data,
+                        contents_a.data_length) == 0;
+  }
+  iree_io_file_mapping_release(mapping_b);
+  iree_io_file_mapping_release(mapping_a);
+  return status;
+}
+
+// Points each data entry at the first earlier entry with identical contents.
+// Entries are bucketed by hash and length in an open-addressed table and
+// candidates are compared byte-for-byte so hash collisions never alias.
+static iree_status_t iree_io_build_parameter_archive_deduplicate(
+    iree_io_build_parameter_archive_state_t* state) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_host_size_t table_capacity = 16;
+  while (table_capacity < state->entry_count * 2) table_capacity *= 2;
+  iree_host_size_t* table = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(state->host_allocator,
+                                table_capacity * sizeof(table[0]),
+                                (void**)&table));
+  for (iree_host_size_t i = 0; i < table_capacity; ++i) {
+    table[i] = IREE_HOST_SIZE_MAX;
+  }
+
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < state->entry_count; ++i) {
+    const iree_io_parameter_index_entry_t* entry = NULL;
+    status = iree_io_parameter_index_get(state->source_index, i, &entry);
+    if (!iree_status_is_ok(status)) break;
+    if (entry->type != IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE ||
+        entry->length == 0) {
+      continue;
+    }
+    iree_host_size_t slot = (iree_host_size_t)state->hashes[i];
+    while (true) {
+      slot &= table_capacity - 1;
+      const iree_host_size_t candidate_ordinal = table[slot];
+      if (candidate_ordinal == IREE_HOST_SIZE_MAX) {
+        table[slot] = i;
+        break;
+      }
+      const iree_io_parameter_index_entry_t* candidate = NULL;
+      status = iree_io_parameter_index_get(state->source_index,
+                                           candidate_ordinal, &candidate);
+      if (!iree_status_is_ok(status)) break;
+      if (state->hashes[candidate_ordinal] == state->hashes[i] &&
+          candidate->length == entry->length) {
+        bool equal = false;
+        status = iree_io_build_parameter_archive_compare_entries(
+            candidate, entry, state->host_allocator, &equal);
+        if (!iree_status_is_ok(status)) break;
+        if (equal) {
+          state->storage_ordinals[i] = candidate_ordinal;
+          break;
+        }
+      }
+      ++slot;
+    }
+    if (!iree_status_is_ok(status)) break;
+  }
+
+  iree_allocator_free(state->host_allocator, table);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Copies the contents of a data entry owning its storage into the mapped
+// target file.
+static iree_status_t iree_io_build_parameter_archive_copy_entry(
+    iree_io_build_parameter_archive_state_t* state,
+    iree_host_size_t entry_ordinal) {
+  if (state->storage_ordinals[entry_ordinal] != entry_ordinal) {
+    return iree_ok_status();
+  }
+  const iree_io_parameter_index_entry_t* source_entry = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_parameter_index_get(
+      state->source_index, entry_ordinal, &source_entry));
+  if (source_entry->type != IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE ||
+      source_entry->length == 0) {
+    return iree_ok_status();
+  }
+  const iree_io_parameter_index_entry_t* target_entry = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_parameter_index_get(
+      state->target_index, state->target_base_ordinal + entry_ordinal,
+      &target_entry));
+  const iree_io_physical_offset_t target_offset =
+      state->target_file_offset + target_entry->storage.file.offset;
+  if (target_offset + target_entry->length >
+      state->target_contents.data_length) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "parameter `%.*s` storage out of range of the "
+                            "target file",
+                            (int)target_entry->key.size,
+                            target_entry->key.data);
+  }
+  iree_io_file_mapping_t* mapping = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_build_parameter_archive_map_entry(
+      source_entry, state->host_allocator, &mapping));
+  iree_const_byte_span_t contents = iree_io_file_mapping_contents_ro(mapping);
+  memcpy(state->target_contents.data + target_offset, contents.data,
+         contents.data_length);
+  iree_io_file_mapping_release(mapping);
+  return iree_ok_status();
+}
+
+// Copies the contents of all data entries owning their storage through
+// |target_stream|, one entry at a time.
+static iree_status_t iree_io_build_parameter_archive_copy_entries_serial(
+    iree_io_build_parameter_archive_state_t* state,
+    iree_io_stream_t* target_stream) {
+  for (iree_host_size_t i = 0; i < state->entry_count; ++i) {
+    if (state->storage_ordinals[i] != i) continue;
+    const iree_io_parameter_index_entry_t* source_entry = NULL;
+    IREE_RETURN_IF_ERROR(
+        iree_io_parameter_index_get(state->source_index, i, &source_entry));
+    switch (source_entry->type) {
+      case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_SPLAT:
+        // No work to do.
+        break;
+      case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE: {
+        const iree_io_parameter_index_entry_t* target_entry = NULL;
+        IREE_RETURN_IF_ERROR(iree_io_parameter_index_get(
+            state->target_index, state->target_base_ordinal + i,
+            &target_entry));
+        IREE_RETURN_IF_ERROR(iree_io_stream_seek(
+            target_stream, IREE_IO_STREAM_SEEK_SET,
+            state->target_file_offset + target_entry->storage.file.offset));
+        IREE_RETURN_IF_ERROR(iree_io_stream_write_file(
+            target_stream, source_entry->storage.file.handle,
+            source_entry->storage.file.offset, target_entry->length,
+            state->host_allocator));
+        break;
+      }
+      default:
+        return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                                "unhandled index entry storage type %d",
+                                (int)source_entry->type);
+    }
+  }
+  return iree_ok_status();
+}
+
 IREE_API_EXPORT iree_status_t iree_io_build_parameter_archive(
     iree_io_parameter_index_t* source_index,
     iree_io_parameter_index_t* target_index,
     iree_io_parameter_archive_file_open_callback_t target_file_open,
     iree_io_physical_offset_t target_file_offset,
     iree_allocator_t host_allocator) {
+  const iree_io_build_parameter_archive_options_t options = {
+      .flags = IREE_IO_BUILD_PARAMETER_ARCHIVE_FLAG_NONE,
+      .max_concurrency = 0,
+  };
+  return iree_io_build_parameter_archive_with_options(
+      source_index, target_index, target_file_open, target_file_offset,
+      &options, /*out_statistics=*/NULL, host_allocator);
+}
+
+IREE_API_EXPORT iree_status_t iree_io_build_parameter_archive_with_options(
+    iree_io_parameter_index_t* source_index,
+    iree_io_parameter_index_t* target_index,
+    iree_io_parameter_archive_file_open_callback_t target_file_open,
+    iree_io_physical_offset_t target_file_offset,
+    const iree_io_build_parameter_archive_options_t* options,
+    iree_io_build_parameter_archive_statistics_t* out_statistics,
+    iree_allocator_t host_allocator) {
   IREE_ASSERT_ARGUMENT(source_index);
   IREE_ASSERT_ARGUMENT(target_index);
   IREE_ASSERT_ARGUMENT(target_file_open.fn);
+  IREE_ASSERT_ARGUMENT(options);
+  if (out_statistics) memset(out_statistics, 0, sizeof(*out_statistics));
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // Allocate per-entry state in one slab.
+  iree_io_build_parameter_archive_state_t state = {
+      .source_index = source_index,
+      .entry_count = iree_io_parameter_index_count(source_index),
+      .max_concurrency =
+          options->max_concurrency
+              ? options->max_concurrency
+              : IREE_IO_BUILD_PARAMETER_ARCHIVE_DEFAULT_CONCURRENCY,
+      .host_allocator = host_allocator,
+      .target_index = target_index,
+      .target_base_ordinal = iree_io_parameter_index_count(target_index),
+      .target_file_offset = target_file_offset,
+  };
+  const iree_host_size_t entry_state_size = sizeof(state.hashes[0]) +
+                                            sizeof(state.statuses[0]) +
+                                            sizeof(state.storage_ordinals[0]);
+  uint8_t* slab = NULL;
+  if (state.entry_count > 0) {
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, iree_allocator_malloc(host_allocator,
+                                  state.entry_count * entry_state_size,
+                                  (void**)&slab));
+  }
+  state.hashes = (uint64_t*)slab;
+  state.statuses = (iree_status_t*)(state.hashes + state.entry_count);
+  state.storage_ordinals =
+      (iree_host_size_t*)(state.statuses + state.entry_count);
+  for (iree_host_size_t i = 0; i < state.entry_count; ++i) {
+    state.storage_ordinals[i] = i;
+  }
+
+  // Find entries with identical contents. This requires reading all of the
+  // source data and is the expensive part of deduplication.
+  iree_status_t status = iree_ok_status();
+  if (iree_all_bits_set(options->flags,
+                        IREE_IO_BUILD_PARAMETER_ARCHIVE_FLAG_DEDUPLICATE)) {
+    status = iree_io_build_parameter_archive_for_each_entry(
+        &state, iree_io_build_parameter_archive_hash_entry);
+    if (iree_status_is_ok(status)) {
+      status = iree_io_build_parameter_archive_deduplicate(&state);
+    }
+  }
+
   iree_io_parameter_archive_builder_t builder;
   iree_io_parameter_archive_builder_initialize(host_allocator, &builder);
 
   // Declare a parameter for each entry in the index.
   // This lets us calculate the size we require to store the entry metadata and
-  // its contents (if any). No data is accessed yet.
-  iree_status_t status = iree_ok_status();
-  for (iree_host_size_t i = 0; i < iree_io_parameter_index_count(source_index);
-       ++i) {
+  // its contents (if any). Duplicate entries alias the storage of the first
+  // entry with the same contents.
+  iree_io_build_parameter_archive_statistics_t statistics = {
+      .entry_count = state.entry_count,
+  };
+  for (iree_host_size_t i = 0;
+       iree_status_is_ok(status) && i < state.entry_count; ++i) {
     const iree_io_parameter_index_entry_t* source_entry = NULL;
     status = iree_io_parameter_index_get(source_index, i, &source_entry);
     if (!iree_status_is_ok(status)) break;
@@ -334,10 +749,19 @@ IREE_API_EXPORT iree_status_t iree_io_build_parameter_archive(
             source_entry->storage.splat.pattern_length, source_entry->length);
         break;
       case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE:
-        status = iree_io_parameter_archive_builder_add_data_entry(
-            &builder, source_entry->key, source_entry->metadata,
-            IREE_IO_PARAMETER_ARCHIVE_DEFAULT_DATA_ALIGNMENT,
-            source_entry->length);
+        statistics.data_length += source_entry->length;
+        if (state.storage_ordinals[i] != i) {
+          ++statistics.deduplicated_entry_count;
+          status = iree_io_parameter_archive_builder_add_alias_entry(
+              &builder, source_entry->key, source_entry->metadata,
+              state.storage_ordinals[i]);
+        } else {
+          statistics.stored_data_length += source_entry->length;
+          status = iree_io_parameter_archive_builder_add_data_entry(
+              &builder, source_entry->key, source_entry->metadata,
+              IREE_IO_PARAMETER_ARCHIVE_DEFAULT_DATA_ALIGNMENT,
+              source_entry->length);
+        }
         break;
       default:
         status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
@@ -345,7 +769,6 @@ IREE_API_EXPORT iree_status_t iree_io_build_parameter_archive(
                                   (int)source_entry->type);
         break;
     }
-    if (!iree_status_is_ok(status)) break;
   }
 
   // Open a file of sufficient size (now that we know it) for writing.
@@ -375,40 +798,24 @@ IREE_API_EXPORT iree_status_t iree_io_build_parameter_archive(
         target_index);
   }
 
-  // Copy over parameter entry file contents (if any).
-  // This is a slow operation and something we could optimize with lower-level
-  // platform primitives.
+  // Copy over parameter entry file contents (if any). When the target file is
+  // in host memory each entry is copied directly from a mapping of its source
+  // in parallel. Otherwise the single target stream is used to write them one
+  // at a time.
   if (iree_status_is_ok(status)) {
-    for (iree_host_size_t i = 0;
-         i < iree_io_parameter_index_count(source_index); ++i) {
-      const iree_io_parameter_index_entry_t* source_entry = NULL;
-      status = iree_io_parameter_index_get(source_index, i, &source_entry);
-      if (!iree_status_is_ok(status)) break;
-      const iree_io_parameter_index_entry_t* target_entry = NULL;
-      status = iree_io_parameter_index_lookup(target_index, source_entry->key,
-                                              &target_entry);
-      if (!iree_status_is_ok(status)) break;
-      switch (source_entry->type) {
-        case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_SPLAT:
-          // No work to do.
-          break;
-        case IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE:
-          status = iree_io_stream_seek(
-              target_stream, IREE_IO_STREAM_SEEK_SET,
-              target_file_offset + target_entry->storage.file.offset);
-          if (!iree_status_is_ok(status)) break;
-          status = iree_io_stream_write_file(
-              target_stream, source_entry->storage.file.handle,
-              source_entry->storage.file.offset, target_entry->length,
-              host_allocator);
-          break;
-        default:
-          status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
-                                    "unhandled index entry storage type %d",
-                                    (int)source_entry->type);
-          break;
-      }
-      if (!iree_status_is_ok(status)) break;
+    iree_io_file_handle_primitive_t target_primitive =
+        iree_io_file_handle_primitive(target_file_handle);
+    iree_byte_span_t host_allocation = target_primitive.value.host_allocation;
+    if (target_primitive.type == IREE_IO_FILE_HANDLE_TYPE_HOST_ALLOCATION &&
+        target_file_offset <= host_allocation.data_length) {
+      state.target_contents = iree_make_byte_span(
+          host_allocation.data + target_file_offset,
+          host_allocation.data_length - target_file_offset);
+      status = iree_io_build_parameter_archive_for_each_entry(
+          &state, iree_io_build_parameter_archive_copy_entry);
+    } else {
+      status = iree_io_build_parameter_archive_copy_entries_serial(
+          &state, target_stream);
     }
   }
 
@@ -420,8 +827,13 @@ IREE_API_EXPORT iree_status_t iree_io_build_parameter_archive(
     status = iree_io_file_handle_flush(target_file_handle);
   }
 
+  if (iree_status_is_ok(status) && out_statistics) {
+    *out_statistics = statistics;
+  }
+
   iree_io_file_handle_release(target_file_handle);
   iree_io_parameter_archive_builder_deinitialize(&builder);
+  iree_allocator_free(host_allocator, slab);
 
   IREE_TRACE_ZONE_END(z0);
   return status;
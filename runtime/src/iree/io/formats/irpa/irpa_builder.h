@@ -92,6 +92,15 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_archive_builder_add_data_entry(
     iree_const_byte_span_t metadata, iree_io_physical_size_t minimum_alignment,
     iree_io_physical_size_t data_length);
 
+// Adds a new data entry to |builder| that shares the physical storage of the
+// data entry at |target_ordinal| (entries are numbered in the order they were
+// added). No additional storage is allocated and the shared contents only
+// need to be written once. |metadata| (if provided) is copied prior to
+// returning.
+IREE_API_EXPORT iree_status_t iree_io_parameter_archive_builder_add_alias_entry(
+    iree_io_parameter_archive_builder_t* builder, iree_string_view_t name,
+    iree_const_byte_span_t metadata, iree_host_size_t target_ordinal);
+
 // Callback for opening a file for writing.
 // Implementations need to ensure that at least |archive_length| bytes are
 // available in the file starting at |archive_offset|.
@@ -108,6 +117,44 @@ typedef struct {
   void* user_data;
 } iree_io_parameter_archive_file_open_callback_t;
 
+// Default maximum number of threads used to hash and copy parameter contents
+// by iree_io_build_parameter_archive.
+#define IREE_IO_BUILD_PARAMETER_ARCHIVE_DEFAULT_CONCURRENCY 8
+
+// Bitfield specifying how a parameter archive is built.
+typedef uint32_t iree_io_build_parameter_archive_flags_t;
+enum iree_io_build_parameter_archive_flag_bits_t {
+  IREE_IO_BUILD_PARAMETER_ARCHIVE_FLAG_NONE = 0u,
+  // Stores the contents of data entries with identical bytes once and has all
+  // of them reference the same storage range. Requires reading and hashing all
+  // parameter contents before the archive is written.
+  IREE_IO_BUILD_PARAMETER_ARCHIVE_FLAG_DEDUPLICATE = 1u << 0,
+};
+
+// Options controlling iree_io_build_parameter_archive_with_options.
+typedef struct iree_io_build_parameter_archive_options_t {
+  iree_io_build_parameter_archive_flags_t flags;
+  // Maximum number of threads (including the calling thread) used to hash and
+  // copy parameter contents or 0 for
+  // IREE_IO_BUILD_PARAMETER_ARCHIVE_DEFAULT_CONCURRENCY. Contents are only
+  // copied in parallel when the target file is mapped into host memory.
+  iree_host_size_t max_concurrency;
+} iree_io_build_parameter_archive_options_t;
+
+// Statistics about a parameter archive produced by
+// iree_io_build_parameter_archive_with_options.
+typedef struct iree_io_build_parameter_archive_statistics_t {
+  // Total number of entries in the archive.
+  iree_host_size_t entry_count;
+  // Number of data entries sharing storage with an identical earlier entry.
+  iree_host_size_t deduplicated_entry_count;
+  // Total length of all data entries in bytes.
+  uint64_t data_length;
+  // Length of the data entries in bytes after deduplication. This is the
+  // amount of parameter contents actually written to the archive.
+  uint64_t stored_data_length;
+} iree_io_build_parameter_archive_statistics_t;
+
 // Builds a parameter archive from the given |source_index| and returns a new
 // index in |target_index| referencing the new archive file.
 // The total size of the archive will be calculated and the provided
@@ -121,6 +168,21 @@ IREE_API_EXPORT iree_status_t iree_io_build_parameter_archive(
     iree_io_physical_offset_t target_file_offset,
     iree_allocator_t host_allocator);
 
+// Builds a parameter archive as with iree_io_build_parameter_archive using the
+// provided |options|. If |out_statistics| is provided it will be populated
+// with information about the archive contents.
+//
+// The provided |host_allocator| is used from multiple threads concurrently and
+// must be thread-safe.
+IREE_API_EXPORT iree_status_t iree_io_build_parameter_archive_with_options(
+    iree_io_parameter_index_t* source_index,
+    iree_io_parameter_index_t* target_index,
+    iree_io_parameter_archive_file_open_callback_t target_file_open,
+    iree_io_physical_offset_t target_file_offset,
+    const iree_io_build_parameter_archive_options_t* options,
+    iree_io_build_parameter_archive_statistics_t* out_statistics,
+    iree_allocator_t host_allocator);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
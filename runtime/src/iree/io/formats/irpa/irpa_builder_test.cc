@@ -0,0 +1,162 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/io/formats/irpa/irpa_builder.h"
+
+#include <cstring>
+#include <vector>
+
+#include "iree/io/formats/irpa/irpa_parser.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace {
+
+// Provides the archive file as a host allocation owned by the test.
+static iree_status_t OpenHostAllocation(
+    void* user_data, iree_io_physical_offset_t archive_offset,
+    iree_io_physical_size_t archive_length,
+    iree_io_file_handle_t** out_file_handle) {
+  auto* storage = (std::vector<uint8_t>*)user_data;
+  storage->resize(archive_offset + archive_length);
+  return iree_io_file_handle_wrap_host_allocation(
+      IREE_IO_FILE_ACCESS_READ | IREE_IO_FILE_ACCESS_WRITE,
+      iree_make_byte_span(storage->data(), storage->size()),
+      iree_io_file_handle_release_callback_null(), iree_allocator_system(),
+      out_file_handle);
+}
+
+class IrpaBuilderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Source contents: [a: 64 x 1][b: 64 x 2][c: 64 x 1][d: 32 x 1]
+    // a and c are identical while d is a prefix of both.
+    source_contents_.resize(64 * 3 + 32);
+    memset(source_contents_.data() + 0, 1, 64);
+    memset(source_contents_.data() + 64, 2, 64);
+    memset(source_contents_.data() + 128, 1, 64);
+    memset(source_contents_.data() + 192, 1, 32);
+    IREE_ASSERT_OK(iree_io_file_handle_wrap_host_allocation(
+        IREE_IO_FILE_ACCESS_READ,
+        iree_make_byte_span(source_contents_.data(), source_contents_.size()),
+        iree_io_file_handle_release_callback_null(), iree_allocator_system(),
+        &source_file_));
+    IREE_ASSERT_OK(iree_io_parameter_index_create(iree_allocator_system(),
+                                                  &source_index_));
+    AddSourceEntry("a", 0, 64);
+    AddSourceEntry("b", 64, 64);
+    AddSourceEntry("c", 128, 64);
+    AddSourceEntry("d", 192, 32);
+  }
+
+  void TearDown() override {
+    iree_io_parameter_index_release(source_index_);
+    iree_io_file_handle_release(source_file_);
+  }
+
+  void AddSourceEntry(const char* key, uint64_t offset, uint64_t length) {
+    iree_io_parameter_index_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.key = iree_make_cstring_view(key);
+    entry.length = length;
+    entry.type = IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE;
+    entry.storage.file.handle = source_file_;
+    entry.storage.file.offset = offset;
+    IREE_ASSERT_OK(iree_io_parameter_index_add(source_index_, &entry));
+  }
+
+  // Builds an archive and reparses it into |out_index|.
+  void Build(iree_io_build_parameter_archive_flags_t flags,
+             iree_io_build_parameter_archive_statistics_t* out_statistics,
+             iree_io_parameter_index_t** out_index) {
+    iree_io_parameter_index_t* target_index = NULL;
+    IREE_ASSERT_OK(
+        iree_io_parameter_index_create(iree_allocator_system(), &target_index));
+    iree_io_parameter_archive_file_open_callback_t open_callback = {
+        /*.fn=*/OpenHostAllocation,
+        /*.user_data=*/&archive_contents_,
+    };
+    iree_io_build_parameter_archive_options_t options = {
+        /*.flags=*/flags,
+        /*.max_concurrency=*/4,
+    };
+    IREE_ASSERT_OK(iree_io_build_parameter_archive_with_options(
+        source_index_, target_index, open_callback, /*target_file_offset=*/0,
+        &options, out_statistics, iree_allocator_system()));
+    iree_io_parameter_index_release(target_index);
+
+    iree_io_file_handle_t* archive_file = NULL;
+    IREE_ASSERT_OK(iree_io_file_handle_wrap_host_allocation(
+        IREE_IO_FILE_ACCESS_READ,
+        iree_make_byte_span(archive_contents_.data(), archive_contents_.size()),
+        iree_io_file_handle_release_callback_null(), iree_allocator_system(),
+        &archive_file));
+    IREE_ASSERT_OK(
+        iree_io_parameter_index_create(iree_allocator_system(), out_index));
+    IREE_ASSERT_OK(iree_io_parse_irpa_index(archive_file, *out_index,
+                                            iree_allocator_system()));
+    iree_io_file_handle_release(archive_file);
+  }
+
+  // Returns the archive contents of the entry with |key|.
+  std::vector<uint8_t> ReadEntry(iree_io_parameter_index_t* index,
+                                 const char* key, uint64_t* out_offset) {
+    const iree_io_parameter_index_entry_t* entry = NULL;
+    IREE_CHECK_OK(iree_io_parameter_index_lookup(
+        index, iree_make_cstring_view(key), &entry));
+    *out_offset = entry->storage.file.offset;
+    return std::vector<uint8_t>(
+        archive_contents_.begin() + entry->storage.file.offset,
+        archive_contents_.begin() + entry->storage.file.offset + entry->length);
+  }
+
+  std::vector<uint8_t> source_contents_;
+  iree_io_file_handle_t* source_file_ = NULL;
+  iree_io_parameter_index_t* source_index_ = NULL;
+  std::vector<uint8_t> archive_contents_;
+};
+
+TEST_F(IrpaBuilderTest, NoDeduplication) {
+  iree_io_build_parameter_archive_statistics_t statistics;
+  iree_io_parameter_index_t* index = NULL;
+  Build(IREE_IO_BUILD_PARAMETER_ARCHIVE_FLAG_NONE, &statistics, &index);
+  EXPECT_EQ(statistics.entry_count, 4);
+  EXPECT_EQ(statistics.deduplicated_entry_count, 0);
+  EXPECT_EQ(statistics.data_length, 224);
+  EXPECT_EQ(statistics.stored_data_length, 224);
+
+  uint64_t offset_a = 0, offset_c = 0;
+  EXPECT_EQ(ReadEntry(index, "a", &offset_a), std::vector<uint8_t>(64, 1));
+  EXPECT_EQ(ReadEntry(index, "c", &offset_c), std::vector<uint8_t>(64, 1));
+  EXPECT_NE(offset_a, offset_c);
+  iree_io_parameter_index_release(index);
+}
+
+TEST_F(IrpaBuilderTest, Deduplication) {
+  iree_io_build_parameter_archive_statistics_t statistics;
+  iree_io_parameter_index_t* index = NULL;
+  Build(IREE_IO_BUILD_PARAMETER_ARCHIVE_FLAG_DEDUPLICATE, &statistics, &index);
+  EXPECT_EQ(statistics.entry_count, 4);
+  EXPECT_EQ(statistics.deduplicated_entry_count, 1);
+  EXPECT_EQ(statistics.data_length, 224);
+  EXPECT_EQ(statistics.stored_data_length, 160);
+  EXPECT_EQ(iree_io_parameter_index_count(index), 4);
+
+  // a and c share storage; b and d (a prefix of a) have their own.
+  uint64_t offset_a = 0, offset_b = 0, offset_c = 0, offset_d = 0;
+  EXPECT_EQ(ReadEntry(index, "a", &offset_a), std::vector<uint8_t>(64, 1));
+  EXPECT_EQ(ReadEntry(index, "b", &offset_b), std::vector<uint8_t>(64, 2));
+  EXPECT_EQ(ReadEntry(index, "c", &offset_c), std::vector<uint8_t>(64, 1));
+  EXPECT_EQ(ReadEntry(index, "d", &offset_d), std::vector<uint8_t>(32, 1));
+  EXPECT_EQ(offset_a, offset_c);
+  EXPECT_NE(offset_a, offset_b);
+  EXPECT_NE(offset_a, offset_d);
+  iree_io_parameter_index_release(index);
+}
+
+}  // namespace
+}  // namespace iree
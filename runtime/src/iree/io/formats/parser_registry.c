@@ -6,7 +6,9 @@
 
 #include "iree/io/formats/parser_registry.h"
 
+#include "iree/base/internal/atomics.h"
 #include "iree/base/internal/path.h"
+#include "iree/base/internal/threading.h"
 #include "iree/io/formats/gguf/gguf_parser.h"
 #include "iree/io/formats/irpa/irpa_parser.h"
 #include "iree/io/formats/safetensors/safetensors_parser.h"
@@ -45,3 +47,145 @@ IREE_API_EXPORT iree_status_t iree_io_parse_file_index(
   IREE_TRACE_ZONE_END(z0);
   return status;
 }
+
+typedef struct iree_io_parse_file_indices_state_t {
+  iree_host_size_t request_count;
+  const iree_io_parse_file_request_t* requests;
+  // Transient per-request indices that are merged into the request indices
+  // in order once all files have been parsed.
+  iree_io_parameter_index_t** file_indices;
+  // Per-request parse result.
+  iree_status_t* statuses;
+  // Next request to be claimed by a worker.
+  iree_atomic_int64_t next_request;
+  iree_allocator_t host_allocator;
+} iree_io_parse_file_indices_state_t;
+
+// Claims and parses requests until none remain. Run on each worker thread as
+// well as the calling thread.
+static int iree_io_parse_file_indices_worker(void* entry_arg) {
+  iree_io_parse_file_indices_state_t* state =
+      (iree_io_parse_file_indices_state_t*)entry_arg;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  while (true) {
+    int64_t i = iree_atomic_fetch_add(&state->next_request, 1,
+                                      iree_memory_order_relaxed);
+    if (i >= (int64_t)state->request_count) break;
+    const iree_io_parse_file_request_t* request = &state->requests[i];
+    state->statuses[i] = iree_io_parse_file_index(
+        request->path, request->file_handle, state->file_indices[i],
+        state->host_allocator);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return 0;
+}
+
+// Appends all entries of |source_index| to |target_index|.
+static iree_status_t iree_io_parameter_index_append_all(
+    iree_io_parameter_index_t* source_index,
+    iree_io_parameter_index_t* target_index) {
+  iree_host_size_t count = iree_io_parameter_index_count(source_index);
+  IREE_RETURN_IF_ERROR(iree_io_parameter_index_reserve(
+      target_index, iree_io_parameter_index_count(target_index) + count));
+  for (iree_host_size_t i = 0; i < count; ++i) {
+    const iree_io_parameter_index_entry_t* entry = NULL;
+    IREE_RETURN_IF_ERROR(iree_io_parameter_index_get(source_index, i, &entry));
+    IREE_RETURN_IF_ERROR(iree_io_parameter_index_add(target_index, entry));
+  }
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t iree_io_parse_file_indices(
+    iree_host_size_t request_count,
+    const iree_io_parse_file_request_t* requests,
+    iree_host_size_t max_concurrency, iree_allocator_t host_allocator) {
+  IREE_ASSERT_ARGUMENT(!request_count || requests);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)request_count);
+  if (request_count == 0) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_ok_status();
+  }
+
+  // Allocate the transient state for all requests in one slab.
+  iree_io_parse_file_indices_state_t state = {
+      .request_count = request_count,
+      .requests = requests,
+      .host_allocator = host_allocator,
+  };
+  iree_atomic_store(&state.next_request, 0, iree_memory_order_relaxed);
+  if (max_concurrency == 0) {
+    max_concurrency = IREE_IO_PARSE_FILE_INDICES_DEFAULT_CONCURRENCY;
+  }
+  const iree_host_size_t worker_count =
+      iree_min(max_concurrency, request_count) - 1;
+  uint8_t* slab = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(
+              host_allocator,
+              request_count * (sizeof(state.file_indices[0]) +
+                               sizeof(state.statuses[0])) +
+                  worker_count * sizeof(iree_thread_t*),
+              (void**)&slab));
+  state.file_indices = (iree_io_parameter_index_t**)slab;
+  state.statuses = (iree_status_t*)(slab + request_count *
+                                               sizeof(state.file_indices[0]));
+  iree_thread_t** workers =
+      (iree_thread_t**)(slab + request_count * (sizeof(state.file_indices[0]) +
+                                                sizeof(state.statuses[0])));
+
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < request_count; ++i) {
+    state.file_indices[i] = NULL;
+    state.statuses[i] = iree_ok_status();
+    if (iree_status_is_ok(status)) {
+      status = iree_io_parameter_index_create(host_allocator,
+                                              &state.file_indices[i]);
+    }
+  }
+
+  // Spin up the workers and have the calling thread help out. If a worker
+  // cannot be created the remaining ones pick up its share.
+  iree_host_size_t started_worker_count = 0;
+  if (iree_status_is_ok(status)) {
+    iree_thread_create_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.name = IREE_SV("iree-io-parse");
+    for (iree_host_size_t i = 0; i < worker_count; ++i) {
+      iree_status_t create_status =
+          iree_thread_create(iree_io_parse_file_indices_worker, &state, params,
+                             host_allocator, &workers[started_worker_count]);
+      if (!iree_status_is_ok(create_status)) {
+        iree_status_ignore(create_status);
+        break;
+      }
+      ++started_worker_count;
+    }
+    iree_io_parse_file_indices_worker(&state);
+  }
+  // Releasing the last reference to a thread joins it.
+  for (iree_host_size_t i = 0; i < started_worker_count; ++i) {
+    iree_thread_release(workers[i]);
+  }
+
+  // Report the first failure in request order and only merge the results if
+  // all files parsed successfully.
+  for (iree_host_size_t i = 0; i < request_count; ++i) {
+    if (iree_status_is_ok(status)) {
+      status = state.statuses[i];
+    } else {
+      iree_status_ignore(state.statuses[i]);
+    }
+  }
+  for (iree_host_size_t i = 0; i < request_count; ++i) {
+    if (iree_status_is_ok(status)) {
+      status = iree_io_parameter_index_append_all(state.file_indices[i],
+                                                  requests[i].index);
+    }
+    iree_io_parameter_index_release(state.file_indices[i]);
+  }
+
+  iree_allocator_free(host_allocator, slab);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
@@ -26,6 +26,41 @@ IREE_API_EXPORT iree_status_t iree_io_parse_file_index(
     iree_string_view_t path, iree_io_file_handle_t* file_handle,
     iree_io_parameter_index_t* index, iree_allocator_t host_allocator);
 
+// A parameter file to be parsed by iree_io_parse_file_indices.
+typedef struct iree_io_parse_file_request_t {
+  // Path used for logging and file format identification as with
+  // iree_io_parse_file_index.
+  iree_string_view_t path;
+  // File to parse. Retained by |index| if it contains any parameters.
+  iree_io_file_handle_t* file_handle;
+  // Index the parameters in the file are appended to. Multiple requests may
+  // share the same index.
+  iree_io_parameter_index_t* index;
+} iree_io_parse_file_request_t;
+
+// Default maximum number of files parsed concurrently by
+// iree_io_parse_file_indices. Parsing is dominated by I/O latency (especially
+// on network storage) and not CPU time so this is not tied to the core count.
+#define IREE_IO_PARSE_FILE_INDICES_DEFAULT_CONCURRENCY 16
+
+// Parses all |requests| with up to |max_concurrency| files in flight at a
+// time (or IREE_IO_PARSE_FILE_INDICES_DEFAULT_CONCURRENCY if 0). This is
+// intended for checkpoints sharded across many files where parsing them one
+// at a time is bound by the latency of each header read.
+//
+// Entries are appended to each request index in request order regardless of
+// which file finishes parsing first so lookups of duplicate keys behave the
+// same as if each file were parsed in order with iree_io_parse_file_index.
+// If any file fails to parse the first failure in request order is returned
+// and no entries from any file are appended.
+//
+// The provided |host_allocator| is used from multiple threads concurrently and
+// must be thread-safe (unlike iree_io_parse_file_index it may not be an arena).
+IREE_API_EXPORT iree_status_t iree_io_parse_file_indices(
+    iree_host_size_t request_count,
+    const iree_io_parse_file_request_t* requests,
+    iree_host_size_t max_concurrency, iree_allocator_t host_allocator);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -0,0 +1,227 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/file_io.h"
+#include "iree/base/internal/flags.h"
+#include "iree/io/formats/parser_registry.h"
+#include "iree/testing/benchmark.h"
+
+IREE_FLAG(string, shard_dir, "",
+          "Directory the synthetic checkpoint shards are written to. Defaults "
+          "to $TEST_TMPDIR or $TMPDIR. Point this at network storage to see "
+          "the effect of per-file latency.");
+
+IREE_FLAG(int32_t, shard_count, 500,
+          "Number of .safetensors shards in the synthetic checkpoint.");
+
+IREE_FLAG(int32_t, tensors_per_shard, 16, "Number of tensors in each shard.");
+
+IREE_FLAG(int32_t, tensor_size, 64 * 1024,
+          "Size in bytes of each tensor. Tensor data is never read by the "
+          "parsers but larger files make whole-file mapping more expensive.");
+
+IREE_FLAG(int32_t, max_concurrency, 0,
+          "Maximum number of shards parsed concurrently by the parallel "
+          "benchmark; 0 uses the default.");
+
+// Paths of all generated shards. Freed at exit.
+static char** shard_paths = NULL;
+
+// Returns the directory that shards should be written to.
+static const char* iree_io_benchmark_shard_dir(void) {
+  if (strlen(FLAG_shard_dir) > 0) return FLAG_shard_dir;
+  const char* dir = getenv("TEST_TMPDIR");
+  if (!dir) dir = getenv("TMPDIR");
+  if (!dir) dir = "/tmp";
+  return dir;
+}
+
+// Writes a single shard with FLAG_tensors_per_shard tensors to |path|.
+static iree_status_t iree_io_benchmark_write_shard(const char* path,
+                                                   int32_t shard_ordinal) {
+  iree_allocator_t host_allocator = iree_allocator_system();
+  iree_string_builder_t builder;
+  iree_string_builder_initialize(host_allocator, &builder);
+
+  // Reserve space for the header length and then append the JSON header.
+  // Each tensor is a 1-D byte array to keep the offsets trivially correct.
+  iree_status_t status =
+      iree_string_builder_append_string(&builder, IREE_SV("01234567{"));
+  const uint64_t tensor_size = (uint64_t)FLAG_tensor_size;
+  for (int32_t i = 0; i < FLAG_tensors_per_shard && iree_status_is_ok(status);
+       ++i) {
+    status = iree_string_builder_append_format(
+        &builder,
+        "\"layers.%d.tensor_%d.weight\":{\"dtype\":\"U8\",\"shape\":[%" PRIu64
+        "],\"data_offsets\":[%" PRIu64 ",%" PRIu64 "]},",
+        shard_ordinal, i, tensor_size, i * tensor_size, (i + 1) * tensor_size);
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_string_builder_append_string(
+        &builder, IREE_SV("\"__metadata__\":{\"format\":\"pt\"}}"));
+  }
+  // The data that follows is conventionally 8-byte aligned.
+  while (iree_status_is_ok(status) &&
+         iree_string_builder_size(&builder) % 8 != 0) {
+    status = iree_string_builder_append_string(&builder, IREE_SV(" "));
+  }
+
+  uint8_t* file_data = NULL;
+  iree_host_size_t header_size = iree_string_builder_size(&builder);
+  iree_host_size_t file_size =
+      header_size + (iree_host_size_t)(FLAG_tensors_per_shard * tensor_size);
+  if (iree_status_is_ok(status)) {
+    status = iree_allocator_malloc(host_allocator, file_size,
+                                   (void**)&file_data);
+  }
+  if (iree_status_is_ok(status)) {
+    memcpy(file_data, iree_string_builder_buffer(&builder), header_size);
+    iree_unaligned_store_le_u64((uint64_t*)file_data, header_size - 8);
+    memset(file_data + header_size, 0, file_size - header_size);
+    status = iree_file_write_contents(
+        path, iree_make_const_byte_span(file_data, file_size));
+  }
+
+  iree_allocator_free(host_allocator, file_data);
+  iree_string_builder_deinitialize(&builder);
+  return status;
+}
+
+// Writes the synthetic checkpoint once for all benchmarks.
+static iree_status_t iree_io_benchmark_write_checkpoint(void) {
+  const char* dir = iree_io_benchmark_shard_dir();
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      iree_allocator_system(), FLAG_shard_count * sizeof(shard_paths[0]),
+      (void**)&shard_paths));
+  for (int32_t i = 0; i < FLAG_shard_count; ++i) {
+    char path[2048];
+    snprintf(path, sizeof(path), "%s/model-%05d-of-%05d.safetensors", dir,
+             i + 1, FLAG_shard_count);
+    shard_paths[i] = strdup(path);
+    IREE_RETURN_IF_ERROR(iree_io_benchmark_write_shard(path, i));
+  }
+  return iree_ok_status();
+}
+
+static void iree_io_benchmark_delete_checkpoint(void) {
+  if (!shard_paths) return;
+  for (int32_t i = 0; i < FLAG_shard_count; ++i) {
+    if (shard_paths[i]) remove(shard_paths[i]);
+    free(shard_paths[i]);
+  }
+  iree_allocator_free(iree_allocator_system(), shard_paths);
+  shard_paths = NULL;
+}
+
+// Opens all shards. Included in the timing as opening is part of the
+// per-file cost on network storage.
+static void iree_io_benchmark_open_shards(
+    iree_io_parameter_index_t* index, iree_allocator_t host_allocator,
+    iree_io_parse_file_request_t* requests) {
+  for (int32_t i = 0; i < FLAG_shard_count; ++i) {
+    requests[i].path = iree_make_cstring_view(shard_paths[i]);
+    requests[i].index = index;
+    IREE_CHECK_OK(iree_io_file_handle_open(IREE_IO_FILE_MODE_READ,
+                                           requests[i].path, host_allocator,
+                                           &requests[i].file_handle));
+  }
+}
+
+static void iree_io_benchmark_close_shards(
+    iree_io_parse_file_request_t* requests) {
+  for (int32_t i = 0; i < FLAG_shard_count; ++i) {
+    iree_io_file_handle_release(requests[i].file_handle);
+  }
+}
+
+// Parses all shards one at a time with iree_io_parse_file_index.
+static iree_status_t iree_io_benchmark_parse_serial(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_allocator_t host_allocator = benchmark_state->host_allocator;
+  iree_io_parse_file_request_t* requests = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      host_allocator, FLAG_shard_count * sizeof(requests[0]),
+      (void**)&requests));
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    iree_io_parameter_index_t* index = NULL;
+    IREE_CHECK_OK(iree_io_parameter_index_create(host_allocator, &index));
+    iree_io_benchmark_open_shards(index, host_allocator, requests);
+    for (int32_t i = 0; i < FLAG_shard_count; ++i) {
+      IREE_CHECK_OK(iree_io_parse_file_index(requests[i].path,
+                                             requests[i].file_handle, index,
+                                             host_allocator));
+    }
+    iree_io_benchmark_close_shards(requests);
+    iree_io_parameter_index_release(index);
+  }
+  iree_allocator_free(host_allocator, requests);
+  return iree_ok_status();
+}
+
+// Parses all shards concurrently with iree_io_parse_file_indices.
+static iree_status_t iree_io_benchmark_parse_parallel(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_allocator_t host_allocator = benchmark_state->host_allocator;
+  iree_io_parse_file_request_t* requests = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      host_allocator, FLAG_shard_count * sizeof(requests[0]),
+      (void**)&requests));
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    iree_io_parameter_index_t* index = NULL;
+    IREE_CHECK_OK(iree_io_parameter_index_create(host_allocator, &index));
+    iree_io_benchmark_open_shards(index, host_allocator, requests);
+    IREE_CHECK_OK(iree_io_parse_file_indices(FLAG_shard_count, requests,
+                                             FLAG_max_concurrency,
+                                             host_allocator));
+    iree_io_benchmark_close_shards(requests);
+    iree_io_parameter_index_release(index);
+  }
+  iree_allocator_free(host_allocator, requests);
+  return iree_ok_status();
+}
+
+int main(int argc, char** argv) {
+  iree_flags_set_usage(
+      "parser_registry_benchmark",
+      "Benchmarks indexing a synthetic checkpoint sharded across many\n"
+      ".safetensors files, parsing shards serially and in parallel.\n"
+      "\n"
+      "Example:\n"
+      "  parser_registry_benchmark --shard_dir=/mnt/nfs/scratch/\n"
+      "\n");
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
+  iree_benchmark_initialize(&argc, argv);
+  iree_status_t status = iree_io_benchmark_write_checkpoint();
+  if (!iree_status_is_ok(status)) {
+    iree_io_benchmark_delete_checkpoint();
+    IREE_CHECK_OK(status);
+  }
+
+  iree_benchmark_def_t benchmark_def = {
+      .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+               IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+      .time_unit = IREE_BENCHMARK_UNIT_MILLISECOND,
+      .minimum_duration_ns = 0,
+      .iteration_count = 0,
+      .run = iree_io_benchmark_parse_serial,
+  };
+  iree_benchmark_register(IREE_SV("parse_serial"), &benchmark_def);
+  benchmark_def.run = iree_io_benchmark_parse_parallel;
+  iree_benchmark_register(IREE_SV("parse_parallel"), &benchmark_def);
+
+  iree_benchmark_run_specified();
+
+  iree_io_benchmark_delete_checkpoint();
+  return 0;
+}
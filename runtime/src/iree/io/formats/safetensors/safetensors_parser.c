@@ -128,24 +128,40 @@ static iree_status_t iree_json_consume_keyword(iree_string_view_t* str,
 
 // Consumes a number from |str| and returns as declared, updating |str| to
 // point immediately after the last character that could compose the number.
-// Assumes the input starts with `number` in the spec.
+// Assumes the input starts with `number` in the spec:
+//  number:
+//   '-'? ('0' | [1-9] digits) ('.' digits)? ([eE] [+-]? digits)?
+// The returned value is not converted; callers that need integers use
+// iree_string_view_atoi_* on the span and all others only need to skip it.
 static iree_status_t iree_json_consume_number(iree_string_view_t* str,
                                               iree_string_view_t* out_value) {
-  // TODO(benvanik): support real numbers - for now we only handle integers
-  // because we are lazy. We scan for digits 0-9 until any non-digit is hit and
-  // then call it good.
-  iree_host_size_t break_pos = 0;
-  for (iree_host_size_t i = 0; i < str->size; ++i) {
-    if (!isdigit(str->data[i])) {
-      break_pos = i;
-      break;
+  iree_host_size_t i = 0;
+  if (i < str->size && str->data[i] == '-') ++i;
+  iree_host_size_t integer_start = i;
+  while (i < str->size && isdigit(str->data[i])) ++i;
+  if (i == integer_start) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT, "invalid number");
+  }
+  if (i < str->size && str->data[i] == '.') {
+    iree_host_size_t fraction_start = ++i;
+    while (i < str->size && isdigit(str->data[i])) ++i;
+    if (i == fraction_start) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "invalid number fraction");
     }
   }
-  if (break_pos == 0) {
-    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT, "invalid number");
+  if (i < str->size && (str->data[i] == 'e' || str->data[i] == 'E')) {
+    ++i;
+    if (i < str->size && (str->data[i] == '+' || str->data[i] == '-')) ++i;
+    iree_host_size_t exponent_start = i;
+    while (i < str->size && isdigit(str->data[i])) ++i;
+    if (i == exponent_start) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "invalid number exponent");
+    }
   }
-  *out_value = iree_string_view_substr(*str, 0, break_pos);
-  *str = iree_string_view_remove_prefix(*str, break_pos);
+  *out_value = iree_string_view_substr(*str, 0, i);
+  *str = iree_string_view_remove_prefix(*str, i);
   return iree_ok_status();
 }
 
@@ -455,6 +471,54 @@ static iree_status_t iree_io_enumerate_safetensors_entries(
   return iree_io_parameter_index_add(entry_state->index, &entry);
 }
 
+// Maximum size of the header JSON blob. The reference implementation rejects
+// anything larger and it keeps a corrupt length from turning into a huge
+// transient allocation when streaming.
+#define IREE_IO_SAFETENSORS_MAX_HEADER_LENGTH (100 * 1024 * 1024)
+
+// Validates the |header_length| read from the start of a file of
+// |file_length| total bytes.
+static iree_status_t iree_io_verify_safetensors_header_length(
+    uint64_t header_length, uint64_t file_length) {
+  uint64_t remaining_bytes = file_length - sizeof(header_length);
+  if (remaining_bytes < header_length) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "insufficient capacity for safetensors header "
+                            "contents (declared as %" PRIu64
+                            " but only %" PRIu64 " bytes available)",
+                            header_length, remaining_bytes);
+  }
+  if (header_length < 2) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "safetensors header must contain a JSON object");
+  }
+  if (header_length > IREE_IO_SAFETENSORS_MAX_HEADER_LENGTH) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "safetensors header length %" PRIu64
+                            " exceeds the maximum of %d bytes",
+                            header_length,
+                            IREE_IO_SAFETENSORS_MAX_HEADER_LENGTH);
+  }
+  return iree_ok_status();
+}
+
+// Parses a safetensors |header_json| blob and emits entries to |index|.
+// Each entry is bounds checked against the |data_size| of the file (bytes
+// excluding the header, relative to |base_offset|).
+static iree_status_t iree_io_parse_safetensors_header(
+    iree_io_file_handle_t* file_handle, iree_string_view_t header_json,
+    uint64_t base_offset, uint64_t data_size,
+    iree_io_parameter_index_t* index) {
+  iree_io_enumerate_safetensors_entry_state_t enumerate_state = {
+      .file_handle = file_handle,
+      .base_offset = base_offset,
+      .data_size = data_size,
+      .index = index,
+  };
+  return iree_json_enumerate_object(
+      header_json, iree_io_enumerate_safetensors_entries, &enumerate_state);
+}
+
 static iree_status_t iree_io_parse_safetensors_index_from_memory(
     iree_io_file_handle_t* file_handle, iree_const_byte_span_t file_contents,
     iree_io_parameter_index_t* index) {
@@ -462,42 +526,75 @@ static iree_status_t iree_io_parse_safetensors_index_from_memory(
   // offset that all data ranges are relative to. Verifies that the header and
   // base offset is in range but each entry data range still needs to be
   // verified.
-  uint64_t remaining_bytes = file_contents.data_length;
   uint64_t header_length = 0;
-  if (remaining_bytes < sizeof(header_length)) {
+  if (file_contents.data_length < sizeof(header_length)) {
     return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
                             "insufficient capacity for safetensors header "
                             "length (need at least %" PRIhsz
-                            " bytes but have %" PRIu64 ")",
-                            sizeof(header_length), remaining_bytes);
+                            " bytes but have %" PRIhsz ")",
+                            sizeof(header_length), file_contents.data_length);
   }
   header_length =
       iree_unaligned_load_le_u64((const uint64_t*)file_contents.data);
-  remaining_bytes -= sizeof(header_length);
-  if (remaining_bytes < header_length) {
-    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
-                            "insufficient capacity for safetensors header "
-                            "contents (declared as %" PRIu64
-                            " but only %" PRIu64 " bytes available)",
-                            header_length, remaining_bytes);
-  }
+  IREE_RETURN_IF_ERROR(iree_io_verify_safetensors_header_length(
+      header_length, file_contents.data_length));
   const iree_string_view_t header_json = iree_make_string_view(
       (const char*)file_contents.data + sizeof(header_length),
       (iree_host_size_t)header_length);
   const uint64_t base_offset = sizeof(header_length) + header_length;
-  remaining_bytes -= header_length;
+  return iree_io_parse_safetensors_header(
+      file_handle, header_json, base_offset,
+      file_contents.data_length - base_offset, index);
+}
 
-  // Parses a safetensors |header_json| blob and emits entries to |index|.
-  // Each entry is bounds checked against the |data_size| of the file (bytes
-  // excluding the header, relative to |base_offset|).
-  iree_io_enumerate_safetensors_entry_state_t enumerate_state = {
-      .file_handle = file_handle,
-      .base_offset = base_offset,
-      .data_size = remaining_bytes,
-      .index = index,
-  };
-  return iree_json_enumerate_object(
-      header_json, iree_io_enumerate_safetensors_entries, &enumerate_state);
+IREE_API_EXPORT iree_status_t iree_io_parse_safetensors_index_from_stream(
+    iree_io_file_handle_t* file_handle, iree_io_stream_t* stream,
+    iree_io_parameter_index_t* index, iree_allocator_t host_allocator) {
+  IREE_ASSERT_ARGUMENT(file_handle);
+  IREE_ASSERT_ARGUMENT(stream);
+  IREE_ASSERT_ARGUMENT(index);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Only the length prefix and the JSON blob are read; tensor data is never
+  // touched and the entries reference |file_handle| directly.
+  const uint64_t file_length = (uint64_t)iree_io_stream_length(stream);
+  uint64_t header_length = 0;
+  if (file_length < sizeof(header_length)) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "insufficient capacity for safetensors header "
+                            "length (need at least %" PRIhsz
+                            " bytes but have %" PRIu64 ")",
+                            sizeof(header_length), file_length);
+  }
+  uint8_t header_length_bytes[sizeof(header_length)];
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_io_stream_read(stream, sizeof(header_length_bytes),
+                              header_length_bytes, NULL));
+  header_length =
+      iree_unaligned_load_le_u64((const uint64_t*)header_length_bytes);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_io_verify_safetensors_header_length(header_length, file_length));
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)header_length);
+
+  char* header_json_buffer = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, (iree_host_size_t)header_length,
+                                (void**)&header_json_buffer));
+  iree_status_t status = iree_io_stream_read(
+      stream, (iree_host_size_t)header_length, header_json_buffer, NULL);
+  if (iree_status_is_ok(status)) {
+    const uint64_t base_offset = sizeof(header_length) + header_length;
+    status = iree_io_parse_safetensors_header(
+        file_handle,
+        iree_make_string_view(header_json_buffer,
+                              (iree_host_size_t)header_length),
+        base_offset, file_length - base_offset, index);
+  }
+  iree_allocator_free(host_allocator, header_json_buffer);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
 }
 
 IREE_API_EXPORT iree_status_t iree_io_parse_safetensors_index(
@@ -506,23 +603,30 @@ IREE_API_EXPORT iree_status_t iree_io_parse_safetensors_index(
   IREE_ASSERT_ARGUMENT(index);
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // The parser requires a host pointer but will only reference the file handle
-  // in the index. It'd be easy to change this parser to use stream-based
-  // reading as we could just read the header bytes and JSON blob into transient
-  // memory but the intent is that parameter parsing should not allocate large
-  // amounts of memory and this keeps the behavior consistent with other
-  // implementations.
-  iree_io_file_mapping_t* file_mapping = NULL;
-  IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_io_file_map_view(file_handle, IREE_IO_FILE_ACCESS_READ, 0,
-                                IREE_HOST_SIZE_MAX,
-                                IREE_IO_FILE_MAPPING_FLAG_EXCLUDE_FROM_DUMPS,
-                                host_allocator, &file_mapping));
-
-  iree_status_t status = iree_io_parse_safetensors_index_from_memory(
-      file_handle, iree_io_file_mapping_contents_ro(file_mapping), index);
-
-  iree_io_file_mapping_release(file_mapping);
+  // Files already resident in host memory are parsed in place. Everything
+  // else is streamed so that only the header bytes are read: mapping a file
+  // that lives on network storage just to read a few KB of JSON costs more
+  // than the read itself and the index only references the file handle.
+  iree_status_t status = iree_ok_status();
+  if (iree_io_file_handle_type(file_handle) ==
+      IREE_IO_FILE_HANDLE_TYPE_HOST_ALLOCATION) {
+    iree_byte_span_t host_allocation =
+        iree_io_file_handle_value(file_handle).host_allocation;
+    status = iree_io_parse_safetensors_index_from_memory(
+        file_handle,
+        iree_make_const_byte_span(host_allocation.data,
+                                  host_allocation.data_length),
+        index);
+  } else {
+    iree_io_stream_t* stream = NULL;
+    status = iree_io_stream_open(IREE_IO_STREAM_MODE_READABLE, file_handle,
+                                 /*file_offset=*/0, host_allocator, &stream);
+    if (iree_status_is_ok(status)) {
+      status = iree_io_parse_safetensors_index_from_stream(
+          file_handle, stream, index, host_allocator);
+    }
+    iree_io_stream_release(stream);
+  }
 
   IREE_TRACE_ZONE_END(z0);
   return status;
@@ -103,5 +103,69 @@ TEST(SafetensorsFormatTest, MultipleTensors) {
   iree_io_parameter_index_release(index);
 }
 
+TEST(SafetensorsFormatTest, MultipleTensorsFromStream) {
+  iree_io_parameter_index_t* index = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_create(iree_allocator_system(), &index));
+
+  iree_io_file_handle_t* file_handle = OpenTestFile("multiple.safetensors");
+  iree_io_stream_t* stream = NULL;
+  IREE_ASSERT_OK(iree_io_stream_open(IREE_IO_STREAM_MODE_READABLE, file_handle,
+                                     /*file_offset=*/0, iree_allocator_system(),
+                                     &stream));
+  IREE_ASSERT_OK(iree_io_parse_safetensors_index_from_stream(
+      file_handle, stream, index, iree_allocator_system()));
+  iree_io_stream_release(stream);
+  iree_io_file_handle_release(file_handle);
+
+  const iree_io_parameter_index_entry_t* entry0 = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_lookup(index, IREE_SV("tensor0"), &entry0));
+  EXPECT_EQ(entry0->storage.file.offset, 200);
+  EXPECT_EQ(entry0->length, 16);
+
+  const iree_io_parameter_index_entry_t* entry2 = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_lookup(index, IREE_SV("tensor2"), &entry2));
+  EXPECT_EQ(entry2->storage.file.offset, 224);
+  EXPECT_EQ(entry2->length, 48);
+
+  iree_io_parameter_index_release(index);
+}
+
+// Metadata values are skipped but must still be scanned correctly, including
+// real numbers and nested values.
+TEST(SafetensorsFormatTest, MetadataWithRealNumbers) {
+  iree_io_parameter_index_t* index = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_create(iree_allocator_system(), &index));
+
+  const char header[] =
+      "{\"__metadata__\":{\"lr\":-1.5e-3,\"scale\":0.25,\"n\":[1,2E+2]},"
+      "\"tensor0\":{\"dtype\":\"F32\",\"shape\":[2],"
+      "\"data_offsets\":[0,8]}}";
+  const uint64_t header_length = sizeof(header) - 1;
+  uint8_t file_data[8 + sizeof(header) - 1 + 8] = {0};
+  memcpy(file_data, &header_length, sizeof(header_length));
+  memcpy(file_data + 8, header, header_length);
+  iree_io_file_handle_t* file_handle = NULL;
+  IREE_ASSERT_OK(iree_io_file_handle_wrap_host_allocation(
+      IREE_IO_FILE_ACCESS_READ,
+      iree_make_byte_span(file_data, sizeof(file_data)),
+      iree_io_file_handle_release_callback_null(), iree_allocator_system(),
+      &file_handle));
+  IREE_ASSERT_OK(iree_io_parse_safetensors_index(file_handle, index,
+                                                 iree_allocator_system()));
+  iree_io_file_handle_release(file_handle);
+
+  const iree_io_parameter_index_entry_t* entry0 = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_lookup(index, IREE_SV("tensor0"), &entry0));
+  EXPECT_EQ(entry0->storage.file.offset, 8 + header_length);
+  EXPECT_EQ(entry0->length, 8);
+
+  iree_io_parameter_index_release(index);
+}
+
 }  // namespace
 }  // namespace iree
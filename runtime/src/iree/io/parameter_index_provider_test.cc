@@ -0,0 +1,256 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/io/parameter_index_provider.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/io/file_handle.h"
+#include "iree/io/parameter_index.h"
+#include "iree/io/parameter_provider.h"
+#include "iree/io/stream.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+using iree::Status;
+using iree::StatusCode;
+using iree::testing::status::StatusIs;
+
+// Records each progress callback and optionally fails after some count.
+struct ProgressRecorder {
+  std::vector<std::pair<uint64_t, uint64_t>> calls;
+  int fail_after = -1;
+
+  static iree_status_t Callback(void* user_data, uint64_t completed_bytes,
+                                uint64_t total_bytes) {
+    ProgressRecorder* recorder = (ProgressRecorder*)user_data;
+    recorder->calls.emplace_back(completed_bytes, total_bytes);
+    if (recorder->fail_after >= 0 &&
+        (int)recorder->calls.size() > recorder->fail_after) {
+      return iree_make_status(IREE_STATUS_CANCELLED, "test cancellation");
+    }
+    return iree_ok_status();
+  }
+
+  iree_io_parameter_prefetch_progress_t Get() {
+    iree_io_parameter_prefetch_progress_t progress;
+    progress.fn = Callback;
+    progress.user_data = this;
+    return progress;
+  }
+};
+
+// Builds a provider with a parameter in a host allocation, a parameter in a
+// platform file (when available), and a splat parameter.
+class ParameterIndexProviderPrefetchTest : public ::testing::Test {
+ protected:
+  static constexpr uint64_t kMemoryLength = 16 * 1024 + 5;
+  static constexpr uint64_t kFileLength = 64 * 1024 + 9;
+
+  void SetUp() override {
+    IREE_ASSERT_OK(
+        iree_io_parameter_index_create(iree_allocator_system(), &index_));
+
+    memory_storage_.resize(kMemoryLength + 128, 0xAB);
+    IREE_ASSERT_OK(iree_io_file_handle_wrap_host_allocation(
+        IREE_IO_FILE_ACCESS_READ,
+        iree_make_byte_span(memory_storage_.data(), memory_storage_.size()),
+        iree_io_file_handle_release_callback_null(), iree_allocator_system(),
+        &memory_handle_));
+    AddFileEntry("memory", memory_handle_, /*offset=*/128, kMemoryLength);
+
+#if IREE_FILE_IO_ENABLE
+    path_ = ::testing::TempDir() + "/iree_io_parameter_index_provider_test_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::remove(path_.c_str());
+    IREE_ASSERT_OK(iree_io_file_handle_create(
+        IREE_IO_FILE_MODE_READ | IREE_IO_FILE_MODE_WRITE,
+        iree_make_string_view(path_.data(), path_.size()),
+        /*initial_size=*/0, iree_allocator_system(), &file_handle_));
+    std::vector<uint8_t> file_contents(kFileLength + 64, 0xCD);
+    iree_io_stream_t* stream = NULL;
+    IREE_ASSERT_OK(iree_io_stream_open(
+        IREE_IO_STREAM_MODE_WRITABLE, file_handle_, /*file_offset=*/0,
+        iree_allocator_system(), &stream));
+    IREE_ASSERT_OK(iree_io_stream_write(stream, file_contents.size(),
+                                        file_contents.data()));
+    iree_io_stream_release(stream);
+    AddFileEntry("file", file_handle_, /*offset=*/64, kFileLength);
+#endif  // IREE_FILE_IO_ENABLE
+
+    iree_io_parameter_index_entry_t splat_entry;
+    memset(&splat_entry, 0, sizeof(splat_entry));
+    splat_entry.key = IREE_SV("splat");
+    splat_entry.length = 1024 * 1024;
+    splat_entry.type = IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_SPLAT;
+    splat_entry.storage.splat.pattern_length = 1;
+    IREE_ASSERT_OK(iree_io_parameter_index_add(index_, &splat_entry));
+
+    IREE_ASSERT_OK(iree_io_parameter_index_provider_create(
+        IREE_SV("scope"), index_,
+        /*max_concurrent_operations=*/
+        IREE_IO_PARAMETER_INDEX_PROVIDER_DEFAULT_MAX_CONCURRENT_OPERATIONS,
+        iree_allocator_system(), &provider_));
+  }
+
+  void TearDown() override {
+    iree_io_parameter_provider_release(provider_);
+    iree_io_parameter_index_release(index_);
+    iree_io_file_handle_release(memory_handle_);
+#if IREE_FILE_IO_ENABLE
+    iree_io_file_handle_release(file_handle_);
+    std::remove(path_.c_str());
+#endif  // IREE_FILE_IO_ENABLE
+  }
+
+  void AddFileEntry(const char* key, iree_io_file_handle_t* handle,
+                    uint64_t offset, uint64_t length) {
+    iree_io_parameter_index_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.key = iree_make_cstring_view(key);
+    entry.length = length;
+    entry.type = IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE;
+    entry.storage.file.handle = handle;
+    entry.storage.file.offset = offset;
+    IREE_ASSERT_OK(iree_io_parameter_index_add(index_, &entry));
+  }
+
+  // Total bytes of all file-backed entries added in SetUp.
+  uint64_t TotalFileBytes() const {
+#if IREE_FILE_IO_ENABLE
+    return kMemoryLength + kFileLength;
+#else
+    return kMemoryLength;
+#endif  // IREE_FILE_IO_ENABLE
+  }
+
+  std::vector<uint8_t> memory_storage_;
+  iree_io_file_handle_t* memory_handle_ = NULL;
+  std::string path_;
+  iree_io_file_handle_t* file_handle_ = NULL;
+  iree_io_parameter_index_t* index_ = NULL;
+  iree_io_parameter_provider_t* provider_ = NULL;
+};
+
+// Hints complete asynchronously and report only the total.
+TEST_F(ParameterIndexProviderPrefetchTest, HintAll) {
+  ProgressRecorder progress;
+  IREE_ASSERT_OK(iree_io_parameter_provider_prefetch(
+      provider_, IREE_SV("scope"), /*key_count=*/0, /*keys=*/NULL,
+      IREE_IO_PARAMETER_PREFETCH_FLAG_NONE, progress.Get()));
+  ASSERT_EQ(progress.calls.size(), 1);
+  EXPECT_EQ(progress.calls[0].first, TotalFileBytes());
+  EXPECT_EQ(progress.calls[0].second, TotalFileBytes());
+}
+
+// Waiting reads each file-backed entry and reports monotonic progress.
+TEST_F(ParameterIndexProviderPrefetchTest, WaitAll) {
+  ProgressRecorder progress;
+  IREE_ASSERT_OK(iree_io_parameter_provider_prefetch(
+      provider_, IREE_SV("scope"), /*key_count=*/0, /*keys=*/NULL,
+      IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT, progress.Get()));
+  ASSERT_FALSE(progress.calls.empty());
+  uint64_t last_completed = 0;
+  for (auto& call : progress.calls) {
+    EXPECT_GE(call.first, last_completed);
+    EXPECT_EQ(call.second, TotalFileBytes());
+    last_completed = call.first;
+  }
+  EXPECT_EQ(last_completed, TotalFileBytes());
+}
+
+// Only the listed keys are prefetched and splats contribute no bytes.
+TEST_F(ParameterIndexProviderPrefetchTest, WaitKeys) {
+  ProgressRecorder progress;
+  iree_string_view_t keys[] = {IREE_SV("memory"), IREE_SV("splat")};
+  IREE_ASSERT_OK(iree_io_parameter_provider_prefetch(
+      provider_, IREE_SV("scope"), IREE_ARRAYSIZE(keys), keys,
+      IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT, progress.Get()));
+  ASSERT_EQ(progress.calls.size(), 1);
+  EXPECT_EQ(progress.calls[0].first, kMemoryLength);
+  EXPECT_EQ(progress.calls[0].second, kMemoryLength);
+}
+
+// Missing keys fail before any work is performed.
+TEST_F(ParameterIndexProviderPrefetchTest, MissingKey) {
+  ProgressRecorder progress;
+  iree_string_view_t keys[] = {IREE_SV("memory"), IREE_SV("missing")};
+  EXPECT_THAT(Status(iree_io_parameter_provider_prefetch(
+                  provider_, IREE_SV("scope"), IREE_ARRAYSIZE(keys), keys,
+                  IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT, progress.Get())),
+              StatusIs(StatusCode::kNotFound));
+  EXPECT_TRUE(progress.calls.empty());
+}
+
+// Scopes the provider does not serve are ignored.
+TEST_F(ParameterIndexProviderPrefetchTest, OtherScope) {
+  ProgressRecorder progress;
+  IREE_ASSERT_OK(iree_io_parameter_provider_prefetch(
+      provider_, IREE_SV("other"), /*key_count=*/0, /*keys=*/NULL,
+      IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT, progress.Get()));
+  EXPECT_TRUE(progress.calls.empty());
+}
+
+// Errors returned from the progress callback abort the prefetch.
+TEST_F(ParameterIndexProviderPrefetchTest, ProgressCancellation) {
+  ProgressRecorder progress;
+  progress.fail_after = 0;
+  EXPECT_THAT(Status(iree_io_parameter_provider_prefetch(
+                  provider_, IREE_SV("scope"), /*key_count=*/0, /*keys=*/NULL,
+                  IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT, progress.Get())),
+              StatusIs(StatusCode::kCancelled));
+  EXPECT_EQ(progress.calls.size(), 1);
+}
+
+// Entries extending past the end of a host allocation are only hinted up to
+// the end of the allocation but fail when waiting.
+TEST_F(ParameterIndexProviderPrefetchTest, OutOfRangeMemoryEntry) {
+  AddFileEntry("memory_oob", memory_handle_, /*offset=*/1024,
+               memory_storage_.size());
+  AddFileEntry("memory_overflow", memory_handle_, /*offset=*/UINT64_MAX,
+               /*length=*/2);
+  for (iree_string_view_t key :
+       {IREE_SV("memory_oob"), IREE_SV("memory_overflow")}) {
+    IREE_EXPECT_OK(iree_io_parameter_provider_prefetch(
+        provider_, IREE_SV("scope"), 1, &key,
+        IREE_IO_PARAMETER_PREFETCH_FLAG_NONE,
+        iree_io_parameter_prefetch_progress_t{NULL, NULL}));
+    EXPECT_THAT(Status(iree_io_parameter_provider_prefetch(
+                    provider_, IREE_SV("scope"), 1, &key,
+                    IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT,
+                    iree_io_parameter_prefetch_progress_t{NULL, NULL})),
+                StatusIs(StatusCode::kOutOfRange));
+  }
+}
+
+#if IREE_FILE_IO_ENABLE
+// Entries extending past the end of a file are only hinted up to the end of
+// the file but fail when waiting.
+TEST_F(ParameterIndexProviderPrefetchTest, OutOfRangeFileEntry) {
+  AddFileEntry("file_oob", file_handle_, /*offset=*/kFileLength,
+               /*length=*/kFileLength);
+  iree_string_view_t key = IREE_SV("file_oob");
+  IREE_EXPECT_OK(iree_io_parameter_provider_prefetch(
+      provider_, IREE_SV("scope"), 1, &key,
+      IREE_IO_PARAMETER_PREFETCH_FLAG_NONE,
+      iree_io_parameter_prefetch_progress_t{NULL, NULL}));
+  EXPECT_THAT(Status(iree_io_parameter_provider_prefetch(
+                  provider_, IREE_SV("scope"), 1, &key,
+                  IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT,
+                  iree_io_parameter_prefetch_progress_t{NULL, NULL})),
+              StatusIs(StatusCode::kOutOfRange));
+}
+#endif  // IREE_FILE_IO_ENABLE
+
+}  // namespace
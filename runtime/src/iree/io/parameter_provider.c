@@ -203,3 +203,20 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_provider_scatter(
   IREE_TRACE_ZONE_END(z0);
   return iree_ok_status();
 }
+
+IREE_API_EXPORT iree_status_t iree_io_parameter_provider_prefetch(
+    iree_io_parameter_provider_t* provider, iree_string_view_t scope,
+    iree_host_size_t key_count, const iree_string_view_t* keys,
+    iree_io_parameter_prefetch_flags_t flags,
+    iree_io_parameter_prefetch_progress_t progress) {
+  IREE_ASSERT_ARGUMENT(provider);
+  IREE_ASSERT_ARGUMENT(!key_count || keys);
+  if (!provider->vtable->prefetch) return iree_ok_status();
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_TEXT(z0, scope.data, scope.size);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, key_count);
+  iree_status_t status = provider->vtable->prefetch(provider, scope, key_count,
+                                                    keys, flags, progress);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
@@ -181,6 +181,50 @@ IREE_API_EXPORT iree_status_t iree_io_parameter_provider_scatter(
     iree_hal_buffer_t* source_buffer, iree_string_view_t target_scope,
     iree_host_size_t count, iree_io_parameter_enumerator_t enumerator);
 
+// Controls the behavior of iree_io_parameter_provider_prefetch.
+enum iree_io_parameter_prefetch_flag_bits_t {
+  IREE_IO_PARAMETER_PREFETCH_FLAG_NONE = 0u,
+  // Blocks until the parameter contents are resident in memory (the OS page
+  // cache or the mapped host allocation) instead of only issuing asynchronous
+  // readahead hints. Useful to make the latency of the first use predictable
+  // at the cost of startup time.
+  IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT = 1u << 0,
+};
+typedef uint32_t iree_io_parameter_prefetch_flags_t;
+
+// Called periodically during a prefetch with the total number of bytes
+// prefetched so far out of |total_bytes|. Returning an error aborts the
+// prefetch and propagates the error to the caller.
+typedef iree_status_t(IREE_API_PTR* iree_io_parameter_prefetch_progress_fn_t)(
+    void* user_data, uint64_t completed_bytes, uint64_t total_bytes);
+
+typedef struct iree_io_parameter_prefetch_progress_t {
+  // Callback function pointer. May be NULL to disable progress reporting.
+  iree_io_parameter_prefetch_progress_fn_t fn;
+  // User data passed to the callback function. Unowned.
+  void* user_data;
+} iree_io_parameter_prefetch_progress_t;
+
+// Prefetches the parameters with the given |keys| in |scope| so that later
+// loads, gathers, and reads of them do not need to fault in the parameter
+// contents on demand. If |key_count| is 0 all parameters in |scope| are
+// prefetched.
+//
+// By default this only issues hints (such as madvise/readahead) that let the
+// platform read the contents in the background and returns immediately. With
+// IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT the call blocks until the contents have
+// been read. The optional |progress| callback is called as parameters are
+// prefetched.
+//
+// Providers that have no use for prefetching (or do not support the scope)
+// treat this as a no-op. Returns IREE_STATUS_NOT_FOUND if any of the explicitly
+// listed keys is not found.
+IREE_API_EXPORT iree_status_t iree_io_parameter_provider_prefetch(
+    iree_io_parameter_provider_t* provider, iree_string_view_t scope,
+    iree_host_size_t key_count, const iree_string_view_t* keys,
+    iree_io_parameter_prefetch_flags_t flags,
+    iree_io_parameter_prefetch_progress_t progress);
+
 //===----------------------------------------------------------------------===//
 // iree_io_parameter_provider_t implementation details
 //===----------------------------------------------------------------------===//
@@ -220,6 +264,13 @@ typedef struct iree_io_parameter_provider_vtable_t {
       const iree_hal_semaphore_list_t signal_semaphore_list,
       iree_hal_buffer_t* source_buffer, iree_string_view_t target_scope,
       iree_host_size_t count, iree_io_parameter_enumerator_t enumerator);
+
+  // Optional; providers that do not implement it treat prefetches as no-ops.
+  iree_status_t(IREE_API_PTR* prefetch)(
+      iree_io_parameter_provider_t* provider, iree_string_view_t scope,
+      iree_host_size_t key_count, const iree_string_view_t* keys,
+      iree_io_parameter_prefetch_flags_t flags,
+      iree_io_parameter_prefetch_progress_t progress);
 } iree_io_parameter_provider_vtable_t;
 
 struct iree_io_parameter_provider_t {
@@ -0,0 +1,231 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/modules/hal/command_batch.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "iree/modules/hal/types.h"
+
+// Limit the number of bindings decoded per dispatch. This matches the limit on
+// direct dispatch calls and guards the stack as bindings are unpacked to it.
+#define IREE_HAL_MODULE_BATCH_MAX_BINDING_COUNT ((iree_host_size_t)32)
+
+// Limit the number of dispatch constants decoded per dispatch.
+// Direct dispatch calls receive their constants in the VM argument buffer but
+// batched dispatches need to unpack them to the stack.
+#define IREE_HAL_MODULE_BATCH_MAX_CONSTANT_COUNT ((iree_host_size_t)64)
+
+// Cursor over a batched command stream and its operands.
+typedef struct iree_hal_module_batch_reader_t {
+  const uint8_t* ptr;
+  const uint8_t* end;
+  iree_host_size_t executable_count;
+  const iree_vm_ref_t* executables;
+  iree_host_size_t buffer_count;
+  const iree_vm_ref_t* buffers;
+  iree_host_size_t value_count;
+  const uint8_t* values;  // unaligned int64_t[value_count]
+} iree_hal_module_batch_reader_t;
+
+static iree_status_t iree_hal_module_batch_read_u32(
+    iree_hal_module_batch_reader_t* reader, uint32_t* out_value) {
+  if (IREE_UNLIKELY(reader->end - reader->ptr < (ptrdiff_t)sizeof(uint32_t))) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "batched command stream truncated");
+  }
+  *out_value = iree_unaligned_load_le_u32((const uint32_t*)reader->ptr);
+  reader->ptr += sizeof(uint32_t);
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_module_batch_read_u64(
+    iree_hal_module_batch_reader_t* reader, uint64_t* out_value) {
+  if (IREE_UNLIKELY(reader->end - reader->ptr < (ptrdiff_t)sizeof(uint64_t))) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "batched command stream truncated");
+  }
+  *out_value = iree_unaligned_load_le_u64((const uint64_t*)reader->ptr);
+  reader->ptr += sizeof(uint64_t);
+  return iree_ok_status();
+}
+
+// Reads a value that is either an immediate or a dynamic operand reference.
+static iree_status_t iree_hal_module_batch_read_value(
+    iree_hal_module_batch_reader_t* reader, uint64_t* out_value) {
+  uint64_t value = 0;
+  IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_u64(reader, &value));
+  if (value & IREE_HAL_MODULE_BATCH_VALUE_DYNAMIC_BIT) {
+    uint64_t ordinal = value & ~IREE_HAL_MODULE_BATCH_VALUE_DYNAMIC_BIT;
+    if (IREE_UNLIKELY(ordinal >= reader->value_count)) {
+      return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                              "batched value ordinal %" PRIu64
+                              " out of range (%" PRIhsz " values)",
+                              ordinal, reader->value_count);
+    }
+    value = iree_unaligned_load_le_u64(
+        (const uint64_t*)(reader->values + ordinal * sizeof(int64_t)));
+  }
+  *out_value = value;
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_module_batch_read_u32_value(
+    iree_hal_module_batch_reader_t* reader, uint32_t* out_value) {
+  uint64_t value = 0;
+  IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_value(reader, &value));
+  *out_value = (uint32_t)value;
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_module_batch_record_execution_barrier(
+    iree_hal_module_batch_reader_t* reader,
+    iree_hal_command_buffer_t* command_buffer) {
+  uint32_t source_stage_mask = 0;
+  uint32_t target_stage_mask = 0;
+  uint32_t flags = 0;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_module_batch_read_u32(reader, &source_stage_mask));
+  IREE_RETURN_IF_ERROR(
+      iree_hal_module_batch_read_u32(reader, &target_stage_mask));
+  IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_u32(reader, &flags));
+
+  // Batched barriers only carry the stage masks and flags and get the same
+  // global dispatch write->read barrier as the execution_barrier import.
+  iree_hal_memory_barrier_t global_barrier;
+  global_barrier.source_scope = IREE_HAL_ACCESS_SCOPE_DISPATCH_WRITE;
+  global_barrier.target_scope = IREE_HAL_ACCESS_SCOPE_DISPATCH_READ;
+
+  return iree_hal_command_buffer_execution_barrier(
+      command_buffer, (iree_hal_execution_stage_t)source_stage_mask,
+      (iree_hal_execution_stage_t)target_stage_mask,
+      (iree_hal_execution_barrier_flags_t)flags, 1, &global_barrier, 0, NULL);
+}
+
+static iree_status_t iree_hal_module_batch_record_dispatch(
+    iree_hal_module_batch_reader_t* reader,
+    iree_hal_command_buffer_t* command_buffer) {
+  uint32_t executable_ordinal = 0;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_module_batch_read_u32(reader, &executable_ordinal));
+  if (IREE_UNLIKELY(executable_ordinal >= reader->executable_count)) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "batched executable ordinal %u out of range",
+                            executable_ordinal);
+  }
+  iree_hal_executable_t* executable = NULL;
+  IREE_RETURN_IF_ERROR(iree_hal_executable_check_deref(
+      reader->executables[executable_ordinal], &executable));
+
+  uint32_t entry_point = 0;
+  uint32_t workgroup_count[3] = {0, 0, 0};
+  uint64_t flags = 0;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_module_batch_read_u32_value(reader, &entry_point));
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(workgroup_count); ++i) {
+    IREE_RETURN_IF_ERROR(
+        iree_hal_module_batch_read_u32_value(reader, &workgroup_count[i]));
+  }
+  IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_u64(reader, &flags));
+
+  uint32_t constant_count = 0;
+  IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_u32(reader, &constant_count));
+  if (IREE_UNLIKELY(constant_count >
+                    IREE_HAL_MODULE_BATCH_MAX_CONSTANT_COUNT)) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "constant count %u > %" PRIhsz, constant_count,
+                            IREE_HAL_MODULE_BATCH_MAX_CONSTANT_COUNT);
+  }
+  uint32_t constants[IREE_HAL_MODULE_BATCH_MAX_CONSTANT_COUNT];
+  for (uint32_t i = 0; i < constant_count; ++i) {
+    IREE_RETURN_IF_ERROR(
+        iree_hal_module_batch_read_u32_value(reader, &constants[i]));
+  }
+
+  uint32_t binding_count = 0;
+  IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_u32(reader, &binding_count));
+  if (IREE_UNLIKELY(binding_count >
+                    IREE_HAL_MODULE_BATCH_MAX_BINDING_COUNT)) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "binding count %u > %" PRIhsz, binding_count,
+                            IREE_HAL_MODULE_BATCH_MAX_BINDING_COUNT);
+  }
+  iree_hal_buffer_ref_t
+      binding_values[IREE_HAL_MODULE_BATCH_MAX_BINDING_COUNT];
+  for (uint32_t i = 0; i < binding_count; ++i) {
+    iree_hal_buffer_ref_t* binding = &binding_values[i];
+    uint32_t buffer_slot = 0;
+    uint32_t buffer_ordinal = 0;
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    IREE_RETURN_IF_ERROR(
+        iree_hal_module_batch_read_u32_value(reader, &buffer_slot));
+    IREE_RETURN_IF_ERROR(
+        iree_hal_module_batch_read_u32(reader, &buffer_ordinal));
+    IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_value(reader, &offset));
+    IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_value(reader, &length));
+    binding->reserved = 0;
+    binding->buffer_slot = buffer_slot;
+    binding->buffer = NULL;
+    if (buffer_ordinal != IREE_HAL_MODULE_BATCH_NULL_ORDINAL) {
+      if (IREE_UNLIKELY(buffer_ordinal >= reader->buffer_count)) {
+        return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                                "batched buffer ordinal %u out of range",
+                                buffer_ordinal);
+      }
+      IREE_RETURN_IF_ERROR(iree_hal_buffer_check_deref_or_null(
+          reader->buffers[buffer_ordinal], &binding->buffer));
+    }
+    binding->offset = (iree_device_size_t)offset;
+    binding->length = (iree_device_size_t)length;
+  }
+  iree_hal_buffer_ref_list_t bindings = {
+      .count = binding_count,
+      .values = binding_values,
+  };
+
+  return iree_hal_command_buffer_dispatch(
+      command_buffer, executable, entry_point, workgroup_count,
+      iree_make_const_byte_span(constants, constant_count * sizeof(uint32_t)),
+      bindings, (iree_hal_dispatch_flags_t)flags);
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_module_record_command_batch(
+    iree_hal_command_buffer_t* command_buffer, iree_const_byte_span_t commands,
+    iree_host_size_t executable_count, const iree_vm_ref_t* executables,
+    iree_host_size_t buffer_count, const iree_vm_ref_t* buffers,
+    iree_host_size_t value_count, const uint8_t* values) {
+  IREE_ASSERT_ARGUMENT(command_buffer);
+  iree_hal_module_batch_reader_t reader = {
+      .ptr = commands.data,
+      .end = commands.data + commands.data_length,
+      .executable_count = executable_count,
+      .executables = executables,
+      .buffer_count = buffer_count,
+      .buffers = buffers,
+      .value_count = value_count,
+      .values = values,
+  };
+  while (reader.ptr < reader.end) {
+    uint32_t opcode = 0;
+    IREE_RETURN_IF_ERROR(iree_hal_module_batch_read_u32(&reader, &opcode));
+    switch (opcode) {
+      case IREE_HAL_MODULE_BATCH_OPCODE_EXECUTION_BARRIER:
+        IREE_RETURN_IF_ERROR(iree_hal_module_batch_record_execution_barrier(
+            &reader, command_buffer));
+        break;
+      case IREE_HAL_MODULE_BATCH_OPCODE_DISPATCH:
+        IREE_RETURN_IF_ERROR(
+            iree_hal_module_batch_record_dispatch(&reader, command_buffer));
+        break;
+      default:
+        return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                                "unknown batched command opcode %u", opcode);
+    }
+  }
+  return iree_ok_status();
+}
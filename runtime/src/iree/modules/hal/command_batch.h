@@ -0,0 +1,68 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_MODULES_HAL_COMMAND_BATCH_H_
+#define IREE_MODULES_HAL_COMMAND_BATCH_H_
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/vm/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// Batched command streams
+//===----------------------------------------------------------------------===//
+
+// Batched command streams are produced by the compiler for runs of commands
+// recorded into the same command buffer and are usually stored in rodata. All
+// fields are little-endian and may be unaligned. Each command starts with a
+// uint32_t opcode:
+//
+//   EXECUTION_BARRIER:
+//     u32 source_stage_mask, u32 target_stage_mask, u32 flags
+//   DISPATCH:
+//     u32 executable (ordinal into the executables list)
+//     value entry_point, value workgroup_x, value workgroup_y,
+//     value workgroup_z, u64 flags
+//     u32 constant_count, value constants[constant_count]
+//     u32 binding_count, binding bindings[binding_count]
+//   binding:
+//     value buffer_slot, u32 buffer (ordinal into the buffers list or
+//     0xFFFFFFFF if the binding is indirect), value offset, value length
+//
+// A value is a u64 holding either an immediate or, if the high bit is set, the
+// ordinal of an operand in the dynamic values list. Immediates that have the
+// high bit set (such as IREE_HAL_WHOLE_BUFFER) are passed as operands.
+//
+// NOTE: this must be kept in sync with the encoder in the compiler
+// (compiler/src/iree/compiler/Dialect/HAL/Conversion/HALToVM/).
+enum iree_hal_module_batch_opcode_e {
+  IREE_HAL_MODULE_BATCH_OPCODE_EXECUTION_BARRIER = 1u,
+  IREE_HAL_MODULE_BATCH_OPCODE_DISPATCH = 2u,
+};
+#define IREE_HAL_MODULE_BATCH_VALUE_DYNAMIC_BIT (1ull << 63)
+#define IREE_HAL_MODULE_BATCH_NULL_ORDINAL 0xFFFFFFFFu
+
+
+// Records the commands encoded in |commands| into |command_buffer|.
+// |executables| and |buffers| are the refs referenced by ordinal from the
+// stream and |values| is an unaligned int64_t[value_count] array of dynamic
+// operands. Commands are recorded as they are decoded and if the stream is
+// malformed the commands prior to the failing one will have been recorded.
+IREE_API_EXPORT iree_status_t iree_hal_module_record_command_batch(
+    iree_hal_command_buffer_t* command_buffer, iree_const_byte_span_t commands,
+    iree_host_size_t executable_count, const iree_vm_ref_t* executables,
+    iree_host_size_t buffer_count, const iree_vm_ref_t* buffers,
+    iree_host_size_t value_count, const uint8_t* values);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_MODULES_HAL_COMMAND_BATCH_H_
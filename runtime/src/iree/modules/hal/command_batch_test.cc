@@ -0,0 +1,414 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/modules/hal/command_batch.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/modules/hal/types.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+#include "iree/vm/api.h"
+
+namespace {
+
+using iree::Status;
+using iree::StatusCode;
+using iree::testing::status::StatusIs;
+
+//===----------------------------------------------------------------------===//
+// Test resources
+//===----------------------------------------------------------------------===//
+
+typedef struct test_executable_t {
+  iree_hal_resource_t resource;
+} test_executable_t;
+
+static void test_executable_destroy(iree_hal_executable_t* base_executable) {
+  delete (test_executable_t*)base_executable;
+}
+
+static const iree_hal_executable_vtable_t test_executable_vtable = {
+    /*.destroy=*/test_executable_destroy,
+};
+
+// A command recorded by the test command buffer.
+struct RecordedCommand {
+  enum class Type {
+    kExecutionBarrier,
+    kDispatch,
+  } type;
+  iree_hal_execution_stage_t source_stage_mask = 0;
+  iree_hal_execution_stage_t target_stage_mask = 0;
+  iree_hal_execution_barrier_flags_t barrier_flags = 0;
+  iree_host_size_t memory_barrier_count = 0;
+  iree_hal_executable_t* executable = NULL;
+  int32_t entry_point = 0;
+  uint32_t workgroup_count[3] = {0, 0, 0};
+  std::vector<uint32_t> constants;
+  std::vector<iree_hal_buffer_ref_t> bindings;
+  iree_hal_dispatch_flags_t dispatch_flags = 0;
+};
+
+// Command buffer that records the barriers and dispatches issued on it.
+// Only the methods the batch decoder uses are implemented.
+typedef struct test_command_buffer_t {
+  iree_hal_command_buffer_t base;
+  std::vector<RecordedCommand>* commands;
+} test_command_buffer_t;
+
+static void test_command_buffer_destroy(
+    iree_hal_command_buffer_t* base_command_buffer) {
+  delete (test_command_buffer_t*)base_command_buffer;
+}
+
+static iree_status_t test_command_buffer_execution_barrier(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_execution_stage_t source_stage_mask,
+    iree_hal_execution_stage_t target_stage_mask,
+    iree_hal_execution_barrier_flags_t flags,
+    iree_host_size_t memory_barrier_count,
+    const iree_hal_memory_barrier_t* memory_barriers,
+    iree_host_size_t buffer_barrier_count,
+    const iree_hal_buffer_barrier_t* buffer_barriers) {
+  test_command_buffer_t* command_buffer =
+      (test_command_buffer_t*)base_command_buffer;
+  RecordedCommand command;
+  command.type = RecordedCommand::Type::kExecutionBarrier;
+  command.source_stage_mask = source_stage_mask;
+  command.target_stage_mask = target_stage_mask;
+  command.barrier_flags = flags;
+  command.memory_barrier_count = memory_barrier_count;
+  command_buffer->commands->push_back(command);
+  return iree_ok_status();
+}
+
+static iree_status_t test_command_buffer_dispatch(
+    iree_hal_command_buffer_t* base_command_buffer,
+    iree_hal_executable_t* executable, int32_t entry_point,
+    const uint32_t workgroup_count[3], iree_const_byte_span_t constants,
+    iree_hal_buffer_ref_list_t bindings, iree_hal_dispatch_flags_t flags) {
+  test_command_buffer_t* command_buffer =
+      (test_command_buffer_t*)base_command_buffer;
+  RecordedCommand command;
+  command.type = RecordedCommand::Type::kDispatch;
+  command.executable = executable;
+  command.entry_point = entry_point;
+  for (int i = 0; i < 3; ++i) command.workgroup_count[i] = workgroup_count[i];
+  const uint32_t* constant_values = (const uint32_t*)constants.data;
+  command.constants.assign(
+      constant_values,
+      constant_values + constants.data_length / sizeof(uint32_t));
+  command.bindings.assign(bindings.values, bindings.values + bindings.count);
+  command.dispatch_flags = flags;
+  command_buffer->commands->push_back(command);
+  return iree_ok_status();
+}
+
+static iree_hal_command_buffer_vtable_t MakeTestCommandBufferVTable() {
+  iree_hal_command_buffer_vtable_t vtable;
+  memset(&vtable, 0, sizeof(vtable));
+  vtable.destroy = test_command_buffer_destroy;
+  vtable.execution_barrier = test_command_buffer_execution_barrier;
+  vtable.dispatch = test_command_buffer_dispatch;
+  return vtable;
+}
+static const iree_hal_command_buffer_vtable_t test_command_buffer_vtable =
+    MakeTestCommandBufferVTable();
+
+//===----------------------------------------------------------------------===//
+// Command stream encoding
+//===----------------------------------------------------------------------===//
+
+static constexpr uint64_t kDynamic = IREE_HAL_MODULE_BATCH_VALUE_DYNAMIC_BIT;
+
+// Builds a command stream in the format produced by the compiler.
+class CommandStream {
+ public:
+  CommandStream& U32(uint32_t value) {
+    for (int i = 0; i < 4; ++i) bytes_.push_back((value >> (i * 8)) & 0xFF);
+    return *this;
+  }
+  CommandStream& U64(uint64_t value) {
+    U32((uint32_t)value);
+    return U32((uint32_t)(value >> 32));
+  }
+
+  CommandStream& ExecutionBarrier(uint32_t source_stage_mask,
+                                  uint32_t target_stage_mask, uint32_t flags) {
+    U32(IREE_HAL_MODULE_BATCH_OPCODE_EXECUTION_BARRIER);
+    U32(source_stage_mask);
+    U32(target_stage_mask);
+    return U32(flags);
+  }
+
+  // Begins a dispatch; the caller must append constants and bindings.
+  CommandStream& Dispatch(uint32_t executable, uint64_t entry_point,
+                          uint64_t x, uint64_t y, uint64_t z) {
+    U32(IREE_HAL_MODULE_BATCH_OPCODE_DISPATCH);
+    U32(executable);
+    U64(entry_point);
+    U64(x);
+    U64(y);
+    U64(z);
+    return U64(/*flags=*/0);
+  }
+
+  CommandStream& Binding(uint64_t slot, uint32_t buffer, uint64_t offset,
+                         uint64_t length) {
+    U64(slot);
+    U32(buffer);
+    U64(offset);
+    return U64(length);
+  }
+
+  size_t size() const { return bytes_.size(); }
+  iree_const_byte_span_t span(size_t length) const {
+    return iree_make_const_byte_span(bytes_.data(), length);
+  }
+  iree_const_byte_span_t span() const { return span(bytes_.size()); }
+
+ private:
+  std::vector<uint8_t> bytes_;
+};
+
+//===----------------------------------------------------------------------===//
+// CommandBatchTest
+//===----------------------------------------------------------------------===//
+
+class CommandBatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    IREE_ASSERT_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
+                                           iree_allocator_system(),
+                                           &instance_));
+    IREE_ASSERT_OK(iree_hal_module_register_all_types(instance_));
+
+    test_executable_t* executable = new test_executable_t();
+    iree_hal_resource_initialize(&test_executable_vtable,
+                                 &executable->resource);
+    executable_ = (iree_hal_executable_t*)executable;
+    executables_.push_back(iree_hal_executable_retain_ref(executable_));
+
+    IREE_ASSERT_OK(iree_hal_allocator_create_heap(
+        iree_make_cstring_view("test"), iree_allocator_system(),
+        iree_allocator_system(), &device_allocator_));
+    iree_hal_buffer_params_t params = {0};
+    params.type = IREE_HAL_MEMORY_TYPE_HOST_LOCAL;
+    params.usage = IREE_HAL_BUFFER_USAGE_DEFAULT;
+    IREE_ASSERT_OK(iree_hal_allocator_allocate_buffer(device_allocator_,
+                                                      params, 4096, &buffer_));
+    buffers_.push_back(iree_hal_buffer_retain_ref(buffer_));
+
+    test_command_buffer_t* command_buffer = new test_command_buffer_t();
+    command_buffer->commands = &commands_;
+    iree_hal_command_buffer_initialize(
+        device_allocator_, IREE_HAL_COMMAND_BUFFER_MODE_UNVALIDATED,
+        IREE_HAL_COMMAND_CATEGORY_DISPATCH, IREE_HAL_QUEUE_AFFINITY_ANY,
+        /*binding_capacity=*/0, /*validation_state=*/NULL,
+        &test_command_buffer_vtable, &command_buffer->base);
+    command_buffer_ = &command_buffer->base;
+  }
+
+  void TearDown() override {
+    iree_hal_command_buffer_release(command_buffer_);
+    for (auto& ref : buffers_) iree_vm_ref_release(&ref);
+    for (auto& ref : executables_) iree_vm_ref_release(&ref);
+    iree_hal_buffer_release(buffer_);
+    iree_hal_executable_release(executable_);
+    iree_hal_allocator_release(device_allocator_);
+    iree_vm_instance_release(instance_);
+  }
+
+  iree_status_t Record(iree_const_byte_span_t commands,
+                       const std::vector<int64_t>& values = {}) {
+    return iree_hal_module_record_command_batch(
+        command_buffer_, commands, executables_.size(), executables_.data(),
+        buffers_.size(), buffers_.data(), values.size(),
+        (const uint8_t*)values.data());
+  }
+
+  iree_vm_instance_t* instance_ = NULL;
+  iree_hal_allocator_t* device_allocator_ = NULL;
+  iree_hal_executable_t* executable_ = NULL;
+  iree_hal_buffer_t* buffer_ = NULL;
+  std::vector<iree_vm_ref_t> executables_;
+  std::vector<iree_vm_ref_t> buffers_;
+  iree_hal_command_buffer_t* command_buffer_ = NULL;
+  std::vector<RecordedCommand> commands_;
+};
+
+TEST_F(CommandBatchTest, Empty) {
+  IREE_ASSERT_OK(Record(iree_const_byte_span_empty()));
+  EXPECT_TRUE(commands_.empty());
+}
+
+TEST_F(CommandBatchTest, DispatchBarrierDispatch) {
+  CommandStream stream;
+  stream.Dispatch(0, /*entry_point=*/1, /*x=*/kDynamic | 0, 2, 3)
+      .U32(2)
+      .U64(31)
+      .U64(kDynamic | 1)
+      .U32(2)
+      .Binding(/*slot=*/0, /*buffer=*/0, /*offset=*/128, /*length=*/256)
+      .Binding(/*slot=*/kDynamic | 1, IREE_HAL_MODULE_BATCH_NULL_ORDINAL,
+               /*offset=*/kDynamic | 0, /*length=*/64);
+  stream.ExecutionBarrier(IREE_HAL_EXECUTION_STAGE_DISPATCH,
+                          IREE_HAL_EXECUTION_STAGE_DISPATCH,
+                          IREE_HAL_EXECUTION_BARRIER_FLAG_NONE);
+  stream.Dispatch(0, 0, 4, 5, 6).U32(0).U32(0);
+  IREE_ASSERT_OK(Record(stream.span(), {10, 7}));
+
+  ASSERT_EQ(commands_.size(), 3);
+
+  const auto& dispatch0 = commands_[0];
+  ASSERT_EQ(dispatch0.type, RecordedCommand::Type::kDispatch);
+  EXPECT_EQ(dispatch0.executable, executable_);
+  EXPECT_EQ(dispatch0.entry_point, 1);
+  EXPECT_EQ(dispatch0.workgroup_count[0], 10);
+  EXPECT_EQ(dispatch0.workgroup_count[1], 2);
+  EXPECT_EQ(dispatch0.workgroup_count[2], 3);
+  EXPECT_EQ(dispatch0.constants, (std::vector<uint32_t>{31, 7}));
+  ASSERT_EQ(dispatch0.bindings.size(), 2);
+  EXPECT_EQ(dispatch0.bindings[0].buffer, buffer_);
+  EXPECT_EQ(dispatch0.bindings[0].buffer_slot, 0);
+  EXPECT_EQ(dispatch0.bindings[0].offset, 128);
+  EXPECT_EQ(dispatch0.bindings[0].length, 256);
+  EXPECT_EQ(dispatch0.bindings[1].buffer, nullptr);
+  EXPECT_EQ(dispatch0.bindings[1].buffer_slot, 7);
+  EXPECT_EQ(dispatch0.bindings[1].offset, 10);
+  EXPECT_EQ(dispatch0.bindings[1].length, 64);
+
+  const auto& barrier = commands_[1];
+  ASSERT_EQ(barrier.type, RecordedCommand::Type::kExecutionBarrier);
+  EXPECT_EQ(barrier.source_stage_mask, IREE_HAL_EXECUTION_STAGE_DISPATCH);
+  EXPECT_EQ(barrier.target_stage_mask, IREE_HAL_EXECUTION_STAGE_DISPATCH);
+  EXPECT_EQ(barrier.barrier_flags, IREE_HAL_EXECUTION_BARRIER_FLAG_NONE);
+  EXPECT_EQ(barrier.memory_barrier_count, 1);
+
+  const auto& dispatch1 = commands_[2];
+  ASSERT_EQ(dispatch1.type, RecordedCommand::Type::kDispatch);
+  EXPECT_EQ(dispatch1.workgroup_count[0], 4);
+  EXPECT_TRUE(dispatch1.constants.empty());
+  EXPECT_TRUE(dispatch1.bindings.empty());
+}
+
+// Values with the high bit set are passed as operands by the compiler.
+TEST_F(CommandBatchTest, HighBitValueOperand) {
+  CommandStream stream;
+  stream.Dispatch(0, 0, 1, 1, 1)
+      .U32(0)
+      .U32(1)
+      .Binding(/*slot=*/0, /*buffer=*/0, /*offset=*/0,
+               /*length=*/kDynamic | 0);
+  IREE_ASSERT_OK(Record(stream.span(), {-1}));
+  ASSERT_EQ(commands_.size(), 1);
+  ASSERT_EQ(commands_[0].bindings.size(), 1);
+  EXPECT_EQ(commands_[0].bindings[0].length, IREE_HAL_WHOLE_BUFFER);
+}
+
+// Every truncation that does not fall on a command boundary must fail without
+// reading past the end of the stream.
+TEST_F(CommandBatchTest, Truncated) {
+  CommandStream stream;
+  stream.ExecutionBarrier(IREE_HAL_EXECUTION_STAGE_DISPATCH,
+                          IREE_HAL_EXECUTION_STAGE_DISPATCH,
+                          IREE_HAL_EXECUTION_BARRIER_FLAG_NONE);
+  const size_t barrier_size = stream.size();
+  stream.Dispatch(0, 0, 1, 1, 1)
+      .U32(1)
+      .U64(31)
+      .U32(1)
+      .Binding(/*slot=*/0, /*buffer=*/0, /*offset=*/0, /*length=*/16);
+  for (size_t length = 1; length < stream.size(); ++length) {
+    if (length == barrier_size) continue;
+    // Copy so that ASAN catches reads past the truncated end.
+    std::vector<uint8_t> truncated(stream.span().data,
+                                   stream.span().data + length);
+    EXPECT_THAT(
+        Status(Record(iree_make_const_byte_span(truncated.data(), length))),
+        StatusIs(StatusCode::kOutOfRange))
+        << "truncated to " << length << " bytes";
+  }
+  commands_.clear();
+  IREE_ASSERT_OK(Record(stream.span()));
+  EXPECT_EQ(commands_.size(), 2);
+}
+
+TEST_F(CommandBatchTest, UnknownOpcode) {
+  CommandStream stream;
+  stream.U32(0xBAD);
+  EXPECT_THAT(Status(Record(stream.span())),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_TRUE(commands_.empty());
+}
+
+TEST_F(CommandBatchTest, ExecutableOrdinalOutOfRange) {
+  CommandStream stream;
+  stream.Dispatch(1, 0, 1, 1, 1).U32(0).U32(0);
+  EXPECT_THAT(Status(Record(stream.span())),
+              StatusIs(StatusCode::kOutOfRange));
+}
+
+TEST_F(CommandBatchTest, ExecutableTypeMismatch) {
+  // Swap the lists so the executable ordinal references a buffer.
+  std::swap(executables_, buffers_);
+  CommandStream stream;
+  stream.Dispatch(0, 0, 1, 1, 1).U32(0).U32(0);
+  EXPECT_THAT(Status(Record(stream.span())),
+              StatusIs(StatusCode::kInvalidArgument));
+  std::swap(executables_, buffers_);
+}
+
+TEST_F(CommandBatchTest, BufferOrdinalOutOfRange) {
+  CommandStream stream;
+  stream.Dispatch(0, 0, 1, 1, 1)
+      .U32(0)
+      .U32(1)
+      .Binding(/*slot=*/0, /*buffer=*/1, /*offset=*/0, /*length=*/16);
+  EXPECT_THAT(Status(Record(stream.span())),
+              StatusIs(StatusCode::kOutOfRange));
+}
+
+TEST_F(CommandBatchTest, ValueOrdinalOutOfRange) {
+  CommandStream stream;
+  stream.Dispatch(0, 0, kDynamic | 2, 1, 1).U32(0).U32(0);
+  EXPECT_THAT(Status(Record(stream.span(), {1, 2})),
+              StatusIs(StatusCode::kOutOfRange));
+  EXPECT_TRUE(commands_.empty());
+}
+
+TEST_F(CommandBatchTest, TooManyConstants) {
+  CommandStream stream;
+  stream.Dispatch(0, 0, 1, 1, 1).U32(0xFFFFFFFFu);
+  EXPECT_THAT(Status(Record(stream.span())),
+              StatusIs(StatusCode::kOutOfRange));
+}
+
+TEST_F(CommandBatchTest, TooManyBindings) {
+  CommandStream stream;
+  stream.Dispatch(0, 0, 1, 1, 1).U32(0).U32(0xFFFFFFFFu);
+  EXPECT_THAT(Status(Record(stream.span())),
+              StatusIs(StatusCode::kOutOfRange));
+}
+
+// Commands prior to a malformed one are recorded.
+TEST_F(CommandBatchTest, PartialRecording) {
+  CommandStream stream;
+  stream.ExecutionBarrier(IREE_HAL_EXECUTION_STAGE_DISPATCH,
+                          IREE_HAL_EXECUTION_STAGE_DISPATCH,
+                          IREE_HAL_EXECUTION_BARRIER_FLAG_NONE);
+  stream.U32(0xBAD);
+  EXPECT_THAT(Status(Record(stream.span())),
+              StatusIs(StatusCode::kInvalidArgument));
+  ASSERT_EQ(commands_.size(), 1);
+  EXPECT_EQ(commands_[0].type, RecordedCommand::Type::kExecutionBarrier);
+}
+
+}  // namespace
@@ -56,6 +56,7 @@ EXPORT_FN("command_buffer.end_debug_group", iree_hal_module_command_buffer_end_d
 EXPORT_FN("command_buffer.execution_barrier", iree_hal_module_command_buffer_execution_barrier, riii, v)
 EXPORT_FN("command_buffer.fill_buffer", iree_hal_module_command_buffer_fill_buffer, rrIIiii, v)
 EXPORT_FN("command_buffer.finalize", iree_hal_module_command_buffer_finalize, r, v)
+EXPORT_FN_CUSTOM("command_buffer.record_batch", iree_hal_module_command_buffer_record_batch, rrCrDCrDCID, v)
 EXPORT_FN("command_buffer.update_buffer", iree_hal_module_command_buffer_update_buffer, rrIrIIi, v)
 
 EXPORT_FN("device.allocator", iree_hal_module_device_allocator, r, r)
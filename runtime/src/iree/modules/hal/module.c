@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "iree/modules/hal/command_batch.h"
 #include "iree/modules/hal/utils/buffer_diagnostics.h"
 
 //===----------------------------------------------------------------------===//
@@ -20,6 +21,10 @@
 // in the future but right now guards the stack from blowing up during calls.
 #define IREE_HAL_MODULE_MAX_DESCRIPTOR_BINDING_COUNT ((iree_host_size_t)32)
 
+// Limit on how many fences are gathered on the stack for a join.
+// Larger joins use a temporary heap allocation.
+#define IREE_HAL_MODULE_MAX_STACK_FENCE_JOIN_COUNT ((iree_host_size_t)64)
+
 // Limit the number of bindings in a binding table that we allocate on the stack
 // while marshaling from the VM. Counts over this amount will result in heap
 // allocations to avoid blowing the native stack. In most programs we expect
@@ -33,7 +38,8 @@
 //===----------------------------------------------------------------------===//
 
 #define IREE_HAL_MODULE_VERSION_0_5 0x00000005u
-#define IREE_HAL_MODULE_VERSION_LATEST IREE_HAL_MODULE_VERSION_0_5
+#define IREE_HAL_MODULE_VERSION_0_6 0x00000006u
+#define IREE_HAL_MODULE_VERSION_LATEST IREE_HAL_MODULE_VERSION_0_6
 
 typedef struct iree_hal_module_t {
   iree_allocator_t host_allocator;
@@ -1124,6 +1130,85 @@ static iree_status_t iree_hal_module_command_buffer_dispatch_indirect_shim(
                                                           module_state, &args);
 }
 
+// Argument signature: rrCrDCrDCID
+typedef struct {
+  union {
+    struct {
+      iree_vm_ref_t command_buffer;
+      iree_vm_ref_t commands;
+    };
+    iree_vm_abi_rr_t params;
+  };
+  iree_vm_size_t executable_count;
+  const iree_vm_ref_t* executables;
+  iree_vm_size_t buffer_count;
+  const iree_vm_ref_t* buffers;
+  iree_vm_size_t value_count;
+  const uint8_t* values;  // unaligned int64_t[value_count]
+} iree_hal_module_command_buffer_record_batch_args_t;
+static iree_status_t iree_hal_module_command_buffer_record_batch(
+    iree_vm_stack_t* IREE_RESTRICT stack, void* IREE_RESTRICT module,
+    iree_hal_module_state_t* IREE_RESTRICT state,
+    const iree_hal_module_command_buffer_record_batch_args_t* IREE_RESTRICT
+        args) {
+  iree_hal_command_buffer_t* command_buffer = NULL;
+  IREE_RETURN_IF_ERROR(iree_hal_command_buffer_check_deref(args->command_buffer,
+                                                           &command_buffer));
+  iree_vm_buffer_t* commands = NULL;
+  IREE_RETURN_IF_ERROR(iree_vm_buffer_check_deref(args->commands, &commands));
+  iree_const_byte_span_t command_span =
+      iree_vm_buffer_as_const_byte_span(commands);
+
+  return iree_hal_module_record_command_batch(
+      command_buffer, command_span, (iree_host_size_t)args->executable_count,
+      args->executables, (iree_host_size_t)args->buffer_count, args->buffers,
+      (iree_host_size_t)args->value_count, args->values);
+}
+static iree_status_t iree_hal_module_command_buffer_record_batch_shim(
+    iree_vm_stack_t* IREE_RESTRICT stack, iree_vm_native_function_flags_t flags,
+    iree_byte_span_t args_storage, iree_byte_span_t rets_storage,
+    iree_vm_native_function_target2_t target_fn, void* IREE_RESTRICT module,
+    void* IREE_RESTRICT module_state) {
+  // The generic shims only support a single variadic segment and this call
+  // has three (executables, buffers and values) so the arguments are decoded
+  // manually. Each segment is a count followed by that many elements and the
+  // counts are validated against the argument storage as they are read.
+  iree_hal_module_command_buffer_record_batch_args_t args;
+  memset(&args, 0, sizeof(args));
+  const uint8_t* ptr = args_storage.data;
+  const uint8_t* end_ptr = args_storage.data + args_storage.data_length;
+  bool args_ok = args_storage.data_length >=
+                 sizeof(iree_vm_abi_rr_t) + 3 * sizeof(iree_vm_size_t);
+  if (args_ok) {
+    args.params = *(const iree_vm_abi_rr_t*)ptr;
+    ptr += sizeof(args.params);
+    args.executable_count = *(const iree_vm_size_t*)ptr;
+    args.executables = (const iree_vm_ref_t*)(ptr + sizeof(iree_vm_size_t));
+    ptr = (const uint8_t*)(args.executables + args.executable_count);
+    args_ok = ptr + sizeof(iree_vm_size_t) <= end_ptr;
+  }
+  if (args_ok) {
+    args.buffer_count = *(const iree_vm_size_t*)ptr;
+    args.buffers = (const iree_vm_ref_t*)(ptr + sizeof(iree_vm_size_t));
+    ptr = (const uint8_t*)(args.buffers + args.buffer_count);
+    args_ok = ptr + sizeof(iree_vm_size_t) <= end_ptr;
+  }
+  if (args_ok) {
+    args.value_count = *(const iree_vm_size_t*)ptr;
+    args.values = ptr + sizeof(iree_vm_size_t);
+    ptr = args.values + args.value_count * sizeof(int64_t);
+    args_ok = ptr <= end_ptr;
+  }
+  if (IREE_UNLIKELY(!args_ok || rets_storage.data_length > 0)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "argument/result signature mismatch");
+  }
+  IREE_ASSERT(target_fn == (iree_vm_native_function_target2_t)
+                               iree_hal_module_command_buffer_record_batch);
+  return iree_hal_module_command_buffer_record_batch(stack, module,
+                                                     module_state, &args);
+}
+
 //===----------------------------------------------------------------------===//
 // iree_hal_device_t
 //===----------------------------------------------------------------------===//
@@ -1530,60 +1615,51 @@ IREE_VM_ABI_EXPORT(iree_hal_module_fence_create,  //
 IREE_VM_ABI_EXPORT(iree_hal_module_fence_join,  //
                    iree_hal_module_state_t,     //
                    CrD, r) {
-  // NOTE: this is an inlined version of iree_hal_fence_join that avoids the
-  // need for mapping VM types to HAL types via temporary stack/heap storage.
-  // This lets us avoid allocations/stack exhaustion in pathological cases of
-  // hundreds of fences (say, one per input argument in stateless programs with
-  // hundreds/thousands of inputs).
-
-  // Find the maximum required timepoint capacity by scanning the fence list.
-  // This ensures all fences passed in are actually fences _or_ are NULL so
-  // the subsequent scan below only needs to check for NULL cases.
-  iree_host_size_t total_timepoint_capacity = 0;
+  // Gather the non-empty fences so they can be joined. This also ensures all
+  // fences passed in are actually fences _or_ are NULL. Programs with hundreds
+  // or thousands of inputs may join one fence per input so large lists spill to
+  // the heap instead of exhausting the stack.
+  iree_host_size_t fence_count = 0;
   for (iree_host_size_t i = 0; i < args->a0_count; ++i) {
     iree_hal_fence_t* fence = NULL;
     IREE_RETURN_IF_ERROR(
         iree_hal_fence_check_deref_or_null(args->a0[i].r0, &fence));
-    if (fence) {
-      total_timepoint_capacity += iree_hal_fence_timepoint_count(fence);
-    }
+    if (iree_hal_fence_timepoint_count(fence) > 0) ++fence_count;
   }
 
   // If all fences were empty then we no-op by returning a NULL fence
   // (immediately signaled).
-  if (!total_timepoint_capacity) {
+  if (!fence_count) {
     rets->r0 = iree_vm_ref_null();
     return iree_ok_status();
   }
 
-  // Create the fence with the maximum capacity. Hopefully there is some
-  // deduplication.
-  iree_hal_fence_t* joined_fence = NULL;
-  IREE_RETURN_IF_ERROR(iree_hal_fence_create(
-      total_timepoint_capacity, state->host_allocator, &joined_fence));
-
-  // Insert all timepoints from all fences. This is slow in cases where there
-  // are a lot of unique fences.
-  iree_status_t status = iree_ok_status();
+  iree_hal_fence_t** fences = NULL;
+  if (fence_count <= IREE_HAL_MODULE_MAX_STACK_FENCE_JOIN_COUNT) {
+    fences = (iree_hal_fence_t**)iree_alloca(fence_count * sizeof(fences[0]));
+  } else {
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+        state->host_allocator, fence_count * sizeof(fences[0]),
+        (void**)&fences));
+  }
+  iree_host_size_t fence_ordinal = 0;
   for (iree_host_size_t i = 0; i < args->a0_count; ++i) {
     // NOTE: only possible because we checked above and know this is NULL or an
     // iree_hal_fence_t.
     iree_hal_fence_t* fence = (iree_hal_fence_t*)args->a0[i].r0.ptr;
-    if (!fence) continue;
-    iree_hal_semaphore_list_t source_list =
-        iree_hal_fence_semaphore_list(fence);
-    for (iree_host_size_t j = 0; j < source_list.count; ++j) {
-      status = iree_hal_fence_insert(joined_fence, source_list.semaphores[j],
-                                     source_list.payload_values[j]);
-      if (!iree_status_is_ok(status)) break;
+    if (iree_hal_fence_timepoint_count(fence) > 0) {
+      fences[fence_ordinal++] = fence;
     }
-    if (!iree_status_is_ok(status)) break;
   }
 
+  iree_hal_fence_t* joined_fence = NULL;
+  iree_status_t status = iree_hal_fence_join(
+      fence_count, fences, state->host_allocator, &joined_fence);
+  if (fence_count > IREE_HAL_MODULE_MAX_STACK_FENCE_JOIN_COUNT) {
+    iree_allocator_free(state->host_allocator, fences);
+  }
   if (iree_status_is_ok(status)) {
     rets->r0 = iree_hal_fence_move_ref(joined_fence);
-  } else {
-    iree_hal_fence_release(joined_fence);
   }
   return status;
 }
@@ -21,25 +21,54 @@ extern "C" {
 // be doing expensive 64-bit atomics on a 32-bit bus all for just 2 bits of
 // data :)
 
+// Affinities are hierarchical: executor workers are partitioned into domains
+// of up to 64 workers that (usually) share a last level cache and a domain set
+// selects which domains may be used while an affinity set selects workers
+// within each of those domains. Worker indices in affinity sets are relative to
+// the first worker in the domain.
+
+//===----------------------------------------------------------------------===//
+// iree_task_domain_set_t
+//===----------------------------------------------------------------------===//
+
+typedef uint32_t iree_task_domain_set_t;
+
+// Allows for only a specific domain to be selected.
+static inline iree_task_domain_set_t iree_task_domain_set_for_domain(
+    uint8_t domain_index) {
+  return 1u << domain_index;
+}
+
+// Allows for any domain to be selected.
+static inline iree_task_domain_set_t iree_task_domain_set_for_any_domain(
+    void) {
+  return UINT32_MAX;
+}
+
+#define iree_task_domain_set_ones(count) (0xFFFFFFFFu >> (32 - (count)))
+#define iree_task_domain_set_count_trailing_zeros(set) \
+  iree_math_count_trailing_zeros_u32(set)
+#define iree_task_domain_set_count_ones(set) iree_math_count_ones_u32(set)
+
 //===----------------------------------------------------------------------===//
 // iree_task_affinity_set_t
 //===----------------------------------------------------------------------===//
 
 typedef uint64_t iree_task_affinity_set_t;
 
-// Allows for only a specific worker to be selected.
+// Allows for only a specific worker within a domain to be selected.
 static inline iree_task_affinity_set_t iree_task_affinity_for_worker(
     uint8_t worker_index) {
   return 1ull << worker_index;
 }
 
-// Allows for a range of workers to be selected.
+// Allows for a range of workers within a domain to be selected.
 static inline iree_task_affinity_set_t iree_task_affinity_for_worker_range(
     uint8_t worker_start, uint8_t worker_end) {
   return ((1ull << (worker_start - 1)) - 1) ^ ((1ull << worker_end) - 1);
 }
 
-// Allows for any worker to be selected.
+// Allows for any worker within a domain to be selected.
 static inline iree_task_affinity_set_t iree_task_affinity_for_any_worker(void) {
   return UINT64_MAX;
 }
@@ -101,7 +101,8 @@ IREE_FLAG(
     int32_t, task_topology_max_group_count, 64,
     "Sets a maximum value on the worker count that can be automatically\n"
     "detected and used when --task_topology_group_count=0 and is ignored\n"
-    "otherwise.");
+    "otherwise. Executors support up to 256 workers partitioned into domains\n"
+    "of up to 64 workers sharing a last level cache.");
 
 IREE_FLAG(string, task_topology_performance_level, "any",
           "Selects only cores that match the specified performance level from\n"
@@ -232,6 +233,7 @@ static void iree_task_flags_dump_task_topology(
   for (iree_host_size_t j = 0; j < topology->group_count; ++j) {
     const iree_task_topology_group_t* group = &topology->groups[j];
     fprintf(stdout, "# group[%d]: '%s'\n", group->group_index, group->name);
+    fprintf(stdout, "#         domain: %u\n", group->domain_index);
     fprintf(stdout, "#      processor: %u\n", group->processor_index);
     fprintf(stdout, "#       affinity: ");
     if (group->ideal_thread_affinity.specified) {
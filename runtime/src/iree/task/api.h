@@ -8,8 +8,9 @@
 #define IREE_TASK_API_H_
 
 #include "iree/base/api.h"
-#include "iree/task/executor.h"  // IWYU pragma: export
-#include "iree/task/topology.h"  // IWYU pragma: export
+#include "iree/task/executor.h"    // IWYU pragma: export
+#include "iree/task/invocation.h"  // IWYU pragma: export
+#include "iree/task/topology.h"    // IWYU pragma: export
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,8 +59,8 @@ iree_status_t iree_task_executors_create_from_flags(
 //===----------------------------------------------------------------------===//
 
 // TODO(benvanik): simple IO completion event callback.
-// TODO(benvanik): simple async function call dispatch.
-// TODO(benvanik): simple parallel-for grid-style function call dispatch.
+// See iree/task/invocation.h for iree_task_executor_async_call and
+// iree_task_executor_parallel_for.
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -0,0 +1,235 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
+#include "iree/task/executor.h"
+#include "iree/task/scope.h"
+#include "iree/task/submission.h"
+#include "iree/task/task.h"
+#include "iree/task/topology.h"
+#include "iree/testing/benchmark.h"
+
+// Models a matmul C[M,N] = A[M,K] * B[K,N] tiled into a grid of output tiles
+// where workgroup x indexes N tiles and y indexes M tiles. Each tile reads the
+// A row panel for its y and the B column panel for its x. Tiles that run close
+// together in time on the same worker reuse panels when the tile order keeps
+// them together.
+
+// Number of rows/columns of the output covered by each tile.
+#define IREE_TASK_TILE_ORDER_BENCHMARK_TILE_SIZE 32
+// Reduction dimension shared by all panels.
+#define IREE_TASK_TILE_ORDER_BENCHMARK_K 256
+// Number of elements in each A or B panel.
+#define IREE_TASK_TILE_ORDER_BENCHMARK_PANEL_SIZE \
+  (IREE_TASK_TILE_ORDER_BENCHMARK_TILE_SIZE * IREE_TASK_TILE_ORDER_BENCHMARK_K)
+// Number of panels each worker is modeled as keeping in its private cache.
+// At 32KB per panel this approximates a 256KB L2.
+#define IREE_TASK_TILE_ORDER_BENCHMARK_CACHED_PANEL_COUNT 8
+// Number of floats per 64-byte cache line.
+#define IREE_TASK_TILE_ORDER_BENCHMARK_LINE_STRIDE 16
+
+// Per-worker LRU model of cached panels.
+// Padded to avoid false sharing between workers.
+typedef iree_alignas(iree_hardware_destructive_interference_size) struct
+    iree_task_tile_order_benchmark_worker_t {
+  // Panel identifiers ordered from most to least recently used or UINT32_MAX.
+  uint32_t panels[IREE_TASK_TILE_ORDER_BENCHMARK_CACHED_PANEL_COUNT];
+  // Total number of panel accesses that missed the model.
+  int64_t miss_count;
+  // Sum of panel data read to keep the reads from being optimized away.
+  float sum;
+} iree_task_tile_order_benchmark_worker_t;
+
+typedef struct iree_task_tile_order_benchmark_state_t {
+  // A row panels followed by B column panels, each PANEL_SIZE elements.
+  float* panels;
+  // Number of tiles along M (y) and N (x).
+  uint32_t tile_count_m;
+  uint32_t tile_count_n;
+  iree_task_tile_order_benchmark_worker_t* workers;
+} iree_task_tile_order_benchmark_state_t;
+
+// Records an access to |panel_id| in the |worker| model and returns the panel.
+static const float* iree_task_tile_order_benchmark_touch_panel(
+    iree_task_tile_order_benchmark_state_t* state,
+    iree_task_tile_order_benchmark_worker_t* worker, uint32_t panel_id) {
+  uint32_t i = 0;
+  for (; i < IREE_TASK_TILE_ORDER_BENCHMARK_CACHED_PANEL_COUNT - 1; ++i) {
+    if (worker->panels[i] == panel_id) break;
+  }
+  if (worker->panels[i] != panel_id) ++worker->miss_count;
+  memmove(&worker->panels[1], &worker->panels[0],
+          i * sizeof(worker->panels[0]));
+  worker->panels[0] = panel_id;
+  return state->panels +
+         (iree_host_size_t)panel_id * IREE_TASK_TILE_ORDER_BENCHMARK_PANEL_SIZE;
+}
+
+static iree_status_t iree_task_tile_order_benchmark_tile(
+    void* user_context, const iree_task_tile_context_t* tile_context,
+    iree_task_submission_t* pending_submission) {
+  iree_task_tile_order_benchmark_state_t* state =
+      (iree_task_tile_order_benchmark_state_t*)user_context;
+  iree_task_tile_order_benchmark_worker_t* worker =
+      &state->workers[tile_context->worker_id];
+  const float* lhs = iree_task_tile_order_benchmark_touch_panel(
+      state, worker, tile_context->workgroup_xyz[1]);
+  const float* rhs = iree_task_tile_order_benchmark_touch_panel(
+      state, worker, state->tile_count_m + tile_context->workgroup_xyz[0]);
+  float sum = 0.0f;
+  for (uint32_t i = 0; i < IREE_TASK_TILE_ORDER_BENCHMARK_PANEL_SIZE;
+       i += IREE_TASK_TILE_ORDER_BENCHMARK_LINE_STRIDE) {
+    sum += lhs[i] * rhs[i];
+  }
+  worker->sum += sum;
+  return iree_ok_status();
+}
+
+typedef struct iree_task_tile_order_benchmark_params_t {
+  iree_task_dispatch_tile_order_t tile_order;
+  const char* tile_order_name;
+  // Number of tiles along M (y) and N (x).
+  uint32_t tile_count_m;
+  uint32_t tile_count_n;
+} iree_task_tile_order_benchmark_params_t;
+
+// Runs the modeled matmul dispatch in the configured tile order on a 4-worker
+// executor. Reports tiles per second and labels the results with the modeled
+// panel misses per tile.
+//
+// user_data is an iree_task_tile_order_benchmark_params_t.
+static iree_status_t iree_task_tile_order_benchmark_execute(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  iree_allocator_t host_allocator = benchmark_state->host_allocator;
+  const iree_task_tile_order_benchmark_params_t* params =
+      (const iree_task_tile_order_benchmark_params_t*)benchmark_def->user_data;
+
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(/*group_count=*/4, &topology);
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  iree_task_executor_t* executor = NULL;
+  IREE_CHECK_OK(iree_task_executor_create(options, &topology, host_allocator,
+                                          &executor));
+  iree_task_topology_deinitialize(&topology);
+  const iree_host_size_t worker_count =
+      iree_task_executor_worker_count(executor);
+
+  iree_task_tile_order_benchmark_state_t state = {
+      .tile_count_m = params->tile_count_m,
+      .tile_count_n = params->tile_count_n,
+  };
+  const iree_host_size_t panel_count =
+      params->tile_count_m + params->tile_count_n;
+  IREE_CHECK_OK(iree_allocator_malloc(
+      host_allocator,
+      panel_count * IREE_TASK_TILE_ORDER_BENCHMARK_PANEL_SIZE * sizeof(float),
+      (void**)&state.panels));
+  for (iree_host_size_t i = 0;
+       i < panel_count * IREE_TASK_TILE_ORDER_BENCHMARK_PANEL_SIZE; ++i) {
+    state.panels[i] = (float)(i % 7);
+  }
+  IREE_CHECK_OK(iree_allocator_malloc_aligned(
+      host_allocator, worker_count * sizeof(*state.workers),
+      iree_alignof(iree_task_tile_order_benchmark_worker_t), 0,
+      (void**)&state.workers));
+  for (iree_host_size_t i = 0; i < worker_count; ++i) {
+    memset(state.workers[i].panels, 0xFF, sizeof(state.workers[i].panels));
+  }
+
+  iree_task_scope_t scope;
+  iree_task_scope_initialize(IREE_SV("tile_order"), IREE_TASK_SCOPE_FLAG_NONE,
+                             &scope);
+  const uint32_t workgroup_size[3] = {1, 1, 1};
+  const uint32_t workgroup_count[3] = {params->tile_count_n,
+                                       params->tile_count_m, 1};
+  int64_t tile_count = 0;
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    iree_task_dispatch_t dispatch_task;
+    iree_task_dispatch_initialize(
+        &scope,
+        iree_task_make_dispatch_closure(iree_task_tile_order_benchmark_tile,
+                                        &state),
+        workgroup_size, workgroup_count, &dispatch_task);
+    dispatch_task.tile_order = params->tile_order;
+    iree_task_fence_t* fence = NULL;
+    IREE_CHECK_OK(iree_task_executor_acquire_fence(executor, &scope, &fence));
+    iree_task_set_completion_task(&dispatch_task.header, &fence->header);
+    iree_task_submission_t submission;
+    iree_task_submission_initialize(&submission);
+    iree_task_submission_enqueue(&submission, &dispatch_task.header);
+    iree_task_executor_submit(executor, &submission);
+    iree_task_executor_flush(executor);
+    IREE_CHECK_OK(iree_task_scope_wait_idle(&scope, IREE_TIME_INFINITE_FUTURE));
+    tile_count += params->tile_count_m * params->tile_count_n;
+  }
+  iree_benchmark_set_items_processed(benchmark_state, tile_count);
+
+  int64_t miss_count = 0;
+  for (iree_host_size_t i = 0; i < worker_count; ++i) {
+    miss_count += state.workers[i].miss_count;
+  }
+  char label[64];
+  snprintf(label, sizeof(label), "panel_misses_per_tile=%.3f",
+           tile_count ? (double)miss_count / (double)tile_count : 0.0);
+  iree_benchmark_set_label(benchmark_state, label);
+
+  iree_task_scope_deinitialize(&scope);
+  iree_task_executor_release(executor);
+  iree_allocator_free_aligned(host_allocator, state.workers);
+  iree_allocator_free(host_allocator, state.panels);
+  return iree_ok_status();
+}
+
+// Each tile order on a square grid and on grids taller and wider than the
+// modeled cache can hold panels for.
+static const iree_task_tile_order_benchmark_params_t
+    iree_task_tile_order_benchmark_params[] = {
+        {IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR, "row_major", 64, 64},
+        {IREE_TASK_DISPATCH_TILE_ORDER_COLUMN_MAJOR, "column_major", 64, 64},
+        {IREE_TASK_DISPATCH_TILE_ORDER_MORTON, "morton", 64, 64},
+        {IREE_TASK_DISPATCH_TILE_ORDER_GROUPED, "grouped", 64, 64},
+        {IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR, "row_major", 96, 24},
+        {IREE_TASK_DISPATCH_TILE_ORDER_COLUMN_MAJOR, "column_major", 96, 24},
+        {IREE_TASK_DISPATCH_TILE_ORDER_MORTON, "morton", 96, 24},
+        {IREE_TASK_DISPATCH_TILE_ORDER_GROUPED, "grouped", 96, 24},
+        {IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR, "row_major", 24, 96},
+        {IREE_TASK_DISPATCH_TILE_ORDER_COLUMN_MAJOR, "column_major", 24, 96},
+        {IREE_TASK_DISPATCH_TILE_ORDER_MORTON, "morton", 24, 96},
+        {IREE_TASK_DISPATCH_TILE_ORDER_GROUPED, "grouped", 24, 96},
+};
+
+int main(int argc, char** argv) {
+  iree_benchmark_initialize(&argc, argv);
+
+  iree_benchmark_def_t benchmark_def = {
+      .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+               IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+      .time_unit = IREE_BENCHMARK_UNIT_MICROSECOND,
+      .minimum_duration_ns = 0,
+      .iteration_count = 0,
+      .run = iree_task_tile_order_benchmark_execute,
+  };
+  for (iree_host_size_t i = 0;
+       i < IREE_ARRAYSIZE(iree_task_tile_order_benchmark_params); ++i) {
+    const iree_task_tile_order_benchmark_params_t* params =
+        &iree_task_tile_order_benchmark_params[i];
+    char name[64];
+    snprintf(name, sizeof(name), "%s_%ux%u", params->tile_order_name,
+             params->tile_count_m, params->tile_count_n);
+    benchmark_def.user_data = (void*)params;
+    iree_benchmark_register(iree_make_cstring_view(name), &benchmark_def);
+  }
+
+  iree_benchmark_run_specified();
+  return 0;
+}
@@ -47,6 +47,43 @@ static iree_host_size_t iree_task_topology_group_local_memory_size(
                          iree_hardware_destructive_interference_size);
 }
 
+// Verifies that the groups in |topology| are partitioned into contiguous
+// domains that fit within the executor bitsets.
+static iree_status_t iree_task_executor_verify_topology_domains(
+    const iree_task_topology_t* topology) {
+  iree_host_size_t domain_group_count = 0;
+  for (iree_host_size_t i = 0; i < topology->group_count; ++i) {
+    const uint8_t domain_index = topology->groups[i].domain_index;
+    const uint8_t last_domain_index =
+        i > 0 ? topology->groups[i - 1].domain_index : 0;
+    if (domain_index == last_domain_index) {
+      ++domain_group_count;
+    } else if (i > 0 && domain_index == last_domain_index + 1) {
+      domain_group_count = 1;
+    } else {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "topology group %" PRIhsz
+                              " domain %u must follow domain %u",
+                              i, domain_index, last_domain_index);
+    }
+    if (domain_index >= IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT) {
+      return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                              "topology domain %u exceeds the maximum of %d "
+                              "domains",
+                              domain_index,
+                              IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT);
+    }
+    if (domain_group_count > IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT) {
+      return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                              "topology domain %u exceeds the maximum of %d "
+                              "groups per domain",
+                              domain_index,
+                              (int)IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
+    }
+  }
+  return iree_ok_status();
+}
+
 iree_status_t iree_task_executor_create(iree_task_executor_options_t options,
                                         const iree_task_topology_t* topology,
                                         iree_allocator_t allocator,
@@ -66,6 +103,7 @@ iree_status_t iree_task_executor_create(iree_task_executor_options_t options,
         IREE_STATUS_UNIMPLEMENTED,
         "threadless donate-only executor mode not yet implemented");
   }
+  IREE_RETURN_IF_ERROR(iree_task_executor_verify_topology_domains(topology));
 
   IREE_TRACE_ZONE_BEGIN(z0);
   IREE_ASSERT_ARGUMENT(out_executor);
@@ -170,8 +208,17 @@ iree_status_t iree_task_executor_create(iree_task_executor_options_t options,
     uint8_t* worker_local_memory =
         (uint8_t*)executor->workers + worker_list_size;
 
-    iree_task_affinity_set_t worker_mask =
-        iree_task_affinity_set_ones(worker_count);
+    // Partition the workers into domains. The masks are published after all
+    // workers have been initialized.
+    executor->domain_count = iree_task_topology_domain_count(topology);
+    for (iree_host_size_t i = 0; i < worker_count; ++i) {
+      const uint8_t domain_index =
+          iree_task_topology_get_group(topology, i)->domain_index;
+      iree_task_executor_domain_t* domain = &executor->domains[domain_index];
+      if (!domain->worker_count) domain->worker_base = i;
+      ++domain->worker_count;
+      executor->worker_domain_indices[i] = domain_index;
+    }
 
     for (iree_host_size_t i = 0; i < worker_count; ++i) {
       const iree_task_topology_group_t* group =
@@ -187,10 +234,17 @@ iree_status_t iree_task_executor_create(iree_task_executor_options_t options,
       if (!iree_status_is_ok(status)) break;
     }
 
-    iree_atomic_task_affinity_set_store(&executor->worker_idle_mask,
-                                        worker_mask, iree_memory_order_release);
-    iree_atomic_task_affinity_set_store(&executor->worker_live_mask,
-                                        worker_mask, iree_memory_order_release);
+    for (iree_host_size_t i = 0; i < executor->domain_count; ++i) {
+      iree_task_executor_domain_t* domain = &executor->domains[i];
+      iree_task_affinity_set_t worker_mask =
+          iree_task_affinity_set_ones(domain->worker_count);
+      iree_atomic_task_affinity_set_store(&domain->worker_idle_mask,
+                                          worker_mask,
+                                          iree_memory_order_release);
+      iree_atomic_task_affinity_set_store(&domain->worker_live_mask,
+                                          worker_mask,
+                                          iree_memory_order_release);
+    }
   }
 
   if (!iree_status_is_ok(status)) {
@@ -274,6 +328,40 @@ iree_host_size_t iree_task_executor_worker_count(
   return executor->worker_count;
 }
 
+void iree_task_executor_query_statistics(
+    iree_task_executor_t* executor,
+    iree_task_executor_statistics_t* out_statistics) {
+  memset(out_statistics, 0, sizeof(*out_statistics));
+#if IREE_STATISTICS_ENABLE
+  for (iree_host_size_t i = 0; i < executor->worker_count; ++i) {
+    iree_task_worker_statistics_t* worker_statistics =
+        &executor->workers[i].statistics;
+    out_statistics->task_count += iree_atomic_load(
+        &worker_statistics->task_count, iree_memory_order_relaxed);
+    out_statistics->tile_count += iree_atomic_load(
+        &worker_statistics->dispatch.tile_count, iree_memory_order_relaxed);
+    out_statistics->steal_count += iree_atomic_load(
+        &worker_statistics->steal_count, iree_memory_order_relaxed);
+    out_statistics->failed_steal_count += iree_atomic_load(
+        &worker_statistics->failed_steal_count, iree_memory_order_relaxed);
+    out_statistics->yield_count += iree_atomic_load(
+        &worker_statistics->yield_count, iree_memory_order_relaxed);
+    out_statistics->sleep_count += iree_atomic_load(
+        &worker_statistics->sleep_count, iree_memory_order_relaxed);
+    out_statistics->sleep_ns += iree_atomic_load(&worker_statistics->sleep_ns,
+                                                 iree_memory_order_relaxed);
+  }
+  out_statistics->wake_count =
+      iree_atomic_load(&executor->wake_count, iree_memory_order_relaxed);
+  out_statistics->coordination_count = iree_atomic_load(
+      &executor->coordination_count, iree_memory_order_relaxed);
+  out_statistics->coordinator_wait_ns = iree_atomic_load(
+      &executor->coordinator_wait_ns, iree_memory_order_relaxed);
+  out_statistics->coordinator_hold_ns = iree_atomic_load(
+      &executor->coordinator_hold_ns, iree_memory_order_relaxed);
+#endif  // IREE_STATISTICS_ENABLE
+}
+
 iree_event_pool_t* iree_task_executor_event_pool(
     iree_task_executor_t* executor) {
   return executor->event_pool;
@@ -303,10 +391,23 @@ static void iree_task_executor_relay_to_worker(
     iree_task_executor_t* executor, iree_task_post_batch_t* post_batch,
     iree_task_t* task) {
   iree_host_size_t worker_index =
-      iree_task_post_batch_select_worker(post_batch, task->affinity_set);
+      iree_task_post_batch_select_worker(post_batch, task->domain_set,
+                                         task->affinity_set);
   iree_task_post_batch_enqueue(post_batch, worker_index, task);
 }
 
+// Reorders |list| such that tasks of higher priority come first.
+// Tasks of the same priority retain their relative order. All ready tasks are
+// still scheduled in the same pass so lower priority tasks are never starved.
+static void iree_task_executor_sort_ready_list_by_priority(
+    iree_task_list_t* list) {
+  iree_task_list_t priority_lists[IREE_TASK_PRIORITY_COUNT];
+  iree_task_list_partition_by_priority(list, priority_lists);
+  for (int i = IREE_TASK_PRIORITY_COUNT - 1; i >= 0; --i) {
+    iree_task_list_append(list, &priority_lists[i]);
+  }
+}
+
 // Schedules all ready tasks in the |pending_submission| list.
 // Task may enqueue zero or more new tasks (or newly-ready/waiting tasks) to
 // |pending_submission| or queue work for posting to workers via the
@@ -322,6 +423,12 @@ void iree_task_executor_schedule_ready_tasks(
     iree_task_executor_t* executor, iree_task_submission_t* pending_submission,
     iree_task_post_batch_t* post_batch) {
   IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Schedule higher priority tasks first so that they are issued to workers
+  // (and their dispatches fanned out) ahead of lower priority tasks.
+  iree_task_executor_sort_ready_list_by_priority(
+      &pending_submission->ready_list);
+
   iree_task_t* task = NULL;
   while ((task = iree_task_list_pop_front(&pending_submission->ready_list))) {
     // If the scope has been marked as failing then we abort the task.
@@ -431,6 +538,22 @@ void iree_task_executor_flush(iree_task_executor_t* executor) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+#if IREE_STATISTICS_ENABLE
+// Records a coordination pass that started waiting for the coordinator lock at
+// |wait_start_ns| and acquired it at |hold_start_ns|.
+// Must be called while holding the coordinator lock.
+static void iree_task_executor_record_coordination(
+    iree_task_executor_t* executor, iree_time_t wait_start_ns,
+    iree_time_t hold_start_ns) {
+  iree_time_t hold_end_ns = iree_time_now();
+  iree_task_statistics_counter_add(&executor->coordination_count, 1);
+  iree_task_statistics_counter_add(&executor->coordinator_wait_ns,
+                                   hold_start_ns - wait_start_ns);
+  iree_task_statistics_counter_add(&executor->coordinator_hold_ns,
+                                   hold_end_ns - hold_start_ns);
+}
+#endif  // IREE_STATISTICS_ENABLE
+
 // Dispatches tasks in the global submission queue to workers.
 // This is called by users upon submission of new tasks or by workers when they
 // run out of tasks to process. If |current_worker| is provided then tasks will
@@ -452,7 +575,9 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
     // TODO(#10212): remove this lock or do something more clever to avoid
     // contention when many workers try to coordinate at the same time. This can
     // create very long serialized lock chains that slow down worker wakes.
+    IREE_STATISTICS(iree_time_t wait_start_ns = iree_time_now());
     iree_slim_mutex_lock(&executor->coordinator_mutex);
+    IREE_STATISTICS(iree_time_t hold_start_ns = iree_time_now());
 
     // Check for incoming submissions and move their posted tasks into our
     // local lists. Any of the tasks here are ready to execute immediately and
@@ -474,6 +599,8 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
     iree_task_submission_initialize_from_lifo_slist(
         &executor->incoming_ready_slist, &pending_submission);
     if (iree_task_list_is_empty(&pending_submission.ready_list)) {
+      IREE_STATISTICS(iree_task_executor_record_coordination(
+          executor, wait_start_ns, hold_start_ns));
       iree_slim_mutex_unlock(&executor->coordinator_mutex);
       IREE_TRACE_ZONE_END(z1);
       break;
@@ -499,6 +626,8 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
     iree_task_poller_enqueue(&executor->poller,
                              &pending_submission.waiting_list);
 
+    IREE_STATISTICS(iree_task_executor_record_coordination(
+        executor, wait_start_ns, hold_start_ns));
     iree_slim_mutex_unlock(&executor->coordinator_mutex);
     IREE_TRACE_ZONE_END(z1);
 
@@ -511,34 +640,35 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
 }
 
 static iree_task_t* iree_task_executor_try_steal_task_from_affinity_set(
-    iree_task_executor_t* executor, iree_task_affinity_set_t victim_mask,
-    uint32_t max_theft_attempts, int rotation_offset,
-    iree_task_queue_t* local_task_queue) {
+    iree_task_executor_t* executor, const iree_task_executor_domain_t* domain,
+    iree_task_affinity_set_t victim_mask, uint32_t max_theft_attempts,
+    int rotation_offset, iree_task_queue_t* local_task_queue) {
   if (!victim_mask) return NULL;
   max_theft_attempts = iree_min(max_theft_attempts,
                                 iree_task_affinity_set_count_ones(victim_mask));
-  victim_mask = iree_task_affinity_set_rotr(victim_mask, rotation_offset);
 
-  int worker_index = rotation_offset;
+  int worker_bit_index = rotation_offset;
   iree_task_affinity_set_t mask =
-      iree_task_affinity_set_rotr(victim_mask, worker_index);
+      iree_task_affinity_set_rotr(victim_mask, rotation_offset);
   for (uint32_t i = 0; i < max_theft_attempts; ++i) {
     // Find the last set bit and skip to it. This avoids the need for doing
     // a full O(n) scan and instead gets us at O(popcnt) * O(ctz).
     //
     // Example: sharing mask = 0b01010101
-    //          mask_rotation = 3 (randomly selected)
-    //          mask = 0b01010101 rotr 3 = 0b10101010
+    //          rotation_offset = 3 (randomly selected)
+    //          mask = 0b01010101 rotr 3 = 0b10101010 (bit 0 is worker 3)
     //          for (i = 0; i < 4; ++i)
     //            offset = ctz(0b10101010) = 1
-    //            mask_rotation += 1 = 4
-    //            mask >>= 1 = 0b01010101
-    //            victim_index = 4 % 64 = 4
+    //            victim_bit_index = (3 + 1) % 64 = 4
+    //            worker_bit_index += 1 + 1 = 5
+    //            mask >>= 2 = 0b00101010
     int offset = iree_task_affinity_set_count_trailing_zeros(mask);
-    int victim_index = (worker_index + offset) % executor->worker_count;
-    worker_index += offset + 1;
+    int victim_bit_index = (worker_bit_index + offset) &
+                           (8 * sizeof(iree_task_affinity_set_t) - 1);
+    worker_bit_index += offset + 1;
     mask = iree_shr(mask, offset + 1);
-    iree_task_worker_t* victim_worker = &executor->workers[victim_index];
+    iree_task_worker_t* victim_worker =
+        &executor->workers[domain->worker_base + victim_bit_index];
     if (iree_atomic_load(&victim_worker->state, iree_memory_order_acquire) !=
         IREE_TASK_WORKER_STATE_RUNNING) {
       return NULL;
@@ -560,6 +690,19 @@ static iree_task_t* iree_task_executor_try_steal_task_from_affinity_set(
   return NULL;
 }
 
+// Returns a bitset of the workers in |domain| that are live and not idle.
+static iree_task_affinity_set_t iree_task_executor_domain_victim_mask(
+    iree_task_executor_domain_t* domain) {
+  // The masks are accessed with 'relaxed' order because they are just hints.
+  iree_task_affinity_set_t worker_live_mask =
+      iree_atomic_task_affinity_set_load(&domain->worker_live_mask,
+                                         iree_memory_order_relaxed);
+  iree_task_affinity_set_t worker_idle_mask =
+      iree_atomic_task_affinity_set_load(&domain->worker_idle_mask,
+                                         iree_memory_order_relaxed);
+  return worker_live_mask & ~worker_idle_mask;
+}
+
 // Tries to steal an entire task from a sibling worker (based on topology).
 // Returns a task that is available (has not yet begun processing at all).
 // May steal multiple tasks and add them to the |local_task_queue|.
@@ -567,7 +710,9 @@ static iree_task_t* iree_task_executor_try_steal_task_from_affinity_set(
 // We do a scan through ideal victims indicated by the
 // |constructive_sharing_mask|; these are the workers most likely to have some
 // cache benefits to taking their work as they share some level of the cache
-// hierarchy and should be better to steal from than any random worker.
+// hierarchy and should be better to steal from than any random worker. After
+// that the remaining workers in the same domain (usually sharing a last level
+// cache) are tried and only then workers in other domains.
 //
 // To prevent biasing any particular victim we use a fast prng function to
 // select where in the set of potential victims defined by the topology
@@ -575,49 +720,64 @@ static iree_task_t* iree_task_executor_try_steal_task_from_affinity_set(
 // instead of bouncing around at random we just select the starting point in
 // our search and then go in-order.
 iree_task_t* iree_task_executor_try_steal_task(
-    iree_task_executor_t* executor,
+    iree_task_executor_t* executor, iree_host_size_t domain_index,
     iree_task_affinity_set_t constructive_sharing_mask,
     uint32_t max_theft_attempts, iree_prng_minilcg128_state_t* theft_prng,
     iree_task_queue_t* local_task_queue) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // The masks are accessed with 'relaxed' order because they are just hints.
-  iree_task_affinity_set_t worker_live_mask =
-      iree_atomic_task_affinity_set_load(&executor->worker_live_mask,
-                                         iree_memory_order_relaxed);
-  iree_task_affinity_set_t worker_idle_mask =
-      iree_atomic_task_affinity_set_load(&executor->worker_idle_mask,
-                                         iree_memory_order_relaxed);
   // Limit the workers we will steal from to the ones that are currently live
   // and not idle.
-  iree_task_affinity_set_t victim_mask = worker_live_mask & ~worker_idle_mask;
+  iree_task_executor_domain_t* domain = &executor->domains[domain_index];
+  iree_task_affinity_set_t victim_mask =
+      iree_task_executor_domain_victim_mask(domain);
 
   // TODO(benvanik): it may be possible to rework this such that we better
   // use the prng; for example, instead of all this rotating stuff we could just
   // generate an 8-bit number (or even split it into two 4-bit numbers) per
   // theft attempt. The current rotation strategy is biased toward the same try
   // ordering vs. what we may really want with an unbiased random selection.
-  int rotation_offset = iree_prng_minilcg128_next_uint8(theft_prng) &
-                        (8 * sizeof(iree_task_affinity_set_t) - 1);
+  uint8_t rotation_seed = iree_prng_minilcg128_next_uint8(theft_prng);
+  int rotation_offset =
+      rotation_seed & (8 * sizeof(iree_task_affinity_set_t) - 1);
 
   // Try first with the workers we may have some caches shared with. This
   // helps to prevent cache invalidations/availability updates as it's likely
   // that we won't need to go back to main memory (or higher cache tiers) in the
   // event that the thief and victim are running close to each other in time.
   iree_task_t* task = iree_task_executor_try_steal_task_from_affinity_set(
-      executor, victim_mask & constructive_sharing_mask, max_theft_attempts,
-      rotation_offset, local_task_queue);
+      executor, domain, victim_mask & constructive_sharing_mask,
+      max_theft_attempts, rotation_offset, local_task_queue);
   if (task) {
     IREE_TRACE_ZONE_APPEND_TEXT(z0, "local");
   } else {
     task = iree_task_executor_try_steal_task_from_affinity_set(
-        executor, victim_mask & ~constructive_sharing_mask, max_theft_attempts,
-        rotation_offset, local_task_queue);
+        executor, domain, victim_mask & ~constructive_sharing_mask,
+        max_theft_attempts, rotation_offset, local_task_queue);
     if (task) {
       IREE_TRACE_ZONE_APPEND_TEXT(z0, "non-local");
     }
   }
 
+  // Fall back to other domains starting at a random one. Tasks stolen from
+  // other domains will likely need to be pulled through main memory (or across
+  // sockets) and are only worth it when there is nothing nearby.
+  const iree_host_size_t remote_domain_count = executor->domain_count - 1;
+  for (iree_host_size_t i = 0; !task && i < remote_domain_count; ++i) {
+    iree_host_size_t remote_domain_index =
+        (domain_index + 1 + (rotation_seed + i) % remote_domain_count) %
+        executor->domain_count;
+    iree_task_executor_domain_t* remote_domain =
+        &executor->domains[remote_domain_index];
+    task = iree_task_executor_try_steal_task_from_affinity_set(
+        executor, remote_domain,
+        iree_task_executor_domain_victim_mask(remote_domain),
+        max_theft_attempts, rotation_offset, local_task_queue);
+    if (task) {
+      IREE_TRACE_ZONE_APPEND_TEXT(z0, "remote");
+    }
+  }
+
   IREE_TRACE_ZONE_END(z0);
   return task;
 }
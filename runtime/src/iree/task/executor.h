@@ -336,6 +336,48 @@ void iree_task_executor_trim(iree_task_executor_t* executor);
 iree_host_size_t iree_task_executor_worker_count(
     iree_task_executor_t* executor);
 
+// Aggregate statistics of an executor and all of its workers.
+// All counters are totals since the executor was created.
+typedef struct iree_task_executor_statistics_t {
+#if IREE_STATISTICS_ENABLE
+  // Total number of tasks executed by workers.
+  int64_t task_count;
+  // Total number of dispatch tiles (workgroups) executed by workers.
+  int64_t tile_count;
+  // Number of times workers stole tasks from other workers.
+  int64_t steal_count;
+  // Number of times workers ran out of work and found nothing to steal.
+  int64_t failed_steal_count;
+  // Number of times dispatch shards yielded to higher priority tasks.
+  int64_t yield_count;
+  // Number of times workers ran out of work and went to sleep.
+  int64_t sleep_count;
+  // Total time workers spent sleeping in nanoseconds.
+  int64_t sleep_ns;
+  // Number of wake requests posted to workers when distributing work.
+  int64_t wake_count;
+  // Number of times a thread acted as the coordinator.
+  int64_t coordination_count;
+  // Total time threads spent waiting to become the coordinator. High values
+  // indicate contention on the coordinator lock.
+  int64_t coordinator_wait_ns;
+  // Total time threads spent holding the coordinator lock.
+  int64_t coordinator_hold_ns;
+#else
+  int reserved;
+#endif  // IREE_STATISTICS_ENABLE
+} iree_task_executor_statistics_t;
+
+// Queries the aggregate statistics of |executor| since creation.
+// Thread-safe; counters are read individually while workers are running and
+// may not be consistent with each other.
+//
+// NOTE: statistics may be compiled out in some configurations and this call
+// will become a memset(0).
+void iree_task_executor_query_statistics(
+    iree_task_executor_t* executor,
+    iree_task_executor_statistics_t* out_statistics);
+
 // Returns an iree_event_t pool managed by the executor.
 // Users of the task system should acquire their transient events from this.
 // Long-lived events should be allocated on their own in order to avoid
@@ -25,6 +25,39 @@
 extern "C" {
 #endif  // __cplusplus
 
+// A domain of up to 64 workers that (usually) share a last level cache.
+// Workers are assigned to domains in contiguous ranges and the bitsets here
+// are relative to the first worker in the domain.
+typedef struct iree_task_executor_domain_t {
+  // A bitset indicating which workers are likely to be live and usable; all
+  // attempts to push work onto a particular worker should check first with this
+  // mask. This may change over time either automatically or by user request
+  // ("don't use these cores for awhile I'm going to be using them" etc).
+  //
+  // This mask is just a hint, accessed with memory_order_relaxed. Readers must
+  // be OK with getting slightly out-of-date information. The only way to get
+  // an authoritative answer to the question "is this worker live" is to
+  // atomically query worker->state. This mask is for usage patterns where one
+  // needs a cheap (single relaxed atomic op) approximation of all N workers'
+  // live state without having to perform N expensive atomic ops.
+  iree_atomic_task_affinity_set_t worker_live_mask;
+
+  // A bitset indicating which workers are currently idle. Used to bias incoming
+  // tasks to workers that aren't doing much else. This is a balance of latency
+  // to wake the idle workers vs. latency to wait for existing work to complete
+  // on already woken workers.
+  //
+  // This mask is just a hint, accessed with memory_order_relaxed. See the
+  // comment on worker_live_mask.
+  iree_atomic_task_affinity_set_t worker_idle_mask;
+
+  // Executor-local index of the first worker in the domain.
+  iree_host_size_t worker_base;
+
+  // Total number of workers in the domain.
+  iree_host_size_t worker_count;
+} iree_task_executor_domain_t;
+
 struct iree_task_executor_t {
   iree_atomic_ref_count_t ref_count;
   iree_allocator_t allocator;
@@ -87,6 +120,16 @@ struct iree_task_executor_t {
   // coordinator.
   iree_slim_mutex_t coordinator_mutex;
 
+#if IREE_STATISTICS_ENABLE
+  // Coordination statistics; only updated while holding coordinator_mutex.
+  iree_atomic_int64_t coordination_count;
+  iree_atomic_int64_t coordinator_wait_ns;
+  iree_atomic_int64_t coordinator_hold_ns;
+
+  // Total number of wake requests posted to workers. Updated from any thread.
+  iree_atomic_int64_t wake_count;
+#endif  // IREE_STATISTICS_ENABLE
+
   // Wait task polling and wait thread manager.
   // This handles all system waits so that we can keep the syscalls off the
   // worker threads and lower wake latencies (the wait thread can enqueue
@@ -94,27 +137,14 @@ struct iree_task_executor_t {
   // existing computation on the workers to finish).
   iree_task_poller_t poller;
 
-  // A bitset indicating which workers are likely to be live and usable; all
-  // attempts to push work onto a particular worker should check first with this
-  // mask. This may change over time either automatically or by user request
-  // ("don't use these cores for awhile I'm going to be using them" etc).
-  //
-  // This mask is just a hint, accessed with memory_order_relaxed. Readers must
-  // be OK with getting slightly out-of-date information. The only way to get
-  // an authoritative answer to the question "is this worker live" is to
-  // atomically query worker->state. This mask is for usage patterns where one
-  // needs a cheap (single relaxed atomic op) approximation of all N workers'
-  // live state without having to perform N expensive atomic ops.
-  iree_atomic_task_affinity_set_t worker_live_mask;
+  // Worker domains partitioning the workers based on the topology.
+  // Work is preferentially placed and stolen within a domain before crossing
+  // into other domains.
+  iree_host_size_t domain_count;
+  iree_task_executor_domain_t domains[IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT];
 
-  // A bitset indicating which workers are currently idle. Used to bias incoming
-  // tasks to workers that aren't doing much else. This is a balance of latency
-  // to wake the idle workers vs. latency to wait for existing work to complete
-  // on already woken workers.
-  //
-  // This mask is just a hint, accessed with memory_order_relaxed. See the
-  // comment on worker_live_mask.
-  iree_atomic_task_affinity_set_t worker_idle_mask;
+  // Domain index of each worker used to map worker indices to their domain.
+  uint8_t worker_domain_indices[IREE_TASK_EXECUTOR_MAX_WORKER_COUNT];
 
   // Base value added to each executor-local worker index.
   // This allows workers to uniquely identify themselves in multi-executor
@@ -128,6 +158,19 @@ struct iree_task_executor_t {
   iree_task_worker_t* workers;  // [worker_count]
 };
 
+#if IREE_STATISTICS_ENABLE
+// Adds |value| to a statistics |counter| that is only updated by one thread at
+// a time. A relaxed load and store avoids the cost of an atomic
+// read-modify-write on hot paths while still allowing other threads to read
+// the counter at any time.
+static inline void iree_task_statistics_counter_add(
+    iree_atomic_int64_t* counter, int64_t value) {
+  iree_atomic_store(
+      counter, iree_atomic_load(counter, iree_memory_order_relaxed) + value,
+      iree_memory_order_relaxed);
+}
+#endif  // IREE_STATISTICS_ENABLE
+
 // Merges a submission into the primary FIFO queues.
 // Coordinators will fetch items from here as workers demand them but otherwise
 // not be notified of the changes (waiting until coordination runs again).
@@ -155,10 +198,11 @@ void iree_task_executor_coordinate(iree_task_executor_t* executor,
                                    iree_task_worker_t* current_worker);
 
 // Tries to steal an entire task from a sibling worker (based on topology).
+// Workers in |domain_index| are tried first before any other domain.
 // Returns a task that is available (has not yet begun processing at all).
 // May steal multiple tasks and add them to the |local_task_queue|.
 iree_task_t* iree_task_executor_try_steal_task(
-    iree_task_executor_t* executor,
+    iree_task_executor_t* executor, iree_host_size_t domain_index,
     iree_task_affinity_set_t constructive_sharing_mask,
     uint32_t max_theft_attempts, iree_prng_minilcg128_state_t* theft_prng,
     iree_task_queue_t* local_task_queue);
@@ -0,0 +1,137 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/task/executor.h"
+#include "iree/task/invocation.h"
+#include "iree/task/topology.h"
+#include "iree/testing/benchmark.h"
+
+// Total number of elements processed per parallel-for regardless of the
+// worker count. Chunks are sized so that each worker receives a few of them.
+#define IREE_TASK_SCALING_BENCHMARK_ELEMENT_COUNT (1024 * 1024)
+
+// Shape of the executor used by a benchmark.
+typedef struct iree_task_scaling_benchmark_params_t {
+  // Number of workers in the executor. Workers beyond 64 are partitioned into
+  // additional domains by the topology.
+  iree_host_size_t worker_count;
+  // Number of elements processed per parallel-for function call.
+  iree_host_size_t grain_size;
+} iree_task_scaling_benchmark_params_t;
+
+// Performs a small amount of arithmetic per element so that the cost measured
+// is dominated by distribution of chunks across workers. The result is stored
+// to the first element of the range in the uint32_t array |user_data|.
+static iree_status_t iree_task_scaling_benchmark_range(void* user_data,
+                                                       iree_host_size_t begin,
+                                                       iree_host_size_t end) {
+  uint32_t value = (uint32_t)begin;
+  for (iree_host_size_t i = begin; i < end; ++i) {
+    value = value * 1664525u + 1013904223u;
+  }
+  ((uint32_t*)user_data)[begin] = value;
+  return iree_ok_status();
+}
+
+// Creates an executor with the configured worker count and repeatedly runs a
+// fixed-size parallel-for across it. Reports elements per second.
+//
+// user_data is an iree_task_scaling_benchmark_params_t.
+static iree_status_t iree_task_scaling_benchmark_execute(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  const iree_task_scaling_benchmark_params_t* params =
+      (const iree_task_scaling_benchmark_params_t*)benchmark_def->user_data;
+
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(params->worker_count,
+                                                 &topology);
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  iree_task_executor_t* executor = NULL;
+  IREE_CHECK_OK(iree_task_executor_create(
+      options, &topology, benchmark_state->host_allocator, &executor));
+  iree_task_topology_deinitialize(&topology);
+  uint32_t* results = NULL;
+  IREE_CHECK_OK(iree_allocator_malloc(
+      benchmark_state->host_allocator,
+      IREE_TASK_SCALING_BENCHMARK_ELEMENT_COUNT * sizeof(*results),
+      (void**)&results));
+
+  int64_t element_count = 0;
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    iree_task_invocation_t invocation;
+    IREE_CHECK_OK(iree_task_executor_parallel_for(
+        executor, IREE_TASK_SCALING_BENCHMARK_ELEMENT_COUNT, params->grain_size,
+        iree_task_scaling_benchmark_range, results,
+        iree_wait_primitive_immediate(), &invocation));
+    IREE_CHECK_OK(
+        iree_task_invocation_wait(&invocation, iree_infinite_timeout()));
+    iree_task_invocation_deinitialize(&invocation);
+    element_count += IREE_TASK_SCALING_BENCHMARK_ELEMENT_COUNT;
+  }
+  iree_benchmark_set_items_processed(benchmark_state, element_count);
+
+  iree_allocator_free(benchmark_state->host_allocator, results);
+  iree_task_executor_release(executor);
+  return iree_ok_status();
+}
+
+// Worker counts spanning a single domain up to the maximum of four domains,
+// each run with the default grain size and with fine-grained chunks that
+// stress work stealing.
+static const iree_task_scaling_benchmark_params_t
+    iree_task_scaling_benchmark_params[] = {
+        {1, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT},
+        {4, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT},
+        {16, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT},
+        {64, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT},
+        {128, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT},
+        {192, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT},
+        {256, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT},
+        {1, 256},
+        {4, 256},
+        {16, 256},
+        {64, 256},
+        {128, 256},
+        {192, 256},
+        {256, 256},
+};
+
+int main(int argc, char** argv) {
+  iree_benchmark_initialize(&argc, argv);
+
+  iree_benchmark_def_t benchmark_def = {
+      .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
+               IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+      .time_unit = IREE_BENCHMARK_UNIT_MICROSECOND,
+      .minimum_duration_ns = 0,
+      .iteration_count = 0,
+      .run = iree_task_scaling_benchmark_execute,
+  };
+  for (iree_host_size_t i = 0;
+       i < IREE_ARRAYSIZE(iree_task_scaling_benchmark_params); ++i) {
+    const iree_task_scaling_benchmark_params_t* params =
+        &iree_task_scaling_benchmark_params[i];
+    char name[64];
+    if (params->grain_size == IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT) {
+      snprintf(name, sizeof(name), "parallel_for_%" PRIhsz "w_default_grain",
+               params->worker_count);
+    } else {
+      snprintf(name, sizeof(name), "parallel_for_%" PRIhsz "w_grain_%" PRIhsz,
+               params->worker_count, params->grain_size);
+    }
+    benchmark_def.user_data = (void*)params;
+    iree_benchmark_register(iree_make_cstring_view(name), &benchmark_def);
+  }
+
+  iree_benchmark_run_specified();
+  return 0;
+}
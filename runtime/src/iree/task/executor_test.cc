@@ -135,4 +135,90 @@ TEST(ExecutorTest, SubmissionStress) {
   iree_task_topology_deinitialize(&topology);
 }
 
+// Tests that work is distributed across executors with workers partitioned
+// into multiple unevenly sized domains.
+TEST(ExecutorTest, MultipleDomains) {
+  static const uint8_t kDomainGroupCounts[] = {3, 64, 1, 12};
+  iree_task_topology_t topology;
+  iree_task_topology_initialize(&topology);
+  for (uint8_t domain_index = 0;
+       domain_index < IREE_ARRAYSIZE(kDomainGroupCounts); ++domain_index) {
+    for (uint8_t i = 0; i < kDomainGroupCounts[domain_index]; ++i) {
+      iree_task_topology_group_t group;
+      iree_task_topology_group_initialize(
+          (uint8_t)iree_task_topology_group_count(&topology), &group);
+      group.domain_index = domain_index;
+      IREE_ASSERT_OK(iree_task_topology_push_group(&topology, &group));
+    }
+  }
+  EXPECT_EQ(iree_task_topology_domain_count(&topology),
+            IREE_ARRAYSIZE(kDomainGroupCounts));
+
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  options.worker_local_memory_size = 4 * 1024;
+  iree_task_executor_t* executor = NULL;
+  IREE_ASSERT_OK(iree_task_executor_create(options, &topology,
+                                           iree_allocator_system(), &executor));
+  EXPECT_EQ(iree_task_executor_worker_count(executor),
+            iree_task_topology_group_count(&topology));
+  iree_task_scope_t scope;
+  iree_task_scope_initialize(iree_make_cstring_view("scope"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &scope);
+
+  for (int i = 0; i < 10; ++i) {
+    static std::atomic<uint32_t> tile_count = {0};
+    tile_count = 0;
+    const uint32_t workgroup_size[3] = {1, 1, 1};
+    const uint32_t workgroup_count[3] = {4096, 4, 1};
+    iree_task_dispatch_t dispatch;
+    iree_task_dispatch_initialize(
+        &scope,
+        iree_task_make_dispatch_closure(
+            [](void* user_context, const iree_task_tile_context_t* tile_context,
+               iree_task_submission_t* pending_submission) {
+              ++tile_count;
+              return iree_ok_status();
+            },
+            NULL),
+        workgroup_size, workgroup_count, &dispatch);
+
+    iree_task_fence_t* fence = NULL;
+    IREE_ASSERT_OK(iree_task_executor_acquire_fence(executor, &scope, &fence));
+    iree_task_set_completion_task(&dispatch.header, &fence->header);
+
+    iree_task_submission_t submission;
+    iree_task_submission_initialize(&submission);
+    iree_task_submission_enqueue(&submission, &dispatch.header);
+    iree_task_executor_submit(executor, &submission);
+    iree_task_executor_flush(executor);
+    IREE_ASSERT_OK(
+        iree_task_scope_wait_idle(&scope, IREE_TIME_INFINITE_FUTURE));
+    EXPECT_EQ(tile_count, workgroup_count[0] * workgroup_count[1]);
+  }
+
+  iree_task_scope_deinitialize(&scope);
+  iree_task_executor_release(executor);
+  iree_task_topology_deinitialize(&topology);
+}
+
+// Tests that topologies with domains too large for the executor are rejected.
+TEST(ExecutorTest, DomainCapacityExceeded) {
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(/*group_count=*/65, &topology);
+  for (iree_host_size_t i = 0; i < iree_task_topology_group_count(&topology);
+       ++i) {
+    topology.groups[i].domain_index = 0;
+  }
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  iree_task_executor_t* executor = NULL;
+  iree_status_t status = iree_task_executor_create(
+      options, &topology, iree_allocator_system(), &executor);
+  EXPECT_TRUE(iree_status_is_resource_exhausted(status));
+  iree_status_ignore(status);
+  EXPECT_EQ(executor, nullptr);
+  iree_task_topology_deinitialize(&topology);
+}
+
 }  // namespace
@@ -0,0 +1,204 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/task/invocation.h"
+
+#include <string.h>
+
+#include "iree/task/submission.h"
+
+// Target number of parallel-for chunks per worker when selecting a default
+// grain size. More chunks balance load better when chunk costs vary at the
+// cost of additional per-chunk overhead.
+#define IREE_TASK_PARALLEL_FOR_CHUNKS_PER_WORKER 4
+
+static void iree_task_invocation_initialize(
+    iree_task_executor_t* executor, iree_string_view_t name,
+    iree_task_invocation_t* invocation) {
+  memset(invocation, 0, sizeof(*invocation));
+  iree_task_scope_initialize(name, IREE_TASK_SCOPE_FLAG_NONE,
+                             &invocation->scope);
+  invocation->executor = executor;
+  iree_task_executor_retain(executor);
+}
+
+static void iree_task_invocation_release_resources(
+    iree_task_invocation_t* invocation) {
+  iree_task_scope_deinitialize(&invocation->scope);
+  iree_task_executor_release(invocation->executor);
+  invocation->executor = NULL;
+}
+
+// Joins |task| on a fence signaling |signal_handle| and submits it.
+static iree_status_t iree_task_invocation_submit(
+    iree_task_invocation_t* invocation, iree_task_t* task,
+    iree_wait_primitive_t signal_handle) {
+  iree_task_fence_t* fence = NULL;
+  IREE_RETURN_IF_ERROR(iree_task_executor_acquire_fence(
+      invocation->executor, &invocation->scope, &fence));
+  fence->signal_handle = signal_handle;
+  iree_task_set_completion_task(task, &fence->header);
+
+  iree_task_submission_t submission;
+  iree_task_submission_initialize(&submission);
+  iree_task_submission_enqueue(&submission, task);
+  iree_task_executor_submit(invocation->executor, &submission);
+  iree_task_executor_flush(invocation->executor);
+  return iree_ok_status();
+}
+
+//===----------------------------------------------------------------------===//
+// iree_task_executor_async_call
+//===----------------------------------------------------------------------===//
+
+static iree_status_t iree_task_invocation_call(
+    void* user_context, iree_task_t* task,
+    iree_task_submission_t* pending_submission) {
+  iree_task_invocation_t* invocation = (iree_task_invocation_t*)user_context;
+  return invocation->fn.async(invocation->user_data);
+}
+
+iree_status_t iree_task_executor_async_call(
+    iree_task_executor_t* executor, iree_task_async_fn_t fn, void* user_data,
+    iree_wait_primitive_t signal_handle,
+    iree_task_invocation_t* out_invocation) {
+  IREE_ASSERT_ARGUMENT(executor);
+  IREE_ASSERT_ARGUMENT(fn);
+  IREE_ASSERT_ARGUMENT(out_invocation);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_task_invocation_initialize(executor, IREE_SV("async_call"),
+                                  out_invocation);
+  out_invocation->fn.async = fn;
+  out_invocation->user_data = user_data;
+  iree_task_call_initialize(
+      &out_invocation->scope,
+      iree_task_make_call_closure(iree_task_invocation_call, out_invocation),
+      &out_invocation->task.call);
+
+  iree_status_t status = iree_task_invocation_submit(
+      out_invocation, &out_invocation->task.call.header, signal_handle);
+  if (!iree_status_is_ok(status)) {
+    iree_task_invocation_release_resources(out_invocation);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// iree_task_executor_parallel_for
+//===----------------------------------------------------------------------===//
+
+static iree_status_t iree_task_invocation_parallel_for_tile(
+    void* user_context, const iree_task_tile_context_t* tile_context,
+    iree_task_submission_t* pending_submission) {
+  iree_task_invocation_t* invocation = (iree_task_invocation_t*)user_context;
+
+  // Skip remaining chunks once the invocation has been cancelled or another
+  // chunk has failed. Dispatch failures only propagate to the scope when the
+  // dispatch retires so both need to be checked.
+  if (iree_atomic_load(&invocation->task.dispatch.status,
+                       iree_memory_order_relaxed) != 0 ||
+      iree_task_scope_has_failed(&invocation->scope)) {
+    return iree_ok_status();
+  }
+
+  const iree_host_size_t begin =
+      (iree_host_size_t)tile_context->workgroup_xyz[0] * invocation->grain_size;
+  const iree_host_size_t end =
+      begin + iree_min(invocation->grain_size, invocation->count - begin);
+  return invocation->fn.parallel_for(invocation->user_data, begin, end);
+}
+
+// Returns the grain size used to split |count| elements across |executor|.
+static iree_host_size_t iree_task_parallel_for_select_grain_size(
+    iree_task_executor_t* executor, iree_host_size_t count,
+    iree_host_size_t grain_size) {
+  if (grain_size == IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT) {
+    const iree_host_size_t worker_count =
+        iree_max(1, iree_task_executor_worker_count(executor));
+    grain_size = iree_host_size_ceil_div(
+        count, worker_count * IREE_TASK_PARALLEL_FOR_CHUNKS_PER_WORKER);
+  }
+  // Chunks are indexed by a 32-bit workgroup ID.
+  grain_size = iree_max(grain_size, iree_host_size_ceil_div(count, UINT32_MAX));
+  return iree_max(1, grain_size);
+}
+
+iree_status_t iree_task_executor_parallel_for(
+    iree_task_executor_t* executor, iree_host_size_t count,
+    iree_host_size_t grain_size, iree_task_parallel_for_fn_t fn,
+    void* user_data, iree_wait_primitive_t signal_handle,
+    iree_task_invocation_t* out_invocation) {
+  IREE_ASSERT_ARGUMENT(executor);
+  IREE_ASSERT_ARGUMENT(fn);
+  IREE_ASSERT_ARGUMENT(out_invocation);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)count);
+
+  iree_task_invocation_initialize(executor, IREE_SV("parallel_for"),
+                                  out_invocation);
+  out_invocation->fn.parallel_for = fn;
+  out_invocation->user_data = user_data;
+  out_invocation->count = count;
+  out_invocation->grain_size =
+      iree_task_parallel_for_select_grain_size(executor, count, grain_size);
+
+  // Dispatches with a zero workgroup count are skipped and complete
+  // immediately.
+  const uint32_t workgroup_size[3] = {1, 1, 1};
+  const uint32_t workgroup_count[3] = {
+      (uint32_t)iree_host_size_ceil_div(count, out_invocation->grain_size),
+      1,
+      1,
+  };
+  iree_task_dispatch_initialize(
+      &out_invocation->scope,
+      iree_task_make_dispatch_closure(iree_task_invocation_parallel_for_tile,
+                                      out_invocation),
+      workgroup_size, workgroup_count, &out_invocation->task.dispatch);
+
+  iree_status_t status = iree_task_invocation_submit(
+      out_invocation, &out_invocation->task.dispatch.header, signal_handle);
+  if (!iree_status_is_ok(status)) {
+    iree_task_invocation_release_resources(out_invocation);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// iree_task_invocation_t
+//===----------------------------------------------------------------------===//
+
+void iree_task_invocation_cancel(iree_task_invocation_t* invocation) {
+  IREE_ASSERT_ARGUMENT(invocation);
+  iree_task_scope_abort(&invocation->scope);
+}
+
+iree_status_t iree_task_invocation_wait(iree_task_invocation_t* invocation,
+                                        iree_timeout_t timeout) {
+  IREE_ASSERT_ARGUMENT(invocation);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_status_t status = iree_task_scope_wait_idle(
+      &invocation->scope, iree_timeout_as_deadline_ns(timeout));
+  if (iree_status_is_ok(status)) {
+    status = iree_task_scope_consume_status(&invocation->scope);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+void iree_task_invocation_deinitialize(iree_task_invocation_t* invocation) {
+  if (!invocation || !invocation->executor) return;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_IGNORE_ERROR(iree_task_scope_wait_idle(&invocation->scope,
+                                              IREE_TIME_INFINITE_FUTURE));
+  iree_task_invocation_release_resources(invocation);
+  IREE_TRACE_ZONE_END(z0);
+}
@@ -0,0 +1,135 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_TASK_INVOCATION_H_
+#define IREE_TASK_INVOCATION_H_
+
+#include "iree/base/api.h"
+#include "iree/task/executor.h"
+#include "iree/task/scope.h"
+#include "iree/task/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// Simple invocation utilities
+//===----------------------------------------------------------------------===//
+// These are helpers for host code that wants to run work on the executor
+// workers without building task DAGs itself: parameter decompression, file
+// parsing, format conversion, etc. Each invocation is a single task (a call or
+// a dispatch) tracked by its own scope and joined on an executor fence.
+//
+// Usage:
+//   iree_task_invocation_t invocation;
+//   IREE_RETURN_IF_ERROR(iree_task_executor_parallel_for(
+//       executor, element_count, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT,
+//       my_range_fn, my_state, iree_wait_primitive_immediate(), &invocation));
+//   ... do other work ...
+//   iree_status_t status =
+//       iree_task_invocation_wait(&invocation, iree_infinite_timeout());
+//   iree_task_invocation_deinitialize(&invocation);
+//
+// Waiting on an invocation blocks the calling thread. Waits must not be
+// performed from the workers of the executor the invocation was submitted to
+// as with small worker counts the wait may never be satisfied.
+
+// Function called from an executor worker by iree_task_executor_async_call.
+typedef iree_status_t(IREE_API_PTR* iree_task_async_fn_t)(void* user_data);
+
+// Function called from executor workers by iree_task_executor_parallel_for to
+// process the elements in the range [begin, end). Ranges are processed
+// concurrently and in no particular order.
+typedef iree_status_t(IREE_API_PTR* iree_task_parallel_for_fn_t)(
+    void* user_data, iree_host_size_t begin, iree_host_size_t end);
+
+// Selects a grain size such that each executor worker receives a few ranges
+// to balance load while keeping the per-range overhead low.
+#define IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT 0
+
+// An asynchronous invocation submitted to an executor.
+// Caller-allocated and must remain live and at a fixed address from the time it
+// is submitted until iree_task_invocation_deinitialize.
+typedef struct iree_task_invocation_t {
+  // Scope tracking completion and failure of the invocation task.
+  iree_task_scope_t scope;
+  // Executor the invocation was submitted to; retained.
+  iree_task_executor_t* executor;
+  // Task submitted to the executor. Completes into an executor fence.
+  union {
+    iree_task_call_t call;
+    iree_task_dispatch_t dispatch;
+  } task;
+  // User function and its data.
+  union {
+    iree_task_async_fn_t async;
+    iree_task_parallel_for_fn_t parallel_for;
+  } fn;
+  void* user_data;
+  // Total number of elements in a parallel-for range.
+  iree_host_size_t count;
+  // Number of elements processed per parallel-for function call.
+  iree_host_size_t grain_size;
+} iree_task_invocation_t;
+
+// Submits an asynchronous call of |fn| with |user_data| to |executor|.
+// The call runs on one executor worker. |user_data| must remain live until the
+// invocation has completed.
+//
+// An optional unowned |signal_handle| will be signaled with iree_event_set
+// once the invocation has completed or has been cancelled or failed. Callers
+// must still wait on the invocation with iree_task_invocation_wait before
+// deinitializing it.
+iree_status_t iree_task_executor_async_call(
+    iree_task_executor_t* executor, iree_task_async_fn_t fn, void* user_data,
+    iree_wait_primitive_t signal_handle,
+    iree_task_invocation_t* out_invocation);
+
+// Submits a parallel-for over the elements [0, |count|) to |executor|.
+// The range is split into chunks of |grain_size| elements (the last chunk may
+// be smaller) and |fn| is called once per chunk on any executor worker.
+// Specify IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT to have the grain size
+// selected based on the number of workers available. |user_data| must remain
+// live until the invocation has completed.
+//
+// If any call of |fn| fails or the invocation is cancelled the remaining chunks
+// will be skipped. Chunks already executing will run to completion.
+//
+// An optional unowned |signal_handle| will be signaled with iree_event_set
+// once the invocation has completed or has been cancelled or failed. Callers
+// must still wait on the invocation with iree_task_invocation_wait before
+// deinitializing it.
+iree_status_t iree_task_executor_parallel_for(
+    iree_task_executor_t* executor, iree_host_size_t count,
+    iree_host_size_t grain_size, iree_task_parallel_for_fn_t fn,
+    void* user_data, iree_wait_primitive_t signal_handle,
+    iree_task_invocation_t* out_invocation);
+
+// Requests that the |invocation| be cancelled. Work that has not yet started
+// will be skipped and the invocation will complete with IREE_STATUS_ABORTED.
+// If the invocation has already completed or failed this is ignored.
+// Callers must still wait on the invocation with iree_task_invocation_wait.
+void iree_task_invocation_cancel(iree_task_invocation_t* invocation);
+
+// Waits for the |invocation| to complete and returns its result.
+// Returns IREE_STATUS_DEADLINE_EXCEEDED if the |timeout| elapses before the
+// invocation completes, in which case the invocation is still in-flight.
+// The full failure status is returned on the first wait only and subsequent
+// waits return just the status code.
+iree_status_t iree_task_invocation_wait(iree_task_invocation_t* invocation,
+                                        iree_timeout_t timeout);
+
+// Deinitializes the |invocation| after waiting for it to complete.
+// Any failure status that was not returned by iree_task_invocation_wait is
+// ignored.
+void iree_task_invocation_deinitialize(iree_task_invocation_t* invocation);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_TASK_INVOCATION_H_
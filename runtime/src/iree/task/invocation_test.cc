@@ -0,0 +1,194 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/task/invocation.h"
+
+#include <atomic>
+#include <memory>
+
+#include "iree/base/internal/wait_handle.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+using iree::Status;
+using iree::StatusCode;
+using iree::testing::status::StatusIs;
+
+class InvocationTest : public ::testing::TestWithParam<int> {
+ protected:
+  virtual void SetUp() {
+    iree_task_topology_t topology;
+    iree_task_topology_initialize_from_group_count(
+        /*group_count=*/GetParam(), &topology);
+    iree_task_executor_options_t options;
+    iree_task_executor_options_initialize(&options);
+    IREE_ASSERT_OK(iree_task_executor_create(
+        options, &topology, iree_allocator_system(), &executor_));
+    iree_task_topology_deinitialize(&topology);
+  }
+
+  virtual void TearDown() { iree_task_executor_release(executor_); }
+
+  iree_task_executor_t* executor_ = NULL;
+};
+
+TEST_P(InvocationTest, AsyncCall) {
+  std::atomic<int> call_count = {0};
+  iree_task_invocation_t invocation;
+  IREE_ASSERT_OK(iree_task_executor_async_call(
+      executor_,
+      [](void* user_data) {
+        ++*(std::atomic<int>*)user_data;
+        return iree_ok_status();
+      },
+      &call_count, iree_wait_primitive_immediate(), &invocation));
+  IREE_EXPECT_OK(
+      iree_task_invocation_wait(&invocation, iree_infinite_timeout()));
+  iree_task_invocation_deinitialize(&invocation);
+  EXPECT_EQ(call_count, 1);
+}
+
+TEST_P(InvocationTest, AsyncCallFailure) {
+  iree_task_invocation_t invocation;
+  IREE_ASSERT_OK(iree_task_executor_async_call(
+      executor_,
+      [](void* user_data) {
+        return iree_make_status(IREE_STATUS_DATA_LOSS, "whoops!");
+      },
+      NULL, iree_wait_primitive_immediate(), &invocation));
+  EXPECT_THAT(Status(iree_task_invocation_wait(&invocation,
+                                               iree_infinite_timeout())),
+              StatusIs(StatusCode::kDataLoss));
+  iree_task_invocation_deinitialize(&invocation);
+}
+
+// Tracks how many times each element of a parallel-for range was visited.
+struct RangeState {
+  explicit RangeState(iree_host_size_t count)
+      : count(count), visits(new std::atomic<int>[count]) {
+    for (iree_host_size_t i = 0; i < count; ++i) visits[i] = 0;
+  }
+  static iree_status_t Visit(void* user_data, iree_host_size_t begin,
+                             iree_host_size_t end) {
+    auto* state = (RangeState*)user_data;
+    if (begin >= end || end > state->count) {
+      return iree_make_status(IREE_STATUS_OUT_OF_RANGE, "bad range");
+    }
+    for (iree_host_size_t i = begin; i < end; ++i) ++state->visits[i];
+    return iree_ok_status();
+  }
+  bool VisitedOnce() const {
+    for (iree_host_size_t i = 0; i < count; ++i) {
+      if (visits[i] != 1) return false;
+    }
+    return true;
+  }
+  iree_host_size_t count;
+  std::unique_ptr<std::atomic<int>[]> visits;
+};
+
+TEST_P(InvocationTest, ParallelForEmpty) {
+  RangeState state(0);
+  iree_task_invocation_t invocation;
+  IREE_ASSERT_OK(iree_task_executor_parallel_for(
+      executor_, /*count=*/0, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT,
+      RangeState::Visit, &state, iree_wait_primitive_immediate(),
+      &invocation));
+  IREE_EXPECT_OK(
+      iree_task_invocation_wait(&invocation, iree_infinite_timeout()));
+  iree_task_invocation_deinitialize(&invocation);
+}
+
+TEST_P(InvocationTest, ParallelForDefaultGrain) {
+  RangeState state(10007);
+  iree_task_invocation_t invocation;
+  IREE_ASSERT_OK(iree_task_executor_parallel_for(
+      executor_, state.count, IREE_TASK_PARALLEL_FOR_GRAIN_SIZE_DEFAULT,
+      RangeState::Visit, &state, iree_wait_primitive_immediate(),
+      &invocation));
+  IREE_EXPECT_OK(
+      iree_task_invocation_wait(&invocation, iree_infinite_timeout()));
+  iree_task_invocation_deinitialize(&invocation);
+  EXPECT_TRUE(state.VisitedOnce());
+}
+
+TEST_P(InvocationTest, ParallelForUnevenGrain) {
+  RangeState state(1000);
+  iree_task_invocation_t invocation;
+  IREE_ASSERT_OK(iree_task_executor_parallel_for(
+      executor_, state.count, /*grain_size=*/7, RangeState::Visit, &state,
+      iree_wait_primitive_immediate(), &invocation));
+  IREE_EXPECT_OK(
+      iree_task_invocation_wait(&invocation, iree_infinite_timeout()));
+  iree_task_invocation_deinitialize(&invocation);
+  EXPECT_TRUE(state.VisitedOnce());
+}
+
+// Tests that a failing chunk fails the invocation and signals the fence.
+TEST_P(InvocationTest, ParallelForFailure) {
+  iree_event_t event;
+  IREE_ASSERT_OK(iree_event_initialize(/*initial_state=*/false, &event));
+  iree_task_invocation_t invocation;
+  IREE_ASSERT_OK(iree_task_executor_parallel_for(
+      executor_, /*count=*/100, /*grain_size=*/1,
+      [](void* user_data, iree_host_size_t begin, iree_host_size_t end) {
+        if (begin == 50) {
+          return iree_make_status(IREE_STATUS_DATA_LOSS, "whoops!");
+        }
+        return iree_ok_status();
+      },
+      NULL, iree_make_wait_primitive(event.type, event.value), &invocation));
+  IREE_EXPECT_OK(iree_wait_one(&event, IREE_TIME_INFINITE_FUTURE));
+  EXPECT_THAT(Status(iree_task_invocation_wait(&invocation,
+                                               iree_infinite_timeout())),
+              StatusIs(StatusCode::kDataLoss));
+  iree_task_invocation_deinitialize(&invocation);
+  iree_event_deinitialize(&event);
+}
+
+// Tests that cancelling an invocation skips the chunks that have not started.
+TEST_P(InvocationTest, ParallelForCancel) {
+  struct CancelState {
+    iree_event_t started;
+    iree_event_t resume;
+    std::atomic<int> chunk_count = {0};
+  } state;
+  IREE_ASSERT_OK(iree_event_initialize(/*initial_state=*/false,
+                                       &state.started));
+  IREE_ASSERT_OK(iree_event_initialize(/*initial_state=*/false,
+                                       &state.resume));
+
+  // Every chunk blocks until the test has cancelled the invocation so at most
+  // one chunk per worker can begin before the cancellation is observed.
+  iree_task_invocation_t invocation;
+  IREE_ASSERT_OK(iree_task_executor_parallel_for(
+      executor_, /*count=*/1000, /*grain_size=*/1,
+      [](void* user_data, iree_host_size_t begin, iree_host_size_t end) {
+        auto* state = (CancelState*)user_data;
+        ++state->chunk_count;
+        iree_event_set(&state->started);
+        return iree_wait_one(&state->resume, IREE_TIME_INFINITE_FUTURE);
+      },
+      &state, iree_wait_primitive_immediate(), &invocation));
+  IREE_ASSERT_OK(iree_wait_one(&state.started, IREE_TIME_INFINITE_FUTURE));
+  iree_task_invocation_cancel(&invocation);
+  iree_event_set(&state.resume);
+  EXPECT_THAT(Status(iree_task_invocation_wait(&invocation,
+                                               iree_infinite_timeout())),
+              StatusIs(StatusCode::kAborted));
+  iree_task_invocation_deinitialize(&invocation);
+  EXPECT_LE(state.chunk_count, (int)iree_task_executor_worker_count(executor_));
+
+  iree_event_deinitialize(&state.started);
+  iree_event_deinitialize(&state.resume);
+}
+
+INSTANTIATE_TEST_SUITE_P(WorkerCounts, InvocationTest,
+                         ::testing::Values(1, 4));
+
+}  // namespace
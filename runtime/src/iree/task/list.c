@@ -136,6 +136,18 @@ void iree_task_list_append_from_fifo_slist(iree_task_list_t* list,
   iree_task_list_append(list, &suffix);
 }
 
+void iree_task_list_partition_by_priority(
+    iree_task_list_t* list,
+    iree_task_list_t out_lists[IREE_TASK_PRIORITY_COUNT]) {
+  for (iree_host_size_t i = 0; i < IREE_TASK_PRIORITY_COUNT; ++i) {
+    iree_task_list_initialize(&out_lists[i]);
+  }
+  iree_task_t* task = NULL;
+  while ((task = iree_task_list_pop_front(list))) {
+    iree_task_list_push_back(&out_lists[iree_task_priority(task)], task);
+  }
+}
+
 void iree_task_list_reverse(iree_task_list_t* list) {
   if (iree_task_list_is_empty(list)) return;
   iree_task_t* tail = list->head;
@@ -12,6 +12,7 @@
 
 #include "iree/base/api.h"
 #include "iree/base/internal/atomic_slist.h"
+#include "iree/task/scope.h"
 #include "iree/task/task.h"
 
 #ifdef __cplusplus
@@ -92,6 +93,12 @@ void iree_task_list_append(iree_task_list_t* list, iree_task_list_t* suffix);
 void iree_task_list_append_from_fifo_slist(iree_task_list_t* list,
                                            iree_atomic_task_slist_t* slist);
 
+// Moves all tasks from |list| into |out_lists| indexed by task priority.
+// Tasks of the same priority retain their relative order. |list| will be reset.
+void iree_task_list_partition_by_priority(
+    iree_task_list_t* list,
+    iree_task_list_t out_lists[IREE_TASK_PRIORITY_COUNT]);
+
 // Reverses the list in-place.
 // Requires a full O(n) traversal.
 void iree_task_list_reverse(iree_task_list_t* list);
@@ -21,7 +21,10 @@ void iree_task_post_batch_initialize(iree_task_executor_t* executor,
                                      iree_task_post_batch_t* out_post_batch) {
   out_post_batch->executor = executor;
   out_post_batch->current_worker = current_worker;
-  out_post_batch->worker_pending_mask = 0;
+  out_post_batch->current_worker_max_priority = IREE_TASK_PRIORITY_LOW;
+  out_post_batch->domain_pending_mask = 0;
+  memset(&out_post_batch->worker_pending_masks, 0,
+         executor->domain_count * sizeof(iree_task_affinity_set_t));
   memset(&out_post_batch->worker_pending_lifos, 0,
          executor->worker_count * sizeof(iree_task_list_t));
 }
@@ -31,57 +34,103 @@ iree_host_size_t iree_task_post_batch_worker_count(
   return post_batch->executor->worker_count;
 }
 
-static iree_host_size_t iree_task_post_batch_select_random_worker(
-    iree_task_post_batch_t* post_batch, iree_task_affinity_set_t affinity_set) {
+// Selects a worker from |affinity_set| in the domain at |domain_index|.
+// Returns false if no workers in the domain are valid.
+static bool iree_task_post_batch_select_domain_worker(
+    iree_task_post_batch_t* post_batch, iree_host_size_t domain_index,
+    iree_task_affinity_set_t affinity_set,
+    iree_host_size_t* out_worker_index) {
   // The masks are accessed with 'relaxed' order because they are just hints.
+  iree_task_executor_domain_t* domain =
+      &post_batch->executor->domains[domain_index];
   iree_task_affinity_set_t worker_live_mask =
-      iree_atomic_task_affinity_set_load(
-          &post_batch->executor->worker_live_mask, iree_memory_order_relaxed);
+      iree_atomic_task_affinity_set_load(&domain->worker_live_mask,
+                                         iree_memory_order_relaxed);
   iree_task_affinity_set_t valid_worker_mask = affinity_set & worker_live_mask;
-  if (!valid_worker_mask) {
-    // No valid workers as desired; for now just bail to worker 0.
-    return 0;
-  }
+  if (!valid_worker_mask) return false;
 
   // TODO(benvanik): rotate through workers here. Instead, if the affinity set
   // has the current_worker allowed we just use that to avoid needing a
   // cross-thread hop.
-  return iree_task_affinity_set_count_trailing_zeros(valid_worker_mask);
+  *out_worker_index =
+      domain->worker_base +
+      iree_task_affinity_set_count_trailing_zeros(valid_worker_mask);
+  return true;
+}
+
+// Selects an idle worker from |affinity_set| in the domain at |domain_index|.
+// Returns false if no workers in the domain are idle.
+static bool iree_task_post_batch_select_idle_domain_worker(
+    iree_task_post_batch_t* post_batch, iree_host_size_t domain_index,
+    iree_task_affinity_set_t affinity_set,
+    iree_host_size_t* out_worker_index) {
+  // Note that we only consider workers idle if we ourselves in this batch
+  // haven't already queued work for them (as then they aren't going to be
+  // idle). The masks are accessed with 'relaxed' order because they are just
+  // hints.
+  iree_task_affinity_set_t worker_idle_mask =
+      iree_atomic_task_affinity_set_load(
+          &post_batch->executor->domains[domain_index].worker_idle_mask,
+          iree_memory_order_relaxed);
+  worker_idle_mask &= ~post_batch->worker_pending_masks[domain_index];
+  iree_task_affinity_set_t idle_affinity_set = affinity_set & worker_idle_mask;
+  if (!idle_affinity_set) return false;
+  return iree_task_post_batch_select_domain_worker(
+      post_batch, domain_index, idle_affinity_set, out_worker_index);
 }
 
 iree_host_size_t iree_task_post_batch_select_worker(
-    iree_task_post_batch_t* post_batch, iree_task_affinity_set_t affinity_set) {
+    iree_task_post_batch_t* post_batch, iree_task_domain_set_t domain_set,
+    iree_task_affinity_set_t affinity_set) {
+  iree_task_executor_t* executor = post_batch->executor;
+  iree_host_size_t home_domain_index = 0;
   if (post_batch->current_worker) {
     // Posting from a worker - prefer sending right back to this worker if we
     // haven't already scheduled for it.
-    if ((affinity_set & post_batch->current_worker->worker_bit) &&
-        !(post_batch->worker_pending_mask &
-          post_batch->current_worker->worker_bit)) {
-      return iree_task_affinity_set_count_trailing_zeros(
-          post_batch->current_worker->worker_bit);
+    const iree_task_worker_t* current_worker = post_batch->current_worker;
+    home_domain_index = current_worker->domain_index;
+    if ((domain_set & iree_task_domain_set_for_domain(home_domain_index)) &&
+        (affinity_set & current_worker->worker_bit) &&
+        !(post_batch->worker_pending_masks[home_domain_index] &
+          current_worker->worker_bit)) {
+      return executor->domains[home_domain_index].worker_base +
+             iree_task_affinity_set_count_trailing_zeros(
+                 current_worker->worker_bit);
     }
   }
 
   // Prefer workers that are idle as though they'll need to wake up it is
   // guaranteed that they aren't working on something else and the latency of
   // waking should (hopefully) be less than the latency of waiting for a
-  // worker's queue to finish. Note that we only consider workers idle if we
-  // ourselves in this batch haven't already queued work for them (as then they
-  // aren't going to be idle).
-  // The masks are accessed with 'relaxed' order because they are just hints.
-  iree_task_affinity_set_t worker_idle_mask =
-      iree_atomic_task_affinity_set_load(
-          &post_batch->executor->worker_idle_mask, iree_memory_order_relaxed);
-  worker_idle_mask &= ~post_batch->worker_pending_mask;
-  iree_task_affinity_set_t idle_affinity_set = affinity_set & worker_idle_mask;
-  if (idle_affinity_set) {
-    return iree_task_post_batch_select_random_worker(post_batch,
-                                                     idle_affinity_set);
+  // worker's queue to finish. Idle workers in the domain of the current worker
+  // are preferred as they are likely to share caches with the work that
+  // produced the task.
+  iree_host_size_t worker_index = 0;
+  for (iree_host_size_t i = 0; i < executor->domain_count; ++i) {
+    iree_host_size_t domain_index =
+        (home_domain_index + i) % executor->domain_count;
+    if (!(domain_set & iree_task_domain_set_for_domain(domain_index))) continue;
+    if (iree_task_post_batch_select_idle_domain_worker(
+            post_batch, domain_index, affinity_set, &worker_index)) {
+      return worker_index;
+    }
   }
 
   // No more workers are idle; farm out at random. In the worst case work
   // stealing will help balance things out on the backend.
-  return iree_task_post_batch_select_random_worker(post_batch, affinity_set);
+  for (iree_host_size_t i = 0; i < executor->domain_count; ++i) {
+    iree_host_size_t domain_index =
+        (home_domain_index + i) % executor->domain_count;
+    if (!(domain_set & iree_task_domain_set_for_domain(domain_index))) continue;
+    if (iree_task_post_batch_select_domain_worker(post_batch, domain_index,
+                                                  affinity_set,
+                                                  &worker_index)) {
+      return worker_index;
+    }
+  }
+
+  // No valid workers as desired; for now just bail to worker 0.
+  return 0;
 }
 
 void iree_task_post_batch_enqueue(iree_task_post_batch_t* post_batch,
@@ -89,15 +138,27 @@ void iree_task_post_batch_enqueue(iree_task_post_batch_t* post_batch,
                                   iree_task_t* task) {
   iree_task_list_push_front(&post_batch->worker_pending_lifos[worker_index],
                             task);
-  post_batch->worker_pending_mask |=
-      iree_task_affinity_for_worker(worker_index);
+  const iree_task_executor_t* executor = post_batch->executor;
+  if (&executor->workers[worker_index] == post_batch->current_worker) {
+    iree_task_priority_t priority = iree_task_priority(task);
+    if (priority > post_batch->current_worker_max_priority) {
+      post_batch->current_worker_max_priority = priority;
+    }
+  }
+  const uint8_t domain_index = executor->worker_domain_indices[worker_index];
+  post_batch->domain_pending_mask |=
+      iree_task_domain_set_for_domain(domain_index);
+  post_batch->worker_pending_masks[domain_index] |=
+      iree_task_affinity_for_worker(
+          worker_index - executor->domains[domain_index].worker_base);
 }
 
-// Wakes each worker indicated in the |wake_mask|, if needed.
+// Wakes each worker indicated in the |wake_masks| of the domains indicated in
+// |domain_wake_mask|, if needed.
 static void iree_task_post_batch_wake_workers(
-    iree_task_post_batch_t* post_batch, iree_task_affinity_set_t wake_mask) {
+    iree_task_post_batch_t* post_batch, iree_task_domain_set_t domain_wake_mask,
+    const iree_task_affinity_set_t* wake_masks) {
   IREE_TRACE_ZONE_BEGIN(z0);
-  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, iree_math_count_ones_u64(wake_mask));
 
   // TODO(#4016): use a FUTEX_WAKE_BITSET here to wake all of the workers that
   // have pending work in a single syscall (vs. popcnt(worker_pending_mask)
@@ -108,63 +169,101 @@ static void iree_task_post_batch_wake_workers(
   // threads will be needed simultaneously and can hopefully perform any needed
   // migrations prior to beginning execution.
   iree_task_executor_t* executor = post_batch->executor;
-  int wake_count = iree_task_affinity_set_count_ones(wake_mask);
-  int worker_index = 0;
-  for (int i = 0; i < wake_count; ++i) {
-    int offset = iree_task_affinity_set_count_trailing_zeros(wake_mask);
-    int wake_index = worker_index + offset;
-    worker_index += offset + 1;
-    wake_mask = iree_shr(wake_mask, offset + 1);
-
-    // Wake workers if they are waiting - workers are the only thing that can
-    // wait on this notification so this should almost always be either free (an
-    // atomic load) if a particular worker isn't waiting or it's required to
-    // actually wake it and we can't avoid it.
-    iree_task_worker_t* worker = &executor->workers[wake_index];
-    iree_notification_post(&worker->wake_notification, 1);
+  int total_wake_count = 0;
+  while (domain_wake_mask) {
+    int domain_index =
+        iree_task_domain_set_count_trailing_zeros(domain_wake_mask);
+    domain_wake_mask &= domain_wake_mask - 1;
+    iree_task_affinity_set_t wake_mask = wake_masks[domain_index];
+    int wake_count = iree_task_affinity_set_count_ones(wake_mask);
+    total_wake_count += wake_count;
+    iree_host_size_t worker_index = executor->domains[domain_index].worker_base;
+    for (int i = 0; i < wake_count; ++i) {
+      int offset = iree_task_affinity_set_count_trailing_zeros(wake_mask);
+      iree_host_size_t wake_index = worker_index + offset;
+      worker_index += offset + 1;
+      wake_mask = iree_shr(wake_mask, offset + 1);
+
+      // Wake workers if they are waiting - workers are the only thing that can
+      // wait on this notification so this should almost always be either free
+      // (an atomic load) if a particular worker isn't waiting or it's required
+      // to actually wake it and we can't avoid it.
+      iree_task_worker_t* worker = &executor->workers[wake_index];
+      iree_notification_post(&worker->wake_notification, 1);
+    }
   }
+  (void)total_wake_count;
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, total_wake_count);
+  IREE_STATISTICS(iree_atomic_fetch_add(&executor->wake_count,
+                                        total_wake_count,
+                                        iree_memory_order_relaxed));
 
   IREE_TRACE_ZONE_END(z0);
 }
 
 bool iree_task_post_batch_submit(iree_task_post_batch_t* post_batch) {
-  if (!post_batch->worker_pending_mask) return false;
+  if (!post_batch->domain_pending_mask) return false;
 
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  // Run through each worker that has a bit set in the pending mask and post
+  // Run through each worker that has a bit set in the pending masks and post
   // the pending tasks.
-  iree_task_affinity_set_t worker_mask = post_batch->worker_pending_mask;
-  post_batch->worker_pending_mask = 0;
-  int worker_index = 0;
-  int post_count = iree_task_affinity_set_count_ones(worker_mask);
-  iree_task_affinity_set_t worker_wake_mask = 0;
-  for (int i = 0; i < post_count; ++i) {
-    int offset = iree_task_affinity_set_count_trailing_zeros(worker_mask);
-    int target_index = worker_index + offset;
-    worker_index += offset + 1;
-    worker_mask = iree_shr(worker_mask, offset + 1);
-
-    iree_task_worker_t* worker = &post_batch->executor->workers[target_index];
-    iree_task_list_t* target_pending_lifo =
-        &post_batch->worker_pending_lifos[target_index];
-    if (worker == post_batch->current_worker) {
-      // Fast-path for posting to self; this happens when a worker plays the
-      // role of coordinator and we want to ensure we aren't doing a fully
-      // block-and-flush loop when we could just be popping the next new task
-      // off the list.
-      iree_task_queue_append_from_lifo_list_unsafe(&worker->local_task_queue,
-                                                   target_pending_lifo);
-    } else {
-      iree_task_worker_post_tasks(worker, target_pending_lifo);
-      worker_wake_mask |= iree_task_affinity_for_worker(target_index);
+  iree_task_executor_t* executor = post_batch->executor;
+  iree_task_domain_set_t domain_mask = post_batch->domain_pending_mask;
+  post_batch->domain_pending_mask = 0;
+  const iree_task_priority_t current_worker_max_priority =
+      post_batch->current_worker_max_priority;
+  post_batch->current_worker_max_priority = IREE_TASK_PRIORITY_LOW;
+  iree_task_domain_set_t domain_wake_mask = 0;
+  iree_task_affinity_set_t
+      worker_wake_masks[IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT];
+  int post_count = 0;
+  while (domain_mask) {
+    int domain_index = iree_task_domain_set_count_trailing_zeros(domain_mask);
+    domain_mask &= domain_mask - 1;
+    iree_task_affinity_set_t worker_mask =
+        post_batch->worker_pending_masks[domain_index];
+    post_batch->worker_pending_masks[domain_index] = 0;
+    iree_task_affinity_set_t worker_wake_mask = 0;
+    iree_host_size_t worker_base = executor->domains[domain_index].worker_base;
+    int worker_bit_index = 0;
+    int domain_post_count = iree_task_affinity_set_count_ones(worker_mask);
+    for (int i = 0; i < domain_post_count; ++i) {
+      int offset = iree_task_affinity_set_count_trailing_zeros(worker_mask);
+      int target_bit_index = worker_bit_index + offset;
+      worker_bit_index += offset + 1;
+      worker_mask = iree_shr(worker_mask, offset + 1);
+
+      iree_host_size_t target_index = worker_base + target_bit_index;
+      iree_task_worker_t* worker = &executor->workers[target_index];
+      iree_task_list_t* target_pending_lifo =
+          &post_batch->worker_pending_lifos[target_index];
+      if (worker == post_batch->current_worker &&
+          current_worker_max_priority <= IREE_TASK_PRIORITY_NORMAL) {
+        // Fast-path for posting to self; this happens when a worker plays the
+        // role of coordinator and we want to ensure we aren't doing a fully
+        // block-and-flush loop when we could just be popping the next new task
+        // off the list. Tasks of higher than normal priority go through the
+        // mailbox so that the worker moves them ahead of its local work.
+        iree_task_queue_append_from_lifo_list_unsafe(&worker->local_task_queue,
+                                                     target_pending_lifo);
+      } else {
+        iree_task_worker_post_tasks(worker, target_pending_lifo);
+        worker_wake_mask |= iree_task_affinity_for_worker(target_bit_index);
+      }
+    }
+    post_count += domain_post_count;
+    worker_wake_masks[domain_index] = worker_wake_mask;
+    if (worker_wake_mask) {
+      domain_wake_mask |= iree_task_domain_set_for_domain(domain_index);
     }
   }
 
   // Wake all workers that now have pending work. If a worker is not already
   // waiting this will be cheap (no syscall).
-  if (worker_wake_mask != 0) {
-    iree_task_post_batch_wake_workers(post_batch, worker_wake_mask);
+  if (domain_wake_mask != 0) {
+    iree_task_post_batch_wake_workers(post_batch, domain_wake_mask,
+                                      worker_wake_masks);
   }
 
   IREE_TRACE_ZONE_END(z0);
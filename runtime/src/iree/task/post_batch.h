@@ -13,6 +13,7 @@
 #include "iree/task/affinity_set.h"
 #include "iree/task/executor.h"
 #include "iree/task/list.h"
+#include "iree/task/scope.h"
 #include "iree/task/task.h"
 #include "iree/task/tuning.h"
 
@@ -35,9 +36,18 @@ typedef struct iree_task_post_batch_t {
   // May be NULL if not being posted from a worker (such as a submission).
   iree_task_worker_t* current_worker;
 
-  // A bitmask of workers indicating which have pending tasks in their lists.
-  // Used to quickly scan the lists and perform the posts only when required.
-  iree_task_affinity_set_t worker_pending_mask;
+  // Highest priority of the tasks pending for |current_worker|. Tasks above
+  // normal priority are posted through its mailbox instead of its local queue.
+  iree_task_priority_t current_worker_max_priority;
+
+  // A bitmask of domains indicating which have workers with pending tasks.
+  iree_task_domain_set_t domain_pending_mask;
+
+  // A per-domain bitmask of workers indicating which have pending tasks in
+  // their lists. Used to quickly scan the lists and perform the posts only when
+  // required.
+  iree_task_affinity_set_t
+      worker_pending_masks[IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT];
 
   // A per-worker LIFO task list waiting to be posted.
   iree_task_list_t worker_pending_lifos[0];
@@ -51,9 +61,12 @@ void iree_task_post_batch_initialize(iree_task_executor_t* executor,
 iree_host_size_t iree_task_post_batch_worker_count(
     const iree_task_post_batch_t* post_batch);
 
-// Selects a random worker from the given affinity set.
+// Selects a worker from the given |affinity_set| in the domains in
+// |domain_set|. Workers in the domain of the current worker are preferred.
+// Returns the executor-local worker index.
 iree_host_size_t iree_task_post_batch_select_worker(
-    iree_task_post_batch_t* post_batch, iree_task_affinity_set_t affinity_set);
+    iree_task_post_batch_t* post_batch, iree_task_domain_set_t domain_set,
+    iree_task_affinity_set_t affinity_set);
 
 // Enqueues a task to the given worker. Note that the pending work lists for
 // each work is kept in LIFO order so that we can easily concatenate it with the
@@ -0,0 +1,193 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/task/executor.h"
+#include "iree/task/scope.h"
+#include "iree/task/submission.h"
+#include "iree/task/task.h"
+#include "iree/task/topology.h"
+#include "iree/testing/benchmark.h"
+
+// Number of tiles in each background dispatch per worker. Background
+// dispatches are large enough that a foreground dispatch submitted at a random
+// time will almost always find all workers busy with background tiles.
+#define IREE_TASK_PRIORITY_BENCHMARK_BACKGROUND_TILES_PER_WORKER (1024)
+
+// Number of iterations of arithmetic performed per background tile.
+#define IREE_TASK_PRIORITY_BENCHMARK_BACKGROUND_TILE_WORK (8 * 1024)
+
+// Number of iterations of arithmetic performed per foreground tile.
+#define IREE_TASK_PRIORITY_BENCHMARK_FOREGROUND_TILE_WORK (256)
+
+// Configuration of the load used by a benchmark.
+typedef struct iree_task_priority_benchmark_params_t {
+  // Number of workers in the executor.
+  iree_host_size_t worker_count;
+  // Priority of the continuously running background dispatches.
+  iree_task_priority_t background_priority;
+  // Priority of the small dispatches whose latency is measured.
+  iree_task_priority_t foreground_priority;
+} iree_task_priority_benchmark_params_t;
+
+// Performs |user_context| iterations of arithmetic to simulate a workgroup.
+static iree_status_t iree_task_priority_benchmark_tile(
+    void* user_context, const iree_task_tile_context_t* tile_context,
+    iree_task_submission_t* pending_submission) {
+  const uintptr_t work = (uintptr_t)user_context;
+  uint32_t value = tile_context->workgroup_xyz[0];
+  for (uintptr_t i = 0; i < work; ++i) {
+    value = value * 1664525u + 1013904223u;
+  }
+  iree_benchmark_use_ptr((char const volatile*)&value);
+  return iree_ok_status();
+}
+
+// Submits a dispatch of |tile_count| tiles each performing |tile_work|
+// iterations into |scope|. |dispatch_task| must remain live until the scope is
+// idle.
+static void iree_task_priority_benchmark_submit(
+    iree_task_executor_t* executor, iree_task_scope_t* scope,
+    uint32_t tile_count, uintptr_t tile_work,
+    iree_task_dispatch_t* dispatch_task) {
+  const uint32_t workgroup_size[3] = {1, 1, 1};
+  const uint32_t workgroup_count[3] = {tile_count, 1, 1};
+  iree_task_dispatch_initialize(
+      scope,
+      iree_task_make_dispatch_closure(iree_task_priority_benchmark_tile,
+                                      (void*)tile_work),
+      workgroup_size, workgroup_count, dispatch_task);
+  iree_task_fence_t* fence = NULL;
+  IREE_CHECK_OK(iree_task_executor_acquire_fence(executor, scope, &fence));
+  iree_task_set_completion_task(&dispatch_task->header, &fence->header);
+  iree_task_submission_t submission;
+  iree_task_submission_initialize(&submission);
+  iree_task_submission_enqueue(&submission, &dispatch_task->header);
+  iree_task_executor_submit(executor, &submission);
+  iree_task_executor_flush(executor);
+}
+
+// Keeps all workers busy with background dispatches while measuring the time
+// from submission to completion of small foreground dispatches. Reports
+// foreground dispatches per second; lower iteration times are lower latency.
+//
+// user_data is an iree_task_priority_benchmark_params_t.
+static iree_status_t iree_task_priority_benchmark_execute(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  const iree_task_priority_benchmark_params_t* params =
+      (const iree_task_priority_benchmark_params_t*)benchmark_def->user_data;
+
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(params->worker_count,
+                                                 &topology);
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  iree_task_executor_t* executor = NULL;
+  IREE_CHECK_OK(iree_task_executor_create(
+      options, &topology, benchmark_state->host_allocator, &executor));
+  iree_task_topology_deinitialize(&topology);
+
+  iree_task_scope_t background_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("background"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &background_scope);
+  iree_task_scope_set_priority(&background_scope, params->background_priority);
+  iree_task_scope_t foreground_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("foreground"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &foreground_scope);
+  iree_task_scope_set_priority(&foreground_scope, params->foreground_priority);
+
+  const uint32_t background_tile_count =
+      (uint32_t)params->worker_count *
+      IREE_TASK_PRIORITY_BENCHMARK_BACKGROUND_TILES_PER_WORKER;
+  const uint32_t foreground_tile_count = (uint32_t)params->worker_count;
+  iree_task_dispatch_t background_task;
+  iree_task_dispatch_t foreground_task;
+
+  int64_t dispatch_count = 0;
+  while (iree_benchmark_keep_running(benchmark_state, /*batch_count=*/1)) {
+    // Restart the background load whenever the previous one has completed.
+    iree_benchmark_pause_timing(benchmark_state);
+    if (iree_task_scope_is_idle(&background_scope)) {
+      iree_task_priority_benchmark_submit(
+          executor, &background_scope, background_tile_count,
+          IREE_TASK_PRIORITY_BENCHMARK_BACKGROUND_TILE_WORK, &background_task);
+    }
+    iree_benchmark_resume_timing(benchmark_state);
+
+    iree_task_priority_benchmark_submit(
+        executor, &foreground_scope, foreground_tile_count,
+        IREE_TASK_PRIORITY_BENCHMARK_FOREGROUND_TILE_WORK, &foreground_task);
+    IREE_CHECK_OK(iree_task_scope_wait_idle(&foreground_scope,
+                                            IREE_TIME_INFINITE_FUTURE));
+    ++dispatch_count;
+  }
+  iree_benchmark_set_items_processed(benchmark_state, dispatch_count);
+
+  IREE_CHECK_OK(
+      iree_task_scope_wait_idle(&background_scope, IREE_TIME_INFINITE_FUTURE));
+  iree_task_scope_deinitialize(&foreground_scope);
+  iree_task_scope_deinitialize(&background_scope);
+  iree_task_executor_release(executor);
+  return iree_ok_status();
+}
+
+// Foreground dispatches at the same priority as the background load wait for
+// the background dispatch to drain while those at a higher priority preempt it
+// between tile reservations.
+static const iree_task_priority_benchmark_params_t
+    iree_task_priority_benchmark_params[] = {
+        {4, IREE_TASK_PRIORITY_NORMAL, IREE_TASK_PRIORITY_NORMAL},
+        {4, IREE_TASK_PRIORITY_NORMAL, IREE_TASK_PRIORITY_HIGH},
+        {4, IREE_TASK_PRIORITY_LOW, IREE_TASK_PRIORITY_NORMAL},
+        {16, IREE_TASK_PRIORITY_NORMAL, IREE_TASK_PRIORITY_NORMAL},
+        {16, IREE_TASK_PRIORITY_NORMAL, IREE_TASK_PRIORITY_HIGH},
+        {16, IREE_TASK_PRIORITY_LOW, IREE_TASK_PRIORITY_NORMAL},
+};
+
+static const char* iree_task_priority_benchmark_name(
+    iree_task_priority_t priority) {
+  switch (priority) {
+    case IREE_TASK_PRIORITY_LOW:
+      return "low";
+    case IREE_TASK_PRIORITY_NORMAL:
+      return "normal";
+    case IREE_TASK_PRIORITY_HIGH:
+      return "high";
+    default:
+      return "unknown";
+  }
+}
+
+int main(int argc, char** argv) {
+  iree_benchmark_initialize(&argc, argv);
+
+  iree_benchmark_def_t benchmark_def = {
+      .flags = IREE_BENCHMARK_FLAG_USE_REAL_TIME,
+      .time_unit = IREE_BENCHMARK_UNIT_MICROSECOND,
+      .minimum_duration_ns = 0,
+      .iteration_count = 0,
+      .run = iree_task_priority_benchmark_execute,
+  };
+  for (iree_host_size_t i = 0;
+       i < IREE_ARRAYSIZE(iree_task_priority_benchmark_params); ++i) {
+    const iree_task_priority_benchmark_params_t* params =
+        &iree_task_priority_benchmark_params[i];
+    char name[64];
+    snprintf(name, sizeof(name), "mixed_load_%" PRIhsz "w_%s_over_%s",
+             params->worker_count,
+             iree_task_priority_benchmark_name(params->foreground_priority),
+             iree_task_priority_benchmark_name(params->background_priority));
+    benchmark_def.user_data = (void*)params;
+    iree_benchmark_register(iree_make_cstring_view(name), &benchmark_def);
+  }
+
+  iree_benchmark_run_specified();
+  return 0;
+}
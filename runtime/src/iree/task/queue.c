@@ -61,6 +61,33 @@ iree_task_t* iree_task_queue_flush_from_lifo_slist(
   return next_task;
 }
 
+void iree_task_queue_flush_from_lifo_slist_by_priority(
+    iree_task_queue_t* queue, iree_atomic_task_slist_t* source_slist,
+    iree_task_priority_t priority) {
+  iree_task_list_t flushed;
+  iree_task_list_initialize(&flushed);
+  if (!iree_atomic_task_slist_flush(
+          source_slist, IREE_ATOMIC_SLIST_FLUSH_ORDER_APPROXIMATE_FIFO,
+          &flushed.head, &flushed.tail)) {
+    return;
+  }
+
+  // Partition the tasks by priority outside of the lock.
+  iree_task_list_t priority_lists[IREE_TASK_PRIORITY_COUNT];
+  iree_task_list_partition_by_priority(&flushed, priority_lists);
+
+  // Higher priorities are prepended such that the highest ends up at the front
+  // and lower priorities are appended such that the lowest ends up at the back.
+  iree_slim_mutex_lock(&queue->mutex);
+  for (int i = priority + 1; i < IREE_TASK_PRIORITY_COUNT; ++i) {
+    iree_task_list_prepend(&queue->list, &priority_lists[i]);
+  }
+  for (int i = priority; i >= 0; --i) {
+    iree_task_list_append(&queue->list, &priority_lists[i]);
+  }
+  iree_slim_mutex_unlock(&queue->mutex);
+}
+
 iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue) {
   iree_slim_mutex_lock(&queue->mutex);
   iree_task_t* next_task = iree_task_list_pop_front(&queue->list);
@@ -143,6 +143,16 @@ void iree_task_queue_append_from_lifo_list_unsafe(iree_task_queue_t* queue,
 iree_task_t* iree_task_queue_flush_from_lifo_slist(
     iree_task_queue_t* queue, iree_atomic_task_slist_t* source_slist);
 
+// Flushes the |source_slist| LIFO mailbox into the task queue in priority
+// order. Tasks with a priority above |priority| are placed at the front of the
+// queue ahead of all pre-existing tasks while the remaining tasks are appended.
+// Tasks of the same priority retain their FIFO order.
+//
+// Must only be called from the owning worker's thread.
+void iree_task_queue_flush_from_lifo_slist_by_priority(
+    iree_task_queue_t* queue, iree_atomic_task_slist_t* source_slist,
+    iree_task_priority_t priority);
+
 // Pops a task from the front of the queue if any are available.
 //
 // Must only be called from the owning worker's thread.
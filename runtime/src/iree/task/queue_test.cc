@@ -190,6 +190,59 @@ TEST(QueueTest, FlushSlistOrdered) {
   iree_task_queue_deinitialize(&queue);
 }
 
+TEST(QueueTest, FlushSlistByPriority) {
+  iree_task_scope_t low_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("low"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &low_scope);
+  iree_task_scope_set_priority(&low_scope, IREE_TASK_PRIORITY_LOW);
+  iree_task_scope_t high_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("high"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &high_scope);
+  iree_task_scope_set_priority(&high_scope, IREE_TASK_PRIORITY_HIGH);
+
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+
+  // Queue up an existing normal priority task.
+  iree_task_t task_a = {0};
+  iree_task_queue_push_front(&queue, &task_a);
+
+  // Make a lifo list: e<-d<-c<-b with mixed priorities.
+  iree_atomic_task_slist_t slist;
+  iree_atomic_task_slist_initialize(&slist);
+  iree_task_t task_b = {0};
+  task_b.scope = &low_scope;
+  iree_atomic_task_slist_push(&slist, &task_b);
+  iree_task_t task_c = {0};
+  task_c.scope = &high_scope;
+  iree_atomic_task_slist_push(&slist, &task_c);
+  iree_task_t task_d = {0};
+  iree_atomic_task_slist_push(&slist, &task_d);
+  iree_task_t task_e = {0};
+  task_e.scope = &high_scope;
+  iree_atomic_task_slist_push(&slist, &task_e);
+
+  // Flush the list to the queue; higher priority tasks should be placed ahead
+  // of the existing task and lower priority tasks after it.
+  iree_task_queue_flush_from_lifo_slist_by_priority(&queue, &slist,
+                                                    IREE_TASK_PRIORITY_NORMAL);
+
+  // Pop list and ensure order: c->e->a->d->b.
+  EXPECT_EQ(&task_c, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(&task_e, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(&task_a, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(&task_d, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(&task_b, iree_task_queue_pop_front(&queue));
+  EXPECT_TRUE(iree_task_queue_is_empty(&queue));
+
+  iree_atomic_task_slist_deinitialize(&slist);
+
+  iree_task_queue_deinitialize(&queue);
+
+  iree_task_scope_deinitialize(&high_scope);
+  iree_task_scope_deinitialize(&low_scope);
+}
+
 TEST(QueueTest, TryStealEmpty) {
   iree_task_queue_t source_queue;
   iree_task_queue_initialize(&source_queue);
@@ -26,6 +26,7 @@ void iree_task_scope_initialize(iree_string_view_t name,
   out_scope->name[name_length] = 0;
 
   out_scope->flags = flags;
+  out_scope->priority = IREE_TASK_PRIORITY_NORMAL;
 
   // TODO(benvanik): pick trace colors based on name hash.
   IREE_TRACE(out_scope->task_trace_color = 0xFFFF0000u);
@@ -66,6 +67,12 @@ iree_string_view_t iree_task_scope_name(iree_task_scope_t* scope) {
   return iree_make_cstring_view(scope->name);
 }
 
+void iree_task_scope_set_priority(iree_task_scope_t* scope,
+                                  iree_task_priority_t priority) {
+  IREE_ASSERT_LT(priority, IREE_TASK_PRIORITY_COUNT);
+  scope->priority = priority;
+}
+
 iree_task_dispatch_statistics_t iree_task_scope_consume_statistics(
     iree_task_scope_t* scope) {
   iree_task_dispatch_statistics_t result = scope->dispatch_statistics;
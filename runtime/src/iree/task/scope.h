@@ -28,6 +28,30 @@ enum iree_task_scope_flag_bits_e {
 };
 typedef uint32_t iree_task_scope_flags_t;
 
+// Relative scheduling priority of the tasks within a scope.
+// Ready tasks from higher priority scopes are scheduled ahead of those from
+// lower priority scopes by both the coordinator and the workers and dispatches
+// from lower priority scopes may be preempted between tile reservations.
+typedef enum iree_task_priority_e {
+  // Work that may be delayed by all other work (prefetching, warmup, etc).
+  IREE_TASK_PRIORITY_LOW = 0,
+  // Default priority of all scopes.
+  IREE_TASK_PRIORITY_NORMAL = 1,
+  // Latency-sensitive work that should preempt lower priority work.
+  IREE_TASK_PRIORITY_HIGH = 2,
+  // Total number of priorities; not a valid priority.
+  IREE_TASK_PRIORITY_COUNT,
+} iree_task_priority_t;
+
+// A bitmask of priorities with one bit (1 << iree_task_priority_t) each.
+typedef uint32_t iree_task_priority_mask_t;
+
+// Returns a mask with the bits of all priorities strictly above |priority|.
+static inline iree_task_priority_mask_t iree_task_priority_mask_above(
+    iree_task_priority_t priority) {
+  return ~((2u << priority) - 1u);
+}
+
 // iree_task_scope_t is an atomic reference-counting helper posting a
 // notification when the reference count is decremended to 0.
 //
@@ -60,6 +84,9 @@ typedef struct iree_task_scope_t {
   // Flags controlling optional scope behavior.
   iree_task_scope_flags_t flags;
 
+  // Scheduling priority of all tasks within the scope.
+  iree_task_priority_t priority;
+
   // Base color used for tasks in this scope.
   // The color will be modulated based on task type.
   IREE_TRACE(uint32_t task_trace_color;)
@@ -101,6 +128,17 @@ void iree_task_scope_deinitialize(iree_task_scope_t* scope);
 // string.
 iree_string_view_t iree_task_scope_name(iree_task_scope_t* scope);
 
+// Sets the scheduling priority of all tasks within the scope.
+// Scopes default to IREE_TASK_PRIORITY_NORMAL. Must only be changed while the
+// scope is idle as in-flight tasks read the priority while being scheduled.
+void iree_task_scope_set_priority(iree_task_scope_t* scope,
+                                  iree_task_priority_t priority);
+
+// Returns the scheduling priority of |task| as defined by its scope.
+static inline iree_task_priority_t iree_task_priority(const iree_task_t* task) {
+  return task->scope ? task->scope->priority : IREE_TASK_PRIORITY_NORMAL;
+}
+
 // Returns and resets the statistics for the scope.
 // Statistics may experience tearing (non-atomic update across fields) if this
 // is performed while tasks are in-flight.
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "iree/base/internal/math.h"
 #include "iree/task/list.h"
 #include "iree/task/pool.h"
 #include "iree/task/post_batch.h"
@@ -27,6 +28,7 @@ void iree_task_initialize(iree_task_type_t type, iree_task_scope_t* scope,
   memset(out_task, 0, sizeof(*out_task));
   out_task->scope = scope;
   out_task->affinity_set = iree_task_affinity_for_any_worker();
+  out_task->domain_set = iree_task_domain_set_for_any_domain();
   out_task->type = type;
 }
 
@@ -93,6 +95,7 @@ static void iree_task_cleanup(iree_task_t* task,
 
 static void iree_task_barrier_discard(iree_task_barrier_t* task,
                                       iree_task_list_t* discard_worklist);
+static void iree_task_fence_discard(iree_task_fence_t* task);
 
 void iree_task_discard(iree_task_t* task, iree_task_list_t* discard_worklist) {
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -126,6 +129,7 @@ void iree_task_discard(iree_task_t* task, iree_task_list_t* discard_worklist) {
       break;
     case IREE_TASK_TYPE_FENCE:
       end_scope = task->scope;  // need to clean up the task first
+      iree_task_fence_discard((iree_task_fence_t*)task);
       break;
     case IREE_TASK_TYPE_WAIT:
     case IREE_TASK_TYPE_DISPATCH:
@@ -371,6 +375,17 @@ void iree_task_fence_initialize(iree_task_scope_t* scope,
   iree_task_scope_begin(scope);
 }
 
+// Signals the optional wait primitive of the fence |task|.
+static void iree_task_fence_signal(iree_task_fence_t* task) {
+  // TODO(benvanik): better API that doesn't require wrapping or requiring that
+  // iree_event_t is an iree_wait_handle_t.
+  iree_wait_handle_t signal_handle = {
+      .type = task->signal_handle.type,
+      .value = task->signal_handle.value,
+  };
+  iree_event_set(&signal_handle);
+}
+
 void iree_task_fence_retire(iree_task_fence_t* task,
                             iree_task_submission_t* pending_submission) {
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -381,13 +396,7 @@ void iree_task_fence_retire(iree_task_fence_t* task,
   // while we are still using it.
   iree_task_scope_t* end_scope = task->header.scope;
 
-  // TODO(benvanik): better API that doesn't require wrapping or requiring that
-  // iree_event_t is an iree_wait_handle_t.
-  iree_wait_handle_t signal_handle = {
-      .type = task->signal_handle.type,
-      .value = task->signal_handle.value,
-  };
-  iree_event_set(&signal_handle);
+  iree_task_fence_signal(task);
 
   iree_task_retire(&task->header, pending_submission, iree_ok_status());
 
@@ -398,6 +407,12 @@ void iree_task_fence_retire(iree_task_fence_t* task,
   IREE_TRACE_ZONE_END(z0);
 }
 
+// Fences discarded due to failure or cancellation still signal so that any
+// waiter on the primitive observes completion and can query the scope status.
+static void iree_task_fence_discard(iree_task_fence_t* task) {
+  iree_task_fence_signal(task);
+}
+
 //==============================================================================
 // IREE_TASK_TYPE_WAIT
 //==============================================================================
@@ -514,7 +529,156 @@ static uint32_t iree_task_tile_to_color(
 void iree_task_dispatch_statistics_merge(
     const iree_task_dispatch_statistics_t* source,
     iree_task_dispatch_statistics_t* target) {
-  // TODO(benvanik): statistics.
+#if IREE_STATISTICS_ENABLE
+  int64_t tile_count = iree_atomic_load(
+      (iree_atomic_int64_t*)&source->tile_count, iree_memory_order_relaxed);
+  if (tile_count) {
+    iree_atomic_fetch_add(&target->tile_count, tile_count,
+                          iree_memory_order_relaxed);
+  }
+#endif  // IREE_STATISTICS_ENABLE
+}
+
+// Returns the log2 of the smallest power of two >= |count|.
+static uint32_t iree_task_tile_extent_log2(uint32_t count) {
+  return count <= 1 ? 0 : 32 - iree_math_count_leading_zeros_u32(count - 1);
+}
+
+// Returns the number of tile indices in each z slice of a |workgroup_count|
+// grid when traversed in |tile_order|.
+static uint64_t iree_task_dispatch_slice_index_count(
+    iree_task_dispatch_tile_order_t tile_order,
+    const uint32_t workgroup_count[3]) {
+  if (tile_order == IREE_TASK_DISPATCH_TILE_ORDER_MORTON &&
+      workgroup_count[0] != 0 && workgroup_count[1] != 0) {
+    return 1ull << (iree_task_tile_extent_log2(workgroup_count[0]) +
+                    iree_task_tile_extent_log2(workgroup_count[1]));
+  }
+  return (uint64_t)workgroup_count[0] * workgroup_count[1];
+}
+
+// Returns the tile order used for a |workgroup_count| grid when |tile_order|
+// was requested. Orders only matter when both x and y have extents and fall
+// back to row-major when their index space would not fit in 32 bits.
+static iree_task_dispatch_tile_order_t iree_task_dispatch_select_tile_order(
+    iree_task_dispatch_tile_order_t tile_order,
+    const uint32_t workgroup_count[3]) {
+  if (workgroup_count[0] <= 1 || workgroup_count[1] <= 1) {
+    return IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR;
+  }
+  switch (tile_order) {
+    case IREE_TASK_DISPATCH_TILE_ORDER_COLUMN_MAJOR:
+      return tile_order;
+    case IREE_TASK_DISPATCH_TILE_ORDER_MORTON:
+      if (iree_task_dispatch_slice_index_count(tile_order, workgroup_count) *
+              workgroup_count[2] >
+          UINT32_MAX) {
+        return IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR;
+      }
+      return tile_order;
+    case IREE_TASK_DISPATCH_TILE_ORDER_GROUPED:
+      if ((uint64_t)workgroup_count[0] *
+              IREE_TASK_DISPATCH_TILE_ORDER_GROUP_SIZE >
+          UINT32_MAX) {
+        return IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR;
+      }
+      return tile_order;
+    default:
+      return IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR;
+  }
+}
+
+// Precomputed state for mapping tile indices to locations in a dispatch grid.
+typedef struct iree_task_tile_traversal_t {
+  iree_task_dispatch_tile_order_t order;
+  uint32_t count_x;
+  uint32_t count_y;
+  // Number of tile indices in each z slice.
+  uint32_t slice_index_count;
+  // MORTON: number of bits of x and y interleaved in the low bits of the slice
+  // index. The remaining high bits belong to the larger of x and y.
+  uint32_t interleaved_bits;
+  // MORTON: true if the high bits of the slice index belong to x.
+  bool x_has_high_bits;
+  // GROUPED: number of tile indices in each band of y rows.
+  uint32_t group_index_count;
+} iree_task_tile_traversal_t;
+
+static void iree_task_tile_traversal_initialize(
+    const iree_task_dispatch_t* dispatch_task,
+    iree_task_tile_traversal_t* out_traversal) {
+  const uint32_t* workgroup_count = dispatch_task->workgroup_count.value;
+  out_traversal->order = iree_task_dispatch_select_tile_order(
+      dispatch_task->tile_order, workgroup_count);
+  out_traversal->count_x = workgroup_count[0];
+  out_traversal->count_y = workgroup_count[1];
+  out_traversal->slice_index_count = (uint32_t)iree_max(
+      1, iree_task_dispatch_slice_index_count(out_traversal->order,
+                                              workgroup_count));
+  const uint32_t log2_x = iree_task_tile_extent_log2(workgroup_count[0]);
+  const uint32_t log2_y = iree_task_tile_extent_log2(workgroup_count[1]);
+  out_traversal->interleaved_bits = iree_min(log2_x, log2_y);
+  out_traversal->x_has_high_bits = log2_x > log2_y;
+  out_traversal->group_index_count =
+      workgroup_count[0] * IREE_TASK_DISPATCH_TILE_ORDER_GROUP_SIZE;
+}
+
+// Gathers the even bits of |value| into the low 16 bits.
+static inline uint32_t iree_task_morton_compact_u32(uint32_t value) {
+  value &= 0x55555555u;
+  value = (value | (value >> 1)) & 0x33333333u;
+  value = (value | (value >> 2)) & 0x0F0F0F0Fu;
+  value = (value | (value >> 4)) & 0x00FF00FFu;
+  value = (value | (value >> 8)) & 0x0000FFFFu;
+  return value;
+}
+
+// Maps |tile_index| to its grid location in |out_xyz|.
+// Returns false if the index lies outside of the grid and must be skipped.
+static inline bool iree_task_tile_traversal_map(
+    const iree_task_tile_traversal_t* traversal, uint32_t tile_index,
+    uint32_t out_xyz[3]) {
+  const uint32_t slice_index = tile_index % traversal->slice_index_count;
+  out_xyz[2] = tile_index / traversal->slice_index_count;
+  switch (traversal->order) {
+    default:
+    case IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR:
+      out_xyz[0] = slice_index % traversal->count_x;
+      out_xyz[1] = slice_index / traversal->count_x;
+      return true;
+    case IREE_TASK_DISPATCH_TILE_ORDER_COLUMN_MAJOR:
+      out_xyz[0] = slice_index / traversal->count_y;
+      out_xyz[1] = slice_index % traversal->count_y;
+      return true;
+    case IREE_TASK_DISPATCH_TILE_ORDER_MORTON: {
+      const uint32_t bits = traversal->interleaved_bits;
+      const uint32_t low_index = slice_index & ((1u << (2 * bits)) - 1);
+      const uint32_t high_index = (slice_index >> (2 * bits)) << bits;
+      uint32_t x = iree_task_morton_compact_u32(low_index);
+      uint32_t y = iree_task_morton_compact_u32(low_index >> 1);
+      if (traversal->x_has_high_bits) {
+        x |= high_index;
+      } else {
+        y |= high_index;
+      }
+      out_xyz[0] = x;
+      out_xyz[1] = y;
+      return x < traversal->count_x && y < traversal->count_y;
+    }
+    case IREE_TASK_DISPATCH_TILE_ORDER_GROUPED: {
+      const uint32_t group_index = slice_index / traversal->group_index_count;
+      const uint32_t group_y =
+          group_index * IREE_TASK_DISPATCH_TILE_ORDER_GROUP_SIZE;
+      const uint32_t group_height =
+          iree_min(IREE_TASK_DISPATCH_TILE_ORDER_GROUP_SIZE,
+                   traversal->count_y - group_y);
+      const uint32_t group_offset =
+          slice_index - group_index * traversal->group_index_count;
+      out_xyz[0] = group_offset / group_height;
+      out_xyz[1] = group_y + group_offset % group_height;
+      return true;
+    }
+  }
 }
 
 //==============================================================================
@@ -529,6 +693,7 @@ static void iree_task_dispatch_initialize_base(
   memcpy(out_task->workgroup_size, workgroup_size,
          sizeof(out_task->workgroup_size));
   out_task->local_memory_size = 0;
+  out_task->tile_order = IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR;
   iree_atomic_store(&out_task->status, 0, iree_memory_order_release);
   memset(&out_task->statistics, 0, sizeof(out_task->statistics));
 
@@ -596,31 +761,40 @@ void iree_task_dispatch_issue(iree_task_dispatch_t* dispatch_task,
 #endif  // IREE_HAL_VERBOSE_TRACING_ENABLE
 
   // Setup the iteration space for shards to pull work from the complete grid.
+  // Tile orders that walk a padded index space have more indices than tiles.
+  const uint32_t grid_tile_count =
+      workgroup_count[0] * workgroup_count[1] * workgroup_count[2];
+  const iree_task_dispatch_tile_order_t tile_order =
+      iree_task_dispatch_select_tile_order(dispatch_task->tile_order,
+                                           workgroup_count);
   iree_atomic_store(&dispatch_task->tile_index, 0, iree_memory_order_relaxed);
   dispatch_task->tile_count =
-      workgroup_count[0] * workgroup_count[1] * workgroup_count[2];
+      grid_tile_count == 0
+          ? 0
+          : (uint32_t)(iree_task_dispatch_slice_index_count(tile_order,
+                                                            workgroup_count) *
+                       workgroup_count[2]);
 
   // Compute shard count - almost always worker_count unless we are a very small
   // dispatch (1x1x1, etc).
   iree_host_size_t worker_count = iree_task_post_batch_worker_count(post_batch);
-  iree_host_size_t shard_count =
-      iree_min(dispatch_task->tile_count, worker_count);
+  iree_host_size_t shard_count = iree_min(grid_tile_count, worker_count);
 
   // Compute how many tiles we want each shard to reserve at a time from the
   // larger grid. A higher number reduces overhead and improves locality while
   // a lower number reduces maximum worst-case latency (coarser work stealing).
-  if (dispatch_task->tile_count <
-      worker_count * IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION) {
-    // Grid is small - allow it to be eagerly sliced up.
-    dispatch_task->tiles_per_reservation = 1;
-  } else {
-    dispatch_task->tiles_per_reservation =
-        IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION;
-  }
+  // Small grids are split such that each shard makes a few reservations
+  // instead of contending on the tile index for every tile.
+  const iree_host_size_t reservation_count =
+      iree_max(1, shard_count * IREE_TASK_DISPATCH_RESERVATIONS_PER_SHARD);
+  dispatch_task->tiles_per_reservation = (uint32_t)iree_min(
+      IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION,
+      iree_max(1, dispatch_task->tile_count / reservation_count));
 
   // Randomize starting worker.
   iree_host_size_t worker_offset = iree_task_post_batch_select_worker(
-      post_batch, dispatch_task->header.affinity_set);
+      post_batch, dispatch_task->header.domain_set,
+      dispatch_task->header.affinity_set);
   iree_host_size_t worker_index = worker_offset;
 
   for (iree_host_size_t i = 0; i < shard_count; ++i) {
@@ -691,6 +865,7 @@ void iree_task_dispatch_shard_initialize(iree_task_dispatch_t* dispatch_task,
   iree_task_initialize(IREE_TASK_TYPE_DISPATCH_SHARD,
                        dispatch_task->header.scope, &out_task->header);
   iree_task_set_completion_task(&out_task->header, &dispatch_task->header);
+  out_task->yield_count = 0;
 }
 
 iree_task_dispatch_shard_t* iree_task_dispatch_shard_allocate(
@@ -707,9 +882,11 @@ iree_task_dispatch_shard_t* iree_task_dispatch_shard_allocate(
   return shard_task;
 }
 
-void iree_task_dispatch_shard_execute(
+bool iree_task_dispatch_shard_execute(
     iree_task_dispatch_shard_t* task, iree_cpu_processor_id_t processor_id,
     uint32_t worker_id, iree_byte_span_t worker_local_memory,
+    iree_task_dispatch_statistics_t* worker_statistics,
+    iree_atomic_int32_t* preemption_mask,
     iree_task_submission_t* pending_submission) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
@@ -732,7 +909,7 @@ void iree_task_dispatch_shard_execute(
                          worker_local_memory.data_length));
     iree_task_retire(&task->header, pending_submission, iree_ok_status());
     IREE_TRACE_ZONE_END(z0);
-    return;
+    return false;
   }
 
   // Prepare context shared for all tiles in the shard.
@@ -741,8 +918,8 @@ void iree_task_dispatch_shard_execute(
          sizeof(tile_context.workgroup_size));
   memcpy(&tile_context.workgroup_count, dispatch_task->workgroup_count.value,
          sizeof(tile_context.workgroup_count));
-  uint32_t workgroup_count_x = tile_context.workgroup_count[0];
-  uint32_t workgroup_count_y = tile_context.workgroup_count[1];
+  iree_task_tile_traversal_t traversal;
+  iree_task_tile_traversal_initialize(dispatch_task, &traversal);
   tile_context.worker_id = worker_id;
   tile_context.local_memory = worker_local_memory;
 
@@ -756,7 +933,16 @@ void iree_task_dispatch_shard_execute(
   // Hint as to which processor we are running on.
   tile_context.processor_id = processor_id;
 
+  // Tasks of higher priority than the shard posted to the worker will cause
+  // the shard to yield between reservations (a bounded number of times).
+  const iree_task_priority_mask_t preemption_priority_mask =
+      task->yield_count < IREE_TASK_DISPATCH_SHARD_MAX_YIELD_COUNT
+          ? iree_task_priority_mask_above(iree_task_priority(&task->header))
+          : 0;
+  bool did_yield = false;
+
   // Loop over all tiles until they are all processed.
+  IREE_STATISTICS(int64_t executed_tile_count = 0);
   const uint32_t tile_count = dispatch_task->tile_count;
   const uint32_t tiles_per_reservation = dispatch_task->tiles_per_reservation;
   // relaxed order because we only care about atomic increments, not about
@@ -771,12 +957,10 @@ void iree_task_dispatch_shard_execute(
          ++tile_index) {
       // TODO(benvanik): faster math here, especially knowing we pull off N
       // sequential indices per reservation.
-      uint32_t tile_i = tile_index;
-      tile_context.workgroup_xyz[0] = tile_i % workgroup_count_x;
-      tile_i /= workgroup_count_x;
-      tile_context.workgroup_xyz[1] = tile_i % workgroup_count_y;
-      tile_i /= workgroup_count_y;
-      tile_context.workgroup_xyz[2] = tile_i;
+      if (!iree_task_tile_traversal_map(&traversal, tile_index,
+                                        tile_context.workgroup_xyz)) {
+        continue;  // padding outside of the grid
+      }
 
       IREE_TRACE_ZONE_BEGIN_NAMED(z_tile,
                                   "iree_task_dispatch_shard_execute_tile");
@@ -796,6 +980,7 @@ void iree_task_dispatch_shard_execute(
                                     &tile_context, pending_submission);
 
       IREE_TRACE_ZONE_END(z_tile);
+      IREE_STATISTICS(++executed_tile_count);
 
       // If any tile fails we bail early from the loop. This doesn't match
       // what an accelerator would do but saves some unneeded work.
@@ -810,6 +995,16 @@ void iree_task_dispatch_shard_execute(
       }
     }
 
+    // Yield to higher priority tasks before reserving more tiles. No tiles
+    // are held by the shard and any remaining will be reserved when resumed.
+    if (IREE_UNLIKELY(iree_atomic_load(preemption_mask,
+                                       iree_memory_order_relaxed) &
+                      preemption_priority_mask)) {
+      ++task->yield_count;
+      did_yield = true;
+      break;
+    }
+
     // Try to grab the next slice of tiles.
     tile_base =
         iree_atomic_fetch_add(&dispatch_task->tile_index, tiles_per_reservation,
@@ -817,14 +1012,26 @@ void iree_task_dispatch_shard_execute(
   }
 abort_shard:
 
-  // Push aggregate statistics up to the dispatch.
+  // Push aggregate statistics up to the dispatch and the worker.
   // Note that we may have partial information here if we errored out of the
   // loop but that's still useful to know.
+  IREE_STATISTICS(iree_atomic_store(&shard_statistics.tile_count,
+                                    executed_tile_count,
+                                    iree_memory_order_relaxed));
   iree_task_dispatch_statistics_merge(&shard_statistics,
                                       &dispatch_task->statistics);
+  iree_task_dispatch_statistics_merge(&shard_statistics, worker_statistics);
+
+  // Yielded shards are requeued by the caller and retire once resumed.
+  if (did_yield) {
+    IREE_TRACE_ZONE_APPEND_TEXT(z0, "yielded");
+    IREE_TRACE_ZONE_END(z0);
+    return true;
+  }
 
   // NOTE: even if an error was hit we retire OK - the error has already been
   // propagated to the dispatch and it'll clean up after all shards are joined.
   iree_task_retire(&task->header, pending_submission, iree_ok_status());
   IREE_TRACE_ZONE_END(z0);
+  return false;
 }
@@ -162,8 +162,12 @@ struct iree_alignas(iree_max_align_t) iree_task_t {
   // of the specific work being performed. For example, some dispatches can be
   // limited to run on certain microarchitectures that workers have affinity
   // with at the OS scheduler level (such as little.BIG topologies).
+  // The set is relative to each executor worker domain in |domain_set|.
   iree_task_affinity_set_t affinity_set;
 
+  // Specifies which executor worker domains will be used to execute this task.
+  iree_task_domain_set_t domain_set;
+
   // Total number of dependent tasks still outstanding. Decremented each time
   // a dependent task completes. The task is considered ready to execute when
   // this value reaches 0.
@@ -492,10 +496,14 @@ void iree_task_wait_set_wait_any(iree_task_wait_t* task,
 // generic ones like 'l2 cache misses' or 'ipc') then we can sprinkle in some
 // #ifdefs.
 typedef struct iree_task_dispatch_statistics_t {
-  // TODO(benvanik): statistics counters.
   // NOTE: each of these increases the command buffer storage requirements; we
   // should always guard these with IREE_STATISTICS_ENABLE.
+#if IREE_STATISTICS_ENABLE
+  // Total number of tiles executed, including those that failed.
+  iree_atomic_int64_t tile_count;
+#else
   iree_atomic_int32_t reserved;
+#endif  // IREE_STATISTICS_ENABLE
 } iree_task_dispatch_statistics_t;
 
 // Merges statistics from |source| to |target| atomically per-field.
@@ -584,6 +592,26 @@ static inline iree_task_dispatch_closure_t iree_task_make_dispatch_closure(
 // IREE_TASK_TYPE_DISPATCH
 //==============================================================================
 
+// Order in which the tiles of a dispatch grid are handed out to shards.
+// Shards reserve contiguous ranges of tiles in this order and tiles that are
+// close together in the order are likely to execute at the same time on
+// neighboring workers. Orders that keep tiles sharing operands (such as the
+// rows and columns of a matmul) together improve cache reuse. Only the x and y
+// dimensions are reordered; z is always the slowest varying.
+typedef enum iree_task_dispatch_tile_order_e {
+  // Linear xyz order with x varying fastest.
+  IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR = 0,
+  // y varies fastest followed by x.
+  IREE_TASK_DISPATCH_TILE_ORDER_COLUMN_MAJOR = 1,
+  // Morton (Z-order) curve over x and y. The curve is walked over the
+  // power-of-two extents of the grid and indices outside of it are skipped.
+  IREE_TASK_DISPATCH_TILE_ORDER_MORTON = 2,
+  // Bands of IREE_TASK_DISPATCH_TILE_ORDER_GROUP_SIZE y rows traversed
+  // column-major. Consecutive tiles share either x or y with their neighbors
+  // (grouped-M swizzling when y indexes the M dimension of a matmul).
+  IREE_TASK_DISPATCH_TILE_ORDER_GROUPED = 3,
+} iree_task_dispatch_tile_order_t;
+
 // An execution request across a tiled grid.
 // Dispatches are fork points where zero or more dispatch shard tasks are
 // spawned and processed prior to joining again on the dispatch completion task.
@@ -628,6 +656,10 @@ typedef iree_alignas(iree_max_align_t) struct iree_task_dispatch_t {
   // dispatch closure.
   uint32_t local_memory_size;
 
+  // Order in which tiles are distributed to shards.
+  // Defaults to IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR.
+  iree_task_dispatch_tile_order_t tile_order;
+
   // Resulting status from the dispatch available once all workgroups have
   // completed (or would have completed). If multiple shards processing the
   // workgroups hit an error the first will be taken and the result ignored. A
@@ -638,7 +670,9 @@ typedef iree_alignas(iree_max_align_t) struct iree_task_dispatch_t {
   // Statistics storage used for aggregating counters across all shards.
   iree_task_dispatch_statistics_t statistics;
 
-  // The total number of tiles in the dispatch bounding tile_index.
+  // The total number of tile indices in the dispatch bounding tile_index.
+  // This is the number of tiles in the grid unless the tile order walks a
+  // larger index space and skips indices outside of the grid.
   uint32_t tile_count;
 
   // Maximum number of tiles to fetch per tile reservation from the grid.
@@ -678,6 +712,10 @@ typedef iree_alignas(iree_max_align_t) struct {
 
   // NOTE: the parent dispatch task this shard is applied to is in the
   // header.completion_task field.
+
+  // Number of times the shard has yielded to higher priority tasks.
+  // Bounded by IREE_TASK_DISPATCH_SHARD_MAX_YIELD_COUNT.
+  uint32_t yield_count;
 } iree_task_dispatch_shard_t;
 
 void iree_task_dispatch_shard_initialize(iree_task_dispatch_t* dispatch_task,
@@ -118,11 +118,21 @@ iree_task_dispatch_shard_t* iree_task_dispatch_shard_allocate(
 // |worker_local_memory| is a block of memory exclusively available to the shard
 // during execution. Contents are undefined both before and after execution.
 //
+// |worker_statistics| receives the statistics of the shard in addition to the
+// parent dispatch so that executors can aggregate them per-worker.
+//
+// |preemption_mask| is an iree_task_priority_mask_t of the tasks pending on the
+// worker. If any are of a higher priority than the shard it may yield between
+// tile reservations and return true without retiring. The caller must requeue
+// the shard to have it continue processing the remaining tiles later.
+//
 // Errors are propagated to the parent scope and the dispatch will fail once
 // all shards have completed.
-void iree_task_dispatch_shard_execute(
+bool iree_task_dispatch_shard_execute(
     iree_task_dispatch_shard_t* task, iree_cpu_processor_id_t processor_id,
     uint32_t worker_id, iree_byte_span_t worker_local_memory,
+    iree_task_dispatch_statistics_t* worker_statistics,
+    iree_atomic_int32_t* preemption_mask,
     iree_task_submission_t* pending_submission);
 
 #ifdef __cplusplus
@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/threading.h"
 #include "iree/task/submission.h"
 #include "iree/task/task.h"
 #include "iree/task/testing/task_test.h"
@@ -70,7 +71,9 @@ class TaskDispatchTest : public TaskTest {
  public:
   void DispatchAndVerifyGrid(const uint32_t workgroup_size[3],
                              const uint32_t workgroup_count[3],
-                             uint32_t dispatch_flags) {
+                             uint32_t dispatch_flags,
+                             iree_task_dispatch_tile_order_t tile_order =
+                                 IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR) {
     IREE_TRACE_SCOPE();
     GridCoverage coverage(workgroup_count);
     iree_task_dispatch_t task;
@@ -79,6 +82,7 @@ class TaskDispatchTest : public TaskTest {
         iree_task_make_dispatch_closure(GridCoverage::Tile, (void*)&coverage),
         workgroup_size, workgroup_count, &task);
     task.header.flags |= dispatch_flags;
+    task.tile_order = tile_order;
     IREE_ASSERT_OK(SubmitTasksAndWaitIdle(&task.header, &task.header));
     EXPECT_TRUE(coverage.Verify());
   }
@@ -112,6 +116,246 @@ TEST_F(TaskDispatchTest, Issue345) {
   DispatchAndVerifyGrid(kWorkgroupSize, kWorkgroupCount, IREE_TASK_FLAG_NONE);
 }
 
+#if IREE_STATISTICS_ENABLE
+// Tests that executed tiles are reported in the executor statistics.
+TEST_F(TaskDispatchTest, IssueStatistics) {
+  IREE_TRACE_SCOPE();
+  const uint32_t kWorkgroupSize[3] = {1, 1, 1};
+  const uint32_t kWorkgroupCount[3] = {3, 4, 5};
+  DispatchAndVerifyGrid(kWorkgroupSize, kWorkgroupCount, IREE_TASK_FLAG_NONE);
+  iree_task_executor_statistics_t statistics;
+  iree_task_executor_query_statistics(executor_, &statistics);
+  EXPECT_EQ(statistics.tile_count, 3 * 4 * 5);
+  EXPECT_GE(statistics.coordination_count, 1);
+}
+#endif  // IREE_STATISTICS_ENABLE
+
+// Tests that every tile order covers grids with extents that are not powers of
+// two or multiples of the tile order group size exactly once.
+TEST_F(TaskDispatchTest, IssueTileOrders) {
+  IREE_TRACE_SCOPE();
+  const uint32_t kWorkgroupSize[3] = {1, 1, 1};
+  const uint32_t kWorkgroupCounts[][3] = {
+      {1, 1, 1},  {7, 1, 1},   {1, 7, 1},  {3, 4, 5},
+      {13, 9, 2}, {64, 64, 1}, {5, 33, 1}, {33, 5, 3},
+  };
+  const iree_task_dispatch_tile_order_t kTileOrders[] = {
+      IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR,
+      IREE_TASK_DISPATCH_TILE_ORDER_COLUMN_MAJOR,
+      IREE_TASK_DISPATCH_TILE_ORDER_MORTON,
+      IREE_TASK_DISPATCH_TILE_ORDER_GROUPED,
+  };
+  for (auto tile_order : kTileOrders) {
+    for (auto& workgroup_count : kWorkgroupCounts) {
+      DispatchAndVerifyGrid(kWorkgroupSize, workgroup_count,
+                            IREE_TASK_FLAG_NONE, tile_order);
+    }
+  }
+}
+
+// Tests that tiles are issued in the requested order by recording the order in
+// which they run on a single-worker executor (and thus a single shard).
+TEST_F(TaskDispatchTest, IssueTileOrderSequence) {
+  IREE_TRACE_SCOPE();
+  struct TileSequence {
+    iree_atomic_int32_t next_index = IREE_ATOMIC_VAR_INIT(0);
+    uint32_t xy[16][2];
+    static iree_status_t Tile(void* user_context,
+                              const iree_task_tile_context_t* tile_context,
+                              iree_task_submission_t* pending_submission) {
+      auto* sequence = (TileSequence*)user_context;
+      int32_t index = iree_atomic_fetch_add(&sequence->next_index, 1,
+                                            iree_memory_order_relaxed);
+      sequence->xy[index][0] = tile_context->workgroup_xyz[0];
+      sequence->xy[index][1] = tile_context->workgroup_xyz[1];
+      return iree_ok_status();
+    }
+  };
+
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(1, &topology);
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  iree_task_executor_t* executor = NULL;
+  IREE_ASSERT_OK(iree_task_executor_create(options, &topology,
+                                           iree_allocator_system(), &executor));
+  iree_task_topology_deinitialize(&topology);
+  iree_task_scope_t scope;
+  iree_task_scope_initialize(iree_make_cstring_view("scope"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &scope);
+
+  auto run = [&](iree_task_dispatch_tile_order_t tile_order,
+                 TileSequence* sequence) {
+    const uint32_t kWorkgroupSize[3] = {1, 1, 1};
+    const uint32_t kWorkgroupCount[3] = {4, 4, 1};
+    iree_task_dispatch_t task;
+    iree_task_dispatch_initialize(
+        &scope, iree_task_make_dispatch_closure(TileSequence::Tile, sequence),
+        kWorkgroupSize, kWorkgroupCount, &task);
+    task.tile_order = tile_order;
+    iree_task_fence_t* fence = NULL;
+    IREE_ASSERT_OK(iree_task_executor_acquire_fence(executor, &scope, &fence));
+    iree_task_set_completion_task(&task.header, &fence->header);
+    iree_task_submission_t submission;
+    iree_task_submission_initialize(&submission);
+    iree_task_submission_enqueue(&submission, &task.header);
+    iree_task_executor_submit(executor, &submission);
+    iree_task_executor_flush(executor);
+    IREE_ASSERT_OK(
+        iree_task_scope_wait_idle(&scope, IREE_TIME_INFINITE_FUTURE));
+    ASSERT_EQ(16, iree_atomic_load(&sequence->next_index,
+                                   iree_memory_order_relaxed));
+  };
+
+  TileSequence row_major;
+  run(IREE_TASK_DISPATCH_TILE_ORDER_ROW_MAJOR, &row_major);
+  for (uint32_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(i % 4, row_major.xy[i][0]);
+    EXPECT_EQ(i / 4, row_major.xy[i][1]);
+  }
+
+  TileSequence column_major;
+  run(IREE_TASK_DISPATCH_TILE_ORDER_COLUMN_MAJOR, &column_major);
+  for (uint32_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(i / 4, column_major.xy[i][0]);
+    EXPECT_EQ(i % 4, column_major.xy[i][1]);
+  }
+
+  // Z-order visits each 2x2 quadrant before moving to the next.
+  TileSequence morton;
+  run(IREE_TASK_DISPATCH_TILE_ORDER_MORTON, &morton);
+  static const uint32_t kMortonXY[16][2] = {
+      {0, 0}, {1, 0}, {0, 1}, {1, 1}, {2, 0}, {3, 0}, {2, 1}, {3, 1},
+      {0, 2}, {1, 2}, {0, 3}, {1, 3}, {2, 2}, {3, 2}, {2, 3}, {3, 3},
+  };
+  for (uint32_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(kMortonXY[i][0], morton.xy[i][0]);
+    EXPECT_EQ(kMortonXY[i][1], morton.xy[i][1]);
+  }
+
+  iree_task_scope_deinitialize(&scope);
+  iree_task_executor_release(executor);
+}
+
+// Tests that a long low priority dispatch yields to a high priority dispatch
+// posted while it is running and that every tile of both still runs once.
+TEST_F(TaskDispatchTest, IssuePreemption) {
+  IREE_TRACE_SCOPE();
+  struct PreemptionState {
+    iree_atomic_int32_t low_started = IREE_ATOMIC_VAR_INIT(0);
+    iree_atomic_int32_t high_posted = IREE_ATOMIC_VAR_INIT(0);
+    iree_atomic_int32_t high_tile_count = IREE_ATOMIC_VAR_INIT(0);
+    iree_atomic_int32_t high_tiles_seen_by_low = IREE_ATOMIC_VAR_INIT(0);
+    GridCoverage* low_coverage = NULL;
+    GridCoverage* high_coverage = NULL;
+    static iree_status_t LowTile(void* user_context,
+                                 const iree_task_tile_context_t* tile_context,
+                                 iree_task_submission_t* pending_submission) {
+      auto* state = (PreemptionState*)user_context;
+      if (!iree_atomic_exchange(&state->low_started, 1,
+                                iree_memory_order_seq_cst)) {
+        // Hold the first tile until the high priority dispatch is posted so
+        // that the shard observes it before reserving more tiles.
+        while (!iree_atomic_load(&state->high_posted,
+                                 iree_memory_order_seq_cst)) {
+          iree_thread_yield();
+        }
+      }
+      iree_atomic_store(&state->high_tiles_seen_by_low,
+                        iree_atomic_load(&state->high_tile_count,
+                                         iree_memory_order_seq_cst),
+                        iree_memory_order_seq_cst);
+      return GridCoverage::Tile(state->low_coverage, tile_context,
+                                pending_submission);
+    }
+    static iree_status_t HighTile(void* user_context,
+                                  const iree_task_tile_context_t* tile_context,
+                                  iree_task_submission_t* pending_submission) {
+      auto* state = (PreemptionState*)user_context;
+      iree_atomic_fetch_add(&state->high_tile_count, 1,
+                            iree_memory_order_seq_cst);
+      return GridCoverage::Tile(state->high_coverage, tile_context,
+                                pending_submission);
+    }
+  };
+
+  // A single worker ensures both dispatches are scheduled to the same worker.
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(1, &topology);
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  iree_task_executor_t* executor = NULL;
+  IREE_ASSERT_OK(iree_task_executor_create(options, &topology,
+                                           iree_allocator_system(), &executor));
+  iree_task_topology_deinitialize(&topology);
+  iree_task_scope_t low_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("low"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &low_scope);
+  iree_task_scope_set_priority(&low_scope, IREE_TASK_PRIORITY_LOW);
+  iree_task_scope_t high_scope;
+  iree_task_scope_initialize(iree_make_cstring_view("high"),
+                             IREE_TASK_SCOPE_FLAG_NONE, &high_scope);
+  iree_task_scope_set_priority(&high_scope, IREE_TASK_PRIORITY_HIGH);
+
+  const uint32_t kWorkgroupSize[3] = {1, 1, 1};
+  const uint32_t kLowWorkgroupCount[3] = {16, 16, 1};
+  const uint32_t kHighWorkgroupCount[3] = {4, 4, 1};
+  GridCoverage low_coverage(kLowWorkgroupCount);
+  GridCoverage high_coverage(kHighWorkgroupCount);
+  PreemptionState state;
+  state.low_coverage = &low_coverage;
+  state.high_coverage = &high_coverage;
+
+  auto submit = [&](iree_task_scope_t* scope, iree_task_dispatch_closure_t fn,
+                    const uint32_t workgroup_count[3],
+                    iree_task_dispatch_t* task) {
+    iree_task_dispatch_initialize(scope, fn, kWorkgroupSize, workgroup_count,
+                                  task);
+    iree_task_fence_t* fence = NULL;
+    IREE_ASSERT_OK(iree_task_executor_acquire_fence(executor, scope, &fence));
+    iree_task_set_completion_task(&task->header, &fence->header);
+    iree_task_submission_t submission;
+    iree_task_submission_initialize(&submission);
+    iree_task_submission_enqueue(&submission, &task->header);
+    iree_task_executor_submit(executor, &submission);
+    iree_task_executor_flush(executor);
+  };
+
+  iree_task_dispatch_t low_task;
+  submit(&low_scope,
+         iree_task_make_dispatch_closure(PreemptionState::LowTile, &state),
+         kLowWorkgroupCount, &low_task);
+  while (!iree_atomic_load(&state.low_started, iree_memory_order_seq_cst)) {
+    iree_thread_yield();
+  }
+  iree_task_dispatch_t high_task;
+  submit(&high_scope,
+         iree_task_make_dispatch_closure(PreemptionState::HighTile, &state),
+         kHighWorkgroupCount, &high_task);
+  iree_atomic_store(&state.high_posted, 1, iree_memory_order_seq_cst);
+
+  IREE_ASSERT_OK(
+      iree_task_scope_wait_idle(&high_scope, IREE_TIME_INFINITE_FUTURE));
+  IREE_ASSERT_OK(
+      iree_task_scope_wait_idle(&low_scope, IREE_TIME_INFINITE_FUTURE));
+  EXPECT_TRUE(low_coverage.Verify());
+  EXPECT_TRUE(high_coverage.Verify());
+
+  // The high priority dispatch completed before the low priority one did.
+  EXPECT_EQ(4 * 4, iree_atomic_load(&state.high_tiles_seen_by_low,
+                                    iree_memory_order_seq_cst));
+
+#if IREE_STATISTICS_ENABLE
+  iree_task_executor_statistics_t statistics;
+  iree_task_executor_query_statistics(executor, &statistics);
+  EXPECT_GT(statistics.yield_count, 0);
+#endif  // IREE_STATISTICS_ENABLE
+
+  iree_task_scope_deinitialize(&high_scope);
+  iree_task_scope_deinitialize(&low_scope);
+  iree_task_executor_release(executor);
+}
+
 TEST_F(TaskDispatchTest, IssueIndirect) {
   IREE_TRACE_SCOPE();
 
@@ -15,6 +15,7 @@ void iree_task_topology_group_initialize(
     uint8_t group_index, iree_task_topology_group_t* out_group) {
   memset(out_group, 0, sizeof(*out_group));
   out_group->group_index = group_index;
+  out_group->domain_index = group_index / IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT;
   snprintf(out_group->name, IREE_ARRAYSIZE(out_group->name), "iree-worker-%u",
            group_index);
   iree_thread_affinity_set_any(&out_group->ideal_thread_affinity);
@@ -63,12 +64,57 @@ const iree_task_topology_group_t* iree_task_topology_get_group(
   return &topology->groups[group_index];
 }
 
+// Returns the index of the first group of the run of groups in |domain_index|
+// that ends at |group_index| (exclusive).
+static iree_host_size_t iree_task_topology_domain_group_base(
+    const iree_task_topology_t* topology, iree_host_size_t group_index,
+    uint8_t domain_index) {
+  while (group_index > 0 &&
+         topology->groups[group_index - 1].domain_index == domain_index) {
+    --group_index;
+  }
+  return group_index;
+}
+
 iree_status_t iree_task_topology_push_group(
     iree_task_topology_t* topology, const iree_task_topology_group_t* group) {
   if (topology->group_count + 1 > IREE_ARRAYSIZE(topology->groups)) {
     return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
                             "group capacity exceeded");
   }
+
+  // Domains must be contiguous and fit within the group masks.
+  if (group->domain_index >= IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT) {
+    return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                            "domain %u exceeds the maximum of %d domains",
+                            group->domain_index,
+                            IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT);
+  }
+  if (topology->group_count == 0) {
+    if (group->domain_index != 0) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "first group must be in domain 0 (got %u)",
+                              group->domain_index);
+    }
+  } else {
+    const uint8_t last_domain_index =
+        topology->groups[topology->group_count - 1].domain_index;
+    if (group->domain_index != last_domain_index &&
+        group->domain_index != last_domain_index + 1) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "group domain %u must follow domain %u",
+                              group->domain_index, last_domain_index);
+    }
+  }
+  if (topology->group_count -
+          iree_task_topology_domain_group_base(
+              topology, topology->group_count, group->domain_index) >=
+      IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT) {
+    return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                            "domain %u group capacity exceeded",
+                            group->domain_index);
+  }
+
   iree_task_topology_group_t* dst_group =
       &topology->groups[topology->group_count];
   memcpy(dst_group, group, sizeof(*group));
@@ -76,10 +122,25 @@ iree_status_t iree_task_topology_push_group(
   return iree_ok_status();
 }
 
+iree_host_size_t iree_task_topology_domain_count(
+    const iree_task_topology_t* topology) {
+  if (!topology->group_count) return 0;
+  return topology->groups[topology->group_count - 1].domain_index + 1;
+}
+
+iree_task_topology_group_mask_t iree_task_topology_group_domain_bit(
+    const iree_task_topology_t* topology, iree_host_size_t group_index) {
+  const iree_host_size_t group_base = iree_task_topology_domain_group_base(
+      topology, group_index, topology->groups[group_index].domain_index);
+  return 1ull << ((group_index - group_base) %
+                  IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
+}
+
 // Fixes constructive_sharing_mask values such that they represent other chosen
 // topology groups instead of processor indices. We do this so that code using
 // the topology groups doesn't need to know anything about which physical
-// processor IDs a particular group is mapped to.
+// processor IDs a particular group is mapped to. Platforms that can query the
+// last level cache sharing may also reassign the group domains.
 //
 // This is implemented by platform-specific logic and may be a no-op if the
 // platform doesn't support querying the required cache information.
@@ -89,7 +150,7 @@ iree_status_t iree_task_topology_fixup_constructive_sharing_masks(
 void iree_task_topology_initialize_from_group_count(
     iree_host_size_t group_count, iree_task_topology_t* out_topology) {
   // Clamp to the maximum we support.
-  group_count = iree_min(group_count, IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
+  group_count = iree_min(group_count, IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT);
 
   IREE_TRACE_ZONE_BEGIN(z0);
   IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, group_count);
@@ -115,11 +176,11 @@ iree_status_t iree_task_topology_initialize_from_thread_affinities(
     iree_task_topology_t* out_topology) {
   // Today we have a fixed limit on the number of groups within a particular
   // topology.
-  if (group_count >= IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT) {
+  if (group_count > IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT) {
     return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
                             "too many groups specified (%" PRIhsz
-                            " provided for a max capacity of %zu)",
-                            group_count, IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
+                            " provided for a max capacity of %d)",
+                            group_count, IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT);
   }
 
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -41,14 +41,21 @@ iree_task_topology_node_id_t iree_task_topology_query_current_node(void);
 // Topology group (worker thread(s) assigned to a processor)
 //===----------------------------------------------------------------------===//
 
-// A bitmask indicating which other groups from 0 to N may constructively share
-// caches. For example, a value of 0b1100 indicates that group 2 and 3 share.
+// A bitmask indicating which other groups from 0 to N within the same domain
+// may constructively share caches. Bits are relative to the first group in the
+// domain. For example, a value of 0b1100 indicates that groups 2 and 3 of the
+// domain share.
 typedef uint64_t iree_task_topology_group_mask_t;
 
 #define IREE_TASK_TOPOLOGY_GROUP_MASK_ALL UINT64_MAX
+
+// Maximum number of groups within a single domain.
 #define IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT \
   (sizeof(iree_task_topology_group_mask_t) * 8)
 
+// Maximum number of groups within a topology.
+#define IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT IREE_TASK_EXECUTOR_MAX_WORKER_COUNT
+
 // Total cache sizes (that we care about).
 // More information may be available but we shouldn't be specializing on it
 // unless absolutely required. Values should ideally be a power-of-two if
@@ -71,6 +78,12 @@ typedef struct iree_task_topology_group_t {
   // A name assigned to executor workers used for logging/tracing.
   char name[32 - /*group_index*/ 1];
 
+  // Index of the domain the group belongs to. Domains are contiguous ranges of
+  // up to IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT groups that (usually) share a last
+  // level cache. Work is preferentially distributed and stolen within a domain
+  // before crossing into other domains.
+  uint8_t domain_index;
+
   // Logical processor index.
   uint32_t processor_index;
 
@@ -86,11 +99,14 @@ typedef struct iree_task_topology_group_t {
   // hierarchy. Workers of this group are more likely to constructively share
   // some cache levels higher up with these other groups. For example, if the
   // workers in a group all share an L2 cache then the groups indicated here may
-  // all share the same L3 cache.
+  // all share the same L3 cache. Only groups within the same domain can be
+  // represented.
   iree_task_topology_group_mask_t constructive_sharing_mask;
 } iree_task_topology_group_t;
 
-// Initializes |out_group| with a |group_index| derived name.
+// Initializes |out_group| with a |group_index| derived name and domain.
+// Groups are assigned to domains of IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT groups
+// in order.
 void iree_task_topology_group_initialize(uint8_t group_index,
                                          iree_task_topology_group_t* out_group);
 
@@ -117,7 +133,7 @@ void iree_task_topology_group_initialize(uint8_t group_index,
 // edge cases for applications to construct.
 typedef struct iree_task_topology_t {
   iree_host_size_t group_count;
-  iree_task_topology_group_t groups[IREE_TASK_EXECUTOR_MAX_WORKER_COUNT];
+  iree_task_topology_group_t groups[IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT];
 } iree_task_topology_t;
 
 // Initializes an empty task topology.
@@ -149,10 +165,21 @@ const iree_task_topology_group_t* iree_task_topology_get_group(
     const iree_task_topology_t* topology, iree_host_size_t group_index);
 
 // Pushes a new group onto the topology set.
-// The provided group data will be copied into the topology structure.
+// The provided group data will be copied into the topology structure. The group
+// must be in either the same domain as the last group in the topology or the
+// domain immediately following it.
 iree_status_t iree_task_topology_push_group(
     iree_task_topology_t* topology, const iree_task_topology_group_t* group);
 
+// Returns the total domain count defined by the topology.
+iree_host_size_t iree_task_topology_domain_count(
+    const iree_task_topology_t* topology);
+
+// Returns the bit representing the group at |group_index| in the group masks of
+// its domain (such as constructive_sharing_mask).
+iree_task_topology_group_mask_t iree_task_topology_group_domain_bit(
+    const iree_task_topology_t* topology, iree_host_size_t group_index);
+
 //===----------------------------------------------------------------------===//
 // Topology initialization helpers
 //===----------------------------------------------------------------------===//
@@ -5,7 +5,6 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include "iree/base/api.h"
-#include "iree/base/internal/math.h"
 #include "iree/task/topology.h"
 
 #if !defined(IREE_PLATFORM_APPLE) && !defined(IREE_PLATFORM_EMSCRIPTEN) && \
@@ -47,11 +46,11 @@ iree_status_t iree_task_topology_initialize_from_logical_cpu_set(
     iree_task_topology_t* out_topology) {
   // Today we have a fixed limit on the number of groups within a particular
   // topology.
-  if (cpu_count >= IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT) {
+  if (cpu_count > IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT) {
     return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
                             "too many CPUs specified (%" PRIhsz
-                            " provided for a max capacity of %zu)",
-                            cpu_count, IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
+                            " provided for a max capacity of %d)",
+                            cpu_count, IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT);
   }
 
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -206,33 +205,44 @@ static void iree_task_topology_group_initialize_from_core(
                                                      out_group);
 }
 
-// Returns a bitset with all *processors* that share the same |cache|.
-static uint64_t iree_task_topology_calculate_cache_bits(
-    const struct cpuinfo_cache* cache) {
-  if (!cache) return 0;
-  uint64_t mask = 0;
-  for (uint32_t processor_i = 0; processor_i < cache->processor_count;
-       ++processor_i) {
-    uint32_t i = cache->processor_start + processor_i;
-    if (i < IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT) {
-      mask |= 1ull << i;
-    }
-  }
-  return mask;
+// Returns true if |processor| and |other_processor| share an L1 or L2 cache.
+static bool iree_task_topology_processors_share_cache(
+    const struct cpuinfo_processor* processor,
+    const struct cpuinfo_processor* other_processor) {
+  return (processor->cache.l1i &&
+          processor->cache.l1i == other_processor->cache.l1i) ||
+         (processor->cache.l1d &&
+          processor->cache.l1d == other_processor->cache.l1d) ||
+         (processor->cache.l2 &&
+          processor->cache.l2 == other_processor->cache.l2);
 }
 
-// Constructs a constructive sharing mask for all *processors* that share the
-// same cache as the specified |processor|.
-static uint64_t iree_task_topology_calculate_constructive_sharing_mask(
-    const struct cpuinfo_processor* processor) {
-  uint64_t mask = 0;
-  mask |= iree_task_topology_calculate_cache_bits(processor->cache.l1i);
-  mask |= iree_task_topology_calculate_cache_bits(processor->cache.l1d);
-  mask |= iree_task_topology_calculate_cache_bits(processor->cache.l2);
-  // TODO(benvanik): include L3 here too (for systems that have it)? Or use L3
-  // info purely for distribution and focus the group mask on lower-latency
-  // caches?
-  return mask;
+// Assigns groups to domains of adjacent groups sharing the same L3 cache.
+// Domains are split when they exceed IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT groups.
+// If more than IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT domains would be required
+// (many small L3 caches or groups interleaved across them) the default domains
+// assigned in order are retained.
+static void iree_task_topology_assign_cache_domains(
+    iree_task_topology_t* topology) {
+  uint8_t domain_indices[IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT];
+  uint32_t domain_index = 0;
+  iree_host_size_t domain_group_count = 0;
+  const struct cpuinfo_cache* domain_cache = NULL;
+  for (iree_host_size_t i = 0; i < topology->group_count; ++i) {
+    const struct cpuinfo_cache* cache =
+        cpuinfo_get_processor(topology->groups[i].processor_index)->cache.l3;
+    if (i > 0 && (cache != domain_cache ||
+                  domain_group_count == IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT)) {
+      if (++domain_index == IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT) return;
+      domain_group_count = 0;
+    }
+    domain_cache = cache;
+    domain_indices[i] = (uint8_t)domain_index;
+    ++domain_group_count;
+  }
+  for (iree_host_size_t i = 0; i < topology->group_count; ++i) {
+    topology->groups[i].domain_index = domain_indices[i];
+  }
 }
 
 iree_status_t iree_task_topology_fixup_constructive_sharing_masks(
@@ -242,22 +252,25 @@ iree_status_t iree_task_topology_fixup_constructive_sharing_masks(
     return iree_ok_status();
   }
 
-  // O(n^2), but n is always <= 64 (and often <= 8).
+  // Partition the groups into domains based on their last level cache.
+  iree_task_topology_assign_cache_domains(topology);
+
+  // O(n^2), but n is always <= 256 (and often <= 8).
   for (iree_host_size_t i = 0; i < topology->group_count; ++i) {
     iree_task_topology_group_t* group = &topology->groups[i];
+    const struct cpuinfo_processor* processor =
+        cpuinfo_get_processor(group->processor_index);
 
-    // Compute the processors that we can constructively share with.
-    uint64_t constructive_sharing_mask =
-        iree_task_topology_calculate_constructive_sharing_mask(
-            cpuinfo_get_processor(group->processor_index));
-
+    // Find the other groups in the domain with processors that we can
+    // constructively share with.
     iree_task_topology_group_mask_t group_mask = 0;
     for (iree_host_size_t j = 0; j < topology->group_count; ++j) {
       const iree_task_topology_group_t* other_group = &topology->groups[j];
-      uint64_t group_processor_bits =
-          iree_math_rotl_u64(1ull, other_group->processor_index);
-      if (constructive_sharing_mask & group_processor_bits) {
-        group_mask |= iree_math_rotl_u64(1ull, other_group->group_index);
+      if (other_group->domain_index != group->domain_index) continue;
+      if (iree_task_topology_processors_share_cache(
+              processor,
+              cpuinfo_get_processor(other_group->processor_index))) {
+        group_mask |= iree_task_topology_group_domain_bit(topology, j);
       }
     }
 
@@ -278,11 +291,11 @@ iree_status_t iree_task_topology_initialize_from_logical_cpu_set(
 
   // Today we have a fixed limit on the number of groups within a particular
   // topology.
-  if (cpu_count >= IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT) {
+  if (cpu_count > IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT) {
     return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
                             "too many CPUs specified (%" PRIhsz
-                            " provided for a max capacity of %zu)",
-                            cpu_count, IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
+                            " provided for a max capacity of %d)",
+                            cpu_count, IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT);
   }
 
   // Validate the CPU IDs provided.
@@ -379,7 +392,7 @@ iree_task_topology_initialize_from_physical_cores_with_filter(
     return iree_ok_status();
   }
 
-  max_core_count = iree_min(max_core_count, IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
+  max_core_count = iree_min(max_core_count, IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT);
   IREE_TRACE_ZONE_BEGIN(z0);
   IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, max_core_count);
 
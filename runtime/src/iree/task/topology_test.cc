@@ -117,6 +117,64 @@ TEST(TopologyTest, FromGroupCount) {
   iree_task_topology_deinitialize(&topology);
 }
 
+TEST(TopologyTest, FromGroupCountDomains) {
+  iree_task_topology_t topology;
+  iree_task_topology_initialize_from_group_count(
+      IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT, &topology);
+  EXPECT_EQ(iree_task_topology_group_count(&topology),
+            IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT);
+  EXPECT_EQ(iree_task_topology_domain_count(&topology),
+            IREE_TASK_TOPOLOGY_MAX_GROUP_COUNT /
+                IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT);
+  for (iree_host_size_t i = 0; i < iree_task_topology_group_count(&topology);
+       ++i) {
+    const iree_task_topology_group_t* group =
+        iree_task_topology_get_group(&topology, i);
+    EXPECT_EQ(i / IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT, group->domain_index);
+    EXPECT_EQ(1ull << (i % IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT),
+              iree_task_topology_group_domain_bit(&topology, i));
+  }
+  iree_task_topology_deinitialize(&topology);
+}
+
+TEST(TopologyTest, PushGroupDomains) {
+  iree_task_topology_t topology;
+  iree_task_topology_initialize(&topology);
+
+  // Domains must start at 0 and can only advance one at a time.
+  iree_task_topology_group_t group;
+  iree_task_topology_group_initialize(0, &group);
+  group.domain_index = 1;
+  iree_status_t status = iree_task_topology_push_group(&topology, &group);
+  EXPECT_TRUE(iree_status_is_invalid_argument(status));
+  iree_status_ignore(status);
+  group.domain_index = 0;
+  IREE_EXPECT_OK(iree_task_topology_push_group(&topology, &group));
+  group.domain_index = 1;
+  IREE_EXPECT_OK(iree_task_topology_push_group(&topology, &group));
+  IREE_EXPECT_OK(iree_task_topology_push_group(&topology, &group));
+  group.domain_index = 0;
+  status = iree_task_topology_push_group(&topology, &group);
+  EXPECT_TRUE(iree_status_is_invalid_argument(status));
+  iree_status_ignore(status);
+  EXPECT_EQ(2, iree_task_topology_domain_count(&topology));
+  EXPECT_EQ(1ull << 1, iree_task_topology_group_domain_bit(&topology, 2));
+
+  // Fill up domain 1 - it should fail once the group mask is full.
+  group.domain_index = 1;
+  while (iree_task_topology_group_count(&topology) <
+         1 + IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT) {
+    IREE_EXPECT_OK(iree_task_topology_push_group(&topology, &group));
+  }
+  status = iree_task_topology_push_group(&topology, &group);
+  EXPECT_TRUE(iree_status_is_resource_exhausted(status));
+  iree_status_ignore(status);
+  group.domain_index = 2;
+  IREE_EXPECT_OK(iree_task_topology_push_group(&topology, &group));
+
+  iree_task_topology_deinitialize(&topology);
+}
+
 // Verifies only that the |topology| is usable.
 // If we actually checked the contents here then we'd just be validating that
 // cpuinfo was working and the tests would become machine-dependent.
@@ -131,6 +189,12 @@ static void EnsureTopologyValid(iree_host_size_t max_group_count,
     const iree_task_topology_group_t* group =
         iree_task_topology_get_group(topology, i);
     EXPECT_EQ(i, group->group_index);
+    if (i > 0) {
+      const iree_task_topology_group_t* last_group =
+          iree_task_topology_get_group(topology, i - 1);
+      EXPECT_GE(group->domain_index, last_group->domain_index);
+      EXPECT_LE(group->domain_index, last_group->domain_index + 1);
+    }
   }
 }
 
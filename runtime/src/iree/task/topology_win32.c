@@ -109,9 +109,11 @@ static void iree_task_topology_assign_constructive_sharing(
       for (iree_host_size_t group_j = 0; group_j < topology->group_count;
            ++group_j) {
         iree_task_topology_group_t* other = &topology->groups[group_j];
-        if (other->ideal_thread_affinity.group == group_mask.Group &&
+        if (other->domain_index == group->domain_index &&
+            other->ideal_thread_affinity.group == group_mask.Group &&
             (group_mask.Mask & (1ull << other->ideal_thread_affinity.id))) {
-          group->constructive_sharing_mask |= 1ull << group_j;
+          group->constructive_sharing_mask |=
+              iree_task_topology_group_domain_bit(topology, group_j);
         }
       }
     }
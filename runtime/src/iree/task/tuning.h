@@ -12,10 +12,15 @@ extern "C" {
 #endif  // __cplusplus
 
 // Maximum number of workers that an executor can manage.
-// A 64 worker hard limit is based on us using uint64_t as a bitmask to select
-// workers. It's easy to go smaller (just use fewer bits) if it's known that
-// only <64 will ever be used (such as for devices with 2 cores).
-#define IREE_TASK_EXECUTOR_MAX_WORKER_COUNT (64)
+// Workers are partitioned into domains (usually those sharing a last level
+// cache) and each domain uses a uint64_t bitmask to select its workers. The
+// total is limited by the uint8_t group indices in the topology.
+#define IREE_TASK_EXECUTOR_MAX_WORKER_COUNT (256)
+
+// Maximum number of worker domains that an executor can manage.
+// A 32 domain hard limit is based on us using uint32_t as a bitmask to select
+// domains. Each domain can have up to 64 workers.
+#define IREE_TASK_EXECUTOR_MAX_DOMAIN_COUNT (32)
 
 // Initial number of shard tasks that are allocated in the executor pool.
 // Increasing this number will decrease initial allocation storms in cases of
@@ -77,8 +82,7 @@ extern "C" {
 // In real-time systems too few tasks is better (slightly more work for much
 // lower variance in execution) while in batch mode systems too many tasks is
 // better (as latencies don't matter so long as throughput is maximized).
-#define IREE_TASK_EXECUTOR_MAX_THEFT_TASK_COUNT \
-  IREE_TASK_EXECUTOR_MAX_WORKER_COUNT
+#define IREE_TASK_EXECUTOR_MAX_THEFT_TASK_COUNT (64)
 
 // Number of tiles that will be batched into a single reservation from the grid.
 // This is a maximum; if there are fewer tiles that would otherwise allow for
@@ -94,6 +98,27 @@ extern "C" {
 // memory).
 #define IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION (8)
 
+// Target number of reservations each shard makes from the grid when it is
+// smaller than IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION allows.
+// Reservations are sized so that each shard claims ranges of tiles instead of
+// contending on the shared tile index for every tile while still leaving
+// enough reservations for shards that finish early to balance the load.
+#define IREE_TASK_DISPATCH_RESERVATIONS_PER_SHARD (4)
+
+// Maximum number of times a dispatch shard will yield to higher priority tasks
+// posted to its worker before running to completion.
+//
+// Shards check for higher priority work between tile reservations and yield
+// back to the worker so that latency-sensitive tasks don't wait for the entire
+// dispatch to complete. Bounding the yields ensures that a continuous stream of
+// higher priority work cannot starve lower priority dispatches.
+#define IREE_TASK_DISPATCH_SHARD_MAX_YIELD_COUNT (16)
+
+// Number of y rows in each band of IREE_TASK_DISPATCH_TILE_ORDER_GROUPED.
+// Tiles along x within a band reuse the same rows and a band should fit
+// comfortably within the caches shared by the workers processing it.
+#define IREE_TASK_DISPATCH_TILE_ORDER_GROUP_SIZE (4)
+
 // Whether to enable per-tile colors for each tile tracing zone based on the
 // tile grid xyz. Not cheap and can be disabled to reduce tracing overhead.
 // TODO(#4017): make per-tile color tracing fast enough to always have on.
@@ -30,7 +30,9 @@ iree_status_t iree_task_worker_initialize(
 
   out_worker->executor = executor;
   out_worker->worker_index = executor->worker_base_index + worker_index;
-  out_worker->worker_bit = iree_task_affinity_for_worker(worker_index);
+  out_worker->domain_index = executor->worker_domain_indices[worker_index];
+  out_worker->worker_bit = iree_task_affinity_for_worker(
+      worker_index - executor->domains[out_worker->domain_index].worker_base);
   out_worker->ideal_thread_affinity = topology_group->ideal_thread_affinity;
   out_worker->constructive_sharing_mask =
       topology_group->constructive_sharing_mask;
@@ -41,10 +43,13 @@ iree_status_t iree_task_worker_initialize(
   out_worker->local_memory = local_memory;
   out_worker->processor_id = 0;
   out_worker->processor_tag = 0;
+  memset(&out_worker->statistics, 0, sizeof(out_worker->statistics));
 
   iree_notification_initialize(&out_worker->wake_notification);
   iree_notification_initialize(&out_worker->state_notification);
   iree_atomic_task_slist_initialize(&out_worker->mailbox_slist);
+  iree_atomic_store(&out_worker->mailbox_priority_mask, 0,
+                    iree_memory_order_relaxed);
   iree_task_queue_initialize(&out_worker->local_task_queue);
 
   iree_task_worker_state_t initial_state = IREE_TASK_WORKER_STATE_RUNNING;
@@ -140,21 +145,37 @@ void iree_task_worker_deinitialize(iree_task_worker_t* worker) {
   IREE_TRACE_ZONE_END(z0);
 }
 
+#if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+// Returns the percentage of workers in |executor| that are active given the
+// |idle_mask| of the domain at |domain_index|. The masks of other domains are
+// just hints and may be slightly out of date.
+static float iree_task_worker_calculate_active_percentage(
+    iree_task_executor_t* executor, iree_host_size_t domain_index,
+    iree_task_affinity_set_t idle_mask) {
+  int idle_count = iree_task_affinity_set_count_ones(idle_mask);
+  for (iree_host_size_t i = 0; i < executor->domain_count; ++i) {
+    if (i == domain_index) continue;
+    idle_count += iree_task_affinity_set_count_ones(
+        iree_atomic_task_affinity_set_load(
+            &executor->domains[i].worker_idle_mask, iree_memory_order_relaxed));
+  }
+  return 100.0f - 100.0f * idle_count / (float)executor->worker_count;
+}
+#endif  // IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+
 // Marks the worker as "active" (scheduling work or executing it).
 // The idle mask is accessed with 'relaxed' order because it's just a hint.
 static void iree_task_worker_mark_active(iree_task_worker_t* worker) {
   iree_task_affinity_set_t old_idle_mask =
       iree_atomic_task_affinity_set_fetch_and(
-          &worker->executor->worker_idle_mask, ~worker->worker_bit,
-          iree_memory_order_relaxed);
+          &worker->executor->domains[worker->domain_index].worker_idle_mask,
+          ~worker->worker_bit, iree_memory_order_relaxed);
   (void)old_idle_mask;
   IREE_TRACE_PLOT_VALUE_F32(
       worker->executor->trace_name,
-      old_idle_mask
-          ? (100.0f -
-             100.0f * (iree_task_affinity_set_count_ones(old_idle_mask) - 1) /
-                 (float)worker->executor->worker_count)
-          : 100.0f);
+      iree_task_worker_calculate_active_percentage(
+          worker->executor, worker->domain_index,
+          old_idle_mask & ~worker->worker_bit));
 }
 
 // Marks the worker as "idle" (sleeping/spinning waiting to wake).
@@ -162,21 +183,44 @@ static void iree_task_worker_mark_active(iree_task_worker_t* worker) {
 static void iree_task_worker_mark_idle(iree_task_worker_t* worker) {
   iree_task_affinity_set_t old_idle_mask =
       iree_atomic_task_affinity_set_fetch_or(
-          &worker->executor->worker_idle_mask, worker->worker_bit,
-          iree_memory_order_relaxed);
+          &worker->executor->domains[worker->domain_index].worker_idle_mask,
+          worker->worker_bit, iree_memory_order_relaxed);
   (void)old_idle_mask;
   IREE_TRACE_PLOT_VALUE_F32(
       worker->executor->trace_name,
-      100.0f - 100.0f * (iree_task_affinity_set_count_ones(old_idle_mask) + 1) /
-                   (float)worker->executor->worker_count);
+      iree_task_worker_calculate_active_percentage(
+          worker->executor, worker->domain_index,
+          old_idle_mask | worker->worker_bit));
 }
 
 void iree_task_worker_post_tasks(iree_task_worker_t* worker,
                                  iree_task_list_t* list) {
+  // Gather the priorities of the posted tasks; the tasks can't be touched once
+  // they are in the mailbox as the worker may immediately begin running them.
+  iree_task_priority_mask_t priority_mask = 0;
+  for (iree_task_t* task = list->head; task; task = task->next_task) {
+    priority_mask |= 1u << iree_task_priority(task);
+  }
+
   // Move the list into the mailbox. Note that the mailbox is LIFO and this list
   // is concatenated with its current order preserved (which should be LIFO).
   iree_atomic_task_slist_concat(&worker->mailbox_slist, list->head, list->tail);
   memset(list, 0, sizeof(*list));
+
+  // Publish the priorities after the tasks are in the mailbox so that the
+  // worker never clears the mask without also flushing the tasks.
+  iree_atomic_fetch_or(&worker->mailbox_priority_mask, (int32_t)priority_mask,
+                       iree_memory_order_release);
+}
+
+// Flushes the mailbox into the local queue with all tasks of a priority above
+// |priority| placed at the front of the queue.
+static void iree_task_worker_flush_mailbox_by_priority(
+    iree_task_worker_t* worker, iree_task_priority_t priority) {
+  iree_atomic_exchange(&worker->mailbox_priority_mask, 0,
+                       iree_memory_order_acquire);
+  iree_task_queue_flush_from_lifo_slist_by_priority(
+      &worker->local_task_queue, &worker->mailbox_slist, priority);
 }
 
 iree_task_t* iree_task_worker_try_steal_task(iree_task_worker_t* worker,
@@ -215,20 +259,45 @@ static void iree_task_worker_execute(
       break;
     }
     case IREE_TASK_TYPE_DISPATCH_SHARD: {
-      iree_task_dispatch_shard_execute(
-          (iree_task_dispatch_shard_t*)task, worker->processor_id,
-          worker->worker_index, worker->local_memory, pending_submission);
+      const iree_task_priority_t priority = iree_task_priority(task);
+      if (iree_task_dispatch_shard_execute(
+              (iree_task_dispatch_shard_t*)task, worker->processor_id,
+              worker->worker_index, worker->local_memory,
+              &worker->statistics.dispatch, &worker->mailbox_priority_mask,
+              pending_submission)) {
+        // The shard yielded to higher priority tasks in the mailbox. Requeue
+        // it such that it resumes right after those tasks have been processed.
+        iree_task_queue_push_front(&worker->local_task_queue, task);
+        iree_task_worker_flush_mailbox_by_priority(worker, priority);
+        IREE_STATISTICS(iree_task_statistics_counter_add(
+            &worker->statistics.yield_count, 1));
+      }
       break;
     }
     default:
       IREE_ASSERT_UNREACHABLE("incorrect task type for worker execution");
       break;
   }
+  IREE_STATISTICS(
+      iree_task_statistics_counter_add(&worker->statistics.task_count, 1));
 
   // NOTE: task is invalidated above and must not be used!
   task = NULL;
 }
 
+// Returns true if any task made ready in |submission| since |previous_head| was
+// at the front of its ready list is of a higher than normal priority. Ready
+// tasks are pushed to the front of the list so only new tasks are checked.
+static bool iree_task_worker_readied_urgent_tasks(
+    const iree_task_submission_t* submission,
+    const iree_task_t* previous_head) {
+  for (iree_task_t* task = submission->ready_list.head;
+       task && task != previous_head; task = task->next_task) {
+    if (iree_task_priority(task) > IREE_TASK_PRIORITY_NORMAL) return true;
+  }
+  return false;
+}
+
 // Pumps the worker thread once, processing a single task.
 // Returns true if pumping should continue as there are more tasks remaining or
 // false if the caller should wait for more tasks to be posted.
@@ -236,6 +305,16 @@ static bool iree_task_worker_pump_once(
     iree_task_worker_t* worker, iree_task_submission_t* pending_submission) {
   IREE_TRACE_ZONE_BEGIN(z0);
 
+  // Pull in any tasks of higher than normal priority posted to the mailbox
+  // ahead of the work already in the local queue.
+  if (IREE_UNLIKELY(
+          iree_atomic_load(&worker->mailbox_priority_mask,
+                           iree_memory_order_relaxed) &
+          iree_task_priority_mask_above(IREE_TASK_PRIORITY_NORMAL))) {
+    iree_task_worker_flush_mailbox_by_priority(worker,
+                                               IREE_TASK_PRIORITY_NORMAL);
+  }
+
   // Check the local work queue for any work we know we should start
   // processing immediately. Other workers may try to steal some of this work
   // if we take too long.
@@ -251,6 +330,8 @@ static bool iree_task_worker_pump_once(
     // first place (large uneven workloads for various workers, bad distribution
     // in the face of heterogenous multi-core architectures where some workers
     // complete tasks faster than others, etc).
+    iree_atomic_exchange(&worker->mailbox_priority_mask, 0,
+                         iree_memory_order_acquire);
     task = iree_task_queue_flush_from_lifo_slist(&worker->local_task_queue,
                                                  &worker->mailbox_slist);
   }
@@ -262,9 +343,14 @@ static bool iree_task_worker_pump_once(
   // the first task in the queue is popped off and returned.
   if (!task) {
     task = iree_task_executor_try_steal_task(
-        worker->executor, worker->constructive_sharing_mask,
+        worker->executor, worker->domain_index,
+        worker->constructive_sharing_mask,
         worker->max_theft_attempts, &worker->theft_prng,
         &worker->local_task_queue);
+    IREE_STATISTICS(iree_task_statistics_counter_add(
+        task ? &worker->statistics.steal_count
+             : &worker->statistics.failed_steal_count,
+        1));
   }
 #endif  // IREE_TASK_EXECUTOR_MAX_THEFT_ATTEMPTS_DIVISOR > 0
 
@@ -276,8 +362,18 @@ static bool iree_task_worker_pump_once(
 
   // Execute the task (may call out to arbitrary user code and may submit more
   // tasks for execution).
+  const iree_task_t* previous_ready_head = pending_submission->ready_list.head;
   iree_task_worker_execute(worker, task, pending_submission);
 
+  // Tasks of higher than normal priority readied by the task (such as the
+  // retirement of a dispatch after its last shard) are scheduled immediately
+  // instead of waiting until the worker has drained its local queue.
+  if (iree_task_worker_readied_urgent_tasks(pending_submission,
+                                            previous_ready_head)) {
+    iree_task_executor_merge_submission(worker->executor, pending_submission);
+    iree_task_executor_coordinate(worker->executor, worker);
+  }
+
   IREE_TRACE_ZONE_END(z0);
   return true;  // try again
 }
@@ -362,10 +458,16 @@ static void iree_task_worker_pump_until_exit(iree_task_worker_t* worker) {
       // just using it as a pulse.
       IREE_TRACE_ZONE_BEGIN_NAMED(z_wait,
                                   "iree_task_worker_main_pump_wake_wait");
+      IREE_STATISTICS(iree_time_t sleep_start_ns = iree_time_now());
       iree_notification_commit_wait(
           &worker->wake_notification, wait_token,
           /*spin_ns=*/worker->executor->worker_spin_ns,
           /*deadline_ns=*/IREE_TIME_INFINITE_FUTURE);
+      IREE_STATISTICS({
+        iree_task_statistics_counter_add(&worker->statistics.sleep_count, 1);
+        iree_task_statistics_counter_add(&worker->statistics.sleep_ns,
+                                        iree_time_now() - sleep_start_ns);
+      });
       IREE_TRACE_ZONE_END(z_wait);
 
       // Woke from a wait - query the processor ID in case we migrated during
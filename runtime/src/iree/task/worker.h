@@ -47,6 +47,28 @@ typedef enum iree_task_worker_state_e {
   IREE_TASK_WORKER_STATE_ZOMBIE = 2,
 } iree_task_worker_state_t;
 
+// Statistics counters of a single worker.
+// Counters are only ever updated by the worker thread and may be read at any
+// time from other threads; readers may observe tearing across fields.
+typedef struct iree_task_worker_statistics_t {
+#if IREE_STATISTICS_ENABLE
+  // Total number of tasks executed by the worker.
+  iree_atomic_int64_t task_count;
+  // Number of times the worker stole tasks from another worker.
+  iree_atomic_int64_t steal_count;
+  // Number of times the worker tried to steal tasks but found none.
+  iree_atomic_int64_t failed_steal_count;
+  // Number of times a dispatch shard yielded to higher priority tasks.
+  iree_atomic_int64_t yield_count;
+  // Number of times the worker ran out of work and went to sleep.
+  iree_atomic_int64_t sleep_count;
+  // Total time the worker spent sleeping in nanoseconds.
+  iree_atomic_int64_t sleep_ns;
+#endif  // IREE_STATISTICS_ENABLE
+  // Aggregate statistics of all dispatch shards executed by the worker.
+  iree_task_dispatch_statistics_t dispatch;
+} iree_task_worker_statistics_t;
+
 // A worker within the executor pool.
 //
 // NOTE: fields in here are touched from multiple threads with lock-free
@@ -63,6 +85,13 @@ typedef struct iree_task_worker_t {
   // LAYOUT: must be 64b away from local_task_queue.
   iree_atomic_task_slist_t mailbox_slist;
 
+  // A bitmask of the priorities of tasks posted to mailbox_slist since it was
+  // last flushed (iree_task_priority_mask_t). Workers check this between tasks
+  // and dispatch shards check it between tile reservations in order to pull in
+  // higher priority tasks ahead of the lower priority work they have queued.
+  // LAYOUT: next to mailbox_slist as posters touch both.
+  iree_atomic_int32_t mailbox_priority_mask;
+
   // Current state of the worker (iree_task_worker_state_t).
   // LAYOUT: frequent access; next to wake_notification as they are always
   //         accessed together.
@@ -84,8 +113,11 @@ typedef struct iree_task_worker_t {
   // Globally unique worker index (worker_base_index + local worker_index).
   iree_host_size_t worker_index;
 
+  // Index of the domain within the executor owning the worker.
+  iree_host_size_t domain_index;
+
   // Bit the worker represents in the various worker bitsets.
-  // Local to the executor owning the worker.
+  // Local to the domain within the executor owning the worker.
   iree_task_affinity_set_t worker_bit;
 
   // Ideal thread affinity for the worker thread.
@@ -142,6 +174,11 @@ typedef struct iree_task_worker_t {
   // of work of their own.
   // LAYOUT: must be 64b away from mailbox_slist.
   iree_task_queue_t local_task_queue;
+
+  // Statistics counters updated by the worker as it processes tasks.
+  // LAYOUT: after local_task_queue as both are primarily touched by the
+  //         worker thread.
+  iree_task_worker_statistics_t statistics;
 } iree_task_worker_t;
 static_assert(offsetof(iree_task_worker_t, mailbox_slist) +
                       sizeof(iree_atomic_task_slist_t) <
@@ -6,6 +6,11 @@
 
 #include "iree/tooling/function_io.h"
 
+#include <stdio.h>
+
+#include "iree/io/file_handle.h"
+#include "iree/io/formats/irpa/irpa_builder.h"
+#include "iree/io/parameter_index.h"
 #include "iree/io/stdio_stream.h"
 #include "iree/io/stream.h"
 #include "iree/modules/hal/module.h"
@@ -1195,3 +1200,387 @@ iree_status_t iree_tooling_write_variants(iree_vm_list_t* list,
   IREE_TRACE_ZONE_END(z0);
   return iree_ok_status();
 }
+
+//===----------------------------------------------------------------------===//
+// Streaming
+//===----------------------------------------------------------------------===//
+
+// A file that one or more outputs are streamed into.
+typedef struct iree_tooling_stream_target_t {
+  // Path of the file without the mode prefix. References the spec storage.
+  iree_string_view_t path;
+  // True if the file is an IRPA archive with each output stored as an entry.
+  bool is_archive;
+  // File the output contents are written to. Archives are only created once
+  // all entries are known and the total size of the file can be computed.
+  iree_io_file_handle_t* file_handle;
+  // Stream used to write headers prior to streaming contents.
+  iree_io_stream_t* stream;
+  // Layout of all entries when the target is an archive.
+  iree_io_parameter_archive_builder_t builder;
+  // HAL file imported from |file_handle| that contents are written to.
+  iree_hal_file_t* file;
+} iree_tooling_stream_target_t;
+
+// An output streamed into one of the targets.
+typedef struct iree_tooling_stream_output_t {
+  // Buffer view with the output contents, retained.
+  iree_hal_buffer_view_t* buffer_view;
+  // Ordinal of the target the output is written to.
+  iree_host_size_t target_ordinal;
+  // Ordinal of the archive entry when the target is an archive.
+  iree_host_size_t entry_ordinal;
+  // True if the contents are in host memory (primitive values and VM buffers)
+  // and are written through the target stream instead of by the device.
+  bool is_host;
+  // Absolute offset in the target file the contents are written to.
+  uint64_t file_offset;
+} iree_tooling_stream_output_t;
+
+// Finds the target referenced by |spec| or opens a new one if this is the
+// first output written to the file. New targets are appended to |targets|.
+static iree_status_t iree_tooling_stream_open_target(
+    iree_string_view_t spec, iree_host_size_t* target_count,
+    iree_tooling_stream_target_t* targets, iree_allocator_t host_allocator,
+    iree_host_size_t* out_target_ordinal) {
+  bool append = false;
+  if (iree_string_view_consume_prefix(&spec, IREE_SV("@"))) {
+    append = false;
+  } else if (iree_string_view_consume_prefix(&spec, IREE_SV("+"))) {
+    append = true;
+  } else {
+    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                            "unsupported output mode specification '%.*s'; "
+                            "only files can be streamed",
+                            (int)spec.size, spec.data);
+  }
+  bool is_archive = false;
+  if (iree_string_view_ends_with(spec, IREE_SV(".irpa"))) {
+    is_archive = true;
+  } else if (!iree_string_view_ends_with(spec, IREE_SV(".npy"))) {
+    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                            "output file '%.*s' cannot be streamed; only .npy "
+                            "and .irpa files are supported",
+                            (int)spec.size, spec.data);
+  }
+
+  // Outputs appended to a file started by a prior output share its target.
+  for (iree_host_size_t i = 0; i < *target_count; ++i) {
+    if (!iree_string_view_equal(targets[i].path, spec)) continue;
+    if (!append) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "output file '%.*s' is written by multiple "
+                              "outputs; use `+` to append to it",
+                              (int)spec.size, spec.data);
+    }
+    *out_target_ordinal = i;
+    return iree_ok_status();
+  }
+  if (append && is_archive) {
+    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                            "appending to existing archive '%.*s' is not "
+                            "supported; start the archive with `@`",
+                            (int)spec.size, spec.data);
+  }
+
+  // The target is counted immediately so that it is cleaned up on failure.
+  iree_tooling_stream_target_t* target = &targets[*target_count];
+  *out_target_ordinal = (*target_count)++;
+  target->path = spec;
+  target->is_archive = is_archive;
+  if (is_archive) {
+    return iree_io_parameter_archive_builder_initialize(host_allocator,
+                                                        &target->builder);
+  }
+
+  // .npy files are concatenated and each output appends its header followed
+  // by its contents to the end of the file.
+  const iree_io_file_mode_t file_mode =
+      IREE_IO_FILE_MODE_READ | IREE_IO_FILE_MODE_WRITE;
+  if (append) {
+    IREE_RETURN_IF_ERROR(iree_io_file_handle_open(
+        file_mode, spec, host_allocator, &target->file_handle));
+  } else {
+    IREE_RETURN_IF_ERROR(
+        iree_io_file_handle_create(file_mode, spec, /*initial_size=*/0,
+                                   host_allocator, &target->file_handle));
+  }
+  IREE_RETURN_IF_ERROR(iree_io_stream_open(
+      IREE_IO_STREAM_MODE_WRITABLE | IREE_IO_STREAM_MODE_SEEKABLE,
+      target->file_handle, /*file_offset=*/0, host_allocator,
+      &target->stream));
+  return iree_io_stream_seek(target->stream, IREE_IO_STREAM_SEEK_FROM_END, 0);
+}
+
+// Writes the host contents of |output| to |stream| at its current offset.
+static iree_status_t iree_tooling_stream_write_host_output(
+    iree_tooling_stream_output_t* output, iree_io_stream_t* stream) {
+  iree_hal_buffer_mapping_t mapping;
+  IREE_RETURN_IF_ERROR(iree_hal_buffer_map_range(
+      iree_hal_buffer_view_buffer(output->buffer_view),
+      IREE_HAL_MAPPING_MODE_SCOPED, IREE_HAL_MEMORY_ACCESS_READ, 0,
+      iree_hal_buffer_view_byte_length(output->buffer_view), &mapping));
+  iree_status_t status = iree_io_stream_write(
+      stream, mapping.contents.data_length, mapping.contents.data);
+  iree_status_ignore(iree_hal_buffer_unmap_range(&mapping));
+  return status;
+}
+
+// Reserves space for |output| in |target|. .npy headers are written
+// immediately and the stream is advanced past the contents that will be
+// written later. Archive entries are only laid out as the header can only be
+// written once all entries are known.
+static iree_status_t iree_tooling_stream_layout_output(
+    iree_tooling_stream_target_t* target, iree_host_size_t list_ordinal,
+    iree_tooling_stream_output_t* output, iree_allocator_t host_allocator) {
+  iree_device_size_t byte_length =
+      iree_hal_buffer_view_byte_length(output->buffer_view);
+  if (target->is_archive) {
+    char name[32];
+    snprintf(name, sizeof(name), "output_%" PRIhsz, list_ordinal);
+    output->entry_ordinal =
+        iree_io_parameter_index_count(target->builder.index);
+    return iree_io_parameter_archive_builder_add_data_entry(
+        &target->builder, iree_make_cstring_view(name),
+        iree_const_byte_span_empty(),
+        IREE_IO_PARAMETER_ARCHIVE_DEFAULT_DATA_ALIGNMENT, byte_length);
+  }
+  IREE_RETURN_IF_ERROR(iree_numpy_npy_save_header(
+      target->stream, IREE_NUMPY_NPY_SAVE_OPTION_DEFAULT, output->buffer_view,
+      host_allocator));
+  output->file_offset = iree_io_stream_offset(target->stream);
+  if (output->is_host) {
+    return iree_tooling_stream_write_host_output(output, target->stream);
+  }
+  return iree_io_stream_seek(target->stream, IREE_IO_STREAM_SEEK_FROM_CURRENT,
+                             byte_length);
+}
+
+// Creates the archive file for |target| and writes its header. The offsets of
+// all of the entries are assigned to the outputs referencing the target and
+// the contents of host outputs are written immediately.
+static iree_status_t iree_tooling_stream_write_archive_header(
+    iree_tooling_stream_target_t* target, iree_host_size_t target_ordinal,
+    iree_host_size_t output_count, iree_tooling_stream_output_t* outputs,
+    iree_allocator_t host_allocator) {
+  IREE_RETURN_IF_ERROR(iree_io_file_handle_create(
+      IREE_IO_FILE_MODE_READ | IREE_IO_FILE_MODE_WRITE, target->path,
+      iree_io_parameter_archive_builder_total_size(&target->builder),
+      host_allocator, &target->file_handle));
+  IREE_RETURN_IF_ERROR(iree_io_stream_open(
+      IREE_IO_STREAM_MODE_WRITABLE | IREE_IO_STREAM_MODE_SEEKABLE,
+      target->file_handle, /*file_offset=*/0, host_allocator,
+      &target->stream));
+
+  iree_io_parameter_index_t* index = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_parameter_index_create(host_allocator, &index));
+  iree_status_t status = iree_io_parameter_archive_builder_write(
+      &target->builder, target->file_handle, /*file_offset=*/0, target->stream,
+      index);
+  for (iree_host_size_t i = 0; i < output_count && iree_status_is_ok(status);
+       ++i) {
+    if (outputs[i].target_ordinal != target_ordinal) continue;
+    const iree_io_parameter_index_entry_t* entry = NULL;
+    status = iree_io_parameter_index_get(index, outputs[i].entry_ordinal,
+                                         &entry);
+    if (iree_status_is_ok(status)) {
+      outputs[i].file_offset = entry->storage.file.offset;
+    }
+    if (iree_status_is_ok(status) && outputs[i].is_host) {
+      status = iree_io_stream_seek(target->stream, IREE_IO_STREAM_SEEK_SET,
+                                   outputs[i].file_offset);
+      if (iree_status_is_ok(status)) {
+        status =
+            iree_tooling_stream_write_host_output(&outputs[i], target->stream);
+      }
+    }
+  }
+  iree_io_parameter_index_release(index);
+  return status;
+}
+
+// Finishes writing all headers to |target| and imports its file for use with
+// |device|.
+static iree_status_t iree_tooling_stream_finalize_target(
+    iree_tooling_stream_target_t* target, iree_host_size_t target_ordinal,
+    iree_host_size_t output_count, iree_tooling_stream_output_t* outputs,
+    iree_hal_device_t* device, iree_allocator_t host_allocator) {
+  if (target->is_archive) {
+    IREE_RETURN_IF_ERROR(iree_tooling_stream_write_archive_header(
+        target, target_ordinal, output_count, outputs, host_allocator));
+  }
+
+  // Headers are written through a buffered stream that must be flushed before
+  // the device writes the contents to the file.
+  iree_io_stream_release(target->stream);
+  target->stream = NULL;
+
+  return iree_hal_file_import(device, IREE_HAL_QUEUE_AFFINITY_ANY,
+                              IREE_HAL_MEMORY_ACCESS_WRITE,
+                              target->file_handle,
+                              IREE_HAL_EXTERNAL_FILE_FLAG_NONE, &target->file);
+}
+
+// Enqueues a write of the contents of |output| to |file| that waits on
+// |wait_fence|. The semaphore signaled when the write completes is added to
+// |completion_fence|.
+static iree_status_t iree_tooling_stream_write_output(
+    iree_tooling_stream_output_t* output, iree_hal_file_t* file,
+    iree_hal_device_t* device, iree_hal_fence_t* wait_fence,
+    iree_hal_fence_t* completion_fence) {
+  // Each write signals its own semaphore so that writes are independent and
+  // may complete in any order.
+  iree_hal_semaphore_t* semaphore = NULL;
+  IREE_RETURN_IF_ERROR(iree_hal_semaphore_create(
+      device, 0ull, IREE_HAL_SEMAPHORE_FLAG_NONE, &semaphore));
+  iree_status_t status =
+      iree_hal_fence_insert(completion_fence, semaphore, 1ull);
+
+  if (iree_status_is_ok(status)) {
+    uint64_t signal_value = 1ull;
+    iree_hal_semaphore_list_t signal_semaphore_list = {
+        .count = 1,
+        .semaphores = &semaphore,
+        .payload_values = &signal_value,
+    };
+    status = iree_hal_device_queue_write(
+        device, IREE_HAL_QUEUE_AFFINITY_ANY,
+        iree_hal_fence_semaphore_list(wait_fence), signal_semaphore_list,
+        iree_hal_buffer_view_buffer(output->buffer_view), /*source_offset=*/0,
+        file, output->file_offset,
+        iree_hal_buffer_view_byte_length(output->buffer_view),
+        IREE_HAL_WRITE_FLAG_NONE);
+  }
+
+  iree_hal_semaphore_release(semaphore);
+  return status;
+}
+
+iree_status_t iree_tooling_stream_variants(iree_vm_list_t* list,
+                                           iree_string_view_list_t specs,
+                                           iree_hal_device_t* device,
+                                           iree_hal_fence_t* wait_fence,
+                                           iree_hal_fence_t* signal_fence,
+                                           iree_allocator_t host_allocator) {
+  IREE_ASSERT_ARGUMENT(list);
+  IREE_ASSERT_ARGUMENT(device);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  if (iree_vm_list_size(list) != specs.count) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(
+        IREE_STATUS_OUT_OF_RANGE,
+        "%" PRIhsz
+        " outputs specified but the provided variant list only has %" PRIhsz
+        " elements",
+        specs.count, iree_vm_list_size(list));
+  }
+
+  // There are at most as many targets and outputs as there are specs.
+  iree_host_size_t target_count = 0;
+  iree_tooling_stream_target_t* targets = NULL;
+  iree_host_size_t output_count = 0;
+  iree_tooling_stream_output_t* outputs = NULL;
+  iree_status_t status = iree_ok_status();
+  if (specs.count > 0) {
+    status = iree_allocator_malloc(host_allocator,
+                                   specs.count * sizeof(targets[0]),
+                                   (void**)&targets);
+    if (iree_status_is_ok(status)) {
+      status = iree_allocator_malloc(host_allocator,
+                                     specs.count * sizeof(outputs[0]),
+                                     (void**)&outputs);
+    }
+  }
+
+  // Lay out all outputs in their target files and write the .npy headers.
+  // Values that are not in HAL buffers are already in host memory and are
+  // written directly instead of being staged through the device.
+  iree_hal_allocator_t* device_allocator = iree_hal_device_allocator(device);
+  for (iree_host_size_t i = 0; i < specs.count && iree_status_is_ok(status);
+       ++i) {
+    iree_string_view_t spec = specs.values[i];
+    if (iree_string_view_is_empty(spec)) continue;
+    iree_vm_variant_t variant = iree_vm_variant_empty();
+    status = iree_vm_list_get_variant_assign(list, i, &variant);
+    iree_host_size_t target_ordinal = 0;
+    if (iree_status_is_ok(status)) {
+      status = iree_tooling_stream_open_target(spec, &target_count, targets,
+                                               host_allocator, &target_ordinal);
+    }
+    iree_tooling_stream_output_t* output = &outputs[output_count];
+    output->is_host = !iree_vm_variant_is_ref(variant) ||
+                      (!iree_hal_buffer_isa(variant.ref) &&
+                       !iree_hal_buffer_view_isa(variant.ref));
+    if (iree_status_is_ok(status)) {
+      status = iree_tooling_create_buffer_view_from_variant(
+          variant, device_allocator, host_allocator, &output->buffer_view);
+    }
+    if (iree_status_is_ok(status)) {
+      ++output_count;
+      output->target_ordinal = target_ordinal;
+      status = iree_tooling_stream_layout_output(&targets[target_ordinal], i,
+                                                 output, host_allocator);
+    }
+  }
+
+  // Write the archive headers and make all files available to the device.
+  for (iree_host_size_t i = 0; i < target_count && iree_status_is_ok(status);
+       ++i) {
+    status = iree_tooling_stream_finalize_target(
+        &targets[i], i, output_count, outputs, device, host_allocator);
+  }
+
+  // The completion fence covers |wait_fence| and all device writes so that it
+  // is valid to use even if there was nothing to write.
+  iree_hal_fence_t* completion_fence = NULL;
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_fence_create(
+        iree_hal_fence_timepoint_count(wait_fence) + output_count,
+        host_allocator, &completion_fence);
+  }
+  if (iree_status_is_ok(status) && wait_fence) {
+    status = iree_hal_fence_extend(completion_fence, wait_fence);
+  }
+
+  // Enqueue all writes. Each begins once all of |wait_fence| is reached and
+  // streams directly from the device buffer into the file.
+  for (iree_host_size_t i = 0; i < output_count && iree_status_is_ok(status);
+       ++i) {
+    if (outputs[i].is_host) continue;
+    status = iree_tooling_stream_write_output(
+        &outputs[i], targets[outputs[i].target_ordinal].file, device,
+        wait_fence, completion_fence);
+  }
+
+  // Chain the caller's signal fence to the completion of all writes or block
+  // until they have completed.
+  if (iree_status_is_ok(status)) {
+    if (signal_fence) {
+      status = iree_hal_device_queue_barrier(
+          device, IREE_HAL_QUEUE_AFFINITY_ANY,
+          iree_hal_fence_semaphore_list(completion_fence),
+          iree_hal_fence_semaphore_list(signal_fence));
+    } else {
+      status = iree_hal_fence_wait(completion_fence, iree_infinite_timeout());
+    }
+  }
+  iree_hal_fence_release(completion_fence);
+
+  for (iree_host_size_t i = 0; i < output_count; ++i) {
+    iree_hal_buffer_view_release(outputs[i].buffer_view);
+  }
+  for (iree_host_size_t i = 0; i < target_count; ++i) {
+    iree_tooling_stream_target_t* target = &targets[i];
+    iree_hal_file_release(target->file);
+    iree_io_stream_release(target->stream);
+    iree_io_file_handle_release(target->file_handle);
+    if (target->is_archive) {
+      iree_io_parameter_archive_builder_deinitialize(&target->builder);
+    }
+  }
+  iree_allocator_free(host_allocator, outputs);
+  iree_allocator_free(host_allocator, targets);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
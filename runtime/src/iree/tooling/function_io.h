@@ -113,6 +113,41 @@ iree_status_t iree_tooling_write_variants(iree_vm_list_t* list,
                                           iree_io_stream_t* default_stream,
                                           iree_allocator_t host_allocator);
 
+//===----------------------------------------------------------------------===//
+// Streaming
+//===----------------------------------------------------------------------===//
+
+// Streams a variant list to the files defined by |specs| using
+// iree_hal_device_queue_write on |device| instead of mapping the buffers into
+// host memory. Each write waits on |wait_fence| (if provided) so outputs of an
+// asynchronous invocation can be scheduled before the invocation completes.
+// All writes wait on the entire fence: per-output readiness is not tracked and
+// a write does not begin until every timepoint in |wait_fence| is reached.
+// Writes of different outputs are independent and may complete in any order.
+// File headers are written immediately and only the contents of HAL buffers
+// are streamed from device memory; other values (primitives and VM buffers)
+// are already on the host and are written immediately as well.
+// If no |signal_fence| is provided then the call will block until all writes
+// complete.
+//
+// Supported string output specifiers (and examples):
+//  - Ignore a list element (don't output):
+//    ``
+//  - Numpy files:
+//    `@file.npy` (write array to the specified file, discarding)
+//    `+file.npy` (append array to the specified file)
+//  - IREE Parameter Archive files (entries named `output_N` by list ordinal):
+//    `@file.irpa` (write array as the first entry of a new archive)
+//    `+file.irpa` (add array to an archive started by a prior `@` output)
+// Printing to a stream (`-`) and other file types are not supported as they
+// require the contents to be in host memory.
+iree_status_t iree_tooling_stream_variants(iree_vm_list_t* list,
+                                           iree_string_view_list_t specs,
+                                           iree_hal_device_t* device,
+                                           iree_hal_fence_t* wait_fence,
+                                           iree_hal_fence_t* signal_fence,
+                                           iree_allocator_t host_allocator);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -571,7 +571,7 @@ static iree_status_t iree_numpy_npy_write_bytes(
   return status;
 }
 
-IREE_API_EXPORT iree_status_t iree_numpy_npy_save_ndarray(
+IREE_API_EXPORT iree_status_t iree_numpy_npy_save_header(
     iree_io_stream_t* stream, iree_numpy_npy_save_options_t options,
     iree_hal_buffer_view_t* buffer_view, iree_allocator_t host_allocator) {
   IREE_ASSERT_ARGUMENT(stream);
@@ -590,12 +590,27 @@ IREE_API_EXPORT iree_status_t iree_numpy_npy_save_ndarray(
                                          iree_string_builder_view(&builder));
   }
 
+  iree_string_builder_deinitialize(&builder);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t iree_numpy_npy_save_ndarray(
+    iree_io_stream_t* stream, iree_numpy_npy_save_options_t options,
+    iree_hal_buffer_view_t* buffer_view, iree_allocator_t host_allocator) {
+  IREE_ASSERT_ARGUMENT(stream);
+  IREE_ASSERT_ARGUMENT(buffer_view);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Write header magic and dict, padded to 64 bytes.
+  iree_status_t status =
+      iree_numpy_npy_save_header(stream, options, buffer_view, host_allocator);
+
   // Write buffer contents.
   if (iree_status_is_ok(status)) {
     status = iree_numpy_npy_write_bytes(stream, buffer_view);
   }
 
-  iree_string_builder_deinitialize(&builder);
   IREE_TRACE_ZONE_END(z0);
   return status;
 }
@@ -97,6 +97,15 @@ IREE_API_EXPORT iree_status_t iree_numpy_npy_save_ndarray(
     iree_io_stream_t* stream, iree_numpy_npy_save_options_t options,
     iree_hal_buffer_view_t* buffer_view, iree_allocator_t host_allocator);
 
+// Saves only the header describing |buffer_view| to a .npy |stream|.
+// The ndarray contents must be written by the caller immediately following
+// the header (which is padded to 64 bytes) to produce a valid file. This
+// allows the contents to be written directly from device memory with
+// iree_hal_device_queue_write instead of being mapped into the host.
+IREE_API_EXPORT iree_status_t iree_numpy_npy_save_header(
+    iree_io_stream_t* stream, iree_numpy_npy_save_options_t options,
+    iree_hal_buffer_view_t* buffer_view, iree_allocator_t host_allocator);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
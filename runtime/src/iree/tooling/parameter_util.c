@@ -6,6 +6,9 @@
 
 #include "iree/tooling/parameter_util.h"
 
+#include <inttypes.h>
+#include <stdio.h>
+
 #include "iree/base/internal/file_io.h"
 #include "iree/base/internal/flags.h"
 #include "iree/io/formats/parser_registry.h"
@@ -33,6 +36,15 @@ IREE_FLAG(
     "        by the OS.\n"
     "  file: uses platform file APIs to read/write the file as needed.");
 
+IREE_FLAG(
+    string, parameter_prewarm, "none",
+    "Prefetches all parameters on startup to avoid faulting them in on first\n"
+    "use. One of ['none', 'async', 'wait'].\n"
+    "  none: parameters are read on demand.\n"
+    "  async: hints the OS to read parameters in the background.\n"
+    "  wait: blocks startup until all parameters have been read, reporting\n"
+    "        progress to stderr. Makes first-run latency predictable.");
+
 static void iree_file_contents_release_callback(
     void* user_data, iree_io_file_handle_primitive_t handle_primitive) {
   iree_file_contents_t* file_contents = (iree_file_contents_t*)user_data;
@@ -118,36 +130,28 @@ IREE_FLAG_LIST(
     "- .gguf (https://github.com/ggerganov/ggml/blob/master/docs/gguf.md)\n"
     "- .safetensors (https://github.com/huggingface/safetensors)");
 
-// Appends the parameter file located at |path| to |index|.
-static iree_status_t iree_io_append_parameter_file_to_index(
-    iree_string_view_t path, iree_io_parameter_index_t* index,
-    iree_allocator_t host_allocator) {
-  IREE_ASSERT_ARGUMENT(index);
-  IREE_TRACE_ZONE_BEGIN(z0);
-
-  // Open the file.
-  iree_io_file_handle_t* file_handle = NULL;
-  IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_io_open_parameter_file(path, host_allocator, &file_handle));
-
-  // Index the file based on its (inferred) format.
-  iree_status_t status =
-      iree_io_parse_file_index(path, file_handle, index, host_allocator);
-
-  // Release our file reference - it's still retained by the index if it had any
-  // parameters in it.
-  iree_io_file_handle_release(file_handle);
-
-  IREE_TRACE_ZONE_END(z0);
-  return status;
-}
-
 iree_status_t iree_tooling_build_parameter_indices_from_flags(
     iree_io_scope_map_t* scope_map) {
   IREE_TRACE_ZONE_BEGIN(z0);
+  const iree_host_size_t file_count = FLAG_parameters_list().count;
+  if (file_count == 0) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_ok_status();
+  }
+  iree_allocator_t host_allocator = scope_map->host_allocator;
 
-  // Create one index per scope and add parameters to each.
-  for (iree_host_size_t i = 0; i < FLAG_parameters_list().count; ++i) {
+  // Sharded checkpoints may be split across hundreds of files and parsing them
+  // serially is bound by the latency of reading each header. We open every
+  // file up front and then parse them all concurrently; entries are still
+  // appended to each index in flag order.
+  iree_io_parse_file_request_t* requests = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, file_count * sizeof(*requests),
+                                (void**)&requests));
+
+  // Create one index per scope and open each file.
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < file_count; ++i) {
     // Parse the `scope=path` flag. Note that the scope is optional.
     iree_string_view_t flag = FLAG_parameters_list().values[i];
     iree_string_view_t scope, path;
@@ -156,22 +160,88 @@ iree_status_t iree_tooling_build_parameter_indices_from_flags(
       path = scope;
       scope = iree_string_view_empty();
     }
+    requests[i].path = path;
 
     // Lookup (or create) the index for the given scope.
-    iree_io_parameter_index_t* index = NULL;  // unowned
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
-        z0, iree_io_scope_map_lookup(scope_map, scope, &index));
-
-    // Index the file.
-    IREE_RETURN_AND_END_ZONE_IF_ERROR(
-        z0, iree_io_append_parameter_file_to_index(path, index,
-                                                   scope_map->host_allocator));
+    status = iree_io_scope_map_lookup(scope_map, scope, &requests[i].index);
+    if (!iree_status_is_ok(status)) break;
+
+    // Open the file.
+    status = iree_io_open_parameter_file(path, host_allocator,
+                                         &requests[i].file_handle);
+    if (!iree_status_is_ok(status)) break;
   }
 
+  // Index all files based on their (inferred) formats.
+  if (iree_status_is_ok(status)) {
+    status = iree_io_parse_file_indices(file_count, requests,
+                                        /*max_concurrency=*/0, host_allocator);
+  }
+
+  // Release our file references - they're still retained by the indices if
+  // they had any parameters in them.
+  for (iree_host_size_t i = 0; i < file_count; ++i) {
+    iree_io_file_handle_release(requests[i].file_handle);
+  }
+  iree_allocator_free(host_allocator, requests);
+
   IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Prints prefetch progress to stderr in 10% increments.
+static iree_status_t iree_tooling_parameter_prewarm_progress(
+    void* user_data, uint64_t completed_bytes, uint64_t total_bytes) {
+  int* last_reported_percent = (int*)user_data;
+  int percent =
+      total_bytes ? (int)((completed_bytes * 100) / total_bytes) : 100;
+  if (percent / 10 > *last_reported_percent / 10 || percent == 100) {
+    fprintf(stderr,
+            "prewarming parameters: %3d%% (%" PRIu64 "/%" PRIu64 " bytes)\n",
+            percent, completed_bytes, total_bytes);
+    *last_reported_percent = percent;
+  }
   return iree_ok_status();
 }
 
+// Prefetches all parameters of each provider as requested by the
+// --parameter_prewarm flag.
+static iree_status_t iree_tooling_prewarm_parameters_from_flags(
+    iree_io_scope_map_t* scope_map, iree_host_size_t provider_count,
+    iree_io_parameter_provider_t** providers) {
+  iree_io_parameter_prefetch_flags_t flags =
+      IREE_IO_PARAMETER_PREFETCH_FLAG_NONE;
+  if (strcmp(FLAG_parameter_prewarm, "none") == 0) {
+    return iree_ok_status();
+  } else if (strcmp(FLAG_parameter_prewarm, "async") == 0) {
+    flags = IREE_IO_PARAMETER_PREFETCH_FLAG_NONE;
+  } else if (strcmp(FLAG_parameter_prewarm, "wait") == 0) {
+    flags = IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT;
+  } else {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "unrecognized --parameter_prewarm= mode: %s",
+                            FLAG_parameter_prewarm);
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  int last_reported_percent = -1;
+  iree_io_parameter_prefetch_progress_t progress = {
+      .fn = iree_all_bits_set(flags, IREE_IO_PARAMETER_PREFETCH_FLAG_WAIT)
+                ? iree_tooling_parameter_prewarm_progress
+                : NULL,
+      .user_data = &last_reported_percent,
+  };
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < provider_count; ++i) {
+    last_reported_percent = -1;
+    status = iree_io_parameter_provider_prefetch(
+        providers[i], scope_map->entries[i]->scope, /*key_count=*/0,
+        /*keys=*/NULL, flags, progress);
+    if (!iree_status_is_ok(status)) break;
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 iree_status_t iree_tooling_create_parameters_module_from_flags(
     iree_vm_instance_t* instance, iree_allocator_t host_allocator,
     iree_vm_module_t** out_module) {
@@ -200,6 +270,12 @@ iree_status_t iree_tooling_create_parameters_module_from_flags(
     }
   }
 
+  // Optionally warm up the parameters before they are first used.
+  if (iree_status_is_ok(status)) {
+    status = iree_tooling_prewarm_parameters_from_flags(
+        &scope_map, provider_count, providers);
+  }
+
   // Create the module with the list of providers.
   if (iree_status_is_ok(status)) {
     status = iree_io_parameters_module_create(
@@ -76,6 +76,21 @@ IREE_FLAG_LIST(
     "Each occurrence of the flag indicates an output in the order they were\n"
     "specified on the command line.");
 
+IREE_FLAG(
+    bool, output_streaming, false,
+    "Streams outputs written to .npy and .irpa files directly from device\n"
+    "buffers using queued file writes instead of transferring them to the\n"
+    "host. Writes are scheduled when the invocation returns and all of them\n"
+    "begin once the entire invocation completes: asynchronous functions\n"
+    "signal a single fence for all results so writes do not overlap with\n"
+    "device work of the invocation. The writes of all outputs are issued\n"
+    "together and may proceed concurrently. All --output= flags must be\n"
+    "empty or target .npy or .irpa files:\n"
+    "  `@file.irpa`: create/overwrite an IREE Parameter Archive with the\n"
+    "     output stored as the `output_N` entry (N is the output ordinal)\n"
+    "  `+file.irpa`: add the output to an archive started by a prior\n"
+    "     `@file.irpa` output");
+
 IREE_FLAG_LIST(
     string, expected_output,
     "An expected function output following the same format as `--input=`.\n"
@@ -185,6 +200,33 @@ static iree_status_t iree_tooling_create_run_context(
   return status;
 }
 
+// Prints the task executor statistics of |device| to |file|.
+// Devices that are not backed by a task executor (or that have statistics
+// compiled out) do not support the queries and are skipped.
+static void iree_tooling_print_executor_statistics(FILE* file,
+                                                   iree_hal_device_t* device) {
+  static const char* keys[] = {
+      "task_count",          "tile_count",         "steal_count",
+      "failed_steal_count",  "yield_count",        "sleep_count",
+      "sleep_ns",            "wake_count",         "coordination_count",
+      "coordinator_wait_ns", "coordinator_hold_ns",
+  };
+  int64_t values[IREE_ARRAYSIZE(keys)];
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(keys); ++i) {
+    iree_status_t status = iree_hal_device_query_i64(
+        device, IREE_SV("task.executor"), iree_make_cstring_view(keys[i]),
+        &values[i]);
+    if (!iree_status_is_ok(status)) {
+      iree_status_ignore(status);
+      return;
+    }
+  }
+  fprintf(file, "[[ iree_task_executor_t statistics ]]\n");
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(keys); ++i) {
+    fprintf(file, "%20s: %" PRId64 "\n", keys[i], values[i]);
+  }
+}
+
 static iree_status_t iree_tooling_annotate_status_with_function_decl(
     iree_status_t base_status, iree_vm_function_t function) {
   iree_string_view_t decl = iree_vm_function_lookup_attr_by_name(
@@ -200,6 +242,7 @@ static iree_status_t iree_tooling_run_function(
     iree_vm_context_t* context, iree_vm_function_t function,
     iree_hal_device_t* device, iree_hal_allocator_t* device_allocator,
     iree_allocator_t host_allocator, int* out_exit_code) {
+  *out_exit_code = EXIT_SUCCESS;
   iree_string_view_t function_name = iree_vm_function_name(&function);
   (void)function_name;
 
@@ -209,6 +252,21 @@ static iree_status_t iree_tooling_run_function(
   iree_status_t status = iree_vm_function_call_get_cconv_fragments(
       &signature, &arguments_cconv, &results_cconv);
 
+  // Streaming writes outputs directly from device buffers and bypasses the
+  // host-side processing of results.
+  if (iree_status_is_ok(status) && FLAG_output_streaming) {
+    if (!device) {
+      status = iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                                "--output_streaming requires a HAL device");
+    } else if (FLAG_output_list().count == 0 ||
+               FLAG_expected_output_list().count > 0) {
+      status = iree_make_status(
+          IREE_STATUS_INVALID_ARGUMENT,
+          "--output_streaming requires --output= flags for all outputs and "
+          "cannot be used with --expected_output=");
+    }
+  }
+
   // Parse --input= values into device buffers.
   iree_vm_list_t* inputs = NULL;
   if (iree_status_is_ok(status)) {
@@ -257,6 +315,17 @@ static iree_status_t iree_tooling_run_function(
   }
   iree_vm_list_release(inputs);
 
+  // Schedule the output writes before waiting on the invocation. The writes
+  // wait on the finish fence that covers all results and so only begin once
+  // the entire invocation has completed.
+  if (iree_status_is_ok(status) && FLAG_output_streaming) {
+    status = iree_status_annotate_f(
+        iree_tooling_stream_variants(outputs, FLAG_output_list(), device,
+                                     finish_fence, /*signal_fence=*/NULL,
+                                     host_allocator),
+        "streaming function outputs");
+  }
+
   // If the function is async we need to wait for it to complete.
   if (iree_status_is_ok(status) && finish_fence) {
     IREE_RETURN_IF_ERROR(
@@ -280,7 +349,7 @@ static iree_status_t iree_tooling_run_function(
 
   // Transfer outputs to the host so they can be processed. Only required when
   // using full HAL device-based execution.
-  if (iree_status_is_ok(status) && device != NULL) {
+  if (iree_status_is_ok(status) && device != NULL && !FLAG_output_streaming) {
     iree_hal_buffer_params_t target_params = {
         .usage = IREE_HAL_BUFFER_USAGE_TRANSFER | IREE_HAL_BUFFER_USAGE_MAPPING,
         .access = IREE_HAL_MEMORY_ACCESS_ALL,
@@ -306,7 +375,7 @@ static iree_status_t iree_tooling_run_function(
 
   // Handle either printing/writing the outputs or checking them against
   // expected values (basic pass/fail testing).
-  if (iree_status_is_ok(status)) {
+  if (iree_status_is_ok(status) && !FLAG_output_streaming) {
     status = iree_status_annotate_f(
         iree_tooling_process_results(device, results_cconv, outputs,
                                      stdout_stream, host_allocator,
@@ -427,6 +496,9 @@ iree_status_t iree_tooling_run_module_with_data(
     IREE_IGNORE_ERROR(
         iree_hal_allocator_statistics_fprint(stderr, device_allocator));
   }
+  if (device && FLAG_print_statistics) {
+    iree_tooling_print_executor_statistics(stderr, device);
+  }
 
   iree_hal_allocator_release(device_allocator);
   iree_hal_device_release(device);
@@ -1644,25 +1644,32 @@ iree_status_t iree_vm_bytecode_disassemble_op(
       break;
     }
 
+// Parses and emits a vm.cond_br. Shared with the superinstructions that end in
+// a conditional branch.
+#define DISASM_COND_BRANCH()                                                \
+  {                                                                         \
+    uint16_t condition_reg = VM_ParseOperandRegI32("condition");            \
+    int32_t true_block_pc = VM_ParseBranchTarget("true_dest");              \
+    const iree_vm_register_remap_list_t* true_remap_list =                  \
+        VM_ParseBranchOperands("true_operands");                            \
+    int32_t false_block_pc = VM_ParseBranchTarget("false_dest");            \
+    const iree_vm_register_remap_list_t* false_remap_list =                 \
+        VM_ParseBranchOperands("false_operands");                           \
+    IREE_RETURN_IF_ERROR(                                                   \
+        iree_string_builder_append_cstring(b, "vm.cond_br "));              \
+    EMIT_I32_REG_NAME(condition_reg);                                       \
+    EMIT_OPTIONAL_VALUE_I32(regs->i32[condition_reg]);                      \
+    IREE_RETURN_IF_ERROR(                                                   \
+        iree_string_builder_append_format(b, ", ^%08X(", true_block_pc));   \
+    EMIT_REMAP_LIST(true_remap_list);                                       \
+    IREE_RETURN_IF_ERROR(                                                   \
+        iree_string_builder_append_format(b, "), ^%08X(", false_block_pc)); \
+    EMIT_REMAP_LIST(false_remap_list);                                      \
+    IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, ")"));       \
+  }
+
     DISASM_OP(CORE, CondBranch) {
-      uint16_t condition_reg = VM_ParseOperandRegI32("condition");
-      int32_t true_block_pc = VM_ParseBranchTarget("true_dest");
-      const iree_vm_register_remap_list_t* true_remap_list =
-          VM_ParseBranchOperands("true_operands");
-      int32_t false_block_pc = VM_ParseBranchTarget("false_dest");
-      const iree_vm_register_remap_list_t* false_remap_list =
-          VM_ParseBranchOperands("false_operands");
-      IREE_RETURN_IF_ERROR(
-          iree_string_builder_append_cstring(b, "vm.cond_br "));
-      EMIT_I32_REG_NAME(condition_reg);
-      EMIT_OPTIONAL_VALUE_I32(regs->i32[condition_reg]);
-      IREE_RETURN_IF_ERROR(
-          iree_string_builder_append_format(b, ", ^%08X(", true_block_pc));
-      EMIT_REMAP_LIST(true_remap_list);
-      IREE_RETURN_IF_ERROR(
-          iree_string_builder_append_format(b, "), ^%08X(", false_block_pc));
-      EMIT_REMAP_LIST(false_remap_list);
-      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, ")"));
+      DISASM_COND_BRANCH();
       break;
     }
 
@@ -1900,6 +1907,123 @@ iree_status_t iree_vm_bytecode_disassemble_op(
       break;
     }
 
+    //===------------------------------------------------------------------===//
+    // Superinstructions
+    //===------------------------------------------------------------------===//
+    // Emitted as their component ops separated by `;`.
+
+#define DISASM_OP_CORE_CMP_I32_COND_BRANCH(op_name, op_mnemonic)       \
+  DISASM_OP(CORE, op_name) {                                           \
+    uint16_t lhs_reg = VM_ParseOperandRegI32("lhs");                   \
+    uint16_t rhs_reg = VM_ParseOperandRegI32("rhs");                   \
+    uint16_t result_reg = VM_ParseResultRegI32("result");              \
+    EMIT_I32_REG_NAME(result_reg);                                     \
+    IREE_RETURN_IF_ERROR(                                              \
+        iree_string_builder_append_format(b, " = %s ", op_mnemonic));  \
+    EMIT_I32_REG_NAME(lhs_reg);                                        \
+    EMIT_OPTIONAL_VALUE_I32(regs->i32[lhs_reg]);                       \
+    IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, ", ")); \
+    EMIT_I32_REG_NAME(rhs_reg);                                        \
+    EMIT_OPTIONAL_VALUE_I32(regs->i32[rhs_reg]);                       \
+    IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, "; ")); \
+    DISASM_COND_BRANCH();                                              \
+    break;                                                             \
+  }
+
+    DISASM_OP_CORE_CMP_I32_COND_BRANCH(CmpEQI32CondBranch, "vm.cmp.eq.i32");
+    DISASM_OP_CORE_CMP_I32_COND_BRANCH(CmpNEI32CondBranch, "vm.cmp.ne.i32");
+    DISASM_OP_CORE_CMP_I32_COND_BRANCH(CmpLTI32SCondBranch, "vm.cmp.lt.i32.s");
+
+#define DISASM_OP_CORE_CMP_I64_COND_BRANCH(op_name, op_mnemonic)       \
+  DISASM_OP(CORE, op_name) {                                           \
+    uint16_t lhs_reg = VM_ParseOperandRegI64("lhs");                   \
+    uint16_t rhs_reg = VM_ParseOperandRegI64("rhs");                   \
+    uint16_t result_reg = VM_ParseResultRegI32("result");              \
+    EMIT_I32_REG_NAME(result_reg);                                     \
+    IREE_RETURN_IF_ERROR(                                              \
+        iree_string_builder_append_format(b, " = %s ", op_mnemonic));  \
+    EMIT_I64_REG_NAME(lhs_reg);                                        \
+    EMIT_OPTIONAL_VALUE_I64(regs->i32[lhs_reg]);                       \
+    IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, ", ")); \
+    EMIT_I64_REG_NAME(rhs_reg);                                        \
+    EMIT_OPTIONAL_VALUE_I64(regs->i32[rhs_reg]);                       \
+    IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, "; ")); \
+    DISASM_COND_BRANCH();                                              \
+    break;                                                             \
+  }
+
+    DISASM_OP_CORE_CMP_I64_COND_BRANCH(CmpEQI64CondBranch, "vm.cmp.eq.i64");
+    DISASM_OP_CORE_CMP_I64_COND_BRANCH(CmpNEI64CondBranch, "vm.cmp.ne.i64");
+    DISASM_OP_CORE_CMP_I64_COND_BRANCH(CmpLTI64SCondBranch, "vm.cmp.lt.i64.s");
+
+    DISASM_OP(CORE, CmpNZRefCondBranch) {
+      bool operand_is_move;
+      uint16_t operand_reg = VM_ParseOperandRegRef("operand", &operand_is_move);
+      uint16_t result_reg = VM_ParseResultRegI32("result");
+      EMIT_I32_REG_NAME(result_reg);
+      IREE_RETURN_IF_ERROR(
+          iree_string_builder_append_cstring(b, " = vm.cmp.nz.ref "));
+      EMIT_REF_REG_NAME(operand_reg);
+      EMIT_OPTIONAL_VALUE_REF(&regs->ref[operand_reg]);
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, "; "));
+      DISASM_COND_BRANCH();
+      break;
+    }
+
+    DISASM_OP(CORE, AddI32CmpLTI32SCondBranch) {
+      uint16_t add_lhs_reg = VM_ParseOperandRegI32("lhs");
+      uint16_t add_rhs_reg = VM_ParseOperandRegI32("rhs");
+      uint16_t add_result_reg = VM_ParseResultRegI32("result");
+      EMIT_I32_REG_NAME(add_result_reg);
+      IREE_RETURN_IF_ERROR(
+          iree_string_builder_append_cstring(b, " = vm.add.i32 "));
+      EMIT_I32_REG_NAME(add_lhs_reg);
+      EMIT_OPTIONAL_VALUE_I32(regs->i32[add_lhs_reg]);
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, ", "));
+      EMIT_I32_REG_NAME(add_rhs_reg);
+      EMIT_OPTIONAL_VALUE_I32(regs->i32[add_rhs_reg]);
+      uint16_t cmp_lhs_reg = VM_ParseOperandRegI32("lhs");
+      uint16_t cmp_rhs_reg = VM_ParseOperandRegI32("rhs");
+      uint16_t cmp_result_reg = VM_ParseResultRegI32("result");
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, "; "));
+      EMIT_I32_REG_NAME(cmp_result_reg);
+      IREE_RETURN_IF_ERROR(
+          iree_string_builder_append_cstring(b, " = vm.cmp.lt.i32.s "));
+      EMIT_I32_REG_NAME(cmp_lhs_reg);
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, ", "));
+      EMIT_I32_REG_NAME(cmp_rhs_reg);
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, "; "));
+      DISASM_COND_BRANCH();
+      break;
+    }
+
+    DISASM_OP(CORE, AddI64CmpLTI64SCondBranch) {
+      uint16_t add_lhs_reg = VM_ParseOperandRegI64("lhs");
+      uint16_t add_rhs_reg = VM_ParseOperandRegI64("rhs");
+      uint16_t add_result_reg = VM_ParseResultRegI64("result");
+      EMIT_I64_REG_NAME(add_result_reg);
+      IREE_RETURN_IF_ERROR(
+          iree_string_builder_append_cstring(b, " = vm.add.i64 "));
+      EMIT_I64_REG_NAME(add_lhs_reg);
+      EMIT_OPTIONAL_VALUE_I64(regs->i32[add_lhs_reg]);
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, ", "));
+      EMIT_I64_REG_NAME(add_rhs_reg);
+      EMIT_OPTIONAL_VALUE_I64(regs->i32[add_rhs_reg]);
+      uint16_t cmp_lhs_reg = VM_ParseOperandRegI64("lhs");
+      uint16_t cmp_rhs_reg = VM_ParseOperandRegI64("rhs");
+      uint16_t cmp_result_reg = VM_ParseResultRegI32("result");
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, "; "));
+      EMIT_I32_REG_NAME(cmp_result_reg);
+      IREE_RETURN_IF_ERROR(
+          iree_string_builder_append_cstring(b, " = vm.cmp.lt.i64.s "));
+      EMIT_I64_REG_NAME(cmp_lhs_reg);
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, ", "));
+      EMIT_I64_REG_NAME(cmp_rhs_reg);
+      IREE_RETURN_IF_ERROR(iree_string_builder_append_cstring(b, "; "));
+      DISASM_COND_BRANCH();
+      break;
+    }
+
     //===------------------------------------------------------------------===//
     // Extension trampolines
     //===------------------------------------------------------------------===//
@@ -102,6 +102,8 @@ static iree_status_t iree_vm_bytecode_function_enter(
     return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
                             "import ordinal out of range");
   }
+  IREE_RETURN_IF_ERROR(
+      iree_vm_bytecode_module_ensure_verified(module, function.ordinal));
   const iree_vm_FunctionDescriptor_t* target_descriptor =
       &module->function_descriptor_table[function.ordinal];
 
@@ -440,16 +442,68 @@ static void iree_vm_bytecode_populate_import_cconv_arguments(
   }
 }
 
+// Begins a call to a native |import| with a direct call target, bypassing
+// the module begin_call. This matches what iree_vm_native_module_t does: the
+// callee frame is left on the stack if the call yields so that the module
+// resume_call can pick it back up.
+static iree_status_t iree_vm_bytecode_begin_direct_import_call(
+    iree_vm_stack_t* stack, const iree_vm_bytecode_import_t* import,
+    const iree_vm_function_call_t call) {
+  const iree_vm_native_function_direct_call_t* direct_call =
+      &import->direct_call;
+  iree_vm_stack_frame_t* callee_frame = NULL;
+  if (direct_call->module_state) {
+    IREE_RETURN_IF_ERROR(iree_vm_stack_function_enter_with_state(
+        stack, &call.function, direct_call->module_state,
+        IREE_VM_STACK_FRAME_NATIVE, /*frame_size=*/0,
+        /*frame_cleanup_fn=*/NULL, &callee_frame));
+  } else {
+    IREE_RETURN_IF_ERROR(iree_vm_stack_function_enter(
+        stack, &call.function, IREE_VM_STACK_FRAME_NATIVE, /*frame_size=*/0,
+        /*frame_cleanup_fn=*/NULL, &callee_frame));
+  }
+  iree_status_t status = direct_call->function.shim(
+      stack, IREE_VM_NATIVE_FUNCTION_CALL_BEGIN, call.arguments, call.results,
+      direct_call->function.target, direct_call->module,
+      callee_frame->module_state);
+  if (iree_status_is_deferred(status)) {
+    // Call deferred; bail and return to the scheduler.
+    // Note that we preserve the stack.
+    return status;
+  }
+
+  if (IREE_UNLIKELY(!iree_status_is_ok(status))) {
+#if IREE_STATUS_FEATURES & IREE_STATUS_FEATURE_ANNOTATIONS
+    iree_string_view_t module_name IREE_ATTRIBUTE_UNUSED =
+        iree_vm_module_name(call.function.module);
+    iree_string_view_t function_name IREE_ATTRIBUTE_UNUSED =
+        iree_vm_function_name(&call.function);
+    return iree_status_annotate_f(status,
+                                  "while invoking native function %.*s.%.*s",
+                                  (int)module_name.size, module_name.data,
+                                  (int)function_name.size, function_name.data);
+#else
+    return status;
+#endif  // IREE_STATUS_FEATURES & IREE_STATUS_FEATURE_ANNOTATIONS
+  }
+
+  // Call completed successfully; pop the stack and return to caller.
+  return iree_vm_stack_function_leave(stack);
+}
+
 // Issues a populated import call and marshals the results into |dst_reg_list|.
 static iree_status_t iree_vm_bytecode_issue_import_call(
-    iree_vm_stack_t* stack, const iree_vm_function_call_t call,
-    iree_string_view_t cconv_results,
+    iree_vm_stack_t* stack, const iree_vm_bytecode_import_t* import,
+    const iree_vm_function_call_t call, iree_string_view_t cconv_results,
     const iree_vm_register_list_t* IREE_RESTRICT dst_reg_list,
     iree_vm_stack_frame_t* IREE_RESTRICT* out_caller_frame,
     iree_vm_registers_t* out_caller_registers) {
   // Call external function.
   iree_status_t call_status =
-      call.function.module->begin_call(call.function.module->self, stack, call);
+      import->direct_call.function.shim
+          ? iree_vm_bytecode_begin_direct_import_call(stack, import, call)
+          : call.function.module->begin_call(call.function.module->self,
+                                             stack, call);
   if (iree_status_is_deferred(call_status)) {
     if (!iree_byte_span_is_empty(call.results)) {
       iree_status_ignore(call_status);
@@ -565,8 +619,9 @@ static iree_status_t iree_vm_bytecode_call_import(
   call.results.data_length = import->result_buffer_size;
   call.results.data = iree_alloca(call.results.data_length);
   memset(call.results.data, 0, call.results.data_length);
-  return iree_vm_bytecode_issue_import_call(stack, call, import->results,
-                                            dst_reg_list, out_caller_frame,
+  return iree_vm_bytecode_issue_import_call(stack, import, call,
+                                            import->results, dst_reg_list,
+                                            out_caller_frame,
                                             out_caller_registers);
 }
 
@@ -606,8 +661,9 @@ static iree_status_t iree_vm_bytecode_call_import_variadic(
   call.results.data_length = import->result_buffer_size;
   call.results.data = iree_alloca(call.results.data_length);
   memset(call.results.data, 0, call.results.data_length);
-  return iree_vm_bytecode_issue_import_call(stack, call, import->results,
-                                            dst_reg_list, out_caller_frame,
+  return iree_vm_bytecode_issue_import_call(stack, import, call,
+                                            import->results, dst_reg_list,
+                                            out_caller_frame,
                                             out_caller_registers);
 }
 
@@ -615,6 +671,24 @@ static iree_status_t iree_vm_bytecode_call_import_variadic(
 // Main interpreter dispatch routine
 //===----------------------------------------------------------------------===//
 
+// Runs the native code translated from the function of |current_frame| if the
+// frame has just been entered. Returns the pc the interpreter continues at.
+static inline iree_vm_source_offset_t iree_vm_bytecode_dispatch_jit_enter(
+    iree_vm_stack_t* stack, iree_vm_bytecode_module_t* module,
+    iree_vm_stack_frame_t* current_frame, int32_t* regs_i32) {
+#if IREE_VM_BYTECODE_JIT_ENABLE
+  if (IREE_LIKELY(!module->jit_module) || current_frame->pc != 0 ||
+      IREE_IS_DISPATCH_TRACING_ENABLED()) {
+    return current_frame->pc;
+  }
+  iree_vm_bytecode_jit_function_t function =
+      module->jit_module->functions[current_frame->function.ordinal];
+  return function ? function(regs_i32) : 0;
+#else
+  return current_frame->pc;
+#endif  // IREE_VM_BYTECODE_JIT_ENABLE
+}
+
 static iree_status_t iree_vm_bytecode_dispatch(
     iree_vm_stack_t* stack, iree_vm_bytecode_module_t* module,
     iree_vm_stack_frame_t* current_frame, iree_vm_registers_t regs,
@@ -686,7 +760,8 @@ static iree_status_t iree_vm_bytecode_dispatch(
   iree_vm_ref_t* IREE_RESTRICT regs_ref = regs.ref;
   IREE_BUILTIN_ASSUME_ALIGNED(regs_ref, 16);
 
-  iree_vm_source_offset_t pc = current_frame->pc;
+  iree_vm_source_offset_t pc = iree_vm_bytecode_dispatch_jit_enter(
+      stack, module, current_frame, regs_i32);
   BEGIN_DISPATCH_CORE() {
     //===------------------------------------------------------------------===//
     // Globals
@@ -1628,28 +1703,33 @@ static iree_status_t iree_vm_bytecode_dispatch(
       }
     });
 
-    DISPATCH_OP(CORE, CondBranch, {
-      int32_t condition = VM_DecOperandRegI32("condition");
-      int32_t true_block_pc = VM_DecBranchTarget("true_dest");
-      const iree_vm_register_remap_list_t* true_remap_list =
-          VM_DecBranchOperands("true_operands");
-      int32_t false_block_pc = VM_DecBranchTarget("false_dest");
-      const iree_vm_register_remap_list_t* false_remap_list =
-          VM_DecBranchOperands("false_operands");
-      if (condition) {
-        pc = true_block_pc + IREE_VM_BLOCK_MARKER_SIZE;  // skip block marker
-        if (IREE_UNLIKELY(true_remap_list->size > 0)) {
-          iree_vm_bytecode_dispatch_remap_branch_registers(regs_i32, regs_ref,
-                                                           true_remap_list);
-        }
-      } else {
-        pc = false_block_pc + IREE_VM_BLOCK_MARKER_SIZE;  // skip block marker
-        if (IREE_UNLIKELY(false_remap_list->size > 0)) {
-          iree_vm_bytecode_dispatch_remap_branch_registers(regs_i32, regs_ref,
-                                                           false_remap_list);
-        }
-      }
-    });
+// Decodes the condition and branch targets of a vm.cond_br and branches.
+// Shared with the superinstructions that end in a conditional branch.
+#define DISPATCH_COND_BRANCH(condition_name)                                   \
+  {                                                                            \
+    int32_t condition = VM_DecOperandRegI32(condition_name);                   \
+    int32_t true_block_pc = VM_DecBranchTarget("true_dest");                   \
+    const iree_vm_register_remap_list_t* true_remap_list =                     \
+        VM_DecBranchOperands("true_operands");                                 \
+    int32_t false_block_pc = VM_DecBranchTarget("false_dest");                 \
+    const iree_vm_register_remap_list_t* false_remap_list =                    \
+        VM_DecBranchOperands("false_operands");                                \
+    if (condition) {                                                           \
+      pc = true_block_pc + IREE_VM_BLOCK_MARKER_SIZE; /* skip block marker */  \
+      if (IREE_UNLIKELY(true_remap_list->size > 0)) {                          \
+        iree_vm_bytecode_dispatch_remap_branch_registers(regs_i32, regs_ref,   \
+                                                         true_remap_list);     \
+      }                                                                        \
+    } else {                                                                   \
+      pc = false_block_pc + IREE_VM_BLOCK_MARKER_SIZE; /* skip block marker */ \
+      if (IREE_UNLIKELY(false_remap_list->size > 0)) {                         \
+        iree_vm_bytecode_dispatch_remap_branch_registers(regs_i32, regs_ref,   \
+                                                         false_remap_list);    \
+      }                                                                        \
+    }                                                                          \
+  }
+
+    DISPATCH_OP(CORE, CondBranch, { DISPATCH_COND_BRANCH("condition"); });
 
     DISPATCH_OP(CORE, BranchTable, {
       int32_t index = VM_DecOperandRegI32("index");
@@ -1710,12 +1790,14 @@ static iree_status_t iree_vm_bytecode_dispatch(
       }
 
       // Restore the local dispatch variables that may have changed during the
-      // function call due to stack growth.
+      // function call due to stack growth. Internal callees start in their
+      // native code if they have any.
       regs_i32 = regs.i32;
       IREE_BUILTIN_ASSUME_ALIGNED(regs_i32, 16);
       regs_ref = regs.ref;
       IREE_BUILTIN_ASSUME_ALIGNED(regs_ref, 16);
-      pc = current_frame->pc;
+      pc = iree_vm_bytecode_dispatch_jit_enter(stack, module, current_frame,
+                                               regs_i32);
     });
 
     DISPATCH_OP(CORE, CallVariadic, {
@@ -1871,6 +1953,72 @@ static iree_status_t iree_vm_bytecode_dispatch(
       pc = block_pc + IREE_VM_BLOCK_MARKER_SIZE;  // skip block marker
     });
 
+    //===------------------------------------------------------------------===//
+    // Superinstructions
+    //===------------------------------------------------------------------===//
+    // Each superinstruction performs its component ops in order exactly as if
+    // they had been dispatched individually (including writing intermediate
+    // results to their registers) but saves a dispatch per fused op.
+
+#define DISPATCH_OP_CORE_CMP_I32_COND_BRANCH(op_name, op_func) \
+  DISPATCH_OP(CORE, op_name, {                                 \
+    int32_t lhs = VM_DecOperandRegI32("lhs");                  \
+    int32_t rhs = VM_DecOperandRegI32("rhs");                  \
+    int32_t* result = VM_DecResultRegI32("result");            \
+    *result = op_func(lhs, rhs);                               \
+    DISPATCH_COND_BRANCH("condition");                         \
+  });
+
+    DISPATCH_OP_CORE_CMP_I32_COND_BRANCH(CmpEQI32CondBranch, vm_cmp_eq_i32);
+    DISPATCH_OP_CORE_CMP_I32_COND_BRANCH(CmpNEI32CondBranch, vm_cmp_ne_i32);
+    DISPATCH_OP_CORE_CMP_I32_COND_BRANCH(CmpLTI32SCondBranch, vm_cmp_lt_i32s);
+
+#define DISPATCH_OP_CORE_CMP_I64_COND_BRANCH(op_name, op_func) \
+  DISPATCH_OP(CORE, op_name, {                                 \
+    int64_t lhs = VM_DecOperandRegI64("lhs");                  \
+    int64_t rhs = VM_DecOperandRegI64("rhs");                  \
+    int32_t* result = VM_DecResultRegI32("result");            \
+    *result = op_func(lhs, rhs);                               \
+    DISPATCH_COND_BRANCH("condition");                         \
+  });
+
+    DISPATCH_OP_CORE_CMP_I64_COND_BRANCH(CmpEQI64CondBranch, vm_cmp_eq_i64);
+    DISPATCH_OP_CORE_CMP_I64_COND_BRANCH(CmpNEI64CondBranch, vm_cmp_ne_i64);
+    DISPATCH_OP_CORE_CMP_I64_COND_BRANCH(CmpLTI64SCondBranch, vm_cmp_lt_i64s);
+
+    DISPATCH_OP(CORE, CmpNZRefCondBranch, {
+      bool operand_is_move;
+      iree_vm_ref_t* operand = VM_DecOperandRegRef("operand", &operand_is_move);
+      int32_t* result = VM_DecResultRegI32("result");
+      *result = vm_cmp_nz_ref(operand);
+      if (operand_is_move) iree_vm_ref_release(operand);
+      DISPATCH_COND_BRANCH("condition");
+    });
+
+    DISPATCH_OP(CORE, AddI32CmpLTI32SCondBranch, {
+      int32_t add_lhs = VM_DecOperandRegI32("lhs");
+      int32_t add_rhs = VM_DecOperandRegI32("rhs");
+      int32_t* add_result = VM_DecResultRegI32("result");
+      *add_result = vm_add_i32(add_lhs, add_rhs);
+      int32_t cmp_lhs = VM_DecOperandRegI32("lhs");
+      int32_t cmp_rhs = VM_DecOperandRegI32("rhs");
+      int32_t* cmp_result = VM_DecResultRegI32("result");
+      *cmp_result = vm_cmp_lt_i32s(cmp_lhs, cmp_rhs);
+      DISPATCH_COND_BRANCH("condition");
+    });
+
+    DISPATCH_OP(CORE, AddI64CmpLTI64SCondBranch, {
+      int64_t add_lhs = VM_DecOperandRegI64("lhs");
+      int64_t add_rhs = VM_DecOperandRegI64("rhs");
+      int64_t* add_result = VM_DecResultRegI64("result");
+      *add_result = vm_add_i64(add_lhs, add_rhs);
+      int64_t cmp_lhs = VM_DecOperandRegI64("lhs");
+      int64_t cmp_rhs = VM_DecOperandRegI64("rhs");
+      int32_t* cmp_result = VM_DecResultRegI32("result");
+      *cmp_result = vm_cmp_lt_i64s(cmp_lhs, cmp_rhs);
+      DISPATCH_COND_BRANCH("condition");
+    });
+
     //===------------------------------------------------------------------===//
     // Extension trampolines
     //===------------------------------------------------------------------===//
@@ -0,0 +1,274 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Tests covering bytecode calls to native module imports.
+//
+// iree/vm/bytecode/dispatch_import_test.mlir contains the functions used here
+// for testing. The imports are provided by a native module using the default
+// begin_call so that the context resolves them as direct calls.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+#include "iree/vm/api.h"
+#include "iree/vm/bytecode/module.h"
+
+// Compiled module embedded here to avoid file IO:
+#include "iree/vm/bytecode/dispatch_import_test_module_c.h"
+
+namespace iree {
+namespace {
+
+using iree::testing::status::StatusIs;
+
+//===----------------------------------------------------------------------===//
+// native module
+//===----------------------------------------------------------------------===//
+
+// Shared state of the native module passed to each shim as |module|.
+typedef struct native_module_t {
+  int add_1_count;
+  int fail_count;
+  int yield_begin_count;
+  int yield_resume_count;
+} native_module_t;
+
+// (i32)->i32 functions.
+static iree_status_t native_shim_i32_i32(
+    iree_vm_stack_t* stack, iree_vm_native_function_flags_t flags,
+    iree_byte_span_t args_storage, iree_byte_span_t rets_storage,
+    iree_vm_native_function_target_t target, void* module,
+    void* module_state) {
+  typedef iree_status_t (*target_fn_t)(native_module_t* module, int32_t arg0,
+                                       int32_t* out_ret0);
+  const int32_t arg0 = *(const int32_t*)args_storage.data;
+  int32_t* ret0 = (int32_t*)rets_storage.data;
+  return ((target_fn_t)target)((native_module_t*)module, arg0, ret0);
+}
+
+static iree_status_t native_add_1(native_module_t* module, int32_t arg0,
+                                  int32_t* out_ret0) {
+  ++module->add_1_count;
+  *out_ret0 = arg0 + 1;
+  return iree_ok_status();
+}
+
+static iree_status_t native_fail(native_module_t* module, int32_t arg0,
+                                 int32_t* out_ret0) {
+  ++module->fail_count;
+  return iree_make_status(IREE_STATUS_DATA_LOSS, "failed with %d", arg0);
+}
+
+// ()->() function that yields once when called and completes when resumed.
+static iree_status_t native_yield_once(iree_vm_stack_t* stack,
+                                       iree_vm_native_function_flags_t flags,
+                                       iree_byte_span_t args_storage,
+                                       iree_byte_span_t rets_storage,
+                                       iree_vm_native_function_target_t target,
+                                       void* module, void* module_state) {
+  native_module_t* native_module = (native_module_t*)module;
+  if (flags & IREE_VM_NATIVE_FUNCTION_CALL_RESUME) {
+    ++native_module->yield_resume_count;
+    return iree_ok_status();
+  }
+  ++native_module->yield_begin_count;
+  return iree_status_from_code(IREE_STATUS_DEFERRED);
+}
+
+static const iree_vm_native_export_descriptor_t native_module_exports_[] = {
+    {IREE_SV("add_1"), IREE_SV("0i_i"), 0, NULL},
+    {IREE_SV("fail"), IREE_SV("0i_i"), 0, NULL},
+    {IREE_SV("yield_once"), IREE_SV("0v_v"), 0, NULL},
+};
+static const iree_vm_native_function_ptr_t native_module_funcs_[] = {
+    {(iree_vm_native_function_shim_t)native_shim_i32_i32,
+     (iree_vm_native_function_target_t)native_add_1},
+    {(iree_vm_native_function_shim_t)native_shim_i32_i32,
+     (iree_vm_native_function_target_t)native_fail},
+    {(iree_vm_native_function_shim_t)native_yield_once, NULL},
+};
+static_assert(IREE_ARRAYSIZE(native_module_funcs_) ==
+                  IREE_ARRAYSIZE(native_module_exports_),
+              "function pointer table must be 1:1 with exports");
+static const iree_vm_native_module_descriptor_t native_module_descriptor_ = {
+    /*name=*/IREE_SV("native"),
+    /*version=*/0,
+    /*attr_count=*/0,
+    /*attrs=*/NULL,
+    /*dependency_count=*/0,
+    /*dependencies=*/NULL,
+    /*import_count=*/0,
+    /*imports=*/NULL,
+    /*export_count=*/IREE_ARRAYSIZE(native_module_exports_),
+    /*exports=*/native_module_exports_,
+    /*function_count=*/IREE_ARRAYSIZE(native_module_funcs_),
+    /*functions=*/native_module_funcs_,
+};
+
+//===----------------------------------------------------------------------===//
+// VMBytecodeDispatchImportTest
+//===----------------------------------------------------------------------===//
+
+class VMBytecodeDispatchImportTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    IREE_TRACE_SCOPE();
+    IREE_CHECK_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
+                                          iree_allocator_system(), &instance_));
+
+    memset(&native_state_, 0, sizeof(native_state_));
+    iree_vm_module_t interface;
+    IREE_CHECK_OK(iree_vm_module_initialize(&interface, &native_state_));
+    IREE_CHECK_OK(iree_vm_native_module_create(
+        &interface, &native_module_descriptor_, instance_,
+        iree_allocator_system(), &native_module_));
+
+    const iree_file_toc_t* file =
+        iree_vm_bytecode_dispatch_import_test_module_create();
+    IREE_CHECK_OK(iree_vm_bytecode_module_create(
+        instance_,
+        iree_const_byte_span_t{reinterpret_cast<const uint8_t*>(file->data),
+                               static_cast<iree_host_size_t>(file->size)},
+        iree_allocator_null(), iree_allocator_system(), &bytecode_module_));
+
+    std::vector<iree_vm_module_t*> modules = {native_module_,
+                                              bytecode_module_};
+    IREE_CHECK_OK(iree_vm_context_create_with_modules(
+        instance_, IREE_VM_CONTEXT_FLAG_NONE, modules.size(), modules.data(),
+        iree_allocator_system(), &context_));
+  }
+
+  void TearDown() override {
+    IREE_TRACE_SCOPE();
+    iree_vm_context_release(context_);
+    iree_vm_module_release(bytecode_module_);
+    iree_vm_module_release(native_module_);
+    iree_vm_instance_release(instance_);
+  }
+
+  iree_vm_function_t LookupFunction(const char* name) {
+    iree_vm_function_t function;
+    IREE_CHECK_OK(iree_vm_module_lookup_function_by_name(
+        bytecode_module_, IREE_VM_FUNCTION_LINKAGE_EXPORT,
+        iree_make_cstring_view(name), &function));
+    return function;
+  }
+
+  // Begins a call to |name| with a single i32 argument and result.
+  iree_status_t BeginCall(iree_vm_stack_t* stack, const char* name,
+                          int32_t* arg_value, int32_t* ret_value) {
+    iree_vm_function_t function = LookupFunction(name);
+    iree_vm_function_call_t call;
+    memset(&call, 0, sizeof(call));
+    call.function = function;
+    call.arguments = iree_make_byte_span(arg_value, sizeof(*arg_value));
+    call.results = iree_make_byte_span(ret_value, sizeof(*ret_value));
+    return function.module->begin_call(function.module->self, stack, call);
+  }
+
+  iree_vm_instance_t* instance_ = nullptr;
+  native_module_t native_state_;
+  iree_vm_module_t* native_module_ = nullptr;
+  iree_vm_module_t* bytecode_module_ = nullptr;
+  iree_vm_context_t* context_ = nullptr;
+};
+
+// The native module must offer direct calls for its exports or the tests below
+// would only cover begin_call.
+TEST_F(VMBytecodeDispatchImportTest, ExportsHaveDirectCalls) {
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(native_module_funcs_); ++i) {
+    iree_vm_function_t function;
+    IREE_ASSERT_OK(iree_vm_module_lookup_function_by_ordinal(
+        native_module_, IREE_VM_FUNCTION_LINKAGE_EXPORT, i, &function));
+    iree_vm_native_function_direct_call_t direct_call;
+    IREE_ASSERT_OK(native_module_->lookup_direct_call(native_module_->self,
+                                                      function, &direct_call));
+    EXPECT_EQ(direct_call.function.shim, native_module_funcs_[i].shim);
+    EXPECT_EQ(direct_call.function.target, native_module_funcs_[i].target);
+  }
+}
+
+TEST_F(VMBytecodeDispatchImportTest, Success) {
+  IREE_TRACE_SCOPE();
+  IREE_VM_INLINE_STACK_INITIALIZE(stack, IREE_VM_CONTEXT_FLAG_NONE,
+                                  iree_vm_context_state_resolver(context_),
+                                  iree_allocator_system());
+  int32_t arg_value = 41;
+  int32_t ret_value = 0;
+  IREE_ASSERT_OK(BeginCall(stack, "call_add_1", &arg_value, &ret_value));
+  EXPECT_EQ(ret_value, 42);
+  EXPECT_EQ(native_state_.add_1_count, 1);
+  EXPECT_EQ(iree_vm_stack_current_frame(stack), nullptr);
+  iree_vm_stack_deinitialize(stack);
+}
+
+// Failures are annotated with the native function the same as begin_call.
+TEST_F(VMBytecodeDispatchImportTest, Failure) {
+  IREE_TRACE_SCOPE();
+  IREE_VM_INLINE_STACK_INITIALIZE(stack, IREE_VM_CONTEXT_FLAG_NONE,
+                                  iree_vm_context_state_resolver(context_),
+                                  iree_allocator_system());
+  int32_t arg_value = 7;
+  int32_t ret_value = 0;
+  iree_status_t status = BeginCall(stack, "call_fail", &arg_value, &ret_value);
+  EXPECT_EQ(native_state_.fail_count, 1);
+#if IREE_STATUS_FEATURES & IREE_STATUS_FEATURE_ANNOTATIONS
+  iree_allocator_t allocator = iree_allocator_system();
+  iree_host_size_t message_length = 0;
+  char* message = NULL;
+  ASSERT_TRUE(
+      iree_status_to_string(status, &allocator, &message, &message_length));
+  std::string message_str(message, message_length);
+  iree_allocator_free(allocator, message);
+  EXPECT_NE(message_str.find("while invoking native function native.fail"),
+            std::string::npos)
+      << message_str;
+#endif  // IREE_STATUS_FEATURES & IREE_STATUS_FEATURE_ANNOTATIONS
+  EXPECT_THAT(Status(std::move(status)), StatusIs(StatusCode::kDataLoss));
+  iree_vm_stack_deinitialize(stack);
+}
+
+// Yields leave the native frame on the stack so that it is resumed with the
+// module resume_call before the bytecode caller continues.
+TEST_F(VMBytecodeDispatchImportTest, YieldThenResume) {
+  IREE_TRACE_SCOPE();
+  IREE_VM_INLINE_STACK_INITIALIZE(stack, IREE_VM_CONTEXT_FLAG_NONE,
+                                  iree_vm_context_state_resolver(context_),
+                                  iree_allocator_system());
+  int32_t arg_value = 97;
+  int32_t ret_value = 0;
+  ASSERT_THAT(BeginCall(stack, "call_yield_once", &arg_value, &ret_value),
+              StatusIs(StatusCode::kDeferred));
+  EXPECT_EQ(native_state_.yield_begin_count, 1);
+  EXPECT_EQ(native_state_.yield_resume_count, 0);
+
+  // Resume the native frame at the top of the stack.
+  iree_vm_stack_frame_t* native_frame = iree_vm_stack_top(stack);
+  ASSERT_NE(native_frame, nullptr);
+  ASSERT_EQ(native_frame->function.module, native_module_);
+  IREE_ASSERT_OK(native_module_->resume_call(
+      native_module_->self, stack,
+      iree_make_byte_span(&ret_value, sizeof(ret_value))));
+  EXPECT_EQ(native_state_.yield_resume_count, 1);
+
+  // Resume the bytecode caller to complete the call.
+  iree_vm_stack_frame_t* caller_frame = iree_vm_stack_top(stack);
+  ASSERT_NE(caller_frame, nullptr);
+  ASSERT_EQ(caller_frame->function.module, bytecode_module_);
+  IREE_ASSERT_OK(bytecode_module_->resume_call(
+      bytecode_module_->self, stack,
+      iree_make_byte_span(&ret_value, sizeof(ret_value))));
+  EXPECT_EQ(ret_value, arg_value + 1);
+  EXPECT_EQ(native_state_.yield_begin_count, 1);
+  iree_vm_stack_deinitialize(stack);
+}
+
+}  // namespace
+}  // namespace iree
@@ -0,0 +1,35 @@
+// Tested by iree/vm/bytecode/dispatch_import_test.cc.
+//
+// Calls imports provided by a native module in the test so that the direct
+// import call path is exercised for completion, failure, and yields.
+
+vm.module @dispatch_import_test {
+
+  vm.import private @native.add_1(%arg0 : i32) -> i32
+  vm.import private @native.fail(%arg0 : i32) -> i32
+  vm.import private @native.yield_once()
+
+  // Expects a result of %arg0 + 1.
+  vm.export @call_add_1
+  vm.func @call_add_1(%arg0: i32) -> i32 {
+    %0 = vm.call @native.add_1(%arg0) : (i32) -> i32
+    vm.return %0 : i32
+  }
+
+  // Expects the failure returned by the import.
+  vm.export @call_fail
+  vm.func @call_fail(%arg0: i32) -> i32 {
+    %0 = vm.call @native.fail(%arg0) : (i32) -> i32
+    vm.return %0 : i32
+  }
+
+  // Expects one yield from the import and then a result of %arg0 + 1.
+  vm.export @call_yield_once
+  vm.func @call_yield_once(%arg0: i32) -> i32 {
+    vm.call @native.yield_once() : () -> ()
+    %c1 = vm.const.i32 1
+    %0 = vm.add.i32 %arg0, %c1 : i32
+    vm.return %0 : i32
+  }
+
+}
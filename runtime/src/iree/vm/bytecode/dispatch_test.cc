@@ -23,6 +23,8 @@ namespace {
 struct TestParams {
   const struct iree_file_toc_t& module_file;
   std::string function_name;
+  // Creates the module with IREE_VM_BYTECODE_MODULE_FLAG_JIT.
+  bool jit;
 };
 
 std::ostream& operator<<(std::ostream& os, const TestParams& params) {
@@ -30,7 +32,8 @@ std::ostream& operator<<(std::ostream& os, const TestParams& params) {
   auto name_sv = iree_make_string_view(name.data(), name.size());
   iree_string_view_replace_char(name_sv, ':', '_');
   iree_string_view_replace_char(name_sv, '.', '_');
-  return os << name << "_" << params.function_name;
+  return os << name << "_" << params.function_name
+            << (params.jit ? "_jit" : "");
 }
 
 std::vector<TestParams> GetModuleTestParams() {
@@ -52,14 +55,19 @@ std::vector<TestParams> GetModuleTestParams() {
             static_cast<iree_host_size_t>(module_file.size)},
         iree_allocator_null(), iree_allocator_system(), &module));
     iree_vm_module_signature_t signature = iree_vm_module_signature(module);
-    test_params.reserve(test_params.size() + signature.export_function_count);
+    test_params.reserve(test_params.size() +
+                        2 * signature.export_function_count);
     for (int i = 0; i < signature.export_function_count; ++i) {
       iree_vm_function_t function;
       IREE_CHECK_OK(iree_vm_module_lookup_function_by_ordinal(
           module, IREE_VM_FUNCTION_LINKAGE_EXPORT, i, &function));
       iree_string_view_t function_name = iree_vm_function_name(&function);
       test_params.push_back(
-          {module_file, std::string(function_name.data, function_name.size)});
+          {module_file, std::string(function_name.data, function_name.size),
+           /*jit=*/false});
+      test_params.push_back(
+          {module_file, std::string(function_name.data, function_name.size),
+           /*jit=*/true});
     }
     iree_vm_module_release(module);
   }
@@ -79,8 +87,13 @@ class VMBytecodeDispatchTest
     IREE_CHECK_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
                                           iree_allocator_system(), &instance_));
 
-    IREE_CHECK_OK(iree_vm_bytecode_module_create(
-        instance_,
+    iree_vm_bytecode_module_options_t module_options;
+    iree_vm_bytecode_module_options_initialize(&module_options);
+    if (test_params.jit) {
+      module_options.flags |= IREE_VM_BYTECODE_MODULE_FLAG_JIT;
+    }
+    IREE_CHECK_OK(iree_vm_bytecode_module_create_with_options(
+        instance_, &module_options,
         iree_const_byte_span_t{
             reinterpret_cast<const uint8_t*>(test_params.module_file.data),
             static_cast<iree_host_size_t>(test_params.module_file.size)},
@@ -121,6 +134,22 @@ TEST_P(VMBytecodeDispatchTest, Check) {
   const auto& test_params = GetParam();
   bool expect_failure = test_params.function_name.find("fail_") == 0;
 
+#if IREE_VM_BYTECODE_JIT_ENABLE
+  // Functions in jit_ops.mlir must run natively when the JIT is requested so
+  // that the _jit variants exercise the native code and its exits.
+  if (test_params.jit &&
+      iree_string_view_starts_with(
+          iree_make_cstring_view(test_params.module_file.name),
+          IREE_SV("jit_ops"))) {
+    iree_vm_function_t function;
+    IREE_CHECK_OK(iree_vm_module_lookup_function_by_name(
+        bytecode_module_, IREE_VM_FUNCTION_LINKAGE_EXPORT,
+        iree_make_cstring_view(test_params.function_name.c_str()),
+        &function));
+    EXPECT_TRUE(iree_vm_bytecode_module_function_is_native(function));
+  }
+#endif  // IREE_VM_BYTECODE_JIT_ENABLE
+
   iree_status_t status = RunFunction(test_params.function_name.c_str());
   if (iree_status_is_ok(status)) {
     if (expect_failure) {
@@ -0,0 +1,790 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/vm/bytecode/jit.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "iree/base/internal/memory.h"
+
+#if IREE_VM_BYTECODE_JIT_ENABLE
+
+#include <sys/mman.h>
+
+//===----------------------------------------------------------------------===//
+// Code buffer
+//===----------------------------------------------------------------------===//
+
+// Growable host buffer that machine code is emitted into prior to being copied
+// into executable pages.
+typedef struct iree_vm_bytecode_jit_buffer_t {
+  iree_allocator_t allocator;
+  uint8_t* data;
+  iree_host_size_t length;
+  iree_host_size_t capacity;
+} iree_vm_bytecode_jit_buffer_t;
+
+// Ensures at least |length| more bytes can be emitted without growing.
+static iree_status_t iree_vm_bytecode_jit_buffer_reserve(
+    iree_vm_bytecode_jit_buffer_t* buffer, iree_host_size_t length) {
+  if (buffer->length + length <= buffer->capacity) return iree_ok_status();
+  iree_host_size_t new_capacity = iree_max(4096, buffer->capacity * 2);
+  while (new_capacity < buffer->length + length) new_capacity *= 2;
+  IREE_RETURN_IF_ERROR(iree_allocator_realloc(buffer->allocator, new_capacity,
+                                              (void**)&buffer->data));
+  buffer->capacity = new_capacity;
+  return iree_ok_status();
+}
+
+static inline void iree_vm_bytecode_jit_emit_u8(
+    iree_vm_bytecode_jit_buffer_t* buffer, uint8_t value) {
+  buffer->data[buffer->length++] = value;
+}
+
+static inline void iree_vm_bytecode_jit_emit_u32(
+    iree_vm_bytecode_jit_buffer_t* buffer, uint32_t value) {
+  iree_unaligned_store_le_u32((uint32_t*)&buffer->data[buffer->length], value);
+  buffer->length += 4;
+}
+
+//===----------------------------------------------------------------------===//
+// x86_64 op templates
+//===----------------------------------------------------------------------===//
+// Translated functions use the System V calling convention with the i32
+// register storage base in rdi. Only eax and ecx are used as scratch and the
+// functions are leaves with no stack frame. All register accesses use a 32-bit
+// displacement from rdi so that each template has a fixed size.
+
+// Condition codes used by jcc/setcc/cmovcc.
+enum iree_vm_bytecode_jit_cc_e {
+  IREE_VM_BYTECODE_JIT_CC_B = 0x2,
+  IREE_VM_BYTECODE_JIT_CC_E = 0x4,
+  IREE_VM_BYTECODE_JIT_CC_NE = 0x5,
+  IREE_VM_BYTECODE_JIT_CC_A = 0x7,
+  IREE_VM_BYTECODE_JIT_CC_L = 0xC,
+  IREE_VM_BYTECODE_JIT_CC_G = 0xF,
+};
+
+// ModR/M bytes addressing [rdi+disp32] with eax or ecx as the reg operand.
+#define IREE_VM_BYTECODE_JIT_MODRM_EAX_RDI 0x87
+#define IREE_VM_BYTECODE_JIT_MODRM_ECX_RDI 0x8F
+
+// Largest template emitted for a single op excluding branch register remaps.
+#define IREE_VM_BYTECODE_JIT_MAX_OP_SIZE 64
+// Size of the template for a single branch register remap.
+#define IREE_VM_BYTECODE_JIT_REMAP_SIZE 12
+
+// Emits |opcode| with [rdi+|disp|] as the memory operand.
+static void iree_vm_bytecode_jit_emit_mem(iree_vm_bytecode_jit_buffer_t* code,
+                                          uint8_t opcode, uint8_t modrm,
+                                          uint32_t disp) {
+  iree_vm_bytecode_jit_emit_u8(code, opcode);
+  iree_vm_bytecode_jit_emit_u8(code, modrm);
+  iree_vm_bytecode_jit_emit_u32(code, disp);
+}
+
+// mov eax, [rdi+disp]
+static void iree_vm_bytecode_jit_emit_load_eax(
+    iree_vm_bytecode_jit_buffer_t* code, uint32_t disp) {
+  iree_vm_bytecode_jit_emit_mem(code, 0x8B, IREE_VM_BYTECODE_JIT_MODRM_EAX_RDI,
+                                disp);
+}
+
+// mov ecx, [rdi+disp]
+static void iree_vm_bytecode_jit_emit_load_ecx(
+    iree_vm_bytecode_jit_buffer_t* code, uint32_t disp) {
+  iree_vm_bytecode_jit_emit_mem(code, 0x8B, IREE_VM_BYTECODE_JIT_MODRM_ECX_RDI,
+                                disp);
+}
+
+// mov [rdi+disp], eax
+static void iree_vm_bytecode_jit_emit_store_eax(
+    iree_vm_bytecode_jit_buffer_t* code, uint32_t disp) {
+  iree_vm_bytecode_jit_emit_mem(code, 0x89, IREE_VM_BYTECODE_JIT_MODRM_EAX_RDI,
+                                disp);
+}
+
+// mov dword [rdi+disp], imm32
+static void iree_vm_bytecode_jit_emit_store_imm(
+    iree_vm_bytecode_jit_buffer_t* code, uint32_t disp, uint32_t value) {
+  iree_vm_bytecode_jit_emit_mem(code, 0xC7, IREE_VM_BYTECODE_JIT_MODRM_EAX_RDI,
+                                disp);
+  iree_vm_bytecode_jit_emit_u32(code, value);
+}
+
+// cmp dword [rdi+disp], 0
+static void iree_vm_bytecode_jit_emit_test_zero(
+    iree_vm_bytecode_jit_buffer_t* code, uint32_t disp) {
+  iree_vm_bytecode_jit_emit_mem(code, 0x83, 0xBF, disp);
+  iree_vm_bytecode_jit_emit_u8(code, 0x00);
+}
+
+// setcc al; movzx eax, al
+static void iree_vm_bytecode_jit_emit_setcc_eax(
+    iree_vm_bytecode_jit_buffer_t* code, uint8_t cc) {
+  iree_vm_bytecode_jit_emit_u8(code, 0x0F);
+  iree_vm_bytecode_jit_emit_u8(code, 0x90 | cc);
+  iree_vm_bytecode_jit_emit_u8(code, 0xC0);
+  iree_vm_bytecode_jit_emit_u8(code, 0x0F);
+  iree_vm_bytecode_jit_emit_u8(code, 0xB6);
+  iree_vm_bytecode_jit_emit_u8(code, 0xC0);
+}
+
+// mov eax, imm32; ret
+static void iree_vm_bytecode_jit_emit_exit(iree_vm_bytecode_jit_buffer_t* code,
+                                           uint32_t pc) {
+  iree_vm_bytecode_jit_emit_u8(code, 0xB8);
+  iree_vm_bytecode_jit_emit_u32(code, pc);
+  iree_vm_bytecode_jit_emit_u8(code, 0xC3);
+}
+
+//===----------------------------------------------------------------------===//
+// Bytecode reader
+//===----------------------------------------------------------------------===//
+// Mirrors the VM_Dec* macros in dispatch_util.h but bounds checks everything
+// as the bytecode may not have been verified yet. Any failure clears |ok| and
+// the op being read (and everything after it) is left to the interpreter.
+
+typedef struct iree_vm_bytecode_jit_reader_t {
+  const uint8_t* data;
+  uint32_t length;
+  uint32_t pc;
+  uint32_t i32_register_count;
+  bool ok;
+} iree_vm_bytecode_jit_reader_t;
+
+static uint32_t iree_vm_bytecode_jit_read(iree_vm_bytecode_jit_reader_t* reader,
+                                          uint32_t size) {
+  if (!reader->ok || reader->length - reader->pc < size) {
+    reader->ok = false;
+    return 0;
+  }
+  const uint8_t* p = &reader->data[reader->pc];
+  reader->pc += size;
+  switch (size) {
+    case 1:
+      return p[0];
+    case 2:
+      return iree_unaligned_load_le_u16((const uint16_t*)p);
+    default:
+      return iree_unaligned_load_le_u32((const uint32_t*)p);
+  }
+}
+
+// Returns the byte offset of an i32 register operand/result from rdi.
+static uint32_t iree_vm_bytecode_jit_read_reg_i32(
+    iree_vm_bytecode_jit_reader_t* reader) {
+  uint32_t reg = iree_vm_bytecode_jit_read(reader, IREE_REGISTER_ORDINAL_SIZE);
+  if (reg >= reader->i32_register_count) reader->ok = false;
+  return reg * sizeof(int32_t);
+}
+
+static uint32_t iree_vm_bytecode_jit_read_branch_target(
+    iree_vm_bytecode_jit_reader_t* reader) {
+  uint32_t block_pc = iree_vm_bytecode_jit_read(reader, 4);
+  if (block_pc >= reader->length) reader->ok = false;
+  return block_pc;
+}
+
+// Returns the branch operand remap list or NULL if it is invalid or remaps any
+// ref registers.
+static const iree_vm_register_remap_list_t*
+iree_vm_bytecode_jit_read_branch_operands(
+    iree_vm_bytecode_jit_reader_t* reader) {
+  VM_AlignPC(reader->pc, IREE_REGISTER_ORDINAL_SIZE);
+  if (reader->pc > reader->length) reader->ok = false;
+  uint32_t list_pc = reader->pc;
+  uint32_t size = iree_vm_bytecode_jit_read(reader, IREE_REGISTER_ORDINAL_SIZE);
+  for (uint32_t i = 0; i < size * 2 && reader->ok; ++i) {
+    iree_vm_bytecode_jit_read_reg_i32(reader);
+  }
+  if (!reader->ok) return NULL;
+  return (const iree_vm_register_remap_list_t*)&reader->data[list_pc];
+}
+
+// Skips over a variadic register list of any register types.
+static void iree_vm_bytecode_jit_skip_register_list(
+    iree_vm_bytecode_jit_reader_t* reader) {
+  VM_AlignPC(reader->pc, IREE_REGISTER_ORDINAL_SIZE);
+  if (reader->pc > reader->length) reader->ok = false;
+  uint32_t size = iree_vm_bytecode_jit_read(reader, IREE_REGISTER_ORDINAL_SIZE);
+  for (uint32_t i = 0; i < size && reader->ok; ++i) {
+    iree_vm_bytecode_jit_read(reader, IREE_REGISTER_ORDINAL_SIZE);
+  }
+}
+
+// Skips over a string attribute.
+static void iree_vm_bytecode_jit_skip_str_attr(
+    iree_vm_bytecode_jit_reader_t* reader) {
+  uint32_t length = iree_vm_bytecode_jit_read(reader, 2);
+  if (!reader->ok || reader->length - reader->pc < length) {
+    reader->ok = false;
+    return;
+  }
+  reader->pc += length;
+}
+
+//===----------------------------------------------------------------------===//
+// Function translation
+//===----------------------------------------------------------------------===//
+
+// A rel32 branch displacement to patch once all block offsets are known.
+typedef struct iree_vm_bytecode_jit_fixup_t {
+  // Offset in the code buffer of the rel32 operand.
+  uint32_t code_offset;
+  // Bytecode pc of the target block.
+  uint32_t block_pc;
+} iree_vm_bytecode_jit_fixup_t;
+
+// Scratch storage reused across all functions in a module.
+typedef struct iree_vm_bytecode_jit_scratch_t {
+  // Code buffer offset of the block starting at each bytecode pc or
+  // UINT32_MAX if there is no block at that pc.
+  uint32_t* block_offsets;
+  // Branches to patch; there can be at most one per 2 bytes of bytecode.
+  iree_vm_bytecode_jit_fixup_t* fixups;
+  uint32_t fixup_count;
+} iree_vm_bytecode_jit_scratch_t;
+
+// Emits a jump (or conditional jump if |cc| is not 0xFF) to |block_pc|.
+static void iree_vm_bytecode_jit_emit_branch(
+    iree_vm_bytecode_jit_buffer_t* code,
+    iree_vm_bytecode_jit_scratch_t* scratch, uint8_t cc, uint32_t block_pc) {
+  if (cc == 0xFF) {
+    iree_vm_bytecode_jit_emit_u8(code, 0xE9);
+  } else {
+    iree_vm_bytecode_jit_emit_u8(code, 0x0F);
+    iree_vm_bytecode_jit_emit_u8(code, 0x80 | cc);
+  }
+  scratch->fixups[scratch->fixup_count++] = (iree_vm_bytecode_jit_fixup_t){
+      .code_offset = (uint32_t)code->length,
+      .block_pc = block_pc,
+  };
+  iree_vm_bytecode_jit_emit_u32(code, 0);
+}
+
+// Emits the register moves of |remap_list| and a jump to |block_pc|.
+static iree_status_t iree_vm_bytecode_jit_emit_remap_and_branch(
+    iree_vm_bytecode_jit_buffer_t* code,
+    iree_vm_bytecode_jit_scratch_t* scratch,
+    const iree_vm_register_remap_list_t* remap_list, uint32_t block_pc) {
+  IREE_RETURN_IF_ERROR(iree_vm_bytecode_jit_buffer_reserve(
+      code, remap_list->size * IREE_VM_BYTECODE_JIT_REMAP_SIZE +
+                IREE_VM_BYTECODE_JIT_MAX_OP_SIZE));
+  for (uint16_t i = 0; i < remap_list->size; ++i) {
+    iree_vm_bytecode_jit_emit_load_eax(
+        code, remap_list->pairs[i].src_reg * sizeof(int32_t));
+    iree_vm_bytecode_jit_emit_store_eax(
+        code, remap_list->pairs[i].dst_reg * sizeof(int32_t));
+  }
+  iree_vm_bytecode_jit_emit_branch(code, scratch, 0xFF, block_pc);
+  return iree_ok_status();
+}
+
+// Decodes and emits the tail of a vm.cond_br and any superinstruction ending
+// in one: branches to the true block if the condition register is non-zero.
+static iree_status_t iree_vm_bytecode_jit_emit_cond_branch(
+    iree_vm_bytecode_jit_reader_t* reader, iree_vm_bytecode_jit_buffer_t* code,
+    iree_vm_bytecode_jit_scratch_t* scratch) {
+  uint32_t condition = iree_vm_bytecode_jit_read_reg_i32(reader);
+  uint32_t true_block_pc = iree_vm_bytecode_jit_read_branch_target(reader);
+  const iree_vm_register_remap_list_t* true_remap_list =
+      iree_vm_bytecode_jit_read_branch_operands(reader);
+  uint32_t false_block_pc = iree_vm_bytecode_jit_read_branch_target(reader);
+  const iree_vm_register_remap_list_t* false_remap_list =
+      iree_vm_bytecode_jit_read_branch_operands(reader);
+  if (!reader->ok) return iree_ok_status();
+
+  // cmp [condition], 0; je false_remaps; <true remaps>; jmp true_block
+  // false_remaps: <false remaps>; jmp false_block
+  iree_vm_bytecode_jit_emit_test_zero(code, condition);
+  iree_vm_bytecode_jit_emit_u8(code, 0x0F);
+  iree_vm_bytecode_jit_emit_u8(code, 0x80 | IREE_VM_BYTECODE_JIT_CC_E);
+  iree_host_size_t false_rel32_offset = code->length;
+  iree_vm_bytecode_jit_emit_u32(code, 0);
+  IREE_RETURN_IF_ERROR(iree_vm_bytecode_jit_emit_remap_and_branch(
+      code, scratch, true_remap_list, true_block_pc));
+  iree_unaligned_store_le_u32(
+      (uint32_t*)&code->data[false_rel32_offset],
+      (uint32_t)(code->length - (false_rel32_offset + 4)));
+  return iree_vm_bytecode_jit_emit_remap_and_branch(
+      code, scratch, false_remap_list, false_block_pc);
+}
+
+// Emits `mov eax, [lhs]; <opcode> eax, [rhs]` for a two-operand op.
+static void iree_vm_bytecode_jit_emit_binary_eax(
+    iree_vm_bytecode_jit_reader_t* reader, iree_vm_bytecode_jit_buffer_t* code,
+    uint8_t opcode_prefix, uint8_t opcode) {
+  uint32_t lhs = iree_vm_bytecode_jit_read_reg_i32(reader);
+  uint32_t rhs = iree_vm_bytecode_jit_read_reg_i32(reader);
+  iree_vm_bytecode_jit_emit_load_eax(code, lhs);
+  if (opcode_prefix) iree_vm_bytecode_jit_emit_u8(code, opcode_prefix);
+  iree_vm_bytecode_jit_emit_mem(code, opcode,
+                                IREE_VM_BYTECODE_JIT_MODRM_EAX_RDI, rhs);
+}
+
+// Emits an arithmetic op of the form `result = lhs <op> rhs`.
+static void iree_vm_bytecode_jit_emit_arith(
+    iree_vm_bytecode_jit_reader_t* reader, iree_vm_bytecode_jit_buffer_t* code,
+    uint8_t opcode_prefix, uint8_t opcode) {
+  iree_vm_bytecode_jit_emit_binary_eax(reader, code, opcode_prefix, opcode);
+  uint32_t result = iree_vm_bytecode_jit_read_reg_i32(reader);
+  iree_vm_bytecode_jit_emit_store_eax(code, result);
+}
+
+// Emits a comparison of the form `result = lhs <cc> rhs ? 1 : 0`.
+static void iree_vm_bytecode_jit_emit_cmp(
+    iree_vm_bytecode_jit_reader_t* reader, iree_vm_bytecode_jit_buffer_t* code,
+    uint8_t cc) {
+  iree_vm_bytecode_jit_emit_binary_eax(reader, code, 0, 0x3B);
+  iree_vm_bytecode_jit_emit_setcc_eax(code, cc);
+  uint32_t result = iree_vm_bytecode_jit_read_reg_i32(reader);
+  iree_vm_bytecode_jit_emit_store_eax(code, result);
+}
+
+// Emits `result = lhs <cc> rhs ? rhs : lhs` as used by min/max.
+static void iree_vm_bytecode_jit_emit_minmax(
+    iree_vm_bytecode_jit_reader_t* reader, iree_vm_bytecode_jit_buffer_t* code,
+    uint8_t cc) {
+  uint32_t lhs = iree_vm_bytecode_jit_read_reg_i32(reader);
+  uint32_t rhs = iree_vm_bytecode_jit_read_reg_i32(reader);
+  iree_vm_bytecode_jit_emit_load_eax(code, lhs);
+  iree_vm_bytecode_jit_emit_load_ecx(code, rhs);
+  iree_vm_bytecode_jit_emit_u8(code, 0x39);  // cmp eax, ecx
+  iree_vm_bytecode_jit_emit_u8(code, 0xC8);
+  iree_vm_bytecode_jit_emit_u8(code, 0x0F);  // cmovcc eax, ecx
+  iree_vm_bytecode_jit_emit_u8(code, 0x40 | cc);
+  iree_vm_bytecode_jit_emit_u8(code, 0xC1);
+  uint32_t result = iree_vm_bytecode_jit_read_reg_i32(reader);
+  iree_vm_bytecode_jit_emit_store_eax(code, result);
+}
+
+// Emits `result = operand <shift> (amount & 31)`; |ext| selects the shift.
+static void iree_vm_bytecode_jit_emit_shift(
+    iree_vm_bytecode_jit_reader_t* reader, iree_vm_bytecode_jit_buffer_t* code,
+    uint8_t ext) {
+  uint32_t operand = iree_vm_bytecode_jit_read_reg_i32(reader);
+  uint32_t amount = iree_vm_bytecode_jit_read_reg_i32(reader);
+  iree_vm_bytecode_jit_emit_load_eax(code, operand);
+  iree_vm_bytecode_jit_emit_load_ecx(code, amount);
+  iree_vm_bytecode_jit_emit_u8(code, 0xD3);  // <shift> eax, cl
+  iree_vm_bytecode_jit_emit_u8(code, 0xC0 | (ext << 3));
+  uint32_t result = iree_vm_bytecode_jit_read_reg_i32(reader);
+  iree_vm_bytecode_jit_emit_store_eax(code, result);
+}
+
+// Translates the function bytecode in |reader| and appends it to |code|.
+// Translation stops at the first op without a template (or that cannot be
+// decoded) and native code exits to the interpreter at that op. Branches to
+// blocks past it exit to the interpreter at the target block. |out_translated|
+// is false if no ops could be translated in which case nothing is appended.
+static iree_status_t iree_vm_bytecode_jit_translate_function(
+    iree_vm_bytecode_jit_reader_t* reader, iree_vm_bytecode_jit_buffer_t* code,
+    iree_vm_bytecode_jit_scratch_t* scratch, bool* out_translated) {
+  *out_translated = false;
+  const iree_host_size_t code_start = code->length;
+  memset(scratch->block_offsets, 0xFF,
+         reader->length * sizeof(scratch->block_offsets[0]));
+  scratch->fixup_count = 0;
+
+  uint32_t translated_op_count = 0;
+  bool is_terminated = false;
+  while (reader->pc < reader->length) {
+    IREE_RETURN_IF_ERROR(iree_vm_bytecode_jit_buffer_reserve(
+        code, IREE_VM_BYTECODE_JIT_MAX_OP_SIZE));
+    const uint32_t op_pc = reader->pc;
+    const iree_host_size_t op_code_offset = code->length;
+    const uint32_t op_fixup_count = scratch->fixup_count;
+    const uint8_t opcode = (uint8_t)iree_vm_bytecode_jit_read(reader, 1);
+    bool is_supported = true;
+    is_terminated = false;
+    switch (opcode) {
+      case IREE_VM_OP_CORE_Block:
+        scratch->block_offsets[op_pc] = (uint32_t)code->length;
+        break;
+      case IREE_VM_OP_CORE_ConstI32Zero:
+        iree_vm_bytecode_jit_emit_store_imm(
+            code, iree_vm_bytecode_jit_read_reg_i32(reader), 0);
+        break;
+      case IREE_VM_OP_CORE_ConstI32: {
+        uint32_t value = iree_vm_bytecode_jit_read(reader, 4);
+        iree_vm_bytecode_jit_emit_store_imm(
+            code, iree_vm_bytecode_jit_read_reg_i32(reader), value);
+      } break;
+      case IREE_VM_OP_CORE_SelectI32: {
+        // mov eax, [false_value]; cmp [condition], 0; cmovne eax, [true_value]
+        uint32_t condition = iree_vm_bytecode_jit_read_reg_i32(reader);
+        uint32_t true_value = iree_vm_bytecode_jit_read_reg_i32(reader);
+        uint32_t false_value = iree_vm_bytecode_jit_read_reg_i32(reader);
+        iree_vm_bytecode_jit_emit_load_eax(code, false_value);
+        iree_vm_bytecode_jit_emit_test_zero(code, condition);
+        iree_vm_bytecode_jit_emit_u8(code, 0x0F);
+        iree_vm_bytecode_jit_emit_mem(code, 0x40 | IREE_VM_BYTECODE_JIT_CC_NE,
+                                      IREE_VM_BYTECODE_JIT_MODRM_EAX_RDI,
+                                      true_value);
+        iree_vm_bytecode_jit_emit_store_eax(
+            code, iree_vm_bytecode_jit_read_reg_i32(reader));
+      } break;
+      case IREE_VM_OP_CORE_AddI32:
+        iree_vm_bytecode_jit_emit_arith(reader, code, 0, 0x03);
+        break;
+      case IREE_VM_OP_CORE_SubI32:
+        iree_vm_bytecode_jit_emit_arith(reader, code, 0, 0x2B);
+        break;
+      case IREE_VM_OP_CORE_MulI32:
+        iree_vm_bytecode_jit_emit_arith(reader, code, 0x0F, 0xAF);
+        break;
+      case IREE_VM_OP_CORE_AndI32:
+        iree_vm_bytecode_jit_emit_arith(reader, code, 0, 0x23);
+        break;
+      case IREE_VM_OP_CORE_OrI32:
+        iree_vm_bytecode_jit_emit_arith(reader, code, 0, 0x0B);
+        break;
+      case IREE_VM_OP_CORE_XorI32:
+        iree_vm_bytecode_jit_emit_arith(reader, code, 0, 0x33);
+        break;
+      case IREE_VM_OP_CORE_NotI32:
+        iree_vm_bytecode_jit_emit_load_eax(
+            code, iree_vm_bytecode_jit_read_reg_i32(reader));
+        iree_vm_bytecode_jit_emit_u8(code, 0xF7);  // not eax
+        iree_vm_bytecode_jit_emit_u8(code, 0xD0);
+        iree_vm_bytecode_jit_emit_store_eax(
+            code, iree_vm_bytecode_jit_read_reg_i32(reader));
+        break;
+      case IREE_VM_OP_CORE_MinI32S:
+        iree_vm_bytecode_jit_emit_minmax(reader, code,
+                                         IREE_VM_BYTECODE_JIT_CC_G);
+        break;
+      case IREE_VM_OP_CORE_MinI32U:
+        iree_vm_bytecode_jit_emit_minmax(reader, code,
+                                         IREE_VM_BYTECODE_JIT_CC_A);
+        break;
+      case IREE_VM_OP_CORE_MaxI32S:
+        iree_vm_bytecode_jit_emit_minmax(reader, code,
+                                         IREE_VM_BYTECODE_JIT_CC_L);
+        break;
+      case IREE_VM_OP_CORE_MaxI32U:
+        iree_vm_bytecode_jit_emit_minmax(reader, code,
+                                         IREE_VM_BYTECODE_JIT_CC_B);
+        break;
+      case IREE_VM_OP_CORE_ShlI32:
+        iree_vm_bytecode_jit_emit_shift(reader, code, 4);
+        break;
+      case IREE_VM_OP_CORE_ShrI32S:
+        iree_vm_bytecode_jit_emit_shift(reader, code, 7);
+        break;
+      case IREE_VM_OP_CORE_ShrI32U:
+        iree_vm_bytecode_jit_emit_shift(reader, code, 5);
+        break;
+      case IREE_VM_OP_CORE_CmpEQI32:
+        iree_vm_bytecode_jit_emit_cmp(reader, code, IREE_VM_BYTECODE_JIT_CC_E);
+        break;
+      case IREE_VM_OP_CORE_CmpNEI32:
+        iree_vm_bytecode_jit_emit_cmp(reader, code, IREE_VM_BYTECODE_JIT_CC_NE);
+        break;
+      case IREE_VM_OP_CORE_CmpLTI32S:
+        iree_vm_bytecode_jit_emit_cmp(reader, code, IREE_VM_BYTECODE_JIT_CC_L);
+        break;
+      case IREE_VM_OP_CORE_CmpLTI32U:
+        iree_vm_bytecode_jit_emit_cmp(reader, code, IREE_VM_BYTECODE_JIT_CC_B);
+        break;
+      case IREE_VM_OP_CORE_CmpNZI32:
+        iree_vm_bytecode_jit_emit_test_zero(
+            code, iree_vm_bytecode_jit_read_reg_i32(reader));
+        iree_vm_bytecode_jit_emit_setcc_eax(code, IREE_VM_BYTECODE_JIT_CC_NE);
+        iree_vm_bytecode_jit_emit_store_eax(
+            code, iree_vm_bytecode_jit_read_reg_i32(reader));
+        break;
+      case IREE_VM_OP_CORE_Branch: {
+        uint32_t block_pc = iree_vm_bytecode_jit_read_branch_target(reader);
+        const iree_vm_register_remap_list_t* remap_list =
+            iree_vm_bytecode_jit_read_branch_operands(reader);
+        if (!reader->ok) break;
+        IREE_RETURN_IF_ERROR(iree_vm_bytecode_jit_emit_remap_and_branch(
+            code, scratch, remap_list, block_pc));
+        is_terminated = true;
+      } break;
+      case IREE_VM_OP_CORE_CondBranch:
+        IREE_RETURN_IF_ERROR(
+            iree_vm_bytecode_jit_emit_cond_branch(reader, code, scratch));
+        is_terminated = true;
+        break;
+      case IREE_VM_OP_CORE_CmpEQI32CondBranch:
+        iree_vm_bytecode_jit_emit_cmp(reader, code, IREE_VM_BYTECODE_JIT_CC_E);
+        IREE_RETURN_IF_ERROR(
+            iree_vm_bytecode_jit_emit_cond_branch(reader, code, scratch));
+        is_terminated = true;
+        break;
+      case IREE_VM_OP_CORE_CmpNEI32CondBranch:
+        iree_vm_bytecode_jit_emit_cmp(reader, code, IREE_VM_BYTECODE_JIT_CC_NE);
+        IREE_RETURN_IF_ERROR(
+            iree_vm_bytecode_jit_emit_cond_branch(reader, code, scratch));
+        is_terminated = true;
+        break;
+      case IREE_VM_OP_CORE_CmpLTI32SCondBranch:
+        iree_vm_bytecode_jit_emit_cmp(reader, code, IREE_VM_BYTECODE_JIT_CC_L);
+        IREE_RETURN_IF_ERROR(
+            iree_vm_bytecode_jit_emit_cond_branch(reader, code, scratch));
+        is_terminated = true;
+        break;
+      case IREE_VM_OP_CORE_AddI32CmpLTI32SCondBranch:
+        iree_vm_bytecode_jit_emit_arith(reader, code, 0, 0x03);
+        iree_vm_bytecode_jit_emit_cmp(reader, code, IREE_VM_BYTECODE_JIT_CC_L);
+        IREE_RETURN_IF_ERROR(
+            iree_vm_bytecode_jit_emit_cond_branch(reader, code, scratch));
+        is_terminated = true;
+        break;
+      case IREE_VM_OP_CORE_Return:
+        // Results are marshaled by the interpreter so that the native code
+        // never needs to know about frames.
+        iree_vm_bytecode_jit_skip_register_list(reader);
+        iree_vm_bytecode_jit_emit_exit(code, op_pc);
+        is_terminated = true;
+        break;
+      case IREE_VM_OP_CORE_Fail:
+        // The interpreter creates the failure status (or continues if the
+        // status code is 0).
+        iree_vm_bytecode_jit_read_reg_i32(reader);
+        iree_vm_bytecode_jit_skip_str_attr(reader);
+        iree_vm_bytecode_jit_emit_exit(code, op_pc);
+        is_terminated = true;
+        break;
+      default:
+        is_supported = false;
+        break;
+    }
+    if (!is_supported || !reader->ok) {
+      // Discard anything emitted for the op and leave it and all ops after it
+      // to the interpreter. Their encoding is unknown so translation cannot
+      // resume at the next op.
+      code->length = op_code_offset;
+      scratch->fixup_count = op_fixup_count;
+      iree_vm_bytecode_jit_emit_exit(code, op_pc);
+      is_terminated = true;
+      break;
+    }
+    if (opcode != IREE_VM_OP_CORE_Block) ++translated_op_count;
+  }
+
+  if (!translated_op_count || !is_terminated) {
+    // Nothing would run natively or falling off the end of the function would
+    // run into the next one.
+    code->length = code_start;
+    return iree_ok_status();
+  }
+
+  // Patch branches now that all blocks have been emitted. Blocks that were not
+  // translated get a stub exiting to the interpreter at the block. Translated
+  // functions are only entered after they have been verified and all targets
+  // are then valid blocks within the function.
+  for (uint32_t i = 0; i < scratch->fixup_count; ++i) {
+    const iree_vm_bytecode_jit_fixup_t* fixup = &scratch->fixups[i];
+    uint32_t block_offset = scratch->block_offsets[fixup->block_pc];
+    if (block_offset == UINT32_MAX) {
+      IREE_RETURN_IF_ERROR(iree_vm_bytecode_jit_buffer_reserve(
+          code, IREE_VM_BYTECODE_JIT_MAX_OP_SIZE));
+      block_offset = (uint32_t)code->length;
+      scratch->block_offsets[fixup->block_pc] = block_offset;
+      iree_vm_bytecode_jit_emit_exit(code, fixup->block_pc);
+    }
+    iree_unaligned_store_le_u32(
+        (uint32_t*)&code->data[fixup->code_offset],
+        (uint32_t)(block_offset - (fixup->code_offset + 4)));
+  }
+
+  // Pad with int3 so that the next function starts 16-byte aligned.
+  IREE_RETURN_IF_ERROR(iree_vm_bytecode_jit_buffer_reserve(code, 16));
+  while (code->length % 16) iree_vm_bytecode_jit_emit_u8(code, 0xCC);
+  *out_translated = true;
+  return iree_ok_status();
+}
+
+// Translates all functions into |code|. |function_offsets| receives the code
+// buffer offset of each translated function or UINT32_MAX.
+static iree_status_t iree_vm_bytecode_jit_translate_functions(
+    iree_host_size_t function_descriptor_count,
+    const iree_vm_FunctionDescriptor_t* function_descriptors,
+    iree_const_byte_span_t bytecode_data, iree_allocator_t allocator,
+    iree_vm_bytecode_jit_buffer_t* code, uint32_t* function_offsets,
+    iree_host_size_t* out_translated_function_count) {
+  *out_translated_function_count = 0;
+
+  // Size the scratch storage for the largest function.
+  iree_host_size_t max_bytecode_length = 0;
+  for (iree_host_size_t i = 0; i < function_descriptor_count; ++i) {
+    max_bytecode_length =
+        iree_max(max_bytecode_length,
+                 (iree_host_size_t)function_descriptors[i].bytecode_length);
+  }
+  if (max_bytecode_length == 0) return iree_ok_status();
+  iree_vm_bytecode_jit_scratch_t scratch;
+  memset(&scratch, 0, sizeof(scratch));
+  iree_host_size_t block_offsets_size =
+      max_bytecode_length * sizeof(scratch.block_offsets[0]);
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      allocator,
+      block_offsets_size +
+          (max_bytecode_length / 2 + 1) * sizeof(scratch.fixups[0]),
+      (void**)&scratch.block_offsets));
+  scratch.fixups = (iree_vm_bytecode_jit_fixup_t*)((uint8_t*)
+                                                       scratch.block_offsets +
+                                                   block_offsets_size);
+
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < function_descriptor_count; ++i) {
+    function_offsets[i] = UINT32_MAX;
+    const iree_vm_FunctionDescriptor_t* descriptor = &function_descriptors[i];
+    if (descriptor->bytecode_offset < 0 || descriptor->bytecode_length <= 0 ||
+        (iree_host_size_t)descriptor->bytecode_offset +
+                descriptor->bytecode_length >
+            bytecode_data.data_length) {
+      continue;
+    }
+    iree_vm_bytecode_jit_reader_t reader = {
+        .data = bytecode_data.data + descriptor->bytecode_offset,
+        .length = (uint32_t)descriptor->bytecode_length,
+        .pc = 0,
+        .i32_register_count = descriptor->i32_register_count,
+        .ok = true,
+    };
+    const uint32_t function_offset = (uint32_t)code->length;
+    bool translated = false;
+    status = iree_vm_bytecode_jit_translate_function(&reader, code, &scratch,
+                                                     &translated);
+    if (!iree_status_is_ok(status)) break;
+    if (translated) {
+      function_offsets[i] = function_offset;
+      ++*out_translated_function_count;
+    }
+  }
+
+  iree_allocator_free(allocator, scratch.block_offsets);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// Executable code
+//===----------------------------------------------------------------------===//
+
+// Copies |code| into newly allocated executable pages. The pages are never
+// writable and executable at the same time.
+static iree_status_t iree_vm_bytecode_jit_commit_code(
+    const iree_vm_bytecode_jit_buffer_t* code, void** out_code_base,
+    iree_host_size_t* out_code_length) {
+  const iree_memory_info_t memory_info = iree_memory_query_info();
+  const iree_host_size_t code_length =
+      iree_host_align(code->length, memory_info.normal_page_size);
+  void* code_base = mmap(NULL, code_length, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (code_base == MAP_FAILED) {
+    return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                            "failed to allocate %" PRIhsz
+                            " bytes for JIT code",
+                            code_length);
+  }
+  iree_memory_jit_context_begin();
+  memcpy(code_base, code->data, code->length);
+  iree_memory_jit_context_end();
+  if (mprotect(code_base, code_length, PROT_READ | PROT_EXEC) != 0) {
+    munmap(code_base, code_length);
+    return iree_make_status(IREE_STATUS_PERMISSION_DENIED,
+                            "failed to make JIT code executable");
+  }
+  iree_memory_flush_icache(code_base, code->length);
+  *out_code_base = code_base;
+  *out_code_length = code_length;
+  return iree_ok_status();
+}
+
+iree_status_t iree_vm_bytecode_jit_module_create(
+    iree_host_size_t function_descriptor_count,
+    const iree_vm_FunctionDescriptor_t* function_descriptors,
+    iree_const_byte_span_t bytecode_data, iree_allocator_t allocator,
+    iree_vm_bytecode_jit_module_t** out_jit_module) {
+  IREE_ASSERT_ARGUMENT(out_jit_module);
+  *out_jit_module = NULL;
+  if (function_descriptor_count == 0 ||
+      !iree_all_bits_set(iree_memory_query_info().supported_features,
+                         IREE_MEMORY_FEATURE_ALLOCATABLE_EXECUTABLE_PAGES)) {
+    return iree_ok_status();
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_vm_bytecode_jit_module_t* jit_module = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(
+              allocator,
+              sizeof(*jit_module) +
+                  function_descriptor_count * sizeof(jit_module->functions[0]),
+              (void**)&jit_module));
+
+  // Functions are translated into a host buffer and located by offset until
+  // the code has been committed and its base address is known.
+  uint32_t* function_offsets = NULL;
+  iree_vm_bytecode_jit_buffer_t code = {.allocator = allocator};
+  iree_status_t status = iree_allocator_malloc(
+      allocator, function_descriptor_count * sizeof(function_offsets[0]),
+      (void**)&function_offsets);
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_bytecode_jit_translate_functions(
+        function_descriptor_count, function_descriptors, bytecode_data,
+        allocator, &code, function_offsets,
+        &jit_module->translated_function_count);
+  }
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, jit_module->translated_function_count);
+
+  if (iree_status_is_ok(status) && jit_module->translated_function_count > 0) {
+    // Platforms may deny executable pages (W^X policies, SELinux, etc) in
+    // which case all functions are interpreted.
+    iree_status_ignore(iree_vm_bytecode_jit_commit_code(
+        &code, &jit_module->code_base, &jit_module->code_length));
+  }
+  iree_allocator_free(allocator, code.data);
+
+  if (iree_status_is_ok(status) && jit_module->code_base) {
+    for (iree_host_size_t i = 0; i < function_descriptor_count; ++i) {
+      uint32_t function_offset = function_offsets[i];
+      jit_module->functions[i] =
+          function_offset == UINT32_MAX
+              ? NULL
+              : (iree_vm_bytecode_jit_function_t)(
+                    (uint8_t*)jit_module->code_base + function_offset);
+    }
+    *out_jit_module = jit_module;
+  } else {
+    iree_allocator_free(allocator, jit_module);
+  }
+  iree_allocator_free(allocator, function_offsets);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+void iree_vm_bytecode_jit_module_free(iree_vm_bytecode_jit_module_t* jit_module,
+                                      iree_allocator_t allocator) {
+  if (!jit_module) return;
+  if (jit_module->code_base) {
+    munmap(jit_module->code_base, jit_module->code_length);
+  }
+  iree_allocator_free(allocator, jit_module);
+}
+
+#else
+
+iree_status_t iree_vm_bytecode_jit_module_create(
+    iree_host_size_t function_descriptor_count,
+    const iree_vm_FunctionDescriptor_t* function_descriptors,
+    iree_const_byte_span_t bytecode_data, iree_allocator_t allocator,
+    iree_vm_bytecode_jit_module_t** out_jit_module) {
+  IREE_ASSERT_ARGUMENT(out_jit_module);
+  *out_jit_module = NULL;
+  return iree_ok_status();
+}
+
+void iree_vm_bytecode_jit_module_free(iree_vm_bytecode_jit_module_t* jit_module,
+                                      iree_allocator_t allocator) {}
+
+#endif  // IREE_VM_BYTECODE_JIT_ENABLE
@@ -0,0 +1,82 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_VM_BYTECODE_JIT_H_
+#define IREE_VM_BYTECODE_JIT_H_
+
+#include <stdint.h>
+
+#include "iree/base/api.h"
+#include "iree/vm/bytecode/utils/isa.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// Baseline JIT
+//===----------------------------------------------------------------------===//
+//
+// Functions are translated once at module creation by walking their bytecode
+// and stitching together a fixed machine code template per op with the
+// register offsets, immediates, and branch targets patched in. There is no
+// register allocation or optimization: every op loads its operands from and
+// stores its results to the frame register storage exactly as the interpreter
+// does, which allows the interpreter to pick up where the native code left off
+// with no state to transfer.
+//
+// Native code is entered by the interpreter when a frame is first entered and
+// runs until it reaches an op it does not handle (vm.return, vm.fail, and any
+// op without a template) at which point it returns the pc of that op and the
+// interpreter continues from there. Translation of a function stops at the
+// first op without a template: native code exits to the interpreter at that op
+// and branches to blocks after it exit at the target block. Once in the
+// interpreter a frame stays there, so functions are only partially native when
+// their unsupported ops come after the hot path. Functions that start with an
+// op without a template are not translated.
+
+// Native entry point of a translated function.
+// |regs_i32| is the i32 register storage of the entered frame. Returns the pc
+// of the op the interpreter should continue execution at.
+typedef uint32_t(IREE_API_PTR* iree_vm_bytecode_jit_function_t)(
+    int32_t* regs_i32);
+
+// Native code for all translated functions in a module.
+typedef struct iree_vm_bytecode_jit_module_t {
+  // Executable pages containing the code of all translated functions.
+  void* code_base;
+  iree_host_size_t code_length;
+  // Number of functions that were translated.
+  iree_host_size_t translated_function_count;
+  // Entry points mapped 1:1 with function descriptors. NULL for functions that
+  // must be interpreted.
+  iree_vm_bytecode_jit_function_t functions[];
+} iree_vm_bytecode_jit_module_t;
+
+// Translates all supported functions in |function_descriptors| to native code.
+// |out_jit_module| is set to NULL if the JIT is unavailable on the current
+// target or platform or none of the functions could be translated; in that
+// case all functions are interpreted. Must be freed with
+// iree_vm_bytecode_jit_module_free.
+//
+// Bytecode is bounds checked during translation and does not need to have been
+// verified: anything unexpected causes the function to be interpreted (and
+// verified when entered).
+iree_status_t iree_vm_bytecode_jit_module_create(
+    iree_host_size_t function_descriptor_count,
+    const iree_vm_FunctionDescriptor_t* function_descriptors,
+    iree_const_byte_span_t bytecode_data, iree_allocator_t allocator,
+    iree_vm_bytecode_jit_module_t** out_jit_module);
+
+// Frees the native code and entry table of |jit_module|.
+void iree_vm_bytecode_jit_module_free(iree_vm_bytecode_jit_module_t* jit_module,
+                                      iree_allocator_t allocator);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_VM_BYTECODE_JIT_H_
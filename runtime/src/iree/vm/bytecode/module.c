@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "iree/base/internal/siphash.h"
 #include "iree/vm/bytecode/archive.h"
 #include "iree/vm/bytecode/module_impl.h"
 #include "iree/vm/bytecode/verifier.h"
@@ -153,6 +154,9 @@ static void iree_vm_bytecode_module_destroy(void* self) {
     iree_vm_buffer_deinitialize(ref);
   }
 
+  iree_vm_bytecode_jit_module_free(module->jit_module, module->allocator);
+  module->jit_module = NULL;
+
   module->def = NULL;
   iree_allocator_free(module->archive_allocator,
                       (void*)module->archive_contents.data);
@@ -744,6 +748,13 @@ static iree_status_t IREE_API_PTR iree_vm_bytecode_module_fork_state(
   memcpy(child_state->import_table, parent_state->import_table,
          parent_state->import_count * sizeof(child_state->import_table[0]));
 
+  // Direct calls may have resolved the imported module state in the parent
+  // context. The child has its own states so we drop them and let the stack
+  // resolve them on each call.
+  for (iree_host_size_t i = 0; i < child_state->import_count; ++i) {
+    child_state->import_table[i].direct_call.module_state = NULL;
+  }
+
   *out_child_state = (iree_vm_module_state_t*)child_state;
 
   IREE_TRACE_ZONE_END(z0);
@@ -766,6 +777,7 @@ static iree_status_t iree_vm_bytecode_module_resolve_import(
 
   iree_vm_bytecode_import_t* import = &state->import_table[ordinal];
   import->function = *function;
+  memset(&import->direct_call, 0, sizeof(import->direct_call));
 
   // Split up arguments/results into fragments so that we can avoid scanning
   // during calling.
@@ -795,6 +807,22 @@ static iree_status_t iree_vm_bytecode_module_resolve_import(
   return iree_ok_status();
 }
 
+static iree_status_t iree_vm_bytecode_module_resolve_import_direct_call(
+    void* self, iree_vm_module_state_t* module_state, iree_host_size_t ordinal,
+    const iree_vm_native_function_direct_call_t* direct_call) {
+  IREE_ASSERT_ARGUMENT(module_state);
+  iree_vm_bytecode_module_state_t* state =
+      (iree_vm_bytecode_module_state_t*)module_state;
+  if (ordinal >= state->import_count) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "import ordinal out of range (0 < %" PRIhsz
+                            " < %" PRIhsz ")",
+                            ordinal, state->import_count);
+  }
+  state->import_table[ordinal].direct_call = *direct_call;
+  return iree_ok_status();
+}
+
 static iree_status_t IREE_API_PTR iree_vm_bytecode_module_notify(
     void* self, iree_vm_module_state_t* module_state, iree_vm_signal_t signal) {
   return iree_ok_status();
@@ -853,11 +881,73 @@ static iree_status_t iree_vm_bytecode_module_resume_call(
   return iree_vm_bytecode_dispatch_resume(stack, module, call_results);  // tail
 }
 
+iree_status_t iree_vm_bytecode_module_verify_function_lazy(
+    iree_vm_bytecode_module_t* module, uint16_t function_ordinal) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Racing threads may both verify the function; verification has no side
+  // effects and only the thread that sets the bit updates the count below.
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_bytecode_function_verify(module, function_ordinal,
+                                           module->allocator));
+  const int32_t bit = (int32_t)(1u << (function_ordinal % 32));
+  int32_t prior_word = iree_atomic_fetch_or(
+      &module->verified_function_bits[function_ordinal / 32], bit,
+      iree_memory_order_acq_rel);
+
+  // Record the module in the verification cache once every function has been
+  // verified so that future loads can skip verification entirely.
+  if (!(prior_word & bit) &&
+      iree_atomic_fetch_sub(&module->unverified_function_count, 1,
+                            iree_memory_order_acq_rel) == 1 &&
+      module->verification_cache.insert) {
+    module->verification_cache.insert(module->verification_cache.self,
+                                      module->verification_digest);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+// Computes the digest of the module FlatBuffer used to key the verification
+// cache. Rodata stored outside of the FlatBuffer is not included as only its
+// bounds are verified and those are checked on every load.
+static uint64_t iree_vm_bytecode_module_verification_digest(
+    const iree_vm_bytecode_verification_cache_t* cache,
+    iree_const_byte_span_t flatbuffer_contents) {
+  iree_siphash_key_t key = {
+      .k0 = cache->key[0],
+      .k1 = cache->key[1] ^ (((uint64_t)IREE_VM_BYTECODE_VERSION_MAJOR << 16) |
+                             IREE_VM_BYTECODE_VERSION_MINOR),
+  };
+  return iree_siphash24(key, flatbuffer_contents);
+}
+
+IREE_API_EXPORT void iree_vm_bytecode_module_options_initialize(
+    iree_vm_bytecode_module_options_t* out_options) {
+  IREE_ASSERT_ARGUMENT(out_options);
+  memset(out_options, 0, sizeof(*out_options));
+}
+
 IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
     iree_vm_instance_t* instance, iree_const_byte_span_t archive_contents,
     iree_allocator_t archive_allocator, iree_allocator_t allocator,
     iree_vm_module_t** out_module) {
+  iree_vm_bytecode_module_options_t options;
+  iree_vm_bytecode_module_options_initialize(&options);
+  return iree_vm_bytecode_module_create_with_options(
+      instance, &options, archive_contents, archive_allocator, allocator,
+      out_module);
+}
+
+IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create_with_options(
+    iree_vm_instance_t* instance,
+    const iree_vm_bytecode_module_options_t* options,
+    iree_const_byte_span_t archive_contents,
+    iree_allocator_t archive_allocator, iree_allocator_t allocator,
+    iree_vm_module_t** out_module) {
   IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_ASSERT_ARGUMENT(options);
   IREE_ASSERT_ARGUMENT(out_module);
   *out_module = NULL;
 
@@ -897,18 +987,46 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
   size_t rodata_ref_table_size =
       iree_host_align(rodata_ref_count * sizeof(iree_vm_buffer_t), 16);
 
+  iree_vm_FunctionDescriptor_vec_t function_descriptors =
+      iree_vm_BytecodeModuleDef_function_descriptors(module_def);
+  iree_host_size_t function_descriptor_count =
+      iree_vm_FunctionDescriptor_vec_len(function_descriptors);
+
+  // Determine which functions (if any) need verification. A verification cache
+  // hit means the exact same FlatBuffer has been verified before.
+  bool verify_functions = IREE_VM_BYTECODE_VERIFICATION_ENABLE;
+  uint64_t verification_digest = 0;
+  if (verify_functions && options->verification_cache) {
+    IREE_TRACE_ZONE_BEGIN_NAMED(
+        z1, "iree_vm_bytecode_module_verification_cache_lookup");
+    verification_digest = iree_vm_bytecode_module_verification_digest(
+        options->verification_cache, flatbuffer_contents);
+    verify_functions = !options->verification_cache->lookup(
+        options->verification_cache->self, verification_digest);
+    IREE_TRACE_ZONE_END(z1);
+  }
+  const bool verify_lazily =
+      verify_functions && function_descriptor_count > 0 &&
+      iree_all_bits_set(options->flags,
+                        IREE_VM_BYTECODE_MODULE_FLAG_LAZY_VERIFICATION);
+  size_t verified_function_bits_size =
+      verify_lazily
+          ? iree_host_align(
+                iree_host_size_ceil_div(function_descriptor_count, 32) *
+                    sizeof(iree_atomic_int32_t),
+                16)
+          : 0;
+
   iree_vm_bytecode_module_t* module = NULL;
   IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0,
-      iree_allocator_malloc(
-          allocator, sizeof(*module) + type_table_size + rodata_ref_table_size,
-          (void**)&module));
+      z0, iree_allocator_malloc(allocator,
+                                sizeof(*module) + type_table_size +
+                                    rodata_ref_table_size +
+                                    verified_function_bits_size,
+                                (void**)&module));
   module->allocator = allocator;
 
-  iree_vm_FunctionDescriptor_vec_t function_descriptors =
-      iree_vm_BytecodeModuleDef_function_descriptors(module_def);
-  module->function_descriptor_count =
-      iree_vm_FunctionDescriptor_vec_len(function_descriptors);
+  module->function_descriptor_count = function_descriptor_count;
   module->function_descriptor_table = function_descriptors;
 
   flatbuffers_uint8_vec_t bytecode_data =
@@ -948,6 +1066,8 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
   module->interface.free_state = iree_vm_bytecode_module_free_state;
   module->interface.fork_state = iree_vm_bytecode_module_fork_state;
   module->interface.resolve_import = iree_vm_bytecode_module_resolve_import;
+  module->interface.resolve_import_direct_call =
+      iree_vm_bytecode_module_resolve_import_direct_call;
   module->interface.notify = iree_vm_bytecode_module_notify;
   module->interface.begin_call = iree_vm_bytecode_module_begin_call;
   module->interface.resume_call = iree_vm_bytecode_module_resume_call;
@@ -981,17 +1101,47 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
                               iree_allocator_null(), ref);
   }
 
+  if (options->verification_cache) {
+    module->verification_cache = *options->verification_cache;
+    module->verification_digest = verification_digest;
+  }
+
   // Verify functions in the module now that we've verified the metadata that we
-  // need to do so.
+  // need to do so. With lazy verification each function is instead verified on
+  // its first call and the bitmap (zeroed by the allocation) tracks progress.
   iree_status_t verify_status = iree_ok_status();
-#if IREE_VM_BYTECODE_VERIFICATION_ENABLE
-  for (uint16_t i = 0; i < module->function_descriptor_count; ++i) {
-    IREE_TRACE_ZONE_BEGIN_NAMED(z1, "iree_vm_bytecode_function_verify");
-    verify_status = iree_vm_bytecode_function_verify(module, i, allocator);
+  if (verify_lazily) {
+    module->verified_function_bits =
+        (iree_atomic_int32_t*)((uint8_t*)module + sizeof(*module) +
+                               type_table_size + rodata_ref_table_size);
+    iree_atomic_store(&module->unverified_function_count,
+                      (int32_t)module->function_descriptor_count,
+                      iree_memory_order_release);
+  } else if (verify_functions) {
+    for (uint16_t i = 0; i < module->function_descriptor_count; ++i) {
+      IREE_TRACE_ZONE_BEGIN_NAMED(z1, "iree_vm_bytecode_function_verify");
+      verify_status = iree_vm_bytecode_function_verify(module, i, allocator);
+      IREE_TRACE_ZONE_END(z1);
+      if (!iree_status_is_ok(verify_status)) break;
+    }
+    if (iree_status_is_ok(verify_status) && options->verification_cache) {
+      options->verification_cache->insert(options->verification_cache->self,
+                                          verification_digest);
+    }
+  }
+
+  // Translate what we can to native code. The JIT bounds checks the bytecode
+  // itself and translated functions are only entered after they have passed
+  // verification so this is safe with lazy verification.
+  if (iree_status_is_ok(verify_status) &&
+      iree_all_bits_set(options->flags, IREE_VM_BYTECODE_MODULE_FLAG_JIT)) {
+    IREE_TRACE_ZONE_BEGIN_NAMED(z1, "iree_vm_bytecode_module_jit");
+    verify_status = iree_vm_bytecode_jit_module_create(
+        module->function_descriptor_count, module->function_descriptor_table,
+        module->bytecode_data, allocator, &module->jit_module);
     IREE_TRACE_ZONE_END(z1);
-    if (!iree_status_is_ok(verify_status)) break;
   }
-#endif  // IREE_VM_BYTECODE_VERIFICATION_ENABLE
+
   if (iree_status_is_ok(verify_status)) {
     *out_module = &module->interface;
   } else {
@@ -1001,3 +1151,25 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
   IREE_TRACE_ZONE_END(z0);
   return verify_status;
 }
+
+IREE_API_EXPORT bool iree_vm_bytecode_module_function_is_native(
+    iree_vm_function_t function) {
+  if (!function.module ||
+      function.module->destroy != iree_vm_bytecode_module_destroy) {
+    return false;
+  }
+  iree_vm_bytecode_module_t* module =
+      (iree_vm_bytecode_module_t*)function.module->self;
+  if (!module->jit_module) return false;
+  uint16_t ordinal = function.ordinal;
+  if (function.linkage != IREE_VM_FUNCTION_LINKAGE_INTERNAL) {
+    iree_status_t status =
+        iree_vm_bytecode_map_internal_ordinal(module, function, &ordinal, NULL);
+    if (!iree_status_is_ok(status)) {
+      iree_status_ignore(status);
+      return false;
+    }
+  }
+  return ordinal < module->function_descriptor_count &&
+         module->jit_module->functions[ordinal] != NULL;
+}
@@ -23,6 +23,81 @@ IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create(
     iree_allocator_t archive_allocator, iree_allocator_t allocator,
     iree_vm_module_t** out_module);
 
+// Controls bytecode module creation behavior.
+enum iree_vm_bytecode_module_flag_bits_t {
+  IREE_VM_BYTECODE_MODULE_FLAG_NONE = 0u,
+
+  // Defers bytecode verification of each function until its first call.
+  // Module creation only verifies the FlatBuffer metadata and functions that
+  // are never called are never verified. A function that fails verification
+  // fails the call that would have entered it instead of module creation.
+  // Has no effect if IREE_VM_BYTECODE_VERIFICATION_ENABLE is 0.
+  IREE_VM_BYTECODE_MODULE_FLAG_LAZY_VERIFICATION = 1u << 0,
+
+  // Translates functions to native code at module creation by stitching
+  // together per-op machine code templates. i32 arithmetic, comparisons, and
+  // branches run natively until the first other op, which (along with the rest
+  // of the call) runs in the interpreter. Functions on targets or platforms
+  // without JIT support or where executable pages cannot be allocated are
+  // interpreted. Has no effect if IREE_VM_BYTECODE_JIT_ENABLE is 0.
+  IREE_VM_BYTECODE_MODULE_FLAG_JIT = 1u << 1,
+};
+typedef uint32_t iree_vm_bytecode_module_flags_t;
+
+// A host-owned record of module archives whose bytecode has passed
+// verification, allowing it to be skipped when the same archive is loaded
+// again (such as in a later process).
+//
+// Entries are keyed by a digest of the module FlatBuffer computed with
+// SipHash-2-4 under |key|. The key must be secret from whoever produces
+// untrusted archives (for example, randomly generated and persisted alongside
+// the cache) so that they cannot produce a different archive with the digest
+// of one that has already been verified. The digest also covers the runtime
+// bytecode version so that cache entries are not shared across runtimes with
+// differing verifiers.
+//
+// |lookup| and |insert| may be called from any thread that calls into the
+// module when using lazy verification and must be thread-safe. The cache must
+// remain valid for the lifetime of any module created with it.
+typedef struct iree_vm_bytecode_verification_cache_t {
+  // User-defined pointer passed to all functions.
+  void* self;
+  // Returns true if an archive with |digest| has previously passed
+  // verification.
+  bool(IREE_API_PTR* lookup)(void* self, uint64_t digest);
+  // Records that an archive with |digest| has passed verification.
+  void(IREE_API_PTR* insert)(void* self, uint64_t digest);
+  // Secret 128-bit key used to compute digests.
+  uint64_t key[2];
+} iree_vm_bytecode_verification_cache_t;
+
+// Options controlling bytecode module creation.
+typedef struct iree_vm_bytecode_module_options_t {
+  // Flags controlling module behavior.
+  iree_vm_bytecode_module_flags_t flags;
+  // Optional verification cache; NULL to always verify.
+  const iree_vm_bytecode_verification_cache_t* verification_cache;
+} iree_vm_bytecode_module_options_t;
+
+// Initializes |out_options| to their default values.
+IREE_API_EXPORT void iree_vm_bytecode_module_options_initialize(
+    iree_vm_bytecode_module_options_t* out_options);
+
+// Creates a VM module from an in-memory ModuleDef FlatBuffer archive using the
+// provided |options|. See iree_vm_bytecode_module_create for details.
+IREE_API_EXPORT iree_status_t iree_vm_bytecode_module_create_with_options(
+    iree_vm_instance_t* instance,
+    const iree_vm_bytecode_module_options_t* options,
+    iree_const_byte_span_t archive_contents,
+    iree_allocator_t archive_allocator, iree_allocator_t allocator,
+    iree_vm_module_t** out_module);
+
+// Returns true if |function| is a function of a bytecode module that was
+// translated to native code with IREE_VM_BYTECODE_MODULE_FLAG_JIT. Translated
+// functions may still exit to the interpreter partway through.
+IREE_API_EXPORT bool iree_vm_bytecode_module_function_is_native(
+    iree_vm_function_t function);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -71,10 +71,13 @@ static iree_status_t native_import_module_create(
 }
 
 // Benchmarks the given exported function, optionally passing in arguments.
-static iree_status_t RunFunction(iree_benchmark_state_t* benchmark_state,
-                                 iree_string_view_t function_name,
-                                 std::vector<int32_t> i32_args,
-                                 int result_count, int64_t batch_size = 1) {
+// |module_flags| controls how the bytecode module is created such as whether
+// functions are translated by the JIT.
+static iree_status_t RunFunction(
+    iree_benchmark_state_t* benchmark_state, iree_string_view_t function_name,
+    std::vector<int32_t> i32_args, int result_count, int64_t batch_size = 1,
+    iree_vm_bytecode_module_flags_t module_flags =
+        IREE_VM_BYTECODE_MODULE_FLAG_NONE) {
   iree_vm_instance_t* instance = NULL;
   IREE_CHECK_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
                                         iree_allocator_system(), &instance));
@@ -85,9 +88,12 @@ static iree_status_t RunFunction(iree_benchmark_state_t* benchmark_state,
 
   const auto* module_file_toc =
       iree_vm_bytecode_module_benchmark_module_create();
+  iree_vm_bytecode_module_options_t module_options;
+  iree_vm_bytecode_module_options_initialize(&module_options);
+  module_options.flags = module_flags;
   iree_vm_module_t* bytecode_module = nullptr;
-  IREE_CHECK_OK(iree_vm_bytecode_module_create(
-      instance,
+  IREE_CHECK_OK(iree_vm_bytecode_module_create_with_options(
+      instance, &module_options,
       iree_const_byte_span_t{
           reinterpret_cast<const uint8_t*>(module_file_toc->data),
           static_cast<iree_host_size_t>(module_file_toc->size)},
@@ -292,6 +298,19 @@ IREE_BENCHMARK_FN(BM_CallInternalFuncBytecode) {
 }
 IREE_BENCHMARK_REGISTER(BM_CallInternalFuncBytecode);
 
+// Only internal_func is translated as call_internal_func contains calls; this
+// measures the cost of entering native code from the interpreter.
+IREE_BENCHMARK_FN(BM_CallInternalFuncJIT) {
+  static const int batch = 100;
+  return RunFunction(
+      benchmark_state,
+      iree_make_cstring_view("bytecode_module_benchmark.call_internal_func"),
+      {batch},
+      /*result_count=*/1,
+      /*batch_size=*/batch, IREE_VM_BYTECODE_MODULE_FLAG_JIT);
+}
+IREE_BENCHMARK_REGISTER(BM_CallInternalFuncJIT);
+
 IREE_BENCHMARK_FN(BM_CallImportedFuncBytecode) {
   static const int batch = 100;
   return RunFunction(
@@ -335,6 +354,74 @@ IREE_BENCHMARK_FN(BM_LoopSumBytecode) {
 }
 IREE_BENCHMARK_REGISTER(BM_LoopSumBytecode);
 
+IREE_BENCHMARK_FN(BM_LoopSumJIT) {
+  static const int batch = 100000;
+  return RunFunction(
+      benchmark_state,
+      iree_make_cstring_view("bytecode_module_benchmark.loop_sum"), {batch},
+      /*result_count=*/1,
+      /*batch_size=*/batch, IREE_VM_BYTECODE_MODULE_FLAG_JIT);
+}
+IREE_BENCHMARK_REGISTER(BM_LoopSumJIT);
+
+IREE_BENCHMARK_FN(BM_BranchChainReference) {
+  static const int batch = 100000;
+  static auto work = +[](int i) {
+    int v = 0;
+    switch (i & 3) {
+      case 0:
+        break;
+      case 1:
+        v = 1;
+        break;
+      case 2:
+        v = 2;
+        break;
+      default:
+        v = 3;
+        break;
+    }
+    iree_optimization_barrier(v);
+    return v;
+  };
+  static auto loop = +[](int count) {
+    int sum = 0;
+    for (int i = 0; i < count; ++i) {
+      iree_optimization_barrier(sum += work(i));
+    }
+    return sum;
+  };
+  while (iree_benchmark_keep_running(benchmark_state, batch)) {
+    int ret = loop(batch);
+    iree_optimization_barrier(ret);
+    iree_benchmark_clobber();
+  }
+  return iree_ok_status();
+}
+IREE_BENCHMARK_REGISTER(BM_BranchChainReference);
+
+IREE_BENCHMARK_FN(BM_BranchChainBytecode) {
+  static const int batch = 100000;
+  return RunFunction(
+      benchmark_state,
+      iree_make_cstring_view("bytecode_module_benchmark.branch_chain"),
+      {batch},
+      /*result_count=*/1,
+      /*batch_size=*/batch);
+}
+IREE_BENCHMARK_REGISTER(BM_BranchChainBytecode);
+
+IREE_BENCHMARK_FN(BM_BranchChainJIT) {
+  static const int batch = 100000;
+  return RunFunction(
+      benchmark_state,
+      iree_make_cstring_view("bytecode_module_benchmark.branch_chain"),
+      {batch},
+      /*result_count=*/1,
+      /*batch_size=*/batch, IREE_VM_BYTECODE_MODULE_FLAG_JIT);
+}
+IREE_BENCHMARK_REGISTER(BM_BranchChainJIT);
+
 IREE_BENCHMARK_FN(BM_BufferReduceReference) {
   static const int batch = 100000;
   static auto work = +[](int32_t* buffer, int i, int sum) {
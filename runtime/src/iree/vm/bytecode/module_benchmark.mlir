@@ -77,6 +77,38 @@ vm.module @bytecode_module_benchmark {
     vm.return %ie : i32
   }
 
+  // Measures the cost of compare-and-branch chains, as produced by lowering
+  // scf.index_switch and nested scf.if ops. Each iteration walks a 4-way
+  // chain of equality tests before the loop latch.
+  vm.export @branch_chain
+  vm.func @branch_chain(%count : i32) -> i32 {
+    %c0 = vm.const.i32.zero
+    %c1 = vm.const.i32 1
+    %c2 = vm.const.i32 2
+    %c3 = vm.const.i32 3
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i : i32, %sum : i32):
+    %sel = vm.and.i32 %i, %c3 : i32
+    %is0 = vm.cmp.eq.i32 %sel, %c0 : i32
+    vm.cond_br %is0, ^latch(%i, %c0 : i32, i32), ^case1
+  ^case1:
+    %is1 = vm.cmp.eq.i32 %sel, %c1 : i32
+    vm.cond_br %is1, ^latch(%i, %c1 : i32, i32), ^case2
+  ^case2:
+    %is2 = vm.cmp.eq.i32 %sel, %c2 : i32
+    vm.cond_br %is2, ^latch(%i, %c2 : i32, i32), ^case3
+  ^case3:
+    %is3 = vm.cmp.ne.i32 %sel, %c0 : i32
+    vm.cond_br %is3, ^latch(%i, %c3 : i32, i32), ^latch(%i, %c0 : i32, i32)
+  ^latch(%j : i32, %v : i32):
+    %new_sum = vm.add.i32 %sum, %v : i32
+    %jn = vm.add.i32 %j, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %jn, %count : i32
+    vm.cond_br %cmp, ^loop(%jn, %new_sum : i32, i32), ^loop_exit(%new_sum : i32)
+  ^loop_exit(%result : i32):
+    vm.return %result : i32
+  }
+
   // Measures the cost of lots of buffer loads.
   vm.export @buffer_reduce
   vm.func @buffer_reduce(%count : i32) -> i32 {
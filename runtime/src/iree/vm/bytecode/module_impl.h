@@ -11,7 +11,10 @@
 #include <string.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
 #include "iree/vm/api.h"
+#include "iree/vm/bytecode/jit.h"
+#include "iree/vm/bytecode/module.h"
 #include "iree/vm/bytecode/utils/isa.h"
 
 #ifdef __cplusplus
@@ -48,6 +51,23 @@ typedef struct iree_vm_bytecode_module_t {
   iree_host_size_t rodata_ref_count;
   iree_vm_buffer_t* rodata_ref_table;
 
+  // Bitmap with one bit per function descriptor set once the function has
+  // passed verification. NULL if all functions were verified (or verification
+  // was skipped) when the module was created.
+  iree_atomic_int32_t* verified_function_bits;
+  // Number of functions that have not yet passed lazy verification.
+  iree_atomic_int32_t unverified_function_count;
+
+  // Verification cache the module was created with, if any, and the digest
+  // the module is recorded under once all functions have been verified.
+  iree_vm_bytecode_verification_cache_t verification_cache;
+  uint64_t verification_digest;
+
+  // Native code for functions translated by the baseline JIT when the module
+  // was created with IREE_VM_BYTECODE_MODULE_FLAG_JIT. NULL if all functions
+  // are interpreted.
+  iree_vm_bytecode_jit_module_t* jit_module;
+
   // Type table mapping module type IDs to registered VM types.
   iree_host_size_t type_count;
   iree_vm_type_def_t type_table[];
@@ -73,6 +93,10 @@ typedef struct iree_vm_bytecode_import_t {
   // don't support variadic values (yet).
   uint16_t argument_buffer_size;
   uint16_t result_buffer_size;
+
+  // Direct call target of native imports that don't override begin_call.
+  // The shim is NULL if the import must be called through begin_call.
+  iree_vm_native_function_direct_call_t direct_call;
 } iree_vm_bytecode_import_t;
 
 // Per-instance module state.
@@ -96,6 +120,26 @@ typedef struct iree_vm_bytecode_module_state_t {
   iree_allocator_t allocator;
 } iree_vm_bytecode_module_state_t;
 
+// Verifies |function_ordinal| when the module was created with lazy
+// verification and the function has not yet been verified.
+iree_status_t iree_vm_bytecode_module_verify_function_lazy(
+    iree_vm_bytecode_module_t* module, uint16_t function_ordinal);
+
+// Ensures that |function_ordinal| has passed verification prior to entering
+// it. This is a single predictable branch unless lazy verification is enabled.
+static inline iree_status_t iree_vm_bytecode_module_ensure_verified(
+    iree_vm_bytecode_module_t* module, uint16_t function_ordinal) {
+  if (IREE_LIKELY(!module->verified_function_bits)) return iree_ok_status();
+  int32_t word = iree_atomic_load(
+      &module->verified_function_bits[function_ordinal / 32],
+      iree_memory_order_acquire);
+  if (IREE_LIKELY(word & (1u << (function_ordinal % 32)))) {
+    return iree_ok_status();
+  }
+  return iree_vm_bytecode_module_verify_function_lazy(module,
+                                                      function_ordinal);
+}
+
 // Begins execution of the current frame and continues until either a yield or
 // return.
 iree_status_t iree_vm_bytecode_dispatch_begin(
@@ -11,6 +11,7 @@
 #include "iree/vm/bytecode/module.h"
 
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "iree/base/api.h"
@@ -113,9 +114,12 @@ class VMBytecodeModuleTest : public ::testing::Test {
     IREE_CHECK_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
                                           iree_allocator_system(), &instance_));
 
+    iree_vm_bytecode_module_options_t options;
+    iree_vm_bytecode_module_options_initialize(&options);
+    options.flags = module_flags();
     const auto* module_file_toc = iree_vm_bytecode_module_test_module_create();
-    IREE_CHECK_OK(iree_vm_bytecode_module_create(
-        instance_,
+    IREE_CHECK_OK(iree_vm_bytecode_module_create_with_options(
+        instance_, &options,
         iree_const_byte_span_t{
             reinterpret_cast<const uint8_t*>(module_file_toc->data),
             static_cast<iree_host_size_t>(module_file_toc->size)},
@@ -127,6 +131,10 @@ class VMBytecodeModuleTest : public ::testing::Test {
         iree_allocator_system(), &context_));
   }
 
+  virtual iree_vm_bytecode_module_flags_t module_flags() {
+    return IREE_VM_BYTECODE_MODULE_FLAG_NONE;
+  }
+
   virtual void TearDown() {
     iree_vm_module_release(bytecode_module_);
     iree_vm_context_release(context_);
@@ -228,4 +236,85 @@ TEST_F(VMBytecodeModuleTest, FuncIO600) {
               IsOkAndHolds(Eq(MakeNullRefList(600))));
 }
 
+// Runs the same functions with each verified on its first call.
+class VMBytecodeModuleLazyVerificationTest : public VMBytecodeModuleTest {
+ protected:
+  iree_vm_bytecode_module_flags_t module_flags() override {
+    return IREE_VM_BYTECODE_MODULE_FLAG_LAZY_VERIFICATION;
+  }
+};
+
+TEST_F(VMBytecodeModuleLazyVerificationTest, FuncIO8) {
+  EXPECT_THAT(RunFunction("FuncIO8", MakeValueRangeList(0, 7)),
+              IsOkAndHolds(Eq(MakeValueRangeList(7, 0))));
+  // Second call takes the already-verified path.
+  EXPECT_THAT(RunFunction("FuncIO8", MakeValueRangeList(0, 7)),
+              IsOkAndHolds(Eq(MakeValueRangeList(7, 0))));
+}
+
+// In-memory verification cache that counts hits and inserts.
+struct TestVerificationCache {
+  std::set<uint64_t> digests;
+  int hit_count = 0;
+  int insert_count = 0;
+
+  static bool Lookup(void* self, uint64_t digest) {
+    auto* cache = reinterpret_cast<TestVerificationCache*>(self);
+    bool hit = cache->digests.count(digest) > 0;
+    if (hit) ++cache->hit_count;
+    return hit;
+  }
+  static void Insert(void* self, uint64_t digest) {
+    auto* cache = reinterpret_cast<TestVerificationCache*>(self);
+    cache->digests.insert(digest);
+    ++cache->insert_count;
+  }
+};
+
+// Loads the test module and releases it immediately.
+static void LoadTestModule(
+    iree_vm_instance_t* instance,
+    const iree_vm_bytecode_verification_cache_t* verification_cache,
+    iree_const_byte_span_t archive_contents) {
+  iree_vm_bytecode_module_options_t options;
+  iree_vm_bytecode_module_options_initialize(&options);
+  options.verification_cache = verification_cache;
+  iree_vm_module_t* module = nullptr;
+  IREE_ASSERT_OK(iree_vm_bytecode_module_create_with_options(
+      instance, &options, archive_contents, iree_allocator_null(),
+      iree_allocator_system(), &module));
+  iree_vm_module_release(module);
+}
+
+TEST(VMBytecodeModuleVerificationCacheTest, SkipsVerifiedArchives) {
+  iree_vm_instance_t* instance = nullptr;
+  IREE_ASSERT_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
+                                         iree_allocator_system(), &instance));
+  const auto* module_file_toc = iree_vm_bytecode_module_test_module_create();
+  iree_const_byte_span_t archive_contents = {
+      reinterpret_cast<const uint8_t*>(module_file_toc->data),
+      static_cast<iree_host_size_t>(module_file_toc->size)};
+
+  TestVerificationCache test_cache;
+  iree_vm_bytecode_verification_cache_t cache = {
+      &test_cache,
+      TestVerificationCache::Lookup,
+      TestVerificationCache::Insert,
+      {0x0123456789ABCDEFull, 0xFEDCBA9876543210ull},
+  };
+
+  // First load verifies and records the archive; the second hits.
+  LoadTestModule(instance, &cache, archive_contents);
+  EXPECT_EQ(test_cache.insert_count, IREE_VM_BYTECODE_VERIFICATION_ENABLE);
+  LoadTestModule(instance, &cache, archive_contents);
+  EXPECT_EQ(test_cache.hit_count, IREE_VM_BYTECODE_VERIFICATION_ENABLE);
+
+  // A different key produces a different digest so the entry is not reused.
+  cache.key[1] ^= 1;
+  LoadTestModule(instance, &cache, archive_contents);
+  EXPECT_EQ(test_cache.hit_count, IREE_VM_BYTECODE_VERIFICATION_ENABLE);
+
+  iree_vm_instance_release(instance);
+}
+
 }  // namespace
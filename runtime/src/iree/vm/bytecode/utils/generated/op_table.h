@@ -140,15 +140,15 @@ typedef enum {
   IREE_VM_OP_CORE_CastAnyRef = 0x82,
   IREE_VM_OP_CORE_BranchTable = 0x83,
   IREE_VM_OP_CORE_BufferHash = 0x84,
-  IREE_VM_OP_CORE_RSV_0x85,
-  IREE_VM_OP_CORE_RSV_0x86,
-  IREE_VM_OP_CORE_RSV_0x87,
-  IREE_VM_OP_CORE_RSV_0x88,
-  IREE_VM_OP_CORE_RSV_0x89,
-  IREE_VM_OP_CORE_RSV_0x8A,
-  IREE_VM_OP_CORE_RSV_0x8B,
-  IREE_VM_OP_CORE_RSV_0x8C,
-  IREE_VM_OP_CORE_RSV_0x8D,
+  IREE_VM_OP_CORE_CmpEQI32CondBranch = 0x85,
+  IREE_VM_OP_CORE_CmpNEI32CondBranch = 0x86,
+  IREE_VM_OP_CORE_CmpLTI32SCondBranch = 0x87,
+  IREE_VM_OP_CORE_CmpEQI64CondBranch = 0x88,
+  IREE_VM_OP_CORE_CmpNEI64CondBranch = 0x89,
+  IREE_VM_OP_CORE_CmpLTI64SCondBranch = 0x8A,
+  IREE_VM_OP_CORE_CmpNZRefCondBranch = 0x8B,
+  IREE_VM_OP_CORE_AddI32CmpLTI32SCondBranch = 0x8C,
+  IREE_VM_OP_CORE_AddI64CmpLTI64SCondBranch = 0x8D,
   IREE_VM_OP_CORE_RSV_0x8E,
   IREE_VM_OP_CORE_RSV_0x8F,
   IREE_VM_OP_CORE_RSV_0x90,
@@ -399,15 +399,15 @@ typedef enum {
     OPC(0x82, CastAnyRef) \
     OPC(0x83, BranchTable) \
     OPC(0x84, BufferHash) \
-    RSV(0x85) \
-    RSV(0x86) \
-    RSV(0x87) \
-    RSV(0x88) \
-    RSV(0x89) \
-    RSV(0x8A) \
-    RSV(0x8B) \
-    RSV(0x8C) \
-    RSV(0x8D) \
+    OPC(0x85, CmpEQI32CondBranch) \
+    OPC(0x86, CmpNEI32CondBranch) \
+    OPC(0x87, CmpLTI32SCondBranch) \
+    OPC(0x88, CmpEQI64CondBranch) \
+    OPC(0x89, CmpNEI64CondBranch) \
+    OPC(0x8A, CmpLTI64SCondBranch) \
+    OPC(0x8B, CmpNZRefCondBranch) \
+    OPC(0x8C, AddI32CmpLTI32SCondBranch) \
+    OPC(0x8D, AddI64CmpLTI64SCondBranch) \
     RSV(0x8E) \
     RSV(0x8F) \
     RSV(0x90) \
@@ -39,7 +39,7 @@
 // Higher versions are disallowed as they occur when new ops are added that
 // otherwise cannot be executed by older runtimes.
 // Matches BytecodeEncoder::kVersionMinor in the compiler.
-#define IREE_VM_BYTECODE_VERSION_MINOR 0
+#define IREE_VM_BYTECODE_VERSION_MINOR 1
 
 //===----------------------------------------------------------------------===//
 // Bytecode structural constants
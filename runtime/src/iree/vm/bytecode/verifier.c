@@ -1560,14 +1560,17 @@ static iree_status_t iree_vm_bytecode_function_verify_bytecode_op(
       verify_state->in_block = 0;  // terminator
     });
 
-    VERIFY_OP(CORE, CondBranch, {
-      VM_VerifyOperandRegI32(condition);
-      VM_VerifyBranchTarget(true_dest_pc);
-      VM_VerifyBranchOperands(true_operands);
-      VM_VerifyBranchTarget(false_dest_pc);
-      VM_VerifyBranchOperands(false_operands);
-      verify_state->in_block = 0;  // terminator
-    });
+// Verifies the operands of a vm.cond_br. Shared with the superinstructions that
+// end in a conditional branch.
+#define VERIFY_COND_BRANCH()               \
+  VM_VerifyOperandRegI32(condition);       \
+  VM_VerifyBranchTarget(true_dest_pc);     \
+  VM_VerifyBranchOperands(true_operands);  \
+  VM_VerifyBranchTarget(false_dest_pc);    \
+  VM_VerifyBranchOperands(false_operands); \
+  verify_state->in_block = 0; /* terminator */
+
+    VERIFY_OP(CORE, CondBranch, { VERIFY_COND_BRANCH(); });
 
     VERIFY_OP(CORE, BranchTable, {
       VM_VerifyOperandRegI32(index);
@@ -1699,6 +1702,61 @@ static iree_status_t iree_vm_bytecode_function_verify_bytecode_op(
       verify_state->in_block = 0;  // terminator
     });
 
+    //===------------------------------------------------------------------===//
+    // Superinstructions
+    //===------------------------------------------------------------------===//
+    // Encoded as the operands of each component op in order.
+
+#define VERIFY_OP_CORE_CMP_I32_COND_BRANCH(op_name) \
+  VERIFY_OP(CORE, op_name, {                        \
+    VM_VerifyOperandRegI32(lhs);                    \
+    VM_VerifyOperandRegI32(rhs);                    \
+    VM_VerifyResultRegI32(result);                  \
+    VERIFY_COND_BRANCH();                           \
+  });
+
+    VERIFY_OP_CORE_CMP_I32_COND_BRANCH(CmpEQI32CondBranch);
+    VERIFY_OP_CORE_CMP_I32_COND_BRANCH(CmpNEI32CondBranch);
+    VERIFY_OP_CORE_CMP_I32_COND_BRANCH(CmpLTI32SCondBranch);
+
+#define VERIFY_OP_CORE_CMP_I64_COND_BRANCH(op_name) \
+  VERIFY_OP(CORE, op_name, {                        \
+    VM_VerifyOperandRegI64(lhs);                    \
+    VM_VerifyOperandRegI64(rhs);                    \
+    VM_VerifyResultRegI32(result);                  \
+    VERIFY_COND_BRANCH();                           \
+  });
+
+    VERIFY_OP_CORE_CMP_I64_COND_BRANCH(CmpEQI64CondBranch);
+    VERIFY_OP_CORE_CMP_I64_COND_BRANCH(CmpNEI64CondBranch);
+    VERIFY_OP_CORE_CMP_I64_COND_BRANCH(CmpLTI64SCondBranch);
+
+    VERIFY_OP(CORE, CmpNZRefCondBranch, {
+      VM_VerifyOperandRegRef(operand);
+      VM_VerifyResultRegI32(result);
+      VERIFY_COND_BRANCH();
+    });
+
+    VERIFY_OP(CORE, AddI32CmpLTI32SCondBranch, {
+      VM_VerifyOperandRegI32(add_lhs);
+      VM_VerifyOperandRegI32(add_rhs);
+      VM_VerifyResultRegI32(add_result);
+      VM_VerifyOperandRegI32(cmp_lhs);
+      VM_VerifyOperandRegI32(cmp_rhs);
+      VM_VerifyResultRegI32(cmp_result);
+      VERIFY_COND_BRANCH();
+    });
+
+    VERIFY_OP(CORE, AddI64CmpLTI64SCondBranch, {
+      VM_VerifyOperandRegI64(add_lhs);
+      VM_VerifyOperandRegI64(add_rhs);
+      VM_VerifyResultRegI64(add_result);
+      VM_VerifyOperandRegI64(cmp_lhs);
+      VM_VerifyOperandRegI64(cmp_rhs);
+      VM_VerifyResultRegI32(cmp_result);
+      VERIFY_COND_BRANCH();
+    });
+
     //===------------------------------------------------------------------===//
     // Extension trampolines
     //===------------------------------------------------------------------===//
@@ -12,6 +12,7 @@
 
 #include "iree/base/internal/atomics.h"
 #include "iree/base/internal/debugging.h"
+#include "iree/vm/native_module.h"
 
 struct iree_vm_context_t {
   iree_atomic_ref_count_t ref_count;
@@ -157,6 +158,27 @@ static iree_status_t iree_vm_context_check_module_dependency(
       (int)dependency->name.size, dependency->name.data);
 }
 
+// Resolves the direct call target of |import_function| (if any) and provides
+// it to |module| as import |ordinal|.
+static iree_status_t iree_vm_context_resolve_import_direct_call(
+    iree_vm_context_t* context, iree_vm_module_t* module,
+    iree_vm_module_state_t* module_state, iree_host_size_t ordinal,
+    const iree_vm_function_t* import_function) {
+  iree_vm_module_t* import_module = import_function->module;
+  if (!module->resolve_import_direct_call ||
+      !import_module->lookup_direct_call) {
+    return iree_ok_status();
+  }
+  iree_vm_native_function_direct_call_t direct_call;
+  IREE_RETURN_IF_ERROR(import_module->lookup_direct_call(
+      import_module->self, *import_function, &direct_call));
+  if (!direct_call.function.shim) return iree_ok_status();
+  IREE_RETURN_IF_ERROR(iree_vm_context_query_module_state(
+      context, import_module, &direct_call.module_state));
+  return module->resolve_import_direct_call(module->self, module_state,
+                                            ordinal, &direct_call);
+}
+
 static iree_status_t iree_vm_context_resolve_module_imports(
     iree_vm_context_t* context, iree_vm_module_t* module,
     iree_vm_module_state_t* module_state) {
@@ -242,6 +264,12 @@ static iree_status_t iree_vm_context_resolve_module_imports(
     IREE_RETURN_AND_END_ZONE_IF_ERROR(
         z0, module->resolve_import(module->self, module_state, i,
                                    &import_function, &import_signature));
+
+    // If both sides support it hand the importer a direct call target so that
+    // it can skip begin_call and the state lookup on each call.
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, iree_vm_context_resolve_import_direct_call(
+                context, module, module_state, i, &import_function));
   }
 
   IREE_TRACE_ZONE_END(z0);
@@ -22,6 +22,8 @@ extern "C" {
 typedef struct iree_vm_module_t iree_vm_module_t;
 typedef struct iree_vm_stack_t iree_vm_stack_t;
 typedef struct iree_vm_stack_frame_t iree_vm_stack_frame_t;
+typedef struct iree_vm_native_function_direct_call_t
+    iree_vm_native_function_direct_call_t;
 
 //===----------------------------------------------------------------------===//
 // Module / function reflection
@@ -444,6 +446,22 @@ typedef struct iree_vm_module_t {
       iree_host_size_t ordinal, const iree_vm_function_t* function,
       const iree_vm_function_signature_t* signature);
 
+  // Optional: queries a direct call target for |function| that callers may
+  // invoke without going through begin_call. |out_direct_call| will be zeroed
+  // if the function has no direct call target (such as when the module
+  // overrides begin_call).
+  iree_status_t(IREE_API_PTR* lookup_direct_call)(
+      void* self, iree_vm_function_t function,
+      iree_vm_native_function_direct_call_t* out_direct_call);
+
+  // Optional: provides the direct call target of the import with the given
+  // ordinal after it has been resolved with resolve_import. Only called for
+  // imports that have a direct call target in the context.
+  iree_status_t(IREE_API_PTR* resolve_import_direct_call)(
+      void* self, iree_vm_module_state_t* module_state,
+      iree_host_size_t ordinal,
+      const iree_vm_native_function_direct_call_t* direct_call);
+
   // Notifies the module of a system signal.
   iree_status_t(IREE_API_PTR* notify)(void* self,
                                       iree_vm_module_state_t* module_state,
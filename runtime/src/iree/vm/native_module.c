@@ -341,6 +341,46 @@ static iree_status_t IREE_API_PTR iree_vm_native_module_resolve_import(
                           "native module does not support imports");
 }
 
+static iree_status_t IREE_API_PTR
+iree_vm_native_module_resolve_import_direct_call(
+    void* self, iree_vm_module_state_t* module_state, iree_host_size_t ordinal,
+    const iree_vm_native_function_direct_call_t* direct_call) {
+  iree_vm_native_module_t* module = (iree_vm_native_module_t*)self;
+  if (module->user_interface.resolve_import_direct_call) {
+    return module->user_interface.resolve_import_direct_call(
+        module->self, module_state, ordinal, direct_call);
+  }
+  // Imports are always called through the module begin_call by default.
+  return iree_ok_status();
+}
+
+static iree_status_t IREE_API_PTR iree_vm_native_module_lookup_direct_call(
+    void* self, iree_vm_function_t function,
+    iree_vm_native_function_direct_call_t* out_direct_call) {
+  iree_vm_native_module_t* module = (iree_vm_native_module_t*)self;
+  memset(out_direct_call, 0, sizeof(*out_direct_call));
+  if (module->user_interface.lookup_direct_call) {
+    return module->user_interface.lookup_direct_call(module->self, function,
+                                                     out_direct_call);
+  }
+
+  // Modules overriding begin_call may do arbitrary work before the shims are
+  // reached (if they have shims at all) and must always be called through it.
+  if (module->user_interface.begin_call || !module->descriptor->functions) {
+    return iree_ok_status();
+  }
+  if (function.linkage != IREE_VM_FUNCTION_LINKAGE_EXPORT &&
+      function.linkage != IREE_VM_FUNCTION_LINKAGE_EXPORT_OPTIONAL) {
+    return iree_ok_status();
+  } else if (function.ordinal >= module->descriptor->function_count) {
+    return iree_ok_status();
+  }
+
+  out_direct_call->function = module->descriptor->functions[function.ordinal];
+  out_direct_call->module = module->self;
+  return iree_ok_status();
+}
+
 static iree_status_t IREE_API_PTR iree_vm_native_module_notify(
     void* self, iree_vm_module_state_t* module_state, iree_vm_signal_t signal) {
   iree_vm_native_module_t* module = (iree_vm_native_module_t*)self;
@@ -547,6 +587,10 @@ IREE_API_EXPORT iree_status_t iree_vm_native_module_initialize(
   module->base_interface.free_state = iree_vm_native_module_free_state;
   module->base_interface.fork_state = iree_vm_native_module_fork_state;
   module->base_interface.resolve_import = iree_vm_native_module_resolve_import;
+  module->base_interface.lookup_direct_call =
+      iree_vm_native_module_lookup_direct_call;
+  module->base_interface.resolve_import_direct_call =
+      iree_vm_native_module_resolve_import_direct_call;
   module->base_interface.notify = iree_vm_native_module_notify;
   module->base_interface.begin_call = iree_vm_native_module_begin_call;
   module->base_interface.resume_call = iree_vm_native_module_resume_call;
@@ -74,6 +74,21 @@ typedef struct iree_vm_native_function_ptr_t {
   iree_vm_native_function_target_t target;
 } iree_vm_native_function_ptr_t;
 
+// A native function resolved for direct calls that bypass begin_call.
+// Callers enter a IREE_VM_STACK_FRAME_NATIVE frame for the function and invoke
+// the shim with the same arguments iree_vm_native_module_t would use. If the
+// shim returns IREE_STATUS_DEFERRED the frame must be left on the stack so
+// that the module resume_call can continue the call.
+typedef struct iree_vm_native_function_direct_call_t {
+  // Shim and target of the function from the module descriptor.
+  iree_vm_native_function_ptr_t function;
+  // The self pointer passed to the shim as |module|.
+  void* module;
+  // Module state resolved at link time or NULL if it must be resolved by the
+  // stack when the call is made.
+  iree_vm_module_state_t* module_state;
+} iree_vm_native_function_direct_call_t;
+
 // Describes a native module implementation by way of descriptor tables.
 // All of this information is assumed read-only and will be referenced for the
 // lifetime of any module created with the descriptor.
@@ -6,6 +6,8 @@
 
 #include "iree/base/api.h"
 #include "iree/testing/benchmark.h"
+#include "iree/vm/context.h"
+#include "iree/vm/instance.h"
 #include "iree/vm/module.h"
 #include "iree/vm/native_module.h"
 #include "iree/vm/native_module_test.h"
@@ -13,6 +15,101 @@
 
 namespace {
 
-// TODO(benvanik): native module benchmarks.
+// Number of calls made per benchmark iteration to amortize loop overhead.
+static constexpr int64_t kCallsPerIteration = 1024;
+
+// Runs |fn| with a context containing module_a and the module_a.add_1 export.
+template <typename Fn>
+static iree_status_t RunWithAdd1(iree_benchmark_state_t* benchmark_state,
+                                 Fn fn) {
+  iree_vm_instance_t* instance = NULL;
+  IREE_CHECK_OK(iree_vm_instance_create(IREE_VM_TYPE_CAPACITY_DEFAULT,
+                                        iree_allocator_system(), &instance));
+  iree_vm_module_t* module = NULL;
+  IREE_CHECK_OK(module_a_create(instance, iree_allocator_system(), &module));
+  iree_vm_context_t* context = NULL;
+  IREE_CHECK_OK(iree_vm_context_create_with_modules(
+      instance, IREE_VM_CONTEXT_FLAG_NONE, 1, &module, iree_allocator_system(),
+      &context));
+
+  iree_vm_function_t function;
+  IREE_CHECK_OK(iree_vm_context_resolve_function(
+      context, IREE_SV("module_a.add_1"), &function));
+
+  IREE_VM_INLINE_STACK_INITIALIZE(stack, IREE_VM_INVOCATION_FLAG_NONE,
+                                  iree_vm_context_state_resolver(context),
+                                  iree_allocator_system());
+  iree_status_t status = fn(benchmark_state, stack, function);
+  iree_vm_stack_deinitialize(stack);
+
+  iree_vm_context_release(context);
+  iree_vm_module_release(module);
+  iree_vm_instance_release(instance);
+  return status;
+}
+
+// Calls module_a.add_1 through iree_vm_module_t::begin_call as a caller that
+// has not been linked against the module would.
+IREE_BENCHMARK_FN(BM_CallNativeFunctionBeginCall) {
+  return RunWithAdd1(
+      benchmark_state,
+      [](iree_benchmark_state_t* benchmark_state, iree_vm_stack_t* stack,
+         iree_vm_function_t function) {
+        int32_t value = 0;
+        while (iree_benchmark_keep_running(benchmark_state,
+                                           kCallsPerIteration)) {
+          for (int64_t i = 0; i < kCallsPerIteration; ++i) {
+            iree_vm_function_call_t call;
+            call.function = function;
+            call.arguments = iree_make_byte_span(&value, sizeof(value));
+            call.results = iree_make_byte_span(&value, sizeof(value));
+            IREE_CHECK_OK(function.module->begin_call(function.module->self,
+                                                      stack, call));
+          }
+        }
+        return iree_ok_status();
+      });
+}
+IREE_BENCHMARK_REGISTER(BM_CallNativeFunctionBeginCall);
+
+// Calls module_a.add_1 through the direct call target resolved once up front as
+// the bytecode module does for its native imports.
+IREE_BENCHMARK_FN(BM_CallNativeFunctionDirect) {
+  return RunWithAdd1(
+      benchmark_state,
+      [](iree_benchmark_state_t* benchmark_state, iree_vm_stack_t* stack,
+         iree_vm_function_t function) {
+        // NOTE: module_a has no state so the NULL module_state returned from
+        // the lookup is the correct one; contexts fill in the real state when
+        // linking.
+        iree_vm_native_function_direct_call_t direct_call;
+        IREE_CHECK_OK(function.module->lookup_direct_call(
+            function.module->self, function, &direct_call));
+        if (!direct_call.function.shim) {
+          return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                                  "module_a.add_1 has no direct call target");
+        }
+        int32_t value = 0;
+        while (iree_benchmark_keep_running(benchmark_state,
+                                           kCallsPerIteration)) {
+          for (int64_t i = 0; i < kCallsPerIteration; ++i) {
+            iree_vm_stack_frame_t* callee_frame = NULL;
+            IREE_CHECK_OK(iree_vm_stack_function_enter_with_state(
+                stack, &function, direct_call.module_state,
+                IREE_VM_STACK_FRAME_NATIVE, /*frame_size=*/0,
+                /*frame_cleanup_fn=*/NULL, &callee_frame));
+            IREE_CHECK_OK(direct_call.function.shim(
+                stack, IREE_VM_NATIVE_FUNCTION_CALL_BEGIN,
+                iree_make_byte_span(&value, sizeof(value)),
+                iree_make_byte_span(&value, sizeof(value)),
+                direct_call.function.target, direct_call.module,
+                callee_frame->module_state));
+            IREE_CHECK_OK(iree_vm_stack_function_leave(stack));
+          }
+        }
+        return iree_ok_status();
+      });
+}
+IREE_BENCHMARK_REGISTER(BM_CallNativeFunctionDirect);
 
 }  // namespace
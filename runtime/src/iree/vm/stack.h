@@ -305,6 +305,16 @@ IREE_API_EXPORT iree_status_t iree_vm_stack_function_enter(
     iree_vm_stack_frame_cleanup_fn_t frame_cleanup_fn,
     iree_vm_stack_frame_t* IREE_RESTRICT* out_callee_frame);
 
+// Enters into the given |function| as with iree_vm_stack_function_enter using
+// an already-resolved |module_state| instead of querying the stack state
+// resolver. Used by direct calls that resolve the state once at link time.
+IREE_API_EXPORT iree_status_t iree_vm_stack_function_enter_with_state(
+    iree_vm_stack_t* stack, const iree_vm_function_t* function,
+    iree_vm_module_state_t* module_state,
+    iree_vm_stack_frame_type_t frame_type, iree_host_size_t frame_size,
+    iree_vm_stack_frame_cleanup_fn_t frame_cleanup_fn,
+    iree_vm_stack_frame_t* IREE_RESTRICT* out_callee_frame);
+
 // Leaves the current stack frame.
 IREE_API_EXPORT iree_status_t
 iree_vm_stack_function_leave(iree_vm_stack_t* stack);
@@ -0,0 +1,89 @@
+// Functions that start with ops the baseline JIT translates. The dispatch test
+// checks that modules created with IREE_VM_BYTECODE_MODULE_FLAG_JIT run these
+// natively (up to the first op without a template).
+vm.module @jit_ops {
+
+  //===--------------------------------------------------------------------===//
+  // Fully translated
+  //===--------------------------------------------------------------------===//
+
+  vm.export @test_loop_i32
+  vm.func @test_loop_i32() {
+    %c0 = vm.const.i32.zero
+    %c1 = vm.const.i32 1
+    %c10 = vm.const.i32 10
+    %c10dno = util.optimization_barrier %c10 : i32
+    vm.br ^loop(%c0, %c0 : i32, i32)
+  ^loop(%i: i32, %sum: i32):
+    %sum_next = vm.add.i32 %sum, %i : i32
+    %i_next = vm.add.i32 %i, %c1 : i32
+    %cmp = vm.cmp.lt.i32.s %i_next, %c10dno : i32
+    vm.cond_br %cmp, ^loop(%i_next, %sum_next : i32, i32), ^exit(%sum_next : i32)
+  ^exit(%result: i32):
+    %c45 = vm.const.i32 45
+    vm.check.eq %result, %c45, "sum(0..9)=45" : i32
+    vm.return
+  }
+
+  vm.export @test_select_minmax_i32
+  vm.func @test_select_minmax_i32() {
+    %c3 = vm.const.i32 3
+    %c3dno = util.optimization_barrier %c3 : i32
+    %cn2 = vm.const.i32 -2
+    %cn2dno = util.optimization_barrier %cn2 : i32
+    %min = vm.min.i32.s %c3dno, %cn2dno : i32
+    %max = vm.max.i32.s %c3dno, %cn2dno : i32
+    %cmp = vm.cmp.lt.i32.s %min, %max : i32
+    %v = vm.select.i32 %cmp, %min, %max : i32
+    vm.check.eq %v, %cn2dno, "select(-2<3, -2, 3)=-2" : i32
+    vm.return
+  }
+
+  vm.export @fail_check_i32
+  vm.func @fail_check_i32() {
+    %c1 = vm.const.i32 1
+    %c1dno = util.optimization_barrier %c1 : i32
+    %v = vm.shl.i32 %c1dno, %c1dno : i32
+    vm.check.eq %v, %c1dno, "1<<1=1" : i32
+    vm.return
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Partially translated
+  //===--------------------------------------------------------------------===//
+
+  // vm.div.i32.s has no template and the interpreter continues from it.
+  vm.export @test_exit_at_unsupported_op
+  vm.func @test_exit_at_unsupported_op() {
+    %c6 = vm.const.i32 6
+    %c6dno = util.optimization_barrier %c6 : i32
+    %c2 = vm.const.i32 2
+    %sum = vm.add.i32 %c6dno, %c2 : i32
+    %v = vm.div.i32.s %sum, %c2 : i32
+    %c4 = vm.const.i32 4
+    vm.check.eq %v, %c4, "(6+2)/2=4" : i32
+    vm.return
+  }
+
+  // The branch to ^bb1 exits to the interpreter at the block as it follows an
+  // op without a template.
+  vm.export @test_exit_at_untranslated_block
+  vm.func @test_exit_at_untranslated_block() {
+    %c0 = vm.const.i32.zero
+    %c0dno = util.optimization_barrier %c0 : i32
+    %c8 = vm.const.i32 8
+    vm.cond_br %c0dno, ^bb0, ^bb1(%c8 : i32)
+  ^bb0:
+    %c2 = vm.const.i32 2
+    %v = vm.rem.i32.s %c8, %c2 : i32
+    vm.check.eq %v, %c0, "8%2=0" : i32
+    vm.return
+  ^bb1(%arg: i32):
+    %c3 = vm.const.i32 3
+    %w = vm.rem.i32.u %arg, %c3 : i32
+    %c2b = vm.const.i32 2
+    vm.check.eq %w, %c2b, "8%3=2" : i32
+    vm.return
+  }
+
+}
@@ -164,6 +164,15 @@ IREE_FLAG(bool, quiet, false,
 
 IREE_FLAG(string, output, "", "Output .irpa file path.");
 
+IREE_FLAG(bool, deduplicate, true,
+          "Stores parameters with identical contents once and has all of them\n"
+          "reference the same range of the output file. Requires reading all\n"
+          "parameter contents before writing the output.");
+
+IREE_FLAG(int32_t, max_concurrency, 0,
+          "Maximum number of threads used to hash and copy parameter\n"
+          "contents; 0 uses the default.");
+
 static void iree_io_file_handle_release_mapping(
     void* user_data, iree_io_file_handle_primitive_t handle_primitive) {
   iree_file_contents_free((iree_file_contents_t*)user_data);
@@ -257,6 +266,9 @@ int main(int argc, char** argv) {
   }
 
   // Write out the new archive.
+  iree_io_build_parameter_archive_statistics_t statistics;
+  memset(&statistics, 0, sizeof(statistics));
+  iree_time_t start_time_ns = iree_time_now();
   if (iree_status_is_ok(status)) {
     iree_tooling_open_params_t open_params = {
         .host_allocator = host_allocator,
@@ -266,9 +278,34 @@ int main(int argc, char** argv) {
         .fn = iree_tooling_open_output_parameter_file,
         .user_data = &open_params,
     };
-    status = iree_io_build_parameter_archive(
+    iree_io_build_parameter_archive_options_t options = {
+        .flags = FLAG_deduplicate
+                     ? IREE_IO_BUILD_PARAMETER_ARCHIVE_FLAG_DEDUPLICATE
+                     : IREE_IO_BUILD_PARAMETER_ARCHIVE_FLAG_NONE,
+        .max_concurrency = (iree_host_size_t)iree_max(0, FLAG_max_concurrency),
+    };
+    status = iree_io_build_parameter_archive_with_options(
         new_index, built_index, open_callback,
-        /*target_file_offset=*/0, host_allocator);
+        /*target_file_offset=*/0, &options, &statistics, host_allocator);
+  }
+  iree_time_t end_time_ns = iree_time_now();
+
+  // Report how much deduplication saved and the conversion throughput.
+  if (iree_status_is_ok(status) && !FLAG_quiet) {
+    double duration_s = (double)(end_time_ns - start_time_ns) / 1e9;
+    fprintf(stdout,
+            "Converted %" PRIhsz " parameters (%" PRIhsz
+            " deduplicated) with %" PRIu64 " bytes of data in %.3fs (%.2f "
+            "GB/s)\n",
+            statistics.entry_count, statistics.deduplicated_entry_count,
+            statistics.data_length, duration_s,
+            duration_s > 0.0 ? (double)statistics.data_length / duration_s / 1e9
+                             : 0.0);
+    fprintf(stdout,
+            "Stored %" PRIu64 " bytes of data; %" PRIu64
+            " bytes saved by deduplication\n\n",
+            statistics.stored_data_length,
+            statistics.data_length - statistics.stored_data_length);
   }
 
   // Dump the new index ala iree-dump-parameters to show the final file.
@@ -41,6 +41,17 @@ func.func @default() -> (i32, tensor<f32>, tensor<?x4xi32>) {
 // RUN:                  --output=+%t.npy) && \
 // RUN:  "%PYTHON" %S/echo_npy.py %t.npy | \
 // RUN: FileCheck --check-prefix=OUTPUT-NUMPY %s
+
+// Tests the same outputs streamed directly from device buffers into the file.
+
+// RUN: (iree-compile --iree-hal-target-backends=vmvx %s | \
+// RUN:  iree-run-module --device=local-sync --module=- --function=numpy \
+// RUN:                  --output_streaming \
+// RUN:                  --output= \
+// RUN:                  --output=@%t.streamed.npy \
+// RUN:                  --output=+%t.streamed.npy) && \
+// RUN:  "%PYTHON" %S/echo_npy.py %t.streamed.npy | \
+// RUN: FileCheck --check-prefix=OUTPUT-NUMPY %s
 func.func @numpy() -> (i32, tensor<f32>, tensor<?x4xi32>) {
   // Output skipped:
   %0 = arith.constant 123 : i32
@@ -54,6 +65,29 @@ func.func @numpy() -> (i32, tensor<f32>, tensor<?x4xi32>) {
 
 // -----
 
+// Tests streaming outputs into a parameter archive with each output stored as
+// an entry named by its ordinal.
+
+// RUN: (iree-compile --iree-hal-target-backends=vmvx %s | \
+// RUN:  iree-run-module --device=local-sync --module=- --function=irpa \
+// RUN:                  --output_streaming \
+// RUN:                  --output= \
+// RUN:                  --output=@%t.irpa \
+// RUN:                  --output=+%t.irpa && \
+// RUN:  iree-dump-parameters --parameters=%t.irpa) | \
+// RUN: FileCheck --check-prefix=OUTPUT-IRPA %s
+func.func @irpa() -> (i32, tensor<f32>, tensor<?x4xi32>) {
+  // Output skipped:
+  %0 = arith.constant 123 : i32
+  // OUTPUT-IRPA: | 4 | `output_1`
+  %1 = arith.constant dense<4.0> : tensor<f32>
+  // OUTPUT-IRPA: | 32 | `output_2`
+  %2 = flow.tensor.dynamic_constant dense<[[0,1,2,3],[4,5,6,7]]> : tensor<2x4xi32> -> tensor<?x4xi32>
+  return %0, %1, %2 : i32, tensor<f32>, tensor<?x4xi32>
+}
+
+// -----
+
 // Tests output to binary files by round-tripping the output of a function into
 // another invocation reading from the binary files. Each output is written to
 // its own file (optimal for alignment/easier to inspect).
@@ -0,0 +1,81 @@
+// Tests that executables split into multiple partitions for parallel LLVM
+// code generation link and run correctly. Each addition is kept in its own
+// dispatch so that the linked executable has enough exports to be split into
+// two partitions.
+
+// RUN: (iree-compile %s \
+// RUN:      --iree-hal-target-backends=llvm-cpu \
+// RUN:      --iree-llvmcpu-codegen-partitions=2 | \
+// RUN:  iree-run-module \
+// RUN:      --device=local-task \
+// RUN:      --module=- \
+// RUN:      --function=add_chain \
+// RUN:      --input="2xf32=-2 3") | \
+// RUN: FileCheck %s
+
+// Verifies that the executable was actually split.
+// RUN: rm -rf %t.dump
+// RUN: iree-compile %s \
+// RUN:      --iree-hal-target-backends=llvm-cpu \
+// RUN:      --iree-llvmcpu-codegen-partitions=2 \
+// RUN:      --iree-hal-dump-executable-intermediates-to=%t.dump \
+// RUN:      -o /dev/null
+// RUN: ls %t.dump | FileCheck %s --check-prefix=DUMP
+
+// DUMP-DAG: _partition0.o
+// DUMP-DAG: _partition1.o
+
+// CHECK-LABEL: EXEC @add_chain
+// CHECK-NEXT: result[0]: hal.buffer_view
+// CHECK-NEXT: 2xf32=134 139
+func.func @add_chain(%input: tensor<2xf32>) -> tensor<2xf32> {
+  %c1 = arith.constant dense<1.0> : tensor<2xf32>
+  %add1 = arith.addf %input, %c1 : tensor<2xf32>
+  %barrier1 = util.optimization_barrier %add1 : tensor<2xf32>
+  %c2 = arith.constant dense<2.0> : tensor<2xf32>
+  %add2 = arith.addf %barrier1, %c2 : tensor<2xf32>
+  %barrier2 = util.optimization_barrier %add2 : tensor<2xf32>
+  %c3 = arith.constant dense<3.0> : tensor<2xf32>
+  %add3 = arith.addf %barrier2, %c3 : tensor<2xf32>
+  %barrier3 = util.optimization_barrier %add3 : tensor<2xf32>
+  %c4 = arith.constant dense<4.0> : tensor<2xf32>
+  %add4 = arith.addf %barrier3, %c4 : tensor<2xf32>
+  %barrier4 = util.optimization_barrier %add4 : tensor<2xf32>
+  %c5 = arith.constant dense<5.0> : tensor<2xf32>
+  %add5 = arith.addf %barrier4, %c5 : tensor<2xf32>
+  %barrier5 = util.optimization_barrier %add5 : tensor<2xf32>
+  %c6 = arith.constant dense<6.0> : tensor<2xf32>
+  %add6 = arith.addf %barrier5, %c6 : tensor<2xf32>
+  %barrier6 = util.optimization_barrier %add6 : tensor<2xf32>
+  %c7 = arith.constant dense<7.0> : tensor<2xf32>
+  %add7 = arith.addf %barrier6, %c7 : tensor<2xf32>
+  %barrier7 = util.optimization_barrier %add7 : tensor<2xf32>
+  %c8 = arith.constant dense<8.0> : tensor<2xf32>
+  %add8 = arith.addf %barrier7, %c8 : tensor<2xf32>
+  %barrier8 = util.optimization_barrier %add8 : tensor<2xf32>
+  %c9 = arith.constant dense<9.0> : tensor<2xf32>
+  %add9 = arith.addf %barrier8, %c9 : tensor<2xf32>
+  %barrier9 = util.optimization_barrier %add9 : tensor<2xf32>
+  %c10 = arith.constant dense<10.0> : tensor<2xf32>
+  %add10 = arith.addf %barrier9, %c10 : tensor<2xf32>
+  %barrier10 = util.optimization_barrier %add10 : tensor<2xf32>
+  %c11 = arith.constant dense<11.0> : tensor<2xf32>
+  %add11 = arith.addf %barrier10, %c11 : tensor<2xf32>
+  %barrier11 = util.optimization_barrier %add11 : tensor<2xf32>
+  %c12 = arith.constant dense<12.0> : tensor<2xf32>
+  %add12 = arith.addf %barrier11, %c12 : tensor<2xf32>
+  %barrier12 = util.optimization_barrier %add12 : tensor<2xf32>
+  %c13 = arith.constant dense<13.0> : tensor<2xf32>
+  %add13 = arith.addf %barrier12, %c13 : tensor<2xf32>
+  %barrier13 = util.optimization_barrier %add13 : tensor<2xf32>
+  %c14 = arith.constant dense<14.0> : tensor<2xf32>
+  %add14 = arith.addf %barrier13, %c14 : tensor<2xf32>
+  %barrier14 = util.optimization_barrier %add14 : tensor<2xf32>
+  %c15 = arith.constant dense<15.0> : tensor<2xf32>
+  %add15 = arith.addf %barrier14, %c15 : tensor<2xf32>
+  %barrier15 = util.optimization_barrier %add15 : tensor<2xf32>
+  %c16 = arith.constant dense<16.0> : tensor<2xf32>
+  %add16 = arith.addf %barrier15, %c16 : tensor<2xf32>
+  %barrier16 = util.optimization_barrier %add16 : tensor<2xf32>
+  return %barrier16 : tensor<2xf32>
+}